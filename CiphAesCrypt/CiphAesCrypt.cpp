@@ -1,1071 +1,1416 @@
-#include <Windows.h>
+#include "CiphAes.h"
+#include "CiphLib.h"
 #include <stdio.h>
+#include <string.h>
 
-// AES (Advanced Encryption Standard) ɂÍ
-
-// Ql
-// ADVANCED ENCRYPTION STANDARD (AES)
-// https://csrc.nist.gov/csrc/media/publications/fips/197/final/documents/fips-197.pdf
+// AES (Advanced Encryption Standard) ɂÍ̃eXg
+// Í̏ CiphLib (CiphAes.h, CiphLib.h) Q
 
 // eXg
 // https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/AES_ModesA_All.pdf
 // https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Algorithm-Validation-Program/documents/aes/AESAVS.pdf
 
-// Figure 4.  Key-Block-Round Combinations.
-// 
-//           | Key Length | Block Size | Number of Rounds
-//           | (Nk words) | (Nb words) | (Nr)
-// ----------+------------+------------+----------------
-// AES - 128 | 4          | 4          | 10
-// ----------+------------+------------+----------------
-// AES - 192 | 6          | 4          | 12
-// ----------+------------+------------+----------------
-// AES - 256 | 8          | 4          | 14
-// ----------+------------+------------+----------------
-
-// Figure 7. S-box:  substitution values for the byte xy (in hexadecimal format).
-// oCgl11̔`u\
-static const BYTE SBox[256] = {
-	//     0     1     2     3     4     5     6     7     8     9     A     B     C     D     E     F
-		0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
-		0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
-		0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
-		0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
-		0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
-		0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
-		0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
-		0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
-		0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
-		0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
-		0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
-		0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
-		0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
-		0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
-		0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
-		0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
-};
-
-// Figure 14. Inverse S-box: substitution values for the byte xy (in hexadecimal format).
-// oCgl11̔`u\
-// SBox ̋to[W
-static const BYTE InvSBox[256] = {
-	//     0     1     2     3     4     5     6     7     8     9     A     B     C     D     E     F
-		0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
-		0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
-		0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
-		0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
-		0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
-		0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
-		0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
-		0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
-		0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
-		0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
-		0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
-		0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
-		0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
-		0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
-		0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
-		0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
-};
-
-typedef enum
-{
-	AES128 = 0,
-	AES192,
-	AES256
-} AESBitLength;
-
-AESBitLength CurrentAESBitLength;
-
-BYTE KeyTable[3] = { 4, 6, 8 };
-BYTE RoundTable[3] = { 10, 12, 14 };
-
-// GFMultiplication ֐
-// ^ꂽɊÂČvZsǍʂԂ
-// ꂼ a, b ƂAʂ c Ƃ
-// ȉ̏ b  0 ɂȂ܂ŌJԂB܂ c ̏l 0 Ƃ
-// 1. b ̍ŉʃrbg 1 ̏ꍇAc = a ^ c Ƃ
-// 2. a ̍ŏʃrbg 1 ̏ꍇAa  1 rbgVtg a = a ^ 0x1b Ƃ
-//    a ̍ŏʃrbg 0 ̏ꍇAa  1 rbgVtg
-// 3. b  1 rbgEVtg
-BYTE WINAPI GFMultiplication(BYTE a, BYTE b)
+#define AES_MODE_ECB 1
+#define AES_MODE_CBC 2
+#define AES_MODE_CFB 3
+#define AES_MODE_OFB 4
+#define AES_MODE_CTR 5
+
+// AesEncryptDecrypt ֐
+// AES ɂÍƕ̃eXg
+VOID WINAPI AesEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* IVorICV, BYTE* Key, BYTE cbitSegment, DWORD dwMode)
 {
-	BYTE aTemp, bTemp, c = 0;
+	DWORD i;
+	BYTE* cipher, * out;
+	BYTE Nk = KeyTable[CurrentAESBitLength];
 
-	for (aTemp = a, bTemp = b; bTemp != 0; bTemp >>= 1)
+	printf("%-21s = ", "Cipher Key");
+	for (i = 0; i < (DWORD)(Nk * 4); i++)
 	{
-		if (bTemp & 1)
+		printf("%02x", Key[i]);
+		if (i % 8 == 7)
 		{
-			c ^= aTemp;
+			printf(" ");
 		}
+	}
+	printf("\r\n");
 
-		if (aTemp & 0x80)
+	if (IVorICV != NULL)
+	{
+		printf("%-21s = ", "IV or ICV");
+		for (i = 0; i < 16; i++)
 		{
-			aTemp <<= 1;
-			aTemp ^= 0x1b;
+			printf("%02x", IVorICV[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
 		}
-		else
+		printf("\r\n");
+	}
+
+	printf("%-21s = ", "Input");
+	for (i = 0; i < cbIn; i++)
+	{
+		printf("%02x", in[i]);
+		if (i % 8 == 7)
 		{
-			aTemp <<= 1;
+			printf(" ");
 		}
 	}
+	printf("\r\n");
 
-	return c;
-}
+	if (cbitSegment != 0)
+	{
+		printf("%-21s = %u\r\n", "Segment Bits", cbitSegment);
+	}
+
+	// ÍƕőŜ㏑邽 0 ł̏͏Ȃ
+	cipher = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+	out = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+
+	// AES Í
+	switch (dwMode)
+	{
+	case AES_MODE_ECB:
+		AesEcbEncrypt(in, cbIn, Key, cipher);
+		printf("%-21s = ", "Cipher Text (AES-ECB)");
+		break;
+	case AES_MODE_CBC:
+		AesCbcEncrypt(in, cbIn, IVorICV, Key, cipher);
+		printf("%-21s = ", "Cipher Text (AES-CBC)");
+		break;
+	case AES_MODE_CFB:
+		AesCfbEncrypt(in, cbIn, IVorICV, Key, cbitSegment, cipher);
+		printf("%-21s = ", "Cipher Text (AES-CFB)");
+		break;
+	case AES_MODE_OFB:
+		AesOfbEncryptDecrypt(in, cbIn, IVorICV, Key, cipher);
+		printf("%-21s = ", "Cipher Text (AES-OFB)");
+		break;
+	case AES_MODE_CTR:
+		AesCtrEncryptDecrypt(in, cbIn, IVorICV, Key, cipher);
+		printf("%-21s = ", "Cipher Text (AES-CTR)");
+		break;
+	default:
+		break;
+	}
 
+	for (i = 0; i < cbIn; i++)
+	{
+		printf("%02x", cipher[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
+	}
+	printf("\r\n");
 
-// SubBytes ֐
-// ue[u (SBox) gp State ̊eoCgu
-VOID WINAPI SubBytes(BYTE* State) // 4 * Nb
+	// AES 
+	switch (dwMode)
+	{
+	case AES_MODE_ECB:
+		AesEcbDecrypt(cipher, cbIn, Key, out);
+		break;
+	case AES_MODE_CBC:
+		AesCbcDecrypt(cipher, cbIn, IVorICV, Key, out);
+		break;
+	case AES_MODE_CFB:
+		AesCfbDecrypt(cipher, cbIn, IVorICV, Key, cbitSegment, out);
+		break;
+	case AES_MODE_OFB:
+		AesOfbEncryptDecrypt(cipher, cbIn, IVorICV, Key, out);
+		break;
+	case AES_MODE_CTR:
+		AesCtrEncryptDecrypt(cipher, cbIn, IVorICV, Key, out);
+		break;
+	default:
+		break;
+	}
+
+	printf("%-21s = ", "Output");
+	for (i = 0; i < cbIn; i++)
+	{
+		printf("%02x", out[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
+	}
+	printf("\r\n");
+
+	CiphFree(cipher);
+	CiphFree(out);
+
+	return;
+}
+
+// AesPaddingEncryptDecrypt ֐
+// pfBOAÍގp AES ɂÍƕ̃eXg
+VOID WINAPI AesPaddingEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, DWORD dwPadding, DWORD dwMode)
 {
-	BYTE i;
-	const BYTE Nb = 4;
+	DWORD i, cbCipher, cbOut = 0;
+	BYTE* cipher, * out;
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	BOOL bResult = FALSE;
 
-	for (i = 0; i < 4 * Nb; i++)
+	printf("%-21s = ", "Cipher Key");
+	for (i = 0; i < (DWORD)(Nk * 4); i++)
 	{
-		State[i] = SBox[State[i]];
+		printf("%02x", Key[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
 	}
+	printf("\r\n");
+
+	if (IV != NULL)
+	{
+		printf("%-21s = ", "IV");
+		for (i = 0; i < 16; i++)
+		{
+			printf("%02x", IV[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
+		}
+		printf("\r\n");
+	}
+
+	printf("%-21s = ", "Input");
+	for (i = 0; i < cbIn; i++)
+	{
+		printf("%02x", in[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
+	}
+	printf("\r\n");
+
+	// o̓obt@̃TCY͈ÍOɊm肷
+	cbCipher = AesGetOutputLength(cbIn, dwPadding);
+	cipher = (BYTE*)CiphAlloc(cbCipher);
+	out = (BYTE*)CiphAlloc(cbCipher);
+
+	// AES Í
+	if (dwMode == AES_MODE_ECB)
+	{
+		AesEcbEncryptPkcs7(in, cbIn, Key, cipher);
+		printf("%-21s = ", "Cipher Text (ECB-P7)");
+	}
+	else if (dwPadding == AES_PADDING_PKCS7)
+	{
+		AesCbcEncryptPkcs7(in, cbIn, IV, Key, cipher);
+		printf("%-21s = ", "Cipher Text (CBC-P7)");
+	}
+	else
+	{
+		AesCbcEncryptCts(in, cbIn, IV, Key, dwPadding, cipher);
+		printf("Cipher Text (CBC-CS%u) = ", dwPadding - AES_PADDING_CS1 + 1);
+	}
+
+	for (i = 0; i < cbCipher; i++)
+	{
+		printf("%02x", cipher[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
+	}
+	printf("\r\n");
+
+	// AES 
+	if (dwMode == AES_MODE_ECB)
+	{
+		bResult = AesEcbDecryptPkcs7(cipher, cbCipher, Key, out, &cbOut);
+	}
+	else if (dwPadding == AES_PADDING_PKCS7)
+	{
+		bResult = AesCbcDecryptPkcs7(cipher, cbCipher, IV, Key, out, &cbOut);
+	}
+	else
+	{
+		bResult = AesCbcDecryptCts(cipher, cbCipher, IV, Key, dwPadding, out);
+		cbOut = cbCipher;
+	}
+
+	printf("%-21s = ", "Output");
+	if (bResult)
+	{
+		for (i = 0; i < cbOut; i++)
+		{
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
+		}
+	}
+	else
+	{
+		printf("(invalid padding)");
+	}
+	printf("\r\n");
+
+	CiphFree(cipher);
+	CiphFree(out);
 
 	return;
 }
 
-// InvSubBytes ֐
-// ue[u (InvSBox) gp State ̊eoCgu
-VOID WINAPI InvSubBytes(BYTE* State) // 4 * Nb
+// PrintBytes ֐
+// xƃoCg 16 iŕ\ (8 oCgɋ󔒂ŋ؂)
+VOID WINAPI PrintBytes(CONST CHAR* label, BYTE* data, DWORD cbData)
 {
-	BYTE i;
-	const BYTE Nb = 4;
+	DWORD i;
 
-	for (i = 0; i < 4 * Nb; i++)
+	printf("%-21s = ", label);
+	for (i = 0; i < cbData; i++)
 	{
-		State[i] = InvSBox[State[i]];
+		printf("%02x", data[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
 	}
+	printf("\r\n");
 
 	return;
 }
 
-// ShiftRows ֐
-// State ̍Ō 3 s̃oCgAzIɃVtg
-// ŏ̍s (r = 0) ̓VtgȂ
-//           S                        S'
-// +----+----+----+----+    +----+----+----+----+
-// |s0,0|s0,1|s0,2|s0,3|    |s0,0|s0,1|s0,2|s0,3|
-// +----+----+----+----+    +----+----+----+----+
-// |s1,0|s1,1|s1,2|s1,3|    |s1,1|s1,2|s1,3|s1,0|
-// +----+----+----+----+ => +----+----+----+----+
-// |s2,0|s2,1|s2,2|s2,3|    |s2,2|s2,3|s2,0|s2,1|
-// +----+----+----+----+    +----+----+----+----+
-// |s3,0|s3,1|s3,2|s3,3|    |s3,3|s3,0|s3,1|s3,2|
-// +----+----+----+----+    +----+----+----+----+
-VOID WINAPI ShiftRows(BYTE* State) // 4 * Nb
+VOID WINAPI AesGcmEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, DWORD cbIV, BYTE* AAD, DWORD cbAAD, BYTE* Key)
 {
-	BYTE btTemp;
-	const BYTE Nb = 4;
-
-	btTemp = State[1];
-	State[1] = State[5];
-	State[5] = State[9];
-	State[9] = State[13];
-	State[13] = btTemp;
-
-	btTemp = State[2];
-	State[2] = State[10];
-	State[10] = btTemp;
-	btTemp = State[6];
-	State[6] = State[14];
-	State[14] = btTemp;
-
-	btTemp = State[3];
-	State[3] = State[15];
-	State[15] = State[11];
-	State[11] = State[7];
-	State[7] = btTemp;
+	BYTE* cipher, * out;
+	BYTE Tag[16];
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	BOOL bResult;
+	AES_GCM_CONTEXT* pContext;
+
+	PrintBytes("Cipher Key", Key, Nk * 4);
+	PrintBytes("IV", IV, cbIV);
+	PrintBytes("AAD", AAD, cbAAD);
+	PrintBytes("Input", in, cbIn);
+
+	// ̓͂łmۂł悤 1 oCg]Ɋmۂ
+	cipher = (BYTE*)CiphAlloc(cbIn + 1);
+	out = (BYTE*)CiphAlloc(cbIn + 1);
+	pContext = (AES_GCM_CONTEXT*)CiphAlloc(sizeof(AES_GCM_CONTEXT));
+
+	// AES-GCM Í
+	AesGcmInit(Key, CurrentAESBitLength, pContext);
+	AesGcmEncrypt(pContext, IV, cbIV, AAD, cbAAD, in, cbIn, cipher, Tag);
+	PrintBytes("Cipher Text (GCM)", cipher, cbIn);
+	PrintBytes("Tag", Tag, 16);
+
+	// AES-GCM 
+	bResult = AesGcmDecrypt(pContext, IV, cbIV, AAD, cbAAD, cipher, cbIn, Tag, out);
+	if (bResult)
+	{
+		PrintBytes("Output", out, cbIn);
+	}
+	else
+	{
+		printf("%-21s = (authentication failed)\r\n", "Output");
+	}
+
+	// F؃^O񂵂ꍇ͕Ɏs
+	Tag[0] ^= 1;
+	bResult = AesGcmDecrypt(pContext, IV, cbIV, AAD, cbAAD, cipher, cbIn, Tag, out);
+	printf("%-21s = %s\r\n", "Tampered Tag", bResult ? "accepted" : "rejected");
+
+	SecureZeroMemory(pContext, sizeof(AES_GCM_CONTEXT));
+	CiphFree(pContext);
+	CiphFree(cipher);
+	CiphFree(out);
 
 	return;
 }
 
-// InvShiftRows ֐
-// State ̍Ō 3 s̃oCgAzIɃVtg
-// ŏ̍s (r = 0) ̓VtgȂ
-//           S                        S'
-// +----+----+----+----+    +----+----+----+----+
-// |s0,0|s0,1|s0,2|s0,3|    |s0,0|s0,1|s0,2|s0,3|
-// +----+----+----+----+    +----+----+----+----+
-// |s1,0|s1,1|s1,2|s1,3|    |s1,3|s1,0|s1,1|s1,2|
-// +----+----+----+----+ => +----+----+----+----+
-// |s2,0|s2,1|s2,2|s2,3|    |s2,2|s2,3|s2,0|s2,1|
-// +----+----+----+----+    +----+----+----+----+
-// |s3,0|s3,1|s3,2|s3,3|    |s3,1|s3,2|s3,3|s3,0|
-// +----+----+----+----+    +----+----+----+----+
-VOID WINAPI InvShiftRows(BYTE* State) // 4 * Nb
+VOID WINAPI AesXtsEncryptDecrypt(BYTE* in, DWORD cbSector, ULONG64 SectorNumber, BYTE* Key)
 {
-	BYTE btTemp;
-
-	btTemp = State[13];
-	State[13] = State[9];
-	State[9] = State[5];
-	State[5] = State[1];
-	State[1] = btTemp;
-
-	btTemp = State[2];
-	State[2] = State[10];
-	State[10] = btTemp;
-	btTemp = State[6];
-	State[6] = State[14];
-	State[14] = btTemp;
-
-	btTemp = State[3];
-	State[3] = State[7];
-	State[7] = State[11];
-	State[11] = State[15];
-	State[15] = btTemp;
+	BYTE* cipher, * out;
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	AES_XTS_CONTEXT* pContext;
+
+	PrintBytes("Key1", Key, Nk * 4);
+	PrintBytes("Key2", &Key[Nk * 4], Nk * 4);
+	printf("%-21s = %llx\r\n", "Sector Number", SectorNumber);
+	PrintBytes("Input", in, cbSector);
+
+	cipher = (BYTE*)CiphAlloc(cbSector);
+	out = (BYTE*)CiphAlloc(cbSector);
+	pContext = (AES_XTS_CONTEXT*)CiphAlloc(sizeof(AES_XTS_CONTEXT));
+
+	// AES-XTS Í
+	AesXtsInit(Key, CurrentAESBitLength, pContext);
+	AesXtsEncrypt(pContext, SectorNumber, in, cbSector, cipher);
+	PrintBytes("Cipher Text (XTS)", cipher, cbSector);
+
+	// AES-XTS 
+	AesXtsDecrypt(pContext, SectorNumber, cipher, cbSector, out);
+	PrintBytes("Output", out, cbSector);
+
+	SecureZeroMemory(pContext, sizeof(AES_XTS_CONTEXT));
+	CiphFree(pContext);
+	CiphFree(cipher);
+	CiphFree(out);
 
 	return;
 }
 
-// MixColumns ֐
-// State 񂲂Ƃɑ삵Ăꂼɏs
-// ̂悤ȍšvZs
-// |S'0,c|   |02 03 01 01| |S0,c|
-// |S'1,c| = |01 02 03 01| |S1,c|
-// |S'2,c|   |01 01 02 03| |S2,c|
-// |S'3,c|   |03 01 01 02| |S3,c|
-VOID WINAPI MixColumns(BYTE* State) // 4 * Nb
+// ꊇ (Xbh) ̌ʂ 1 ZN^ʂƈv邩mF
+VOID WINAPI AesXtsBatchEncryptDecrypt(BYTE* Key, ULONG64 FirstSector, DWORD cbSector, DWORD nSectors, DWORD dwThreads)
 {
-	BYTE i, Temp[4];
-	const BYTE Nb = 4;
+	DWORD i;
+	SIZE_T cbTotal = (SIZE_T)cbSector * nSectors;
+	BYTE* in, * cipher, * out, * single;
+	BOOL bMatch = TRUE;
+	AES_XTS_CONTEXT* pContext;
+
+	in = (BYTE*)CiphAlloc(cbTotal);
+	cipher = (BYTE*)CiphAlloc(cbTotal);
+	out = (BYTE*)CiphAlloc(cbTotal);
+	single = (BYTE*)CiphAlloc(cbSector);
+	pContext = (AES_XTS_CONTEXT*)CiphAlloc(sizeof(AES_XTS_CONTEXT));
+
+	for (i = 0; i < cbTotal; i++)
+	{
+		in[i] = (BYTE)i;
+	}
+
+	AesXtsInit(Key, CurrentAESBitLength, pContext);
+	AesXtsEncryptSectors(pContext, FirstSector, in, cbSector, nSectors, cipher, dwThreads);
+	for (i = 0; i < nSectors; i++)
+	{
+		AesXtsEncrypt(pContext, FirstSector + i, &in[(SIZE_T)i * cbSector], cbSector, single);
+		if (memcmp(single, &cipher[(SIZE_T)i * cbSector], cbSector) != 0)
+		{
+			bMatch = FALSE;
+		}
+	}
+	AesXtsDecryptSectors(pContext, FirstSector, cipher, cbSector, nSectors, out, dwThreads);
+	if (memcmp(in, out, cbTotal) != 0)
+	{
+		bMatch = FALSE;
+	}
+
+	printf("%-21s = %u sectors x %u bytes, %u threads\r\n", "Batch (XTS)", nSectors, cbSector, dwThreads);
+	printf("%-21s = %s\r\n", "Result", bMatch ? "match" : "mismatch");
+
+	SecureZeroMemory(pContext, sizeof(AES_XTS_CONTEXT));
+	CiphFree(pContext);
+	CiphFree(single);
+	CiphFree(in);
+	CiphFree(cipher);
+	CiphFree(out);
+
+	return;
+}
 
-	for (i = 0; i < Nb; i++)
+VOID WINAPI AesOcbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* Key, DWORD cbTag)
+{
+	BYTE* cipher, * out;
+	BYTE Tag[16];
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	BOOL bResult;
+	AES_OCB_CONTEXT* pContext;
+
+	PrintBytes("Cipher Key", Key, Nk * 4);
+	PrintBytes("Nonce", Nonce, cbNonce);
+	PrintBytes("AAD", AAD, cbAAD);
+	PrintBytes("Input", in, cbIn);
+
+	cipher = (BYTE*)CiphAlloc(cbIn + 1);
+	out = (BYTE*)CiphAlloc(cbIn + 1);
+	pContext = (AES_OCB_CONTEXT*)CiphAlloc(sizeof(AES_OCB_CONTEXT));
+
+	// AES-OCB Í
+	AesOcbInit(Key, CurrentAESBitLength, cbTag, pContext);
+	AesOcbEncrypt(pContext, Nonce, cbNonce, AAD, cbAAD, in, cbIn, cipher, Tag, 1);
+	PrintBytes("Cipher Text (OCB)", cipher, cbIn);
+	PrintBytes("Tag", Tag, cbTag);
+
+	// AES-OCB 
+	bResult = AesOcbDecrypt(pContext, Nonce, cbNonce, AAD, cbAAD, cipher, cbIn, Tag, out, 1);
+	if (bResult)
+	{
+		PrintBytes("Output", out, cbIn);
+	}
+	else
 	{
-		Temp[0] = GFMultiplication(0x02, State[i * Nb]) ^ GFMultiplication(0x03, State[i * Nb + 1]) ^ State[i * Nb + 2] ^ State[i * Nb + 3];
-		Temp[1] = State[i * Nb] ^ GFMultiplication(0x02, State[i * Nb + 1]) ^ GFMultiplication(0x03, State[i * Nb + 2]) ^ State[i * Nb + 3];
-		Temp[2] = State[i * Nb] ^ State[i * Nb + 1] ^ GFMultiplication(0x02, State[i * Nb + 2]) ^ GFMultiplication(0x03, State[i * Nb + 3]);
-		Temp[3] = GFMultiplication(0x03, State[i * Nb]) ^ State[i * Nb + 1] ^ State[i * Nb + 2] ^ GFMultiplication(0x02, State[i * Nb + 3]);
-		memcpy(&State[i * Nb], Temp, sizeof(Temp));
+		printf("%-21s = (authentication failed)\r\n", "Output");
 	}
 
+	SecureZeroMemory(pContext, sizeof(AES_OCB_CONTEXT));
+	CiphFree(pContext);
+	CiphFree(cipher);
+	CiphFree(out);
+
 	return;
 }
 
-// InvMixColumns ֐
-// State 񂲂Ƃɑ삵Ăꂼɏs
-// ̂悤ȍšvZs
-// |S'0,c|   |0e 0b 0d 09| |S0,c|
-// |S'1,c| = |09 0e 0b 0d| |S1,c|
-// |S'2,c|   |0d 09 0e 0b| |S2,c|
-// |S'3,c|   |0b 0d 09 0e| |S3,c|
-VOID WINAPI InvMixColumns(BYTE* State) // 4 * Nb
+// RFC 7253 Appendix A ̑S̑gݍ킹AÍvZF؃^O
+// K = 0^(KEYLEN-8) || num2str(TAGLEN, 8) ƂāAi = 0 ` 127 ɂ
+// S = 0^(8i) ̈Í (N = 3i+1, A = S), (N = 3i+2, A = ), (N = 3i+3, P = ) ̏o͂AA
+// Ō N = 385 ŘAŜ AAD Ƃċ̕Í
+VOID WINAPI AesOcbIterativeTest(DWORD cbTag)
 {
-	BYTE i, Temp[4];
-	const BYTE Nb = 4;
+	DWORD i, j, cbC = 0;
+	BYTE Key[32] = { 0 }, Nonce[12] = { 0 }, S[128] = { 0 }, Tag[16];
+	BYTE* C;
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	AES_OCB_CONTEXT* pContext;
+
+	C = (BYTE*)CiphAlloc(128 * (3 * 16 + 2 * 127));
+	pContext = (AES_OCB_CONTEXT*)CiphAlloc(sizeof(AES_OCB_CONTEXT));
+
+	Key[Nk * 4 - 1] = (BYTE)(cbTag * 8);
+	AesOcbInit(Key, CurrentAESBitLength, cbTag, pContext);
 
-	for (i = 0; i < Nb; i++)
+	for (i = 0; i < 128; i++)
 	{
-		Temp[0] = GFMultiplication(0x0e, State[i * Nb]) ^ GFMultiplication(0x0b, State[i * Nb + 1]) ^ GFMultiplication(0x0d, State[i * Nb + 2]) ^ GFMultiplication(0x09, State[i * Nb + 3]);
-		Temp[1] = GFMultiplication(0x09, State[i * Nb]) ^ GFMultiplication(0x0e, State[i * Nb + 1]) ^ GFMultiplication(0x0b, State[i * Nb + 2]) ^ GFMultiplication(0x0d, State[i * Nb + 3]);
-		Temp[2] = GFMultiplication(0x0d, State[i * Nb]) ^ GFMultiplication(0x09, State[i * Nb + 1]) ^ GFMultiplication(0x0e, State[i * Nb + 2]) ^ GFMultiplication(0x0b, State[i * Nb + 3]);
-		Temp[3] = GFMultiplication(0x0b, State[i * Nb]) ^ GFMultiplication(0x0d, State[i * Nb + 1]) ^ GFMultiplication(0x09, State[i * Nb + 2]) ^ GFMultiplication(0x0e, State[i * Nb + 3]);
-		memcpy(&State[i * Nb], Temp, sizeof(Temp));
+		for (j = 1; j <= 3; j++)
+		{
+			Nonce[10] = (BYTE)((3 * i + j) >> 8);
+			Nonce[11] = (BYTE)(3 * i + j);
+			if (j == 1)
+			{
+				AesOcbEncrypt(pContext, Nonce, 12, S, i, S, i, &C[cbC], &C[cbC + i], 1);
+				cbC += i + cbTag;
+			}
+			else if (j == 2)
+			{
+				AesOcbEncrypt(pContext, Nonce, 12, NULL, 0, S, i, &C[cbC], &C[cbC + i], 1);
+				cbC += i + cbTag;
+			}
+			else
+			{
+				AesOcbEncrypt(pContext, Nonce, 12, S, i, NULL, 0, NULL, &C[cbC], 1);
+				cbC += cbTag;
+			}
+		}
 	}
 
+	Nonce[10] = (BYTE)(385 >> 8);
+	Nonce[11] = (BYTE)385;
+	AesOcbEncrypt(pContext, Nonce, 12, C, cbC, NULL, 0, NULL, Tag, 1);
+
+	printf("%-21s = AES-%u, TAGLEN %u\r\n", "Iterative Test (OCB)", Nk * 32, cbTag * 8);
+	PrintBytes("Tag", Tag, cbTag);
+
+	SecureZeroMemory(pContext, sizeof(AES_OCB_CONTEXT));
+	CiphFree(pContext);
+	CiphFree(C);
+
 	return;
 }
 
-// Figure 10.  AddRoundKey() XORs each column of the State with a word from the key schedule.
-// AddRoundKey ֐
-// word  round key  state  xor vZ
-VOID WINAPI AddRoundKey(BYTE* State, // 4 * Nb
-	DWORD* W)
+// Xbhŏʂ 1 Xbhŏʂƈv邩mF
+VOID WINAPI AesOcbParallelEncryptDecrypt(BYTE* Key, DWORD cbIn, DWORD dwThreads)
 {
-	BYTE i;
-	DWORD* pState = (DWORD*)State;
-	const BYTE Nb = 4;
+	DWORD i;
+	BYTE Nonce[12] = { 0 }, Tag1[16], Tag2[16];
+	BYTE* in, * cipher1, * cipher2, * out;
+	BOOL bMatch;
+	AES_OCB_CONTEXT* pContext;
+
+	in = (BYTE*)CiphAlloc(cbIn);
+	cipher1 = (BYTE*)CiphAlloc(cbIn);
+	cipher2 = (BYTE*)CiphAlloc(cbIn);
+	out = (BYTE*)CiphAlloc(cbIn);
+	pContext = (AES_OCB_CONTEXT*)CiphAlloc(sizeof(AES_OCB_CONTEXT));
 
-	for (i = 0; i < Nb; i++) {
-		pState[i] ^= W[i];
+	for (i = 0; i < cbIn; i++)
+	{
+		in[i] = (BYTE)i;
 	}
 
+	AesOcbInit(Key, CurrentAESBitLength, 16, pContext);
+	AesOcbEncrypt(pContext, Nonce, 12, in, cbIn, in, cbIn, cipher1, Tag1, 1);
+	AesOcbEncrypt(pContext, Nonce, 12, in, cbIn, in, cbIn, cipher2, Tag2, dwThreads);
+	bMatch = memcmp(cipher1, cipher2, cbIn) == 0 && memcmp(Tag1, Tag2, 16) == 0;
+	bMatch = bMatch && AesOcbDecrypt(pContext, Nonce, 12, in, cbIn, cipher2, cbIn, Tag2, out, dwThreads) && memcmp(in, out, cbIn) == 0;
+
+	printf("%-21s = %u bytes, %u threads\r\n", "Parallel (OCB)", cbIn, dwThreads);
+	printf("%-21s = %s\r\n", "Result", bMatch ? "match" : "mismatch");
+
+	SecureZeroMemory(pContext, sizeof(AES_OCB_CONTEXT));
+	CiphFree(pContext);
+	CiphFree(in);
+	CiphFree(cipher1);
+	CiphFree(cipher2);
+	CiphFree(out);
+
 	return;
 }
 
-// RotWord ֐
-// wordE]
-// a3 a2 a1 a0 -> a0 a3 a2 a1
-DWORD RotWord(DWORD word)
+VOID WINAPI AesCcmEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* Key, DWORD cbTag)
 {
-	return word << 24 | word >> 8;
+	BYTE* cipher, * out;
+	BYTE Tag[16];
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	BOOL bResult;
+	AES_CCM_CONTEXT* pContext;
+
+	PrintBytes("Cipher Key", Key, Nk * 4);
+	PrintBytes("Nonce", Nonce, cbNonce);
+	// AAD ꍇ͒̂ݕ\
+	if (cbAAD <= 64)
+	{
+		PrintBytes("AAD", AAD, cbAAD);
+	}
+	else
+	{
+		printf("%-21s = (%u bytes)\r\n", "AAD", cbAAD);
+	}
+	PrintBytes("Input", in, cbIn);
+
+	cipher = (BYTE*)CiphAlloc(cbIn + 1);
+	out = (BYTE*)CiphAlloc(cbIn + 1);
+	pContext = (AES_CCM_CONTEXT*)CiphAlloc(sizeof(AES_CCM_CONTEXT));
+
+	// AES-CCM Í
+	AesCcmInit(Key, CurrentAESBitLength, cbTag, pContext);
+	AesCcmEncrypt(pContext, Nonce, cbNonce, AAD, cbAAD, in, cbIn, cipher, Tag);
+	PrintBytes("Cipher Text (CCM)", cipher, cbIn);
+	PrintBytes("Tag", Tag, cbTag);
+
+	// AES-CCM 
+	bResult = AesCcmDecrypt(pContext, Nonce, cbNonce, AAD, cbAAD, cipher, cbIn, Tag, out);
+	if (bResult)
+	{
+		PrintBytes("Output", out, cbIn);
+	}
+	else
+	{
+		printf("%-21s = (authentication failed)\r\n", "Output");
+	}
+
+	SecureZeroMemory(pContext, sizeof(AES_CCM_CONTEXT));
+	CiphFree(pContext);
+	CiphFree(cipher);
+	CiphFree(out);
+
+	return;
 }
 
-// SubWord ֐
-// 4 oCgl 1 oCgɕꂼ SBox l擾Ǎʂ 4 oCglɂ܂Ƃ߂
-DWORD WINAPI SubWord(DWORD word)
+VOID WINAPI AesCmacGenerate(BYTE* in, DWORD cbIn, BYTE* Key)
 {
-	DWORD dwSubWord = word;
-	BYTE* pSubWord = (BYTE*)&dwSubWord;
+	BYTE Mac[16];
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	AES_CMAC_CONTEXT Context;
 
-	pSubWord[0] = SBox[pSubWord[0]];
-	pSubWord[1] = SBox[pSubWord[1]];
-	pSubWord[2] = SBox[pSubWord[2]];
-	pSubWord[3] = SBox[pSubWord[3]];
+	PrintBytes("Cipher Key", Key, Nk * 4);
+	PrintBytes("Input", in, cbIn);
 
-	return dwSubWord;
+	AesCmacInit(Key, CurrentAESBitLength, &Context);
+	AesCmac(&Context, in, cbIn, Mac);
+	PrintBytes("MAC (CMAC)", Mac, 16);
+
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
 }
 
-// i  Nk  Nb * (Nr+1) ܂ő鎞 x^(i-1) mod x^8 + x^4 + x^3 + x + 1 ̌vZʂ擾
-const DWORD RCon[] = {
-  0x00000000, // invalid
-  0x00000001, // x^0
-  0x00000002, // x^1
-  0x00000004, // x^2
-  0x00000008, // x^3
-  0x00000010, // x^4
-  0x00000020, // x^5
-  0x00000040, // x^6
-  0x00000080, // x^7
-  0x0000001B, // x^4 + x^3 + x^1 + x^0
-  0x00000036, // x^5 + x^4 + x^2 + x^1
-};
-
-// Figure 11.  Pseudo Code for Key Expansion.
-// KeyExpansion ֐
-// Í (Key)  Round Key (W) 쐬
-VOID WINAPI KeyExpansion(BYTE* Key, // 4*Nk
-	DWORD* W, // Nb*(Nr+1)
-	BYTE Nk)
+// ꊇ̌ʂ 1 bZ[WvZʂƈv邩mF
+// bZ[W 0 ` cbMax oCgł΂΂ɂ
+VOID WINAPI AesCmacBatchGenerate(BYTE* Key, DWORD nMessages, DWORD cbMax)
 {
-	BYTE i;
-	for (i = 0; i < Nk; i++)
+	DWORD i;
+	BYTE Mac[16];
+	BYTE* data, * Macs;
+	BYTE** Messages;
+	DWORD* cbMessages;
+	BOOL bMatch = TRUE;
+	AES_CMAC_CONTEXT Context;
+
+	data = (BYTE*)CiphAlloc(cbMax + 1);
+	Macs = (BYTE*)CiphAlloc(16 * (SIZE_T)nMessages);
+	Messages = (BYTE**)CiphAlloc(sizeof(BYTE*) * nMessages);
+	cbMessages = (DWORD*)CiphAlloc(sizeof(DWORD) * nMessages);
+
+	for (i = 0; i <= cbMax; i++)
 	{
-		W[i] = Key[4 * i + 3];
-		W[i] <<= 8;
-		W[i] += Key[4 * i + 2];
-		W[i] <<= 8;
-		W[i] += Key[4 * i + 1];
-		W[i] <<= 8;
-		W[i] += Key[4 * i];
+		data[i] = (BYTE)(i * 7);
 	}
-
-	const BYTE Nb = 4;
-	BYTE Nr = RoundTable[CurrentAESBitLength];
-	DWORD temp;
-
-	for (i = Nk; i < Nb * (Nr + 1); i++)
+	for (i = 0; i < nMessages; i++)
 	{
-		temp = W[i - 1];
+		cbMessages[i] = (i * 37) % (cbMax + 1);
+		Messages[i] = &data[(i * 13) % (cbMax + 1 - cbMessages[i])];
+	}
 
-		if (i % Nk == 0)
-		{
-			temp = SubWord(RotWord(temp)) ^ RCon[i / Nk];
-		}
-		else if (Nk > 6 && i % Nk == 4)
+	AesCmacInit(Key, CurrentAESBitLength, &Context);
+	AesCmacBatch(&Context, Messages, cbMessages, nMessages, Macs);
+	for (i = 0; i < nMessages; i++)
+	{
+		AesCmac(&Context, Messages[i], cbMessages[i], Mac);
+		if (memcmp(Mac, &Macs[16 * i], 16) != 0)
 		{
-			temp = SubWord(temp);
+			bMatch = FALSE;
 		}
-
-		W[i] = W[i - Nk] ^ temp;
 	}
 
+	printf("%-21s = %u messages, 0 - %u bytes\r\n", "Batch (CMAC)", nMessages, cbMax);
+	printf("%-21s = %s\r\n", "Result", bMatch ? "match" : "mismatch");
+
+	SecureZeroMemory(&Context, sizeof(Context));
+	CiphFree(data);
+	CiphFree(Macs);
+	CiphFree(Messages);
+	CiphFree(cbMessages);
+
 	return;
 }
 
-// Figure 5.  Pseudo Code for the Cipher.
-// Cipher ֐
-// AES Ís
-VOID WINAPI Cipher(BYTE* in, BYTE* out, DWORD* W)
+VOID WINAPI AesKeyWrapUnwrap(BYTE* in, DWORD cbIn, BYTE* Kek, BOOL bPadded)
 {
-	BYTE i, Nr = RoundTable[CurrentAESBitLength], state[16]; // state[4,Nb] 
-	const BYTE Nb = 4;
+	DWORD cbCipher = 0, cbOut = 0;
+	BYTE* cipher, * out;
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	AES_KEY_CONTEXT Context;
+
+	PrintBytes("KEK", Kek, Nk * 4);
+	PrintBytes("Key Data", in, cbIn);
 
-	memcpy(state, in, 4 * Nb);
+	cipher = (BYTE*)CiphAlloc(cbIn + 16);
+	out = (BYTE*)CiphAlloc(cbIn + 16);
 
-	AddRoundKey(state, &W[0]);
-	for (i = 1; i < Nr; i++) {
-		SubBytes(state);
-		ShiftRows(state);
-		MixColumns(state);
-		AddRoundKey(state, &W[Nb * i]);
+	AesKeySetup(Kek, CurrentAESBitLength, &Context);
+	AesKeyWrap(&Context, in, cbIn, bPadded, cipher, &cbCipher);
+	PrintBytes(bPadded ? "Wrapped (KWP)" : "Wrapped (KW)", cipher, cbCipher);
+
+	if (AesKeyUnwrap(&Context, cipher, cbCipher, bPadded, out, &cbOut))
+	{
+		PrintBytes("Output", out, cbOut);
+	}
+	else
+	{
+		printf("%-21s = (integrity check failed)\r\n", "Output");
 	}
-	SubBytes(state);
-	ShiftRows(state);
-	AddRoundKey(state, &W[Nb * Nr]);
 
-	memcpy(out, state, 16);
+	SecureZeroMemory(&Context, sizeof(Context));
+	CiphFree(cipher);
+	CiphFree(out);
 
 	return;
 }
 
-// Figure 12.  Pseudo Code for the Inverse Cipher.
-// InvCipher ֐
-// AES s
-VOID WINAPI InvCipher(BYTE* in, BYTE* out, DWORD* W)
+// nKeys ̌ KEK ŃbvĂꊇŃbvAV KEK Œڃbvʂƈv邩mF
+// 1 񂵂Ǎs邱ƂmF
+VOID WINAPI AesKeyRewrapBatchCheck(BYTE* OldKek, BYTE* NewKek, DWORD nKeys, BOOL bPadded)
 {
-	BYTE i, Nr = RoundTable[CurrentAESBitLength], state[16]; // state[4,Nb] 
-	const BYTE Nb = 4;
+	DWORD i, cbKey, cbWrapped, cbOffset = 0;
+	BYTE Key[64], Expected[80];
+	BYTE* data;
+	BYTE** Wrapped;
+	DWORD* cbWrappedKeys;
+	BOOL* pbResults;
+	BOOL bMatch = TRUE;
+	AES_KEY_CONTEXT OldContext, NewContext;
+
+	data = (BYTE*)CiphAlloc(80 * (SIZE_T)nKeys);
+	Wrapped = (BYTE**)CiphAlloc(sizeof(BYTE*) * nKeys);
+	cbWrappedKeys = (DWORD*)CiphAlloc(sizeof(DWORD) * nKeys);
+	pbResults = (BOOL*)CiphAlloc(sizeof(BOOL) * nKeys);
+
+	AesKeySetup(OldKek, CurrentAESBitLength, &OldContext);
+	AesKeySetup(NewKek, CurrentAESBitLength, &NewContext);
+
+	// 16, 24, 32 oCg (KWP ̏ꍇ 1 ` 64 oCg) ̌ KEK Ńbv
+	for (i = 0; i < nKeys; i++)
+	{
+		cbKey = bPadded ? i % 64 + 1 : 16 + 8 * (i % 3);
+		memset(Key, (BYTE)i, cbKey);
+		Wrapped[i] = &data[cbOffset];
+		AesKeyWrap(&OldContext, Key, cbKey, bPadded, Wrapped[i], &cbWrappedKeys[i]);
+		cbOffset += cbWrappedKeys[i];
+	}
+	Wrapped[nKeys / 2][cbWrappedKeys[nKeys / 2] - 1] ^= 1;
 
-	memcpy(state, in, 16);
+	AesKeyRewrapBatch(&OldContext, &NewContext, bPadded, Wrapped, cbWrappedKeys, nKeys, Wrapped, pbResults);
 
-	AddRoundKey(state, &W[Nb * Nr]);
-	for (i = Nr - 1; 1 <= i; i--) {
-		InvShiftRows(state);
-		InvSubBytes(state);
-		AddRoundKey(state, &W[Nb * i]);
-		InvMixColumns(state);
+	for (i = 0; i < nKeys; i++)
+	{
+		cbKey = bPadded ? i % 64 + 1 : 16 + 8 * (i % 3);
+		memset(Key, (BYTE)i, cbKey);
+		AesKeyWrap(&NewContext, Key, cbKey, bPadded, Expected, &cbWrapped);
+		if (i == nKeys / 2)
+		{
+			bMatch = bMatch && !pbResults[i];
+		}
+		else
+		{
+			bMatch = bMatch && pbResults[i] && cbWrapped == cbWrappedKeys[i] && memcmp(Expected, Wrapped[i], cbWrapped) == 0;
+		}
 	}
-	InvShiftRows(state);
-	InvSubBytes(state);
-	AddRoundKey(state, &W[0]);
 
-	memcpy(out, state, 16);
+	printf("%-21s = %u keys, 1 tampered\r\n", bPadded ? "Rewrap Batch (KWP)" : "Rewrap Batch (KW)", nKeys);
+	printf("%-21s = %s\r\n", "Result", bMatch ? "match" : "mismatch");
+
+	SecureZeroMemory(&OldContext, sizeof(OldContext));
+	SecureZeroMemory(&NewContext, sizeof(NewContext));
+	CiphFree(data);
+	CiphFree(Wrapped);
+	CiphFree(cbWrappedKeys);
+	CiphFree(pbResults);
 
 	return;
 }
 
-// AesEcbEncrypt ֐
-// EBC p AES ɂÍAs
-//              Plane Text 1                     Plane Text 2                     Plane Text N
-//                   |                                |                                |
-//                   |                                |                                |
-//                   v                                v                                v
-//       +-----------+-----------+        +-----------+-----------+        +-----------+-----------+
-// Key ->|block cipher encryption|  Key ->|block cipher encryption|  Key ->|block cipher encryption|
-//       +-----------+-----------+        +-----------+-----------+        +-----------+-----------+ 
-//                   |                                |                                |
-//                   |                                |                                |
-//                   v                                v                                v
-//              Cipher Text 1                    Cipher Text 2                   Cipher Text N
-VOID WINAPI AesEcbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out)
+// FixedEntropySource ֐
+// eXgp̃Ggs[ (pParam ̓ê܂ܕԂ)
+BOOL WINAPI FixedEntropySource(PVOID pParam, BYTE* out, DWORD cbOut)
 {
-	DWORD i, W[60];
+	memcpy(out, pParam, cbOut);
 
-	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+	return TRUE;
+}
 
-	// AES Í
-	Cipher(in, out, W);
-	for (i = 16; i < cbIn; i += 16)
+// Œ̃Ggs[ŃCX^X쐬A2 ڂ̐ʂ\ (CAVP  CTR_DRBG eXgƓ菇)
+VOID WINAPI AesCtrDrbgGenerateTest(BYTE* Entropy, BYTE* AddInput, DWORD cbAddInput, DWORD cbOut)
+{
+	BYTE* out;
+	AES_CTR_DRBG_CONTEXT Context;
+
+	out = (BYTE*)CiphAlloc(cbOut);
+
+	AesCtrDrbgInstantiate(&Context, CurrentAESBitLength, FixedEntropySource, Entropy, NULL, 0, FALSE);
+	PrintBytes("Entropy Input", Entropy, Context.cbSeed);
+	PrintBytes("Additional Input", AddInput, cbAddInput);
+
+	AesCtrDrbgGenerate(&Context, out, cbOut, AddInput, cbAddInput);
+	AesCtrDrbgGenerate(&Context, out, cbOut, AddInput, cbAddInput);
+	PrintBytes("Returned Bits", out, cbOut);
+
+	AesCtrDrbgUninstantiate(&Context);
+	CiphFree(out);
+
+	return;
+}
+
+// AesRandomBytesWorker ֐
+// eXbhg CTR_DRBG CX^X 1 MB 𐶐
+VOID WINAPI AesRandomBytesWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	BYTE* out = (BYTE*)pParam;
+	DWORD i;
+
+	for (i = dwFirst; i < dwFirst + dwCount; i++)
 	{
-		Cipher(&in[i], &out[i], W);
+		AesRandomBytes(&out[(SIZE_T)i << 20], (SIZE_T)1 << 20);
 	}
 
 	return;
 }
 
-// AesEcbDecrypt ֐
-// ECB p Aes ɂ镡s
-//              Cipher Text 1                    Cipher Text 2                   Cipher Text N
-//                   |                                |                                |
-//                   |                                |                                |
-//                   v                                v                                v
-//       +-----------+-----------+        +-----------+-----------+        +-----------+-----------+
-// Key ->|block cipher decryption|  Key ->|block cipher decryption|  Key ->|block cipher decryption|
-//       +-----------+-----------+        +-----------+-----------+        +-----------+-----------+ 
-//                   |                                |                                |
-//                   |                                |                                |
-//                   v                                v                                v
-//              Plane Text 1                    Plane Text 2                     Plane Text N
-VOID WINAPI AesEcbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out)
+// Xbh̃CX^XƗ𐶐邱ƂmF
+VOID WINAPI AesRandomBytesParallel(DWORD dwThreads)
 {
-	DWORD i, W[60];
+	DWORD i, j;
+	BYTE* out;
+	BOOL bDistinct = TRUE;
 
-	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+	out = (BYTE*)CiphAlloc((SIZE_T)dwThreads << 20);
 
-	// AES 
-	InvCipher(in, out, W);
-	for (i = 16; i < cbIn; i += 16)
+	RunParallel(AesRandomBytesWorker, out, dwThreads, dwThreads);
+	for (i = 0; i < dwThreads; i++)
 	{
-		InvCipher(&in[i], &out[i], W);
+		for (j = i + 1; j < dwThreads; j++)
+		{
+			if (memcmp(&out[(SIZE_T)i << 20], &out[(SIZE_T)j << 20], 16) == 0)
+			{
+				bDistinct = FALSE;
+			}
+		}
 	}
 
+	printf("%-21s = %u threads x 1 MB\r\n", "Per-thread DRBG", dwThreads);
+	printf("%-21s = %s\r\n", "Result", bDistinct ? "distinct" : "duplicated");
+
+	CiphFree(out);
+
 	return;
 }
 
-VOID WINAPI Xor(BYTE* in1, BYTE* in2, DWORD cbIn, BYTE* out)
+// FPE ̃eXgŎgp鐔ƕ̑Ή ( 36 ܂)
+CONST CHAR FpeAlphabet[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// FpeToNumerals ֐
+// 𐔎̗ɕϊAԂ
+DWORD WINAPI FpeToNumerals(CONST CHAR* Text, WORD* X)
 {
 	DWORD i;
 
-	for (i = 0; i < cbIn; i++)
+	for (i = 0; Text[i] != '\0'; i++)
 	{
-		out[i] = in1[i] ^ in2[i];
+		X[i] = (WORD)(strchr(FpeAlphabet, Text[i]) - FpeAlphabet);
 	}
 
-	return;
+	return i;
 }
 
-// AesCbcEncrypt ֐
-// CBC p AES ɂÍs
-//               Plane Text 1                      Plane Text 2                          Plane Text N
-//                   |                                 |                                      |
-// IV --------------xor            +------------------xor                 +------------------xor
-//                   |             |                   |                  |                   |
-//                   v             |                   v                  |                   v
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
-// Key ->|block cipher encryption| | Key ->|block cipher encryption|      | Key ->|block cipher encryption|
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
-//                   |             |                   |                  |                   |
-//                   +-------------+                   +---------- ...  --+                   |
-//                   |                                 |                                      |
-//                   v                                 v                                      v
-//              Cipher Text 1                     Cipher Text 2                         Cipher Text N
-VOID WINAPI AesCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out)
+// FpeToText ֐
+// ̗𕶎ɕϊ
+VOID WINAPI FpeToText(WORD* X, DWORD n, CHAR* Text)
 {
-	DWORD i, W[60];
-	BYTE inTemp[16], outTemp[16];
-
-	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+	DWORD i;
 
-	// AES-CBC ɂÍ
-	Xor(in, IV, 16, inTemp);
-	Cipher(inTemp, outTemp, W);
-	memcpy(out, outTemp, 16);
-	for (i = 16; i < cbIn; i += 16)
+	for (i = 0; i < n; i++)
 	{
-		Xor(&in[i], outTemp, 16, inTemp);
-		Cipher(inTemp, outTemp, W);
-		memcpy(&out[i], outTemp, 16);
+		Text[i] = FpeAlphabet[X[i]];
 	}
+	Text[n] = '\0';
 
 	return;
 }
 
-// AesCbcDecrypt ֐
-// CBC p Aes ɂ镡s
-//              Cipher Text 1                     Cipher Text 2                         Cipher Text N
-//                   |                                 |                                      |
-//                   +-------------+                   +---------- ...  --+                   |
-//                   |             |                   |                  |                   |
-//                   v             |                   v                  |                   v
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
-// Key ->|block cipher decryption| | Key ->|block cipher decryption|      | Key ->|block cipher decryption|
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
-//                   |             |                   |                  |                   |
-// IV --------------xor            +------------------xor                 +------------------xor
-//                   |                                 |                                      |
-//                   v                                 v                                      v
-//              Plane Text 1                      Plane Text 2                          Plane Text N
-VOID WINAPI AesCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out)
+// FF1 ɂÍƕ
+VOID WINAPI AesFf1EncryptDecrypt(BYTE* Key, DWORD dwRadix, BYTE* Tweak, DWORD cbTweak, CONST CHAR* Plain)
 {
-	DWORD i, W[60];
-	BYTE inTemp[16], outTemp[16];
+	WORD X[FPE_MAX_LEN];
+	CHAR Text[FPE_MAX_LEN + 1];
+	DWORD n;
+	AES_FF1_CONTEXT* pContext;
 
-	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+	pContext = (AES_FF1_CONTEXT*)CiphAlloc(sizeof(AES_FF1_CONTEXT));
+	AesFf1Init(Key, CurrentAESBitLength, dwRadix, Tweak, cbTweak, pContext);
 
-	// AES-CBC ɂ镡
-	InvCipher(in, inTemp, W);
-	Xor(inTemp, IV, 16, outTemp);
-	memcpy(out, outTemp, 16);
-	for (i = 16; i < cbIn; i += 16)
-	{
-		InvCipher(&in[i], inTemp, W);
-		Xor(&in[i - 16], inTemp, 16, outTemp);
-		memcpy(&out[i], outTemp, 16);
-	}
+	n = FpeToNumerals(Plain, X);
+	printf("%-21s = %u\r\n", "Radix", dwRadix);
+	PrintBytes("Tweak", Tweak, cbTweak);
+	printf("%-21s = %s\r\n", "PlainText", Plain);
+
+	AesFf1Encrypt(pContext, X, n, X);
+	FpeToText(X, n, Text);
+	printf("%-21s = %s\r\n", "CipherText", Text);
+
+	AesFf1Decrypt(pContext, X, n, X);
+	FpeToText(X, n, Text);
+	printf("%-21s = %s\r\n", "Decrypted", Text);
+
+	SecureZeroMemory(pContext, sizeof(AES_FF1_CONTEXT));
+	CiphFree(pContext);
 
 	return;
 }
 
-// AesCfbEncrypt ֐
-// CFB p AES ɂÍs
-// IV ---------------+------------>+-------------------+---------- ... -->+-------------------+ 
-//                   |             |                   |                  |                   |
-//                   |             |        (block - segment bits)        |        (block - segment bits)
-//                   v             |                   v                  |                   v
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
-//       |Input Block 1          | |       |Input Block 2          |      |       |Input Block N          |
-//       |(128 bits)             | |       |(128 - s bits)|(s bits)|      |       |(128 - s bits)|(s bits)|
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
-// Key ->|block cipher encryption| | Key ->|block cipher encryption|      | Key ->|block cipher encryption|
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
-//                   |             |                   |                  |                   |
-// Plane Text 1 ----xor            |  Plane Text 2 ---xor                 |   Plane Text N --xor
-//   (Segment Bits)  |             |   (Segment Bits)  |                  |   (Segment Bits)  |
-//                   |             |                   |                  |                   |
-//                   +-------------+                   +---------- ...  --+                   |
-//                   |                                 |                                      |
-//                   v                                 v                                      v
-//         Cipher Text 1 (s bits)            Cipher Text 2 (s bits)                 Cipher Text N (s bits)
-VOID WINAPI AesCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE cbitSegment, BYTE* out)
+// FF3-1 ɂÍƕ
+// Expected  NULL łȂꍇ͈ÍƔr (56 rbg̒l T_L, T_R ւ̊̕mF)
+VOID WINAPI AesFf3EncryptDecrypt(BYTE* Key, DWORD dwRadix, BYTE* Tweak, CONST CHAR* Plain, CONST CHAR* Expected)
 {
-	DWORD i, cbSegment, cbRemain, W[60];
-	BYTE inTemp[16], MsgTemp[16], outTemp[16], * pInCurrent, temp, sbits, bitsCurrent, bitOr;
-
-	// Segment Bits  IV (16 oCg) 𒴂ĂꍇA 0 ̏ꍇI
-	if (cbitSegment > 128 || cbitSegment == 0)
-	{
-		return;
-	}
-
-	// ̓f[^TCY Segment Bits ̔{ŖꍇI
-	if ((cbIn * 8) % cbitSegment != 0)
+	WORD X[FPE_MAX_LEN];
+	CHAR Text[FPE_MAX_LEN + 1];
+	DWORD n;
+	AES_FF3_CONTEXT Context;
+
+	AesFf3Init(Key, CurrentAESBitLength, dwRadix, Tweak, &Context);
+
+	n = FpeToNumerals(Plain, X);
+	printf("%-21s = %u\r\n", "Radix", dwRadix);
+	PrintBytes("Tweak", Tweak, 7);
+	printf("%-21s = %s\r\n", "PlainText", Plain);
+
+	AesFf3Encrypt(&Context, X, n, X);
+	FpeToText(X, n, Text);
+	printf("%-21s = %s\r\n", "CipherText", Text);
+	if (Expected != NULL)
 	{
-		return;
+		printf("%-21s = %s\r\n", "Result", strcmp(Text, Expected) == 0 ? "match" : "mismatch");
 	}
 
-	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+	AesFf3Decrypt(&Context, X, n, X);
+	FpeToText(X, n, Text);
+	printf("%-21s = %s\r\n", "Decrypted", Text);
 
-	if (cbitSegment % 8 == 0) // Segment Bits  8 ̔{ (oCg) łꍇ
-	{
-		cbSegment = cbitSegment / 8;
+	SecureZeroMemory(&Context, sizeof(Context));
 
-		// AES-CFB ɂÍ
-		Cipher(IV, inTemp, W);
-		Xor(in, inTemp, cbSegment, outTemp); // Segment Bits  xor
-		memcpy(out, outTemp, cbSegment);// ʂo͗pobt@ɃRs[
+	return;
+}
 
-		// ZOg IV VtgAZOg}ē̓f[^쐬
-		if (cbSegment != 16)
-		{
-			memcpy(inTemp, &IV[cbSegment], 16 - cbSegment);
-			memcpy(&inTemp[16 - cbSegment], outTemp, cbSegment);
-		}
-		else
+// ̈قȂ nRecords ̃R[hꊇŏA1 R[hʂƈv邱ƁAɖ߂邱ƂmF
+VOID WINAPI AesFpeBatchCheck(BYTE* Key, BYTE* Tweak, DWORD nRecords)
+{
+	DWORD i, j;
+	WORD* data, * Batch, * Single;
+	WORD** In, ** Out;
+	DWORD* n;
+	BOOL bFf1Match = TRUE, bFf3Match = TRUE;
+	AES_FF1_CONTEXT* pFf1;
+	AES_FF3_CONTEXT Ff3;
+
+	pFf1 = (AES_FF1_CONTEXT*)CiphAlloc(sizeof(AES_FF1_CONTEXT));
+	data = (WORD*)CiphAlloc(sizeof(WORD) * 32 * nRecords);
+	Batch = (WORD*)CiphAlloc(sizeof(WORD) * 32 * nRecords);
+	Single = (WORD*)CiphAlloc(sizeof(WORD) * 32);
+	In = (WORD**)CiphAlloc(sizeof(WORD*) * nRecords);
+	Out = (WORD**)CiphAlloc(sizeof(WORD*) * nRecords);
+	n = (DWORD*)CiphAlloc(sizeof(DWORD) * nRecords);
+
+	AesFf1Init(Key, CurrentAESBitLength, 10, Tweak, 7, pFf1);
+	AesFf3Init(Key, CurrentAESBitLength, 10, Tweak, &Ff3);
+
+	// 6 ` 28  (FF3-1 ̊ 10 ̍ő咷 56)
+	for (i = 0; i < nRecords; i++)
+	{
+		n[i] = 6 + (i * 7) % 23;
+		In[i] = &data[32 * i];
+		Out[i] = &Batch[32 * i];
+		for (j = 0; j < n[i]; j++)
 		{
-			memcpy(inTemp, outTemp, cbSegment);
+			In[i][j] = (WORD)((i * 31 + j * 17) % 10);
 		}
+	}
 
-		for (cbRemain = cbIn - cbSegment, pInCurrent = &in[cbSegment]; cbRemain > 0; cbRemain -= cbSegment, pInCurrent += cbSegment)
+	AesFf1EncryptBatch(pFf1, In, n, nRecords, Out);
+	for (i = 0; i < nRecords; i++)
+	{
+		AesFf1Encrypt(pFf1, In[i], n[i], Single);
+		if (memcmp(Single, Out[i], sizeof(WORD) * n[i]) != 0)
 		{
-			Cipher(inTemp, MsgTemp, W); // Ǒʂ쐬̓f[^ AES Í
-			Xor(pInCurrent, MsgTemp, cbSegment, outTemp); // ʂƕ XOR
-			memcpy(&out[cbIn - cbRemain], outTemp, cbSegment); // ʂo͗pobt@ɃRs[
-
-			// ZOg̓f[^VtgAZOg}ē̓f[^쐬
-			if (cbSegment != 16)
-			{
-				memcpy(inTemp, &inTemp[cbSegment], 16 - cbSegment);
-				memcpy(&inTemp[16 - cbSegment], outTemp, cbSegment);
-			}
-			else
-			{
-				memcpy(inTemp, outTemp, cbSegment);
-			}
+			bFf1Match = FALSE;
 		}
 	}
-	else if (8 % cbitSegment == 0) // Segment Bits  1, 2, 4 ̏ꍇ
+	AesFf1DecryptBatch(pFf1, Out, n, nRecords, Out);
+	if (memcmp(data, Batch, sizeof(WORD) * 32 * nRecords) != 0)
 	{
-		// AES-CFB ɂÍ
-		Cipher(IV, outTemp, W);
-		sbits = (in[0] ^ outTemp[0]) >> (8 - cbitSegment); // Segment Bits  xor
+		bFf1Match = FALSE;
+	}
 
-		bitOr = 1;
-		for (i = 1; i < cbitSegment; i++)
+	AesFf3EncryptBatch(&Ff3, In, n, nRecords, Out);
+	for (i = 0; i < nRecords; i++)
+	{
+		AesFf3Encrypt(&Ff3, In[i], n[i], Single);
+		if (memcmp(Single, Out[i], sizeof(WORD) * n[i]) != 0)
 		{
-			bitOr <<= 1;
-			bitOr++;
+			bFf3Match = FALSE;
 		}
+	}
+	AesFf3DecryptBatch(&Ff3, Out, n, nRecords, Out);
+	if (memcmp(data, Batch, sizeof(WORD) * 32 * nRecords) != 0)
+	{
+		bFf3Match = FALSE;
+	}
 
-		// ZOg̓f[^VtgAZOg}ē̓f[^쐬
-		for (i = 0; i < 15; i++)
-		{
-			inTemp[i] = IV[i] << cbitSegment;
-			inTemp[i] |= IV[i + 1] >> (8 - cbitSegment);
-		}
-		inTemp[15] = IV[15] << cbitSegment;
-		inTemp[15] |= sbits;
+	printf("%-21s = %u records\r\n", "FPE Batch", nRecords);
+	printf("%-21s = %s\r\n", "FF1 Result", bFf1Match ? "match" : "mismatch");
+	printf("%-21s = %s\r\n", "FF3-1 Result", bFf3Match ? "match" : "mismatch");
 
-		bitsCurrent = cbitSegment;
-		temp = sbits;
-		for (cbRemain = cbIn; cbRemain > 0; cbRemain--)
-		{
-			while (bitsCurrent < 8)
-			{
-				Cipher(inTemp, outTemp, W);
-
-				sbits = (((in[cbIn - cbRemain] << bitsCurrent) ^ outTemp[0]) >> (8 - cbitSegment)) & bitOr; // Segment Bits  xor
-				temp <<= cbitSegment;
-				temp |= sbits;
-				bitsCurrent += cbitSegment;
-
-				// ZOg̓f[^VtgAZOg}ē̓f[^쐬
-				for (i = 0; i < 15; i++)
-				{
-					inTemp[i] = inTemp[i] << cbitSegment;
-					inTemp[i] |= inTemp[i + 1] >> (8 - cbitSegment);
-				}
-				inTemp[15] = inTemp[15] << cbitSegment;
-				inTemp[15] |= sbits;
-			}
-			out[cbIn - cbRemain] = temp;
-			temp = 0;
-			bitsCurrent = 0;
-		}
+	SecureZeroMemory(pFf1, sizeof(AES_FF1_CONTEXT));
+	SecureZeroMemory(&Ff3, sizeof(Ff3));
+	CiphFree(pFf1);
+	CiphFree(data);
+	CiphFree(Batch);
+	CiphFree(Single);
+	CiphFree(In);
+	CiphFree(Out);
+	CiphFree(n);
+
+	return;
+}
+
+VOID WINAPI AesDukptGenerate(BYTE* Bdk, BYTE* Ksn, DWORD dwFirst, DWORD dwLast)
+{
+	DWORD dwCounter;
+	BYTE InitialKey[32], Key[32], CurrentKsn[12];
+	BYTE Nk = KeyTable[CurrentAESBitLength];
+	AES_DUKPT_BDK_CONTEXT BdkContext;
+	AES_DUKPT_CONTEXT Context;
+
+	PrintBytes("BDK", Bdk, Nk * 4);
+
+	AesDukptBdkSetup(Bdk, CurrentAESBitLength, &BdkContext);
+	AesDukptDeriveInitialKey(&BdkContext, Ksn, InitialKey);
+	AesDukptInit(InitialKey, CurrentAESBitLength, Ksn, &Context);
+	PrintBytes("Initial Key", InitialKey, Nk * 4);
+
+	memcpy(CurrentKsn, Ksn, 8);
+	for (dwCounter = dwFirst; dwCounter <= dwLast; dwCounter++)
+	{
+		CurrentKsn[8] = (BYTE)(dwCounter >> 24);
+		CurrentKsn[9] = (BYTE)(dwCounter >> 16);
+		CurrentKsn[10] = (BYTE)(dwCounter >> 8);
+		CurrentKsn[11] = (BYTE)dwCounter;
+		PrintBytes("KSN", CurrentKsn, 12);
+
+		AesDukptDeriveKey(&Context, dwCounter, AES_DUKPT_USAGE_PIN, AES_DUKPT_KEY_AES128, Key);
+		PrintBytes("PIN Key (AES-128)", Key, 16);
+		AesDukptDeriveKey(&Context, dwCounter, AES_DUKPT_USAGE_MAC_GENERATION, AES_DUKPT_KEY_AES128, Key);
+		PrintBytes("MAC Key (AES-128)", Key, 16);
+		AesDukptDeriveKey(&Context, dwCounter, AES_DUKPT_USAGE_DATA_BOTH, AES_DUKPT_KEY_2TDEA, Key);
+		PrintBytes("Data Key (2TDEA)", Key, 16);
 	}
 
+	SecureZeroMemory(InitialKey, 32);
+	SecureZeroMemory(Key, 32);
+	SecureZeroMemory(&BdkContext, sizeof(BdkContext));
+	SecureZeroMemory(&Context, sizeof(Context));
+
 	return;
 }
 
-// AesCfbDecrypt ֐
-// CFB p Aes ɂ镡s
-// IV ---------------+------------>+-------------------+------------->+--- ... -----------+ 
-//                   |             |                   |              |                   |
-//                   |             |        (block - segment bits)    |        (block - segment bits)
-//                   v             |                   v              |                   v
-//       +-----------+-----------+ |       +-----------+-----------+  |       +-----------+-----------+
-//       |Input Block 1          | |       |Input Block 2          |  |       |Input Block N          |
-//       |(128 bits)             | |       |(128 - s bits)|(s bits)|  |       |(128 - s bits)|(s bits)|
-//       +-----------+-----------+ |       +-----------+-----------+  |       +-----------+-----------+
-// Key ->|block cipher encryption| | Key ->|block cipher encryption|  | Key ->|block cipher encryption|
-//       +-----------+-----------+ |       +-----------+-----------+  |       +-----------+-----------+ 
-//                   |             |                   |              |                   |
-//                   |             |                   |              |                   |
-//                   |             |                   |              |                   |
-//                  xor------ Cipher Text 1           xor----- Cipher Text 2             xor----- Cipher Text N
-//                   |                                 |                                  |
-//                   v                                 v                                  v
-//              Plane Text 1                      Plane Text 2                       Plane Text N
-VOID WINAPI AesCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE cbitSegment, BYTE* out)
+// ꊇǒʂ KSN ɏ瓱oʂƈv邩mF
+// nDevices ̒[ KSN (JE^ 0 ` 65535) ΂΂̏ nKsns ׂ
+VOID WINAPI AesDukptBatchCheck(BYTE* Bdk, BYTE* Ksn, DWORD nDevices, DWORD nKsns)
 {
-	DWORD i, cbSegment, cbRemain, W[60];
-	BYTE inTemp[16], MsgTemp[16], outTemp[16], * pInCurrent, temp, sbits, bitsCurrent, bitOr;
+	DWORD i, dwCounter;
+	BYTE InitialKey[32], Key[32];
+	BYTE* Ksns, * Keys;
+	BOOL bMatch = TRUE;
+	AES_DUKPT_BDK_CONTEXT BdkContext;
+	AES_DUKPT_CONTEXT Context;
 
-	// Segment Bits  IV (16 oCg) 𒴂ĂꍇA 0 ̏ꍇI
-	if (cbitSegment > 128 || cbitSegment == 0)
+	Ksns = (BYTE*)CiphAlloc(12 * (SIZE_T)nKsns);
+	Keys = (BYTE*)CiphAlloc(32 * (SIZE_T)nKsns);
+
+	for (i = 0; i < nKsns; i++)
 	{
-		return;
+		dwCounter = (DWORD)(i * 2654435761UL) >> 16;
+		memcpy(&Ksns[12 * i], Ksn, 8);
+		Ksns[12 * i + 7] ^= (BYTE)((i * 7) % nDevices);
+		Ksns[12 * i + 10] = (BYTE)(dwCounter >> 8);
+		Ksns[12 * i + 11] = (BYTE)dwCounter;
 	}
 
-	// ̓f[^TCY Segment Bits ̔{ŖꍇI
-	if ((cbIn * 8) % cbitSegment != 0)
+	AesDukptBdkSetup(Bdk, CurrentAESBitLength, &BdkContext);
+	AesDukptDeriveBatch(&BdkContext, Ksns, nKsns, AES_DUKPT_USAGE_PIN, AES_DUKPT_KEY_AES256, Keys);
+	for (i = 0; i < nKsns; i++)
 	{
-		return;
+		AesDukptDeriveInitialKey(&BdkContext, &Ksns[12 * i], InitialKey);
+		AesDukptInit(InitialKey, CurrentAESBitLength, &Ksns[12 * i], &Context);
+		AesDukptDeriveKey(&Context, AesDukptCounter(&Ksns[12 * i]), AES_DUKPT_USAGE_PIN, AES_DUKPT_KEY_AES256, Key);
+		if (memcmp(Key, &Keys[32 * i], 32) != 0)
+		{
+			bMatch = FALSE;
+		}
 	}
 
-	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+	printf("%-21s = %u KSNs, %u devices\r\n", "Batch (DUKPT)", nKsns, nDevices);
+	printf("%-21s = %s\r\n", "Result", bMatch ? "match" : "mismatch");
 
-	if (cbitSegment % 8 == 0) // Segment Bits  8 ̔{ (oCg) łꍇ
-	{
-		cbSegment = cbitSegment / 8;
+	SecureZeroMemory(InitialKey, 32);
+	SecureZeroMemory(Key, 32);
+	SecureZeroMemory(&BdkContext, sizeof(BdkContext));
+	SecureZeroMemory(&Context, sizeof(Context));
+	SecureZeroMemory(Keys, 32 * (SIZE_T)nKsns);
+	CiphFree(Ksns);
+	CiphFree(Keys);
 
-		// AES-CFB ɂ镡
-		Cipher(IV, inTemp, W); // IV  AES Í
-		Xor(in, inTemp, cbSegment, outTemp); // Segment Bits  xor
-		memcpy(out, outTemp, cbSegment);// ʂo͗pobt@ɃRs[
+	return;
+}
 
-		// ZOg IV VtgAZOg}ē̓f[^쐬
-		if (cbSegment != 16)
-		{
-			memcpy(inTemp, &IV[cbSegment], 16 - cbSegment);
-			memcpy(&inTemp[16 - cbSegment], in, cbSegment);
-		}
-		else
-		{
-			memcpy(inTemp, in, cbSegment);
-		}
+// AesKcvGenerate ֐
+//  1  KCV \AnKeys ̌ KCV ꊇŌvZʂAƂɌvZʂƈv邱ƂmF
+//  Key ̊eoCgɌ̔ԍč
+VOID WINAPI AesKcvGenerate(BYTE* Key, DWORD nKeys)
+{
+	DWORD i, j;
+	DWORD cbKey = 4 * KeyTable[CurrentAESBitLength];
+	BYTE Zero[16] = { 0 }, Block[16];
+	BYTE* Keys, * Kcvs;
+	BOOL bMatch = TRUE;
+	AES_KEY_CONTEXT Context;
 
-		for (cbRemain = cbIn - cbSegment, pInCurrent = &in[cbSegment]; cbRemain > 0; cbRemain -= cbSegment, pInCurrent += cbSegment)
-		{
-			Cipher(inTemp, MsgTemp, W); // Ǒʂ쐬̓f[^ AES Í
-			Xor(pInCurrent, MsgTemp, cbSegment, outTemp); // ʂƕ XOR
-			memcpy(&out[cbIn - cbRemain], outTemp, cbSegment); // ʂo͗pobt@ɃRs[
+	Keys = (BYTE*)CiphAlloc(cbKey * (SIZE_T)nKeys);
+	Kcvs = (BYTE*)CiphAlloc(AES_KCV_LENGTH * (SIZE_T)nKeys);
 
-			// ZOg̓f[^VtgAZOg}ē̓f[^쐬
-			if (cbSegment != 16)
-			{
-				memcpy(inTemp, &inTemp[cbSegment], 16 - cbSegment);
-				memcpy(&inTemp[16 - cbSegment], pInCurrent, cbSegment);
-			}
-			else
-			{
-				memcpy(inTemp, pInCurrent, cbSegment);
-			}
-		}
-	}
-	else if (8 % cbitSegment == 0) // Segment Bits  1, 2, 4 ̏ꍇ
+	for (i = 0; i < nKeys; i++)
 	{
-		// AES-CFB ɂÍ
-		Cipher(IV, outTemp, W);
-		sbits = in[0] >> (8 - cbitSegment);
-
-		bitOr = 1;
-		for (i = 1; i < cbitSegment; i++)
+		for (j = 0; j < cbKey; j++)
 		{
-			bitOr <<= 1;
-			bitOr++;
+			Keys[cbKey * i + j] = (BYTE)(Key[j] + i * (j + 1));
 		}
+	}
 
-		// ZOg̓f[^VtgAZOg}ē̓f[^쐬
-		for (i = 0; i < 15; i++)
-		{
-			inTemp[i] = IV[i] << cbitSegment;
-			inTemp[i] |= IV[i + 1] >> (8 - cbitSegment);
-		}
-		inTemp[15] = IV[15] << cbitSegment;
-		inTemp[15] |= sbits;
+	AesKcvBatch(Keys, CurrentAESBitLength, nKeys, Kcvs, AES_KCV_LENGTH);
+
+	PrintBytes("Key", Key, cbKey);
+	PrintBytes("KCV", Kcvs, AES_KCV_LENGTH);
 
-		bitsCurrent = cbitSegment;
-		temp = sbits ^ (outTemp[0] >> (8 - cbitSegment)); // Segment Bits  xor
-		for (cbRemain = cbIn; cbRemain > 0; cbRemain--)
+	for (i = 0; i < nKeys; i++)
+	{
+		AesKeySetup(&Keys[cbKey * i], CurrentAESBitLength, &Context);
+		AesEncryptBlocks(&Context, Zero, Block, 1);
+		if (memcmp(Block, &Kcvs[AES_KCV_LENGTH * i], AES_KCV_LENGTH) != 0)
 		{
-			while (bitsCurrent < 8)
-			{
-				Cipher(inTemp, outTemp, W);
-
-				sbits = (in[cbIn - cbRemain] >> (8 - cbitSegment - bitsCurrent)) & bitOr;
-				temp <<= cbitSegment;
-				temp |= sbits ^ (outTemp[0] >> (8 - cbitSegment)); // Segment Bits  xor
-				bitsCurrent += cbitSegment;
-
-				// ZOg̓f[^VtgAZOg}ē̓f[^쐬
-				for (i = 0; i < 15; i++)
-				{
-					inTemp[i] = inTemp[i] << cbitSegment;
-					inTemp[i] |= inTemp[i + 1] >> (8 - cbitSegment);
-				}
-				inTemp[15] = inTemp[15] << cbitSegment;
-				inTemp[15] |= sbits;
-			}
-			out[cbIn - cbRemain] = temp;
-			temp = 0;
-			bitsCurrent = 0;
+			bMatch = FALSE;
 		}
 	}
+	printf("%-21s = %u keys (%s)\r\n", "Batch (KCV)", nKeys, bMatch ? "match" : "mismatch");
+
+	SecureZeroMemory(&Context, sizeof(Context));
+	SecureZeroMemory(Keys, cbKey * (SIZE_T)nKeys);
+	CiphFree(Keys);
+	CiphFree(Kcvs);
 
 	return;
 }
 
-// AesOfbEncryptDecrypt ֐
-// OFB p AES ɂÍEs
-// EÍ
-//                  IV
-//                   |             +-------------------+                  +-------------------+
-//                   |             |                   |                  |                   |
-//                   v             |                   v                  |                   v
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
-// Key ->|block cipher encryption| | Key ->|block cipher encryption|      | Key ->|block cipher encryption|
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
-//                   |             |                   |                  |                   |
-//                   +-------------+                   +---------- ...  --+                   |
-//                   |                                 |                                      |
-// Plane Text 1 ----xor              Plane Text 1 ----xor                   Plane Text 1 ----xor
-//                   |                                 |                                      |
-//                   v                                 v                                      v
-//              Cipher Text 1                     Cipher Text 2                         Cipher Text N
-// 
-// E
-//                  IV
-//                   |             +-------------------+                  +-------------------+
-//                   |             |                   |                  |                   |
-//                   v             |                   v                  |                   v
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
-// Key ->|block cipher encryption| | Key ->|block cipher encryption|      | Key ->|block cipher encryption|
-//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
-//                   |             |                   |                  |                   |
-//                   +-------------+                   +---------- ...  --+                   |
-//                   |                                 |                                      |
-// Cipher Text 1 ---xor              Cipher Text 1 ---xor                   Cipher Text 1 ---xor
-//                   |                                 |                                      |
-//                   v                                 v                                      v
-//              Plane Text 1                      Plane Text 2                       Plane Text N
-VOID WINAPI AesOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out)
+// AesLibraryEncryptDecrypt ֐
+// Cu C C^[tF[X (CiphLib.h) p ECB, CBC, CTR ɂÍ /  CMAC s
+// CTR ͓r̃oCgʒu (Offset) 珈ʂA擪珈ʂ̓ʒuƈv邩mF
+VOID WINAPI AesLibraryEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* ICV, BYTE* Key, DWORD cbKey)
 {
-	DWORD i, W[60];
-	BYTE Temp1[16], Temp2[16];
-
-	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+	BYTE* cipher, * out;
+	BYTE Mac[16];
+	DWORD dwOffset;
+	BOOL bMatch = TRUE;
+	CIPH_AES_KEY* hKey;
+	CIPH_AES_CMAC* hCmac;
 
-	// AES-OFB ɂÍ
-	Cipher(IV, Temp1, W);
-	Xor(in, Temp1, 16, Temp2);
-	memcpy(out, Temp2, 16);
-	for (i = 16; i < cbIn; i += 16)
+	if (CiphAesCreateKey(Key, cbKey, &hKey) != CIPH_SUCCESS || CiphAesCmacCreate(Key, cbKey, &hCmac) != CIPH_SUCCESS)
 	{
-		Cipher(Temp1, Temp2, W);
-		Xor(&in[i], Temp2, 16, Temp1);
-		memcpy(&out[i], Temp1, 16);
-		memcpy(Temp1, Temp2, 16);
+		return;
 	}
 
-	return;
-}
+	cipher = (BYTE*)CiphAlloc(cbIn);
+	out = (BYTE*)CiphAlloc(cbIn);
 
-VOID WINAPI AesCtrEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* ICV, BYTE* Key, BYTE* out)
-{
-	DWORD i, W[60];
-	BYTE Temp[16], ICVCurrent[16];
-	DWORD cbCurrent;
-	ULONG64 ICVLow, ICVHigh;
+	PrintBytes("Cipher Key", Key, cbKey);
+	PrintBytes("Input", in, cbIn);
 
-	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+	CiphAesEcbEncrypt(hKey, in, cbIn, cipher);
+	CiphAesEcbDecrypt(hKey, cipher, cbIn, out);
+	PrintBytes("Cipher Text (ECB)", cipher, cbIn);
+	PrintBytes("Output", out, cbIn);
 
-	Cipher(ICV, Temp, W);
-	Xor(in, Temp, 16, out);
-	memcpy(ICVCurrent, ICV, 16);
-	for (cbCurrent = 16; cbCurrent < cbIn; cbCurrent += 16)
+	// CBC ͕𓯂obt@ōs
+	CiphAesCbcEncrypt(hKey, IV, in, cbIn, cipher);
+	PrintBytes("Cipher Text (CBC)", cipher, cbIn);
+	CiphAesCbcDecrypt(hKey, IV, cipher, cbIn, cipher);
+	PrintBytes("Output", cipher, cbIn);
+
+	CiphAesCtrCrypt(hKey, ICV, 0, in, cbIn, cipher);
+	CiphAesCtrCrypt(hKey, ICV, 0, cipher, cbIn, out);
+	PrintBytes("Cipher Text (CTR)", cipher, cbIn);
+	PrintBytes("Output", out, cbIn);
+	for (dwOffset = 1; dwOffset < cbIn; dwOffset++)
 	{
-		if (ICVCurrent[15] == 0xff)
+		CiphAesCtrCrypt(hKey, ICV, dwOffset, &in[dwOffset], cbIn - dwOffset, out);
+		if (memcmp(out, &cipher[dwOffset], cbIn - dwOffset) != 0)
 		{
-			ICVHigh = 0;
-			for (i = 0; i < 8; i++)
-			{
-				ICVHigh <<= 8;
-				ICVHigh += ICVCurrent[i];
-			}
-			ICVLow = 0;
-			for (i = 8; i < 16; i++)
-			{
-				ICVLow <<= 8;
-				ICVLow += ICVCurrent[i];
-			}
-			if (ICVLow == 0xffffffffffffffff)
-			{
-				ICVLow = 0;
-				ICVHigh++;
-			}
-			else
-			{
-				ICVLow++;
-			}
-			for (i = 0; i < 8; i++)
-			{
-				ICVCurrent[7 - i] = (BYTE)(ICVHigh & 0xff);
-				ICVHigh >>= 8;
-			}
-			for (i = 0; i < 8; i++)
-			{
-				ICVCurrent[15 - i] = (BYTE)(ICVLow & 0xff);
-				ICVLow >>= 8;
-			}
-		}
-		else
-		{
-			ICVCurrent[15]++;
+			bMatch = FALSE;
 		}
+	}
+	printf("%-21s = %s\r\n", "Seek (CTR)", bMatch ? "match" : "mismatch");
+
+	CiphAesCmac(hCmac, in, cbIn, Mac);
+	PrintBytes("MAC (CMAC)", Mac, 16);
+
+	// ubN̔{łȂ ECB ͏ɃG[Ԃ
+	printf("%-21s = %d\r\n", "Status (ECB, 15)", CiphAesEcbEncrypt(hKey, in, 15, cipher));
+
+	CiphAesCmacDestroy(hCmac);
+	CiphAesDestroyKey(hKey);
+	CiphFree(cipher);
+	CiphFree(out);
+
+	return;
+}
+
+// AesLibraryGcm ֐
+// Cu C C^[tF[X (CiphLib.h) p GCM ɂÍ / s
+VOID WINAPI AesLibraryGcm(BYTE* in, DWORD cbIn, BYTE* IV, DWORD cbIV, BYTE* AAD, DWORD cbAAD, BYTE* Key, DWORD cbKey)
+{
+	BYTE* cipher, * out;
+	BYTE Tag[16];
+	CIPH_AES_GCM* hGcm;
+	CIPH_STATUS Status;
+
+	if (CiphAesGcmCreate(Key, cbKey, &hGcm) != CIPH_SUCCESS)
+	{
+		return;
+	}
 
-		Cipher(ICVCurrent, Temp, W);
-		Xor(&in[cbCurrent], Temp, 16, &out[cbCurrent]);
+	cipher = (BYTE*)CiphAlloc(cbIn + 1);
+	out = (BYTE*)CiphAlloc(cbIn + 1);
+
+	PrintBytes("Cipher Key", Key, cbKey);
+	PrintBytes("IV", IV, cbIV);
+	PrintBytes("AAD", AAD, cbAAD);
+	PrintBytes("Input", in, cbIn);
+
+	CiphAesGcmEncrypt(hGcm, IV, cbIV, AAD, cbAAD, in, cbIn, cipher, Tag);
+	PrintBytes("Cipher Text (GCM)", cipher, cbIn);
+	PrintBytes("Tag", Tag, 16);
+
+	Status = CiphAesGcmDecrypt(hGcm, IV, cbIV, AAD, cbAAD, cipher, cbIn, Tag, out);
+	if (Status == CIPH_SUCCESS)
+	{
+		PrintBytes("Output", out, cbIn);
 	}
+	else
+	{
+		printf("%-21s = (status %d)\r\n", "Output", Status);
+	}
+
+	Tag[0] ^= 1;
+	Status = CiphAesGcmDecrypt(hGcm, IV, cbIV, AAD, cbAAD, cipher, cbIn, Tag, out);
+	printf("%-21s = %s\r\n", "Tampered Tag", Status == CIPH_AUTHENTICATION_FAILED ? "rejected" : "accepted");
+
+	CiphAesGcmDestroy(hGcm);
+	CiphFree(cipher);
+	CiphFree(out);
 
 	return;
 }
 
-#define AES_MODE_ECB 1
-#define AES_MODE_CBC 2
-#define AES_MODE_CFB 3
-#define AES_MODE_OFB 4
-#define AES_MODE_CTR 5
-
-// AesEncryptDecrypt ֐
-// AES ɂÍƕ̃eXg
-VOID WINAPI AesEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* IVorICV, BYTE* Key, BYTE cbitSegment, DWORD dwMode)
+// AesBufferCheck ֐
+// Ɨ̈ (CiphAlloc, CiphAllocEx) ̊mF
+// 64 oCgEɑĂ邱ƁA0 ŏ邱ƁÄ悪TCYNX̊mۂōėp邱ƁA
+// TCYNX傫̈ (cbLarge oCg) [Wy[WwŊmۂēǂݏł邱ƂmF
+VOID WINAPI AesBufferCheck(SIZE_T cbLarge)
 {
-	DWORD i;
-	BYTE* cipher, * out;
-	BYTE Nk = KeyTable[CurrentAESBitLength];
+	SIZE_T i, cb;
+	BYTE* p, * q;
+	BOOL bAligned = TRUE, bZeroed = TRUE, bReused = TRUE, bLarge = TRUE;
 
-	printf("%-21s = ", "Cipher Key");
-	for (i = 0; i < (DWORD)(Nk * 4); i++)
+	for (cb = 1; cb <= 0x100000; cb = cb * 3 + 1)
 	{
-		printf("%02x", Key[i]);
-		if (i % 8 == 7)
+		p = (BYTE*)CiphAllocEx(cb, CIPH_ALLOC_NO_ZERO);
+		if (p == NULL || ((ULONG_PTR)p & 63) != 0)
 		{
-			printf(" ");
+			bAligned = FALSE;
+			CiphFree(p);
+			continue;
 		}
-	}
-	printf("\r\n");
+		memset(p, 0xa5, cb);
+		CiphFree(p);
 
-	if (IVorICV != NULL)
-	{
-		printf("%-21s = ", "IV or ICV");
-		for (i = 0; i < 16; i++)
+		// Oɉ̈悪ėpACiphAlloc ł 0 ŏ
+		q = (BYTE*)CiphAlloc(cb);
+		if (q != p)
 		{
-			printf("%02x", IVorICV[i]);
-			if (i % 8 == 7)
+			bReused = FALSE;
+		}
+		for (i = 0; q != NULL && i < cb; i++)
+		{
+			if (q[i] != 0)
 			{
-				printf(" ");
+				bZeroed = FALSE;
+				break;
 			}
 		}
-		printf("\r\n");
+		CiphFree(q);
 	}
 
-	printf("%-21s = ", "Input");
-	for (i = 0; i < cbIn; i++)
+	p = (BYTE*)CiphAllocEx(cbLarge, CIPH_ALLOC_NO_ZERO | CIPH_ALLOC_LARGE_PAGES);
+	if (p == NULL || ((ULONG_PTR)p & 63) != 0)
 	{
-		printf("%02x", in[i]);
-		if (i % 8 == 7)
-		{
-			printf(" ");
-		}
+		bLarge = FALSE;
 	}
-	printf("\r\n");
-
-	if (cbitSegment != 0)
+	else
 	{
-		printf("%-21s = %u\r\n", "Segment Bits", cbitSegment);
+		memset(p, 0x5a, cbLarge);
+		bLarge = p[0] == 0x5a && p[cbLarge - 1] == 0x5a;
 	}
+	CiphFree(p);
+	CiphAllocTrim();
 
-	cipher = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-	out = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
+	printf("%-21s = %s\r\n", "Aligned (64 bytes)", bAligned ? "match" : "mismatch");
+	printf("%-21s = %s\r\n", "Zeroed", bZeroed ? "match" : "mismatch");
+	printf("%-21s = %s\r\n", "Reused", bReused ? "match" : "mismatch");
+	printf("%-21s = %u MB (%s)\r\n", "Large Pages", (DWORD)(cbLarge >> 20), bLarge ? "match" : "mismatch");
 
-	// AES Í
-	switch (dwMode)
+	return;
+}
+
+// AesDispatchCheck ֐
+// s@̑I (CiphSetDispatch) ̊mF
+// 1 ubN̏AݏA񏈗AÎꂼŁAECB, CBC ̕ (obt@), CTR (Offset = 5) ̌ʂv邱ƂmF
+// ŌɎIő肵񏈗臒l\ (1 XbhgȂꍇ͕񏈗I΂Ȃ)
+VOID WINAPI AesDispatchCheck(BYTE* Key, DWORD cbKey, BYTE* IV, BYTE* ICV, DWORD cbData, DWORD dwConcurrency)
+{
+	const DWORD Strategies[4] = { CIPH_DISPATCH_SERIAL, CIPH_DISPATCH_INTERLEAVED, CIPH_DISPATCH_THREADED, CIPH_DISPATCH_AUTO };
+	const CHAR* Labels[3] = { "Threshold (ECB)", "Threshold (CBC)", "Threshold (CTR)" };
+	DWORD Sizes[3] = { 48, 65536, cbData }, i, j;
+	BYTE* data, * Ecb, * Cbc, * Ctr, * out;
+	BOOL bMatch;
+	size_t cbThreaded;
+	CIPH_AES_KEY* hKey;
+
+	if (CiphAesCreateKey(Key, cbKey, &hKey) != CIPH_SUCCESS)
 	{
-	case AES_MODE_ECB:
-		AesEcbEncrypt(in, cbIn, Key, cipher);
-		printf("%-21s = ", "Cipher Text (AES-ECB)");
-		break;
-	case AES_MODE_CBC:
-		AesCbcEncrypt(in, cbIn, IVorICV, Key, cipher);
-		printf("%-21s = ", "Cipher Text (AES-CBC)");
-		break;
-	case AES_MODE_CFB:
-		AesCfbEncrypt(in, cbIn, IVorICV, Key, cbitSegment, cipher);
-		printf("%-21s = ", "Cipher Text (AES-CFB)");
-		break;
-	case AES_MODE_OFB:
-		AesOfbEncryptDecrypt(in, cbIn, IVorICV, Key, cipher);
-		printf("%-21s = ", "Cipher Text (AES-OFB)");
-		break;
-	case AES_MODE_CTR:
-		AesCtrEncryptDecrypt(in, cbIn, IVorICV, Key, cipher);
-		printf("%-21s = ", "Cipher Text (AES-CTR)");
-		break;
-	default:
-		break;
+		return;
 	}
-
-	for (i = 0; i < cbIn; i++)
+	CiphSetConcurrency(dwConcurrency);
+
+	data = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Ecb = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Cbc = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Ctr = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	out = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	for (i = 0; i < cbData; i++)
 	{
-		printf("%02x", cipher[i]);
-		if (i % 8 == 7)
-		{
-			printf(" ");
-		}
+		data[i] = (BYTE)(i * 31 + (i >> 11));
 	}
-	printf("\r\n");
 
-	// AES 
-	switch (dwMode)
+	printf("%-21s = %u threads\r\n", "Concurrency", dwConcurrency);
+	for (i = 0; i < 3; i++)
 	{
-	case AES_MODE_ECB:
-		AesEcbDecrypt(cipher, cbIn, Key, out);
-		break;
-	case AES_MODE_CBC:
-		AesCbcDecrypt(cipher, cbIn, IVorICV, Key, out);
-		break;
-	case AES_MODE_CFB:
-		AesCfbDecrypt(cipher, cbIn, IVorICV, Key, cbitSegment, out);
-		break;
-	case AES_MODE_OFB:
-		AesOfbEncryptDecrypt(cipher, cbIn, IVorICV, Key, out);
-		break;
-	case AES_MODE_CTR:
-		AesCtrEncryptDecrypt(cipher, cbIn, IVorICV, Key, out);
-		break;
-	default:
-		break;
+		// 1 ubNʂƂ
+		CiphSetDispatch(CIPH_DISPATCH_SERIAL);
+		CiphAesEcbEncrypt(hKey, data, Sizes[i], Ecb);
+		CiphAesCbcEncrypt(hKey, IV, data, Sizes[i], Cbc);
+		CiphAesCtrCrypt(hKey, ICV, 5, data, Sizes[i], Ctr);
+
+		bMatch = TRUE;
+		for (j = 0; j < 4; j++)
+		{
+			CiphSetDispatch(Strategies[j]);
+
+			CiphAesEcbEncrypt(hKey, data, Sizes[i], out);
+			if (memcmp(out, Ecb, Sizes[i]) != 0)
+			{
+				bMatch = FALSE;
+			}
+			CiphAesEcbDecrypt(hKey, out, Sizes[i], out);
+			if (memcmp(out, data, Sizes[i]) != 0)
+			{
+				bMatch = FALSE;
+			}
+
+			memcpy(out, Cbc, Sizes[i]);
+			CiphAesCbcDecrypt(hKey, IV, out, Sizes[i], out);
+			if (memcmp(out, data, Sizes[i]) != 0)
+			{
+				bMatch = FALSE;
+			}
+
+			CiphAesCtrCrypt(hKey, ICV, 5, data, Sizes[i], out);
+			if (memcmp(out, Ctr, Sizes[i]) != 0)
+			{
+				bMatch = FALSE;
+			}
+		}
+		printf("%-21s = %u bytes (%s)\r\n", "Dispatch", Sizes[i], bMatch ? "match" : "mismatch");
 	}
 
-	printf("%-21s = ", "Output");
-	for (i = 0; i < cbIn; i++)
+	for (i = 0; i < 3; i++)
 	{
-		printf("%02x", out[i]);
-		if (i % 8 == 7)
+		cbThreaded = CiphGetDispatchThreshold(CIPH_DISPATCH_KIND_AES_ECB + i);
+		if (cbThreaded == (size_t)-1)
 		{
-			printf(" ");
+			printf("%-21s = single thread\r\n", Labels[i]);
+		}
+		else
+		{
+			printf("%-21s = %u KB\r\n", Labels[i], (DWORD)(cbThreaded >> 10));
 		}
 	}
-	printf("\r\n");
 
-	HeapFree(GetProcessHeap(), 0, cipher);
-	HeapFree(GetProcessHeap(), 0, out);
+	// IƘ_vZbT̏ɖ߂
+	CiphSetDispatch(CIPH_DISPATCH_AUTO);
+	CiphSetConcurrency(0);
+
+	CiphAesDestroyKey(hKey);
+	CiphFree(data);
+	CiphFree(Ecb);
+	CiphFree(Cbc);
+	CiphFree(Ctr);
+	CiphFree(out);
 
 	return;
 }
@@ -1268,5 +1613,359 @@ INT main(INT argc, CHAR* argv[])
 	AesEncryptDecrypt(AesExample5_Input, AesExample5_CbInput, AesExample5_IV, AesExample5_Key3, AesExample5_SegmentLength, AES_MODE_CFB);
 	printf("\r\n");
 
+	// Example 6
+	// AES-128 (ECB, CBC) + PKCS#7 pfBO, CBC-CS1/CS2/CS3
+	// Cipher Key = 636869636B656E20 7465726979616B69 ("chicken teriyaki")
+	// IV = 00000000 00000000 00000000 00000000
+	// Input = "I would like the General Gau's C" ̐擪 17, 31, 32 oCg
+	// Tv (CS3  RFC 3962  Kerberos AES-CTS Ɠ)
+	// https://www.rfc-editor.org/rfc/rfc3962
+	// Cipher Text (CS3, 17 oCg) = c6353568f2bf8cb4 d8a580362da7ff7f 97
+	// Cipher Text (CS3, 31 oCg) = fc00783e0efdb2c1 d445d4c8eff7ed22 97687268d6ecccc0 c07b25e25ecfe5
+	// Cipher Text (CS3, 32 oCg) = 39312523a78662d5 be7fcbcc98ebf5a8 97687268d6ecccc0 c07b25e25ecfe584
+	BYTE AesExample6_Key[56] = { 0x63, 0x68, 0x69, 0x63, 0x6B, 0x65, 0x6E, 0x20, 0x74, 0x65, 0x72, 0x69, 0x79, 0x61, 0x6B, 0x69 };
+	BYTE AesExample6_IV[16] = { 0 };
+	CHAR AesExample6_Input[] = "I would like the General Gau's C";
+
+	CurrentAESBitLength = AES128;
+	AesPaddingEncryptDecrypt((BYTE*)AesExample6_Input, 17, NULL, AesExample6_Key, AES_PADDING_PKCS7, AES_MODE_ECB);
+	printf("\r\n");
+	AesPaddingEncryptDecrypt((BYTE*)AesExample6_Input, 31, AesExample6_IV, AesExample6_Key, AES_PADDING_PKCS7, AES_MODE_CBC);
+	printf("\r\n");
+	AesPaddingEncryptDecrypt((BYTE*)AesExample6_Input, 17, AesExample6_IV, AesExample6_Key, AES_PADDING_CS1, AES_MODE_CBC);
+	printf("\r\n");
+	AesPaddingEncryptDecrypt((BYTE*)AesExample6_Input, 31, AesExample6_IV, AesExample6_Key, AES_PADDING_CS2, AES_MODE_CBC);
+	printf("\r\n");
+	AesPaddingEncryptDecrypt((BYTE*)AesExample6_Input, 17, AesExample6_IV, AesExample6_Key, AES_PADDING_CS3, AES_MODE_CBC);
+	printf("\r\n");
+	AesPaddingEncryptDecrypt((BYTE*)AesExample6_Input, 31, AesExample6_IV, AesExample6_Key, AES_PADDING_CS3, AES_MODE_CBC);
+	printf("\r\n");
+	AesPaddingEncryptDecrypt((BYTE*)AesExample6_Input, 32, AesExample6_IV, AesExample6_Key, AES_PADDING_CS3, AES_MODE_CBC);
+	printf("\r\n");
+
+	// Example 7
+	// AES-GCM (128, 256)
+	// Tv (The Galois/Counter Mode of Operation (GCM)  Test Case 1 ` 6, 16)
+	// https://csrc.nist.gov/CSRC/media/Projects/Block-Cipher-Techniques/documents/BCM/proposed-modes/gcm/gcm-spec.pdf
+	// Test Case 1 : Tag = 58e2fccefa7e3061 367f1d57a4e7455a
+	// Test Case 2 : Cipher Text = 0388dace60b6a392 f328c2b971b2fe78, Tag = ab6e47d42cec13bd f53a67b21257bddf
+	// Test Case 3 : Cipher Text = 42831ec221777424 4b7221b784d0d49c e3aa212f2c02a4e0 35c17e2329aca12e
+	//                             21d514b25466931c 7d8f6a5aac84aa05 1ba30b396a0aac97 3d58e091473f5985
+	//               Tag = 4d5c2af327cd64a6 2cf35abd2ba6fab4
+	// Test Case 4 : Tag = 5bc94fbc3221a5db 94fae95ae7121a47
+	// Test Case 5 : Cipher Text = 61353b4c2806934a 777ff51fa22a4755 699b2a714fcdc6f8 3766e5f97b6c7423
+	//                             73806900e49f24b2 2b097544d4896b42 4989b5e1ebac0f07 c23f4598
+	//               Tag = 3612d2e79e3b0785 561be14aaca2fccb
+	// Test Case 6 : Cipher Text = 8ce24998625615b6 03a033aca13fb894 be9112a5c3a211a8 ba262a3cca7e2ca7
+	//                             01e4a9a4fba43c90 ccdcb281d48c7c6f d62875d2aca41703 4c34aee5
+	//               Tag = 619cc5aefffe0bfa 462af43c1699d050
+	// Test Case 16 : Cipher Text = 522dc1f099567d07 f47f37a32a84427d 643a8cdcbfe5c0c9 7598a2bd2555d1aa
+	//                              8cb08e48590dbb3d a7b08b1056828838 c5f61e6393ba7a0a bcc9f662
+	//                Tag = 76fc6ece0f4e1768 cddf8853bb2d551b
+	BYTE AesExample7_Key1[56] = { 0 };
+	BYTE AesExample7_Key2[56] = { 0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08, 0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08 };
+	BYTE AesExample7_IV1[12] = { 0 };
+	BYTE AesExample7_IV2[12] = { 0xCA, 0xFE, 0xBA, 0xBE, 0xFA, 0xCE, 0xDB, 0xAD, 0xDE, 0xCA, 0xF8, 0x88 };
+	BYTE AesExample7_IV3[60] = { 0x93, 0x13, 0x22, 0x5D, 0xF8, 0x84, 0x06, 0xE5, 0x55, 0x90, 0x9C, 0x5A, 0xFF, 0x52, 0x69, 0xAA, 0x6A, 0x7A, 0x95, 0x38, 0x53, 0x4F, 0x7D, 0xA1, 0xE4, 0xC3, 0x03, 0xD2, 0xA3, 0x18, 0xA7, 0x28, 0xC3, 0xC0, 0xC9, 0x51, 0x56, 0x80, 0x95, 0x39, 0xFC, 0xF0, 0xE2, 0x42, 0x9A, 0x6B, 0x52, 0x54, 0x16, 0xAE, 0xDB, 0xF5, 0xA0, 0xDE, 0x6A, 0x57, 0xA6, 0x37, 0xB3, 0x9B };
+	BYTE AesExample7_AAD[20] = { 0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF, 0xAB, 0xAD, 0xDA, 0xD2 };
+	BYTE AesExample7_Input1[16] = { 0 };
+	BYTE AesExample7_Input2[64] = { 0xD9, 0x31, 0x32, 0x25, 0xF8, 0x84, 0x06, 0xE5, 0xA5, 0x59, 0x09, 0xC5, 0xAF, 0xF5, 0x26, 0x9A, 0x86, 0xA7, 0xA9, 0x53, 0x15, 0x34, 0xF7, 0xDA, 0x2E, 0x4C, 0x30, 0x3D, 0x8A, 0x31, 0x8A, 0x72, 0x1C, 0x3C, 0x0C, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2F, 0xCF, 0x0E, 0x24, 0x49, 0xA6, 0xB5, 0x25, 0xB1, 0x6A, 0xED, 0xF5, 0xAA, 0x0D, 0xE6, 0x57, 0xBA, 0x63, 0x7B, 0x39, 0x1A, 0xAF, 0xD2, 0x55 };
+
+	CurrentAESBitLength = AES128;
+	AesGcmEncryptDecrypt(AesExample7_Input1, 0, AesExample7_IV1, 12, NULL, 0, AesExample7_Key1);
+	printf("\r\n");
+	AesGcmEncryptDecrypt(AesExample7_Input1, 16, AesExample7_IV1, 12, NULL, 0, AesExample7_Key1);
+	printf("\r\n");
+	AesGcmEncryptDecrypt(AesExample7_Input2, 64, AesExample7_IV2, 12, NULL, 0, AesExample7_Key2);
+	printf("\r\n");
+	AesGcmEncryptDecrypt(AesExample7_Input2, 60, AesExample7_IV2, 12, AesExample7_AAD, 20, AesExample7_Key2);
+	printf("\r\n");
+	AesGcmEncryptDecrypt(AesExample7_Input2, 60, AesExample7_IV2, 8, AesExample7_AAD, 20, AesExample7_Key2);
+	printf("\r\n");
+	AesGcmEncryptDecrypt(AesExample7_Input2, 60, AesExample7_IV3, 60, AesExample7_AAD, 20, AesExample7_Key2);
+	printf("\r\n");
+
+	CurrentAESBitLength = AES256;
+	AesGcmEncryptDecrypt(AesExample7_Input2, 60, AesExample7_IV2, 12, AesExample7_AAD, 20, AesExample7_Key2);
+	printf("\r\n");
+
+	// Example 8
+	// XTS-AES-128
+	// Tv (IEEE Std 1619-2007 Annex B  Vector 1, 2, 15, 17)
+	// Vector 1 : Cipher Text = 917cf69ebd68b2ec 9b9fe9a3eadda692 cd43d2f59598ed85 8c02c2652fbf922e
+	// Vector 2 : Cipher Text = c454185e6a16936e 39334038acef838b fb186fff7480adc4 289382ecd6d394f0
+	// Vector 15 : Cipher Text = 6c1625db4671522d 3d7599601de7ca09 ed
+	// Vector 17 : Cipher Text = e5df1351c0544ba1 350b3363cd8ef4be edbf9d
+	BYTE AesExample8_Key1[64] = { 0 };
+	BYTE AesExample8_Key2[64] = { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22 };
+	BYTE AesExample8_Key3[64] = { 0xFF, 0xFE, 0xFD, 0xFC, 0xFB, 0xFA, 0xF9, 0xF8, 0xF7, 0xF6, 0xF5, 0xF4, 0xF3, 0xF2, 0xF1, 0xF0, 0xBF, 0xBE, 0xBD, 0xBC, 0xBB, 0xBA, 0xB9, 0xB8, 0xB7, 0xB6, 0xB5, 0xB4, 0xB3, 0xB2, 0xB1, 0xB0 };
+	BYTE AesExample8_Input1[32] = { 0 };
+	BYTE AesExample8_Input2[32] = { 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44 };
+	BYTE AesExample8_Input3[19] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12 };
+
+	CurrentAESBitLength = AES128;
+	AesXtsEncryptDecrypt(AesExample8_Input1, 32, 0, AesExample8_Key1);
+	printf("\r\n");
+	AesXtsEncryptDecrypt(AesExample8_Input2, 32, 0x3333333333, AesExample8_Key2);
+	printf("\r\n");
+	AesXtsEncryptDecrypt(AesExample8_Input3, 17, 0x123456789A, AesExample8_Key3);
+	printf("\r\n");
+	AesXtsEncryptDecrypt(AesExample8_Input3, 19, 0x123456789A, AesExample8_Key3);
+	printf("\r\n");
+	AesXtsBatchEncryptDecrypt(AesExample8_Key3, 0x123456789A, 512, 256, 4);
+	printf("\r\n");
+	AesXtsBatchEncryptDecrypt(AesExample8_Key3, 0x123456789A, 4100, 37, 0);
+	printf("\r\n");
+
+	// Example 9
+	// AES-OCB (RFC 7253)
+	// Tv (RFC 7253 Appendix A)
+	// https://www.rfc-editor.org/rfc/rfc7253
+	// N = BBAA99887766554433221100 : Tag = 785407bfffc8ad9e dcc5520ac9111ee6
+	// N = BBAA99887766554433221101 : Cipher Text = 6820b3657b6f615a, Tag = 5725bda0d3b4eb3a 257c9af1f8f03009
+	// N = BBAA99887766554433221104 : Cipher Text = 571d535b60b27718 8be5147170a9a22c, Tag = 3ad7a4ff3835b8c5 701c1ccec8fc3358
+	// N = BBAA9988776655443322110F (AAD Ȃ) : Cipher Text = 4412923493c57d5d e0d700f753cce0d1 d2d95060122e9f15 a5ddbfc5787e50b5 cc55ee507bcb084e
+	//                                            Tag = 479ad363ac366b95 a98ca5f3000b1479
+	// Iterative Test : AES-128 TAGLEN 128 = 67e944d23256c5e0 b6c61fa22fdf1ea2
+	//                  AES-128 TAGLEN 96 = 77a3d8e73589158d 25d01209
+	//                  AES-128 TAGLEN 64 = 192c9b7bd90ba06a
+	//                  AES-192 TAGLEN 128 = f673f2c3e7174aae 7bae986ca9f29e17
+	//                  AES-256 TAGLEN 128 = d90eb8e9c977c88b 79dd793d7ffa161c
+	BYTE AesExample9_Key[56] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F };
+	BYTE AesExample9_Nonce[12] = { 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00 };
+	BYTE AesExample9_Input[40] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27 };
+
+	CurrentAESBitLength = AES128;
+	AesOcbEncryptDecrypt(AesExample9_Input, 0, AesExample9_Nonce, 12, AesExample9_Input, 0, AesExample9_Key, 16);
+	printf("\r\n");
+	AesExample9_Nonce[11] = 0x01;
+	AesOcbEncryptDecrypt(AesExample9_Input, 8, AesExample9_Nonce, 12, AesExample9_Input, 8, AesExample9_Key, 16);
+	printf("\r\n");
+	AesExample9_Nonce[11] = 0x04;
+	AesOcbEncryptDecrypt(AesExample9_Input, 16, AesExample9_Nonce, 12, AesExample9_Input, 16, AesExample9_Key, 16);
+	printf("\r\n");
+	AesExample9_Nonce[11] = 0x0F;
+	AesOcbEncryptDecrypt(AesExample9_Input, 40, AesExample9_Nonce, 12, NULL, 0, AesExample9_Key, 16);
+	printf("\r\n");
+	AesOcbIterativeTest(16);
+	AesOcbIterativeTest(12);
+	AesOcbIterativeTest(8);
+	CurrentAESBitLength = AES192;
+	AesOcbIterativeTest(16);
+	CurrentAESBitLength = AES256;
+	AesOcbIterativeTest(16);
+	printf("\r\n");
+
+	CurrentAESBitLength = AES128;
+	AesOcbParallelEncryptDecrypt(AesExample9_Key, 1000003, 4);
+	printf("\r\n");
+
+	// Example 10
+	// AES-CCM
+	// Tv (SP 800-38C Appendix C  Example 1 ` 4)
+	// https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38c.pdf
+	// Example 1 : Cipher Text = 7162015b, Tag = 4dac255d
+	// Example 2 : Cipher Text = d2a1f0e051ea5f62 081a7792073d593d, Tag = 1fc64fbfaccd
+	// Example 3 : Cipher Text = e3b201a9f5b71a7a 9b1ceaeccd97e70b 6176aad9a4428aa5, Tag = 484392fbc1b09951
+	// Example 4 : Cipher Text = 69915dad1e84c637 6a68c2967e4dab61 5ae0fd1faec44cc4 84828529463ccf72, Tag = b4ac6bec93e8598e 7f0dadbcea5b
+	BYTE AesExample10_Key[56] = { 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F };
+	BYTE AesExample10_Nonce[13] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C };
+	BYTE AesExample10_Input[32] = { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F };
+	BYTE* AesExample10_AAD = (BYTE*)CiphAlloc(65536);
+
+	for (DWORD i = 0; i < 65536; i++)
+	{
+		AesExample10_AAD[i] = (BYTE)i;
+	}
+
+	CurrentAESBitLength = AES128;
+	AesCcmEncryptDecrypt(AesExample10_Input, 4, AesExample10_Nonce, 7, AesExample10_AAD, 8, AesExample10_Key, 4);
+	printf("\r\n");
+	AesCcmEncryptDecrypt(AesExample10_Input, 16, AesExample10_Nonce, 8, AesExample10_AAD, 16, AesExample10_Key, 6);
+	printf("\r\n");
+	AesCcmEncryptDecrypt(AesExample10_Input, 24, AesExample10_Nonce, 12, AesExample10_AAD, 20, AesExample10_Key, 8);
+	printf("\r\n");
+	AesCcmEncryptDecrypt(AesExample10_Input, 32, AesExample10_Nonce, 13, AesExample10_AAD, 65536, AesExample10_Key, 14);
+	printf("\r\n");
+
+	CiphFree(AesExample10_AAD);
+
+	// Example 11
+	// AES-CMAC (128, 256)
+	// Tv (SP 800-38B ̗ARFC 4493 Ɠ)
+	// https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/AES_CMAC.pdf
+	// AES-128 : 0 oCg = bb1d6929e9593728 7fa37d129b756746, 16 oCg = 070a16b46b4d4144 f79bdd9dd04a287c
+	//           40 oCg = dfa66747de9ae630 30ca32611497c827, 64 oCg = 51f0bebf7e3b9d92 fc49741779363cfe
+	// AES-256 : 0 oCg = 028962f61b7bf89e fc6b551f4667d983, 64 oCg = e1992190549f6ed5 696a2c056c315410
+	BYTE AesExample11_Key1[56] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+	BYTE AesExample11_Key2[56] = { 0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE, 0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81, 0x1F, 0x35, 0x2C, 0x07, 0x3B, 0x61, 0x08, 0xD7, 0x2D, 0x98, 0x10, 0xA3, 0x09, 0x14, 0xDF, 0xF4 };
+	BYTE AesExample11_Input[64] = { 0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A, 0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51, 0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF, 0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10 };
+
+	CurrentAESBitLength = AES128;
+	AesCmacGenerate(AesExample11_Input, 0, AesExample11_Key1);
+	printf("\r\n");
+	AesCmacGenerate(AesExample11_Input, 16, AesExample11_Key1);
+	printf("\r\n");
+	AesCmacGenerate(AesExample11_Input, 40, AesExample11_Key1);
+	printf("\r\n");
+	AesCmacGenerate(AesExample11_Input, 64, AesExample11_Key1);
+	printf("\r\n");
+	AesCmacBatchGenerate(AesExample11_Key1, 1000, 300);
+	printf("\r\n");
+
+	CurrentAESBitLength = AES256;
+	AesCmacGenerate(AesExample11_Input, 0, AesExample11_Key2);
+	printf("\r\n");
+	AesCmacGenerate(AesExample11_Input, 64, AesExample11_Key2);
+	printf("\r\n");
+
+	// Example 12
+	// AES bv (KW, KWP)
+	// Tv (RFC 3394 4.1, 4.6  RFC 5649 6)
+	// KW (KEK 128,  128) = 1fa68b0a8112b447 aef34bd8fb5a7b82 9d3e862371d2cfe5
+	// KW (KEK 256,  256) = 28c9f404c4b810f4 cbccb35cfb87f826 3f5786e2d80ed326 cbc7f0e71a99f43b fb988b9b7a02dd21
+	// KWP (KEK 192, 20 oCg) = 138bdeaa9b8fa7fc 61f97742e72248ee 5ae6ae5360d1ae6a 5f54f373fa543b6a
+	// KWP (KEK 192, 7 oCg) = afbeb0f07dfbf541 9200f2ccb50bb24f
+	BYTE AesExample12_Kek1[56] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F };
+	BYTE AesExample12_Kek2[56] = { 0x58, 0x40, 0xDF, 0x6E, 0x29, 0xB0, 0x2A, 0xF1, 0xAB, 0x49, 0x3B, 0x70, 0x5B, 0xF1, 0x6E, 0xA1, 0xAE, 0x83, 0x38, 0xF4, 0xDC, 0xC1, 0x76, 0xA8 };
+	BYTE AesExample12_Key1[32] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F };
+	BYTE AesExample12_Key2[20] = { 0xC3, 0x7B, 0x7E, 0x64, 0x92, 0x58, 0x43, 0x40, 0xBE, 0xD1, 0x22, 0x07, 0x80, 0x89, 0x41, 0x15, 0x50, 0x68, 0xF7, 0x38 };
+	BYTE AesExample12_Key3[7] = { 0x46, 0x6F, 0x72, 0x50, 0x61, 0x73, 0x69 };
+
+	CurrentAESBitLength = AES128;
+	AesKeyWrapUnwrap(AesExample12_Key1, 16, AesExample12_Kek1, FALSE);
+	printf("\r\n");
+	CurrentAESBitLength = AES256;
+	AesKeyWrapUnwrap(AesExample12_Key1, 32, AesExample12_Kek1, FALSE);
+	printf("\r\n");
+	CurrentAESBitLength = AES192;
+	AesKeyWrapUnwrap(AesExample12_Key2, 20, AesExample12_Kek2, TRUE);
+	printf("\r\n");
+	AesKeyWrapUnwrap(AesExample12_Key3, 7, AesExample12_Kek2, TRUE);
+	printf("\r\n");
+
+	CurrentAESBitLength = AES256;
+	AesKeyRewrapBatchCheck(AesExample12_Kek1, AesExample11_Key2, 1000, FALSE);
+	printf("\r\n");
+	AesKeyRewrapBatchCheck(AesExample12_Kek1, AesExample11_Key2, 1000, TRUE);
+	printf("\r\n");
+
+	// Example 13
+	// CTR_DRBG (AES-128, AES-256, o֐Ȃ)
+	// Entropy Input = 00 01 02 ... (seedlen oCg) ō쐬A2 ڂ̐ʂ\
+	// OpenSSL  CTR-DRBG (use_df = 0) Ɠo͂ƂȂ
+	// AES-128 : Returned Bits = 796037fe48c39bf6 10f8a85a98565d96 094b2d53595ffe0f c61be739c21d9394 ...
+	// AES-256 : Returned Bits = 04562ad35e8ecafa afda16981cdaa147 606beea62801342a f13c8b5535f72f94 ...
+	BYTE AesExample13_Entropy[48];
+	BYTE AesExample13_AddInput[48];
+
+	for (DWORD i = 0; i < 48; i++)
+	{
+		AesExample13_Entropy[i] = (BYTE)i;
+		AesExample13_AddInput[i] = (BYTE)(0x80 + i);
+	}
+
+	CurrentAESBitLength = AES128;
+	AesCtrDrbgGenerateTest(AesExample13_Entropy, NULL, 0, 64);
+	printf("\r\n");
+	CurrentAESBitLength = AES256;
+	AesCtrDrbgGenerateTest(AesExample13_Entropy, NULL, 0, 64);
+	printf("\r\n");
+	AesCtrDrbgGenerateTest(AesExample13_Entropy, AesExample13_AddInput, 48, 64);
+	printf("\r\n");
+	AesRandomBytesParallel(4);
+	printf("\r\n");
+
+	// Example 14
+	// ێÍ (FF1, FF3-1)
+	// Tv (SP 800-38G FF1 Samples 1 ` 9)
+	// AES-128 : 2433477484, 6124200773, a9tv40mll9kdu509eum
+	// AES-192 : 2830668132, 2496655549, xbj3kv35jrawxv32ysr
+	// AES-256 : 6657667009, 1001623463, xs8a0azh2avyalyzuwd
+	// FF3-1 (AES-128,  10)
+	// Key = 2de79d232df5585d68ce47882ae256d6, Tweak = cbd09280979564 : 3992520240 -> 8901801106
+	// Key = 2b7e151628aed2a6abf7158809cf4f3c, Tweak = d8e7920afa330a : 890121234567890000 -> 628741947818718721
+	// (2 ڂ 4 oCgڂ̉ 4 rbg 0 łȂlŁA 4 rbg T_R Ɉڂ邱ƂmF)
+	BYTE AesExample14_Key[32] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C, 0xEF, 0x43, 0x59, 0xD8, 0xD5, 0x80, 0xAA, 0x4F, 0x7F, 0x03, 0x6D, 0x6F, 0x04, 0xFC, 0x6A, 0x94 };
+	BYTE AesExample14_Tweak1[10] = { 0x39, 0x38, 0x37, 0x36, 0x35, 0x34, 0x33, 0x32, 0x31, 0x30 };
+	BYTE AesExample14_Tweak2[11] = { 0x37, 0x37, 0x37, 0x37, 0x70, 0x71, 0x72, 0x73, 0x37, 0x37, 0x37 };
+	BYTE AesExample14_Tweak3[7] = { 0xD8, 0xE7, 0x92, 0x0A, 0xFA, 0x33, 0x0A };
+	BYTE AesExample14_Ff3Key[16] = { 0x2D, 0xE7, 0x9D, 0x23, 0x2D, 0xF5, 0x58, 0x5D, 0x68, 0xCE, 0x47, 0x88, 0x2A, 0xE2, 0x56, 0xD6 };
+	BYTE AesExample14_Ff3Tweak[7] = { 0xCB, 0xD0, 0x92, 0x80, 0x97, 0x95, 0x64 };
+
+	for (DWORD i = AES128; i <= AES256; i++)
+	{
+		CurrentAESBitLength = (AESBitLength)i;
+		AesFf1EncryptDecrypt(AesExample14_Key, 10, NULL, 0, "0123456789");
+		printf("\r\n");
+		AesFf1EncryptDecrypt(AesExample14_Key, 10, AesExample14_Tweak1, 10, "0123456789");
+		printf("\r\n");
+		AesFf1EncryptDecrypt(AesExample14_Key, 36, AesExample14_Tweak2, 11, "0123456789abcdefghi");
+		printf("\r\n");
+	}
+
+	CurrentAESBitLength = AES128;
+	AesFf3EncryptDecrypt(AesExample14_Ff3Key, 10, AesExample14_Ff3Tweak, "3992520240", "8901801106");
+	printf("\r\n");
+	AesFf3EncryptDecrypt(AesExample14_Key, 10, AesExample14_Tweak3, "890121234567890000", "628741947818718721");
+	printf("\r\n");
+	AesFf3EncryptDecrypt(AesExample14_Key, 26, AesExample14_Tweak3, "0123456789abcdefghijklmnop", NULL);
+	printf("\r\n");
+	AesFpeBatchCheck(AesExample14_Key, AesExample14_Tweak3, 1000);
+	printf("\r\n");
+
+	// Example 15
+	// AES DUKPT (AES-128 BDK)
+	// Tv (ANSI X9.24-3-2017 ̗)
+	// BDK = fedcba9876543210f1f1f1f1f1f1f1f1, ̎ʎq = 1234567890123456
+	// Initial Key = 1273671ea26ac29afa4d1084127652a1
+	// KSN 123456789012345600000001 : PIN Key (AES-128) = af8cb133a78f8dc2d1359f18527593fb
+	BYTE AesExample15_Bdk[16] = { 0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1 };
+	BYTE AesExample15_Ksn[12] = { 0x12, 0x34, 0x56, 0x78, 0x90, 0x12, 0x34, 0x56, 0x00, 0x00, 0x00, 0x00 };
+
+	CurrentAESBitLength = AES128;
+	AesDukptGenerate(AesExample15_Bdk, AesExample15_Ksn, 1, 2);
+	printf("\r\n");
+	AesDukptBatchCheck(AesExample15_Bdk, AesExample15_Ksn, 40, 2000);
+	printf("\r\n");
+
+	// Example 16
+	// l (KCV)
+	//  Example 1 ` 3 Ɠ
+	// AES-128 : E_K(0) = 7df76b0c1ab899b33e42f047b91b546fAKCV = 7df76b
+	// AES-192 : E_K(0) = 22452d8e49a8a5939f7321ceea6d514bAKCV = 22452d
+	// AES-256 : E_K(0) = e568f68194cf76d6174d4cc04310a854AKCV = e568f6
+	CurrentAESBitLength = AES128;
+	AesKcvGenerate(AesExample1_Key, 1003);
+	printf("\r\n");
+	CurrentAESBitLength = AES192;
+	AesKcvGenerate(AesExample2_Key, 1003);
+	printf("\r\n");
+	CurrentAESBitLength = AES256;
+	AesKcvGenerate(AesExample3_Key, 1003);
+	printf("\r\n");
+
+	// Example 17
+	// Cu C C^[tF[X (CiphLib.h)
+	// Ɠ͂ Example 1 Ɠ (AES-128)
+	// ECB, CBC, CTR ̈Í Example 1 ƓACMAC  SP 800-38B  Example 4 (51f0bebf7e3b9d92 fc49741779363cfe)
+	// GCM  Example 7  Test Case 4 (Tag = 5bc94fbc3221a5db 94fae95ae7121a47)
+	printf("CiphLib\r\n");
+	AesLibraryEncryptDecrypt(AesExample1_Input, 64, AesExample1_IV, AesExample1_ICV, AesExample1_Key, 16);
+	printf("\r\n");
+	AesLibraryGcm(AesExample7_Input2, 60, AesExample7_IV2, 12, AesExample7_AAD, 20, AesExample7_Key2, 16);
+	printf("\r\n");
+
+	// Example 18
+	// Ɨ̈ (64 oCgEATCYNX̍ėpA[Wy[W)
+	AesBufferCheck((SIZE_T)64 << 20);
+	printf("\r\n");
+
+	// Example 19
+	// s@̑I (1 ubNAݏA񏈗AIB񏈗ɎQXbh̏ 4 Ƃ)
+	// AIV, ICV  Example 1 Ɠ (AES-128)
+	AesDispatchCheck(AesExample1_Key, 16, AesExample1_IV, AesExample1_ICV, 1048624, 4);
+	printf("\r\n");
+
 	return 0;
 }
\ No newline at end of file
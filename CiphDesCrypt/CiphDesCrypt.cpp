@@ -1,839 +1,718 @@
-#include <Windows.h>
+#include "CiphDes.h"
+#include "CiphLib.h"
 #include <stdio.h>
+#include <string.h>
 
-// DES (Data Encryption Standard) ɂÍ
+// DES (Data Encryption Standard) ɂÍ̃eXg
+// Í̏ CiphLib (CiphDes.h, CiphLib.h) Q
 
-// Ql
-// https://csrc.nist.gov/csrc/media/publications/fips/46/3/archive/1999-10-25/documents/fips46-3.pdf
-// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-67r2.pdf
-// https://csrc.nist.gov/CSRC/media/Publications/fips/81/archive/1980-12-02/documents/fips81.pdf
-// https://tsapps.nist.gov/publication/get_pdf.cfm?pub_id=910079
+// eXg
 // https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/TDES_Core.pdf
 // https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/TDES_ModesA_All.pdf
 
-// PC1 : Permuted Choice 1
-BYTE PC1[56] =
-{
-	57, 49, 41, 33, 25, 17, 9, 1,
-	58, 50, 42, 34, 26, 18, 10, 2,
-	59, 51, 43, 35, 27, 19, 11, 3,
-	60, 52, 44, 36, 63, 55, 47, 39,
-	31, 23, 15, 7, 62, 54, 46, 38,
-	30, 22, 14, 6, 61, 53, 45, 37,
-	29, 21, 13, 5, 28, 20, 12, 4
-};
-
-// PC2 : Permuted Choice 2
-BYTE PC2[48] =
-{
-	14, 17, 11, 24, 1, 5, 3, 28,
-	15, 6, 21, 10, 23, 19, 12, 4,
-	26, 8, 16, 7, 27, 20, 13, 2,
-	41, 52, 31, 37, 47, 55, 30, 40,
-	51, 45, 33, 48, 44, 49, 39, 56,
-	34, 53, 46, 42, 50, 36, 29, 32
-};
-
-BYTE NumLeftShifts[16] = { 1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1 };
-
-// IP : initial permutation 
-BYTE IP[64] =
-{
-	58, 50, 42, 34, 26, 18, 10, 2,
-	60, 52, 44, 36, 28, 20, 12, 4,
-	62, 54, 46, 38, 30, 22, 14, 6,
-	64, 56, 48, 40, 32, 24, 16, 8,
-	57, 49, 41, 33, 25, 17, 9, 1,
-	59, 51, 43, 35, 27, 19, 11, 3,
-	61, 53, 45, 37, 29, 21, 13, 5,
-	63, 55, 47, 39, 31, 23, 15, 7
-};
-
-// IP^-1 : inverse initial permutation
-BYTE InvIP[64] =
-{
-	40, 8, 48, 16, 56, 24, 64, 32,
-	39, 7, 47, 15, 55, 23, 63, 31,
-	38, 6, 46, 14, 54, 22, 62, 30,
-	37, 5, 45, 13, 53, 21, 61, 29,
-	36, 4, 44, 12, 52, 20, 60, 28,
-	35, 3, 43, 11, 51, 19, 59, 27,
-	34, 2, 42, 10, 50, 18, 58, 26,
-	33, 1, 41, 9, 49, 17, 57, 25
-};
-
-BYTE E[48] =
-{
-	32, 1, 2, 3, 4, 5,
-	4, 5, 6, 7, 8, 9,
-	8, 9, 10, 11, 12, 13,
-	12, 13, 14, 15, 16, 17,
-	16, 17, 18, 19, 20, 21,
-	20, 21, 22, 23, 24, 25,
-	24, 25, 26, 27, 28, 29,
-	28, 29, 30, 31, 32, 1
-};
-
-BYTE S[8][64] =
-{
-	{
-		// S1
-		14, 4, 13, 1, 2, 15, 11, 8, 3, 10, 6, 12, 5, 9, 0, 7,
-		0, 15, 7, 4, 14, 2, 13, 1, 10, 6, 12, 11, 9, 5, 3, 8,
-		4, 1, 14, 8, 13, 6, 2, 11, 15, 12, 9, 7, 3, 10, 5, 0,
-		15, 12, 8, 2, 4, 9, 1, 7, 5, 11, 3, 14, 10, 0, 6, 13
-	},
-	{
-		// S2
-		15, 1, 8, 14, 6, 11, 3, 4, 9, 7, 2, 13, 12, 0, 5, 10,
-		3, 13, 4, 7, 15, 2, 8, 14, 12, 0, 1, 10, 6, 9, 11, 5,
-		0, 14, 7, 11, 10, 4, 13, 1, 5, 8, 12, 6, 9, 3, 2, 15,
-		13, 8, 10, 1, 3, 15, 4, 2, 11, 6, 7, 12, 0, 5, 14, 9
-	},
-	{
-		// S3
-		10, 0, 9, 14, 6, 3, 15, 5, 1, 13, 12, 7, 11, 4, 2, 8,
-		13, 7, 0, 9, 3, 4, 6, 10, 2, 8, 5, 14, 12, 11, 15, 1,
-		13, 6, 4, 9, 8, 15, 3, 0, 11, 1, 2, 12, 5, 10, 14, 7,
-		1, 10, 13, 0, 6, 9, 8, 7, 4, 15, 14, 3, 11, 5, 2, 12
-	},
-	{
-		// S4
-		7, 13, 14, 3, 0, 6, 9, 10, 1, 2, 8, 5, 11, 12, 4, 15,
-		13, 8, 11, 5, 6, 15, 0, 3, 4, 7, 2, 12, 1, 10, 14, 9,
-		10, 6, 9, 0, 12, 11, 7, 13, 15, 1, 3, 14, 5, 2, 8, 4,
-		3, 15, 0, 6, 10, 1, 13, 8, 9, 4, 5, 11, 12, 7, 2, 14
-	},
-	{
-		// S5
-		2, 12, 4, 1, 7, 10, 11, 6, 8, 5, 3, 15, 13, 0, 14, 9,
-		14, 11, 2, 12, 4, 7, 13, 1, 5, 0, 15, 10, 3, 9, 8, 6,
-		4, 2, 1, 11, 10, 13, 7, 8, 15, 9, 12, 5, 6, 3, 0, 14,
-		11, 8, 12, 7, 1, 14, 2, 13, 6, 15, 0, 9, 10, 4, 5, 3
-	},
-	{
-		// S6
-		12, 1, 10, 15, 9, 2, 6, 8, 0, 13, 3, 4, 14, 7, 5, 11,
-		10, 15, 4, 2, 7, 12, 9, 5, 6, 1, 13, 14, 0, 11, 3, 8,
-		9, 14, 15, 5, 2, 8, 12, 3, 7, 0, 4, 10, 1, 13, 11, 6,
-		4, 3, 2, 12, 9, 5, 15, 10, 11, 14, 1, 7, 6, 0, 8, 13
-	},
-	{
-		// S7
-		4, 11, 2, 14, 15, 0, 8, 13, 3, 12, 9, 7, 5, 10, 6, 1,
-		13, 0, 11, 7, 4, 9, 1, 10, 14, 3, 5, 12, 2, 15, 8, 6,
-		1, 4, 11, 13, 12, 3, 7, 14, 10, 15, 6, 8, 0, 5, 9, 2,
-		6, 11, 13, 8, 1, 4, 10, 7, 9, 5, 0, 15, 14, 2, 3, 12
-	},
-	{
-		// S8
-		13, 2, 8, 4, 6, 15, 11, 1, 10, 9, 3, 14, 5, 0, 12, 7,
-		1, 15, 13, 8, 10, 3, 7, 4, 12, 5, 6, 11, 0, 14, 9, 2,
-		7, 11, 4, 1, 9, 12, 14, 2, 0, 6, 10, 13, 15, 3, 5, 8,
-		2, 1, 14, 7, 4, 10, 8, 13, 15, 12, 9, 0, 3, 5, 6, 11
-	}
-};
-
-BYTE P[] =
-{
-	16, 7, 20, 21,
-	29, 12, 28, 17,
-	1, 15, 23, 26,
-	5, 18, 31, 10,
-	2, 8, 24, 14,
-	32, 27, 3, 9,
-	19, 13, 30, 6,
-	22, 11, 4, 25
-};
-
-// Permutation ֐
-// Permutation (]u) s߂̊֐
-// ]uƂ́Arbgʒuɓ鐔l N oCg̃e[up
-// ̓f[^ʂ̃oCgɒu鑀
-// ̓f[^̍ł̃rbg̈ʒu 1 ƂAE 2, 3, 4 ... ƑĂ
-// ̑sɓĈȉ̏
-// 1.cbTable  8 ̔{łȂ΂ȂȂ
-// 2.o͗pobt@ out ̃TCY (oCg) ́A cbTable / 8 ƈvȂ΂ȂȂ
-// 3.͗pobt@ in ̃TCY (oCg) ́Atable ̍ől / 8 zĂ͂ȂȂ
-VOID WINAPI Permutation(BYTE* in, BYTE* table, DWORD cbTable, BYTE* out)
+#define DES_MODE_ECB 1
+#define DES_MODE_CBC 2
+#define DES_MODE_CFB 3
+#define DES_MODE_OFB 4
+#define DES_MODE_CTR 5
+
+// DES ɂÍƕ̃eXgp֐
+VOID WINAPI DesEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out, DWORD dwMode)
 {
-	BYTE byteTemp, bitTemp, bitIn, byteIn, bitOut, byteOut, i, j;
+	DWORD i;
+	BYTE* pInTemp;
 
-	for (i = 0; i < cbTable / 8; i++)
+	printf("%-22s = ", "Input");
+	for (i = 0; i < cbIn; i++)
 	{
-		byteOut = 0;
-		for (j = 0; j < 8; j++)
+		printf("%02x", in[i]);
+		if (i % 8 == 7)
 		{
-			for (j = 0; j < 8; j++)
-			{
-				//  8 oCg̉oCgڂ (0 ` cbTable / 8)
-				byteTemp = (table[i * 8 + j] - 1) / 8;
-				// 1 oCg̉rbgڂ (0`7)
-				bitTemp = (table[i * 8 + j] - 1) % 8;
-				byteIn = in[byteTemp];
-				bitIn = (byteIn >> (7 - bitTemp)) & 1;
-
-				bitOut = bitIn << (7 - j);
-				byteOut |= bitOut;
-			}
-			// ʂۑ
-			out[i] = byteOut;
+			printf(" ");
 		}
 	}
+	printf("\r\n");
 
-	return;
-}
-
-VOID WINAPI Xor(BYTE* in1, BYTE* in2, DWORD cbIn, BYTE* out)
-{
-	DWORD i;
+	printf("%-22s = ", "Key");
+	for (i = 0; i < 8; i++)
+	{
+		printf("%02x", OriginalKey[i]);
+	}
+	printf("\r\n");
 
-	for (i = 0; i < cbIn; i++)
+	printf("%-22s = ", "Initialization Vector");
+	for (i = 0; i < 8; i++)
 	{
-		out[i] = in1[i] ^ in2[i];
+		printf("%02x", IV[i]);
 	}
+	printf("\r\n");
 
-	return;
-}
+	switch (dwMode)
+	{
+	case DES_MODE_ECB:
+		DesEcbEncryptDecrypt(in, cbIn, OriginalKey, out);
 
-// DesEncrypt ֐
-// DES ɂÍsBDES ɂÍ͈ȉ̎菇očs
-// 1.̓f[^Ƃ 64 rbg̕ƁA64 rbg̈Í󂯎
-// 2.64 rbg̈Í Permuted Choice 1 s 56 rbǧ K0 𐶐
-// 3.K0 ̃f[^ 28 rbg̃f[^ C0, D0  2 ɕ
-// 4.C0, D0 ̂ꂼ[e[g (dlł͍VtgƋLڂĂ邪Aۂ͍[e[g)  C1, D1 쐬
-// 5.C1, D1 ̃f[^ Permuted Choice 2 sA48 rbǧ K1 𐶐
-// 6.C1, D1 ` C16, D16 ɂ 4. y 5. ̏JԂ K1`K16쐬
-// 7.ɂ Initial Permutation (IP) ƌĂ΂鏉]us
-// 8.]usʂ 32 rbg̃f[^ L0, R0  2 ɕ
-// 9.R0  32 rbg 48 rbgɊg
-// 10.R0 ̂܂ L1 Ƃ
-// 11 R0  48 rbgɊĝ K1 ̓f[^Ƃ f ֐ĂяoǍʂ L0 ̘_ς R1 Ƃ
-// 12.L0, R0 ` L15, R15 ɂ 9. ` 11. ̏JԂ L1, R1 ` L16, R16 쐬
-// 13.R16, L16 (R16  L16 E)  Inverse Initial Permutation (ŏI]u) sāA64 rbg̈Í擾
-// 
-// }ɂƈȉ̂悤ɂȂ
-// +---------------------------------+           +---------------------------------+
-// | Plain Text (64 bits)            |           | Original Key (64 bits)          |
-// +----------------+----------------+           +----------------+----------------+
-//                  | Initial Permutation (IP)                    | Permuted Choice 1
-//                  |                            +----------------+----------------+  +----------------+----------------+
-// +----------------+----------------+           | Permuted Key K0 (56 bits)       +->+ C0 (28bits)| D0 (28bits)|
-// | L0 (32bits)| R0 (32bits)|           +---------------------------------+  +--------+-------+-------+--------+
-// +--------+-------+-------+--------+                                                         | [e[g  | [e[g
-//          |               |                    +---------------------------------+  +--------+-------+-------+--------+
-//          | +-------------+                    | Permuted Key K1 (48 bits)       +<-+ C1 (28 bits)   | D1 (28 bits)   |
-//          |/      +-------+--------+           +----------------+----------------+  +--------+-------+-------+--------+
-//         /|       | Expansion      |                            |         Permuted Choice 2  | [e[g  | [e[g            
-//        / |       +-------+--------+     +----------------------+                            |               |
-//       /  |               |              |     +---------------------------------+  +--------+-------+-------+--------+
-//      /   |       +-------+--------+     |     | Permuted Key K2 (48 bits)       +<-+ C2 (28 bits)   | D2 (28 bits)   |
-//      |   |       | f              +-----+     +----------------+----------------+  +--------+-------+-------+--------+
-//      |   |       +-------+--------+                            |         Permuted Choice 2  | [e[g  | [e[g 
-//      |  xor--------------+                                     :                            :               :
-//      |   |                                                     :                            :               :
-//      |   +---------------+
-//      |                   |
-// +----+-----------+-------+--------+
-// | L1 (32bits)    | R1 (32bits)    |
-// +--------+-------+-------+--------+
-//          |               |
-//          :               :
-// +--------+-------+-------+--------+
-// | L16 (32bits)   | R16 (32bits)   |
-// +--------+-------+-------+--------+
-//          |               |
-//          +-------+-------+
-//                  | Inverse Initial Permutation
-// +---------------------------------+
-// | Cipher Text (64 bits)           |
-// +---------------------------------+
-// 
-VOID WINAPI DesEncrypt(BYTE* in, BYTE* OriginalKey, BYTE* out)
-{
-	BYTE i, j, temp[8];
-
-	// Key Schedule 1 (KS1)
-	// ^ꂽIWǐ 56 rbǧ K0  1 ƁA 48 rbǧ 16 쐬
-	// +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
-	// |01|02|03|04|05|06|07|08|09|10|11|12|13|14|15|16|17|18|19|20|21|22|23|24|25|26|27|28|29|30|31|32|33|34|35|36|37|38|39|40|41|42|43|44|45|46|47|48|49|50|51|52|53|54|55|56|
-	// +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
-	// | Permuted Key (56 bits)                                                                                                                                                |
-	// +-----------------------------------------------------------------------------------+-----------------------------------------------------------------------------------+
-	// | C0 (28 bits)                                                                      | D0 (28 bits)                                                                      |
-	// +-----------------------------------------------------------------------------------+-----------------------------------------------------------------------------------+
-	// C0, D0 ɂĂꂼ 1 rbg[e[g C1, D1 쐬
-	//  +---------------------------------------------------------------------------------+  +--------------------------------------------------------------------------------+ 
-	//  |                                                                                 |  |                                                                                |
-	//  |                                                                                 v  |                                                                                v
-	// +-----------------------------------------------------------------------------------+-----------------------------------------------------------------------------------+
-	// | C1 (28 bits)                                                                      | D1 (28 bits)                                                                      |
-	// +-----------------------------------------------------------------------------------+-----------------------------------------------------------------------------------+
-	// 悤 C2, D2 ɂĂ C1, D1 ꂼrbg[e[gč쐬
-	// [e[grbǵAꂼ 1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1
-	BYTE C[17][4], D[17][4], K[17][7], KTemp[7];
-
-	BYTE inIP[8], L[17][4], R[17][4], RExp[17][6], RXorK[17][6], Row, Column, SRet[4], PRet[4];
-
-	// Permuted Choice 1
-	Permutation(OriginalKey, PC1, 56, K[0]);
-
-	// C0 : 56 rbgɏk]u K ̏ 28 rbg
-	memcpy(C[0], K[0], 4);
-	C[0][3] &= 0xf0;
-
-	// D0 : 56 rbgɏk]u K ̉ 28 rbg
-	memcpy(D[0], &K[0][3], 4);
-	D[0][0] &= 0xf;
-
-	for (i = 1; i < 17; i++)
-	{
-		// Cn  Cn-1  NumLeftShifts[n - 1] rbg[e[g
-		for (j = 0; j < 4; j++)
+		printf("%-22s = ", "Cipher Text (ECB)");
+		for (i = 0; i < cbIn; i++)
 		{
-			C[i][j] = C[i - 1][j] << NumLeftShifts[i - 1];
-			if (j < 3)
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
 			{
-				C[i][j] |= C[i - 1][j + 1] >> (8 - NumLeftShifts[i - 1]);
+				printf(" ");
 			}
 		}
-		C[i][3] |= (C[i - 1][0] >> (8 - NumLeftShifts[i - 1])) << 4;
+		printf("\r\n");
 
-		// Dn  Dn-1  NumLeftShifts[n - 1] rbg[e[g
-		for (j = 0; j < 4; j++)
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
+		DesEcbDecrypt(pInTemp, cbIn, OriginalKey, out);
+		CiphFree(pInTemp);
+
+		break;
+
+	case DES_MODE_CBC:
+		DesCbcEncrypt(in, cbIn, OriginalKey, IV, out);
+
+		printf("%-22s = ", "Cipher Text (CBC)");
+		for (i = 0; i < cbIn; i++)
 		{
-			D[i][j] = D[i - 1][j] << NumLeftShifts[i - 1];
-			if (j < 3)
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
 			{
-				D[i][j] |= D[i - 1][j + 1] >> (8 - NumLeftShifts[i - 1]);
+				printf(" ");
 			}
 		}
-		D[i][3] |= D[i - 1][0] >> (4 - NumLeftShifts[i - 1]);
-		D[i][0] &= 0xf;
+		printf("\r\n");
 
-		// Cn  Dn  Kn 쐬
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
+		DesCbcDecrypt(pInTemp, cbIn, OriginalKey, IV, out);
+		CiphFree(pInTemp);
 
-		memcpy(KTemp, C[i], 3);
-		memcpy(&KTemp[4], &D[i][1], 3);
-		KTemp[3] = C[i][3] | D[i][0];
+		break;
 
-		// Permuted Choice 2
-		Permutation(KTemp, PC2, 48, K[i]);
-		K[i][6] = 0;
-	}
+	case DES_MODE_CFB:
+		DesCfbEncrypt(in, cbIn, OriginalKey, IV, out);
 
-	// Initial Permutation
-	Permutation(in, IP, 64, inIP);
+		printf("%-22s = ", "Cipher Text (CFB)");
+		for (i = 0; i < cbIn; i++)
+		{
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
+		}
+		printf("\r\n");
 
-	//  32bit
-	memcpy(L[0], inIP, 4);
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
+		DesCfbDecrypt(pInTemp, cbIn, OriginalKey, IV, out);
+		CiphFree(pInTemp);
 
-	//  32bit
-	memcpy(R[0], &inIP[4], 4);
+		break;
 
-	for (i = 0; i < 16; i++)
-	{
-		// f : Feistel Structure 
-		// Expansion
-		Permutation(R[i], E, 48, RExp[i]);
+	case DES_MODE_OFB:
+		DesOfbEncryptDecrypt(in, cbIn, OriginalKey, IV, out);
 
-		// Xor
-		Xor(RExp[i], K[i + 1], 6, RXorK[i]);
+		printf("%-22s = ", "Cipher Text (OFB)");
+		for (i = 0; i < cbIn; i++)
+		{
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
+		}
+		printf("\r\n");
+
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
+		DesOfbEncryptDecrypt(pInTemp, cbIn, OriginalKey, IV, out);
+		CiphFree(pInTemp);
+
+		break;
 
-		// S ֐
-		// 48 rbg 6 rbg 8 ɕAbit1, bit6  2 i (00 ` 11 4ʂ)  Row Ƃ
-		// bit2 ` bit5  2 i (0000 ` 1111  16 ʂ)  Column Ƃ
-		//  S1 ` S8 ̂ꂼ̃e[uɂĂ͂߁A4 rbg 2il (0000 ` 1111  16 ʂ) B1 ` B8  32 rbg擾
-		ZeroMemory(SRet, 4);
-		for (j = 0; j < 8; j++)
+	case DES_MODE_CTR:
+		DesCtrEncryptDecrypt(in, cbIn, OriginalKey, IV, out);
+
+		printf("%-22s = ", "Cipher Text (CTR)");
+		for (i = 0; i < cbIn; i++)
 		{
-			Row = (RXorK[i][(j * 6) / 8] >> (7 - (j * 6) % 8)) & 1;
-			Row <<= 1;
-			Row |= (RXorK[i][(j * 6 + 5) / 8] >> (7 - (j * 6 + 5) % 8)) & 1;
-
-			Column = (RXorK[i][(j * 6 + 1) / 8] >> (7 - (j * 6 + 1) % 8)) & 1;
-			Column <<= 1;
-			Column |= (RXorK[i][(j * 6 + 2) / 8] >> (7 - (j * 6 + 2) % 8)) & 1;
-			Column <<= 1;
-			Column |= (RXorK[i][(j * 6 + 3) / 8] >> (7 - (j * 6 + 3) % 8)) & 1;
-			Column <<= 1;
-			Column |= (RXorK[i][(j * 6 + 4) / 8] >> (7 - (j * 6 + 4) % 8)) & 1;
-
-			SRet[j / 2] <<= 4;
-			SRet[j / 2] |= S[j][Row * 16 + Column];
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
 		}
+		printf("\r\n");
 
-		// P ֐
-		// S ֐ɂēꂽʂ P e[uɂĂ͂ 32 rbg32 rbg̓]us
-		Permutation(SRet, P, 32, PRet);
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
+		DesCtrEncryptDecrypt(pInTemp, cbIn, OriginalKey, IV, out);
+		CiphFree(pInTemp);
 
-		// Ln  P ֐ɂēꂽʂ xor  Rn+1 𓾂
-		Xor(L[i], PRet, 4, R[i + 1]);
+		break;
 
-		// Rn ͂̂܂ Ln+1 ƂȂ
-		memcpy(L[i + 1], R[i], 4);
-	}
+	default:
+		DesEncrypt(in, OriginalKey, out);
+
+		printf("%-22s = ", "Cipher Text");
+		for (i = 0; i < cbIn; i++)
+		{
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
+		}
+		printf("\r\n");
+
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
+		DesDecrypt(pInTemp, OriginalKey, out);
+		CiphFree(pInTemp);
 
-	memcpy(temp, R[16], 4);
-	memcpy(&temp[4], L[16], 4);
+		break;
+	}
 
-	// Final Permutation
-	Permutation(temp, InvIP, 64, out);
+	printf("%-22s = ", "Output");
+	for (i = 0; i < cbIn; i++)
+	{
+		printf("%02x", out[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
+	}
+	printf("\r\n");
 
 	return;
 }
 
-// DesDecrypt ֐
-// Des ɂĈÍꂽ𕡍Bȉ̏ŏs
-// ̓f[^ 64 rbgɕďs
-// 1.̓f[^Ƃ 64 rbg̕ƁA64 rbg̈Í󂯎
-// 2.64 rbg̈Í Permuted Choice 1 s 56 rbǧ K0 𐶐
-// 3.K0 ̃f[^ 28 rbg̃f[^ C0, D0  2 ɕ
-// 4.C0, D0 ̂ꂼ[e[g (dlł͍VtgƋLڂĂ邪Aۂ͍[e[g)  C1, D1 쐬
-// 5.C1, D1 ̃f[^ Permuted Choice 2 sA48 rbǧ K1 𐶐
-// 6.C1, D1 ` C16, D16 ɂ 4. y 5. ̏JԂ K1`K16쐬
-// 7.ɂ Initial Permutation (IP) ƌĂ΂鏉]us
-// 8.]usʂ 32 rbg̃f[^ L0, R0  2 ɕ
-// 9.n  0 傫ꍇ L0  R0 ւ
-// 10.R0  R1 Ƃ
-// 11.R0  32 rbg 48 rbgɊg
-// 12 R0  48 rbgɊĝ K16 ̓f[^Ƃ f ֐ĂяoǍʂ L0 ̔rI_a L1 Ƃ
-// 13.L0, R0 ` L15, R15 ɂ 9. ` 12. ̏JԂ L1, R1 ` L16, R16 쐬
-// 13.L16, R16  Inverse Initial Permutation (ŏI]u) sāA64 rbg̈Í擾
-// 
-VOID WINAPI DesDecrypt(BYTE* in, BYTE* OriginalKey, BYTE* out)
+VOID WINAPI TdeaEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IVorICV, BYTE* out, DWORD dwMode)
 {
-	BYTE i, j, temp[8];
+	BYTE* pInTemp;
+	DWORD i;
 
-	// Key Schedule 1 (KS1)
-	BYTE C[17][4], D[17][4], K[17][7], KTemp[7];
+	printf("%-22s = ", "Input");
+	for (i = 0; i < cbIn; i++)
+	{
+		printf("%02x", in[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
+	}
+	printf("\r\n");
 
-	BYTE inIP[8], L[17][4], R[17][4], RExp[17][6], RXorK[17][6], Row, Column, SRet[4], PRet[4];
+	printf("%-22s = ", "Key1");
+	for (i = 0; i < 8; i++)
+	{
+		printf("%02x", Key1[i]);
+	}
+	printf("\r\n");
 
-	// Permuted Choice 1
-	Permutation(OriginalKey, PC1, 56, K[0]);
+	printf("%-22s = ", "Key2");
+	for (i = 0; i < 8; i++)
+	{
+		printf("%02x", Key2[i]);
+	}
+	printf("\r\n");
 
-	// C0 : 56 rbgɏk]u K ̏ 28 rbg
-	memcpy(C[0], K[0], 4);
-	C[0][3] &= 0xf0;
+	printf("%-22s = ", "Key3");
+	for (i = 0; i < 8; i++)
+	{
+		printf("%02x", Key3[i]);
+	}
+	printf("\r\n");
 
-	// D0 : 56 rbgɏk]u K ̉ 28 rbg
-	memcpy(D[0], &K[0][3], 4);
-	D[0][0] &= 0xf;
+	printf("%-22s = ", "IV or ICV");
+	for (i = 0; i < 8; i++)
+	{
+		printf("%02x", IVorICV[i]);
+	}
+	printf("\r\n");
 
-	for (i = 1; i < 17; i++)
+	switch (dwMode)
 	{
-		// Cn  Cn-1  NumLeftShifts[n - 1] rbg[e[g
-		for (j = 0; j < 4; j++)
+	case DES_MODE_ECB:
+		TdeaEcbEncrypt(in, cbIn, Key1, Key2, Key3, out);
+
+		printf("%-22s = ", "Cipher Text (TDEA-ECB)");
+		for (i = 0; i < cbIn; i++)
 		{
-			C[i][j] = C[i - 1][j] << NumLeftShifts[i - 1];
-			if (j < 3)
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
 			{
-				C[i][j] |= C[i - 1][j + 1] >> (8 - NumLeftShifts[i - 1]);
+				printf(" ");
 			}
 		}
-		C[i][3] |= (C[i - 1][0] >> (8 - NumLeftShifts[i - 1])) << 4;
+		printf("\r\n");
 
-		// Dn  Dn-1  NumLeftShifts[n - 1] rbg[e[g
-		for (j = 0; j < 4; j++)
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
+
+		TdeaEcbDecrypt(pInTemp, cbIn, Key1, Key2, Key3, out);
+		CiphFree(pInTemp);
+
+		break;
+	case DES_MODE_CBC:
+		TdeaCbcEncrypt(in, cbIn, Key1, Key2, Key3, IVorICV, out);
+
+		printf("%-22s = ", "Cipher Text (TDEA-CBC)");
+		for (i = 0; i < cbIn; i++)
 		{
-			D[i][j] = D[i - 1][j] << NumLeftShifts[i - 1];
-			if (j < 3)
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
 			{
-				D[i][j] |= D[i - 1][j + 1] >> (8 - NumLeftShifts[i - 1]);
+				printf(" ");
 			}
 		}
-		D[i][3] |= D[i - 1][0] >> (4 - NumLeftShifts[i - 1]);
-		D[i][0] &= 0xf;
+		printf("\r\n");
 
-		// Cn  Dn  Kn 쐬
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
 
-		memcpy(KTemp, C[i], 3);
-		memcpy(&KTemp[4], &D[i][1], 3);
-		KTemp[3] = C[i][3] | D[i][0];
+		TdeaCbcDecrypt(pInTemp, cbIn, Key1, Key2, Key3, IVorICV, out);
+		CiphFree(pInTemp);
 
-		// Permuted Choice 2
-		Permutation(KTemp, PC2, 48, K[i]);
-		K[i][6] = 0;
-	}
+		break;
+	case DES_MODE_CFB:
+		TdeaCfbEncrypt(in, cbIn, Key1, Key2, Key3, IVorICV, out);
 
-	// Initial Permutation
-	Permutation(in, IP, 64, inIP);
+		printf("%-22s = ", "Cipher Text (TDEA-CFB)");
+		for (i = 0; i < cbIn; i++)
+		{
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
+		}
+		printf("\r\n");
 
-	//  32bit
-	memcpy(L[0], inIP, 4);
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
 
-	//  32bit
-	memcpy(R[0], &inIP[4], 4);
+		TdeaCfbDecrypt(pInTemp, cbIn, Key1, Key2, Key3, IVorICV, out);
+		CiphFree(pInTemp);
 
-	for (i = 0; i < 16; i++)
-	{
-		if (i > 0)
+		break;
+	case DES_MODE_OFB:
+		TdeaOfbEncryptDecrypt(in, cbIn, Key1, Key2, Key3, IVorICV, out);
+
+		printf("%-22s = ", "Cipher Text (TDEA-OFB)");
+		for (i = 0; i < cbIn; i++)
 		{
-			memcpy(R[i], L[i], 4);
-			memcpy(L[i], R[i - 1], 4);
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
 		}
+		printf("\r\n");
 
-		// f : Feistel Structure 
-		// Expansion
-		Permutation(R[i], E, 48, RExp[i]);
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
 
-		// Xor
-		Xor(RExp[i], K[16 - i], 6, RXorK[i]);
+		TdeaOfbEncryptDecrypt(pInTemp, cbIn, Key1, Key2, Key3, IVorICV, out);
+		CiphFree(pInTemp);
 
-		// S ֐
-		// 48 rbg 6 rbg 8 ɕAbit1, bit6  2 i (00 ` 11 4ʂ)  Row Ƃ
-		// bit2 ` bit5  2 i (0000 ` 1111  16 ʂ)  Column Ƃ
-		//  S1 ` S8 ̂ꂼ̃e[uɂĂ͂߁A4 rbg 2il (0000 ` 1111  16 ʂ) B1 ` B8  32 rbg擾
-		ZeroMemory(SRet, 4);
-		for (j = 0; j < 8; j++)
+		break;
+	case DES_MODE_CTR:
+		TdeaCtrEncryptDecrypt(in, cbIn, Key1, Key2, Key3, IVorICV, out);
+
+		printf("%-22s = ", "Cipher Text (TDEA-CTR)");
+		for (i = 0; i < cbIn; i++)
 		{
-			Row = (RXorK[i][(j * 6) / 8] >> (7 - (j * 6) % 8)) & 1;
-			Row <<= 1;
-			Row |= (RXorK[i][(j * 6 + 5) / 8] >> (7 - (j * 6 + 5) % 8)) & 1;
-
-			Column = (RXorK[i][(j * 6 + 1) / 8] >> (7 - (j * 6 + 1) % 8)) & 1;
-			Column <<= 1;
-			Column |= (RXorK[i][(j * 6 + 2) / 8] >> (7 - (j * 6 + 2) % 8)) & 1;
-			Column <<= 1;
-			Column |= (RXorK[i][(j * 6 + 3) / 8] >> (7 - (j * 6 + 3) % 8)) & 1;
-			Column <<= 1;
-			Column |= (RXorK[i][(j * 6 + 4) / 8] >> (7 - (j * 6 + 4) % 8)) & 1;
-
-			SRet[j / 2] <<= 4;
-			SRet[j / 2] |= S[j][Row * 16 + Column];
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
 		}
+		printf("\r\n");
 
-		// P ֐
-		// S ֐ɂēꂽʂ P e[uɂĂ͂ 32 rbg32 rbg̓]us
-		Permutation(SRet, P, 32, PRet);
-
-		// Ln  P ֐ɂēꂽʂ xor  Ln+1 𓾂
-		Xor(L[i], PRet, 4, L[i + 1]);
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
 
-		// Rn ͂̂܂ Rn+1 ƂȂ
-		memcpy(R[i + 1], R[i], 4);
-	}
+		TdeaCtrEncryptDecrypt(pInTemp, cbIn, Key1, Key2, Key3, IVorICV, out);
+		CiphFree(pInTemp);
 
-	memcpy(temp, L[16], 4);
-	memcpy(&temp[4], R[16], 4);
+		break;
+	default:
+		TdeaEncrypt(in, Key1, Key2, Key3, out);
 
-	// Final Permutation
-	Permutation(temp, InvIP, 64, out);
+		printf("%-22s = ", "Cipher Text (TDEA)");
+		for (i = 0; i < cbIn; i++)
+		{
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
+		}
+		printf("\r\n");
 
-	return;
-}
+		pInTemp = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+		memcpy(pInTemp, out, cbIn);
+		TdeaDecrypt(pInTemp, Key1, Key2, Key3, out);
+		CiphFree(pInTemp);
 
-VOID WINAPI DesEcbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out)
-{
-	DWORD cbCurrent;
+		break;
+	}
 
-	DesEncrypt(in, OriginalKey, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	printf("%-22s = ", "Output");
+	for (i = 0; i < cbIn; i++)
 	{
-		DesEncrypt(&in[cbCurrent], OriginalKey, &out[cbCurrent]);
+		printf("%02x", out[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
 	}
-
-	return;
+	printf("\r\n");
 }
 
-
-VOID WINAPI DesCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
+// TDEA (Key2, Key3  NULL ̏ꍇ DES) ̃pfBOAÍގ̃eXgp֐
+VOID WINAPI TdeaPaddingEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, DWORD dwPadding, DWORD dwMode)
 {
-	BYTE inTemp[8];
-	DWORD cbCurrent;
+	BYTE* cipher, * out;
+	DWORD i, cbCipher, cbOut = 0;
+	BOOL bResult = FALSE, bTdea = (Key2 != NULL && Key3 != NULL);
 
-	Xor(in, IV, 8, inTemp);
-	DesEncrypt(inTemp, OriginalKey, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	printf("%-22s = ", "Input");
+	for (i = 0; i < cbIn; i++)
 	{
-		Xor(&in[cbCurrent], &out[cbCurrent - 8], 8, inTemp);
-		DesEncrypt(inTemp, OriginalKey, &out[cbCurrent]);
+		printf("%02x", in[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
 	}
+	printf("\r\n");
 
-	return;
-}
-
-VOID WINAPI DesCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
-{
-	BYTE outTemp[8];
-	DWORD cbCurrent;
-
-	DesDecrypt(in, OriginalKey, outTemp);
-	Xor(outTemp, IV, 8, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	printf("%-22s = ", bTdea ? "Key1" : "Key");
+	for (i = 0; i < 8; i++)
 	{
-		DesDecrypt(&in[cbCurrent], OriginalKey, outTemp);
-		Xor(outTemp, &in[cbCurrent - 8], 8, &out[cbCurrent]);
+		printf("%02x", Key1[i]);
 	}
+	printf("\r\n");
 
-	return;
-}
+	if (bTdea)
+	{
+		printf("%-22s = ", "Key2");
+		for (i = 0; i < 8; i++)
+		{
+			printf("%02x", Key2[i]);
+		}
+		printf("\r\n");
 
-VOID WINAPI DesCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
-{
-	BYTE outTemp[8];
-	DWORD cbCurrent;
+		printf("%-22s = ", "Key3");
+		for (i = 0; i < 8; i++)
+		{
+			printf("%02x", Key3[i]);
+		}
+		printf("\r\n");
+	}
 
-	DesEncrypt(IV, OriginalKey, outTemp);
-	Xor(in, outTemp, 8, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	printf("%-22s = ", "Initialization Vector");
+	for (i = 0; i < 8; i++)
 	{
-		DesEncrypt(&out[cbCurrent - 8], OriginalKey, outTemp);
-		Xor(&in[cbCurrent], outTemp, 8, &out[cbCurrent]);
+		printf("%02x", IV[i]);
 	}
+	printf("\r\n");
 
-	return;
-}
-
-VOID WINAPI DesCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
-{
-	BYTE outTemp[8];
-	DWORD cbCurrent;
+	// o̓obt@̃TCY͈ÍOɊm肷
+	cbCipher = DesGetOutputLength(cbIn, dwPadding);
+	cipher = (BYTE*)CiphAlloc(cbCipher);
+	out = (BYTE*)CiphAlloc(cbCipher);
 
-	DesEncrypt(IV, OriginalKey, outTemp);
-	Xor(in, outTemp, 8, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	if (dwMode == DES_MODE_ECB)
+	{
+		bTdea ? TdeaEcbEncryptPkcs7(in, cbIn, Key1, Key2, Key3, cipher) : DesEcbEncryptPkcs7(in, cbIn, Key1, cipher);
+		printf("%-22s = ", "Cipher Text (ECB-P7)");
+	}
+	else if (dwPadding == DES_PADDING_PKCS7)
+	{
+		bTdea ? TdeaCbcEncryptPkcs7(in, cbIn, Key1, Key2, Key3, IV, cipher) : DesCbcEncryptPkcs7(in, cbIn, Key1, IV, cipher);
+		printf("%-22s = ", "Cipher Text (CBC-P7)");
+	}
+	else
 	{
-		DesEncrypt(&in[cbCurrent - 8], OriginalKey, outTemp);
-		Xor(&in[cbCurrent], outTemp, 8, &out[cbCurrent]);
+		bTdea ? TdeaCbcEncryptCts(in, cbIn, Key1, Key2, Key3, IV, dwPadding, cipher) : DesCbcEncryptCts(in, cbIn, Key1, IV, dwPadding, cipher);
+		printf("Cipher Text (CBC-CS%u)  = ", dwPadding - DES_PADDING_CS1 + 1);
 	}
 
-	return;
-}
+	for (i = 0; i < cbCipher; i++)
+	{
+		printf("%02x", cipher[i]);
+		if (i % 8 == 7)
+		{
+			printf(" ");
+		}
+	}
+	printf("\r\n");
 
-VOID WINAPI DesOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
-{
-	BYTE Temp1[8], Temp2[8];
-	DWORD cbCurrent;
+	if (dwMode == DES_MODE_ECB)
+	{
+		bResult = bTdea ? TdeaEcbDecryptPkcs7(cipher, cbCipher, Key1, Key2, Key3, out, &cbOut) : DesEcbDecryptPkcs7(cipher, cbCipher, Key1, out, &cbOut);
+	}
+	else if (dwPadding == DES_PADDING_PKCS7)
+	{
+		bResult = bTdea ? TdeaCbcDecryptPkcs7(cipher, cbCipher, Key1, Key2, Key3, IV, out, &cbOut) : DesCbcDecryptPkcs7(cipher, cbCipher, Key1, IV, out, &cbOut);
+	}
+	else
+	{
+		bResult = bTdea ? TdeaCbcDecryptCts(cipher, cbCipher, Key1, Key2, Key3, IV, dwPadding, out) : DesCbcDecryptCts(cipher, cbCipher, Key1, IV, dwPadding, out);
+		cbOut = cbCipher;
+	}
 
-	DesEncrypt(IV, OriginalKey, Temp2);
-	Xor(in, Temp2, 8, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	printf("%-22s = ", "Output");
+	if (bResult)
 	{
-		DesEncrypt(Temp2, OriginalKey, Temp1);
-		Xor(&in[cbCurrent], Temp1, 8, &out[cbCurrent]);
+		for (i = 0; i < cbOut; i++)
+		{
+			printf("%02x", out[i]);
+			if (i % 8 == 7)
+			{
+				printf(" ");
+			}
+		}
+	}
+	else
+	{
+		printf("(invalid padding)");
 	}
+	printf("\r\n");
+
+	CiphFree(cipher);
+	CiphFree(out);
 
 	return;
 }
 
-VOID WINAPI TdeaEncrypt(BYTE* in, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
+// nBlocks ̃ubN܂Ƃ߂ď (rbgXCX)  1 ubNʂƈv邱ƁAɖ߂邱ƂmF
+VOID WINAPI TdeaBitslicedCheck(BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, DWORD nBlocks)
 {
-	BYTE Temp1[8], Temp2[8];
+	DWORD i, cbData = 8 * nBlocks;
+	BYTE* data, * Bulk, * Single;
+	BYTE Counter[8];
+	BOOL bDesMatch, bTdeaMatch, bCbcMatch, bCtrMatch;
+	DES_KEY_CONTEXT DesContext;
+	TDEA_KEY_CONTEXT Context;
+
+	data = (BYTE*)CiphAlloc(cbData);
+	Bulk = (BYTE*)CiphAlloc(cbData);
+	Single = (BYTE*)CiphAlloc(cbData);
+
+	for (i = 0; i < cbData; i++)
+	{
+		data[i] = (BYTE)(i * 31 + (i >> 8));
+	}
+	DesKeySetup(Key1, &DesContext);
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
 
-	DesEncrypt(in, Key1, Temp2);
-	DesDecrypt(Temp2, Key2, Temp1);
-	DesEncrypt(Temp1, Key3, out);
+	// DES (ECB)
+	DesEcbEncryptDecrypt(data, cbData, Key1, Bulk);
+	for (i = 0; i < cbData; i += 8)
+	{
+		DesCryptBlock(&DesContext, &data[i], &Single[i], FALSE);
+	}
+	bDesMatch = memcmp(Bulk, Single, cbData) == 0;
+	DesEcbDecrypt(Bulk, cbData, Key1, Bulk);
+	bDesMatch = bDesMatch && memcmp(data, Bulk, cbData) == 0;
 
-	return;
-}
+	// TDEA (ECB)
+	TdeaEcbEncrypt(data, cbData, Key1, Key2, Key3, Bulk);
+	for (i = 0; i < cbData; i += 8)
+	{
+		TdeaCryptBlock(&Context, &data[i], &Single[i], FALSE);
+	}
+	bTdeaMatch = memcmp(Bulk, Single, cbData) == 0;
+	TdeaEcbDecrypt(Bulk, cbData, Key1, Key2, Key3, Bulk);
+	bTdeaMatch = bTdeaMatch && memcmp(data, Bulk, cbData) == 0;
+
+	// TDEA (CBC) : Í 1 ubNA͂܂Ƃ߂čs
+	TdeaCbcEncrypt(data, cbData, Key1, Key2, Key3, IV, Bulk);
+	TdeaCbcDecrypt(Bulk, cbData, Key1, Key2, Key3, IV, Bulk);
+	bCbcMatch = memcmp(data, Bulk, cbData) == 0;
+
+	// TDEA (CTR)
+	TdeaCtrEncryptDecrypt(data, cbData, Key1, Key2, Key3, IV, Bulk);
+	for (i = 0; i < cbData; i += 8)
+	{
+		Store64(Load64(IV) + i / 8, Counter);
+		TdeaCryptBlock(&Context, Counter, &Single[i], FALSE);
+		Xor(&data[i], &Single[i], 8, &Single[i]);
+	}
+	bCtrMatch = memcmp(Bulk, Single, cbData) == 0;
 
-VOID WINAPI TdeaDecrypt(BYTE* in, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
-{
-	BYTE Temp1[8], Temp2[8];
+	printf("%-21s = %u blocks\r\n", "Bitsliced", nBlocks);
+	printf("%-21s = %s\r\n", "DES (ECB)", bDesMatch ? "match" : "mismatch");
+	printf("%-21s = %s\r\n", "TDEA (ECB)", bTdeaMatch ? "match" : "mismatch");
+	printf("%-21s = %s\r\n", "TDEA (CBC)", bCbcMatch ? "match" : "mismatch");
+	printf("%-21s = %s\r\n", "TDEA (CTR)", bCtrMatch ? "match" : "mismatch");
 
-	DesDecrypt(in, Key3, Temp2);
-	DesEncrypt(Temp2, Key2, Temp1);
-	DesDecrypt(Temp1, Key1, out);
+	SecureZeroMemory(&DesContext, sizeof(DesContext));
+	SecureZeroMemory(&Context, sizeof(Context));
+	CiphFree(data);
+	CiphFree(Bulk);
+	CiphFree(Single);
 
 	return;
 }
 
-VOID WINAPI TdeaEcbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
+// cbData oCgxɏʂƁAr̈ʒu؂ (XbhςȂ) ʂv邱ƁAɖ߂邱ƂmF
+VOID WINAPI DesCtrSeekCheck(BYTE* Key, BYTE* ICV, DWORD cbData)
 {
-	BYTE Temp1[8], Temp2[8];
-	DWORD cbCurrent;
+	DWORD i, k, cbPiece;
+	BYTE* data, * Whole, * Pieces;
+	BOOL bSeekMatch, bParallelMatch;
+	DES_KEY_CONTEXT Context;
 
-	DesEncrypt(in, Key1, Temp2);
-	DesDecrypt(Temp2, Key2, Temp1);
-	DesEncrypt(Temp1, Key3, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	data = (BYTE*)CiphAlloc(cbData);
+	Whole = (BYTE*)CiphAlloc(cbData);
+	Pieces = (BYTE*)CiphAlloc(cbData);
+
+	for (i = 0; i < cbData; i++)
 	{
-		DesEncrypt(&in[cbCurrent], Key1, Temp2);
-		DesDecrypt(Temp2, Key2, Temp1);
-		DesEncrypt(Temp1, Key3, &out[cbCurrent]);
+		data[i] = (BYTE)(i * 31 + (i >> 8));
 	}
+	DesKeySetup(Key, &Context);
 
-	return;
-}
+	// 擪 1 Xbhŏ
+	DesCtrEncryptDecryptContext(&Context, data, cbData, ICV, 0, Whole, 1);
 
-VOID WINAPI TdeaEcbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
-{
-	BYTE Temp1[8], Temp2[8];
-	DWORD cbCurrent;
-
-	DesDecrypt(in, Key3, Temp2);
-	DesEncrypt(Temp2, Key2, Temp1);
-	DesDecrypt(Temp1, Key1, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	// ubNEɂȂŋ؂Aꂼ̃oCgʒu珈
+	for (i = 0, k = 0; i < cbData; i += cbPiece, k++)
 	{
-		DesDecrypt(&in[cbCurrent], Key3, Temp2);
-		DesEncrypt(Temp2, Key2, Temp1);
-		DesDecrypt(Temp1, Key1, &out[cbCurrent]);
+		cbPiece = 1 + (k * 7919 + 13) % 40009;
+		if (cbPiece > cbData - i)
+		{
+			cbPiece = cbData - i;
+		}
+		DesCtrEncryptDecryptContext(&Context, &data[i], cbPiece, ICV, i, &Pieces[i], 1 + k % 4);
 	}
+	bSeekMatch = memcmp(Whole, Pieces, cbData) == 0;
 
-	return;
-}
+	// 4 Xbhł̏ŕ
+	DesCtrEncryptDecryptContext(&Context, Whole, cbData, ICV, 0, Whole, 4);
+	bParallelMatch = memcmp(data, Whole, cbData) == 0;
 
-VOID WINAPI TdeaCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
-{
-	BYTE Temp1[8], Temp2[8];
-	DWORD cbCurrent;
+	printf("%-21s = %u bytes\r\n", "DES (CTR)", cbData);
+	printf("%-21s = %s\r\n", "Seek", bSeekMatch ? "match" : "mismatch");
+	printf("%-21s = %s\r\n", "Parallel", bParallelMatch ? "match" : "mismatch");
 
-	Xor(in, IV, 8, Temp1);
-	DesEncrypt(Temp1, Key1, Temp2);
-	DesDecrypt(Temp2, Key2, Temp1);
-	DesEncrypt(Temp1, Key3, Temp2);
-	memcpy(out, Temp2, 8);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
-	{
-		Xor(Temp2, &in[cbCurrent], 8, Temp1);
-		DesEncrypt(Temp1, Key1, Temp2);
-		DesDecrypt(Temp2, Key2, Temp1);
-		DesEncrypt(Temp1, Key3, Temp2);
-		memcpy(&out[cbCurrent], Temp2, 8);
-	}
+	SecureZeroMemory(&Context, sizeof(Context));
+	CiphFree(data);
+	CiphFree(Whole);
+	CiphFree(Pieces);
 
 	return;
 }
 
-VOID WINAPI TdeaCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+// q̕񏈗̊mFɎgp[^
+typedef struct
 {
-	BYTE Temp1[8], Temp2[8];
-	DWORD cbCurrent;
-
-	DesDecrypt(in, Key3, Temp2);
-	DesEncrypt(Temp2, Key2, Temp1);
-	DesDecrypt(Temp1, Key1, Temp2);
-	Xor(Temp2, IV, 8, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
-	{
-		DesDecrypt(&in[cbCurrent], Key3, Temp2);
-		DesEncrypt(Temp2, Key2, Temp1);
-		DesDecrypt(Temp1, Key1, Temp2);
-		Xor(Temp2, &in[cbCurrent - 8], 8, &out[cbCurrent]);
-	}
+	DWORD* Counts;
+	DWORD nInner;
+} DES_PARALLEL_CHECK;
 
-	return;
-}
-
-VOID WINAPI TdeaCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+// DesParallelInnerWorker ֐
+// ږɏ񐔂𐔂
+VOID WINAPI DesParallelInnerWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
 {
-	BYTE Temp1[8], Temp2[8];
-	DWORD cbCurrent;
+	DWORD* Counts = (DWORD*)pParam;
+	DWORD i;
 
-	DesEncrypt(IV, Key1, Temp1);
-	DesDecrypt(Temp1, Key2, Temp2);
-	DesEncrypt(Temp2, Key3, Temp1);
-	Xor(in, Temp1, 8, Temp2);
-	memcpy(out, Temp2, 8);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	for (i = dwFirst; i < dwFirst + dwCount; i++)
 	{
-		DesEncrypt(Temp2, Key1, Temp1);
-		DesDecrypt(Temp1, Key2, Temp2);
-		DesEncrypt(Temp2, Key3, Temp1);
-		Xor(&in[cbCurrent], Temp1, 8, Temp2);
-		memcpy(&out[cbCurrent], Temp2, 8);
+		Counts[i]++;
 	}
 
 	return;
 }
 
-VOID WINAPI TdeaCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+// DesParallelOuterWorker ֐
+// ږ nInner ̍ڂ̕񏈗qōs
+VOID WINAPI DesParallelOuterWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
 {
-	BYTE Temp1[8], Temp2[8];
-	DWORD cbCurrent;
+	DES_PARALLEL_CHECK* pCheck = (DES_PARALLEL_CHECK*)pParam;
+	DWORD i;
 
-	DesEncrypt(IV, Key1, Temp1);
-	DesDecrypt(Temp1, Key2, Temp2);
-	DesEncrypt(Temp2, Key3, Temp1);
-	Xor(in, Temp1, 8, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	for (i = dwFirst; i < dwFirst + dwCount; i++)
 	{
-		DesEncrypt(&in[cbCurrent - 8], Key1, Temp1);
-		DesDecrypt(Temp1, Key2, Temp2);
-		DesEncrypt(Temp2, Key3, Temp1);
-		Xor(&in[cbCurrent], Temp1, 8, &out[cbCurrent]);
+		RunParallel(DesParallelInnerWorker, &pCheck->Counts[(SIZE_T)i * pCheck->nInner], pCheck->nInner, 0);
 	}
 
 	return;
 }
 
-VOID WINAPI TdeaOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+// DesParallelCheck ֐
+// Xbhv[̊mF
+// 񏈗̏ dwConcurrency ɐݒ肵AcbData oCg DES-CTR ɏʂ 1 Xbhŏʂƈv邱ƁA
+// nOuter ̍ڂ̒ nInner ̍ڂ̕񏈗qōsASĂ̍ڂ傤 1 񂸂邱ƂmF
+VOID WINAPI DesParallelCheck(BYTE* Key, BYTE* ICV, DWORD cbData, DWORD nOuter, DWORD nInner, DWORD dwConcurrency)
 {
-	BYTE Temp1[8], Temp2[8];
-	DWORD cbCurrent;
+	DWORD i;
+	BYTE* data, * Single, * Parallel;
+	BOOL bCtrMatch, bNestedMatch = TRUE;
+	DES_KEY_CONTEXT Context;
+	DES_PARALLEL_CHECK Check;
+
+	SetParallelConcurrency(dwConcurrency);
+
+	data = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Single = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Parallel = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Check.Counts = (DWORD*)CiphAlloc(sizeof(DWORD) * nOuter * nInner);
+	Check.nInner = nInner;
 
-	DesEncrypt(IV, Key1, Temp1);
-	DesDecrypt(Temp1, Key2, Temp2);
-	DesEncrypt(Temp2, Key3, Temp1);
-	Xor(in, Temp1, 8, out);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	for (i = 0; i < cbData; i++)
 	{
-		DesEncrypt(Temp1, Key1, Temp2);
-		DesDecrypt(Temp2, Key2, Temp1);
-		DesEncrypt(Temp1, Key3, Temp2);
-		Xor(&in[cbCurrent], Temp2, 8, &out[cbCurrent]);
-		memcpy(Temp1, Temp2, 8);
+		data[i] = (BYTE)(i * 17 + (i >> 9));
 	}
+	DesKeySetup(Key, &Context);
 
-	return;
-}
+	DesCtrEncryptDecryptContext(&Context, data, cbData, ICV, 0, Single, 1);
+	DesCtrEncryptDecryptContext(&Context, data, cbData, ICV, 0, Parallel, 0);
+	bCtrMatch = memcmp(Single, Parallel, cbData) == 0;
 
-VOID WINAPI TdeaCtrEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* ICV, BYTE* out)
-{
-	BYTE Temp1[8], Temp2[8], ICVCurrent[8], i;
-	DWORD cbCurrent;
-	ULONG64 ICVTemp;
-
-	DesEncrypt(ICV, Key1, Temp1);
-	DesDecrypt(Temp1, Key2, Temp2);
-	DesEncrypt(Temp2, Key3, Temp1);
-	Xor(in, Temp1, 8, out);
-	memcpy(ICVCurrent, ICV, 8);
-	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
-	{
-		if (ICVCurrent[7] == 0xff)
-		{
-			ICVTemp = 0;
-			for (i = 0; i < 8; i++)
-			{
-				ICVTemp <<= 8;
-				ICVTemp += ICVCurrent[i];
-			}
-			ICVTemp++;
-			for (i = 0; i < 8; i++)
-			{
-				ICVCurrent[7 - i] = (BYTE)(ICVTemp & 0xff);
-				ICVTemp >>= 8;
-			}
-		}
-		else
+	RunParallel(DesParallelOuterWorker, &Check, nOuter, 0);
+	for (i = 0; i < nOuter * nInner; i++)
+	{
+		if (Check.Counts[i] != 1)
 		{
-			ICVCurrent[7]++;
+			bNestedMatch = FALSE;
 		}
-
-		DesEncrypt(ICVCurrent, Key1, Temp1);
-		DesDecrypt(Temp1, Key2, Temp2);
-		DesEncrypt(Temp2, Key3, Temp1);
-		Xor(&in[cbCurrent], Temp1, 8, &out[cbCurrent]);
 	}
 
+	printf("%-21s = %u threads\r\n", "Concurrency", GetParallelConcurrency());
+	printf("%-21s = %u bytes (%s)\r\n", "Parallel (CTR)", cbData, bCtrMatch ? "match" : "mismatch");
+	printf("%-21s = %u x %u items (%s)\r\n", "Nested", nOuter, nInner, bNestedMatch ? "match" : "mismatch");
+
+	// _vZbTɖ߂
+	SetParallelConcurrency(0);
+
+	SecureZeroMemory(&Context, sizeof(Context));
+	CiphFree(data);
+	CiphFree(Single);
+	CiphFree(Parallel);
+	CiphFree(Check.Counts);
+
 	return;
 }
 
-#define DES_MODE_ECB 1
-#define DES_MODE_CBC 2
-#define DES_MODE_CFB 3
-#define DES_MODE_OFB 4
-#define DES_MODE_CTR 5
-
-// DES ɂÍƕ̃eXgp֐
-VOID WINAPI DesEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out, DWORD dwMode)
+// DesMacGenerate ֐
+// MAC vZĕ\ (Key2, Key3 ͎gpȂꍇ NULL Ƃ)
+VOID WINAPI DesMacGenerate(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, DWORD dwAlgorithm, DWORD dwPadding)
 {
-	DWORD i;
-	BYTE* pInTemp;
+	DWORD i, j;
+	BYTE Mac[8];
+	BYTE* Keys[3] = { Key1, Key2, Key3 };
+	DES_MAC_CONTEXT Context;
 
 	printf("%-22s = ", "Input");
 	for (i = 0; i < cbIn; i++)
@@ -846,319 +725,540 @@ VOID WINAPI DesEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV,
 	}
 	printf("\r\n");
 
-	printf("%-22s = ", "Key");
-	for (i = 0; i < 8; i++)
+	for (j = 0; j < 3 && Keys[j] != NULL; j++)
 	{
-		printf("%02x", OriginalKey[i]);
+		printf("Key%-19u = ", j + 1);
+		for (i = 0; i < 8; i++)
+		{
+			printf("%02x", Keys[j][i]);
+		}
+		printf("\r\n");
 	}
-	printf("\r\n");
 
-	printf("%-22s = ", "Initialization Vector");
+	DesMacInit(Key1, Key2, Key3, dwAlgorithm, dwPadding, &Context);
+	DesMac(&Context, in, cbIn, Mac);
+
+	printf("%-22s = ", dwAlgorithm == DES_MAC_CMAC ? "MAC (CMAC)" : dwAlgorithm == DES_MAC_ALGORITHM3 ? "MAC (Algorithm 3)" : "MAC (Algorithm 1)");
 	for (i = 0; i < 8; i++)
 	{
-		printf("%02x", IV[i]);
+		printf("%02x", Mac[i]);
 	}
 	printf("\r\n");
 
-	switch (dwMode)
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+// ꊇ̌ʂ 1 bZ[WvZʂƈv邩Aꊇ؂ŉ񂵂bZ[WsvƂȂ邩mF
+// bZ[W 0 ` cbMax oCgł΂΂ɂAMAC ͐擪 4 oCgɐ؂l߂Č؂
+VOID WINAPI DesMacBatchGenerate(BYTE* Key1, BYTE* Key2, BYTE* Key3, DWORD dwAlgorithm, DWORD dwPadding, DWORD nMessages, DWORD cbMax)
+{
+	DWORD i, nValid;
+	BYTE Mac[8];
+	BYTE* data, * Macs, * Expected;
+	BYTE** Messages;
+	DWORD* cbMessages;
+	BOOL* Results;
+	BOOL bMatch = TRUE, bVerify = TRUE;
+	DES_MAC_CONTEXT Context;
+
+	data = (BYTE*)CiphAlloc(cbMax + 1);
+	Macs = (BYTE*)CiphAlloc(8 * (SIZE_T)nMessages);
+	Expected = (BYTE*)CiphAlloc(4 * (SIZE_T)nMessages);
+	Messages = (BYTE**)CiphAlloc(sizeof(BYTE*) * nMessages);
+	cbMessages = (DWORD*)CiphAlloc(sizeof(DWORD) * nMessages);
+	Results = (BOOL*)CiphAlloc(sizeof(BOOL) * nMessages);
+
+	for (i = 0; i <= cbMax; i++)
 	{
-	case DES_MODE_ECB:
-		DesEcbEncryptDecrypt(in, cbIn, OriginalKey, out);
+		data[i] = (BYTE)(i * 7);
+	}
+	for (i = 0; i < nMessages; i++)
+	{
+		cbMessages[i] = (i * 37) % (cbMax + 1);
+		Messages[i] = &data[(i * 13) % (cbMax + 1 - cbMessages[i])];
+	}
 
-		printf("%-22s = ", "Cipher Text (ECB)");
-		for (i = 0; i < cbIn; i++)
+	DesMacInit(Key1, Key2, Key3, dwAlgorithm, dwPadding, &Context);
+	DesMacBatch(&Context, Messages, cbMessages, nMessages, Macs);
+	for (i = 0; i < nMessages; i++)
+	{
+		DesMac(&Context, Messages[i], cbMessages[i], Mac);
+		if (memcmp(Mac, &Macs[8 * i], 8) != 0)
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
+			bMatch = FALSE;
 		}
-		printf("\r\n");
-
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
-		DesEcbEncryptDecrypt(pInTemp, cbIn, OriginalKey, out);
-		HeapFree(GetProcessHeap(), 0, pInTemp);
-
-		break;
-
-	case DES_MODE_CBC:
-		DesCbcEncrypt(in, cbIn, OriginalKey, IV, out);
+	}
 
-		printf("%-22s = ", "Cipher Text (CBC)");
-		for (i = 0; i < cbIn; i++)
+	// 10 bZ[W 1  MAC  1 rbg𔽓]Ă
+	for (i = 0; i < nMessages; i++)
+	{
+		memcpy(&Expected[4 * i], &Macs[8 * i], 4);
+		if (i % 10 == 3)
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
+			Expected[4 * i + i % 4] ^= (BYTE)(1 << (i % 8));
 		}
-		printf("\r\n");
-
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
-		DesCbcDecrypt(pInTemp, cbIn, OriginalKey, IV, out);
-		HeapFree(GetProcessHeap(), 0, pInTemp);
-
-		break;
-
-	case DES_MODE_CFB:
-		DesCfbEncrypt(in, cbIn, OriginalKey, IV, out);
-
-		printf("%-22s = ", "Cipher Text (CFB)");
-		for (i = 0; i < cbIn; i++)
+	}
+	nValid = DesMacVerifyBatch(&Context, Messages, cbMessages, nMessages, Expected, 4, Results);
+	for (i = 0; i < nMessages; i++)
+	{
+		if (Results[i] != (i % 10 != 3))
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
+			bVerify = FALSE;
 		}
-		printf("\r\n");
+	}
 
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
-		DesCfbDecrypt(pInTemp, cbIn, OriginalKey, IV, out);
-		HeapFree(GetProcessHeap(), 0, pInTemp);
+	printf("%-21s = %u messages, 0 - %u bytes\r\n", "Batch (MAC)", nMessages, cbMax);
+	printf("%-21s = %s\r\n", "Result", bMatch ? "match" : "mismatch");
+	printf("%-21s = %u / %u valid (%s)\r\n", "Verify", nValid, nMessages, bVerify ? "match" : "mismatch");
 
-		break;
+	SecureZeroMemory(&Context, sizeof(Context));
+	CiphFree(data);
+	CiphFree(Macs);
+	CiphFree(Expected);
+	CiphFree(Messages);
+	CiphFree(cbMessages);
+	CiphFree(Results);
 
-	case DES_MODE_OFB:
-		DesOfbEncryptDecrypt(in, cbIn, OriginalKey, IV, out);
+	return;
+}
 
-		printf("%-22s = ", "Cipher Text (OFB)");
-		for (i = 0; i < cbIn; i++)
-		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
-		}
-		printf("\r\n");
+// DukptGenerate ֐
+// BDK  KSN  IPEK ƁAJE^ dwFirst ` dwLast ̃gUNV (PIN, MAC v, f[^v) 𓱏oĕ\
+VOID WINAPI DukptGenerate(BYTE* Bdk, BYTE* Ksn, DWORD dwFirst, DWORD dwLast)
+{
+	DWORD i, dwCounter;
+	BYTE Ipek[16], Key[16];
+	DUKPT_BDK_CONTEXT BdkContext;
+	DUKPT_CONTEXT Context;
+
+	printf("%-22s = ", "BDK");
+	for (i = 0; i < 16; i++)
+	{
+		printf("%02x", Bdk[i]);
+	}
+	printf("\r\n");
 
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
-		DesOfbEncryptDecrypt(pInTemp, cbIn, OriginalKey, IV, out);
-		HeapFree(GetProcessHeap(), 0, pInTemp);
+	DukptBdkSetup(Bdk, &BdkContext);
+	DukptDeriveIpek(&BdkContext, Ksn, Ipek);
+	DukptInit(Ipek, Ksn, &Context);
 
-		break;
+	printf("%-22s = ", "IPEK");
+	for (i = 0; i < 16; i++)
+	{
+		printf("%02x", Ipek[i]);
+	}
+	printf("\r\n");
 
-	default:
-		DesEncrypt(in, OriginalKey, out);
+	for (dwCounter = dwFirst; dwCounter <= dwLast; dwCounter++)
+	{
+		printf("%-22s = ", "KSN");
+		for (i = 0; i < 7; i++)
+		{
+			printf("%02x", Context.Ksn[i]);
+		}
+		printf("%06x\r\n", (Context.Ksn[7] << 16) | dwCounter);
 
-		printf("%-22s = ", "Cipher Text");
-		for (i = 0; i < cbIn; i++)
+		DukptDeriveKey(&Context, dwCounter, DUKPT_VARIANT_PIN, Key);
+		printf("%-22s = ", "PIN Key");
+		for (i = 0; i < 16; i++)
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
+			printf("%02x", Key[i]);
 		}
 		printf("\r\n");
 
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
-		DesDecrypt(pInTemp, OriginalKey, out);
-		HeapFree(GetProcessHeap(), 0, pInTemp);
-
-		break;
-	}
+		DukptDeriveKey(&Context, dwCounter, DUKPT_VARIANT_MAC_REQUEST, Key);
+		printf("%-22s = ", "MAC Key (Request)");
+		for (i = 0; i < 16; i++)
+		{
+			printf("%02x", Key[i]);
+		}
+		printf("\r\n");
 
-	printf("%-22s = ", "Output");
-	for (i = 0; i < cbIn; i++)
-	{
-		printf("%02x", out[i]);
-		if (i % 8 == 7)
+		DukptDeriveKey(&Context, dwCounter, DUKPT_VARIANT_DATA_REQUEST, Key);
+		printf("%-22s = ", "Data Key (Request)");
+		for (i = 0; i < 16; i++)
 		{
-			printf(" ");
+			printf("%02x", Key[i]);
 		}
+		printf("\r\n");
 	}
-	printf("\r\n");
+
+	SecureZeroMemory(Ipek, 16);
+	SecureZeroMemory(Key, 16);
+	SecureZeroMemory(&BdkContext, sizeof(BdkContext));
+	SecureZeroMemory(&Context, sizeof(Context));
 
 	return;
 }
 
-VOID WINAPI TdeaEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IVorICV, BYTE* out, DWORD dwMode)
+// ꊇǒʂ KSN  IPEK 瓱oʂƈv邩mF
+// nDevices ̒[ KSN (JE^ 0 ` 4095) ΂΂̏ nKsns ׂ
+VOID WINAPI DukptBatchCheck(BYTE* Bdk, BYTE* Ksn, DWORD nDevices, DWORD nKsns)
 {
-	BYTE* pInTemp;
-	DWORD i;
+	DWORD i, dwDevice, dwCounter;
+	BYTE Ipek[16], Key[16];
+	BYTE* Ksns, * Keys;
+	BOOL bMatch = TRUE;
+	DUKPT_BDK_CONTEXT BdkContext;
+	DUKPT_CONTEXT Context;
 
-	printf("%-22s = ", "Input");
-	for (i = 0; i < cbIn; i++)
+	Ksns = (BYTE*)CiphAlloc(10 * (SIZE_T)nKsns);
+	Keys = (BYTE*)CiphAlloc(16 * (SIZE_T)nKsns);
+
+	for (i = 0; i < nKsns; i++)
 	{
-		printf("%02x", in[i]);
-		if (i % 8 == 7)
+		dwDevice = (i * 7) % nDevices;
+		dwCounter = (DWORD)(i * 2654435761UL) >> 20;
+		memcpy(&Ksns[10 * i], Ksn, 10);
+		Ksns[10 * i + 5] ^= (BYTE)(dwDevice >> 3);
+		Ksns[10 * i + 7] = (BYTE)((Ksn[7] & 0x1F) | dwDevice << 5);
+		Ksns[10 * i + 8] = (BYTE)(dwCounter >> 8);
+		Ksns[10 * i + 9] = (BYTE)dwCounter;
+	}
+
+	DukptBdkSetup(Bdk, &BdkContext);
+	DukptDeriveBatch(&BdkContext, Ksns, nKsns, DUKPT_VARIANT_PIN, Keys);
+	for (i = 0; i < nKsns; i++)
+	{
+		DukptDeriveIpek(&BdkContext, &Ksns[10 * i], Ipek);
+		DukptInit(Ipek, &Ksns[10 * i], &Context);
+		DukptDeriveKey(&Context, DukptCounter(&Ksns[10 * i]), DUKPT_VARIANT_PIN, Key);
+		if (memcmp(Key, &Keys[16 * i], 16) != 0)
 		{
-			printf(" ");
+			bMatch = FALSE;
 		}
 	}
-	printf("\r\n");
 
-	printf("%-22s = ", "Key1");
+	printf("%-21s = %u KSNs, %u devices\r\n", "Batch (DUKPT)", nKsns, nDevices);
+	printf("%-21s = %s\r\n", "Result", bMatch ? "match" : "mismatch");
+
+	SecureZeroMemory(Ipek, 16);
+	SecureZeroMemory(Key, 16);
+	SecureZeroMemory(&BdkContext, sizeof(BdkContext));
+	SecureZeroMemory(&Context, sizeof(Context));
+	SecureZeroMemory(Keys, 16 * (SIZE_T)nKsns);
+	CiphFree(Ksns);
+	CiphFree(Keys);
+
+	return;
+}
+
+// PinTranslateGenerate ֐
+// PIN  PAN ` 0  PIN ubN쐬đM̌ňÍAM̌ɕϊĕ\
+// Ɍ` 0, 1, 3 ō쐬 nJobs  PIN ubNꊇŌ` 0 ɕϊAM̌ŕʂ
+// ڍ쐬` 0  PIN ubNƈv邱ƂmF
+VOID WINAPI PinTranslateGenerate(CHAR* Pin, CHAR* Pan, BYTE* SourceKey1, BYTE* SourceKey2, BYTE* SourceKey3, BYTE* DestinationKey1, BYTE* DestinationKey2, BYTE* DestinationKey3, DWORD nJobs)
+{
+	DWORD i, nValid;
+	BYTE Clear[8], Block[8];
+	BYTE* Blocks, * out;
+	BOOL* Results;
+	BOOL bMatch = TRUE;
+	TDEA_KEY_CONTEXT SourceContext, DestinationContext;
+	PIN_TRANSLATION_JOB* Jobs;
+
+	TdeaKeySetup(SourceKey1, SourceKey2, SourceKey3, &SourceContext);
+	TdeaKeySetup(DestinationKey1, DestinationKey2, DestinationKey3, &DestinationContext);
+
+	printf("%-22s = %s\r\n", "PIN", Pin);
+	printf("%-22s = %s\r\n", "PAN", Pan);
+
+	PinBlockEncode(Pin, PIN_FORMAT_ISO0, Pan, Clear);
+	printf("%-22s = ", "PIN Block (ISO 0)");
 	for (i = 0; i < 8; i++)
 	{
-		printf("%02x", Key1[i]);
+		printf("%02x", Clear[i]);
 	}
 	printf("\r\n");
 
-	printf("%-22s = ", "Key2");
+	TdeaCryptBlock(&SourceContext, Clear, Block, FALSE);
+	printf("%-22s = ", "Source");
 	for (i = 0; i < 8; i++)
 	{
-		printf("%02x", Key2[i]);
+		printf("%02x", Block[i]);
 	}
 	printf("\r\n");
 
-	printf("%-22s = ", "Key3");
-	for (i = 0; i < 8; i++)
+	Jobs = (PIN_TRANSLATION_JOB*)CiphAlloc(sizeof(PIN_TRANSLATION_JOB) * nJobs);
+	Blocks = (BYTE*)CiphAlloc(8 * (SIZE_T)nJobs);
+	out = (BYTE*)CiphAlloc(8 * (SIZE_T)nJobs);
+	Results = (BOOL*)CiphAlloc(sizeof(BOOL) * nJobs);
+
+	for (i = 0; i < nJobs; i++)
 	{
-		printf("%02x", Key3[i]);
+		Jobs[i].pSourceKey = &SourceContext;
+		Jobs[i].pDestinationKey = &DestinationContext;
+		Jobs[i].PinBlock = &Blocks[8 * i];
+		Jobs[i].Pan = Pan;
+		Jobs[i].dwSourceFormat = i % 3 == 0 ? PIN_FORMAT_ISO0 : i % 3 == 1 ? PIN_FORMAT_ISO1 : PIN_FORMAT_ISO3;
+		Jobs[i].dwDestinationFormat = PIN_FORMAT_ISO0;
+		PinBlockEncode(Pin, Jobs[i].dwSourceFormat, Pan, &Blocks[8 * i]);
+		TdeaCryptBlock(&SourceContext, &Blocks[8 * i], &Blocks[8 * i], FALSE);
 	}
-	printf("\r\n");
 
-	printf("%-22s = ", "IV or ICV");
+	nValid = PinTranslateBatch(Jobs, nJobs, out, Results);
+	printf("%-22s = ", "Destination");
 	for (i = 0; i < 8; i++)
 	{
-		printf("%02x", IVorICV[i]);
+		printf("%02x", out[i]);
 	}
 	printf("\r\n");
 
-	switch (dwMode)
+	for (i = 0; i < nJobs; i++)
 	{
-	case DES_MODE_ECB:
-		TdeaEcbEncrypt(in, cbIn, Key1, Key2, Key3, out);
-
-		printf("%-22s = ", "Cipher Text (TDEA-ECB)");
-		for (i = 0; i < cbIn; i++)
+		TdeaCryptBlock(&DestinationContext, &out[8 * i], Block, TRUE);
+		if (!Results[i] || memcmp(Block, Clear, 8) != 0)
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
+			bMatch = FALSE;
 		}
-		printf("\r\n");
+	}
+	printf("%-22s = %u / %u jobs (%s)\r\n", "Batch (ISO 0, 1, 3)", nValid, nJobs, bMatch ? "match" : "mismatch");
 
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
+	SecureZeroMemory(&SourceContext, sizeof(SourceContext));
+	SecureZeroMemory(&DestinationContext, sizeof(DestinationContext));
+	SecureZeroMemory(Clear, 8);
+	SecureZeroMemory(Block, 8);
+	CiphFree(Jobs);
+	CiphFree(Blocks);
+	CiphFree(out);
+	CiphFree(Results);
 
-		TdeaEcbDecrypt(pInTemp, cbIn, Key1, Key2, Key3, out);
+	return;
+}
 
-		break;
-	case DES_MODE_CBC:
-		TdeaCbcEncrypt(in, cbIn, Key1, Key2, Key3, IVorICV, out);
+// DesKcvGenerate ֐
+//  1  KCV \AcbKey oCǧ nKeys  KCV ꊇŌvZʂAƂɌvZʂƈv邱ƂmF
+//  Key ̊eoCgɌ̔ԍč
+VOID WINAPI DesKcvGenerate(BYTE* Key, DWORD cbKey, DWORD nKeys)
+{
+	DWORD i, j;
+	BYTE Zero[8] = { 0 }, Block[8];
+	BYTE* Keys, * Kcvs;
+	BOOL bMatch = TRUE;
+	TDEA_KEY_CONTEXT Context;
 
-		printf("%-22s = ", "Cipher Text (TDEA-CBC)");
-		for (i = 0; i < cbIn; i++)
+	Keys = (BYTE*)CiphAlloc(cbKey * (SIZE_T)nKeys);
+	Kcvs = (BYTE*)CiphAlloc(DES_KCV_LENGTH * (SIZE_T)nKeys);
+
+	for (i = 0; i < nKeys; i++)
+	{
+		for (j = 0; j < cbKey; j++)
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
+			Keys[cbKey * i + j] = (BYTE)(Key[j] + i * (j + 1));
 		}
-		printf("\r\n");
-
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
+	}
 
-		TdeaCbcDecrypt(pInTemp, cbIn, Key1, Key2, Key3, IVorICV, out);
+	DesKcvBatch(Keys, cbKey, nKeys, Kcvs, DES_KCV_LENGTH);
 
-		break;
-	case DES_MODE_CFB:
-		TdeaCfbEncrypt(in, cbIn, Key1, Key2, Key3, IVorICV, out);
+	printf("%-21s = ", "Key");
+	for (i = 0; i < cbKey; i++)
+	{
+		printf("%02x", Key[i]);
+	}
+	printf("\r\n");
+	printf("%-21s = ", "KCV");
+	for (i = 0; i < DES_KCV_LENGTH; i++)
+	{
+		printf("%02x", Kcvs[i]);
+	}
+	printf("\r\n");
 
-		printf("%-22s = ", "Cipher Text (TDEA-CFB)");
-		for (i = 0; i < cbIn; i++)
+	for (i = 0; i < nKeys; i++)
+	{
+		TdeaKeySetup(&Keys[cbKey * i], &Keys[cbKey * i + (cbKey == 8 ? 0 : 8)], &Keys[cbKey * i + (cbKey == 24 ? 16 : 0)], &Context);
+		TdeaCryptBlock(&Context, Zero, Block, FALSE);
+		if (memcmp(Block, &Kcvs[DES_KCV_LENGTH * i], DES_KCV_LENGTH) != 0)
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
+			bMatch = FALSE;
 		}
-		printf("\r\n");
+	}
+	printf("%-21s = %u keys (%s)\r\n", "Batch (KCV)", nKeys, bMatch ? "match" : "mismatch");
 
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
+	SecureZeroMemory(&Context, sizeof(Context));
+	SecureZeroMemory(Keys, cbKey * (SIZE_T)nKeys);
+	CiphFree(Keys);
+	CiphFree(Kcvs);
 
-		TdeaCfbDecrypt(pInTemp, cbIn, Key1, Key2, Key3, IVorICV, out);
+	return;
+}
 
-		break;
-	case DES_MODE_OFB:
-		TdeaOfbEncryptDecrypt(in, cbIn, Key1, Key2, Key3, IVorICV, out);
+// DesPrintBytes ֐
+// xɑ cb oCg̃f[^ 16 iŕ\
+VOID WINAPI DesPrintBytes(CONST CHAR* Label, BYTE* data, DWORD cb)
+{
+	DWORD i;
 
-		printf("%-22s = ", "Cipher Text (TDEA-OFB)");
-		for (i = 0; i < cbIn; i++)
-		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
-		}
-		printf("\r\n");
+	printf("%-21s = ", Label);
+	for (i = 0; i < cb; i++)
+	{
+		printf("%02x", data[i]);
+	}
+	printf("\r\n");
 
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
+	return;
+}
 
-		TdeaOfbEncryptDecrypt(pInTemp, cbIn, Key1, Key2, Key3, IVorICV, out);
+// TdeaLibraryEncryptDecrypt ֐
+// Cu C C^[tF[X (CiphLib.h) p TDEA  ECB, CBC, CTR ɂÍ / s
+// Key  K1 || K2 || K3  24 oCgƂACTR ͓r̃oCgʒu (Offset) 珈ʂmF
+// Ō K1 (DES), K1 || K2 (2-key TDEA), K1 || K2 || K3 (3-key TDEA)  KCV ꊇŌvZ
+VOID WINAPI TdeaLibraryEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* IV)
+{
+	BYTE* cipher, * out;
+	BYTE Kcvs[3];
+	DWORD dwOffset;
+	BOOL bMatch = TRUE;
+	CIPH_TDEA_KEY* hKey;
 
-		break;
-	case DES_MODE_CTR:
-		TdeaCtrEncryptDecrypt(in, cbIn, Key1, Key2, Key3, IVorICV, out);
+	if (CiphTdeaCreateKey(Key, 24, &hKey) != CIPH_SUCCESS)
+	{
+		return;
+	}
 
-		printf("%-22s = ", "Cipher Text (TDEA-CTR)");
-		for (i = 0; i < cbIn; i++)
+	cipher = (BYTE*)CiphAlloc(cbIn);
+	out = (BYTE*)CiphAlloc(cbIn);
+
+	DesPrintBytes("Key", Key, 24);
+	DesPrintBytes("Input", in, cbIn);
+
+	CiphTdeaEcbEncrypt(hKey, in, cbIn, cipher);
+	CiphTdeaEcbDecrypt(hKey, cipher, cbIn, out);
+	DesPrintBytes("Cipher Text (ECB)", cipher, cbIn);
+	DesPrintBytes("Output", out, cbIn);
+
+	// CBC ͕𓯂obt@ōs
+	CiphTdeaCbcEncrypt(hKey, IV, in, cbIn, cipher);
+	DesPrintBytes("Cipher Text (CBC)", cipher, cbIn);
+	CiphTdeaCbcDecrypt(hKey, IV, cipher, cbIn, cipher);
+	DesPrintBytes("Output", cipher, cbIn);
+
+	CiphTdeaCtrCrypt(hKey, IV, 0, in, cbIn, cipher);
+	CiphTdeaCtrCrypt(hKey, IV, 0, cipher, cbIn, out);
+	DesPrintBytes("Cipher Text (CTR)", cipher, cbIn);
+	DesPrintBytes("Output", out, cbIn);
+	for (dwOffset = 1; dwOffset < cbIn; dwOffset++)
+	{
+		CiphTdeaCtrCrypt(hKey, IV, dwOffset, &in[dwOffset], cbIn - dwOffset, out);
+		if (memcmp(out, &cipher[dwOffset], cbIn - dwOffset) != 0)
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
-			{
-				printf(" ");
-			}
+			bMatch = FALSE;
 		}
-		printf("\r\n");
+	}
+	printf("%-21s = %s\r\n", "Seek (CTR)", bMatch ? "match" : "mismatch");
 
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
+	CiphDesKcvBatch(Key, 8, 1, &Kcvs[0], 1);
+	CiphDesKcvBatch(Key, 16, 1, &Kcvs[1], 1);
+	CiphDesKcvBatch(Key, 24, 1, &Kcvs[2], 1);
+	DesPrintBytes("KCV (1 byte)", Kcvs, 3);
 
-		TdeaCtrEncryptDecrypt(pInTemp, cbIn, Key1, Key2, Key3, IVorICV, out);
+	// ̒ 8, 16, 24 oCĝłȂꍇ͌쐬Ȃ
+	printf("%-21s = %d\r\n", "Status (Key, 20)", CiphTdeaCreateKey(Key, 20, &hKey));
 
-		break;
-	default:
-		TdeaEncrypt(in, Key1, Key2, Key3, out);
+	CiphTdeaDestroyKey(hKey);
+	CiphFree(cipher);
+	CiphFree(out);
 
-		printf("%-22s = ", "Cipher Text (TDEA)");
-		for (i = 0; i < cbIn; i++)
+	return;
+}
+
+// TdeaDispatchCheck ֐
+// s@̑I (CiphSetDispatch) ̊mF
+// 1 ubN̏AݏA񏈗AÎꂼŁAECB, CBC ̕ (obt@), CTR (Offset = 5) ̌ʂv邱ƂmF
+// Key  8 oCg (DES) ܂ 24 oCg (3-key TDEA) ƂAŌɎIő肵񏈗臒l\ (1 XbhgȂꍇ͕񏈗I΂Ȃ)
+VOID WINAPI TdeaDispatchCheck(BYTE* Key, DWORD cbKey, BYTE* IV, BYTE* ICV, DWORD cbData, DWORD dwConcurrency)
+{
+	const DWORD Strategies[4] = { CIPH_DISPATCH_SERIAL, CIPH_DISPATCH_INTERLEAVED, CIPH_DISPATCH_THREADED, CIPH_DISPATCH_AUTO };
+	const CHAR* Labels[3] = { "Threshold (ECB)", "Threshold (CBC)", "Threshold (CTR)" };
+	DWORD Sizes[3] = { 24, 32768, cbData }, i, j;
+	BYTE* data, * Ecb, * Cbc, * Ctr, * out;
+	BOOL bMatch;
+	size_t cbThreaded;
+	CIPH_TDEA_KEY* hKey;
+
+	if (CiphTdeaCreateKey(Key, cbKey, &hKey) != CIPH_SUCCESS)
+	{
+		return;
+	}
+	CiphSetConcurrency(dwConcurrency);
+
+	data = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Ecb = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Cbc = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	Ctr = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	out = (BYTE*)CiphAllocEx(cbData, CIPH_ALLOC_NO_ZERO);
+	for (i = 0; i < cbData; i++)
+	{
+		data[i] = (BYTE)(i * 31 + (i >> 11));
+	}
+
+	printf("%-21s = %u threads\r\n", "Concurrency", dwConcurrency);
+	for (i = 0; i < 3; i++)
+	{
+		// 1 ubNʂƂ
+		CiphSetDispatch(CIPH_DISPATCH_SERIAL);
+		CiphTdeaEcbEncrypt(hKey, data, Sizes[i], Ecb);
+		CiphTdeaCbcEncrypt(hKey, IV, data, Sizes[i], Cbc);
+		CiphTdeaCtrCrypt(hKey, ICV, 5, data, Sizes[i], Ctr);
+
+		bMatch = TRUE;
+		for (j = 0; j < 4; j++)
 		{
-			printf("%02x", out[i]);
-			if (i % 8 == 7)
+			CiphSetDispatch(Strategies[j]);
+
+			CiphTdeaEcbEncrypt(hKey, data, Sizes[i], out);
+			if (memcmp(out, Ecb, Sizes[i]) != 0)
 			{
-				printf(" ");
+				bMatch = FALSE;
+			}
+			CiphTdeaEcbDecrypt(hKey, out, Sizes[i], out);
+			if (memcmp(out, data, Sizes[i]) != 0)
+			{
+				bMatch = FALSE;
 			}
-		}
-		printf("\r\n");
 
-		pInTemp = (BYTE*)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, cbIn);
-		memcpy(pInTemp, out, cbIn);
-		TdeaDecrypt(pInTemp, Key1, Key2, Key3, out);
+			memcpy(out, Cbc, Sizes[i]);
+			CiphTdeaCbcDecrypt(hKey, IV, out, Sizes[i], out);
+			if (memcmp(out, data, Sizes[i]) != 0)
+			{
+				bMatch = FALSE;
+			}
 
-		break;
+			CiphTdeaCtrCrypt(hKey, ICV, 5, data, Sizes[i], out);
+			if (memcmp(out, Ctr, Sizes[i]) != 0)
+			{
+				bMatch = FALSE;
+			}
+		}
+		printf("%-21s = %u bytes (%s)\r\n", "Dispatch", Sizes[i], bMatch ? "match" : "mismatch");
 	}
 
-	printf("%-22s = ", "Output");
-	for (i = 0; i < cbIn; i++)
+	for (i = 0; i < 3; i++)
 	{
-		printf("%02x", out[i]);
-		if (i % 8 == 7)
+		cbThreaded = CiphGetDispatchThreshold((cbKey == 8 ? CIPH_DISPATCH_KIND_DES_ECB : CIPH_DISPATCH_KIND_TDEA_ECB) + i);
+		if (cbThreaded == (size_t)-1)
 		{
-			printf(" ");
+			printf("%-21s = single thread\r\n", Labels[i]);
+		}
+		else
+		{
+			printf("%-21s = %u KB\r\n", Labels[i], (DWORD)(cbThreaded >> 10));
 		}
 	}
-	printf("\r\n");
+
+	// IƘ_vZbT̏ɖ߂
+	CiphSetDispatch(CIPH_DISPATCH_AUTO);
+	CiphSetConcurrency(0);
+
+	CiphTdeaDestroyKey(hKey);
+	CiphFree(data);
+	CiphFree(Ecb);
+	CiphFree(Cbc);
+	CiphFree(Ctr);
+	CiphFree(out);
+
+	return;
 }
 
 INT __cdecl main(INT argc, CHAR* argv[])
@@ -1174,6 +1274,7 @@ INT __cdecl main(INT argc, CHAR* argv[])
 	// Cipher Text (CBC) = e5c7cdde872bf27c 43e934008c389c0f 683788499a7c05f6
 	// Cipher Text (CFB) = f3096249c7f46e51 a69e839b1a92f784 03467133898ea622
 	// Cipher Text (OFB) = f3096249c7f46e51 35f24a242eeb3d3f 3d6d5be3255af8c3
+	// Cipher Text (CTR) = f3096249c7f46e51 163a8ca0ffc94c27 fa2f80f480b86f75
 	CHAR DesExample1_Input[] = "Now is the time for all ";
 	DWORD DesExample1_CbInput = 24;
 	BYTE DesExample1_Key[8] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
@@ -1187,6 +1288,8 @@ INT __cdecl main(INT argc, CHAR* argv[])
 	printf("\r\n");
 	DesEncryptDecrypt((BYTE*)DesExample1_Input, DesExample1_CbInput, DesExample1_Key, DesExample1_IV, DesExample1_Output, DES_MODE_OFB);
 	printf("\r\n");
+	DesEncryptDecrypt((BYTE*)DesExample1_Input, DesExample1_CbInput, DesExample1_Key, DesExample1_IV, DesExample1_Output, DES_MODE_CTR);
+	printf("\r\n");
 
 	// TDEA ɂÍeXg
 
@@ -1259,5 +1362,130 @@ INT __cdecl main(INT argc, CHAR* argv[])
 	TdeaEncryptDecrypt(TdeaExample3_Input, TdeaExample3_CbInput, TdeaExample3_Key1, TdeaExample3_Key2, TdeaExample3_Key3, TdeaExample3_IV, TdeaExample3_Output, DES_MODE_CTR);
 	printf("\r\n");
 
+	// Example 4
+	// DES, TDEA (ECB, CBC) + PKCS#7 pfBO, CBC-CS1/CS2/CS3
+	// Input = "Now is the time for all " ̐擪 21 oCg ("Now is the time for a")
+	// Key, IV  DES Example 1 y TDEA Example 3 Ɠ
+	// CBC-CS1 ̐擪 8 oCg Cipher Text (CBC) ̐擪 8 oCg (e5c7cdde872bf27c) ƈv
+	DWORD PaddingExample_CbInput = 21;
+	TdeaPaddingEncryptDecrypt((BYTE*)DesExample1_Input, PaddingExample_CbInput, DesExample1_Key, NULL, NULL, DesExample1_IV, DES_PADDING_PKCS7, DES_MODE_ECB);
+	printf("\r\n");
+	TdeaPaddingEncryptDecrypt((BYTE*)DesExample1_Input, PaddingExample_CbInput, DesExample1_Key, NULL, NULL, DesExample1_IV, DES_PADDING_PKCS7, DES_MODE_CBC);
+	printf("\r\n");
+	TdeaPaddingEncryptDecrypt((BYTE*)DesExample1_Input, PaddingExample_CbInput, DesExample1_Key, NULL, NULL, DesExample1_IV, DES_PADDING_CS1, DES_MODE_CBC);
+	printf("\r\n");
+	TdeaPaddingEncryptDecrypt((BYTE*)DesExample1_Input, PaddingExample_CbInput, DesExample1_Key, NULL, NULL, DesExample1_IV, DES_PADDING_CS2, DES_MODE_CBC);
+	printf("\r\n");
+	TdeaPaddingEncryptDecrypt((BYTE*)DesExample1_Input, PaddingExample_CbInput, TdeaExample3_Key1, TdeaExample3_Key2, TdeaExample3_Key3, TdeaExample3_IV, DES_PADDING_PKCS7, DES_MODE_CBC);
+	printf("\r\n");
+	TdeaPaddingEncryptDecrypt((BYTE*)DesExample1_Input, PaddingExample_CbInput, TdeaExample3_Key1, TdeaExample3_Key2, TdeaExample3_Key3, TdeaExample3_IV, DES_PADDING_CS3, DES_MODE_CBC);
+	printf("\r\n");
+
+	// Example 5
+	// 1000 ubN (AVX2 ł 256 ubN ~ 3 + 64 ubN ~ 3 + 40 ubN) ܂Ƃ߂ď
+	// Key, IV  TDEA Example 3 Ɠ
+	TdeaBitslicedCheck(TdeaExample3_Key1, TdeaExample3_Key2, TdeaExample3_Key3, TdeaExample3_IV, 1000);
+	printf("\r\n");
+
+	// Example 6
+	// Keying Option 3 (K1 == K2 == K3) : DES 1 iɏkނ
+	// Input, Key  DES Example 1 ƓŁACipher Text  DES Example 1 (ECB)  3fa40e8a984d4815... ƈv
+	BYTE TdeaExample6_Output[24] = { 0 };
+	TdeaEncryptDecrypt((BYTE*)DesExample1_Input, DesExample1_CbInput, DesExample1_Key, DesExample1_Key, DesExample1_Key, DesExample1_IV, TdeaExample6_Output, DES_MODE_ECB);
+	printf("\r\n");
+
+	// Example 7
+	// DES (CTR) 300001 oCgACӂ̃oCgʒu؂āA܂Xbhŏ
+	// Key, ICV  DES Example 1 Ɠ
+	DesCtrSeekCheck(DesExample1_Key, DesExample1_IV, 300001);
+	printf("\r\n");
+
+	// Example 8
+	// ISO/IEC 9797-1 MAC Algorithm 1 (ANSI X9.9, FIPS 113), Algorithm 3 (ANSI X9.19 e[ MAC), TDEA-CMAC
+	// Input, Key (K)  DES Example 1 ƓAK' = fedcba9876543210
+	// Algorithm 1 (Padding 1) = 70a30640cc76dd8bAAlgorithm 3 (Padding 1) = a1c72e74ea3fa9b6
+	// TDEA-CMAC ̃Tv (SP 800-38B ̗)
+	// https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/TDES_CMAC.pdf
+	// 0 oCg = b7a688e122ffaf95, 8 oCg = 8e8f293136283797, 20 oCg = 743ddbe0ce2dc2ed, 32 oCg = 33e6b1092400eae5
+	BYTE MacExample8_Key2[8] = { 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 };
+	BYTE MacExample8_CmacKey1[8] = { 0x8a, 0xa8, 0x3b, 0xf8, 0xcb, 0xda, 0x10, 0x62 };
+	BYTE MacExample8_CmacKey2[8] = { 0x0b, 0xc1, 0xbf, 0x19, 0xfb, 0xb6, 0xcd, 0x58 };
+	BYTE MacExample8_CmacKey3[8] = { 0xbc, 0x31, 0x3d, 0x4a, 0x37, 0x1c, 0xa8, 0xb5 };
+	BYTE MacExample8_CmacInput[32] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51 };
+	DesMacGenerate((BYTE*)DesExample1_Input, DesExample1_CbInput, DesExample1_Key, NULL, NULL, DES_MAC_ALGORITHM1, DES_MAC_PADDING1);
+	printf("\r\n");
+	DesMacGenerate((BYTE*)DesExample1_Input, DesExample1_CbInput, DesExample1_Key, MacExample8_Key2, NULL, DES_MAC_ALGORITHM3, DES_MAC_PADDING1);
+	printf("\r\n");
+	DesMacGenerate((BYTE*)DesExample1_Input, PaddingExample_CbInput, DesExample1_Key, MacExample8_Key2, NULL, DES_MAC_ALGORITHM3, DES_MAC_PADDING2);
+	printf("\r\n");
+	DesMacGenerate(MacExample8_CmacInput, 0, MacExample8_CmacKey1, MacExample8_CmacKey2, MacExample8_CmacKey3, DES_MAC_CMAC, 0);
+	printf("\r\n");
+	DesMacGenerate(MacExample8_CmacInput, 8, MacExample8_CmacKey1, MacExample8_CmacKey2, MacExample8_CmacKey3, DES_MAC_CMAC, 0);
+	printf("\r\n");
+	DesMacGenerate(MacExample8_CmacInput, 20, MacExample8_CmacKey1, MacExample8_CmacKey2, MacExample8_CmacKey3, DES_MAC_CMAC, 0);
+	printf("\r\n");
+	DesMacGenerate(MacExample8_CmacInput, 32, MacExample8_CmacKey1, MacExample8_CmacKey2, MacExample8_CmacKey3, DES_MAC_CMAC, 0);
+	printf("\r\n");
+	DesMacBatchGenerate(DesExample1_Key, MacExample8_Key2, NULL, DES_MAC_ALGORITHM3, DES_MAC_PADDING1, 1000, 300);
+	printf("\r\n");
+	DesMacBatchGenerate(MacExample8_CmacKey1, MacExample8_CmacKey2, MacExample8_CmacKey3, DES_MAC_CMAC, 0, 1000, 300);
+	printf("\r\n");
+
+	// Example 9
+	// DUKPT (TDES)
+	// Tv (ANSI X9.24-1:2009 Annex A)
+	// BDK = 0123456789abcdeffedcba9876543210, KSN = ffff9876543210e00000
+	// IPEK = 6ac292faa1315b4d858ab3a3d7d5933a
+	// KSN ffff9876543210e00001 : PIN Key = 042666b49184cf5c68de9628d0397b36, Data Key (Request) = 448d3f076d8304036a55a3d7e0055a78
+	BYTE DukptExample9_Bdk[16] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 };
+	BYTE DukptExample9_Ksn[10] = { 0xff, 0xff, 0x98, 0x76, 0x54, 0x32, 0x10, 0xe0, 0x00, 0x00 };
+	DukptGenerate(DukptExample9_Bdk, DukptExample9_Ksn, 1, 3);
+	printf("\r\n");
+	DukptBatchCheck(DukptExample9_Bdk, DukptExample9_Ksn, 40, 2000);
+	printf("\r\n");
+
+	// Example 10
+	// PIN ubN̕ϊ (ISO 9564-1)
+	// PIN = 1234, PAN = 4111111111111111 : PIN Block (ISO 0) = 041234ffffffffff ^ 0000111111111111 = 041225eeeeeeeeee
+	// M̌ TDEA Example 3AM̌ DES Example 1 ̌ (Keying Option 3)
+	PinTranslateGenerate((CHAR*)"1234", (CHAR*)"4111111111111111", TdeaExample3_Key1, TdeaExample3_Key2, TdeaExample3_Key3, DesExample1_Key, DesExample1_Key, DesExample1_Key, 1000);
+	printf("\r\n");
+
+	// Example 11
+	// l (KCV)
+	// DES Example 1 ̌ 0123456789abcdef : E_K(0000000000000000) = d5d44ff720683d0dAKCV = d5d44f
+	// 2-key TDEA (K1 = 0123456789abcdef, K2 = fedcba9876543210)  3-key TDEA (TDEA Example 3 ̌) lɊmF
+	BYTE KcvExample11_Key2[16] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 };
+	BYTE KcvExample11_Key3[24];
+	memcpy(KcvExample11_Key3, TdeaExample3_Key1, 8);
+	memcpy(&KcvExample11_Key3[8], TdeaExample3_Key2, 8);
+	memcpy(&KcvExample11_Key3[16], TdeaExample3_Key3, 8);
+	DesKcvGenerate(DesExample1_Key, 8, 1000);
+	printf("\r\n");
+	DesKcvGenerate(KcvExample11_Key2, 16, 1000);
+	printf("\r\n");
+	DesKcvGenerate(KcvExample11_Key3, 24, 1000);
+	printf("\r\n");
+
+	// Example 12
+	// Cu C C^[tF[X (CiphLib.h)
+	// Input, Key, IV  TDEA Example 3 ƓŁAECB, CBC, CTR  Cipher Text  TDEA Example 3 ƈv
+	TdeaLibraryEncryptDecrypt(TdeaExample3_Input, TdeaExample3_CbInput, KcvExample11_Key3, TdeaExample3_IV);
+	printf("\r\n");
+
+	// Example 13
+	// Xbhv[ (񏈗ɎQXbh̏ 4 Ƃ)
+	// Key, ICV  DES Example 1 Ɠ
+	DesParallelCheck(DesExample1_Key, DesExample1_IV, 4000003, 64, 1000, 4);
+	printf("\r\n");
+
+	// Example 14
+	// s@̑I (1 ubNAݏA񏈗AIB񏈗ɎQXbh̏ 4 Ƃ)
+	//  DES Example 1  Example 11  3-key TDEAAIV, ICV  DES Example 1 Ɠ
+	TdeaDispatchCheck(DesExample1_Key, 8, DesExample1_IV, DesExample1_IV, 262168, 4);
+	printf("\r\n");
+	TdeaDispatchCheck(KcvExample11_Key3, 24, DesExample1_IV, DesExample1_IV, 262168, 4);
+	printf("\r\n");
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,4358 @@
+#include "CiphAes.h"
+#include <stdlib.h>
+#include <string.h>
+
+// AES (Advanced Encryption Standard) ɂÍ
+
+// Ql
+// ADVANCED ENCRYPTION STANDARD (AES)
+// https://csrc.nist.gov/csrc/media/publications/fips/197/final/documents/fips-197.pdf
+
+// Figure 4.  Key-Block-Round Combinations.
+// 
+//           | Key Length | Block Size | Number of Rounds
+//           | (Nk words) | (Nb words) | (Nr)
+// ----------+------------+------------+----------------
+// AES - 128 | 4          | 4          | 10
+// ----------+------------+------------+----------------
+// AES - 192 | 6          | 4          | 12
+// ----------+------------+------------+----------------
+// AES - 256 | 8          | 4          | 14
+// ----------+------------+------------+----------------
+
+// Figure 7. S-box:  substitution values for the byte xy (in hexadecimal format).
+// oCgl11̔`u\
+static const BYTE SBox[256] = {
+	//     0     1     2     3     4     5     6     7     8     9     A     B     C     D     E     F
+		0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+		0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+		0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+		0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+		0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+		0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+		0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+		0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+		0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+		0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+		0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+		0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+		0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+		0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+		0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+		0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+// Figure 14. Inverse S-box: substitution values for the byte xy (in hexadecimal format).
+// oCgl11̔`u\
+// SBox ̋to[W
+static const BYTE InvSBox[256] = {
+	//     0     1     2     3     4     5     6     7     8     9     A     B     C     D     E     F
+		0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+		0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+		0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+		0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+		0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+		0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+		0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+		0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+		0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+		0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+		0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+		0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+		0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+		0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+		0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+		0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
+};
+
+AESBitLength CurrentAESBitLength;
+
+BYTE KeyTable[3] = { 4, 6, 8 };
+BYTE RoundTable[3] = { 10, 12, 14 };
+
+// GFMultiplication ֐
+// ^ꂽɊÂČvZsǍʂԂ
+// ꂼ a, b ƂAʂ c Ƃ
+// ȉ̏ b  0 ɂȂ܂ŌJԂB܂ c ̏l 0 Ƃ
+// 1. b ̍ŉʃrbg 1 ̏ꍇAc = a ^ c Ƃ
+// 2. a ̍ŏʃrbg 1 ̏ꍇAa  1 rbgVtg a = a ^ 0x1b Ƃ
+//    a ̍ŏʃrbg 0 ̏ꍇAa  1 rbgVtg
+// 3. b  1 rbgEVtg
+BYTE WINAPI GFMultiplication(BYTE a, BYTE b)
+{
+	BYTE aTemp, bTemp, c = 0;
+
+	for (aTemp = a, bTemp = b; bTemp != 0; bTemp >>= 1)
+	{
+		if (bTemp & 1)
+		{
+			c ^= aTemp;
+		}
+
+		if (aTemp & 0x80)
+		{
+			aTemp <<= 1;
+			aTemp ^= 0x1b;
+		}
+		else
+		{
+			aTemp <<= 1;
+		}
+	}
+
+	return c;
+}
+
+
+// SubBytes ֐
+// ue[u (SBox) gp State ̊eoCgu
+VOID WINAPI SubBytes(BYTE* State) // 4 * Nb
+{
+	BYTE i;
+	const BYTE Nb = 4;
+
+	for (i = 0; i < 4 * Nb; i++)
+	{
+		State[i] = SBox[State[i]];
+	}
+
+	return;
+}
+
+// InvSubBytes ֐
+// ue[u (InvSBox) gp State ̊eoCgu
+VOID WINAPI InvSubBytes(BYTE* State) // 4 * Nb
+{
+	BYTE i;
+	const BYTE Nb = 4;
+
+	for (i = 0; i < 4 * Nb; i++)
+	{
+		State[i] = InvSBox[State[i]];
+	}
+
+	return;
+}
+
+// ShiftRows ֐
+// State ̍Ō 3 s̃oCgAzIɃVtg
+// ŏ̍s (r = 0) ̓VtgȂ
+//           S                        S'
+// +----+----+----+----+    +----+----+----+----+
+// |s0,0|s0,1|s0,2|s0,3|    |s0,0|s0,1|s0,2|s0,3|
+// +----+----+----+----+    +----+----+----+----+
+// |s1,0|s1,1|s1,2|s1,3|    |s1,1|s1,2|s1,3|s1,0|
+// +----+----+----+----+ => +----+----+----+----+
+// |s2,0|s2,1|s2,2|s2,3|    |s2,2|s2,3|s2,0|s2,1|
+// +----+----+----+----+    +----+----+----+----+
+// |s3,0|s3,1|s3,2|s3,3|    |s3,3|s3,0|s3,1|s3,2|
+// +----+----+----+----+    +----+----+----+----+
+VOID WINAPI ShiftRows(BYTE* State) // 4 * Nb
+{
+	BYTE btTemp;
+	const BYTE Nb = 4;
+
+	btTemp = State[1];
+	State[1] = State[5];
+	State[5] = State[9];
+	State[9] = State[13];
+	State[13] = btTemp;
+
+	btTemp = State[2];
+	State[2] = State[10];
+	State[10] = btTemp;
+	btTemp = State[6];
+	State[6] = State[14];
+	State[14] = btTemp;
+
+	btTemp = State[3];
+	State[3] = State[15];
+	State[15] = State[11];
+	State[11] = State[7];
+	State[7] = btTemp;
+
+	return;
+}
+
+// InvShiftRows ֐
+// State ̍Ō 3 s̃oCgAzIɃVtg
+// ŏ̍s (r = 0) ̓VtgȂ
+//           S                        S'
+// +----+----+----+----+    +----+----+----+----+
+// |s0,0|s0,1|s0,2|s0,3|    |s0,0|s0,1|s0,2|s0,3|
+// +----+----+----+----+    +----+----+----+----+
+// |s1,0|s1,1|s1,2|s1,3|    |s1,3|s1,0|s1,1|s1,2|
+// +----+----+----+----+ => +----+----+----+----+
+// |s2,0|s2,1|s2,2|s2,3|    |s2,2|s2,3|s2,0|s2,1|
+// +----+----+----+----+    +----+----+----+----+
+// |s3,0|s3,1|s3,2|s3,3|    |s3,1|s3,2|s3,3|s3,0|
+// +----+----+----+----+    +----+----+----+----+
+VOID WINAPI InvShiftRows(BYTE* State) // 4 * Nb
+{
+	BYTE btTemp;
+
+	btTemp = State[13];
+	State[13] = State[9];
+	State[9] = State[5];
+	State[5] = State[1];
+	State[1] = btTemp;
+
+	btTemp = State[2];
+	State[2] = State[10];
+	State[10] = btTemp;
+	btTemp = State[6];
+	State[6] = State[14];
+	State[14] = btTemp;
+
+	btTemp = State[3];
+	State[3] = State[7];
+	State[7] = State[11];
+	State[11] = State[15];
+	State[15] = btTemp;
+
+	return;
+}
+
+// MixColumns ֐
+// State 񂲂Ƃɑ삵Ăꂼɏs
+// ̂悤ȍšvZs
+// |S'0,c|   |02 03 01 01| |S0,c|
+// |S'1,c| = |01 02 03 01| |S1,c|
+// |S'2,c|   |01 01 02 03| |S2,c|
+// |S'3,c|   |03 01 01 02| |S3,c|
+VOID WINAPI MixColumns(BYTE* State) // 4 * Nb
+{
+	BYTE i, Temp[4];
+	const BYTE Nb = 4;
+
+	for (i = 0; i < Nb; i++)
+	{
+		Temp[0] = GFMultiplication(0x02, State[i * Nb]) ^ GFMultiplication(0x03, State[i * Nb + 1]) ^ State[i * Nb + 2] ^ State[i * Nb + 3];
+		Temp[1] = State[i * Nb] ^ GFMultiplication(0x02, State[i * Nb + 1]) ^ GFMultiplication(0x03, State[i * Nb + 2]) ^ State[i * Nb + 3];
+		Temp[2] = State[i * Nb] ^ State[i * Nb + 1] ^ GFMultiplication(0x02, State[i * Nb + 2]) ^ GFMultiplication(0x03, State[i * Nb + 3]);
+		Temp[3] = GFMultiplication(0x03, State[i * Nb]) ^ State[i * Nb + 1] ^ State[i * Nb + 2] ^ GFMultiplication(0x02, State[i * Nb + 3]);
+		memcpy(&State[i * Nb], Temp, sizeof(Temp));
+	}
+
+	return;
+}
+
+// InvMixColumns ֐
+// State 񂲂Ƃɑ삵Ăꂼɏs
+// ̂悤ȍšvZs
+// |S'0,c|   |0e 0b 0d 09| |S0,c|
+// |S'1,c| = |09 0e 0b 0d| |S1,c|
+// |S'2,c|   |0d 09 0e 0b| |S2,c|
+// |S'3,c|   |0b 0d 09 0e| |S3,c|
+VOID WINAPI InvMixColumns(BYTE* State) // 4 * Nb
+{
+	BYTE i, Temp[4];
+	const BYTE Nb = 4;
+
+	for (i = 0; i < Nb; i++)
+	{
+		Temp[0] = GFMultiplication(0x0e, State[i * Nb]) ^ GFMultiplication(0x0b, State[i * Nb + 1]) ^ GFMultiplication(0x0d, State[i * Nb + 2]) ^ GFMultiplication(0x09, State[i * Nb + 3]);
+		Temp[1] = GFMultiplication(0x09, State[i * Nb]) ^ GFMultiplication(0x0e, State[i * Nb + 1]) ^ GFMultiplication(0x0b, State[i * Nb + 2]) ^ GFMultiplication(0x0d, State[i * Nb + 3]);
+		Temp[2] = GFMultiplication(0x0d, State[i * Nb]) ^ GFMultiplication(0x09, State[i * Nb + 1]) ^ GFMultiplication(0x0e, State[i * Nb + 2]) ^ GFMultiplication(0x0b, State[i * Nb + 3]);
+		Temp[3] = GFMultiplication(0x0b, State[i * Nb]) ^ GFMultiplication(0x0d, State[i * Nb + 1]) ^ GFMultiplication(0x09, State[i * Nb + 2]) ^ GFMultiplication(0x0e, State[i * Nb + 3]);
+		memcpy(&State[i * Nb], Temp, sizeof(Temp));
+	}
+
+	return;
+}
+
+// Figure 10.  AddRoundKey() XORs each column of the State with a word from the key schedule.
+// AddRoundKey ֐
+// word  round key  state  xor vZ
+VOID WINAPI AddRoundKey(BYTE* State, // 4 * Nb
+	DWORD* W)
+{
+	BYTE i;
+	DWORD* pState = (DWORD*)State;
+	const BYTE Nb = 4;
+
+	for (i = 0; i < Nb; i++) {
+		pState[i] ^= W[i];
+	}
+
+	return;
+}
+
+// RotWord ֐
+// wordE]
+// a3 a2 a1 a0 -> a0 a3 a2 a1
+DWORD RotWord(DWORD word)
+{
+	return word << 24 | word >> 8;
+}
+
+// SubWord ֐
+// 4 oCgl 1 oCgɕꂼ SBox l擾Ǎʂ 4 oCglɂ܂Ƃ߂
+DWORD WINAPI SubWord(DWORD word)
+{
+	DWORD dwSubWord = word;
+	BYTE* pSubWord = (BYTE*)&dwSubWord;
+
+	pSubWord[0] = SBox[pSubWord[0]];
+	pSubWord[1] = SBox[pSubWord[1]];
+	pSubWord[2] = SBox[pSubWord[2]];
+	pSubWord[3] = SBox[pSubWord[3]];
+
+	return dwSubWord;
+}
+
+// i  Nk  Nb * (Nr+1) ܂ő鎞 x^(i-1) mod x^8 + x^4 + x^3 + x + 1 ̌vZʂ擾
+const DWORD RCon[] = {
+  0x00000000, // invalid
+  0x00000001, // x^0
+  0x00000002, // x^1
+  0x00000004, // x^2
+  0x00000008, // x^3
+  0x00000010, // x^4
+  0x00000020, // x^5
+  0x00000040, // x^6
+  0x00000080, // x^7
+  0x0000001B, // x^4 + x^3 + x^1 + x^0
+  0x00000036, // x^5 + x^4 + x^2 + x^1
+};
+
+// Figure 11.  Pseudo Code for Key Expansion.
+// KeyExpansion ֐
+// Í (Key)  Round Key (W) 쐬
+VOID WINAPI KeyExpansion(BYTE* Key, // 4*Nk
+	DWORD* W, // Nb*(Nr+1)
+	BYTE Nk)
+{
+	BYTE i;
+	for (i = 0; i < Nk; i++)
+	{
+		W[i] = Key[4 * i + 3];
+		W[i] <<= 8;
+		W[i] += Key[4 * i + 2];
+		W[i] <<= 8;
+		W[i] += Key[4 * i + 1];
+		W[i] <<= 8;
+		W[i] += Key[4 * i];
+	}
+
+	const BYTE Nb = 4;
+	BYTE Nr = Nk + 6;
+	DWORD temp;
+
+	for (i = Nk; i < Nb * (Nr + 1); i++)
+	{
+		temp = W[i - 1];
+
+		if (i % Nk == 0)
+		{
+			temp = SubWord(RotWord(temp)) ^ RCon[i / Nk];
+		}
+		else if (Nk > 6 && i % Nk == 4)
+		{
+			temp = SubWord(temp);
+		}
+
+		W[i] = W[i - Nk] ^ temp;
+	}
+
+	return;
+}
+
+// Figure 5.  Pseudo Code for the Cipher.
+// CipherRounds ֐
+// Eh Nr w肵 AES Ís
+VOID WINAPI CipherRounds(BYTE* in, BYTE* out, DWORD* W, BYTE Nr)
+{
+	BYTE i, state[16]; // state[4,Nb] 
+	const BYTE Nb = 4;
+
+	memcpy(state, in, 4 * Nb);
+
+	AddRoundKey(state, &W[0]);
+	for (i = 1; i < Nr; i++) {
+		SubBytes(state);
+		ShiftRows(state);
+		MixColumns(state);
+		AddRoundKey(state, &W[Nb * i]);
+	}
+	SubBytes(state);
+	ShiftRows(state);
+	AddRoundKey(state, &W[Nb * Nr]);
+
+	memcpy(out, state, 16);
+
+	return;
+}
+
+// Cipher ֐
+// AES Ís
+VOID WINAPI Cipher(BYTE* in, BYTE* out, DWORD* W)
+{
+	CipherRounds(in, out, W, RoundTable[CurrentAESBitLength]);
+
+	return;
+}
+
+// Figure 12.  Pseudo Code for the Inverse Cipher.
+// InvCipherRounds ֐
+// Eh Nr w肵 AES s
+VOID WINAPI InvCipherRounds(BYTE* in, BYTE* out, DWORD* W, BYTE Nr)
+{
+	BYTE i, state[16]; // state[4,Nb] 
+	const BYTE Nb = 4;
+
+	memcpy(state, in, 16);
+
+	AddRoundKey(state, &W[Nb * Nr]);
+	for (i = Nr - 1; 1 <= i; i--) {
+		InvShiftRows(state);
+		InvSubBytes(state);
+		AddRoundKey(state, &W[Nb * i]);
+		InvMixColumns(state);
+	}
+	InvShiftRows(state);
+	InvSubBytes(state);
+	AddRoundKey(state, &W[0]);
+
+	memcpy(out, state, 16);
+
+	return;
+}
+
+// InvCipher ֐
+// AES s
+VOID WINAPI InvCipher(BYTE* in, BYTE* out, DWORD* W)
+{
+	InvCipherRounds(in, out, W, RoundTable[CurrentAESBitLength]);
+
+	return;
+}
+
+// AesKeySetup ֐
+// Í (Key) 献ReLXg쐬
+// p̃Eh DW  FIPS 197 5.3.5 ̓tÍɏ]AW tɕׂ InvMixColumns Kp
+// (AES-NI  AESDEC ߂͂̌`̃EhOƂ)
+VOID WINAPI AesKeySetup(BYTE* Key, AESBitLength BitLength, AES_KEY_CONTEXT* pContext)
+{
+	BYTE i, Nr;
+
+	pContext->Nk = KeyTable[BitLength];
+	pContext->Nr = Nr = RoundTable[BitLength];
+	KeyExpansion(Key, pContext->W, pContext->Nk);
+
+	memcpy(&pContext->DW[0], &pContext->W[4 * Nr], 16);
+	for (i = 1; i < Nr; i++)
+	{
+		memcpy(&pContext->DW[4 * i], &pContext->W[4 * (Nr - i)], 16);
+		InvMixColumns((BYTE*)&pContext->DW[4 * i]);
+	}
+	memcpy(&pContext->DW[4 * Nr], &pContext->W[0], 16);
+
+	return;
+}
+
+// AesEncryptKeySetup ֐
+// Í (AesEncryptBlocks) ɂ̂ݎgReLXg쐬
+// ̓ô悤Ɍ 1, 2 ubN̈ÍɂgȂꍇɁAp̃Eh DW ̌vZȂ
+VOID WINAPI AesEncryptKeySetup(BYTE* Key, AESBitLength BitLength, AES_KEY_CONTEXT* pContext)
+{
+	pContext->Nk = KeyTable[BitLength];
+	pContext->Nr = RoundTable[BitLength];
+	KeyExpansion(Key, pContext->W, pContext->Nk);
+
+	return;
+}
+
+// AesEncryptBlocks ֐
+// ReLXgp nBlocks ̓ƗubN (ECB, CTR ̃L[Xg[) Í
+// AES-NI gp\ȏꍇ͕ubNsďAłȂꍇ CipherRounds JԂ
+VOID WINAPI AesEncryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, DWORD nBlocks)
+{
+	DWORD i;
+
+#if defined(CIPH_X86)
+	if (GetCpuFeatures() & CPU_FEATURE_AESNI)
+	{
+		AesNiEncryptBlocks(pContext, in, out, nBlocks);
+		return;
+	}
+#endif
+
+	for (i = 0; i < nBlocks; i++)
+	{
+		CipherRounds(&in[16 * i], &out[16 * i], pContext->W, pContext->Nr);
+	}
+
+	return;
+}
+
+// AesDecryptBlocks ֐
+// ReLXgp nBlocks ̓ƗubN𕡍
+// AES-NI gp\ȏꍇ͕ubNsďAłȂꍇ InvCipherRounds JԂ
+VOID WINAPI AesDecryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, DWORD nBlocks)
+{
+	DWORD i;
+
+#if defined(CIPH_X86)
+	if (GetCpuFeatures() & CPU_FEATURE_AESNI)
+	{
+		AesNiDecryptBlocks(pContext, in, out, nBlocks);
+		return;
+	}
+#endif
+
+	for (i = 0; i < nBlocks; i++)
+	{
+		InvCipherRounds(&in[16 * i], &out[16 * i], pContext->W, pContext->Nr);
+	}
+
+	return;
+}
+
+// AesEcbEncrypt ֐
+// EBC p AES ɂÍAs
+//              Plane Text 1                     Plane Text 2                     Plane Text N
+//                   |                                |                                |
+//                   |                                |                                |
+//                   v                                v                                v
+//       +-----------+-----------+        +-----------+-----------+        +-----------+-----------+
+// Key ->|block cipher encryption|  Key ->|block cipher encryption|  Key ->|block cipher encryption|
+//       +-----------+-----------+        +-----------+-----------+        +-----------+-----------+ 
+//                   |                                |                                |
+//                   |                                |                                |
+//                   v                                v                                v
+//              Cipher Text 1                    Cipher Text 2                   Cipher Text N
+VOID WINAPI AesEcbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out)
+{
+	DWORD i, W[60];
+
+	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+
+	// AES Í
+	Cipher(in, out, W);
+	for (i = 16; i < cbIn; i += 16)
+	{
+		Cipher(&in[i], &out[i], W);
+	}
+
+	return;
+}
+
+// AesEcbDecrypt ֐
+// ECB p Aes ɂ镡s
+//              Cipher Text 1                    Cipher Text 2                   Cipher Text N
+//                   |                                |                                |
+//                   |                                |                                |
+//                   v                                v                                v
+//       +-----------+-----------+        +-----------+-----------+        +-----------+-----------+
+// Key ->|block cipher decryption|  Key ->|block cipher decryption|  Key ->|block cipher decryption|
+//       +-----------+-----------+        +-----------+-----------+        +-----------+-----------+ 
+//                   |                                |                                |
+//                   |                                |                                |
+//                   v                                v                                v
+//              Plane Text 1                    Plane Text 2                     Plane Text N
+VOID WINAPI AesEcbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out)
+{
+	DWORD i, W[60];
+
+	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+
+	// AES 
+	InvCipher(in, out, W);
+	for (i = 16; i < cbIn; i += 16)
+	{
+		InvCipher(&in[i], &out[i], W);
+	}
+
+	return;
+}
+
+// AesCbcEncrypt ֐
+// CBC p AES ɂÍs
+//               Plane Text 1                      Plane Text 2                          Plane Text N
+//                   |                                 |                                      |
+// IV --------------xor            +------------------xor                 +------------------xor
+//                   |             |                   |                  |                   |
+//                   v             |                   v                  |                   v
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
+// Key ->|block cipher encryption| | Key ->|block cipher encryption|      | Key ->|block cipher encryption|
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
+//                   |             |                   |                  |                   |
+//                   +-------------+                   +---------- ...  --+                   |
+//                   |                                 |                                      |
+//                   v                                 v                                      v
+//              Cipher Text 1                     Cipher Text 2                         Cipher Text N
+VOID WINAPI AesCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out)
+{
+	DWORD i, W[60];
+	BYTE inTemp[16], outTemp[16];
+
+	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+
+	// AES-CBC ɂÍ
+	Xor(in, IV, 16, inTemp);
+	Cipher(inTemp, outTemp, W);
+	memcpy(out, outTemp, 16);
+	for (i = 16; i < cbIn; i += 16)
+	{
+		Xor(&in[i], outTemp, 16, inTemp);
+		Cipher(inTemp, outTemp, W);
+		memcpy(&out[i], outTemp, 16);
+	}
+
+	return;
+}
+
+// AesCbcDecrypt ֐
+// CBC p Aes ɂ镡s
+//              Cipher Text 1                     Cipher Text 2                         Cipher Text N
+//                   |                                 |                                      |
+//                   +-------------+                   +---------- ...  --+                   |
+//                   |             |                   |                  |                   |
+//                   v             |                   v                  |                   v
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
+// Key ->|block cipher decryption| | Key ->|block cipher decryption|      | Key ->|block cipher decryption|
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
+//                   |             |                   |                  |                   |
+// IV --------------xor            +------------------xor                 +------------------xor
+//                   |                                 |                                      |
+//                   v                                 v                                      v
+//              Plane Text 1                      Plane Text 2                          Plane Text N
+VOID WINAPI AesCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out)
+{
+	DWORD i, W[60];
+	BYTE inTemp[16], outTemp[16];
+
+	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+
+	// AES-CBC ɂ镡
+	InvCipher(in, inTemp, W);
+	Xor(inTemp, IV, 16, outTemp);
+	memcpy(out, outTemp, 16);
+	for (i = 16; i < cbIn; i += 16)
+	{
+		InvCipher(&in[i], inTemp, W);
+		Xor(&in[i - 16], inTemp, 16, outTemp);
+		memcpy(&out[i], outTemp, 16);
+	}
+
+	return;
+}
+
+// AesGetOutputLength ֐
+// pfBOɉÍ̃oCgԂ
+// PKCS#7 ͕K 1 ` 16 oCg̃pfBOt邽߁A 16 ̔{ɐ؂グ
+// Íގ (CS1, CS2, CS3) ͕ƓoCg̈Ío͂
+DWORD WINAPI AesGetOutputLength(DWORD cbIn, DWORD dwPadding)
+{
+	if (dwPadding == AES_PADDING_PKCS7)
+	{
+		return (cbIn / 16 + 1) * 16;
+	}
+
+	return cbIn;
+}
+
+// AesEcbEncryptPkcs7Context ֐
+// PKCS#7 pfBOt ECB p AES ɂÍs
+// out ɂ AesGetOutputLength(cbIn, AES_PADDING_PKCS7) oCg̗̈悪Kv
+VOID WINAPI AesEcbEncryptPkcs7Context(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out)
+{
+	DWORD cbFull = cbIn & ~15UL;
+	BYTE Temp[16];
+
+	// SȃubN͓̓f[^璼ځA܂Ƃ߂ĈÍ
+	AesEncryptBlocks(pContext, in, out, cbFull / 16);
+
+	// Ō̃ubN̂݃pfBOtĈÍ
+	Pkcs7PadBlock(&in[cbFull], cbIn - cbFull, 16, Temp);
+	AesEncryptBlocks(pContext, Temp, &out[cbFull], 1);
+
+	return;
+}
+
+// AesEcbDecryptPkcs7Context ֐
+// ECB p AES ɂ镡sAPKCS#7 pfBO菜
+// f[^̃oCg pcbOut Ɋi[BpfBOsȏꍇ FALSE Ԃ
+BOOL WINAPI AesEcbDecryptPkcs7Context(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out, DWORD* pcbOut)
+{
+	DWORD cbLast;
+	BYTE Temp[16];
+
+	if (cbIn == 0 || cbIn % 16 != 0)
+	{
+		return FALSE;
+	}
+
+	AesDecryptBlocks(pContext, in, out, cbIn / 16 - 1);
+
+	// Ō̃ubN̓X^bNŕAf[^݂̂o͂
+	AesDecryptBlocks(pContext, &in[cbIn - 16], Temp, 1);
+	if (!Pkcs7UnpadBlock(Temp, 16, &cbLast))
+	{
+		return FALSE;
+	}
+	memcpy(&out[cbIn - 16], Temp, cbLast);
+	*pcbOut = cbIn - 16 + cbLast;
+
+	return TRUE;
+}
+
+// AesCbcEncryptPkcs7Context ֐
+// PKCS#7 pfBOt CBC p AES ɂÍs
+// out ɂ AesGetOutputLength(cbIn, AES_PADDING_PKCS7) oCg̗̈悪Kv
+VOID WINAPI AesCbcEncryptPkcs7Context(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	DWORD i, cbFull = cbIn & ~15UL;
+	BYTE inTemp[16], outTemp[16];
+
+	memcpy(outTemp, IV, 16);
+	for (i = 0; i < cbFull; i += 16)
+	{
+		Xor(&in[i], outTemp, 16, inTemp);
+		AesEncryptBlocks(pContext, inTemp, outTemp, 1);
+		memcpy(&out[i], outTemp, 16);
+	}
+
+	Pkcs7PadBlock(&in[cbFull], cbIn - cbFull, 16, inTemp);
+	Xor(inTemp, outTemp, 16, inTemp);
+	AesEncryptBlocks(pContext, inTemp, &out[cbFull], 1);
+
+	return;
+}
+
+// AesCbcDecryptPkcs7Context ֐
+// CBC p AES ɂ镡sAPKCS#7 pfBO菜
+// f[^̃oCg pcbOut Ɋi[BpfBOsȏꍇ FALSE Ԃ
+BOOL WINAPI AesCbcDecryptPkcs7Context(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out, DWORD* pcbOut)
+{
+	DWORD i, cbLast;
+	BYTE inTemp[16], outTemp[16];
+
+	if (cbIn == 0 || cbIn % 16 != 0)
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i < cbIn; i += 16)
+	{
+		AesDecryptBlocks(pContext, &in[i], inTemp, 1);
+		Xor(inTemp, i == 0 ? IV : &in[i - 16], 16, outTemp);
+		if (i + 16 < cbIn)
+		{
+			memcpy(&out[i], outTemp, 16);
+		}
+	}
+
+	if (!Pkcs7UnpadBlock(outTemp, 16, &cbLast))
+	{
+		return FALSE;
+	}
+	memcpy(&out[cbIn - 16], outTemp, cbLast);
+	*pcbOut = cbIn - 16 + cbLast;
+
+	return TRUE;
+}
+
+// AesCbcEncryptCtsContext ֐
+// Íގ (Ciphertext Stealing) p AES-CBC ɂÍs
+// NIST SP 800-38A Addendum  CBC-CS1, CBC-CS2, CBC-CS3 ɑΉAÍ͕ƓoCgɂȂ
+//  P1, P2, ..., Pn-1, Pn* (Pn*  d oCg, 1 <= d <= 16) Ƃ
+// 1. Pn* ̌ 0 t Pn ܂߂Ēʏ CBC  C1 ` Cn ߂
+// 2. Cn-1 ̐擪 d oCg Cn-1' ƂAc 16 - d oCg͏o͂Ȃ (Cn ̕ŕł)
+// 3. o͈͂̏ȉ̒ʂ
+//    CS1 : C1 || ... || Cn-2 || Cn-1' || Cn
+//    CS2 : d = 16 ̏ꍇ CS1 ƓAȊO CS3 Ɠ
+//    CS3 : C1 || ... || Cn-2 || Cn || Cn-1'
+// ̓f[^ 16 oCgȏłKv
+BOOL WINAPI AesCbcEncryptCtsContext(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	DWORD i, cbTail, cbHead;
+	BYTE inTemp[16], outTemp[16], Last[16];
+
+	if (cbIn < 16 || dwPadding < AES_PADDING_CS1 || dwPadding > AES_PADDING_CS3)
+	{
+		return FALSE;
+	}
+
+	// Pn* ̃oCg (d)  P1 ` Pn-1 ̃oCg
+	cbTail = cbIn % 16 != 0 ? cbIn % 16 : 16;
+	cbHead = cbIn - cbTail;
+
+	// 1 ubN݂̂̏ꍇ͒ʏ CBC Ɠ
+	if (cbHead == 0)
+	{
+		Xor(in, IV, 16, inTemp);
+		AesEncryptBlocks(pContext, inTemp, out, 1);
+		return TRUE;
+	}
+
+	// C1 ` Cn-2 ͒ʏ CBC Œڏo͂ACn-1  outTemp Ɏc
+	memcpy(outTemp, IV, 16);
+	for (i = 0; i < cbHead; i += 16)
+	{
+		Xor(&in[i], outTemp, 16, inTemp);
+		AesEncryptBlocks(pContext, inTemp, outTemp, 1);
+		if (i + 16 < cbHead)
+		{
+			memcpy(&out[i], outTemp, 16);
+		}
+	}
+
+	// Pn* ̌ 0 t Cn ߂
+	ZeroMemory(inTemp, 16);
+	memcpy(inTemp, &in[cbHead], cbTail);
+	Xor(inTemp, outTemp, 16, inTemp);
+	AesEncryptBlocks(pContext, inTemp, Last, 1);
+
+	if (dwPadding == AES_PADDING_CS1 || (dwPadding == AES_PADDING_CS2 && cbTail == 16))
+	{
+		memcpy(&out[cbHead - 16], outTemp, cbTail);
+		memcpy(&out[cbHead - 16 + cbTail], Last, 16);
+	}
+	else
+	{
+		memcpy(&out[cbHead - 16], Last, 16);
+		memcpy(&out[cbHead], outTemp, cbTail);
+	}
+
+	return TRUE;
+}
+
+// AesCbcDecryptCtsContext ֐
+// Íގ (Ciphertext Stealing) p AES-CBC ɂ镡s
+// Cn 𕡍ʂ̌ 16 - d oCgAo͂Ȃ Cn-1 ̎c̕ƂȂ
+BOOL WINAPI AesCbcDecryptCtsContext(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	DWORD i, cbTail, cbHead;
+	BYTE inTemp[16], Prev[16], * pPrev, * pLast;
+
+	if (cbIn < 16 || dwPadding < AES_PADDING_CS1 || dwPadding > AES_PADDING_CS3)
+	{
+		return FALSE;
+	}
+
+	cbTail = cbIn % 16 != 0 ? cbIn % 16 : 16;
+	cbHead = cbIn - cbTail;
+
+	if (cbHead == 0)
+	{
+		AesDecryptBlocks(pContext, in, inTemp, 1);
+		Xor(inTemp, IV, 16, out);
+		return TRUE;
+	}
+
+	// C1 ` Cn-2 ͒ʏ CBC ŕ
+	for (i = 0; i + 16 < cbHead; i += 16)
+	{
+		AesDecryptBlocks(pContext, &in[i], inTemp, 1);
+		Xor(inTemp, i == 0 ? IV : &in[i - 16], 16, &out[i]);
+	}
+
+	// Cn-1'  Cn ̈ʒu߂
+	if (dwPadding == AES_PADDING_CS1 || (dwPadding == AES_PADDING_CS2 && cbTail == 16))
+	{
+		pPrev = &in[cbHead - 16];
+		pLast = &in[cbHead - 16 + cbTail];
+	}
+	else
+	{
+		pLast = &in[cbHead - 16];
+		pPrev = &in[cbHead];
+	}
+
+	// Cn 𕡍ACn-1' ƌʂ̌ 16 - d oCg Cn-1 𕜌
+	AesDecryptBlocks(pContext, pLast, inTemp, 1);
+	memcpy(Prev, pPrev, cbTail);
+	memcpy(&Prev[cbTail], &inTemp[cbTail], 16 - cbTail);
+	Xor(inTemp, Prev, cbTail, &out[cbHead]);
+
+	// Cn-1 𕡍 Pn-1 ߂
+	AesDecryptBlocks(pContext, Prev, inTemp, 1);
+	Xor(inTemp, cbHead == 16 ? IV : &in[cbHead - 32], 16, &out[cbHead - 16]);
+
+	return TRUE;
+}
+
+VOID WINAPI AesEcbEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out)
+{
+	AES_KEY_CONTEXT Context;
+
+	AesKeySetup(Key, CurrentAESBitLength, &Context);
+	AesEcbEncryptPkcs7Context(&Context, in, cbIn, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+BOOL WINAPI AesEcbDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out, DWORD* pcbOut)
+{
+	AES_KEY_CONTEXT Context;
+	BOOL bResult;
+
+	AesKeySetup(Key, CurrentAESBitLength, &Context);
+	bResult = AesEcbDecryptPkcs7Context(&Context, in, cbIn, out, pcbOut);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return bResult;
+}
+
+VOID WINAPI AesCbcEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out)
+{
+	AES_KEY_CONTEXT Context;
+
+	AesKeySetup(Key, CurrentAESBitLength, &Context);
+	AesCbcEncryptPkcs7Context(&Context, in, cbIn, IV, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+BOOL WINAPI AesCbcDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out, DWORD* pcbOut)
+{
+	AES_KEY_CONTEXT Context;
+	BOOL bResult;
+
+	AesKeySetup(Key, CurrentAESBitLength, &Context);
+	bResult = AesCbcDecryptPkcs7Context(&Context, in, cbIn, IV, out, pcbOut);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return bResult;
+}
+
+BOOL WINAPI AesCbcEncryptCts(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, DWORD dwPadding, BYTE* out)
+{
+	AES_KEY_CONTEXT Context;
+	BOOL bResult;
+
+	AesKeySetup(Key, CurrentAESBitLength, &Context);
+	bResult = AesCbcEncryptCtsContext(&Context, in, cbIn, IV, dwPadding, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return bResult;
+}
+
+BOOL WINAPI AesCbcDecryptCts(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, DWORD dwPadding, BYTE* out)
+{
+	AES_KEY_CONTEXT Context;
+	BOOL bResult;
+
+	AesKeySetup(Key, CurrentAESBitLength, &Context);
+	bResult = AesCbcDecryptCtsContext(&Context, in, cbIn, IV, dwPadding, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return bResult;
+}
+
+// AesCfbEncrypt ֐
+// CFB p AES ɂÍs
+// IV ---------------+------------>+-------------------+---------- ... -->+-------------------+ 
+//                   |             |                   |                  |                   |
+//                   |             |        (block - segment bits)        |        (block - segment bits)
+//                   v             |                   v                  |                   v
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
+//       |Input Block 1          | |       |Input Block 2          |      |       |Input Block N          |
+//       |(128 bits)             | |       |(128 - s bits)|(s bits)|      |       |(128 - s bits)|(s bits)|
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
+// Key ->|block cipher encryption| | Key ->|block cipher encryption|      | Key ->|block cipher encryption|
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
+//                   |             |                   |                  |                   |
+// Plane Text 1 ----xor            |  Plane Text 2 ---xor                 |   Plane Text N --xor
+//   (Segment Bits)  |             |   (Segment Bits)  |                  |   (Segment Bits)  |
+//                   |             |                   |                  |                   |
+//                   +-------------+                   +---------- ...  --+                   |
+//                   |                                 |                                      |
+//                   v                                 v                                      v
+//         Cipher Text 1 (s bits)            Cipher Text 2 (s bits)                 Cipher Text N (s bits)
+VOID WINAPI AesCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE cbitSegment, BYTE* out)
+{
+	DWORD i, cbSegment, cbRemain, W[60];
+	BYTE inTemp[16], MsgTemp[16], outTemp[16], * pInCurrent, temp, sbits, bitsCurrent, bitOr;
+
+	// Segment Bits  IV (16 oCg) 𒴂ĂꍇA 0 ̏ꍇI
+	if (cbitSegment > 128 || cbitSegment == 0)
+	{
+		return;
+	}
+
+	// ̓f[^TCY Segment Bits ̔{ŖꍇI
+	if ((cbIn * 8) % cbitSegment != 0)
+	{
+		return;
+	}
+
+	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+
+	if (cbitSegment % 8 == 0) // Segment Bits  8 ̔{ (oCg) łꍇ
+	{
+		cbSegment = cbitSegment / 8;
+
+		// AES-CFB ɂÍ
+		Cipher(IV, inTemp, W);
+		Xor(in, inTemp, cbSegment, outTemp); // Segment Bits  xor
+		memcpy(out, outTemp, cbSegment);// ʂo͗pobt@ɃRs[
+
+		// ZOg IV VtgAZOg}ē̓f[^쐬
+		if (cbSegment != 16)
+		{
+			memcpy(inTemp, &IV[cbSegment], 16 - cbSegment);
+			memcpy(&inTemp[16 - cbSegment], outTemp, cbSegment);
+		}
+		else
+		{
+			memcpy(inTemp, outTemp, cbSegment);
+		}
+
+		for (cbRemain = cbIn - cbSegment, pInCurrent = &in[cbSegment]; cbRemain > 0; cbRemain -= cbSegment, pInCurrent += cbSegment)
+		{
+			Cipher(inTemp, MsgTemp, W); // Ǒʂ쐬̓f[^ AES Í
+			Xor(pInCurrent, MsgTemp, cbSegment, outTemp); // ʂƕ XOR
+			memcpy(&out[cbIn - cbRemain], outTemp, cbSegment); // ʂo͗pobt@ɃRs[
+
+			// ZOg̓f[^VtgAZOg}ē̓f[^쐬
+			if (cbSegment != 16)
+			{
+				memcpy(inTemp, &inTemp[cbSegment], 16 - cbSegment);
+				memcpy(&inTemp[16 - cbSegment], outTemp, cbSegment);
+			}
+			else
+			{
+				memcpy(inTemp, outTemp, cbSegment);
+			}
+		}
+	}
+	else if (8 % cbitSegment == 0) // Segment Bits  1, 2, 4 ̏ꍇ
+	{
+		// AES-CFB ɂÍ
+		Cipher(IV, outTemp, W);
+		sbits = (in[0] ^ outTemp[0]) >> (8 - cbitSegment); // Segment Bits  xor
+
+		bitOr = 1;
+		for (i = 1; i < cbitSegment; i++)
+		{
+			bitOr <<= 1;
+			bitOr++;
+		}
+
+		// ZOg̓f[^VtgAZOg}ē̓f[^쐬
+		for (i = 0; i < 15; i++)
+		{
+			inTemp[i] = IV[i] << cbitSegment;
+			inTemp[i] |= IV[i + 1] >> (8 - cbitSegment);
+		}
+		inTemp[15] = IV[15] << cbitSegment;
+		inTemp[15] |= sbits;
+
+		bitsCurrent = cbitSegment;
+		temp = sbits;
+		for (cbRemain = cbIn; cbRemain > 0; cbRemain--)
+		{
+			while (bitsCurrent < 8)
+			{
+				Cipher(inTemp, outTemp, W);
+
+				sbits = (((in[cbIn - cbRemain] << bitsCurrent) ^ outTemp[0]) >> (8 - cbitSegment)) & bitOr; // Segment Bits  xor
+				temp <<= cbitSegment;
+				temp |= sbits;
+				bitsCurrent += cbitSegment;
+
+				// ZOg̓f[^VtgAZOg}ē̓f[^쐬
+				for (i = 0; i < 15; i++)
+				{
+					inTemp[i] = inTemp[i] << cbitSegment;
+					inTemp[i] |= inTemp[i + 1] >> (8 - cbitSegment);
+				}
+				inTemp[15] = inTemp[15] << cbitSegment;
+				inTemp[15] |= sbits;
+			}
+			out[cbIn - cbRemain] = temp;
+			temp = 0;
+			bitsCurrent = 0;
+		}
+	}
+
+	return;
+}
+
+// AesCfbDecrypt ֐
+// CFB p Aes ɂ镡s
+// IV ---------------+------------>+-------------------+------------->+--- ... -----------+ 
+//                   |             |                   |              |                   |
+//                   |             |        (block - segment bits)    |        (block - segment bits)
+//                   v             |                   v              |                   v
+//       +-----------+-----------+ |       +-----------+-----------+  |       +-----------+-----------+
+//       |Input Block 1          | |       |Input Block 2          |  |       |Input Block N          |
+//       |(128 bits)             | |       |(128 - s bits)|(s bits)|  |       |(128 - s bits)|(s bits)|
+//       +-----------+-----------+ |       +-----------+-----------+  |       +-----------+-----------+
+// Key ->|block cipher encryption| | Key ->|block cipher encryption|  | Key ->|block cipher encryption|
+//       +-----------+-----------+ |       +-----------+-----------+  |       +-----------+-----------+ 
+//                   |             |                   |              |                   |
+//                   |             |                   |              |                   |
+//                   |             |                   |              |                   |
+//                  xor------ Cipher Text 1           xor----- Cipher Text 2             xor----- Cipher Text N
+//                   |                                 |                                  |
+//                   v                                 v                                  v
+//              Plane Text 1                      Plane Text 2                       Plane Text N
+VOID WINAPI AesCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE cbitSegment, BYTE* out)
+{
+	DWORD i, cbSegment, cbRemain, W[60];
+	BYTE inTemp[16], MsgTemp[16], outTemp[16], * pInCurrent, temp, sbits, bitsCurrent, bitOr;
+
+	// Segment Bits  IV (16 oCg) 𒴂ĂꍇA 0 ̏ꍇI
+	if (cbitSegment > 128 || cbitSegment == 0)
+	{
+		return;
+	}
+
+	// ̓f[^TCY Segment Bits ̔{ŖꍇI
+	if ((cbIn * 8) % cbitSegment != 0)
+	{
+		return;
+	}
+
+	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+
+	if (cbitSegment % 8 == 0) // Segment Bits  8 ̔{ (oCg) łꍇ
+	{
+		cbSegment = cbitSegment / 8;
+
+		// AES-CFB ɂ镡
+		Cipher(IV, inTemp, W); // IV  AES Í
+		Xor(in, inTemp, cbSegment, outTemp); // Segment Bits  xor
+		memcpy(out, outTemp, cbSegment);// ʂo͗pobt@ɃRs[
+
+		// ZOg IV VtgAZOg}ē̓f[^쐬
+		if (cbSegment != 16)
+		{
+			memcpy(inTemp, &IV[cbSegment], 16 - cbSegment);
+			memcpy(&inTemp[16 - cbSegment], in, cbSegment);
+		}
+		else
+		{
+			memcpy(inTemp, in, cbSegment);
+		}
+
+		for (cbRemain = cbIn - cbSegment, pInCurrent = &in[cbSegment]; cbRemain > 0; cbRemain -= cbSegment, pInCurrent += cbSegment)
+		{
+			Cipher(inTemp, MsgTemp, W); // Ǒʂ쐬̓f[^ AES Í
+			Xor(pInCurrent, MsgTemp, cbSegment, outTemp); // ʂƕ XOR
+			memcpy(&out[cbIn - cbRemain], outTemp, cbSegment); // ʂo͗pobt@ɃRs[
+
+			// ZOg̓f[^VtgAZOg}ē̓f[^쐬
+			if (cbSegment != 16)
+			{
+				memcpy(inTemp, &inTemp[cbSegment], 16 - cbSegment);
+				memcpy(&inTemp[16 - cbSegment], pInCurrent, cbSegment);
+			}
+			else
+			{
+				memcpy(inTemp, pInCurrent, cbSegment);
+			}
+		}
+	}
+	else if (8 % cbitSegment == 0) // Segment Bits  1, 2, 4 ̏ꍇ
+	{
+		// AES-CFB ɂÍ
+		Cipher(IV, outTemp, W);
+		sbits = in[0] >> (8 - cbitSegment);
+
+		bitOr = 1;
+		for (i = 1; i < cbitSegment; i++)
+		{
+			bitOr <<= 1;
+			bitOr++;
+		}
+
+		// ZOg̓f[^VtgAZOg}ē̓f[^쐬
+		for (i = 0; i < 15; i++)
+		{
+			inTemp[i] = IV[i] << cbitSegment;
+			inTemp[i] |= IV[i + 1] >> (8 - cbitSegment);
+		}
+		inTemp[15] = IV[15] << cbitSegment;
+		inTemp[15] |= sbits;
+
+		bitsCurrent = cbitSegment;
+		temp = sbits ^ (outTemp[0] >> (8 - cbitSegment)); // Segment Bits  xor
+		for (cbRemain = cbIn; cbRemain > 0; cbRemain--)
+		{
+			while (bitsCurrent < 8)
+			{
+				Cipher(inTemp, outTemp, W);
+
+				sbits = (in[cbIn - cbRemain] >> (8 - cbitSegment - bitsCurrent)) & bitOr;
+				temp <<= cbitSegment;
+				temp |= sbits ^ (outTemp[0] >> (8 - cbitSegment)); // Segment Bits  xor
+				bitsCurrent += cbitSegment;
+
+				// ZOg̓f[^VtgAZOg}ē̓f[^쐬
+				for (i = 0; i < 15; i++)
+				{
+					inTemp[i] = inTemp[i] << cbitSegment;
+					inTemp[i] |= inTemp[i + 1] >> (8 - cbitSegment);
+				}
+				inTemp[15] = inTemp[15] << cbitSegment;
+				inTemp[15] |= sbits;
+			}
+			out[cbIn - cbRemain] = temp;
+			temp = 0;
+			bitsCurrent = 0;
+		}
+	}
+
+	return;
+}
+
+// AesOfbEncryptDecrypt ֐
+// OFB p AES ɂÍEs
+// EÍ
+//                  IV
+//                   |             +-------------------+                  +-------------------+
+//                   |             |                   |                  |                   |
+//                   v             |                   v                  |                   v
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
+// Key ->|block cipher encryption| | Key ->|block cipher encryption|      | Key ->|block cipher encryption|
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
+//                   |             |                   |                  |                   |
+//                   +-------------+                   +---------- ...  --+                   |
+//                   |                                 |                                      |
+// Plane Text 1 ----xor              Plane Text 1 ----xor                   Plane Text 1 ----xor
+//                   |                                 |                                      |
+//                   v                                 v                                      v
+//              Cipher Text 1                     Cipher Text 2                         Cipher Text N
+// 
+// E
+//                  IV
+//                   |             +-------------------+                  +-------------------+
+//                   |             |                   |                  |                   |
+//                   v             |                   v                  |                   v
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+
+// Key ->|block cipher encryption| | Key ->|block cipher encryption|      | Key ->|block cipher encryption|
+//       +-----------+-----------+ |       +-----------+-----------+      |       +-----------+-----------+ 
+//                   |             |                   |                  |                   |
+//                   +-------------+                   +---------- ...  --+                   |
+//                   |                                 |                                      |
+// Cipher Text 1 ---xor              Cipher Text 1 ---xor                   Cipher Text 1 ---xor
+//                   |                                 |                                      |
+//                   v                                 v                                      v
+//              Plane Text 1                      Plane Text 2                       Plane Text N
+VOID WINAPI AesOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out)
+{
+	DWORD i, W[60];
+	BYTE Temp1[16], Temp2[16];
+
+	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+
+	// AES-OFB ɂÍ
+	Cipher(IV, Temp1, W);
+	Xor(in, Temp1, 16, Temp2);
+	memcpy(out, Temp2, 16);
+	for (i = 16; i < cbIn; i += 16)
+	{
+		Cipher(Temp1, Temp2, W);
+		Xor(&in[i], Temp2, 16, Temp1);
+		memcpy(&out[i], Temp1, 16);
+		memcpy(Temp1, Temp2, 16);
+	}
+
+	return;
+}
+
+VOID WINAPI AesCtrEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* ICV, BYTE* Key, BYTE* out)
+{
+	DWORD i, W[60];
+	BYTE Temp[16], ICVCurrent[16];
+	DWORD cbCurrent;
+	ULONG64 ICVLow, ICVHigh;
+
+	KeyExpansion(Key, W, KeyTable[CurrentAESBitLength]);
+
+	Cipher(ICV, Temp, W);
+	Xor(in, Temp, 16, out);
+	memcpy(ICVCurrent, ICV, 16);
+	for (cbCurrent = 16; cbCurrent < cbIn; cbCurrent += 16)
+	{
+		if (ICVCurrent[15] == 0xff)
+		{
+			ICVHigh = 0;
+			for (i = 0; i < 8; i++)
+			{
+				ICVHigh <<= 8;
+				ICVHigh += ICVCurrent[i];
+			}
+			ICVLow = 0;
+			for (i = 8; i < 16; i++)
+			{
+				ICVLow <<= 8;
+				ICVLow += ICVCurrent[i];
+			}
+			if (ICVLow == 0xffffffffffffffff)
+			{
+				ICVLow = 0;
+				ICVHigh++;
+			}
+			else
+			{
+				ICVLow++;
+			}
+			for (i = 0; i < 8; i++)
+			{
+				ICVCurrent[7 - i] = (BYTE)(ICVHigh & 0xff);
+				ICVHigh >>= 8;
+			}
+			for (i = 0; i < 8; i++)
+			{
+				ICVCurrent[15 - i] = (BYTE)(ICVLow & 0xff);
+				ICVLow >>= 8;
+			}
+		}
+		else
+		{
+			ICVCurrent[15]++;
+		}
+
+		Cipher(ICVCurrent, Temp, W);
+		Xor(&in[cbCurrent], Temp, 16, &out[cbCurrent]);
+	}
+
+	return;
+}
+
+// 4 rbge[u@ 4 rbgEVtgۂɂӂꂽrbgҌ邽߂̒l
+// (x^128 + x^7 + x^2 + x + 1 @Ƃ)
+const ULONG64 GhashLast4[16] = {
+	0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+	0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+// GhashMultiply4Bit ֐
+// 4 rbge[u@ (Shoup ̕@) p X = X E H vZ
+// PCLMULQDQ gpłȂꍇ GHASH ̏Z
+VOID WINAPI GhashMultiply4Bit(AES_GCM_CONTEXT* pContext, BYTE* X)
+{
+	INT i;
+	BYTE lo, hi, rem;
+	ULONG64 zh, zl;
+
+	lo = X[15] & 0xf;
+	zh = pContext->HH[lo];
+	zl = pContext->HL[lo];
+
+	for (i = 15; i >= 0; i--)
+	{
+		lo = X[i] & 0xf;
+		hi = (X[i] >> 4) & 0xf;
+
+		if (i != 15)
+		{
+			rem = (BYTE)zl & 0xf;
+			zl = (zh << 60) | (zl >> 4);
+			zh = (zh >> 4) ^ (GhashLast4[rem] << 48);
+			zh ^= pContext->HH[lo];
+			zl ^= pContext->HL[lo];
+		}
+
+		rem = (BYTE)zl & 0xf;
+		zl = (zh << 60) | (zl >> 4);
+		zh = (zh >> 4) ^ (GhashLast4[rem] << 48);
+		zh ^= pContext->HH[hi];
+		zl ^= pContext->HL[hi];
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		X[7 - i] = (BYTE)(zh >> (8 * i));
+		X[15 - i] = (BYTE)(zl >> (8 * i));
+	}
+
+	return;
+}
+
+// GhashUpdate ֐
+// GHASH ̏ Y Ƀf[^荞ށBŌ̕sSȃubN 0 ŃpfBO
+VOID WINAPI GhashUpdate(AES_GCM_CONTEXT* pContext, BYTE* Y, BYTE* data, DWORD cbData)
+{
+	DWORD i, nBlocks = cbData / 16;
+	BYTE Temp[16];
+
+#if defined(CIPH_X86)
+	if (pContext->bClmul)
+	{
+		GhashBlocksClmul(pContext, Y, data, nBlocks);
+		if (cbData % 16 != 0)
+		{
+			ZeroMemory(Temp, 16);
+			memcpy(Temp, &data[16 * nBlocks], cbData % 16);
+			GhashBlocksClmul(pContext, Y, Temp, 1);
+		}
+		return;
+	}
+#endif
+
+	for (i = 0; i < nBlocks; i++)
+	{
+		Xor(Y, &data[16 * i], 16, Y);
+		GhashMultiply4Bit(pContext, Y);
+	}
+	if (cbData % 16 != 0)
+	{
+		ZeroMemory(Temp, 16);
+		memcpy(Temp, &data[16 * nBlocks], cbData % 16);
+		Xor(Y, Temp, 16, Y);
+		GhashMultiply4Bit(pContext, Y);
+	}
+
+	return;
+}
+
+// Inc32 ֐
+// JE^ubN̉ 32 rbgrbOGfBA̐Ƃ 1 Z ( 96 rbg͕ωȂ)
+VOID WINAPI Inc32(BYTE* CB)
+{
+	DWORD dwCounter;
+
+	dwCounter = ((DWORD)CB[12] << 24) | ((DWORD)CB[13] << 16) | ((DWORD)CB[14] << 8) | CB[15];
+	dwCounter++;
+	CB[12] = (BYTE)(dwCounter >> 24);
+	CB[13] = (BYTE)(dwCounter >> 16);
+	CB[14] = (BYTE)(dwCounter >> 8);
+	CB[15] = (BYTE)dwCounter;
+
+	return;
+}
+
+// GcmCrypt ֐
+// GCTR ɂÍ / ƈÍ GHASH  1 pXōs
+// AES-NI  PCLMULQDQ gp\ȏꍇ AesNiGcmCrypt gp
+// ȊȌꍇ 4 ubÑL[Xg[܂Ƃ߂č쐬A
+// XOR ̃LbV̈Í GHASH Ɏ荞ނƂŁAf[^ 2 xǂݍ܂Ȃ悤ɂ
+VOID WINAPI GcmCrypt(AES_GCM_CONTEXT* pContext, BYTE* CB, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Y, BOOL bEncrypt)
+{
+	DWORD i, j, cbCurrent;
+	BYTE Counters[64], KeyStream[64];
+
+#if defined(CIPH_X86)
+	if (pContext->bClmul && (GetCpuFeatures() & CPU_FEATURE_AESNI))
+	{
+		AesNiGcmCrypt(pContext, CB, in, cbIn, out, Y, bEncrypt);
+		return;
+	}
+#endif
+
+	for (i = 0; i < cbIn; i += cbCurrent)
+	{
+		cbCurrent = cbIn - i < 64 ? cbIn - i : 64;
+
+		for (j = 0; j < (cbCurrent + 15) / 16; j++)
+		{
+			memcpy(&Counters[16 * j], CB, 16);
+			Inc32(CB);
+		}
+		AesEncryptBlocks(&pContext->Key, Counters, KeyStream, (cbCurrent + 15) / 16);
+
+		// ̏ꍇ XOR OɈÍ荞 (in  out ꍇɔ)
+		if (!bEncrypt)
+		{
+			GhashUpdate(pContext, Y, &in[i], cbCurrent);
+		}
+		Xor(&in[i], KeyStream, cbCurrent, &out[i]);
+		if (bEncrypt)
+		{
+			GhashUpdate(pContext, Y, &out[i], cbCurrent);
+		}
+	}
+
+	return;
+}
+
+// AesGcmInit ֐
+// GCM ̃ReLXg쐬BgAnbV H ̌vZAGHASH p̃e[u̍쐬 1 xs
+VOID WINAPI AesGcmInit(BYTE* Key, AESBitLength BitLength, AES_GCM_CONTEXT* pContext)
+{
+	DWORD i, j;
+	BYTE Zero[16] = { 0 };
+	ULONG64 vh, vl;
+
+	AesKeySetup(Key, BitLength, &pContext->Key);
+	AesEncryptBlocks(&pContext->Key, Zero, pContext->H, 1);
+
+	// 4 rbge[u̍쐬
+	vh = vl = 0;
+	for (i = 0; i < 8; i++)
+	{
+		vh = (vh << 8) | pContext->H[i];
+		vl = (vl << 8) | pContext->H[i + 8];
+	}
+
+	pContext->HL[0] = pContext->HH[0] = 0;
+	pContext->HL[8] = vl;
+	pContext->HH[8] = vh;
+	for (i = 4; i > 0; i >>= 1)
+	{
+		// HEx (rbg]\̂ 1 rbgEVtg)
+		ULONG64 T = (vl & 1) ? 0xe100000000000000ULL : 0;
+		vl = (vh << 63) | (vl >> 1);
+		vh = (vh >> 1) ^ T;
+		pContext->HL[i] = vl;
+		pContext->HH[i] = vh;
+	}
+	for (i = 2; i <= 8; i *= 2)
+	{
+		for (j = 1; j < i; j++)
+		{
+			pContext->HH[i + j] = pContext->HH[i] ^ pContext->HH[j];
+			pContext->HL[i + j] = pContext->HL[i] ^ pContext->HL[j];
+		}
+	}
+
+	pContext->bClmul = FALSE;
+#if defined(CIPH_X86)
+	if ((GetCpuFeatures() & (CPU_FEATURE_PCLMUL | CPU_FEATURE_SSSE3)) == (CPU_FEATURE_PCLMUL | CPU_FEATURE_SSSE3))
+	{
+		pContext->bClmul = TRUE;
+		GhashInitClmul(pContext);
+	}
+#endif
+
+	return;
+}
+
+// GcmComputeJ0 ֐
+// IV 玖OJE^ubN J0 쐬
+// IV  96 rbg̏ꍇ J0 = IV || 0^31 || 1
+// ȊȌꍇ J0 = GHASH(IV || 0^(s+64) || [len(IV)]64)
+VOID WINAPI GcmComputeJ0(AES_GCM_CONTEXT* pContext, BYTE* IV, DWORD cbIV, BYTE* J0)
+{
+	DWORD i;
+	BYTE Lengths[16] = { 0 };
+	ULONG64 cbitIV = (ULONG64)cbIV * 8;
+
+	if (cbIV == 12)
+	{
+		memcpy(J0, IV, 12);
+		J0[12] = J0[13] = J0[14] = 0;
+		J0[15] = 1;
+		return;
+	}
+
+	ZeroMemory(J0, 16);
+	GhashUpdate(pContext, J0, IV, cbIV);
+	for (i = 0; i < 8; i++)
+	{
+		Lengths[15 - i] = (BYTE)(cbitIV >> (8 * i));
+	}
+	GhashUpdate(pContext, J0, Lengths, 16);
+
+	return;
+}
+
+// GcmFinal ֐
+// AAD ƈÍ̃rbg GHASH Ɏ荞݁AF؃^O T = GCTR(J0, S) vZ
+VOID WINAPI GcmFinal(AES_GCM_CONTEXT* pContext, BYTE* J0, BYTE* S, DWORD cbAAD, DWORD cbIn, BYTE* Tag)
+{
+	DWORD i;
+	BYTE Lengths[16], EJ0[16];
+	ULONG64 cbitAAD = (ULONG64)cbAAD * 8, cbitIn = (ULONG64)cbIn * 8;
+
+	for (i = 0; i < 8; i++)
+	{
+		Lengths[7 - i] = (BYTE)(cbitAAD >> (8 * i));
+		Lengths[15 - i] = (BYTE)(cbitIn >> (8 * i));
+	}
+	GhashUpdate(pContext, S, Lengths, 16);
+
+	AesEncryptBlocks(&pContext->Key, J0, EJ0, 1);
+	Xor(S, EJ0, 16, Tag);
+
+	return;
+}
+
+// AesGcmEncrypt ֐
+// GCM p AES ɂFؕtÍs
+// 
+//          J0 ---> inc32 ---> CB1 ---> inc32 ---> CB2 ... CBn
+//           |                  |                   |        |
+//           v                  v                   v        v
+//         CIPH_K             CIPH_K              CIPH_K   CIPH_K
+//           |                  |                   |        |
+//           |       P1 ------>xor       P2 ------>xor ...  xor <--- Pn*
+//           |                  |                   |        |
+//           |                  v                   v        v
+//           |                 C1                  C2 ...   Cn*
+//           |                  |                   |        |
+//           |   AAD ---> GHASH_H (A || C1 || ... || Cn* || [len(A)]64 || [len(C)]64)
+//           |                               |
+//           +----------------------------> xor ---> Tag (128 bits)
+// 
+// IV ͔Cӂ̃oCg (96 rbg𐄏)AAAD ͔Cӂ̃oCgATag ɂ 16 oCg̗̈悪Kv
+VOID WINAPI AesGcmEncrypt(AES_GCM_CONTEXT* pContext, BYTE* IV, DWORD cbIV, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Tag)
+{
+	BYTE J0[16], CB[16], S[16] = { 0 };
+
+	GcmComputeJ0(pContext, IV, cbIV, J0);
+	memcpy(CB, J0, 16);
+	Inc32(CB);
+
+	GhashUpdate(pContext, S, AAD, cbAAD);
+	GcmCrypt(pContext, CB, in, cbIn, out, S, TRUE);
+	GcmFinal(pContext, J0, S, cbAAD, cbIn, Tag);
+
+	return;
+}
+
+// AesGcmDecrypt ֐
+// GCM p AES ɂFؕts
+// F؃^OvȂꍇ͏o͂ 0 ŏ FALSE Ԃ
+BOOL WINAPI AesGcmDecrypt(AES_GCM_CONTEXT* pContext, BYTE* IV, DWORD cbIV, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* Tag, BYTE* out)
+{
+	DWORD i;
+	BYTE J0[16], CB[16], S[16] = { 0 }, ExpectedTag[16], bDiff = 0;
+
+	GcmComputeJ0(pContext, IV, cbIV, J0);
+	memcpy(CB, J0, 16);
+	Inc32(CB);
+
+	GhashUpdate(pContext, S, AAD, cbAAD);
+	GcmCrypt(pContext, CB, in, cbIn, out, S, FALSE);
+	GcmFinal(pContext, J0, S, cbAAD, cbIn, ExpectedTag);
+
+	// ^C~OɂĈvoCgȂ悤ASoCgr
+	for (i = 0; i < 16; i++)
+	{
+		bDiff |= ExpectedTag[i] ^ Tag[i];
+	}
+
+	if (bDiff != 0)
+	{
+		SecureZeroMemory(out, cbIn);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+// 1 xɂ܂Ƃ߂ďubN
+// l̐ɌvZĂAAesEncryptBlocks / AesDecryptBlocks ̕ubNɓn
+#define XTS_LANES 32
+
+// AesXtsInit ֐
+// XTS ̃ReLXg쐬
+// Key  Key1 || Key2 ̘A (AES128  32 oCgAAES256  64 oCg)
+VOID WINAPI AesXtsInit(BYTE* Key, AESBitLength BitLength, AES_XTS_CONTEXT* pContext)
+{
+	AesKeySetup(Key, BitLength, &pContext->DataKey);
+	AesKeySetup(&Key[KeyTable[BitLength] * 4], BitLength, &pContext->TweakKey);
+
+	return;
+}
+
+// XtsMultiplyAlpha ֐
+// l T  GF(2^128) ̌n  悶 (T ̓gGfBAA@ x^128 + x^7 + x^2 + x + 1)
+VOID WINAPI XtsMultiplyAlpha(BYTE* T)
+{
+	INT i;
+	BYTE Carry = T[15] >> 7;
+
+	for (i = 15; i > 0; i--)
+	{
+		T[i] = (T[i] << 1) | (T[i - 1] >> 7);
+	}
+	T[0] = (T[0] << 1) ^ (Carry * 0x87);
+
+	return;
+}
+
+// XtsSectorTweak ֐
+// ZN^ԍ (f[^jbg̃V[PXԍ)  nSectors ̍ŏ̒l T = CIPH_Key2(i) vZ
+// ZN^ԍ 128 rbg̃gGfBAƂĈ
+VOID WINAPI XtsSectorTweak(AES_XTS_CONTEXT* pContext, ULONG64 SectorNumber, DWORD nSectors, BYTE* T)
+{
+	DWORD i, j;
+
+	ZeroMemory(T, 16 * nSectors);
+	for (i = 0; i < nSectors; i++)
+	{
+		for (j = 0; j < 8; j++)
+		{
+			T[16 * i + j] = (BYTE)((SectorNumber + i) >> (8 * j));
+		}
+	}
+	AesEncryptBlocks(&pContext->TweakKey, T, T, nSectors);
+
+	return;
+}
+
+// XtsCryptBlock ֐
+// l T p 1 ubNÍ /  (XEX : C = CIPH_Key1(P ^ T) ^ T)
+VOID WINAPI XtsCryptBlock(AES_XTS_CONTEXT* pContext, BYTE* T, BYTE* in, BYTE* out, BOOL bEncrypt)
+{
+	BYTE Temp[16];
+
+	Xor(in, T, 16, Temp);
+	if (bEncrypt)
+	{
+		AesEncryptBlocks(&pContext->DataKey, Temp, Temp, 1);
+	}
+	else
+	{
+		AesDecryptBlocks(&pContext->DataKey, Temp, Temp, 1);
+	}
+	Xor(Temp, T, 16, out);
+
+	return;
+}
+
+// XtsCryptSectorWithTweak ֐
+// ŏ̒l T 󂯎 1 ZN^Í /  (T ͔j󂳂)
+// XTS_LANES ubN̒l  {ŏɍ쐬ĂA܂Ƃ߂ăubNÍɓn
+// ZN^ 16 ̔{łȂꍇ͈Íގ (ciphertext stealing) ōŌ 2 ubN
+VOID WINAPI XtsCryptSectorWithTweak(AES_XTS_CONTEXT* pContext, BYTE* T, BYTE* in, DWORD cbSector, BYTE* out, BOOL bEncrypt)
+{
+	DWORD i, j, n, nBulk, cbTail = cbSector % 16;
+	BYTE Tweaks[16 * XTS_LANES], Buffer[16 * XTS_LANES], NextT[16], PP[16], CC[16];
+
+	// ÍގsꍇAŌ̊SȃubN͕ʂɏ
+	nBulk = cbSector / 16 - (cbTail != 0 ? 1 : 0);
+
+	for (i = 0; i < nBulk; i += n)
+	{
+		n = nBulk - i < XTS_LANES ? nBulk - i : XTS_LANES;
+
+		for (j = 0; j < n; j++)
+		{
+			memcpy(&Tweaks[16 * j], T, 16);
+			XtsMultiplyAlpha(T);
+		}
+
+		Xor(&in[16 * i], Tweaks, 16 * n, Buffer);
+		if (bEncrypt)
+		{
+			AesEncryptBlocks(&pContext->DataKey, Buffer, Buffer, n);
+		}
+		else
+		{
+			AesDecryptBlocks(&pContext->DataKey, Buffer, Buffer, n);
+		}
+		Xor(Buffer, Tweaks, 16 * n, &out[16 * i]);
+	}
+
+	if (cbTail == 0)
+	{
+		return;
+	}
+
+	// Íގ
+	// Í : CC = XEX(T(m-1), P(m-1)), C(m) = CC ̐擪 cbTail oCg, C(m-1) = XEX(T(m), P(m) || CC ̎c)
+	//  : l̎gptɂȂ
+	memcpy(NextT, T, 16);
+	XtsMultiplyAlpha(NextT);
+
+	XtsCryptBlock(pContext, bEncrypt ? T : NextT, &in[16 * nBulk], CC, bEncrypt);
+	memcpy(PP, &in[16 * nBulk + 16], cbTail);
+	memcpy(&PP[cbTail], &CC[cbTail], 16 - cbTail);
+	memcpy(&out[16 * nBulk + 16], CC, cbTail);
+	XtsCryptBlock(pContext, bEncrypt ? NextT : T, PP, &out[16 * nBulk], bEncrypt);
+
+	return;
+}
+
+// XtsCryptSector ֐
+// ZN^ԍw肵 1 ZN^Í / 
+// ZN^ 16 oCgȏłKv
+BOOL WINAPI XtsCryptSector(AES_XTS_CONTEXT* pContext, ULONG64 SectorNumber, BYTE* in, DWORD cbSector, BYTE* out, BOOL bEncrypt)
+{
+	BYTE T[16];
+
+	if (cbSector < 16)
+	{
+		return FALSE;
+	}
+
+	XtsSectorTweak(pContext, SectorNumber, 1, T);
+	XtsCryptSectorWithTweak(pContext, T, in, cbSector, out, bEncrypt);
+
+	return TRUE;
+}
+
+// AesXtsEncrypt ֐
+// XTS p AES ɂ 1 ZN^̈Ís
+// 
+//             i (ZN^ԍ)               P(j)
+//                   |                        |
+//                   v                        v
+//       Key2 -> CIPH_K ---> T ---> E^j --> xor
+//                                    |       |
+//                                    |       v
+//                                    | Key1 -> CIPH_K
+//                                    |       |
+//                                    |       v
+//                                    +-----> xor
+//                                            |
+//                                            v
+//                                           C(j)
+// 
+// cbSector  16 oCgȏ (16 ̔{łȂꍇ͈Íގs)
+BOOL WINAPI AesXtsEncrypt(AES_XTS_CONTEXT* pContext, ULONG64 SectorNumber, BYTE* in, DWORD cbSector, BYTE* out)
+{
+	return XtsCryptSector(pContext, SectorNumber, in, cbSector, out, TRUE);
+}
+
+// AesXtsDecrypt ֐
+// XTS p AES ɂ 1 ZN^̕s
+BOOL WINAPI AesXtsDecrypt(AES_XTS_CONTEXT* pContext, ULONG64 SectorNumber, BYTE* in, DWORD cbSector, BYTE* out)
+{
+	return XtsCryptSector(pContext, SectorNumber, in, cbSector, out, FALSE);
+}
+
+// ZN^̈ꊇ̃p[^
+typedef struct
+{
+	AES_XTS_CONTEXT* pContext;
+	ULONG64 FirstSector;
+	BYTE* in;
+	DWORD cbSector;
+	BYTE* out;
+	BOOL bEncrypt;
+} XTS_BATCH;
+
+// XtsBatchWorker ֐
+// dwFirst Ԗڂ dwCount ̃ZN^
+// XTS_LANES ZN^̍ŏ̒l 1 x AesEncryptBlocks ł܂Ƃ߂ČvZ
+VOID WINAPI XtsBatchWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	XTS_BATCH* pBatch = (XTS_BATCH*)pParam;
+	DWORD i, j, n;
+	BYTE T[16 * XTS_LANES];
+	SIZE_T Offset;
+
+	for (i = 0; i < dwCount; i += n)
+	{
+		n = dwCount - i < XTS_LANES ? dwCount - i : XTS_LANES;
+
+		XtsSectorTweak(pBatch->pContext, pBatch->FirstSector + dwFirst + i, n, T);
+		for (j = 0; j < n; j++)
+		{
+			Offset = (SIZE_T)(dwFirst + i + j) * pBatch->cbSector;
+			XtsCryptSectorWithTweak(pBatch->pContext, &T[16 * j], &pBatch->in[Offset], pBatch->cbSector, &pBatch->out[Offset], pBatch->bEncrypt);
+		}
+	}
+
+	return;
+}
+
+// XtsCryptSectors ֐
+// AZN^ԍ FirstSector  nSectors ̃ZN^Xbhv[ŕɈÍ / 
+// eZN^͓ƗĂ邽߁AXbhԂœ͕sv
+BOOL WINAPI XtsCryptSectors(AES_XTS_CONTEXT* pContext, ULONG64 FirstSector, BYTE* in, DWORD cbSector, DWORD nSectors, BYTE* out, DWORD dwThreads, BOOL bEncrypt)
+{
+	XTS_BATCH Batch;
+
+	if (cbSector < 16)
+	{
+		return FALSE;
+	}
+
+	Batch.pContext = pContext;
+	Batch.FirstSector = FirstSector;
+	Batch.in = in;
+	Batch.cbSector = cbSector;
+	Batch.out = out;
+	Batch.bEncrypt = bEncrypt;
+	RunParallelEx(XtsBatchWorker, &Batch, nSectors, cbSector, dwThreads);
+
+	return TRUE;
+}
+
+// AesXtsEncryptSectors ֐
+// XTS p AES ɂ镡ZN^̈ꊇÍs
+// in, out  cbSector * nSectors oCgAdwThreads ͎QXbh̏ (0 ̏ꍇ̓vZXŜ̏)
+BOOL WINAPI AesXtsEncryptSectors(AES_XTS_CONTEXT* pContext, ULONG64 FirstSector, BYTE* in, DWORD cbSector, DWORD nSectors, BYTE* out, DWORD dwThreads)
+{
+	return XtsCryptSectors(pContext, FirstSector, in, cbSector, nSectors, out, dwThreads, TRUE);
+}
+
+// AesXtsDecryptSectors ֐
+// XTS p AES ɂ镡ZN^̈ꊇs
+BOOL WINAPI AesXtsDecryptSectors(AES_XTS_CONTEXT* pContext, ULONG64 FirstSector, BYTE* in, DWORD cbSector, DWORD nSectors, BYTE* out, DWORD dwThreads)
+{
+	return XtsCryptSectors(pContext, FirstSector, in, cbSector, nSectors, out, dwThreads, FALSE);
+}
+
+// 1 xɂ܂Ƃ߂ďubN
+#define OCB_LANES 32
+
+// XbhɕzP (ubN)
+// ZbZ[W͌ĂяõXbhŏ
+#define OCB_CHUNK_BLOCKS 4096
+
+// OcbDouble ֐
+// GF(2^128)  2 { (rbOGfBAA@ x^128 + x^7 + x^2 + x + 1)
+VOID WINAPI OcbDouble(BYTE* in, BYTE* out)
+{
+	INT i;
+	BYTE Carry = in[0] >> 7;
+
+	for (i = 0; i < 15; i++)
+	{
+		out[i] = (in[i] << 1) | (in[i + 1] >> 7);
+	}
+	out[15] = (in[15] << 1) ^ (Carry * 0x87);
+
+	return;
+}
+
+// OcbNtz ֐
+// i ̖ɑ 0 ̃rbg (number of trailing zeros) Ԃ (i != 0)
+DWORD WINAPI OcbNtz(DWORD i)
+{
+	DWORD n = 0;
+
+	while ((i & 1) == 0)
+	{
+		i >>= 1;
+		n++;
+	}
+
+	return n;
+}
+
+// AesOcbInit ֐
+// OCB ̃ReLXg쐬BcbTag  1 ` 16 oCg
+BOOL WINAPI AesOcbInit(BYTE* Key, AESBitLength BitLength, DWORD cbTag, AES_OCB_CONTEXT* pContext)
+{
+	DWORD i;
+	BYTE Zero[16] = { 0 };
+
+	if (cbTag == 0 || 16 < cbTag)
+	{
+		return FALSE;
+	}
+
+	AesKeySetup(Key, BitLength, &pContext->Key);
+	pContext->cbTag = cbTag;
+
+	AesEncryptBlocks(&pContext->Key, Zero, pContext->LStar, 1);
+	OcbDouble(pContext->LStar, pContext->LDollar);
+	OcbDouble(pContext->LDollar, pContext->L[0]);
+	for (i = 1; i < OCB_L_MAX; i++)
+	{
+		OcbDouble(pContext->L[i - 1], pContext->L[i]);
+	}
+
+	return TRUE;
+}
+
+// OcbOffsetAt ֐
+// i ubNڂ Offset_i 𒼐ڌvZ
+// Offset_i = Offset_{i-1} ^ L_{ntz(i)}  i JԂƁA
+// Offset_0 ɃOCR[h gray(i) = i ^ (i >> 1) ̗Ărbg k  L_k  XOR ̂ɂȂ
+// ɂAeXbh̓bZ[W̓rƗɏn߂
+VOID WINAPI OcbOffsetAt(AES_OCB_CONTEXT* pContext, BYTE* Offset0, DWORD i, BYTE* Offset)
+{
+	DWORD k, Gray = i ^ (i >> 1);
+
+	memcpy(Offset, Offset0, 16);
+	for (k = 0; Gray != 0; k++, Gray >>= 1)
+	{
+		if (Gray & 1)
+		{
+			Xor(Offset, pContext->L[k], 16, Offset);
+		}
+	}
+
+	return;
+}
+
+// OCB ̏̎
+#define OCB_PROCESS_HASH    0 // AAD  HASH (ENCIPHER ̏o͂ Sum ɉZ)
+#define OCB_PROCESS_ENCRYPT 1 // Í ( Checksum ɉZ)
+#define OCB_PROCESS_DECRYPT 2 //  ( Checksum ɉZ)
+
+// OcbProcessBlocks ֐
+// dwFirst Ԗ (0 n܂)  nBlocks ̊SȃubNAChecksum (HASH ̏ꍇ Sum) ɉZ
+// Offset  dwFirst ubNڂ̒O̒l (Offset_{dwFirst}) Jn
+// OCB_LANES ubÑItZbgOCR[h̏ɍ쐬ĂA܂Ƃ߂ăubNÍɓn
+VOID WINAPI OcbProcessBlocks(AES_OCB_CONTEXT* pContext, BYTE* Offset, DWORD dwFirst, BYTE* in, DWORD nBlocks, BYTE* out, DWORD dwProcess, BYTE* Checksum)
+{
+	DWORD i, j, n;
+	BYTE Offsets[16 * OCB_LANES], Buffer[16 * OCB_LANES];
+
+	for (i = 0; i < nBlocks; i += n)
+	{
+		n = nBlocks - i < OCB_LANES ? nBlocks - i : OCB_LANES;
+
+		for (j = 0; j < n; j++)
+		{
+			Xor(Offset, pContext->L[OcbNtz(dwFirst + i + j + 1)], 16, Offset);
+			memcpy(&Offsets[16 * j], Offset, 16);
+		}
+
+		Xor(&in[16 * i], Offsets, 16 * n, Buffer);
+		if (dwProcess == OCB_PROCESS_DECRYPT)
+		{
+			AesDecryptBlocks(&pContext->Key, Buffer, Buffer, n);
+		}
+		else
+		{
+			AesEncryptBlocks(&pContext->Key, Buffer, Buffer, n);
+		}
+
+		if (dwProcess == OCB_PROCESS_HASH)
+		{
+			for (j = 0; j < n; j++)
+			{
+				Xor(Checksum, &Buffer[16 * j], 16, Checksum);
+			}
+			continue;
+		}
+
+		// Í̏ꍇ in  out łǂ悤A㏑OɕZ
+		if (dwProcess == OCB_PROCESS_ENCRYPT)
+		{
+			for (j = 0; j < n; j++)
+			{
+				Xor(Checksum, &in[16 * (i + j)], 16, Checksum);
+			}
+		}
+		Xor(Buffer, Offsets, 16 * n, &out[16 * i]);
+		if (dwProcess == OCB_PROCESS_DECRYPT)
+		{
+			for (j = 0; j < n; j++)
+			{
+				Xor(Checksum, &out[16 * (i + j)], 16, Checksum);
+			}
+		}
+	}
+
+	return;
+}
+
+// Xbhŏꍇ̃p[^
+typedef struct
+{
+	AES_OCB_CONTEXT* pContext;
+	BYTE* Offset0;
+	BYTE* in;
+	BYTE* out;
+	DWORD nBlocks;
+	DWORD dwProcess;
+	BYTE* Checksums; // `N Checksum (Sum)
+} OCB_BATCH;
+
+// OcbBatchWorker ֐
+// dwFirst Ԗڂ dwCount ̃`NA`N Checksum L^
+VOID WINAPI OcbBatchWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	OCB_BATCH* pBatch = (OCB_BATCH*)pParam;
+	DWORD c, dwBlock, nBlocks;
+	BYTE Offset[16];
+
+	for (c = dwFirst; c < dwFirst + dwCount; c++)
+	{
+		dwBlock = c * OCB_CHUNK_BLOCKS;
+		nBlocks = pBatch->nBlocks - dwBlock < OCB_CHUNK_BLOCKS ? pBatch->nBlocks - dwBlock : OCB_CHUNK_BLOCKS;
+
+		OcbOffsetAt(pBatch->pContext, pBatch->Offset0, dwBlock, Offset);
+		ZeroMemory(&pBatch->Checksums[16 * c], 16);
+		OcbProcessBlocks(pBatch->pContext, Offset, dwBlock, &pBatch->in[16 * (SIZE_T)dwBlock], nBlocks, pBatch->out != NULL ? &pBatch->out[16 * (SIZE_T)dwBlock] : NULL, pBatch->dwProcess, &pBatch->Checksums[16 * c]);
+	}
+
+	return;
+}
+
+// OcbProcess ֐
+// nBlocks ̊SȃubNAChecksum (Sum) ɉZB Offset (Offset_m) Ԃ
+// OCB_CHUNK_BLOCKS ̃`NɕăXbhŏA`N Checksum Ō XOR Ō
+VOID WINAPI OcbProcess(AES_OCB_CONTEXT* pContext, BYTE* Offset, BYTE* in, DWORD nBlocks, BYTE* out, DWORD dwProcess, BYTE* Checksum, DWORD dwThreads)
+{
+	DWORD c, nChunks = (nBlocks + OCB_CHUNK_BLOCKS - 1) / OCB_CHUNK_BLOCKS;
+	BYTE Offset0[16];
+	OCB_BATCH Batch;
+
+	if (dwThreads == 1 || nChunks <= 1)
+	{
+		OcbProcessBlocks(pContext, Offset, 0, in, nBlocks, out, dwProcess, Checksum);
+		return;
+	}
+
+	memcpy(Offset0, Offset, 16);
+	Batch.pContext = pContext;
+	Batch.Offset0 = Offset0;
+	Batch.in = in;
+	Batch.out = out;
+	Batch.nBlocks = nBlocks;
+	Batch.dwProcess = dwProcess;
+	Batch.Checksums = (BYTE*)CiphAlloc(16 * (SIZE_T)nChunks);
+	RunParallelEx(OcbBatchWorker, &Batch, nChunks, 16 * OCB_CHUNK_BLOCKS, dwThreads);
+
+	for (c = 0; c < nChunks; c++)
+	{
+		Xor(Checksum, &Batch.Checksums[16 * c], 16, Checksum);
+	}
+	OcbOffsetAt(pContext, Offset0, nBlocks, Offset);
+
+	CiphFree(Batch.Checksums);
+
+	return;
+}
+
+// OcbHash ֐
+// AAD  HASH(K, A) vZ
+VOID WINAPI OcbHash(AES_OCB_CONTEXT* pContext, BYTE* AAD, DWORD cbAAD, BYTE* Sum, DWORD dwThreads)
+{
+	DWORD nBlocks = cbAAD / 16, cbRemain = cbAAD % 16;
+	BYTE Offset[16] = { 0 }, Temp[16];
+
+	ZeroMemory(Sum, 16);
+	OcbProcess(pContext, Offset, AAD, nBlocks, NULL, OCB_PROCESS_HASH, Sum, dwThreads);
+
+	if (cbRemain != 0)
+	{
+		Xor(Offset, pContext->LStar, 16, Offset);
+		ZeroMemory(Temp, 16);
+		memcpy(Temp, &AAD[16 * nBlocks], cbRemain);
+		Temp[cbRemain] = 0x80;
+		Xor(Temp, Offset, 16, Temp);
+		AesEncryptBlocks(&pContext->Key, Temp, Temp, 1);
+		Xor(Sum, Temp, 16, Sum);
+	}
+
+	return;
+}
+
+// OcbInitialOffset ֐
+// mX (1 ` 15 oCg)  Offset_0 vZ
+// Nonce = num2str(TAGLEN mod 128, 7) || 0* || 1 || N
+// Ktop = ENCIPHER(K, Nonce[1..122] || 0^6), Stretch = Ktop || (Ktop[1..64] ^ Ktop[9..72])
+// Offset_0 = Stretch[1+bottom..128+bottom] (bottom = Nonce ̉ 6 rbg)
+VOID WINAPI OcbInitialOffset(AES_OCB_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* Offset)
+{
+	DWORD i, Bottom, ByteShift, BitShift;
+	BYTE NonceBlock[16] = { 0 }, Stretch[24];
+
+	NonceBlock[0] = (BYTE)(((pContext->cbTag * 8) % 128) << 1);
+	NonceBlock[15 - cbNonce] |= 1;
+	memcpy(&NonceBlock[16 - cbNonce], Nonce, cbNonce);
+
+	Bottom = NonceBlock[15] & 0x3f;
+	NonceBlock[15] &= 0xc0;
+	AesEncryptBlocks(&pContext->Key, NonceBlock, Stretch, 1);
+	for (i = 0; i < 8; i++)
+	{
+		Stretch[16 + i] = Stretch[i] ^ Stretch[i + 1];
+	}
+
+	ByteShift = Bottom / 8;
+	BitShift = Bottom % 8;
+	for (i = 0; i < 16; i++)
+	{
+		Offset[i] = (BYTE)((Stretch[i + ByteShift] << BitShift) | (BitShift != 0 ? Stretch[i + ByteShift + 1] >> (8 - BitShift) : 0));
+	}
+
+	return;
+}
+
+// OcbCrypt ֐
+// OCB ɂÍ / sAF؃^O (16 oCgA擪 cbTag oCggp) vZ
+BOOL WINAPI OcbCrypt(AES_OCB_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* out, BYTE* FullTag, BOOL bEncrypt, DWORD dwThreads)
+{
+	DWORD nBlocks = cbIn / 16, cbRemain = cbIn % 16;
+	BYTE Offset[16], Checksum[16] = { 0 }, Sum[16], Pad[16], Temp[16];
+
+	if (cbNonce == 0 || 15 < cbNonce)
+	{
+		return FALSE;
+	}
+
+	OcbInitialOffset(pContext, Nonce, cbNonce, Offset);
+	OcbProcess(pContext, Offset, in, nBlocks, out, bEncrypt ? OCB_PROCESS_ENCRYPT : OCB_PROCESS_DECRYPT, Checksum, dwThreads);
+
+	// Ō̕sSȃubN
+	if (cbRemain != 0)
+	{
+		Xor(Offset, pContext->LStar, 16, Offset);
+		AesEncryptBlocks(&pContext->Key, Offset, Pad, 1);
+
+		ZeroMemory(Temp, 16);
+		memcpy(Temp, &in[16 * nBlocks], cbRemain);
+		Xor(Temp, Pad, cbRemain, &out[16 * nBlocks]);
+		if (!bEncrypt)
+		{
+			memcpy(Temp, &out[16 * nBlocks], cbRemain);
+		}
+		Temp[cbRemain] = 0x80;
+		Xor(Checksum, Temp, 16, Checksum);
+	}
+
+	// Tag = ENCIPHER(K, Checksum ^ Offset ^ L_$) ^ HASH(K, A)
+	Xor(Checksum, Offset, 16, Temp);
+	Xor(Temp, pContext->LDollar, 16, Temp);
+	AesEncryptBlocks(&pContext->Key, Temp, FullTag, 1);
+	OcbHash(pContext, AAD, cbAAD, Sum, dwThreads);
+	Xor(FullTag, Sum, 16, FullTag);
+
+	return TRUE;
+}
+
+// AesOcbEncrypt ֐
+// OCB p AES ɂFؕtÍs
+// 
+//   Offset_0 = f(K, Nonce), Offset_i = Offset_{i-1} ^ L_{ntz(i)}
+// 
+//        P1                   P2                   Pm
+//        |                    |                    |
+//   O1->xor              O2->xor              Om->xor
+//        |                    |                    |
+//        v                    v                    v
+//    ENCIPHER(K)          ENCIPHER(K)          ENCIPHER(K)
+//        |                    |                    |
+//   O1->xor              O2->xor              Om->xor
+//        |                    |                    |
+//        v                    v                    v
+//        C1                   C2                   Cm
+// 
+//   Tag = ENCIPHER(K, (P1 ^ P2 ^ ... ^ Pm) ^ Offset_m ^ L_$) ^ HASH(K, A)
+// 
+// eubN͓ƗĂ邽߁AItZbgvZΔCӂ̈ʒuɏł
+// Nonce  1 ` 15 oCgATag ɂ cbTag oCg̗̈悪Kv
+// dwThreads ͎gpXbh (1 ̏ꍇ͌ĂяõXbĥ݁A0 ̏ꍇ̓vZXŜ̏)
+BOOL WINAPI AesOcbEncrypt(AES_OCB_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Tag, DWORD dwThreads)
+{
+	BYTE FullTag[16];
+
+	if (!OcbCrypt(pContext, Nonce, cbNonce, AAD, cbAAD, in, cbIn, out, FullTag, TRUE, dwThreads))
+	{
+		return FALSE;
+	}
+	memcpy(Tag, FullTag, pContext->cbTag);
+
+	return TRUE;
+}
+
+// AesOcbDecrypt ֐
+// OCB p AES ɂFؕts
+// F؃^OvȂꍇ͏o͂ 0 ŏ FALSE Ԃ
+BOOL WINAPI AesOcbDecrypt(AES_OCB_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* Tag, BYTE* out, DWORD dwThreads)
+{
+	DWORD i;
+	BYTE FullTag[16], bDiff = 0;
+
+	if (!OcbCrypt(pContext, Nonce, cbNonce, AAD, cbAAD, in, cbIn, out, FullTag, FALSE, dwThreads))
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i < pContext->cbTag; i++)
+	{
+		bDiff |= FullTag[i] ^ Tag[i];
+	}
+
+	if (bDiff != 0)
+	{
+		SecureZeroMemory(out, cbIn);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+// AesCcmInit ֐
+// CCM ̃ReLXg쐬
+BOOL WINAPI AesCcmInit(BYTE* Key, AESBitLength BitLength, DWORD cbTag, AES_CCM_CONTEXT* pContext)
+{
+	if (cbTag < 4 || 16 < cbTag || cbTag % 2 != 0)
+	{
+		return FALSE;
+	}
+
+	AesKeySetup(Key, BitLength, &pContext->Key);
+	pContext->cbTag = cbTag;
+
+	return TRUE;
+}
+
+// CcmIncrement ֐
+// JE^ubN̉ q oCgrbOGfBA̐Ƃ 1 Z
+VOID WINAPI CcmIncrement(BYTE* Ctr, DWORD q)
+{
+	DWORD i;
+
+	for (i = 15; 15 - q < i; i--)
+	{
+		if (++Ctr[i] != 0)
+		{
+			break;
+		}
+	}
+
+	return;
+}
+
+// CcmMacAad ֐
+// AAD 𒷂̕ (2 oCgA܂ 0xff 0xfe ɑ 4 oCg) ƘAA0 ŃpfBO CBC-MAC Ɏ荞
+VOID WINAPI CcmMacAad(AES_CCM_CONTEXT* pContext, BYTE* X, BYTE* AAD, DWORD cbAAD)
+{
+	DWORD i, cbHeader, cbCurrent, dwPos = 0;
+	BYTE Block[16];
+
+	if (cbAAD == 0)
+	{
+		return;
+	}
+
+	ZeroMemory(Block, 16);
+	if (cbAAD < 0xff00)
+	{
+		Block[0] = (BYTE)(cbAAD >> 8);
+		Block[1] = (BYTE)cbAAD;
+		cbHeader = 2;
+	}
+	else
+	{
+		Block[0] = 0xff;
+		Block[1] = 0xfe;
+		for (i = 0; i < 4; i++)
+		{
+			Block[2 + i] = (BYTE)(cbAAD >> (24 - 8 * i));
+		}
+		cbHeader = 6;
+	}
+
+	cbCurrent = 16 - cbHeader < cbAAD ? 16 - cbHeader : cbAAD;
+	memcpy(&Block[cbHeader], AAD, cbCurrent);
+	dwPos = cbCurrent;
+	for (;;)
+	{
+		Xor(X, Block, 16, X);
+		AesEncryptBlocks(&pContext->Key, X, X, 1);
+
+		if (dwPos == cbAAD)
+		{
+			break;
+		}
+
+		cbCurrent = 16 < cbAAD - dwPos ? 16 : cbAAD - dwPos;
+		ZeroMemory(Block, 16);
+		memcpy(Block, &AAD[dwPos], cbCurrent);
+		dwPos += cbCurrent;
+	}
+
+	return;
+}
+
+// CcmCrypt ֐
+// CCM ɂÍ /  CBC-MAC ̌vZ 1 pXōsAÍO̔F؃^O T (16 oCg)  S0 Ԃ
+// eXebv CBC-MAC ̎̃ubN E(X ^ P(i)) ƁA1 ̃L[Xg[ E(Ctr(i+1))  1 x AesEncryptBlocks ŏ
+// 2 ̃ubN͓ƗĂ邽߁AAES-NI ̏ꍇ 2 ubÑEh݂ɔsăCeVdȂ
+// L[Xg[ 1 ubNɌvZĂƂŁA (܂ MAC i߂Ȃ) `ŏł
+BOOL WINAPI CcmCrypt(AES_CCM_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* out, BYTE* T, BYTE* S0, BOOL bEncrypt)
+{
+	DWORD i, q = 15 - cbNonce, dwPos, cbCurrent;
+	BYTE Blocks[48], X[16], Ctr[16], S[16], P[16];
+
+	// mX 7 ` 13 oCgAyC[h q oCgŕ\Kv
+	if (cbNonce < 7 || 13 < cbNonce)
+	{
+		return FALSE;
+	}
+	if (q < 4 && (cbIn >> (8 * q)) != 0)
+	{
+		return FALSE;
+	}
+
+	// B0 = Flags || N || Q, Ctr(0) = Flags' || N || 0
+	ZeroMemory(Blocks, 48);
+	Blocks[0] = (BYTE)((cbAAD != 0 ? 0x40 : 0) | (((pContext->cbTag - 2) / 2) << 3) | (q - 1));
+	memcpy(&Blocks[1], Nonce, cbNonce);
+	for (i = 0; i < q && i < 4; i++)
+	{
+		Blocks[15 - i] = (BYTE)(cbIn >> (8 * i));
+	}
+	Ctr[0] = (BYTE)(q - 1);
+	memcpy(&Ctr[1], Nonce, cbNonce);
+	ZeroMemory(&Ctr[16 - q], q);
+	memcpy(&Blocks[16], Ctr, 16);
+	CcmIncrement(Ctr, q);
+	memcpy(&Blocks[32], Ctr, 16);
+
+	// X(0) = E(B0), S0 = E(Ctr(0)), S1 = E(Ctr(1)) ݂͌ɓƗĂ邽 1 xɏ
+	AesEncryptBlocks(&pContext->Key, Blocks, Blocks, 3);
+	memcpy(X, Blocks, 16);
+	memcpy(S0, &Blocks[16], 16);
+	memcpy(S, &Blocks[32], 16);
+
+	CcmMacAad(pContext, X, AAD, cbAAD);
+
+	for (dwPos = 0; dwPos < cbIn; dwPos += cbCurrent)
+	{
+		cbCurrent = 16 < cbIn - dwPos ? 16 : cbIn - dwPos;
+
+		// P(i) m肳 (Í͓́A C(i) ^ S(i))
+		ZeroMemory(P, 16);
+		if (bEncrypt)
+		{
+			memcpy(P, &in[dwPos], cbCurrent);
+			Xor(P, S, cbCurrent, &out[dwPos]);
+		}
+		else
+		{
+			Xor(&in[dwPos], S, cbCurrent, P);
+			memcpy(&out[dwPos], P, cbCurrent);
+		}
+
+		// CBC-MAC ̎̃ubNƎ̃L[Xg[𓯎ɌvZ
+		Xor(X, P, 16, Blocks);
+		if (dwPos + cbCurrent < cbIn)
+		{
+			CcmIncrement(Ctr, q);
+			memcpy(&Blocks[16], Ctr, 16);
+			AesEncryptBlocks(&pContext->Key, Blocks, Blocks, 2);
+			memcpy(S, &Blocks[16], 16);
+		}
+		else
+		{
+			AesEncryptBlocks(&pContext->Key, Blocks, Blocks, 1);
+		}
+		memcpy(X, Blocks, 16);
+	}
+
+	memcpy(T, X, 16);
+	SecureZeroMemory(S, 16);
+	SecureZeroMemory(P, 16);
+
+	return TRUE;
+}
+
+// AesCcmEncrypt ֐
+// CCM p AES ɂFؕtÍs
+// 
+//   B0 || AAD || P ---> CBC-MAC (CIPH_K) ---> T
+//   Ctr(0), Ctr(1), ... ---> CIPH_K ---> S0, S1, ...
+//   C = (P ^ S1 || S2 || ...) || (T ^ S0) ̐擪 cbTag oCg
+// 
+// Nonce  7 ` 13 oCgATag ɂ cbTag oCg̗̈悪Kv
+BOOL WINAPI AesCcmEncrypt(AES_CCM_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Tag)
+{
+	BYTE T[16], S0[16];
+
+	if (!CcmCrypt(pContext, Nonce, cbNonce, AAD, cbAAD, in, cbIn, out, T, S0, TRUE))
+	{
+		return FALSE;
+	}
+	Xor(T, S0, pContext->cbTag, Tag);
+
+	return TRUE;
+}
+
+// AesCcmDecrypt ֐
+// CCM p AES ɂFؕts
+// F؃^OvȂꍇ͏o͂ 0 ŏ FALSE Ԃ
+BOOL WINAPI AesCcmDecrypt(AES_CCM_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* Tag, BYTE* out)
+{
+	DWORD i;
+	BYTE T[16], S0[16], bDiff = 0;
+
+	if (!CcmCrypt(pContext, Nonce, cbNonce, AAD, cbAAD, in, cbIn, out, T, S0, FALSE))
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i < pContext->cbTag; i++)
+	{
+		bDiff |= T[i] ^ S0[i] ^ Tag[i];
+	}
+
+	if (bDiff != 0)
+	{
+		SecureZeroMemory(out, cbIn);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+// ꊇœɐi߂郁bZ[W
+#define CMAC_LANES 8
+
+// AesCmacInit ֐
+// CMAC ̃ReLXg쐬 (L = CIPH_K(0^128), K1 = LEx, K2 = K1Ex)
+VOID WINAPI AesCmacInit(BYTE* Key, AESBitLength BitLength, AES_CMAC_CONTEXT* pContext)
+{
+	BYTE L[16] = { 0 };
+
+	AesKeySetup(Key, BitLength, &pContext->Key);
+	AesEncryptBlocks(&pContext->Key, L, L, 1);
+	OcbDouble(L, pContext->K1);
+	OcbDouble(pContext->K1, pContext->K2);
+	SecureZeroMemory(L, 16);
+
+	return;
+}
+
+// CmacBlockCount ֐
+// bZ[W̃ubNԂ (̃bZ[W 1 ubNƂĈ)
+DWORD WINAPI CmacBlockCount(DWORD cbIn)
+{
+	return cbIn == 0 ? 1 : (cbIn + 15) / 16;
+}
+
+// CmacLoadBlock ֐
+// bZ[W dwBlock Ԗڂ̃ubN Block Ɏo
+// Ō̃ubŃASȃubNȂ K1 AłȂ 10* ŃpfBO K2  XOR 
+VOID WINAPI CmacLoadBlock(AES_CMAC_CONTEXT* pContext, BYTE* in, DWORD cbIn, DWORD dwBlock, BYTE* Block)
+{
+	DWORD cbLast;
+
+	if (dwBlock + 1 < CmacBlockCount(cbIn))
+	{
+		memcpy(Block, &in[16 * dwBlock], 16);
+		return;
+	}
+
+	cbLast = cbIn - 16 * dwBlock;
+	if (cbLast == 16)
+	{
+		Xor(&in[16 * dwBlock], pContext->K1, 16, Block);
+		return;
+	}
+
+	ZeroMemory(Block, 16);
+	memcpy(Block, &in[16 * dwBlock], cbLast);
+	Block[cbLast] = 0x80;
+	Xor(Block, pContext->K2, 16, Block);
+
+	return;
+}
+
+// AesCmac ֐
+// CMAC p AES ɂ郁bZ[WF؃R[h (16 oCg) vZ
+// 
+//        M1                  M2                 Mn* ^ K1 (܂ 10* ŃpfBO ^ K2)
+//        |                   |                   |
+//        |         +------->xor        +------->xor
+//        |         |         |         |         |
+//        v         |         v         |         v
+//      CIPH_K      |       CIPH_K      |       CIPH_K
+//        |         |         |         |         |
+//        +---------+         +---------+         +---> T (擪 Tlen rbggp)
+// 
+VOID WINAPI AesCmac(AES_CMAC_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* Mac)
+{
+	DWORD i, nBlocks = CmacBlockCount(cbIn);
+	BYTE Block[16], X[16] = { 0 };
+
+	for (i = 0; i < nBlocks; i++)
+	{
+		CmacLoadBlock(pContext, in, cbIn, i, Block);
+		Xor(X, Block, 16, X);
+		AesEncryptBlocks(&pContext->Key, X, X, 1);
+	}
+	memcpy(Mac, X, 16);
+
+	return;
+}
+
+// AesCmacBatch ֐
+//  nMessages ̓ƗbZ[W CMAC vZAMacs  16 oCgi[
+// 1 ̃bZ[W CBC-MAC ͑ÕubŇʂ҂Kv邪AقȂ郁bZ[W̘A͓ƗĂ
+// ōő CMAC_LANES ̃bZ[W̘A 1 ubNĐi߁AeXebv 1 x AesEncryptBlocks ŏ
+// ZbZ[WI[ɂ͎̃bZ[W[AɕubN܂Ƃ߂ď悤ɂ
+VOID WINAPI AesCmacBatch(AES_CMAC_CONTEXT* pContext, BYTE** Messages, DWORD* cbMessages, DWORD nMessages, BYTE* Macs)
+{
+	DWORD j, dwNext = 0, nActive = 0;
+	DWORD Lane[CMAC_LANES], Block[CMAC_LANES];
+	BYTE State[16 * CMAC_LANES], Input[16 * CMAC_LANES];
+
+	for (;;)
+	{
+		// 󂢂[Ɏ̃bZ[W蓖Ă
+		while (nActive < CMAC_LANES && dwNext < nMessages)
+		{
+			Lane[nActive] = dwNext++;
+			Block[nActive] = 0;
+			ZeroMemory(&State[16 * nActive], 16);
+			nActive++;
+		}
+		if (nActive == 0)
+		{
+			break;
+		}
+
+		// e[̎̃ubNׂāA܂Ƃ߂ĈÍ
+		for (j = 0; j < nActive; j++)
+		{
+			CmacLoadBlock(pContext, Messages[Lane[j]], cbMessages[Lane[j]], Block[j], &Input[16 * j]);
+		}
+		Xor(Input, State, 16 * nActive, Input);
+		AesEncryptBlocks(&pContext->Key, Input, State, nActive);
+
+		// Ō̃ubN܂ŏ[͌ʂoAŌ̃[l߂
+		for (j = 0; j < nActive;)
+		{
+			if (++Block[j] < CmacBlockCount(cbMessages[Lane[j]]))
+			{
+				j++;
+				continue;
+			}
+
+			memcpy(&Macs[16 * (SIZE_T)Lane[j]], &State[16 * j], 16);
+			nActive--;
+			if (j != nActive)
+			{
+				Lane[j] = Lane[nActive];
+				Block[j] = Block[nActive];
+				memcpy(&State[16 * j], &State[16 * nActive], 16);
+			}
+		}
+	}
+
+	return;
+}
+
+// bv (KW : RFC 3394, KWP : RFC 5649)
+// Ql
+// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-38F.pdf
+// https://www.rfc-editor.org/rfc/rfc3394
+// https://www.rfc-editor.org/rfc/rfc5649
+// 
+// bv 8 oCg A  n  8 oCg̔ubN R(1) ` R(n)  A || R(1) || ... || R(n) ̌` 1 ̃obt@ɒuA
+// ̃obt@ł̏ŕϊ (bṽobt@̂܂܈ÍƂȂ)
+// 
+//   for j = 0 to 5, for i = 1 to n :
+//     B = CIPH_K(A || R(i)), A = MSB64(B) ^ t (t = n*j + i), R(i) = LSB64(B)
+// 
+// ͂̋tƂȂBKWP  n = 1 ̏ꍇ A || R(1)  1 xÍ邾ƂȂ
+
+// ꊇœɐi߂錮̐
+#define KW_LANES 8
+
+// KW ̏l (ICV1)  KWP ̏l̐擪 4 oCg (ICV2)
+const BYTE KwIcv1[8] = { 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6 };
+const BYTE KwIcv2[4] = { 0xA6, 0x59, 0x59, 0xA6 };
+
+// KwStepCount ֐
+// n ̔ubÑbvɕKv AES ̌Ăяo񐔂Ԃ
+DWORD WINAPI KwStepCount(DWORD n)
+{
+	return n == 1 ? 1 : 6 * n;
+}
+
+// KwProcessBatch ֐
+// nItems ̃obt@ (A || R(1) || ... || R(n)) ̏Ńbv / AbvBn  0 ̃obt@͏Ȃ
+// قȂ錮̃Eh݂͌ɓƗĂ邽߁Aő KW_LANES ̌̏ 1 XebvĐi߁A
+// eXebv 1 x AesEncryptBlocks / AesDecryptBlocks ŏBI[ɂ͎̌[
+VOID WINAPI KwProcessBatch(AES_KEY_CONTEXT* pKek, BYTE** Buffers, DWORD* nSemiblocks, DWORD nItems, BOOL bWrap)
+{
+	DWORD j, k, n, i, r, t, dwNext = 0, nActive = 0;
+	DWORD Lane[KW_LANES], Step[KW_LANES];
+	BYTE Input[16 * KW_LANES], * A, * R;
+
+	for (;;)
+	{
+		// 󂢂[Ɏ̌蓖Ă
+		while (nActive < KW_LANES && dwNext < nItems)
+		{
+			if (nSemiblocks[dwNext] != 0)
+			{
+				Lane[nActive] = dwNext;
+				Step[nActive] = 0;
+				nActive++;
+			}
+			dwNext++;
+		}
+		if (nActive == 0)
+		{
+			break;
+		}
+
+		// e[ A || R(i) ׂ
+		for (j = 0; j < nActive; j++)
+		{
+			n = nSemiblocks[Lane[j]];
+			A = Buffers[Lane[j]];
+			if (n == 1)
+			{
+				memcpy(&Input[16 * j], A, 16);
+				continue;
+			}
+
+			// Xebvԍ j (Eh)Ai (ubN)  t ߂BAbv͋tɐi
+			r = bWrap ? Step[j] / n : 5 - Step[j] / n;
+			i = bWrap ? Step[j] % n + 1 : n - Step[j] % n;
+			t = n * r + i;
+			R = &A[8 * i];
+
+			memcpy(&Input[16 * j], A, 8);
+			memcpy(&Input[16 * j + 8], R, 8);
+			if (!bWrap)
+			{
+				for (k = 0; k < 4; k++)
+				{
+					Input[16 * j + 7 - k] ^= (BYTE)(t >> (8 * k));
+				}
+			}
+		}
+
+		if (bWrap)
+		{
+			AesEncryptBlocks(pKek, Input, Input, nActive);
+		}
+		else
+		{
+			AesDecryptBlocks(pKek, Input, Input, nActive);
+		}
+
+		// ʂe[ A  R(i) ɏ߂AŌ̃Xebv܂ŏ[l߂
+		for (j = 0; j < nActive;)
+		{
+			n = nSemiblocks[Lane[j]];
+			A = Buffers[Lane[j]];
+			if (n == 1)
+			{
+				memcpy(A, &Input[16 * j], 16);
+			}
+			else
+			{
+				r = bWrap ? Step[j] / n : 5 - Step[j] / n;
+				i = bWrap ? Step[j] % n + 1 : n - Step[j] % n;
+				t = n * r + i;
+
+				memcpy(A, &Input[16 * j], 8);
+				memcpy(&A[8 * i], &Input[16 * j + 8], 8);
+				if (bWrap)
+				{
+					for (k = 0; k < 4; k++)
+					{
+						A[7 - k] ^= (BYTE)(t >> (8 * k));
+					}
+				}
+			}
+
+			if (++Step[j] < KwStepCount(n))
+			{
+				j++;
+				continue;
+			}
+
+			nActive--;
+			if (j != nActive)
+			{
+				Lane[j] = Lane[nActive];
+				Step[j] = Step[nActive];
+				memcpy(&Input[16 * j], &Input[16 * nActive], 16);
+			}
+		}
+	}
+
+	SecureZeroMemory(Input, sizeof(Input));
+
+	return;
+}
+
+// KwCheckIcv ֐
+// Abṽobt@ (A || P) ̏lmFÃoCgԂ (sȏꍇ FALSE)
+// KWP ̏ꍇ A = ICV2 || MLI ƂA8*(n-1) < MLI <= 8*n ƁApfBO 0 ł邱ƂmF
+BOOL WINAPI KwCheckIcv(BYTE* Buffer, DWORD n, BOOL bPadded, DWORD* pcbPlain)
+{
+	DWORD i, dwMli;
+	BYTE bDiff = 0;
+
+	if (!bPadded)
+	{
+		for (i = 0; i < 8; i++)
+		{
+			bDiff |= Buffer[i] ^ KwIcv1[i];
+		}
+		*pcbPlain = 8 * n;
+		return bDiff == 0;
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		bDiff |= Buffer[i] ^ KwIcv2[i];
+	}
+	dwMli = ((DWORD)Buffer[4] << 24) | ((DWORD)Buffer[5] << 16) | ((DWORD)Buffer[6] << 8) | Buffer[7];
+	if (bDiff != 0 || dwMli <= 8 * (n - 1) || 8 * n < dwMli)
+	{
+		return FALSE;
+	}
+	for (i = dwMli; i < 8 * n; i++)
+	{
+		bDiff |= Buffer[8 + i];
+	}
+	*pcbPlain = dwMli;
+
+	return bDiff == 0;
+}
+
+// AesKeyWrap ֐
+// bvsBout ɂ cbIn + 8 oCg (KWP ̏ꍇ 8 ̔{ɐ؂グ + 8 oCg) ̗̈悪Kv
+// KW ̏ꍇAcbIn  16 ȏ 8 ̔{łKv
+BOOL WINAPI AesKeyWrap(AES_KEY_CONTEXT* pKek, BYTE* in, DWORD cbIn, BOOL bPadded, BYTE* out, DWORD* pcbOut)
+{
+	DWORD i, n;
+
+	if (bPadded)
+	{
+		if (cbIn == 0)
+		{
+			return FALSE;
+		}
+		n = (cbIn + 7) / 8;
+		memcpy(out, KwIcv2, 4);
+		for (i = 0; i < 4; i++)
+		{
+			out[4 + i] = (BYTE)(cbIn >> (24 - 8 * i));
+		}
+	}
+	else
+	{
+		if (cbIn < 16 || cbIn % 8 != 0)
+		{
+			return FALSE;
+		}
+		n = cbIn / 8;
+		memcpy(out, KwIcv1, 8);
+	}
+
+	memmove(&out[8], in, cbIn);
+	ZeroMemory(&out[8 + cbIn], 8 * n - cbIn);
+	KwProcessBatch(pKek, &out, &n, 1, TRUE);
+	*pcbOut = 8 * n + 8;
+
+	return TRUE;
+}
+
+// AesKeyUnwrap ֐
+// AbvsBout ɂ cbIn - 8 oCg̗̈悪Kv
+// S̊mFɎsꍇ͏o͂ 0 ŏ FALSE Ԃ
+BOOL WINAPI AesKeyUnwrap(AES_KEY_CONTEXT* pKek, BYTE* in, DWORD cbIn, BOOL bPadded, BYTE* out, DWORD* pcbOut)
+{
+	DWORD n = cbIn / 8 - 1, cbPlain = 0;
+	BYTE* Buffer;
+	BOOL bResult;
+
+	if (cbIn % 8 != 0 || cbIn < (DWORD)(bPadded ? 16 : 24))
+	{
+		return FALSE;
+	}
+
+	Buffer = (BYTE*)CiphAllocEx(cbIn, CIPH_ALLOC_NO_ZERO);
+	memcpy(Buffer, in, cbIn);
+	KwProcessBatch(pKek, &Buffer, &n, 1, FALSE);
+
+	bResult = KwCheckIcv(Buffer, n, bPadded, &cbPlain);
+	if (bResult)
+	{
+		memcpy(out, &Buffer[8], cbPlain);
+		*pcbOut = cbPlain;
+	}
+	else
+	{
+		SecureZeroMemory(out, cbIn - 8);
+	}
+
+	SecureZeroMemory(Buffer, cbIn);
+	CiphFree(Buffer);
+
+	return bResult;
+}
+
+// AesKeyRewrapBatch ֐
+//  KEK Ńbvꂽ nKeys ̌AbvAV KEK Ńbv (KEK ̃[e[Vp)
+// in[i]  out[i]  cbIn[i] oCg (bvĂ͕ςȂ)Bin  out ͓łǂ
+// Abv A || R ̂܂ܐV KEK Ńbv邽߁Ǎ out ̃obt@̊Oɂ͒uȂ
+// ʂ pbResults[i] Ɋi[AS̊mFɎs̏o͂ 0 ŏBSĐꍇ TRUE Ԃ
+BOOL WINAPI AesKeyRewrapBatch(AES_KEY_CONTEXT* pOldKek, AES_KEY_CONTEXT* pNewKek, BOOL bPadded, BYTE** in, DWORD* cbIn, DWORD nKeys, BYTE** out, BOOL* pbResults)
+{
+	DWORD i, cbPlain;
+	DWORD* nSemiblocks;
+	BOOL bAllResult = TRUE;
+
+	nSemiblocks = (DWORD*)CiphAlloc(sizeof(DWORD) * (nKeys + 1));
+
+	for (i = 0; i < nKeys; i++)
+	{
+		pbResults[i] = cbIn[i] % 8 == 0 && cbIn[i] >= (DWORD)(bPadded ? 16 : 24);
+		nSemiblocks[i] = pbResults[i] ? cbIn[i] / 8 - 1 : 0;
+		if (pbResults[i])
+		{
+			memmove(out[i], in[i], cbIn[i]);
+		}
+	}
+
+	KwProcessBatch(pOldKek, out, nSemiblocks, nKeys, FALSE);
+
+	for (i = 0; i < nKeys; i++)
+	{
+		if (pbResults[i] && !KwCheckIcv(out[i], nSemiblocks[i], bPadded, &cbPlain))
+		{
+			pbResults[i] = FALSE;
+			SecureZeroMemory(out[i], cbIn[i]);
+			nSemiblocks[i] = 0;
+		}
+		bAllResult = bAllResult && pbResults[i];
+	}
+
+	KwProcessBatch(pNewKek, out, nSemiblocks, nKeys, TRUE);
+
+	CiphFree(nSemiblocks);
+
+	return bAllResult;
+}
+
+// Increment128 ֐
+// 128 rbg̃JE^ubNrbOGfBA̐Ƃ 1 Z
+VOID WINAPI Increment128(BYTE* CB)
+{
+	INT i;
+
+	for (i = 15; i >= 0; i--)
+	{
+		if (++CB[i] != 0)
+		{
+			break;
+		}
+	}
+
+	return;
+}
+
+// AesCtrKeystream ֐
+// 128 rbg̃JE^ CB  nBlocks ̃L[Xg[ out ɏoACB i߂
+// AES-NI gpłȂꍇ out ɃJE^ubNׂĂȀ AesEncryptBlocks ɓn
+VOID WINAPI AesCtrKeystream(AES_KEY_CONTEXT* pContext, BYTE* CB, BYTE* out, DWORD nBlocks)
+{
+	DWORD i;
+
+#if defined(CIPH_X86)
+	if ((GetCpuFeatures() & (CPU_FEATURE_AESNI | CPU_FEATURE_SSSE3)) == (CPU_FEATURE_AESNI | CPU_FEATURE_SSSE3))
+	{
+		AesNiCtrKeystream(pContext, CB, out, nBlocks);
+		return;
+	}
+#endif
+
+	for (i = 0; i < nBlocks; i++)
+	{
+		memcpy(&out[16 * i], CB, 16);
+		Increment128(CB);
+	}
+	AesEncryptBlocks(pContext, out, out, nBlocks);
+
+	return;
+}
+
+// ECB, CBC ̕, CTR ̈ꊇ
+// AES-NI  4 ubN݂ɏ邽߁AAES_INTERLEAVE_BLOCKS ̓͂ 1 ubN
+// 񏈗 AES_DISPATCH_GROUP oCg 1 ڂƂACBC ͊̕e؂̒ÖÍubN IV Ƃ
+#define AES_BATCH_BLOCKS      256
+#define AES_INTERLEAVE_BLOCKS 4
+#define AES_DISPATCH_GROUP    (16 * AES_BATCH_BLOCKS)
+
+// AesCtrCounter ֐
+// CB = ICV + Offset / 16 (128 rbg big endian ̉Z) ߂
+VOID WINAPI AesCtrCounter(BYTE* ICV, ULONG64 Offset, BYTE* CB)
+{
+	ULONG64 Carry = Offset / 16;
+	INT i;
+
+	for (i = 15; i >= 0; i--)
+	{
+		Carry += ICV[i];
+		CB[i] = (BYTE)Carry;
+		Carry >>= 8;
+	}
+
+	return;
+}
+
+// AesCbcDecryptBlocks ֐
+// ReLXgp CBC ɂ镡s
+// AES_BATCH_BLOCKS ubN AesDecryptBlocks ł܂Ƃ߂ĕĂÖÍubN xor 
+// in  out obt@ł悢悤AÖÍubN͏ݑOɑޔ
+VOID WINAPI AesCbcDecryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	BYTE Temp[16 * AES_BATCH_BLOCKS], Prev[16];
+	DWORD cbCurrent, cbChunk, i;
+
+	memcpy(Prev, IV, 16);
+	for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += cbChunk)
+	{
+		cbChunk = cbIn - cbCurrent < sizeof(Temp) ? cbIn - cbCurrent : sizeof(Temp);
+		AesDecryptBlocks(pContext, &in[cbCurrent], Temp, cbChunk / 16);
+		Xor(Temp, Prev, 16, Temp);
+		for (i = 16; i < cbChunk; i += 16)
+		{
+			Xor(&Temp[i], &in[cbCurrent + i - 16], 16, &Temp[i]);
+		}
+		memcpy(Prev, &in[cbCurrent + cbChunk - 16], 16);
+		memcpy(&out[cbCurrent], Temp, cbChunk);
+	}
+	SecureZeroMemory(Temp, cbIn < sizeof(Temp) ? cbIn : sizeof(Temp));
+
+	return;
+}
+
+// AesCtrCryptBlocks ֐
+// ReLXgp CTR ɂÍ / s (JE^ ICV  128 rbg big endian ̐Ƃ݂Ȃ)
+// Offset ̓f[^Ŝ̐擪̃oCgʒuŁAICV + Offset / 16 ̃JE^ AesCtrKeystream ŌXg[A̐擪 Offset % 16 oCgǂݔ΂
+VOID WINAPI AesCtrCryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out)
+{
+	BYTE Stream[16 * AES_BATCH_BLOCKS], CB[16];
+	DWORD cbSkip = (DWORD)(Offset % 16), cbCurrent = 0, cbChunk, nBlocks;
+
+	AesCtrCounter(ICV, Offset, CB);
+	while (cbCurrent < cbIn)
+	{
+		nBlocks = (DWORD)(((ULONG64)cbSkip + (cbIn - cbCurrent) + 15) / 16);
+		if (nBlocks > AES_BATCH_BLOCKS)
+		{
+			nBlocks = AES_BATCH_BLOCKS;
+		}
+		AesCtrKeystream(pContext, CB, Stream, nBlocks);
+
+		cbChunk = 16 * nBlocks - cbSkip;
+		if (cbChunk > cbIn - cbCurrent)
+		{
+			cbChunk = cbIn - cbCurrent;
+		}
+		Xor(&in[cbCurrent], &Stream[cbSkip], cbChunk, &out[cbCurrent]);
+
+		cbCurrent += cbChunk;
+		cbSkip = 0;
+	}
+	SecureZeroMemory(Stream, cbIn + 16 < sizeof(Stream) ? cbIn + 16 : sizeof(Stream));
+
+	return;
+}
+
+// s@̑I (SelectDispatch) ƕ񏈗̃p[^
+typedef struct
+{
+	AES_KEY_CONTEXT* pContext;
+	BYTE* in;
+	DWORD cbIn;
+	BYTE* out;
+	BYTE* ICV;       // CTR
+	ULONG64 Offset;  // CTR
+	BYTE* Prevs;     // CBC : e؂̒ÖÍubN
+	BOOL bDecrypt;   // ECB
+} AES_DISPATCH_BATCH;
+
+// AesEcbSample ֐, AesCbcDecryptSample ֐, AesCtrSample ֐
+// 臒l̑Ɏg (pParam ̌ReLXg buf ̏ŏ)
+VOID WINAPI AesEcbSample(PVOID pParam, BYTE* buf, DWORD cb)
+{
+	AesEncryptBlocks((AES_KEY_CONTEXT*)pParam, buf, buf, cb / 16);
+
+	return;
+}
+
+VOID WINAPI AesCbcDecryptSample(PVOID pParam, BYTE* buf, DWORD cb)
+{
+	BYTE IV[16] = { 0 };
+
+	AesCbcDecryptBlocks((AES_KEY_CONTEXT*)pParam, buf, cb, IV, buf);
+
+	return;
+}
+
+VOID WINAPI AesCtrSample(PVOID pParam, BYTE* buf, DWORD cb)
+{
+	BYTE ICV[16] = { 0 };
+
+	AesCtrCryptBlocks((AES_KEY_CONTEXT*)pParam, buf, cb, ICV, 0, buf);
+
+	return;
+}
+
+// RegisterAesDispatchSamples ֐
+// 臒l̑Ɏgo^ (ÓIȏ 1 xĂяo)
+// ͌Ăяǒg킸ɍs߁A0  AES-128 ̌ō쐬ReLXgp
+static AES_KEY_CONTEXT AesSampleContext;
+
+BOOL WINAPI RegisterAesDispatchSamples()
+{
+	BYTE Key[16] = { 0 };
+
+	AesKeySetup(Key, AES128, &AesSampleContext);
+	RegisterDispatchSample(DISPATCH_AES_ECB, AesEcbSample, &AesSampleContext);
+	RegisterDispatchSample(DISPATCH_AES_CBC_DECRYPT, AesCbcDecryptSample, &AesSampleContext);
+	RegisterDispatchSample(DISPATCH_AES_CTR, AesCtrSample, &AesSampleContext);
+
+	return TRUE;
+}
+
+static const BOOL bAesDispatchSamples = RegisterAesDispatchSamples();
+
+// AesEcbWorker ֐
+// dwFirst Ԗڂ dwCount ̃ubNÍ / 
+VOID WINAPI AesEcbWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	AES_DISPATCH_BATCH* pBatch = (AES_DISPATCH_BATCH*)pParam;
+	SIZE_T cbFirst = (SIZE_T)dwFirst * 16;
+
+	if (pBatch->bDecrypt)
+	{
+		AesDecryptBlocks(pBatch->pContext, &pBatch->in[cbFirst], &pBatch->out[cbFirst], dwCount);
+	}
+	else
+	{
+		AesEncryptBlocks(pBatch->pContext, &pBatch->in[cbFirst], &pBatch->out[cbFirst], dwCount);
+	}
+
+	return;
+}
+
+// AesCbcDecryptWorker ֐
+// dwFirst Ԗڂ dwCount  AES_DISPATCH_GROUP oCg̋؂AޔÖÍubN IV Ƃĕ
+VOID WINAPI AesCbcDecryptWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	AES_DISPATCH_BATCH* pBatch = (AES_DISPATCH_BATCH*)pParam;
+	SIZE_T cbFirst = (SIZE_T)dwFirst * AES_DISPATCH_GROUP;
+	SIZE_T cbLast = (SIZE_T)(dwFirst + dwCount) * AES_DISPATCH_GROUP;
+
+	if (cbLast > pBatch->cbIn)
+	{
+		cbLast = pBatch->cbIn;
+	}
+	AesCbcDecryptBlocks(pBatch->pContext, &pBatch->in[cbFirst], (DWORD)(cbLast - cbFirst), &pBatch->Prevs[16 * (SIZE_T)dwFirst], &pBatch->out[cbFirst]);
+
+	return;
+}
+
+// AesCtrWorker ֐
+// dwFirst Ԗڂ dwCount  AES_DISPATCH_GROUP oCg̋؂ (e؂̃JE^ Offset vZ)
+VOID WINAPI AesCtrWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	AES_DISPATCH_BATCH* pBatch = (AES_DISPATCH_BATCH*)pParam;
+	SIZE_T cbFirst = (SIZE_T)dwFirst * AES_DISPATCH_GROUP;
+	SIZE_T cbLast = (SIZE_T)(dwFirst + dwCount) * AES_DISPATCH_GROUP;
+
+	if (cbLast > pBatch->cbIn)
+	{
+		cbLast = pBatch->cbIn;
+	}
+	AesCtrCryptBlocks(pBatch->pContext, &pBatch->in[cbFirst], (DWORD)(cbLast - cbFirst), pBatch->ICV, pBatch->Offset + cbFirst, &pBatch->out[cbFirst]);
+
+	return;
+}
+
+// AesEcbCryptDispatch ֐
+// ReLXgp ECB ɂÍ / s
+// ͂̃oCgɉāAAesEncryptBlocks (1 ubNA܂͌ݏ) Xbhv[ł̕񏈗I
+VOID WINAPI AesEcbCryptDispatch(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out, BOOL bDecrypt)
+{
+	AES_DISPATCH_BATCH Batch;
+
+	Batch.pContext = pContext;
+	Batch.in = in;
+	Batch.cbIn = cbIn;
+	Batch.out = out;
+	Batch.bDecrypt = bDecrypt;
+	if (SelectDispatch(DISPATCH_AES_ECB, cbIn, 16 * AES_INTERLEAVE_BLOCKS) == DISPATCH_THREADED)
+	{
+		RunParallelEx(AesEcbWorker, &Batch, cbIn / 16, 16, 0);
+	}
+	else
+	{
+		AesEcbWorker(&Batch, 0, cbIn / 16);
+	}
+
+	return;
+}
+
+// AesCbcDecryptDispatch ֐
+// ReLXgp CBC ɂ镡s (cbIn  16 ̔{)
+// ͂̃oCgɉāA1 ubN̏AAesCbcDecryptBlocks (ݏ)AXbhv[ł̕񏈗I
+// 񏈗ł͊e؂̒ÖÍubNɑޔ邽߁Ain  out obt@ł悢
+VOID WINAPI AesCbcDecryptDispatch(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	AES_DISPATCH_BATCH Batch;
+	BYTE Prev[16], Next[16], Temp[16];
+	DWORD dwMode, cbCurrent, i, nGroups = cbIn / AES_DISPATCH_GROUP + (cbIn % AES_DISPATCH_GROUP != 0 ? 1 : 0);
+
+	Batch.pContext = pContext;
+	Batch.in = in;
+	Batch.cbIn = cbIn;
+	Batch.out = out;
+	dwMode = SelectDispatch(DISPATCH_AES_CBC_DECRYPT, cbIn, 16 * AES_INTERLEAVE_BLOCKS);
+
+	if (dwMode == DISPATCH_SERIAL)
+	{
+		memcpy(Prev, IV, 16);
+		for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += 16)
+		{
+			memcpy(Next, &in[cbCurrent], 16);
+			AesDecryptBlocks(pContext, Next, Temp, 1);
+			Xor(Temp, Prev, 16, &out[cbCurrent]);
+			memcpy(Prev, Next, 16);
+		}
+		SecureZeroMemory(Temp, sizeof(Temp));
+		return;
+	}
+
+	if (dwMode == DISPATCH_THREADED)
+	{
+		Batch.Prevs = (BYTE*)CiphAllocEx(16 * (SIZE_T)nGroups, CIPH_ALLOC_NO_ZERO);
+		if (Batch.Prevs != NULL)
+		{
+			memcpy(Batch.Prevs, IV, 16);
+			for (i = 1; i < nGroups; i++)
+			{
+				memcpy(&Batch.Prevs[16 * (SIZE_T)i], &in[(SIZE_T)i * AES_DISPATCH_GROUP - 16], 16);
+			}
+			RunParallelEx(AesCbcDecryptWorker, &Batch, nGroups, AES_DISPATCH_GROUP, 0);
+			CiphFree(Batch.Prevs);
+			return;
+		}
+	}
+
+	AesCbcDecryptBlocks(pContext, in, cbIn, IV, out);
+
+	return;
+}
+
+// AesCtrCryptDispatch ֐
+// ReLXgp CTR ɂÍ / s (Offset  AesCtrCryptBlocks Ɠ)
+// ͂̃oCgɉāA1 ubN̏AAesCtrCryptBlocks (ݏ)AXbhv[ł̕񏈗I
+VOID WINAPI AesCtrCryptDispatch(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out)
+{
+	AES_DISPATCH_BATCH Batch;
+	BYTE Stream[16], CB[16];
+	DWORD dwMode, cbSkip = (DWORD)(Offset % 16), cbCurrent, cbChunk;
+
+	Batch.pContext = pContext;
+	Batch.in = in;
+	Batch.cbIn = cbIn;
+	Batch.out = out;
+	Batch.ICV = ICV;
+	Batch.Offset = Offset;
+	dwMode = SelectDispatch(DISPATCH_AES_CTR, cbIn, 16 * AES_INTERLEAVE_BLOCKS);
+
+	if (dwMode == DISPATCH_SERIAL)
+	{
+		AesCtrCounter(ICV, Offset, CB);
+		for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += cbChunk)
+		{
+			AesEncryptBlocks(pContext, CB, Stream, 1);
+			Increment128(CB);
+			cbChunk = 16 - cbSkip < cbIn - cbCurrent ? 16 - cbSkip : cbIn - cbCurrent;
+			Xor(&in[cbCurrent], &Stream[cbSkip], cbChunk, &out[cbCurrent]);
+			cbSkip = 0;
+		}
+		SecureZeroMemory(Stream, sizeof(Stream));
+	}
+	else if (dwMode == DISPATCH_THREADED)
+	{
+		RunParallelEx(AesCtrWorker, &Batch, cbIn / AES_DISPATCH_GROUP + (cbIn % AES_DISPATCH_GROUP != 0 ? 1 : 0), AES_DISPATCH_GROUP, 0);
+	}
+	else
+	{
+		AesCtrCryptBlocks(pContext, in, cbIn, ICV, Offset, out);
+	}
+
+	return;
+}
+
+// CTR_DRBG (SP 800-90A) 
+// Ql
+// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-90Ar1.pdf
+// o֐ (derivation function) ͎gpAGgs[ seedlen ( + 16) oCg̊SȃGgs[擾
+
+// OsEntropySource ֐
+// OS ̗ (CiphRandom) Ggs[Ƃ
+BOOL WINAPI OsEntropySource(PVOID pParam, BYTE* out, DWORD cbOut)
+{
+	(VOID)pParam;
+
+	return CiphRandom(out, cbOut);
+}
+
+// CtrDrbgUpdate ֐
+// CTR_DRBG_Update : temp = E(V+1) || E(V+2) || ... ̐擪 seedlen oCg provided_data  XOR AKey  V XV
+// provided_data  NULL ̏ꍇ 0 Ƃ݂Ȃ
+VOID WINAPI CtrDrbgUpdate(AES_CTR_DRBG_CONTEXT* pContext, BYTE* ProvidedData)
+{
+	BYTE Temp[48], Key[32];
+	DWORD cbKey = pContext->cbSeed - 16;
+
+	AesCtrKeystream(&pContext->Key, pContext->V, Temp, (pContext->cbSeed + 15) / 16);
+	if (ProvidedData != NULL)
+	{
+		Xor(Temp, ProvidedData, pContext->cbSeed, Temp);
+	}
+
+	memcpy(Key, Temp, cbKey);
+	memcpy(pContext->V, &Temp[cbKey], 16);
+	Increment128(pContext->V);
+	AesKeySetup(Key, pContext->BitLength, &pContext->Key);
+
+	SecureZeroMemory(Temp, sizeof(Temp));
+	SecureZeroMemory(Key, sizeof(Key));
+
+	return;
+}
+
+// CtrDrbgSeed ֐
+// Ggs[ seedlen oCg擾A (personalization string ܂ additional input)  XOR  Update 
+BOOL WINAPI CtrDrbgSeed(AES_CTR_DRBG_CONTEXT* pContext, BYTE* Input, DWORD cbInput)
+{
+	BYTE SeedMaterial[48];
+
+	if (cbInput > pContext->cbSeed)
+	{
+		return FALSE;
+	}
+	if (!pContext->GetEntropy(pContext->pEntropyParam, SeedMaterial, pContext->cbSeed))
+	{
+		return FALSE;
+	}
+	if (Input != NULL)
+	{
+		Xor(SeedMaterial, Input, cbInput, SeedMaterial);
+	}
+
+	CtrDrbgUpdate(pContext, SeedMaterial);
+	pContext->ReseedCounter = 1;
+	SecureZeroMemory(SeedMaterial, sizeof(SeedMaterial));
+
+	return TRUE;
+}
+
+// AesCtrDrbgInstantiate ֐
+// CTR_DRBG ̃CX^X쐬
+// GetEntropy  NULL ̏ꍇ OS ̗Ggs[Ƃ
+// Personalization  seedlen oCgȉ (NULL łǂ)
+// CX^X̓XbhԂŋLAXbhɍ쐬 (bN͎gpȂ)
+BOOL WINAPI AesCtrDrbgInstantiate(AES_CTR_DRBG_CONTEXT* pContext, AESBitLength BitLength, DRBG_ENTROPY_SOURCE GetEntropy, PVOID pEntropyParam, BYTE* Personalization, DWORD cbPersonalization, BOOL bPredictionResistance)
+{
+	BYTE Zero[32] = { 0 };
+
+	pContext->BitLength = BitLength;
+	pContext->cbSeed = KeyTable[BitLength] * 4 + 16;
+	pContext->bPredictionResistance = bPredictionResistance;
+	pContext->GetEntropy = GetEntropy != NULL ? GetEntropy : OsEntropySource;
+	pContext->pEntropyParam = pEntropyParam;
+
+	AesKeySetup(Zero, BitLength, &pContext->Key);
+	ZeroMemory(pContext->V, 16);
+	pContext->V[15] = 1;
+
+	return CtrDrbgSeed(pContext, Personalization, cbPersonalization);
+}
+
+// AesCtrDrbgReseed ֐
+// Ggs[ăV[hBAddInput  seedlen oCgȉ (NULL łǂ)
+BOOL WINAPI AesCtrDrbgReseed(AES_CTR_DRBG_CONTEXT* pContext, BYTE* AddInput, DWORD cbAddInput)
+{
+	return CtrDrbgSeed(pContext, AddInput, cbAddInput);
+}
+
+// CtrDrbgGenerateRequest ֐
+// 1 ̗v (AES_CTR_DRBG_MAX_REQUEST oCgȉ) ̗𐶐
+// o̓obt@ɒڃL[Xg[oAŌ̕sSȃubN̂ݍƗ̈gp
+BOOL WINAPI CtrDrbgGenerateRequest(AES_CTR_DRBG_CONTEXT* pContext, BYTE* out, DWORD cbOut, BYTE* AddInput, DWORD cbAddInput)
+{
+	DWORD nBlocks = cbOut / 16, cbRemain = cbOut % 16;
+	BYTE Padded[48], Last[16];
+
+	if (pContext->bPredictionResistance || pContext->ReseedCounter > AES_CTR_DRBG_RESEED_INTERVAL)
+	{
+		if (!CtrDrbgSeed(pContext, AddInput, cbAddInput))
+		{
+			return FALSE;
+		}
+		AddInput = NULL;
+		cbAddInput = 0;
+	}
+
+	ZeroMemory(Padded, sizeof(Padded));
+	if (AddInput != NULL && cbAddInput != 0)
+	{
+		memcpy(Padded, AddInput, cbAddInput);
+		CtrDrbgUpdate(pContext, Padded);
+	}
+
+	AesCtrKeystream(&pContext->Key, pContext->V, out, nBlocks);
+	if (cbRemain != 0)
+	{
+		AesCtrKeystream(&pContext->Key, pContext->V, Last, 1);
+		memcpy(&out[16 * nBlocks], Last, cbRemain);
+		SecureZeroMemory(Last, 16);
+	}
+
+	CtrDrbgUpdate(pContext, Padded);
+	pContext->ReseedCounter++;
+
+	return TRUE;
+}
+
+// AesCtrDrbgGenerate ֐
+// cbOut oCg̗𐶐BAddInput  seedlen oCgȉ (NULL łǂ)
+// 傫ȗv AES_CTR_DRBG_MAX_REQUEST oCg̗vɕ
+// ev̏o͂̓Ch CTR J[l (AesCtrKeystream) ŏo̓obt@ɒڏo
+BOOL WINAPI AesCtrDrbgGenerate(AES_CTR_DRBG_CONTEXT* pContext, BYTE* out, SIZE_T cbOut, BYTE* AddInput, DWORD cbAddInput)
+{
+	DWORD cbCurrent;
+
+	if (cbAddInput > pContext->cbSeed)
+	{
+		return FALSE;
+	}
+
+	do
+	{
+		cbCurrent = cbOut < AES_CTR_DRBG_MAX_REQUEST ? (DWORD)cbOut : AES_CTR_DRBG_MAX_REQUEST;
+		if (!CtrDrbgGenerateRequest(pContext, out, cbCurrent, AddInput, cbAddInput))
+		{
+			return FALSE;
+		}
+		out += cbCurrent;
+		cbOut -= cbCurrent;
+	} while (cbOut != 0);
+
+	return TRUE;
+}
+
+// AesCtrDrbgUninstantiate ֐
+// CX^X̓Ԃ
+VOID WINAPI AesCtrDrbgUninstantiate(AES_CTR_DRBG_CONTEXT* pContext)
+{
+	SecureZeroMemory(pContext, sizeof(AES_CTR_DRBG_CONTEXT));
+
+	return;
+}
+
+// AesRandomBytes ֐
+// Xbh CTR_DRBG (AES-256) pė𐶐
+// CX^X thread_local ŊeXbh 1 Aŏ̌Ăяo OS ̃Ggs[ō쐬
+// XbhԂŏԂLȂ߁AbNȂŕsɌĂяo
+BOOL WINAPI AesRandomBytes(BYTE* out, SIZE_T cbOut)
+{
+	static thread_local AES_CTR_DRBG_CONTEXT Context;
+	static thread_local BOOL bInstantiated = FALSE;
+
+	if (!bInstantiated)
+	{
+		if (!AesCtrDrbgInstantiate(&Context, AES256, NULL, NULL, NULL, 0, FALSE))
+		{
+			return FALSE;
+		}
+		bInstantiated = TRUE;
+	}
+
+	return AesCtrDrbgGenerate(&Context, out, cbOut, NULL, 0);
+}
+
+// ێÍ (Format-Preserving Encryption : FF1, FF3-1)
+// Ql
+// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-38Gr1-draft.pdf
+// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-38G.pdf
+//  radix (2 ` 65536) ̐ (numeral) ̗AE̗̐ɈÍ
+// ̗ WORD ̔zŕ\AX[0] ŏʂ̐Ƃ
+
+// ꊇœɐi߂郌R[h
+#define FPE_LANES 8
+
+// FpeNumRadix ֐
+// ̗ X (m )  radix ̐Ƃ cbOut oCg̃rbOGfBAɕϊ (NUM_radix)
+// bReverse  TRUE ̏ꍇ X[m-1] ŏʂƂ (FF3-1  NUM_radix(REV(X)))
+VOID WINAPI FpeNumRadix(WORD* X, DWORD m, DWORD dwRadix, BOOL bReverse, BYTE* out, DWORD cbOut)
+{
+	DWORD i, Carry;
+	INT j;
+
+	ZeroMemory(out, cbOut);
+	for (i = 0; i < m; i++)
+	{
+		Carry = X[bReverse ? m - 1 - i : i];
+		for (j = (INT)cbOut - 1; j >= 0; j--)
+		{
+			Carry += out[j] * dwRadix;
+			out[j] = (BYTE)Carry;
+			Carry >>= 8;
+		}
+	}
+
+	return;
+}
+
+// FpeDivRadix ֐
+// rbOGfBA̐ y  radix Ŋ (̏ŏɒu)A]Ԃ
+DWORD WINAPI FpeDivRadix(BYTE* y, DWORD cb, DWORD dwRadix)
+{
+	DWORD i, Remainder = 0;
+
+	for (i = 0; i < cb; i++)
+	{
+		Remainder = (Remainder << 8) | y[i];
+		y[i] = (BYTE)(Remainder / dwRadix);
+		Remainder %= dwRadix;
+	}
+
+	return Remainder;
+}
+
+// FpeAddDigits ֐
+// X (m ̐)  (X } y) mod radix^m ɒu
+// y mod radix^m ʂ̐ 1 oAɉZ (Z) 邽߁A{̏Z]͕KvȂ
+// bReverse  FALSE ̏ꍇ X[m-1] ATRUE ̏ꍇ X[0] ŉʂ̐
+VOID WINAPI FpeAddDigits(WORD* X, DWORD m, DWORD dwRadix, BOOL bReverse, BYTE* y, DWORD cbY, BOOL bSubtract)
+{
+	DWORD i, k, Digit, Carry = 0;
+
+	for (i = 0; i < m; i++)
+	{
+		k = bReverse ? i : m - 1 - i;
+		Digit = FpeDivRadix(y, cbY, dwRadix) + Carry;
+		if (bSubtract)
+		{
+			Carry = X[k] < Digit ? 1 : 0;
+			X[k] = (WORD)(X[k] + Carry * dwRadix - Digit);
+		}
+		else
+		{
+			Carry = X[k] + Digit >= dwRadix ? 1 : 0;
+			X[k] = (WORD)(X[k] + Digit - Carry * dwRadix);
+		}
+	}
+
+	return;
+}
+
+// FpeMinLength ֐
+// radix^minlen >= 1000000 ƂȂŏ̒ (2 ȏ) Ԃ
+DWORD WINAPI FpeMinLength(DWORD dwRadix)
+{
+	DWORD dwMinLen = 0;
+	ULONG64 Value = 1;
+
+	while (Value < 1000000 || dwMinLen < 2)
+	{
+		Value *= dwRadix;
+		dwMinLen++;
+	}
+
+	return dwMinLen;
+}
+
+// FpeCheckNumerals ֐
+// Ɗe͈͓̔ł邱ƂmF
+BOOL WINAPI FpeCheckNumerals(WORD* X, DWORD n, DWORD dwRadix, DWORD dwMinLen, DWORD dwMaxLen)
+{
+	DWORD i;
+
+	if (n < dwMinLen || dwMaxLen < n)
+	{
+		return FALSE;
+	}
+	for (i = 0; i < n; i++)
+	{
+		if (X[i] >= dwRadix)
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+// AesFf1Init ֐
+// FF1 ̃ReLXg쐬
+BOOL WINAPI AesFf1Init(BYTE* Key, AESBitLength BitLength, DWORD dwRadix, BYTE* Tweak, DWORD cbTweak, AES_FF1_CONTEXT* pContext)
+{
+	DWORD n, u, v, i, j, Bits, Carry;
+	BYTE Power[FPE_MAX_LEN * 2 + 1], P[16], Block[16];
+	FF1_LENGTH_PARAM* pParam;
+
+	if (dwRadix < 2 || 65536 < dwRadix || FF1_MAX_TWEAK < cbTweak)
+	{
+		return FALSE;
+	}
+
+	AesKeySetup(Key, BitLength, &pContext->Key);
+	pContext->dwRadix = dwRadix;
+	pContext->dwMinLen = FpeMinLength(dwRadix);
+	ZeroMemory(pContext->Tweak, FF1_MAX_TWEAK);
+	//  Tweak  NULL œn邱Ƃ
+	if (cbTweak != 0)
+	{
+		memcpy(pContext->Tweak, Tweak, cbTweak);
+	}
+	pContext->cbTweak = cbTweak;
+
+	for (n = pContext->dwMinLen; n <= FPE_MAX_LEN; n++)
+	{
+		pParam = &pContext->Params[n];
+		u = n / 2;
+		v = n - u;
+
+		// ceil(v * log2(radix))  radix^v - 1 ̃rbgɓ
+		ZeroMemory(Power, sizeof(Power));
+		Power[sizeof(Power) - 1] = 1;
+		for (i = 0; i < v; i++)
+		{
+			Carry = 0;
+			for (j = sizeof(Power); j > 0; j--)
+			{
+				Carry += Power[j - 1] * dwRadix;
+				Power[j - 1] = (BYTE)Carry;
+				Carry >>= 8;
+			}
+		}
+		for (j = sizeof(Power); j > 0 && Power[j - 1]-- == 0; j--)
+		{
+		}
+		for (i = 0; i < sizeof(Power) && Power[i] == 0; i++)
+		{
+		}
+		Bits = i < sizeof(Power) ? 8 * (sizeof(Power) - i) : 0;
+		for (j = 0x80; i < sizeof(Power) && (Power[i] & j) == 0; j >>= 1)
+		{
+			Bits--;
+		}
+
+		pParam->b = (WORD)((Bits + 7) / 8);
+		pParam->d = (WORD)(4 * ((pParam->b + 3) / 4) + 4);
+		pParam->cbQ = (WORD)(cbTweak + (16 - (cbTweak + pParam->b + 1) % 16) % 16 + 1 + pParam->b);
+		pParam->cbFixed = (WORD)(16 * ((pParam->cbQ - 1 - pParam->b) / 16));
+
+		// P = [1]1 || [2]1 || [1]1 || [radix]3 || [10]1 || [u mod 256]1 || [n]4 || [t]4
+		P[0] = 1;
+		P[1] = 2;
+		P[2] = 1;
+		P[3] = (BYTE)(dwRadix >> 16);
+		P[4] = (BYTE)(dwRadix >> 8);
+		P[5] = (BYTE)dwRadix;
+		P[6] = 10;
+		P[7] = (BYTE)u;
+		for (i = 0; i < 4; i++)
+		{
+			P[8 + i] = (BYTE)(n >> (24 - 8 * i));
+			P[12 + i] = (BYTE)(cbTweak >> (24 - 8 * i));
+		}
+
+		AesEncryptBlocks(&pContext->Key, P, pParam->Prefix, 1);
+		for (i = 0; i < pParam->cbFixed; i += 16)
+		{
+			ZeroMemory(Block, 16);
+			if (i < cbTweak)
+			{
+				memcpy(Block, &Tweak[i], cbTweak - i < 16 ? cbTweak - i : 16);
+			}
+			Xor(pParam->Prefix, Block, 16, Block);
+			AesEncryptBlocks(&pContext->Key, Block, pParam->Prefix, 1);
+		}
+	}
+
+	return TRUE;
+}
+
+// FF1 ̈ꊇ̃[̏
+typedef struct
+{
+	WORD Halves[2][FPE_MAX_LEN];
+	WORD* A;
+	WORD* B;
+	DWORD cbA;       // A ̐
+	DWORD cbB;       // B ̐
+	DWORD n;
+	DWORD nTail;     // eEh CBC-MAC Ɏ荞 Q ̎c̃ubN
+	DWORD nS;        // S ̃ubN ceil(d / 16)
+	BYTE Tail[16 * 18];
+	BYTE X[16];      // CBC-MAC ̏
+} FF1_LANE;
+
+// Ff1ProcessGroup ֐
+// ő FPE_LANES ̃R[h 10 Eh 1 Ehď
+// eEh CBC-MAC ̊eXebvƁAS L CIPH(R ^ [j]) ̑SubNAꂼ 1 x AesEncryptBlocks ŏ
+VOID WINAPI Ff1ProcessGroup(AES_FF1_CONTEXT* pContext, FF1_LANE* Lanes, DWORD nLanes, BOOL bEncrypt)
+{
+	DWORD r, i, j, k, s, m, nBlocks, nMaxTail, cbFixedTail;
+	BYTE Blocks[16 * 17 * FPE_LANES], y[264];
+	FF1_LENGTH_PARAM* pParam;
+	FF1_LANE* pLane;
+	WORD* pTemp;
+
+	for (r = 0; r < 10; r++)
+	{
+		i = bEncrypt ? r : 9 - r;
+		nMaxTail = 0;
+
+		// Q ̎c = (T || 0^pad) ̎c || [i]1 || [NUM_radix(B)]b
+		for (k = 0; k < nLanes; k++)
+		{
+			pLane = &Lanes[k];
+			pParam = &pContext->Params[pLane->n];
+			cbFixedTail = pParam->cbQ - 1 - pParam->b - pParam->cbFixed;
+
+			ZeroMemory(pLane->Tail, sizeof(pLane->Tail));
+			if (pParam->cbFixed < pContext->cbTweak)
+			{
+				memcpy(pLane->Tail, &pContext->Tweak[pParam->cbFixed], pContext->cbTweak - pParam->cbFixed);
+			}
+			pLane->Tail[cbFixedTail] = (BYTE)i;
+			FpeNumRadix(bEncrypt ? pLane->B : pLane->A, bEncrypt ? pLane->cbB : pLane->cbA, pContext->dwRadix, FALSE, &pLane->Tail[cbFixedTail + 1], pParam->b);
+
+			pLane->nTail = (pParam->cbQ - pParam->cbFixed) / 16;
+			pLane->nS = (pParam->d + 15) / 16;
+			memcpy(pLane->X, pParam->Prefix, 16);
+			if (pLane->nTail > nMaxTail)
+			{
+				nMaxTail = pLane->nTail;
+			}
+		}
+
+		// R = PRF(P || Q) : S[ CBC-MAC  1 ubNĐi߂
+		for (s = 0; s < nMaxTail; s++)
+		{
+			nBlocks = 0;
+			for (k = 0; k < nLanes; k++)
+			{
+				if (s < Lanes[k].nTail)
+				{
+					Xor(Lanes[k].X, &Lanes[k].Tail[16 * s], 16, &Blocks[16 * nBlocks++]);
+				}
+			}
+			AesEncryptBlocks(&pContext->Key, Blocks, Blocks, nBlocks);
+			nBlocks = 0;
+			for (k = 0; k < nLanes; k++)
+			{
+				if (s < Lanes[k].nTail)
+				{
+					memcpy(Lanes[k].X, &Blocks[16 * nBlocks++], 16);
+				}
+			}
+		}
+
+		// S = R || CIPH(R ^ [1]16) || CIPH(R ^ [2]16) || ... : S[̐LubN܂Ƃ߂ĈÍ
+		nBlocks = 0;
+		for (k = 0; k < nLanes; k++)
+		{
+			for (j = 1; j < Lanes[k].nS; j++)
+			{
+				memcpy(&Blocks[16 * nBlocks], Lanes[k].X, 16);
+				Blocks[16 * nBlocks + 15] ^= (BYTE)j;
+				nBlocks++;
+			}
+		}
+		AesEncryptBlocks(&pContext->Key, Blocks, Blocks, nBlocks);
+
+		// c = (NUM_radix(A) } y) mod radix^m
+		nBlocks = 0;
+		for (k = 0; k < nLanes; k++)
+		{
+			pLane = &Lanes[k];
+			pParam = &pContext->Params[pLane->n];
+			memcpy(y, pLane->X, 16);
+			memcpy(&y[16], &Blocks[16 * nBlocks], 16 * (pLane->nS - 1));
+			nBlocks += pLane->nS - 1;
+
+			m = i % 2 == 0 ? pLane->n / 2 : pLane->n - pLane->n / 2;
+			if (bEncrypt)
+			{
+				// C = STR(NUM(A) + y), A = B, B = C
+				FpeAddDigits(pLane->A, m, pContext->dwRadix, FALSE, y, pParam->d, FALSE);
+				pTemp = pLane->A;
+				pLane->A = pLane->B;
+				pLane->B = pTemp;
+				pLane->cbA = pLane->cbB;
+				pLane->cbB = m;
+			}
+			else
+			{
+				// C = STR(NUM(B) - y), B = A, A = C
+				FpeAddDigits(pLane->B, m, pContext->dwRadix, FALSE, y, pParam->d, TRUE);
+				pTemp = pLane->B;
+				pLane->B = pLane->A;
+				pLane->A = pTemp;
+				pLane->cbB = pLane->cbA;
+				pLane->cbA = m;
+			}
+		}
+	}
+
+	SecureZeroMemory(Blocks, sizeof(Blocks));
+	SecureZeroMemory(y, sizeof(y));
+
+	return;
+}
+
+// Ff1ProcessBatch ֐
+// nRecords ̃R[h FPE_LANES ܂Ƃ߂ FF1 ňÍ / 
+// ␔sȃR[h܂܂ꍇ͉ FALSE Ԃ
+BOOL WINAPI Ff1ProcessBatch(AES_FF1_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out, BOOL bEncrypt)
+{
+	DWORD i, k, nLanes, u;
+	FF1_LANE* Lanes;
+
+	for (i = 0; i < nRecords; i++)
+	{
+		if (!FpeCheckNumerals(in[i], n[i], pContext->dwRadix, pContext->dwMinLen, FPE_MAX_LEN))
+		{
+			return FALSE;
+		}
+	}
+
+	Lanes = (FF1_LANE*)CiphAlloc(sizeof(FF1_LANE) * FPE_LANES);
+
+	for (i = 0; i < nRecords; i += nLanes)
+	{
+		nLanes = nRecords - i < FPE_LANES ? nRecords - i : FPE_LANES;
+
+		// A = X[0..u), B = X[u..n)
+		for (k = 0; k < nLanes; k++)
+		{
+			u = n[i + k] / 2;
+			Lanes[k].n = n[i + k];
+			Lanes[k].A = Lanes[k].Halves[0];
+			Lanes[k].B = Lanes[k].Halves[1];
+			Lanes[k].cbA = u;
+			Lanes[k].cbB = n[i + k] - u;
+			memcpy(Lanes[k].A, in[i + k], sizeof(WORD) * u);
+			memcpy(Lanes[k].B, &in[i + k][u], sizeof(WORD) * (n[i + k] - u));
+		}
+
+		Ff1ProcessGroup(pContext, Lanes, nLanes, bEncrypt);
+
+		for (k = 0; k < nLanes; k++)
+		{
+			memcpy(out[i + k], Lanes[k].A, sizeof(WORD) * Lanes[k].cbA);
+			memcpy(&out[i + k][Lanes[k].cbA], Lanes[k].B, sizeof(WORD) * Lanes[k].cbB);
+		}
+	}
+
+	SecureZeroMemory(Lanes, sizeof(FF1_LANE) * FPE_LANES);
+	CiphFree(Lanes);
+
+	return TRUE;
+}
+
+// AesFf1Encrypt ֐
+// FF1 p n ̗̐Í (in  out ͓łǂ)
+// 
+//   A = X[0..u), B = X[u..n)
+//   for i = 0 to 9 :
+//     Q = T || 0^pad || [i]1 || [NUM_radix(B)]b
+//     R = PRF(P || Q) (CIPH_K ɂ CBC-MAC)
+//     S = R || CIPH_K(R ^ [1]16) || ... ̐擪 d oCg, y = NUM(S)
+//     C = STR^m_radix((NUM_radix(A) + y) mod radix^m), A = B, B = C
+//   Y = A || B
+// 
+BOOL WINAPI AesFf1Encrypt(AES_FF1_CONTEXT* pContext, WORD* in, DWORD n, WORD* out)
+{
+	return Ff1ProcessBatch(pContext, &in, &n, 1, &out, TRUE);
+}
+
+// AesFf1Decrypt ֐
+// FF1 p n ̗̐𕡍
+BOOL WINAPI AesFf1Decrypt(AES_FF1_CONTEXT* pContext, WORD* in, DWORD n, WORD* out)
+{
+	return Ff1ProcessBatch(pContext, &in, &n, 1, &out, FALSE);
+}
+
+// AesFf1EncryptBatch ֐
+// FF1 p nRecords ̃R[h (in[i]  n[i] ̐) ꊇňÍ
+// قȂ郌R[h Feistel Eh͓ƗĂ邽߁AFPE_LANES Eh𑵂ĕubN AES ŏ
+BOOL WINAPI AesFf1EncryptBatch(AES_FF1_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out)
+{
+	return Ff1ProcessBatch(pContext, in, n, nRecords, out, TRUE);
+}
+
+// AesFf1DecryptBatch ֐
+// FF1 p nRecords ̃R[hꊇŕ
+BOOL WINAPI AesFf1DecryptBatch(AES_FF1_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out)
+{
+	return Ff1ProcessBatch(pContext, in, n, nRecords, out, FALSE);
+}
+
+// FpeMaxLengthFf3 ֐
+// FF3-1 ̍ő̒ 2 * floor(log_radix(2^96)) Ԃ (FPE_MAX_LEN Ƃ)
+// radix^h  13 oCg̐ŌvZA2^96 𒴂Ȃő h 𐔂
+DWORD WINAPI FpeMaxLengthFf3(DWORD dwRadix)
+{
+	BYTE Power[13] = { 0 };
+	DWORD j, Carry, dwHalf = 0;
+
+	Power[12] = 1;
+	for (;;)
+	{
+		Carry = 0;
+		for (j = 13; j > 0; j--)
+		{
+			Carry += Power[j - 1] * dwRadix;
+			Power[j - 1] = (BYTE)Carry;
+			Carry >>= 8;
+		}
+		// 2^96  Power[0] = 1 Ŏc肪S 0 ̒l
+		for (j = 1; j < 13 && Power[j] == 0; j++)
+		{
+		}
+		if (Carry != 0 || Power[0] > 1 || (Power[0] == 1 && j < 13))
+		{
+			break;
+		}
+		dwHalf++;
+	}
+
+	return 2 * dwHalf < FPE_MAX_LEN ? 2 * dwHalf : FPE_MAX_LEN;
+}
+
+// AesFf3Init ֐
+// FF3-1 ̃ReLXg쐬BTweak  7 oCg (56 rbg)
+BOOL WINAPI AesFf3Init(BYTE* Key, AESBitLength BitLength, DWORD dwRadix, BYTE* Tweak, AES_FF3_CONTEXT* pContext)
+{
+	DWORD i, cbKey = KeyTable[BitLength] * 4;
+	BYTE RevKey[32];
+
+	if (dwRadix < 2 || 65536 < dwRadix)
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i < cbKey; i++)
+	{
+		RevKey[i] = Key[cbKey - 1 - i];
+	}
+	AesKeySetup(RevKey, BitLength, &pContext->Key);
+	SecureZeroMemory(RevKey, sizeof(RevKey));
+
+	pContext->dwRadix = dwRadix;
+	pContext->dwMinLen = FpeMinLength(dwRadix);
+
+	pContext->dwMaxLen = FpeMaxLengthFf3(dwRadix);
+
+	// T_L = T[0..27] || 0^4, T_R = T[32..55] || T[28..31] || 0^4
+	memcpy(pContext->TL, Tweak, 3);
+	pContext->TL[3] = Tweak[3] & 0xF0;
+	memcpy(pContext->TR, &Tweak[4], 3);
+	pContext->TR[3] = (BYTE)((Tweak[3] & 0x0F) << 4);
+
+	return TRUE;
+}
+
+// Ff3ProcessBatch ֐
+// nRecords ̃R[h FF3-1 ňÍ / 
+// eEh 1 ubN AES ݂̂̂߁AFPE_LANES ̃R[h̓Eh 1 x AesEncryptBlocks ŏ
+BOOL WINAPI Ff3ProcessBatch(AES_FF3_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out, BOOL bEncrypt)
+{
+	DWORD i, j, k, r, rnd, m, u, nLanes;
+	BYTE Blocks[16 * FPE_LANES], y[16];
+	WORD* A[FPE_LANES], * B[FPE_LANES], * pTemp;
+	WORD(*Halves)[2][FPE_MAX_LEN];
+	BYTE* W;
+
+	for (i = 0; i < nRecords; i++)
+	{
+		if (!FpeCheckNumerals(in[i], n[i], pContext->dwRadix, pContext->dwMinLen, pContext->dwMaxLen))
+		{
+			return FALSE;
+		}
+	}
+
+	Halves = (WORD(*)[2][FPE_MAX_LEN])CiphAlloc(sizeof(WORD) * 2 * FPE_MAX_LEN * FPE_LANES);
+
+	for (i = 0; i < nRecords; i += nLanes)
+	{
+		nLanes = nRecords - i < FPE_LANES ? nRecords - i : FPE_LANES;
+
+		// A = X[0..u), B = X[u..n) (u = ceil(n / 2))
+		for (k = 0; k < nLanes; k++)
+		{
+			u = (n[i + k] + 1) / 2;
+			A[k] = Halves[k][0];
+			B[k] = Halves[k][1];
+			memcpy(A[k], in[i + k], sizeof(WORD) * u);
+			memcpy(B[k], &in[i + k][u], sizeof(WORD) * (n[i + k] - u));
+		}
+
+		for (r = 0; r < 8; r++)
+		{
+			rnd = bEncrypt ? r : 7 - r;
+			W = rnd % 2 == 0 ? pContext->TR : pContext->TL;
+
+			// P = W ^ [i]4 || [NUM_radix(REV(B))]12  REVB ׂ̂
+			for (k = 0; k < nLanes; k++)
+			{
+				u = (n[i + k] + 1) / 2;
+				m = rnd % 2 == 0 ? u : n[i + k] - u;
+				memcpy(y, W, 4);
+				y[3] ^= (BYTE)rnd;
+				FpeNumRadix(bEncrypt ? B[k] : A[k], n[i + k] - m, pContext->dwRadix, TRUE, &y[4], 12);
+				for (j = 0; j < 16; j++)
+				{
+					Blocks[16 * k + j] = y[15 - j];
+				}
+			}
+
+			AesEncryptBlocks(&pContext->Key, Blocks, Blocks, nLanes);
+
+			// S = REVB(CIPH_REVB(K)(REVB(P))), c = (NUM_radix(REV(A)) } NUM(S)) mod radix^m
+			for (k = 0; k < nLanes; k++)
+			{
+				u = (n[i + k] + 1) / 2;
+				m = rnd % 2 == 0 ? u : n[i + k] - u;
+				for (j = 0; j < 16; j++)
+				{
+					y[j] = Blocks[16 * k + 15 - j];
+				}
+
+				if (bEncrypt)
+				{
+					FpeAddDigits(A[k], m, pContext->dwRadix, TRUE, y, 16, FALSE);
+					pTemp = A[k];
+					A[k] = B[k];
+					B[k] = pTemp;
+				}
+				else
+				{
+					FpeAddDigits(B[k], m, pContext->dwRadix, TRUE, y, 16, TRUE);
+					pTemp = B[k];
+					B[k] = A[k];
+					A[k] = pTemp;
+				}
+			}
+		}
+
+		for (k = 0; k < nLanes; k++)
+		{
+			u = (n[i + k] + 1) / 2;
+			memcpy(out[i + k], A[k], sizeof(WORD) * u);
+			memcpy(&out[i + k][u], B[k], sizeof(WORD) * (n[i + k] - u));
+		}
+	}
+
+	SecureZeroMemory(Blocks, sizeof(Blocks));
+	SecureZeroMemory(y, sizeof(y));
+	SecureZeroMemory(Halves, sizeof(WORD) * 2 * FPE_MAX_LEN * FPE_LANES);
+	CiphFree(Halves);
+
+	return TRUE;
+}
+
+// AesFf3Encrypt ֐
+// FF3-1 p n ̗̐Í (in  out ͓łǂ)
+// 
+//   A = X[0..u), B = X[u..n) (u = ceil(n / 2))
+//   for i = 0 to 7 :
+//     W = T_R (i ), T_L (i )
+//     P = W ^ [i]4 || [NUM_radix(REV(B))]12
+//     S = REVB(CIPH_REVB(K)(REVB(P))), y = NUM(S)
+//     C = REV(STR^m_radix((NUM_radix(REV(A)) + y) mod radix^m)), A = B, B = C
+//   Y = A || B
+// 
+BOOL WINAPI AesFf3Encrypt(AES_FF3_CONTEXT* pContext, WORD* in, DWORD n, WORD* out)
+{
+	return Ff3ProcessBatch(pContext, &in, &n, 1, &out, TRUE);
+}
+
+// AesFf3Decrypt ֐
+// FF3-1 p n ̗̐𕡍
+BOOL WINAPI AesFf3Decrypt(AES_FF3_CONTEXT* pContext, WORD* in, DWORD n, WORD* out)
+{
+	return Ff3ProcessBatch(pContext, &in, &n, 1, &out, FALSE);
+}
+
+// AesFf3EncryptBatch ֐
+// FF3-1 p nRecords ̃R[hꊇňÍ
+BOOL WINAPI AesFf3EncryptBatch(AES_FF3_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out)
+{
+	return Ff3ProcessBatch(pContext, in, n, nRecords, out, TRUE);
+}
+
+// AesFf3DecryptBatch ֐
+// FF3-1 p nRecords ̃R[hꊇŕ
+BOOL WINAPI AesFf3DecryptBatch(AES_FF3_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out)
+{
+	return Ff3ProcessBatch(pContext, in, n, nRecords, out, FALSE);
+}
+
+// AES DUKPT (Derived Unique Key Per Transaction)
+// Ql
+// ANSI X9.24-3-2017
+// 
+// KSN (12 oCg) ́A̎ʎq (BDK ID 4 oCg + o ID 4 oCg)  32 rbg̃gUNVJE^Ȃ
+// ̓óAhf[^ (16 oCg) 𓱏o AES Íčs ( 128 rbg𒴂ꍇ 2 ubN)
+// 
+//   hf[^ = Version (01) || Key Block Counter (01, 02) || Key Usage (2) || Algorithm (2) || Length (2) || Data (8)
+//   Data       = ̎ʎq (̓o)A܂͎ʎq̉E 4 oCg || JE^ (ȊO)
+// 
+// Ԃ̓óAJE^ 1 ̃rbgʂ珇ɉJE^gď珇ɓo
+// [̃JE^ 1 邽߁AAgUNV͏ʂ̃rbg̓rL
+// AES_DUKPT_CONTEXT ͂̓rrbgʒuɕێAOƈقȂrbg悾vZ
+
+// ̎ޖ̌ (rbg)
+const WORD AesDukptKeyBits[5] = { 128, 192, 128, 192, 256 };
+
+// AesDukptBdkSetup ֐
+// BDK ̌ReLXg쐬 (Ԃ̓o BDK ƓƂȂ)
+VOID WINAPI AesDukptBdkSetup(BYTE* Bdk, AESBitLength BitLength, AES_DUKPT_BDK_CONTEXT* pContext)
+{
+	AesEncryptKeySetup(Bdk, BitLength, &pContext->Bdk);
+	pContext->BitLength = BitLength;
+
+	return;
+}
+
+// AesDukptDerivationData ֐
+// hf[^쐬B 128 rbg𒴂ꍇ́AKey Block Counter  1, 2 Ƃ 2 ubNׂ
+// ߂l̓ubN
+DWORD WINAPI AesDukptDerivationData(DWORD dwUsage, DWORD dwKeyType, BYTE* InitialKeyId, DWORD dwCounter, BYTE* Data)
+{
+	DWORD i, nBlocks = (AesDukptKeyBits[dwKeyType] + 127) / 128;
+
+	for (i = 0; i < nBlocks; i++)
+	{
+		Data[16 * i + 0] = 0x01;
+		Data[16 * i + 1] = (BYTE)(i + 1);
+		Data[16 * i + 2] = (BYTE)(dwUsage >> 8);
+		Data[16 * i + 3] = (BYTE)dwUsage;
+		Data[16 * i + 4] = 0;
+		Data[16 * i + 5] = (BYTE)dwKeyType;
+		Data[16 * i + 6] = (BYTE)(AesDukptKeyBits[dwKeyType] >> 8);
+		Data[16 * i + 7] = (BYTE)AesDukptKeyBits[dwKeyType];
+		if (dwUsage == AES_DUKPT_USAGE_INITIAL_KEY)
+		{
+			memcpy(&Data[16 * i + 8], InitialKeyId, 8);
+		}
+		else
+		{
+			memcpy(&Data[16 * i + 8], &InitialKeyId[4], 4);
+			Data[16 * i + 12] = (BYTE)(dwCounter >> 24);
+			Data[16 * i + 13] = (BYTE)(dwCounter >> 16);
+			Data[16 * i + 14] = (BYTE)(dwCounter >> 8);
+			Data[16 * i + 15] = (BYTE)dwCounter;
+		}
+	}
+
+	return nBlocks;
+}
+
+// AesDukptDeriveWithKey ֐
+// o Key (BitLength) Ŕhf[^ÍAdwKeyType ̌ out Ɋi[
+VOID WINAPI AesDukptDeriveWithKey(BYTE* Key, AESBitLength BitLength, DWORD dwUsage, DWORD dwKeyType, BYTE* InitialKeyId, DWORD dwCounter, BYTE* out)
+{
+	DWORD nBlocks;
+	BYTE Data[32];
+	AES_KEY_CONTEXT Context;
+
+	nBlocks = AesDukptDerivationData(dwUsage, dwKeyType, InitialKeyId, dwCounter, Data);
+	AesEncryptKeySetup(Key, BitLength, &Context);
+	AesEncryptBlocks(&Context, Data, Data, nBlocks);
+	memcpy(out, Data, AesDukptKeyBits[dwKeyType] / 8);
+
+	SecureZeroMemory(&Context, sizeof(Context));
+	SecureZeroMemory(Data, 32);
+
+	return;
+}
+
+// AesDukptDeriveInitialKey ֐
+// BDK Ə̎ʎq (8 oCg) 珉𓱏o ( BDK Ɠ)
+VOID WINAPI AesDukptDeriveInitialKey(AES_DUKPT_BDK_CONTEXT* pBdk, BYTE* InitialKeyId, BYTE* InitialKey)
+{
+	DWORD dwKeyType = AES_DUKPT_KEY_AES128 + pBdk->BitLength;
+	BYTE Data[32];
+
+	AesDukptDerivationData(AES_DUKPT_USAGE_INITIAL_KEY, dwKeyType, InitialKeyId, 0, Data);
+	AesEncryptBlocks(&pBdk->Bdk, Data, Data, (AesDukptKeyBits[dwKeyType] + 127) / 128);
+	memcpy(InitialKey, Data, AesDukptKeyBits[dwKeyType] / 8);
+	SecureZeroMemory(Data, 32);
+
+	return;
+}
+
+// AesDukptInit ֐
+//  KSN (擪 8 oCg̎ʎq) [̓oԂ쐬
+VOID WINAPI AesDukptInit(BYTE* InitialKey, AESBitLength BitLength, BYTE* Ksn, AES_DUKPT_CONTEXT* pContext)
+{
+	memcpy(pContext->InitialKeyId, Ksn, 8);
+	memcpy(pContext->InitialKey, InitialKey, 4 * KeyTable[BitLength]);
+	pContext->BitLength = BitLength;
+	pContext->dwCounter = 0;
+	pContext->bCached = FALSE;
+
+	return;
+}
+
+// AesDukptCounter ֐
+// KSN ̉E 4 oCg̃gUNVJE^Ԃ
+DWORD WINAPI AesDukptCounter(BYTE* Ksn)
+{
+	return (DWORD)Ksn[8] << 24 | Ksn[9] << 16 | Ksn[10] << 8 | Ksn[11];
+}
+
+// AesDukptDeriveKey ֐
+// JE^ dwCounter ̗pr dwUsageA dwKeyType ̍ƌ𓱏oAKey (AesDukptKeyBits[dwKeyType] / 8 oCg) Ɋi[
+// ÕJE^Əʂ̃rbǵAێĂrĊJ
+VOID WINAPI AesDukptDeriveKey(AES_DUKPT_CONTEXT* pContext, DWORD dwCounter, DWORD dwUsage, DWORD dwKeyType, BYTE* Key)
+{
+	INT b;
+	DWORD dwDiff, dwWorking = 0;
+	DWORD dwDerivationType = AES_DUKPT_KEY_AES128 + pContext->BitLength;
+	BYTE* pCurrent = pContext->InitialKey;
+
+	// OƈقȂŏʂ̃rbǵAO̓r̂܂܎g
+	dwDiff = pContext->bCached ? dwCounter ^ pContext->dwCounter : 0xFFFFFFFF;
+
+	for (b = AES_DUKPT_COUNTER_BITS - 1; b >= 0; b--)
+	{
+		if ((dwCounter >> b & 1) == 0)
+		{
+			continue;
+		}
+
+		dwWorking |= 1UL << b;
+		if ((dwDiff >> b) != 0)
+		{
+			AesDukptDeriveWithKey(pCurrent, pContext->BitLength, AES_DUKPT_USAGE_KEY_DERIVATION, dwDerivationType, pContext->InitialKeyId, dwWorking, pContext->Keys[b]);
+		}
+		pCurrent = pContext->Keys[b];
+	}
+	pContext->dwCounter = dwCounter;
+	pContext->bCached = TRUE;
+
+	AesDukptDeriveWithKey(pCurrent, pContext->BitLength, dwUsage, dwKeyType, pContext->InitialKeyId, dwCounter, Key);
+
+	return;
+}
+
+// ꊇoŕבւ KSN ƁǍ̈ʒu
+typedef struct
+{
+	BYTE* Ksn;
+	DWORD dwIndex;
+} AES_DUKPT_BATCH_ITEM;
+
+// AesDukptCompareKsn ֐
+// KSN ̎ʎqAJE^̏ɕׂ邽߂̔r֐ ( KSN ͌̏ɕׂ)
+INT __cdecl AesDukptCompareKsn(CONST VOID* p1, CONST VOID* p2)
+{
+	CONST AES_DUKPT_BATCH_ITEM* pItem1 = (CONST AES_DUKPT_BATCH_ITEM*)p1;
+	CONST AES_DUKPT_BATCH_ITEM* pItem2 = (CONST AES_DUKPT_BATCH_ITEM*)p2;
+	INT nResult = memcmp(pItem1->Ksn, pItem2->Ksn, 12);
+
+	if (nResult == 0)
+	{
+		nResult = pItem1->dwIndex < pItem2->dwIndex ? -1 : pItem1->dwIndex > pItem2->dwIndex;
+	}
+
+	return nResult;
+}
+
+// AesDukptDeriveBatch ֐
+// nKsns  KSN (12 oCgׂ) ̍ƌ𓱏oAKeys  AesDukptKeyBits[dwKeyType] / 8 oCgi[
+// KSN בւē[̂̂אڂA͈قȂ[̔̕hf[^܂Ƃ߂ 1 x AesEncryptBlocks œo
+// [ KSN ̓JE^̏ AesDukptDeriveKey ŏAʂ̃rbg̓rL
+VOID WINAPI AesDukptDeriveBatch(AES_DUKPT_BDK_CONTEXT* pBdk, BYTE* Ksns, DWORD nKsns, DWORD dwUsage, DWORD dwKeyType, BYTE* Keys)
+{
+	DWORD i, j, nDevices = 0;
+	DWORD dwInitialType = AES_DUKPT_KEY_AES128 + pBdk->BitLength;
+	DWORD nBlocks = (AesDukptKeyBits[dwInitialType] + 127) / 128;
+	DWORD cbKey = AesDukptKeyBits[dwKeyType] / 8;
+	AES_DUKPT_BATCH_ITEM* Items;
+	BYTE* Data;
+	AES_DUKPT_CONTEXT* pContext;
+	BYTE InitialKey[32];
+
+	if (nKsns == 0)
+	{
+		return;
+	}
+
+	Items = (AES_DUKPT_BATCH_ITEM*)CiphAlloc(sizeof(AES_DUKPT_BATCH_ITEM) * nKsns);
+	Data = (BYTE*)CiphAlloc(32 * (SIZE_T)nKsns);
+	pContext = (AES_DUKPT_CONTEXT*)CiphAlloc(sizeof(AES_DUKPT_CONTEXT));
+
+	for (i = 0; i < nKsns; i++)
+	{
+		Items[i].Ksn = &Ksns[12 * (SIZE_T)i];
+		Items[i].dwIndex = i;
+	}
+	qsort(Items, nKsns, sizeof(AES_DUKPT_BATCH_ITEM), AesDukptCompareKsn);
+
+	// [̏̔hf[^ׂāA܂Ƃ߂ĈÍ
+	for (i = 0; i < nKsns; i++)
+	{
+		if (i == 0 || memcmp(Items[i].Ksn, Items[i - 1].Ksn, 8) != 0)
+		{
+			AesDukptDerivationData(AES_DUKPT_USAGE_INITIAL_KEY, dwInitialType, Items[i].Ksn, 0, &Data[16 * nBlocks * (SIZE_T)nDevices]);
+			nDevices++;
+		}
+	}
+	AesEncryptBlocks(&pBdk->Bdk, Data, Data, nBlocks * nDevices);
+
+	// [ɁAJE^̏ɓo
+	for (i = 0, j = 0; i < nKsns; i++)
+	{
+		if (i == 0 || memcmp(Items[i].Ksn, Items[i - 1].Ksn, 8) != 0)
+		{
+			memcpy(InitialKey, &Data[16 * nBlocks * (SIZE_T)j], 4 * KeyTable[pBdk->BitLength]);
+			AesDukptInit(InitialKey, pBdk->BitLength, Items[i].Ksn, pContext);
+			j++;
+		}
+		AesDukptDeriveKey(pContext, AesDukptCounter(Items[i].Ksn), dwUsage, dwKeyType, &Keys[cbKey * (SIZE_T)Items[i].dwIndex]);
+	}
+
+	SecureZeroMemory(InitialKey, 32);
+	SecureZeroMemory(Data, 32 * (SIZE_T)nKsns);
+	SecureZeroMemory(pContext, sizeof(AES_DUKPT_CONTEXT));
+	CiphFree(Items);
+	CiphFree(Data);
+	CiphFree(pContext);
+
+	return;
+}
+
+// l (KCV, Key Check Value)
+// 0 ̃ubNňÍʂ̐擪 (ʏ 3 oCg)
+// ƂɈÍubN 1 Ȃ̂ŁAWJ (KeyExpansion) ̕dȂ
+// AES-NI gpłꍇ 4 ̌̌WJƈÍ 1 ̃[vɂ܂Ƃ߁AWJEĥ܂ AESENC Ɏg
+
+
+// AesKcvBatch ֐
+// BitLength ̌ (4 * Nk oCg)  nKeys ׂ Keys  KCV AKcvs  cbKcv oCg (1 ` 16) i[
+// AES-NI gpłȂꍇ 4 ɖȂ[̌́AƂ AesEncryptKeySetup ŌWJĈÍ
+// cbKcv sȏꍇ FALSE Ԃ
+BOOL WINAPI AesKcvBatch(BYTE* Keys, AESBitLength BitLength, DWORD nKeys, BYTE* Kcvs, DWORD cbKcv)
+{
+	DWORD i = 0;
+	DWORD cbKey = 4 * KeyTable[BitLength];
+	BYTE Zero[16] = { 0 }, Block[64];
+	AES_KEY_CONTEXT Context;
+
+	if (cbKcv == 0 || cbKcv > 16)
+	{
+		return FALSE;
+	}
+
+#if defined(CIPH_X86)
+	if ((GetCpuFeatures() & (CPU_FEATURE_AESNI | CPU_FEATURE_SSSE3)) == (CPU_FEATURE_AESNI | CPU_FEATURE_SSSE3))
+	{
+		DWORD j;
+
+		for (; nKeys - i >= 4; i += 4)
+		{
+			AesNiKcvGroup(&Keys[cbKey * (SIZE_T)i], KeyTable[BitLength], RoundTable[BitLength], Block);
+			for (j = 0; j < 4; j++)
+			{
+				memcpy(&Kcvs[cbKcv * ((SIZE_T)i + j)], &Block[16 * j], cbKcv);
+			}
+		}
+	}
+#endif
+
+	for (; i < nKeys; i++)
+	{
+		AesEncryptKeySetup(&Keys[cbKey * (SIZE_T)i], BitLength, &Context);
+		AesEncryptBlocks(&Context, Zero, Block, 1);
+		memcpy(&Kcvs[cbKcv * (SIZE_T)i], Block, cbKcv);
+	}
+
+	SecureZeroMemory(&Context, sizeof(Context));
+	SecureZeroMemory(Block, sizeof(Block));
+
+	return TRUE;
+}
@@ -0,0 +1,323 @@
+#pragma once
+
+#include "CiphCommon.h"
+
+// AES (Advanced Encryption Standard) ɂÍ
+// e[h̏ CiphAes.cpp Q
+
+typedef enum
+{
+	AES128 = 0,
+	AES192,
+	AES256
+} AESBitLength;
+
+//  Nk, Nr ƁA𒼐ڎ󂯎郂[h֐ (AesEcbEncrypt Ȃ) gp錮
+extern AESBitLength CurrentAESBitLength;
+extern BYTE KeyTable[3];
+extern BYTE RoundTable[3];
+extern const DWORD RCon[11];
+
+BYTE WINAPI GFMultiplication(BYTE a, BYTE b);
+
+// AES ̌ReLXg
+// ǧʂێAŉxÍꍇ KeyExpansion ̍Ďs
+// CurrentAESBitLength ɂ͈ˑA (Nk) ƃEh (Nr) ReLXgg
+typedef struct
+{
+	DWORD W[60];  // Nb*(Nr+1)
+	DWORD DW[60]; // tÍ (Equivalent Inverse Cipher) p̃Eh
+	BYTE Nk;
+	BYTE Nr;
+} AES_KEY_CONTEXT;
+
+VOID WINAPI AesKeySetup(BYTE* Key, AESBitLength BitLength, AES_KEY_CONTEXT* pContext);
+VOID WINAPI AesEncryptKeySetup(BYTE* Key, AESBitLength BitLength, AES_KEY_CONTEXT* pContext);
+VOID WINAPI AesEncryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, DWORD nBlocks);
+VOID WINAPI AesDecryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, DWORD nBlocks);
+
+// ECB, CBC, CFB, OFB, CTR ( CurrentAESBitLength)
+VOID WINAPI AesEcbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out);
+VOID WINAPI AesEcbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out);
+VOID WINAPI AesCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out);
+VOID WINAPI AesCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out);
+
+#define AES_PADDING_NONE  0
+#define AES_PADDING_PKCS7 1
+#define AES_PADDING_CS1   2
+#define AES_PADDING_CS2   3
+#define AES_PADDING_CS3   4
+
+DWORD WINAPI AesGetOutputLength(DWORD cbIn, DWORD dwPadding);
+VOID WINAPI AesEcbEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out);
+BOOL WINAPI AesEcbDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key, BYTE* out, DWORD* pcbOut);
+VOID WINAPI AesCbcEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out);
+BOOL WINAPI AesCbcDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out, DWORD* pcbOut);
+BOOL WINAPI AesCbcEncryptCts(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, DWORD dwPadding, BYTE* out);
+BOOL WINAPI AesCbcDecryptCts(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, DWORD dwPadding, BYTE* out);
+
+// PKCS#7, Íގ (ReLXggp)
+VOID WINAPI AesEcbEncryptPkcs7Context(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out);
+BOOL WINAPI AesEcbDecryptPkcs7Context(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out, DWORD* pcbOut);
+VOID WINAPI AesCbcEncryptPkcs7Context(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out);
+BOOL WINAPI AesCbcDecryptPkcs7Context(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out, DWORD* pcbOut);
+BOOL WINAPI AesCbcEncryptCtsContext(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, DWORD dwPadding, BYTE* out);
+BOOL WINAPI AesCbcDecryptCtsContext(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, DWORD dwPadding, BYTE* out);
+VOID WINAPI AesCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE cbitSegment, BYTE* out);
+VOID WINAPI AesCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE cbitSegment, BYTE* out);
+VOID WINAPI AesOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* IV, BYTE* Key, BYTE* out);
+VOID WINAPI AesCtrEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* ICV, BYTE* Key, BYTE* out);
+
+// GCM (Galois/Counter Mode) ̃ReLXg
+// Ql
+// https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38d.pdf
+// https://csrc.nist.gov/CSRC/media/Projects/Block-Cipher-Techniques/documents/BCM/proposed-modes/gcm/gcm-spec.pdf
+typedef struct
+{
+	AES_KEY_CONTEXT Key;
+	BYTE H[16];          // nbV H = CIPH_K(0^128)
+	BYTE HPow[4][16];    // PCLMULQDQ p H^1 ` H^4 (oCg𔽓]\)
+	ULONG64 HL[16];      // 4 rbge[u (H  0 ` 15 ̐ς̉ 64 rbg)
+	ULONG64 HH[16];      // 4 rbge[u (H  0 ` 15 ̐ς̏ 64 rbg)
+	BOOL bClmul;         // PCLMULQDQ ɂ GHASH gp邩
+} AES_GCM_CONTEXT;
+
+VOID WINAPI AesGcmInit(BYTE* Key, AESBitLength BitLength, AES_GCM_CONTEXT* pContext);
+VOID WINAPI AesGcmEncrypt(AES_GCM_CONTEXT* pContext, BYTE* IV, DWORD cbIV, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Tag);
+BOOL WINAPI AesGcmDecrypt(AES_GCM_CONTEXT* pContext, BYTE* IV, DWORD cbIV, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* Tag, BYTE* out);
+
+// XTS-AES (IEEE 1619) ̃ReLXg
+// Ql
+// https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38e.pdf
+// f[^̈Íp̌ (Key1) ƒl (tweak) ̈Íp̌ (Key2)  2 ̌ReLXg
+typedef struct
+{
+	AES_KEY_CONTEXT DataKey;
+	AES_KEY_CONTEXT TweakKey;
+} AES_XTS_CONTEXT;
+
+VOID WINAPI AesXtsInit(BYTE* Key, AESBitLength BitLength, AES_XTS_CONTEXT* pContext);
+BOOL WINAPI AesXtsEncrypt(AES_XTS_CONTEXT* pContext, ULONG64 SectorNumber, BYTE* in, DWORD cbSector, BYTE* out);
+BOOL WINAPI AesXtsDecrypt(AES_XTS_CONTEXT* pContext, ULONG64 SectorNumber, BYTE* in, DWORD cbSector, BYTE* out);
+BOOL WINAPI AesXtsEncryptSectors(AES_XTS_CONTEXT* pContext, ULONG64 FirstSector, BYTE* in, DWORD cbSector, DWORD nSectors, BYTE* out, DWORD dwThreads);
+BOOL WINAPI AesXtsDecryptSectors(AES_XTS_CONTEXT* pContext, ULONG64 FirstSector, BYTE* in, DWORD cbSector, DWORD nSectors, BYTE* out, DWORD dwThreads);
+
+// OCB (RFC 7253) ̃ReLXg
+// Ql
+// https://www.rfc-editor.org/rfc/rfc7253
+// L_* = ENCIPHER(K, 0^128), L_$ = double(L_*), L_0 = double(L_$), L_i = double(L_{i-1}) OɌvZĂ
+// L_i  2^i ubNɂgȂ߁ADWORD ŕ\ubNɂ 32 Ώ\
+#define OCB_L_MAX 32
+
+typedef struct
+{
+	AES_KEY_CONTEXT Key;
+	BYTE LStar[16];
+	BYTE LDollar[16];
+	BYTE L[OCB_L_MAX][16];
+	DWORD cbTag; // F؃^ÕoCg (1 ` 16)
+} AES_OCB_CONTEXT;
+
+BOOL WINAPI AesOcbInit(BYTE* Key, AESBitLength BitLength, DWORD cbTag, AES_OCB_CONTEXT* pContext);
+BOOL WINAPI AesOcbEncrypt(AES_OCB_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Tag, DWORD dwThreads);
+BOOL WINAPI AesOcbDecrypt(AES_OCB_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* Tag, BYTE* out, DWORD dwThreads);
+
+// CCM (Counter with CBC-MAC) ̃ReLXg
+// Ql
+// https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38c.pdf
+typedef struct
+{
+	AES_KEY_CONTEXT Key;
+	DWORD cbTag; // F؃^ÕoCg (4, 6, 8, 10, 12, 14, 16)
+} AES_CCM_CONTEXT;
+
+BOOL WINAPI AesCcmInit(BYTE* Key, AESBitLength BitLength, DWORD cbTag, AES_CCM_CONTEXT* pContext);
+BOOL WINAPI AesCcmEncrypt(AES_CCM_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Tag);
+BOOL WINAPI AesCcmDecrypt(AES_CCM_CONTEXT* pContext, BYTE* Nonce, DWORD cbNonce, BYTE* AAD, DWORD cbAAD, BYTE* in, DWORD cbIn, BYTE* Tag, BYTE* out);
+
+// CMAC ̃ReLXg
+// Ql
+// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-38b.pdf
+// Tu K1, K2 ͌ 1 xvZĂ
+typedef struct
+{
+	AES_KEY_CONTEXT Key;
+	BYTE K1[16];
+	BYTE K2[16];
+} AES_CMAC_CONTEXT;
+
+VOID WINAPI AesCmacInit(BYTE* Key, AESBitLength BitLength, AES_CMAC_CONTEXT* pContext);
+VOID WINAPI AesCmac(AES_CMAC_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* Mac);
+VOID WINAPI AesCmacBatch(AES_CMAC_CONTEXT* pContext, BYTE** Messages, DWORD* cbMessages, DWORD nMessages, BYTE* Macs);
+
+// bv (SP 800-38F  KW, KWP)
+BOOL WINAPI AesKeyWrap(AES_KEY_CONTEXT* pKek, BYTE* in, DWORD cbIn, BOOL bPadded, BYTE* out, DWORD* pcbOut);
+BOOL WINAPI AesKeyUnwrap(AES_KEY_CONTEXT* pKek, BYTE* in, DWORD cbIn, BOOL bPadded, BYTE* out, DWORD* pcbOut);
+BOOL WINAPI AesKeyRewrapBatch(AES_KEY_CONTEXT* pOldKek, AES_KEY_CONTEXT* pNewKek, BOOL bPadded, BYTE** in, DWORD* cbIn, DWORD nKeys, BYTE** out, BOOL* pbResults);
+
+// CTR ̃L[Xg[ (CB n܂ 128 rbg̃JE^Í)
+VOID WINAPI Increment128(BYTE* CB);
+VOID WINAPI AesCtrKeystream(AES_KEY_CONTEXT* pContext, BYTE* CB, BYTE* out, DWORD nBlocks);
+
+// ReLXgp CBC ̕ CTR (Offset ̓f[^Ŝ̐擪̃oCgʒu)
+VOID WINAPI AesCbcDecryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out);
+VOID WINAPI AesCtrCryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out);
+
+// ͂̃oCgɉ 1 ubN̏AubŇݏAXbhv[ł̕񏈗I ECB, CBC ̕, CTR (SelectDispatch)
+VOID WINAPI AesEcbCryptDispatch(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out, BOOL bDecrypt);
+VOID WINAPI AesCbcDecryptDispatch(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out);
+VOID WINAPI AesCtrCryptDispatch(AES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out);
+
+// CTR_DRBG (SP 800-90A)
+// Ggs[
+// out  cbOut oCg̃Ggs[݁Aꍇ TRUE Ԃ
+typedef BOOL(WINAPI* DRBG_ENTROPY_SOURCE)(PVOID pParam, BYTE* out, DWORD cbOut);
+
+// ăV[hȂŐłő̗v (SP 800-90A Table 3 ̏ 2^48)
+#define AES_CTR_DRBG_RESEED_INTERVAL 0x0001000000000000ULL
+
+// 1 ̗vŐő̃oCg (2^19 rbg)
+// 傫ȗv́A̒Pʂɕ Update ݂Ȃ琶
+#define AES_CTR_DRBG_MAX_REQUEST 65536
+
+typedef struct
+{
+	AES_KEY_CONTEXT Key;
+	BYTE V[16]; // SP 800-90A  V  1 l (ɈÍJE^) ێ
+	AESBitLength BitLength;
+	DWORD cbSeed; // seedlen ( + 16 oCg)
+	ULONG64 ReseedCounter;
+	BOOL bPredictionResistance; // TRUE ̏ꍇ͐̓xɍăV[h
+	DRBG_ENTROPY_SOURCE GetEntropy;
+	PVOID pEntropyParam;
+} AES_CTR_DRBG_CONTEXT;
+
+BOOL WINAPI AesCtrDrbgInstantiate(AES_CTR_DRBG_CONTEXT* pContext, AESBitLength BitLength, DRBG_ENTROPY_SOURCE GetEntropy, PVOID pEntropyParam, BYTE* Personalization, DWORD cbPersonalization, BOOL bPredictionResistance);
+BOOL WINAPI AesCtrDrbgReseed(AES_CTR_DRBG_CONTEXT* pContext, BYTE* AddInput, DWORD cbAddInput);
+BOOL WINAPI AesCtrDrbgGenerate(AES_CTR_DRBG_CONTEXT* pContext, BYTE* out, SIZE_T cbOut, BYTE* AddInput, DWORD cbAddInput);
+VOID WINAPI AesCtrDrbgUninstantiate(AES_CTR_DRBG_CONTEXT* pContext);
+BOOL WINAPI AesRandomBytes(BYTE* out, SIZE_T cbOut);
+
+// ێÍ (Format-Preserving Encryption : FF1, FF3-1)
+// 1 R[h̍ő̐
+#define FPE_MAX_LEN 256
+
+// FF1 ̒l (tweak) ̍őoCg
+#define FF1_MAX_TWEAK 64
+
+// FF1 ̒ n ̃p[^
+typedef struct
+{
+	BYTE Prefix[16]; // CBC-MAC(P || Q ̒l̊SȃubN) ̓ȑ
+	WORD b;          // NUM_radix(B) ̃oCg ceil(ceil(v * log2(radix)) / 8)
+	WORD d;          // gp S ̃oCg 4 * ceil(b / 4) + 4
+	WORD cbFixed;    // Prefix Ɋ܂߂ Q ̐擪̃oCg (16 ̔{)
+	WORD cbQ;        // Q ̃oCg (t + pfBO + 1 + b)
+} FF1_LENGTH_PARAM;
+
+// FF1 ̃ReLXg
+// AAl͌Œ肵A n  P ƒl̃ubN CBC-MAC OɌvZĂ
+// eEhł [i]  NUM_radix(B) ܂ Q ̎c̃ubN݂̂΂悢
+typedef struct
+{
+	AES_KEY_CONTEXT Key;
+	DWORD dwRadix;
+	DWORD dwMinLen;
+	BYTE Tweak[FF1_MAX_TWEAK];
+	DWORD cbTweak;
+	FF1_LENGTH_PARAM Params[FPE_MAX_LEN + 1];
+} AES_FF1_CONTEXT;
+
+BOOL WINAPI AesFf1Init(BYTE* Key, AESBitLength BitLength, DWORD dwRadix, BYTE* Tweak, DWORD cbTweak, AES_FF1_CONTEXT* pContext);
+BOOL WINAPI AesFf1Encrypt(AES_FF1_CONTEXT* pContext, WORD* in, DWORD n, WORD* out);
+BOOL WINAPI AesFf1Decrypt(AES_FF1_CONTEXT* pContext, WORD* in, DWORD n, WORD* out);
+BOOL WINAPI AesFf1EncryptBatch(AES_FF1_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out);
+BOOL WINAPI AesFf1DecryptBatch(AES_FF1_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out);
+
+// FF3-1 ̃ReLXg
+// ̓oCg𔽓] REVB(K) ŌgĂ
+// 56 rbg̒l T_L, T_R 쐬Ă
+typedef struct
+{
+	AES_KEY_CONTEXT Key;
+	DWORD dwRadix;
+	DWORD dwMinLen;
+	DWORD dwMaxLen; // 2 * floor(log_radix(2^96))
+	BYTE TL[4];
+	BYTE TR[4];
+} AES_FF3_CONTEXT;
+
+BOOL WINAPI AesFf3Init(BYTE* Key, AESBitLength BitLength, DWORD dwRadix, BYTE* Tweak, AES_FF3_CONTEXT* pContext);
+BOOL WINAPI AesFf3Encrypt(AES_FF3_CONTEXT* pContext, WORD* in, DWORD n, WORD* out);
+BOOL WINAPI AesFf3Decrypt(AES_FF3_CONTEXT* pContext, WORD* in, DWORD n, WORD* out);
+BOOL WINAPI AesFf3EncryptBatch(AES_FF3_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out);
+BOOL WINAPI AesFf3DecryptBatch(AES_FF3_CONTEXT* pContext, WORD** in, DWORD* n, DWORD nRecords, WORD** out);
+
+// AES DUKPT (ANSI X9.24-3)
+// gUNVJE^̃rbg
+#define AES_DUKPT_COUNTER_BITS 32
+
+// o錮̎ (Algorithm Indicator)
+#define AES_DUKPT_KEY_2TDEA 0
+#define AES_DUKPT_KEY_3TDEA 1
+#define AES_DUKPT_KEY_AES128 2
+#define AES_DUKPT_KEY_AES192 3
+#define AES_DUKPT_KEY_AES256 4
+
+// o錮̗pr (Key Usage Indicator)
+#define AES_DUKPT_USAGE_KEY_ENCRYPTION 0x0002
+#define AES_DUKPT_USAGE_PIN 0x1000
+#define AES_DUKPT_USAGE_MAC_GENERATION 0x2000
+#define AES_DUKPT_USAGE_MAC_VERIFICATION 0x2001
+#define AES_DUKPT_USAGE_MAC_BOTH 0x2002
+#define AES_DUKPT_USAGE_DATA_ENCRYPT 0x3000
+#define AES_DUKPT_USAGE_DATA_DECRYPT 0x3001
+#define AES_DUKPT_USAGE_DATA_BOTH 0x3002
+#define AES_DUKPT_USAGE_KEY_DERIVATION 0x8000
+#define AES_DUKPT_USAGE_INITIAL_KEY 0x8001
+
+// ̎ޖ̌ (rbg)
+extern const WORD AesDukptKeyBits[5];
+
+// BDK ̃ReLXg
+typedef struct
+{
+	AES_KEY_CONTEXT Bdk;
+	AESBitLength BitLength;
+} AES_DUKPT_BDK_CONTEXT;
+
+// [ () ̓o
+// Keys[b]  dwCounter  1 ̃rbĝArbg b ȏ̂̂JE^œoԂ̓o (rbg b  1 ̏ꍇ̂ݗL)
+typedef struct
+{
+	BYTE InitialKeyId[8];
+	BYTE InitialKey[32];
+	AESBitLength BitLength;
+	DWORD dwCounter;
+	BOOL bCached;
+	BYTE Keys[AES_DUKPT_COUNTER_BITS][32];
+} AES_DUKPT_CONTEXT;
+
+VOID WINAPI AesDukptBdkSetup(BYTE* Bdk, AESBitLength BitLength, AES_DUKPT_BDK_CONTEXT* pContext);
+VOID WINAPI AesDukptDeriveInitialKey(AES_DUKPT_BDK_CONTEXT* pBdk, BYTE* InitialKeyId, BYTE* InitialKey);
+VOID WINAPI AesDukptInit(BYTE* InitialKey, AESBitLength BitLength, BYTE* Ksn, AES_DUKPT_CONTEXT* pContext);
+DWORD WINAPI AesDukptCounter(BYTE* Ksn);
+VOID WINAPI AesDukptDeriveKey(AES_DUKPT_CONTEXT* pContext, DWORD dwCounter, DWORD dwUsage, DWORD dwKeyType, BYTE* Key);
+VOID WINAPI AesDukptDeriveBatch(AES_DUKPT_BDK_CONTEXT* pBdk, BYTE* Ksns, DWORD nKsns, DWORD dwUsage, DWORD dwKeyType, BYTE* Keys);
+
+// l (KCV, Key Check Value)
+#define AES_KCV_LENGTH 3
+
+BOOL WINAPI AesKcvBatch(BYTE* Keys, AESBitLength BitLength, DWORD nKeys, BYTE* Kcvs, DWORD cbKcv);
+
+// AES-NI, PCLMULQDQ p (CiphAesNi.cpp)
+// GetCpuFeatures Ŏgpł邱ƂmFĂĂяo
+#if defined(CIPH_X86)
+VOID WINAPI AesNiEncryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, DWORD nBlocks);
+VOID WINAPI AesNiDecryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, DWORD nBlocks);
+VOID WINAPI AesNiCtrKeystream(AES_KEY_CONTEXT* pContext, BYTE* CB, BYTE* out, DWORD nBlocks);
+VOID WINAPI GhashInitClmul(AES_GCM_CONTEXT* pContext);
+VOID WINAPI GhashBlocksClmul(AES_GCM_CONTEXT* pContext, BYTE* Y, BYTE* data, DWORD nBlocks);
+VOID WINAPI AesNiGcmCrypt(AES_GCM_CONTEXT* pContext, BYTE* CB, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Y, BOOL bEncrypt);
+VOID WINAPI AesNiKcvGroup(BYTE* Keys, BYTE Nk, BYTE Nr, BYTE* out);
+#endif
@@ -0,0 +1,522 @@
+#include "CiphAes.h"
+#include <string.h>
+
+// AES-NI  PCLMULQDQ p AES ̎
+// GCC / Clang ł͂̃t@Ĉ -mssse3 -msse4.1 -maes -mpclmul w肵ăRpCÃt@C̖͊߃Zbĝ܂܂Ƃ
+// Ăяo GetCpuFeatures  CPU_FEATURE_AESNI (GHASH  CPU_FEATURE_PCLMUL) mFĂĂяo
+// (DetectCpuFeatures  SSSE3  SSE4.1 gpłȂꍇ AES-NI  PCLMULQDQ 񍐂Ȃ)
+
+#if defined(CIPH_X86)
+// AesNiEncryptBlocks ֐
+// AES-NI p nBlocks ̓ƗubNÍ
+// 4 ubN̊eEh݂ɔsAAESENC ߂̃CeVB
+VOID WINAPI AesNiEncryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, DWORD nBlocks)
+{
+	__m128i RoundKey[15], b0, b1, b2, b3;
+	DWORD i, r, Nr = pContext->Nr;
+
+	for (r = 0; r <= Nr; r++)
+	{
+		RoundKey[r] = _mm_loadu_si128((__m128i*)&pContext->W[4 * r]);
+	}
+
+	for (i = 0; i + 4 <= nBlocks; i += 4)
+	{
+		b0 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i]), RoundKey[0]);
+		b1 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i + 16]), RoundKey[0]);
+		b2 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i + 32]), RoundKey[0]);
+		b3 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i + 48]), RoundKey[0]);
+		for (r = 1; r < Nr; r++)
+		{
+			b0 = _mm_aesenc_si128(b0, RoundKey[r]);
+			b1 = _mm_aesenc_si128(b1, RoundKey[r]);
+			b2 = _mm_aesenc_si128(b2, RoundKey[r]);
+			b3 = _mm_aesenc_si128(b3, RoundKey[r]);
+		}
+		_mm_storeu_si128((__m128i*)&out[16 * i], _mm_aesenclast_si128(b0, RoundKey[Nr]));
+		_mm_storeu_si128((__m128i*)&out[16 * i + 16], _mm_aesenclast_si128(b1, RoundKey[Nr]));
+		_mm_storeu_si128((__m128i*)&out[16 * i + 32], _mm_aesenclast_si128(b2, RoundKey[Nr]));
+		_mm_storeu_si128((__m128i*)&out[16 * i + 48], _mm_aesenclast_si128(b3, RoundKey[Nr]));
+	}
+
+	// c肪 2 ubNȏ̏ꍇ 2 ubN݂ɏ
+	// (CCM  CBC-MAC  CTR ̂悤ɁA̓ƗubN܂Ƃ߂ēnꍇɌʂ)
+	if (i + 2 <= nBlocks)
+	{
+		b0 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i]), RoundKey[0]);
+		b1 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i + 16]), RoundKey[0]);
+		for (r = 1; r < Nr; r++)
+		{
+			b0 = _mm_aesenc_si128(b0, RoundKey[r]);
+			b1 = _mm_aesenc_si128(b1, RoundKey[r]);
+		}
+		_mm_storeu_si128((__m128i*)&out[16 * i], _mm_aesenclast_si128(b0, RoundKey[Nr]));
+		_mm_storeu_si128((__m128i*)&out[16 * i + 16], _mm_aesenclast_si128(b1, RoundKey[Nr]));
+		i += 2;
+	}
+
+	for (; i < nBlocks; i++)
+	{
+		b0 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i]), RoundKey[0]);
+		for (r = 1; r < Nr; r++)
+		{
+			b0 = _mm_aesenc_si128(b0, RoundKey[r]);
+		}
+		_mm_storeu_si128((__m128i*)&out[16 * i], _mm_aesenclast_si128(b0, RoundKey[Nr]));
+	}
+
+	return;
+}
+
+// AesNiDecryptBlocks ֐
+// AES-NI p nBlocks ̓ƗubN𕡍 (tÍ̃Eh DW gp)
+VOID WINAPI AesNiDecryptBlocks(AES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, DWORD nBlocks)
+{
+	__m128i RoundKey[15], b0, b1, b2, b3;
+	DWORD i, r, Nr = pContext->Nr;
+
+	for (r = 0; r <= Nr; r++)
+	{
+		RoundKey[r] = _mm_loadu_si128((__m128i*)&pContext->DW[4 * r]);
+	}
+
+	for (i = 0; i + 4 <= nBlocks; i += 4)
+	{
+		b0 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i]), RoundKey[0]);
+		b1 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i + 16]), RoundKey[0]);
+		b2 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i + 32]), RoundKey[0]);
+		b3 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i + 48]), RoundKey[0]);
+		for (r = 1; r < Nr; r++)
+		{
+			b0 = _mm_aesdec_si128(b0, RoundKey[r]);
+			b1 = _mm_aesdec_si128(b1, RoundKey[r]);
+			b2 = _mm_aesdec_si128(b2, RoundKey[r]);
+			b3 = _mm_aesdec_si128(b3, RoundKey[r]);
+		}
+		_mm_storeu_si128((__m128i*)&out[16 * i], _mm_aesdeclast_si128(b0, RoundKey[Nr]));
+		_mm_storeu_si128((__m128i*)&out[16 * i + 16], _mm_aesdeclast_si128(b1, RoundKey[Nr]));
+		_mm_storeu_si128((__m128i*)&out[16 * i + 32], _mm_aesdeclast_si128(b2, RoundKey[Nr]));
+		_mm_storeu_si128((__m128i*)&out[16 * i + 48], _mm_aesdeclast_si128(b3, RoundKey[Nr]));
+	}
+
+	// c肪 2 ubNȏ̏ꍇ 2 ubN݂ɏ
+	// (CCM  CBC-MAC  CTR ̂悤ɁA̓ƗubN܂Ƃ߂ēnꍇɌʂ)
+	if (i + 2 <= nBlocks)
+	{
+		b0 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i]), RoundKey[0]);
+		b1 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i + 16]), RoundKey[0]);
+		for (r = 1; r < Nr; r++)
+		{
+			b0 = _mm_aesdec_si128(b0, RoundKey[r]);
+			b1 = _mm_aesdec_si128(b1, RoundKey[r]);
+		}
+		_mm_storeu_si128((__m128i*)&out[16 * i], _mm_aesdeclast_si128(b0, RoundKey[Nr]));
+		_mm_storeu_si128((__m128i*)&out[16 * i + 16], _mm_aesdeclast_si128(b1, RoundKey[Nr]));
+		i += 2;
+	}
+
+	for (; i < nBlocks; i++)
+	{
+		b0 = _mm_xor_si128(_mm_loadu_si128((__m128i*)&in[16 * i]), RoundKey[0]);
+		for (r = 1; r < Nr; r++)
+		{
+			b0 = _mm_aesdec_si128(b0, RoundKey[r]);
+		}
+		_mm_storeu_si128((__m128i*)&out[16 * i], _mm_aesdeclast_si128(b0, RoundKey[Nr]));
+	}
+
+	return;
+}
+
+// ClmulAccumulate ֐
+// 128 rbg ~ 128 rbǧJオȂZsAҌǑʂ lo, mid, hi ɉZ
+// ubN̐ς܂Ƃ߂ĉZĂ 1 xҌ (WҌ) ߂ɕĂ
+inline VOID ClmulAccumulate(__m128i a, __m128i b, __m128i* pLo, __m128i* pMid, __m128i* pHi)
+{
+	*pLo = _mm_xor_si128(*pLo, _mm_clmulepi64_si128(a, b, 0x00));
+	*pHi = _mm_xor_si128(*pHi, _mm_clmulepi64_si128(a, b, 0x11));
+	*pMid = _mm_xor_si128(*pMid, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01)));
+}
+
+// GhashReduce ֐
+// 256 rbg̏Zʂ x^128 + x^7 + x^2 + x + 1 ŊҌ
+// GHASH ̓rbg]\̂߁A1 rbgVtgĂҌ
+// (Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode ̕@)
+inline __m128i GhashReduce(__m128i lo, __m128i mid, __m128i hi)
+{
+	__m128i tmp2, tmp3, tmp4, tmp5, tmp6, tmp7, tmp8, tmp9;
+
+	tmp3 = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+	tmp6 = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+	// 256 rbgŜ 1 rbgVtg
+	tmp7 = _mm_srli_epi32(tmp3, 31);
+	tmp8 = _mm_srli_epi32(tmp6, 31);
+	tmp3 = _mm_slli_epi32(tmp3, 1);
+	tmp6 = _mm_slli_epi32(tmp6, 1);
+	tmp9 = _mm_srli_si128(tmp7, 12);
+	tmp8 = _mm_slli_si128(tmp8, 4);
+	tmp7 = _mm_slli_si128(tmp7, 4);
+	tmp3 = _mm_or_si128(tmp3, tmp7);
+	tmp6 = _mm_or_si128(tmp6, tmp8);
+	tmp6 = _mm_or_si128(tmp6, tmp9);
+
+	// Ҍ
+	tmp7 = _mm_slli_epi32(tmp3, 31);
+	tmp8 = _mm_slli_epi32(tmp3, 30);
+	tmp9 = _mm_slli_epi32(tmp3, 25);
+	tmp7 = _mm_xor_si128(tmp7, tmp8);
+	tmp7 = _mm_xor_si128(tmp7, tmp9);
+	tmp8 = _mm_srli_si128(tmp7, 4);
+	tmp7 = _mm_slli_si128(tmp7, 12);
+	tmp3 = _mm_xor_si128(tmp3, tmp7);
+
+	tmp2 = _mm_srli_epi32(tmp3, 1);
+	tmp4 = _mm_srli_epi32(tmp3, 2);
+	tmp5 = _mm_srli_epi32(tmp3, 7);
+	tmp2 = _mm_xor_si128(tmp2, tmp4);
+	tmp2 = _mm_xor_si128(tmp2, tmp5);
+	tmp2 = _mm_xor_si128(tmp2, tmp8);
+	tmp3 = _mm_xor_si128(tmp3, tmp2);
+
+	return _mm_xor_si128(tmp6, tmp3);
+}
+
+// GhashMultiplyClmul ֐
+// PCLMULQDQ p a E b vZ (a, b ̓oCg𔽓]\)
+inline __m128i GhashMultiplyClmul(__m128i a, __m128i b)
+{
+	__m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+	ClmulAccumulate(a, b, &lo, &mid, &hi);
+
+	return GhashReduce(lo, mid, hi);
+}
+
+// GhashBlocksClmul ֐
+// PCLMULQDQ p nBlocks ̃ubN GHASH ̏ Y Ɏ荞
+// 4 ubN Y = (Y ^ X1)EH^4 ^ X2EH^3 ^ X3EH^2 ^ X4EH ƂĊҌ 1 ɂ܂Ƃ߂
+VOID WINAPI GhashBlocksClmul(AES_GCM_CONTEXT* pContext, BYTE* Y, BYTE* data, DWORD nBlocks)
+{
+	const __m128i BSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	__m128i Acc, H1, H2, H3, H4, lo, mid, hi;
+	DWORD i;
+
+	Acc = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)Y), BSwap);
+	H1 = _mm_loadu_si128((__m128i*)pContext->HPow[0]);
+	H2 = _mm_loadu_si128((__m128i*)pContext->HPow[1]);
+	H3 = _mm_loadu_si128((__m128i*)pContext->HPow[2]);
+	H4 = _mm_loadu_si128((__m128i*)pContext->HPow[3]);
+
+	for (i = 0; i + 4 <= nBlocks; i += 4)
+	{
+		lo = mid = hi = _mm_setzero_si128();
+		ClmulAccumulate(_mm_xor_si128(Acc, _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)&data[16 * i]), BSwap)), H4, &lo, &mid, &hi);
+		ClmulAccumulate(_mm_shuffle_epi8(_mm_loadu_si128((__m128i*)&data[16 * i + 16]), BSwap), H3, &lo, &mid, &hi);
+		ClmulAccumulate(_mm_shuffle_epi8(_mm_loadu_si128((__m128i*)&data[16 * i + 32]), BSwap), H2, &lo, &mid, &hi);
+		ClmulAccumulate(_mm_shuffle_epi8(_mm_loadu_si128((__m128i*)&data[16 * i + 48]), BSwap), H1, &lo, &mid, &hi);
+		Acc = GhashReduce(lo, mid, hi);
+	}
+
+	for (; i < nBlocks; i++)
+	{
+		Acc = GhashMultiplyClmul(_mm_xor_si128(Acc, _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)&data[16 * i]), BSwap)), H1);
+	}
+
+	_mm_storeu_si128((__m128i*)Y, _mm_shuffle_epi8(Acc, BSwap));
+
+	return;
+}
+
+// GhashInitClmul ֐
+// PCLMULQDQ p H^1 ` H^4 OɌvZ
+VOID WINAPI GhashInitClmul(AES_GCM_CONTEXT* pContext)
+{
+	const __m128i BSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	__m128i H, HPow;
+	DWORD i;
+
+	H = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)pContext->H), BSwap);
+	HPow = H;
+	_mm_storeu_si128((__m128i*)pContext->HPow[0], HPow);
+	for (i = 1; i < 4; i++)
+	{
+		HPow = GhashMultiplyClmul(HPow, H);
+		_mm_storeu_si128((__m128i*)pContext->HPow[i], HPow);
+	}
+
+	return;
+}
+
+// AesNiGcmCrypt ֐
+// AES-NI  PCLMULQDQ p GCTR ɂÍ /  GHASH  1 pXōs
+// 4 ubN AES Eh̊Ԃ GHASH ̏Zݍ (stitching)A
+// Í͏õWX^̒l̂܂ GHASH Ɏ荞ނ߁AeubNǂݏ̂ 1 xɂȂ
+// EÍ : O 4 ubN̈Í GHASH A݂ 4 ubN AES EhƕsČvZ
+// E : ͂ꂽÍ GHASH A 4 ubN AES EhƕsČvZ
+VOID WINAPI AesNiGcmCrypt(AES_GCM_CONTEXT* pContext, BYTE* CB, BYTE* in, DWORD cbIn, BYTE* out, BYTE* Y, BOOL bEncrypt)
+{
+	const __m128i BSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i One = _mm_set_epi32(0, 0, 0, 1);
+	__m128i RoundKey[15], HPow[4], X[4], Acc, Ctr, c0, c1, c2, c3, lo, mid, hi;
+	DWORD i, j, r, Nr = pContext->Key.Nr, nBlocks = cbIn / 16, cbRemain = cbIn % 16;
+	BOOL bPending = FALSE;
+	BYTE Temp[16];
+
+	for (r = 0; r <= Nr; r++)
+	{
+		RoundKey[r] = _mm_loadu_si128((__m128i*)&pContext->Key.W[4 * r]);
+	}
+	for (r = 0; r < 4; r++)
+	{
+		HPow[r] = _mm_loadu_si128((__m128i*)pContext->HPow[r]);
+	}
+
+	Acc = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)Y), BSwap);
+
+	// oCg𔽓]JE^ubN̉ 32 rbg inc32 ̑ΏۂƂȂ
+	Ctr = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)CB), BSwap);
+
+	for (i = 0; i + 4 <= nBlocks; i += 4)
+	{
+		c0 = _mm_xor_si128(_mm_shuffle_epi8(Ctr, BSwap), RoundKey[0]);
+		Ctr = _mm_add_epi32(Ctr, One);
+		c1 = _mm_xor_si128(_mm_shuffle_epi8(Ctr, BSwap), RoundKey[0]);
+		Ctr = _mm_add_epi32(Ctr, One);
+		c2 = _mm_xor_si128(_mm_shuffle_epi8(Ctr, BSwap), RoundKey[0]);
+		Ctr = _mm_add_epi32(Ctr, One);
+		c3 = _mm_xor_si128(_mm_shuffle_epi8(Ctr, BSwap), RoundKey[0]);
+		Ctr = _mm_add_epi32(Ctr, One);
+
+		if (!bEncrypt)
+		{
+			// ł͓͂ꂽÍ̂܂ GHASH Ɏ荞
+			for (j = 0; j < 4; j++)
+			{
+				X[j] = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)&in[16 * (i + j)]), BSwap);
+			}
+			X[0] = _mm_xor_si128(X[0], Acc);
+			bPending = TRUE;
+		}
+
+		lo = mid = hi = _mm_setzero_si128();
+		for (r = 1; r < Nr; r++)
+		{
+			c0 = _mm_aesenc_si128(c0, RoundKey[r]);
+			c1 = _mm_aesenc_si128(c1, RoundKey[r]);
+			c2 = _mm_aesenc_si128(c2, RoundKey[r]);
+			c3 = _mm_aesenc_si128(c3, RoundKey[r]);
+
+			// ŏ 4 Eh̊Ԃ GHASH ̏Z 1 ubNs
+			if (bPending && r <= 4)
+			{
+				ClmulAccumulate(X[r - 1], HPow[4 - r], &lo, &mid, &hi);
+			}
+		}
+
+		c0 = _mm_xor_si128(_mm_aesenclast_si128(c0, RoundKey[Nr]), _mm_loadu_si128((__m128i*)&in[16 * i]));
+		c1 = _mm_xor_si128(_mm_aesenclast_si128(c1, RoundKey[Nr]), _mm_loadu_si128((__m128i*)&in[16 * i + 16]));
+		c2 = _mm_xor_si128(_mm_aesenclast_si128(c2, RoundKey[Nr]), _mm_loadu_si128((__m128i*)&in[16 * i + 32]));
+		c3 = _mm_xor_si128(_mm_aesenclast_si128(c3, RoundKey[Nr]), _mm_loadu_si128((__m128i*)&in[16 * i + 48]));
+		_mm_storeu_si128((__m128i*)&out[16 * i], c0);
+		_mm_storeu_si128((__m128i*)&out[16 * i + 16], c1);
+		_mm_storeu_si128((__m128i*)&out[16 * i + 32], c2);
+		_mm_storeu_si128((__m128i*)&out[16 * i + 48], c3);
+
+		if (bPending)
+		{
+			Acc = GhashReduce(lo, mid, hi);
+			bPending = FALSE;
+		}
+
+		if (bEncrypt)
+		{
+			// Íł͍̈Í 4 ubN AES Eh̊Ԃ GHASH Ɏ荞
+			X[0] = _mm_xor_si128(_mm_shuffle_epi8(c0, BSwap), Acc);
+			X[1] = _mm_shuffle_epi8(c1, BSwap);
+			X[2] = _mm_shuffle_epi8(c2, BSwap);
+			X[3] = _mm_shuffle_epi8(c3, BSwap);
+			bPending = TRUE;
+		}
+	}
+
+	// Ō 4 ubN GHASH
+	if (bPending)
+	{
+		lo = mid = hi = _mm_setzero_si128();
+		for (j = 0; j < 4; j++)
+		{
+			ClmulAccumulate(X[j], HPow[3 - j], &lo, &mid, &hi);
+		}
+		Acc = GhashReduce(lo, mid, hi);
+	}
+
+	// 4 ubNɖȂc̃ubNƁAŌ̕sSȃubN
+	for (; i < nBlocks || (i == nBlocks && cbRemain != 0); i++)
+	{
+		DWORD cbBlock = i < nBlocks ? 16 : cbRemain;
+
+		c0 = _mm_xor_si128(_mm_shuffle_epi8(Ctr, BSwap), RoundKey[0]);
+		Ctr = _mm_add_epi32(Ctr, One);
+		for (r = 1; r < Nr; r++)
+		{
+			c0 = _mm_aesenc_si128(c0, RoundKey[r]);
+		}
+		c0 = _mm_aesenclast_si128(c0, RoundKey[Nr]);
+
+		ZeroMemory(Temp, 16);
+		memcpy(Temp, &in[16 * i], cbBlock);
+		c1 = _mm_loadu_si128((__m128i*)Temp);
+		c0 = _mm_xor_si128(c0, c1);
+		_mm_storeu_si128((__m128i*)Temp, c0);
+		memcpy(&out[16 * i], Temp, cbBlock);
+
+		// GHASH ɂ 0 ŃpfBOÍ荞
+		if (bEncrypt)
+		{
+			ZeroMemory(&Temp[cbBlock], 16 - cbBlock);
+			c1 = _mm_loadu_si128((__m128i*)Temp);
+		}
+		Acc = GhashMultiplyClmul(_mm_xor_si128(Acc, _mm_shuffle_epi8(c1, BSwap)), HPow[0]);
+	}
+
+	_mm_storeu_si128((__m128i*)Y, _mm_shuffle_epi8(Acc, BSwap));
+	_mm_storeu_si128((__m128i*)CB, _mm_shuffle_epi8(Ctr, BSwap));
+
+	return;
+}
+
+// AesNiCtrKeystream ֐
+// AES-NI p 128 rbg̃JE^ CB  nBlocks ̃L[Xg[ E(CB), E(CB+1), ...  out ɏoACB i߂
+// JE^̓oRɃWX^ō쐬A8 ubÑEh݂ɔs
+VOID WINAPI AesNiCtrKeystream(AES_KEY_CONTEXT* pContext, BYTE* CB, BYTE* out, DWORD nBlocks)
+{
+	const __m128i BSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	__m128i RoundKey[15], b[8];
+	DWORD i, j, n, r, Nr = pContext->Nr;
+	ULONG64 hi = 0, lo = 0;
+
+	for (r = 0; r <= Nr; r++)
+	{
+		RoundKey[r] = _mm_loadu_si128((__m128i*)&pContext->W[4 * r]);
+	}
+	for (i = 0; i < 8; i++)
+	{
+		hi = (hi << 8) | CB[i];
+		lo = (lo << 8) | CB[i + 8];
+	}
+
+	for (i = 0; i < nBlocks; i += n)
+	{
+		n = nBlocks - i < 8 ? nBlocks - i : 8;
+
+		for (j = 0; j < n; j++)
+		{
+			b[j] = _mm_xor_si128(_mm_shuffle_epi8(_mm_set_epi64x((LONGLONG)hi, (LONGLONG)lo), BSwap), RoundKey[0]);
+			if (++lo == 0)
+			{
+				hi++;
+			}
+		}
+		for (r = 1; r < Nr; r++)
+		{
+			for (j = 0; j < n; j++)
+			{
+				b[j] = _mm_aesenc_si128(b[j], RoundKey[r]);
+			}
+		}
+		for (j = 0; j < n; j++)
+		{
+			_mm_storeu_si128((__m128i*)&out[16 * (i + j)], _mm_aesenclast_si128(b[j], RoundKey[Nr]));
+		}
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		CB[7 - i] = (BYTE)(hi >> (8 * i));
+		CB[15 - i] = (BYTE)(lo >> (8 * i));
+	}
+
+	return;
+}
+
+// AesNiKcvGroup ֐
+// 4 ̌ (4 * Nk oCgׂ)  0 ̃ubNÍAʂ out  16 oCgi[
+// 
+// 4 ̌̓ʒũ[h W[i]  1 ̃xNg ([ j  j Ԗڂ̌) ɂ܂Ƃ߂āAKeyExpansion ƓQœWJ
+// SubWord  AESENCLAST (ShiftRows, SubBytes, AddRoundKey)  4 [ɌvZ
+// ShiftRows  (s r,  c)  (s r,  c + r) ̃oCgڂ߁AOɋtɕבւĂ
+// RotWord ̕בւɊ܂߁ARcon  AddRoundKey ̃EhƂ xor 
+// Eh 4 [h낤тɓ]uČƂ̃EhƂAɈÍ 1 Ehi߂
+VOID WINAPI AesNiKcvGroup(BYTE* Keys, BYTE Nk, BYTE Nr, BYTE* out)
+{
+	const __m128i SubWordShuffle = _mm_setr_epi8(0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3);
+	const __m128i RotSubWordShuffle = _mm_setr_epi8(1, 14, 11, 4, 5, 2, 15, 8, 9, 6, 3, 12, 13, 10, 7, 0);
+	__m128i W[60], State[4], RoundKey[4], t0, t1, t2, t3, temp;
+	DWORD Word[4];
+	DWORD i, j, r = 0, k = 0, n = 0;
+
+	for (i = 0; i < 4 * ((DWORD)Nr + 1); i++)
+	{
+		if (i < Nk)
+		{
+			for (j = 0; j < 4; j++)
+			{
+				memcpy(&Word[j], &Keys[4 * (Nk * j + i)], 4);
+			}
+			W[i] = _mm_loadu_si128((__m128i*)Word);
+		}
+		else
+		{
+			temp = W[i - 1];
+			if (k == 0)
+			{
+				temp = _mm_aesenclast_si128(_mm_shuffle_epi8(temp, RotSubWordShuffle), _mm_set1_epi32((INT)RCon[n]));
+			}
+			else if (Nk > 6 && k == 4)
+			{
+				temp = _mm_aesenclast_si128(_mm_shuffle_epi8(temp, SubWordShuffle), _mm_setzero_si128());
+			}
+			W[i] = _mm_xor_si128(W[i - Nk], temp);
+		}
+
+		if ((i & 3) == 3)
+		{
+			// W[4r] ` W[4r + 3] ]uARoundKey[j]  j Ԗڂ̌̃EhƂ
+			t0 = _mm_unpacklo_epi32(W[i - 3], W[i - 2]);
+			t1 = _mm_unpackhi_epi32(W[i - 3], W[i - 2]);
+			t2 = _mm_unpacklo_epi32(W[i - 1], W[i]);
+			t3 = _mm_unpackhi_epi32(W[i - 1], W[i]);
+			RoundKey[0] = _mm_unpacklo_epi64(t0, t2);
+			RoundKey[1] = _mm_unpackhi_epi64(t0, t2);
+			RoundKey[2] = _mm_unpacklo_epi64(t1, t3);
+			RoundKey[3] = _mm_unpackhi_epi64(t1, t3);
+
+			for (j = 0; j < 4; j++)
+			{
+				// 0 ̃ubN AddRoundKey ʂ 1 Ԗڂ̃Eĥ
+				State[j] = r == 0 ? RoundKey[j] : r < Nr ? _mm_aesenc_si128(State[j], RoundKey[j]) : _mm_aesenclast_si128(State[j], RoundKey[j]);
+			}
+			r++;
+		}
+
+		// k = i mod NkAn = i / Nk (Z͌WJ̊e[h̏dߐċ߂)
+		if (++k == Nk)
+		{
+			k = 0;
+			n++;
+		}
+	}
+
+	for (j = 0; j < 4; j++)
+	{
+		_mm_storeu_si128((__m128i*)&out[16 * j], State[j]);
+	}
+
+	SecureZeroMemory(W, sizeof(W));
+	SecureZeroMemory(RoundKey, sizeof(RoundKey));
+	SecureZeroMemory(Word, sizeof(Word));
+
+	return;
+}
+#endif
@@ -0,0 +1,1493 @@
+#include "CiphCommon.h"
+#include <string.h>
+#include <atomic>
+#ifdef _WIN32
+#include <malloc.h>
+#pragma comment(lib, "bcrypt.lib")
+#else
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <time.h>
+#if defined(__APPLE__)
+#include <sys/random.h>
+#endif
+#endif
+
+// bNƏϐ (Windows  SRW bNƏϐAȊO pthread)
+#ifdef _WIN32
+typedef SRWLOCK CIPH_LOCK;
+typedef CONDITION_VARIABLE CIPH_COND;
+#define CIPH_LOCK_INIT SRWLOCK_INIT
+#define CIPH_COND_INIT CONDITION_VARIABLE_INIT
+#define CiphLockInit(pLock) InitializeSRWLock(pLock)
+#define CiphLock(pLock) AcquireSRWLockExclusive(pLock)
+#define CiphUnlock(pLock) ReleaseSRWLockExclusive(pLock)
+#define CiphCondWait(pCond, pLock) SleepConditionVariableSRW((pCond), (pLock), INFINITE, 0)
+#define CiphCondWakeAll(pCond) WakeAllConditionVariable(pCond)
+#else
+typedef pthread_mutex_t CIPH_LOCK;
+typedef pthread_cond_t CIPH_COND;
+#define CIPH_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#define CIPH_COND_INIT PTHREAD_COND_INITIALIZER
+#define CiphLockInit(pLock) pthread_mutex_init((pLock), NULL)
+#define CiphLock(pLock) pthread_mutex_lock(pLock)
+#define CiphUnlock(pLock) pthread_mutex_unlock(pLock)
+#define CiphCondWait(pCond, pLock) pthread_cond_wait((pCond), (pLock))
+#define CiphCondWakeAll(pCond) pthread_cond_broadcast(pCond)
+#endif
+
+// AES  DES ̃GWŋʂ̏
+
+// Ɨ̈̊m
+// ̈̓wb_[ (CIPH_BLOCK) ̒ォn܂A64 oCgEɑ
+// wb_[܂߂ 128 oCg ` 8 MB  2 ׂ̂̃TCYNXɕÄjɍėp
+// ̈͂܂Xbh̃A[iɕێ (bNsv)Aӂꂽ̓vZXŜ̃v[ɕێ
+// ̈͑̃Xbhɂėp邽߁AA[iAv[Aʂ̃AP[^[ɖ߂OɎgp͈͂ 0 ŏ
+// TCYNX傫̈ OS ̃y[WPʂŊmۂ (̉ʂ̃AP[^[̏ꍇ)A OS ɕԂ
+#define CIPH_ALLOC_ALIGN   64
+#define CIPH_POOL_CLASSES  17         // 128 << 16 = 8 MB
+#define CIPH_ARENA_CLASSES 14         // A[iɕێ̂ 1 MB ȉ̃NX̂
+#define CIPH_ARENA_BLOCKS  64         // A[iɃNXɕێőubN
+#define CIPH_ARENA_BYTES   0x00100000 // A[iɃNXɕێőoCg (1 MB)
+#define CIPH_POOL_BYTES    0x04000000 // v[ɕێőoCg (64 MB)
+#define CIPH_PAGE_SIZE     0x00001000
+#define CIPH_HUGE_PAGE     0x00200000
+
+// ubN̎擾
+#define CIPH_SOURCE_BACKING 0 // ʂ̃AP[^[
+#define CIPH_SOURCE_PAGES   1 // OS ̃y[W (VirtualAlloc, mmap)
+
+typedef union CIPH_BLOCK_
+{
+	struct
+	{
+		union CIPH_BLOCK_* pNext; // 󂫃Xg
+		SIZE_T cbBlock;           // wb_[܂ރoCg
+		SIZE_T cbUsed;            // mێɗvꂽoCg (ɏ͈)
+		DWORD dwClass;            // TCYNX (CIPH_POOL_CLASSES ̓NX傫̈)
+		DWORD dwSource;           // CIPH_SOURCE_*
+		CIPH_BACKING_FREE Free;   // mۂʂ̃AP[^[̉֐
+		PVOID pUser;
+	} Header;
+	BYTE Padding[CIPH_ALLOC_ALIGN];
+} CIPH_BLOCK;
+
+// CiphDefaultAlloc ֐, CiphDefaultFree ֐
+// ̉ʂ̃AP[^[ (Windows  _aligned_mallocAȊO posix_memalign)
+PVOID WINAPI CiphDefaultAlloc(PVOID pUser, SIZE_T cb, SIZE_T cbAlign)
+{
+	(VOID)pUser;
+
+#ifdef _WIN32
+	return _aligned_malloc(cb, cbAlign);
+#else
+	PVOID p;
+
+	if (posix_memalign(&p, cbAlign, cb) != 0)
+	{
+		return NULL;
+	}
+
+	return p;
+#endif
+}
+
+VOID WINAPI CiphDefaultFree(PVOID pUser, PVOID p, SIZE_T cb)
+{
+	(VOID)pUser;
+	(VOID)cb;
+
+#ifdef _WIN32
+	_aligned_free(p);
+#else
+	free(p);
+#endif
+
+	return;
+}
+
+static CIPH_BACKING_ALLOC BackingAlloc = CiphDefaultAlloc;
+static CIPH_BACKING_FREE BackingFree = CiphDefaultFree;
+static PVOID BackingUser = NULL;
+
+// vZXŜ̃v[
+static CIPH_BLOCK* PoolFree[CIPH_POOL_CLASSES];
+static SIZE_T cbPool = 0;
+static CIPH_LOCK PoolLock = CIPH_LOCK_INIT;
+
+// CiphReleaseBlock ֐
+// ubN擾 (ʂ̃AP[^[܂ OS) ɕԂ
+VOID WINAPI CiphReleaseBlock(CIPH_BLOCK* pBlock)
+{
+	if (pBlock->Header.dwSource == CIPH_SOURCE_PAGES)
+	{
+#ifdef _WIN32
+		VirtualFree(pBlock, 0, MEM_RELEASE);
+#else
+		munmap(pBlock, pBlock->Header.cbBlock);
+#endif
+	}
+	else
+	{
+		pBlock->Header.Free(pBlock->Header.pUser, pBlock, pBlock->Header.cbBlock);
+	}
+
+	return;
+}
+
+// CiphPoolPush ֐
+// ubNvZXŜ̃v[ɖ߂Bv[ɒBĂꍇ͎擾ɕԂ
+VOID WINAPI CiphPoolPush(CIPH_BLOCK* pBlock)
+{
+	BOOL bPooled = FALSE;
+
+	CiphLock(&PoolLock);
+	if (cbPool + pBlock->Header.cbBlock <= CIPH_POOL_BYTES)
+	{
+		pBlock->Header.pNext = PoolFree[pBlock->Header.dwClass];
+		PoolFree[pBlock->Header.dwClass] = pBlock;
+		cbPool += pBlock->Header.cbBlock;
+		bPooled = TRUE;
+	}
+	CiphUnlock(&PoolLock);
+
+	if (!bPooled)
+	{
+		CiphReleaseBlock(pBlock);
+	}
+
+	return;
+}
+
+// Xbh̃A[i
+// Xbh̏IɕێĂubNvZXŜ̃v[ɖ߂
+struct CIPH_THREAD_ARENA
+{
+	CIPH_BLOCK* Free[CIPH_ARENA_CLASSES];
+	DWORD Count[CIPH_ARENA_CLASSES];
+	BOOL bClosed;
+
+	~CIPH_THREAD_ARENA()
+	{
+		Trim();
+		bClosed = TRUE;
+	}
+
+	VOID Trim()
+	{
+		DWORD i;
+		CIPH_BLOCK* pBlock;
+
+		for (i = 0; i < CIPH_ARENA_CLASSES; i++)
+		{
+			while (Free[i] != NULL)
+			{
+				pBlock = Free[i];
+				Free[i] = pBlock->Header.pNext;
+				CiphPoolPush(pBlock);
+			}
+			Count[i] = 0;
+		}
+
+		return;
+	}
+};
+
+static thread_local CIPH_THREAD_ARENA ThreadArena;
+
+// CiphAllocPages ֐
+// TCYNX傫̈ OS ̃y[WPʂŊmۂBOS mۂ̈ 0 ŏĂ
+// CIPH_ALLOC_LARGE_PAGES ̏ꍇAWindows ̓[Wy[W (SeLockMemoryPrivilege Kv) A
+// ȊO 2 MB E 2 MB PʂŊmۂ Transparent Huge Pages vBgpłȂꍇ͒ʏ̃y[WŊmۂ
+CIPH_BLOCK* WINAPI CiphAllocPages(SIZE_T cbBlock, DWORD dwFlags)
+{
+	PVOID p = NULL;
+#ifdef _WIN32
+	SIZE_T cbLargePage;
+
+	if (dwFlags & CIPH_ALLOC_LARGE_PAGES)
+	{
+		cbLargePage = GetLargePageMinimum();
+		if (cbLargePage != 0)
+		{
+			p = VirtualAlloc(NULL, (cbBlock + cbLargePage - 1) & ~(cbLargePage - 1), MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			if (p != NULL)
+			{
+				cbBlock = (cbBlock + cbLargePage - 1) & ~(cbLargePage - 1);
+			}
+		}
+	}
+
+	if (p == NULL)
+	{
+		cbBlock = (cbBlock + CIPH_PAGE_SIZE - 1) & ~(SIZE_T)(CIPH_PAGE_SIZE - 1);
+		p = VirtualAlloc(NULL, cbBlock, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		if (p == NULL)
+		{
+			return NULL;
+		}
+	}
+#else
+	SIZE_T cbHead;
+
+	if (dwFlags & CIPH_ALLOC_LARGE_PAGES)
+	{
+		// Huge Page ŗt̂ 2 MB Eɑ݂̂̂߁A2 MB ]ɊmۂđO؂l߂
+		cbBlock = (cbBlock + CIPH_HUGE_PAGE - 1) & ~(SIZE_T)(CIPH_HUGE_PAGE - 1);
+		p = mmap(NULL, cbBlock + CIPH_HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED)
+		{
+			return NULL;
+		}
+		cbHead = (CIPH_HUGE_PAGE - ((ULONG_PTR)p & (CIPH_HUGE_PAGE - 1))) & (CIPH_HUGE_PAGE - 1);
+		if (cbHead != 0)
+		{
+			munmap(p, cbHead);
+		}
+		munmap((BYTE*)p + cbHead + cbBlock, CIPH_HUGE_PAGE - cbHead);
+		p = (BYTE*)p + cbHead;
+#if defined(MADV_HUGEPAGE)
+		madvise(p, cbBlock, MADV_HUGEPAGE);
+#endif
+	}
+	else
+	{
+		cbBlock = (cbBlock + CIPH_PAGE_SIZE - 1) & ~(SIZE_T)(CIPH_PAGE_SIZE - 1);
+		p = mmap(NULL, cbBlock, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED)
+		{
+			return NULL;
+		}
+	}
+#endif
+
+	((CIPH_BLOCK*)p)->Header.cbBlock = cbBlock;
+	((CIPH_BLOCK*)p)->Header.dwSource = CIPH_SOURCE_PAGES;
+
+	return (CIPH_BLOCK*)p;
+}
+
+// CiphAllocEx ֐
+// 64 oCgEɑ cb oCg̍Ɨ̈mۂBmۂłȂꍇ NULL Ԃ
+// CIPH_ALLOC_NO_ZERO w肵ꍇ 0 ł̏Ȃ (Ŝ㏑o̓obt@Ȃ)
+// CIPH_ALLOC_LARGE_PAGES w肵ꍇATCYNX傫̈[Wy[WŊmۂ
+PVOID WINAPI CiphAllocEx(SIZE_T cb, DWORD dwFlags)
+{
+	CIPH_BLOCK* pBlock = NULL;
+	SIZE_T cbBlock = 2 * CIPH_ALLOC_ALIGN;
+	DWORD dwClass = 0;
+
+	if (cb > ((SIZE_T)-1) - CIPH_HUGE_PAGE)
+	{
+		return NULL;
+	}
+
+	while (dwClass < CIPH_POOL_CLASSES && cbBlock < cb + CIPH_ALLOC_ALIGN)
+	{
+		cbBlock <<= 1;
+		dwClass++;
+	}
+
+	if (dwClass < CIPH_POOL_CLASSES)
+	{
+		// Xbh̃A[iAvZXŜ̃v[Aʂ̃AP[^[̏ɒT
+		if (dwClass < CIPH_ARENA_CLASSES && ThreadArena.Free[dwClass] != NULL)
+		{
+			pBlock = ThreadArena.Free[dwClass];
+			ThreadArena.Free[dwClass] = pBlock->Header.pNext;
+			ThreadArena.Count[dwClass]--;
+		}
+
+		if (pBlock == NULL)
+		{
+			CiphLock(&PoolLock);
+			pBlock = PoolFree[dwClass];
+			if (pBlock != NULL)
+			{
+				PoolFree[dwClass] = pBlock->Header.pNext;
+				cbPool -= pBlock->Header.cbBlock;
+			}
+			CiphUnlock(&PoolLock);
+		}
+
+		if (pBlock == NULL)
+		{
+			pBlock = (CIPH_BLOCK*)BackingAlloc(BackingUser, cbBlock, CIPH_ALLOC_ALIGN);
+			if (pBlock == NULL)
+			{
+				return NULL;
+			}
+			pBlock->Header.cbBlock = cbBlock;
+			pBlock->Header.dwClass = dwClass;
+			pBlock->Header.dwSource = CIPH_SOURCE_BACKING;
+			pBlock->Header.Free = BackingFree;
+			pBlock->Header.pUser = BackingUser;
+		}
+	}
+	else
+	{
+		cbBlock = cb + CIPH_ALLOC_ALIGN;
+		if (BackingAlloc == CiphDefaultAlloc)
+		{
+			pBlock = CiphAllocPages(cbBlock, dwFlags);
+		}
+		else
+		{
+			pBlock = (CIPH_BLOCK*)BackingAlloc(BackingUser, cbBlock, CIPH_ALLOC_ALIGN);
+			if (pBlock != NULL)
+			{
+				pBlock->Header.cbBlock = cbBlock;
+				pBlock->Header.dwSource = CIPH_SOURCE_BACKING;
+				pBlock->Header.Free = BackingFree;
+				pBlock->Header.pUser = BackingUser;
+			}
+		}
+		if (pBlock == NULL)
+		{
+			return NULL;
+		}
+		pBlock->Header.dwClass = CIPH_POOL_CLASSES;
+	}
+
+	// OS ̃y[W͊mێ 0 ŏĂ
+	if (!(dwFlags & CIPH_ALLOC_NO_ZERO) && pBlock->Header.dwSource != CIPH_SOURCE_PAGES)
+	{
+		memset(pBlock + 1, 0, cb);
+	}
+	pBlock->Header.cbUsed = cb;
+
+	return pBlock + 1;
+}
+
+// CiphAlloc ֐
+// 0 ŏ cb oCg̍Ɨ̈mۂBmۂłȂꍇ NULL Ԃ
+PVOID WINAPI CiphAlloc(SIZE_T cb)
+{
+	return CiphAllocEx(cb, 0);
+}
+
+// CiphFree ֐
+// CiphAlloc, CiphAllocEx ŊmۂƗ̈
+// TCYNẌ̗̓Xbh̃A[i (𒴂ꍇ̓vZXŜ̃v[) ɖ߂čėp
+// ╽ėpɎcȂ悤ɁAOS ɕԂy[WȊO͊mێɗvꂽoCg 0 ŏĂ߂
+VOID WINAPI CiphFree(PVOID p)
+{
+	CIPH_BLOCK* pBlock;
+	DWORD dwClass;
+
+	if (p == NULL)
+	{
+		return;
+	}
+
+	pBlock = (CIPH_BLOCK*)p - 1;
+	dwClass = pBlock->Header.dwClass;
+	if (pBlock->Header.dwSource != CIPH_SOURCE_PAGES)
+	{
+		SecureZeroMemory(p, pBlock->Header.cbUsed);
+	}
+
+	if (dwClass == CIPH_POOL_CLASSES)
+	{
+		CiphReleaseBlock(pBlock);
+		return;
+	}
+
+	if (dwClass < CIPH_ARENA_CLASSES && !ThreadArena.bClosed && ThreadArena.Count[dwClass] < CIPH_ARENA_BLOCKS && ((SIZE_T)ThreadArena.Count[dwClass] + 1) * pBlock->Header.cbBlock <= CIPH_ARENA_BYTES)
+	{
+		pBlock->Header.pNext = ThreadArena.Free[dwClass];
+		ThreadArena.Free[dwClass] = pBlock;
+		ThreadArena.Count[dwClass]++;
+		return;
+	}
+
+	CiphPoolPush(pBlock);
+
+	return;
+}
+
+// CiphAllocTrim ֐
+// ĂяõXbh̃A[iƃvZXŜ̃v[ێĂ̈擾ɕԂ
+VOID WINAPI CiphAllocTrim()
+{
+	DWORD i;
+	CIPH_BLOCK* pList[CIPH_POOL_CLASSES];
+	CIPH_BLOCK* pBlock;
+
+	if (!ThreadArena.bClosed)
+	{
+		ThreadArena.Trim();
+	}
+
+	CiphLock(&PoolLock);
+	for (i = 0; i < CIPH_POOL_CLASSES; i++)
+	{
+		pList[i] = PoolFree[i];
+		PoolFree[i] = NULL;
+	}
+	cbPool = 0;
+	CiphUnlock(&PoolLock);
+
+	for (i = 0; i < CIPH_POOL_CLASSES; i++)
+	{
+		while (pList[i] != NULL)
+		{
+			pBlock = pList[i];
+			pList[i] = pBlock->Header.pNext;
+			CiphReleaseBlock(pBlock);
+		}
+	}
+
+	return;
+}
+
+// CiphSetBackingAllocator ֐
+// TCYNẌ̗mۂ鉺ʂ̃AP[^[ݒ肷BAlloc, Free  NULL ̏ꍇ͊ɖ߂
+// ݒ͈ȌɊmۂ̈悩LŁAݒOɊmۂ̈͊mۂAP[^[ŉ
+VOID WINAPI CiphSetBackingAllocator(CIPH_BACKING_ALLOC Alloc, CIPH_BACKING_FREE Free, PVOID pUser)
+{
+	if (Alloc == NULL || Free == NULL)
+	{
+		Alloc = CiphDefaultAlloc;
+		Free = CiphDefaultFree;
+		pUser = NULL;
+	}
+
+	CiphLock(&PoolLock);
+	BackingAlloc = Alloc;
+	BackingFree = Free;
+	BackingUser = pUser;
+	CiphUnlock(&PoolLock);
+
+	return;
+}
+
+// CiphRandom ֐
+// OS ̗킩 cbOut oCg̗擾
+// Windows  BCryptGenRandomAȊO getentropy (1 ̌Ăяo 256 oCg܂) gp
+BOOL WINAPI CiphRandom(BYTE* out, SIZE_T cbOut)
+{
+	SIZE_T cbCurrent;
+
+	while (cbOut != 0)
+	{
+#ifdef _WIN32
+		cbCurrent = cbOut < 0x80000000 ? cbOut : 0x80000000;
+		if (!BCRYPT_SUCCESS(BCryptGenRandom(NULL, out, (ULONG)cbCurrent, BCRYPT_USE_SYSTEM_PREFERRED_RNG)))
+		{
+			return FALSE;
+		}
+#else
+		cbCurrent = cbOut < 256 ? cbOut : 256;
+		if (getentropy(out, cbCurrent) != 0)
+		{
+			return FALSE;
+		}
+#endif
+		out += cbCurrent;
+		cbOut -= cbCurrent;
+	}
+
+	return TRUE;
+}
+
+// DetectCpuFeatures ֐
+// CPUID ߂pĎgp\Ȋg߂𒲂ׁACPU_FEATURE_* ̑gݍ킹Ԃ
+// AVX2  OS  YMM WX^ۑ (XGETBV ŊmF) ꍇ̂ݎgp\Ƃ
+// CiphAesNi.cpp  SSSE3  SSE4.1 킹ċăRpC邽߁AAES-NI  PCLMULQDQ  SSSE3  SSE4.1 ꍇ̂ݎgp\Ƃ
+DWORD WINAPI DetectCpuFeatures()
+{
+	DWORD dwFeatures = 0;
+#if defined(CIPH_X86)
+	INT CpuInfo[4], nIds;
+
+	__cpuid(CpuInfo, 0);
+	nIds = CpuInfo[0];
+
+	if (nIds >= 1)
+	{
+		__cpuid(CpuInfo, 1);
+		if (CpuInfo[2] & (1 << 9))
+		{
+			dwFeatures |= CPU_FEATURE_SSSE3;
+		}
+		if (CpuInfo[2] & (1 << 19))
+		{
+			dwFeatures |= CPU_FEATURE_SSE41;
+		}
+		if (CpuInfo[2] & (1 << 25))
+		{
+			dwFeatures |= CPU_FEATURE_AESNI;
+		}
+		if (CpuInfo[2] & (1 << 1))
+		{
+			dwFeatures |= CPU_FEATURE_PCLMUL;
+		}
+
+		// OSXSAVE LŁAXMM  YMM ̏Ԃ OS ɂۑꍇ̂ AVX2 gp
+		if ((CpuInfo[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6 && nIds >= 7)
+		{
+			__cpuidex(CpuInfo, 7, 0);
+			if (CpuInfo[1] & (1 << 5))
+			{
+				dwFeatures |= CPU_FEATURE_AVX2;
+			}
+		}
+	}
+
+	if (nIds >= 7)
+	{
+		__cpuidex(CpuInfo, 7, 0);
+		if (CpuInfo[1] & (1 << 8))
+		{
+			dwFeatures |= CPU_FEATURE_BMI2;
+		}
+	}
+
+	if ((dwFeatures & (CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE41)) != (CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE41))
+	{
+		dwFeatures &= ~(CPU_FEATURE_AESNI | CPU_FEATURE_PCLMUL);
+	}
+#endif
+
+	return dwFeatures;
+}
+
+// GetCpuFeatures ֐
+// gp\Ȋg߂ԂBCPUID ͍ŏ̌Ăяo 1 xs
+DWORD WINAPI GetCpuFeatures()
+{
+	static const DWORD dwFeatures = DetectCpuFeatures();
+
+	return dwFeatures;
+}
+
+VOID WINAPI Xor(BYTE* in1, BYTE* in2, DWORD cbIn, BYTE* out)
+{
+	DWORD i;
+
+	for (i = 0; i < cbIn; i++)
+	{
+		out[i] = in1[i] ^ in2[i];
+	}
+
+	return;
+}
+
+// Pkcs7PadBlock ֐
+// ̕sSȃubN (cbTail oCg)  PKCS#7 pfBOt 1 ubN쐬
+// ̓f[^ŜRs[AŌ̃ubNX^bNőgݗĂ
+VOID WINAPI Pkcs7PadBlock(BYTE* tail, DWORD cbTail, DWORD cbBlock, BYTE* block)
+{
+	memcpy(block, tail, cbTail);
+	memset(&block[cbTail], (BYTE)(cbBlock - cbTail), cbBlock - cbTail);
+
+	return;
+}
+
+// Pkcs7UnpadBlock ֐
+// Ō̃ubN PKCS#7 pfBO؂Af[^̃oCg擾
+// pfBOsȏꍇ FALSE Ԃ
+BOOL WINAPI Pkcs7UnpadBlock(BYTE* block, DWORD cbBlock, DWORD* pcbData)
+{
+	DWORD i;
+	BYTE cbPad = block[cbBlock - 1], bDiff = 0;
+
+	if (cbPad == 0 || cbPad > cbBlock)
+	{
+		return FALSE;
+	}
+
+	// pfBȎSoCg cbPad ƈv邩rŔɊmF
+	for (i = cbBlock - cbPad; i < cbBlock; i++)
+	{
+		bDiff |= block[i] ^ cbPad;
+	}
+
+	if (bDiff != 0)
+	{
+		return FALSE;
+	}
+
+	*pcbData = cbBlock - cbPad;
+
+	return TRUE;
+}
+
+// 񏈗̃Xbhv[
+// [J[Xbh͍ŏ̕񏈗ō쐬AvZX̏I܂ōėp
+// [J[͊e̗[L[ɐς܂ꂽ (PARALLEL_JOB) ̎Q擾ĎQ
+// [J[͎g̃L[̖ (Ōɐς܂ꂽ) oȀꍇ͑̃[J[̃L[̐擪 (łÂ) 瓐
+// ̍ڂ͎QXbh͈̔ (PARALLEL_RANGE) ɕĂAeXbh͎g͈̔͂̐擪 nChunk 擾ď
+// g͈̔͂ɂȂƁAc肪ł͈͂̌딼𓐂Ŏg͈̔͂Ƃ邽߁AxXbhQłȂQ̍ڂS
+// ĂяõXbh͈͂ASĂ͈̔͂ɂȂ܂œނ߁A[J[̏ōǂĂĂ͕Ki
+// Ăяo͍ڂȂȂƏϐ (ParallelDone) ŏ̃[J[̊҂ACPU Ȃ
+// 񏈗̌Ăяo ([J[ȊÕXbh) ɐA2 ڈȍ~̌Ăяo̐ԍ̑傫[J[x܂
+#define PARALLEL_MAX_WORKERS 64  // [J[Xbh̍ő吔
+#define PARALLEL_DEQUE_SIZE  64  // [J[̃L[ɐς߂Q̐
+#define PARALLEL_CHUNKS      4   // ׂς߁AQXbh 1 ɗpӂ؂̍ŏ
+
+// QXbh̍ڂ͈̔
+//  32 rbgɏ鍀ڂ̔ԍA 32 rbg͈͂̏IŁA͐擪AރXbh͌납 CAS Ŏ擾
+// ׂ͈̔͂ƃLbVCLȂ悤 64 oCgƂ
+typedef struct
+{
+	std::atomic<ULONG64> Range;
+	BYTE Pad[64 - sizeof(ULONG64)];
+} PARALLEL_RANGE;
+
+#define PARALLEL_RANGE_MAKE(First, End) (((ULONG64)(End) << 32) | (DWORD)(First))
+#define PARALLEL_RANGE_FIRST(Range)     ((DWORD)(Range))
+#define PARALLEL_RANGE_END(Range)       ((DWORD)((Range) >> 32))
+
+// 񏈗
+typedef struct
+{
+	PARALLEL_WORKER Worker;
+	PVOID pParam;
+	DWORD nItems;
+	DWORD nChunk;                // 1 xɎ擾鍀ڐ
+	DWORD nRanges;               // ͈͂̐ (ĂяoƎQ̐)
+	std::atomic<DWORD> nJoined;  // ͈͂蓖ĂXbh̐ (0 Ԗڂ͌Ăяo)
+	std::atomic<LONG> nActive;   // Q擾ď̃[J[̐
+	PARALLEL_RANGE Ranges[PARALLEL_MAX_WORKERS + 1];
+} PARALLEL_JOB;
+
+// [J[̗[L[ (Q̃Oobt@)
+// ꂽQ NULL ɂȂ
+typedef struct
+{
+	CIPH_LOCK Lock;
+	PARALLEL_JOB* Jobs[PARALLEL_DEQUE_SIZE];
+	DWORD dwHead;
+	DWORD dwTail;
+} PARALLEL_DEQUE;
+
+static PARALLEL_DEQUE Deques[PARALLEL_MAX_WORKERS];
+static std::atomic<LONG> nPending(0);       // L[ɐς܂ĂQ̐
+static std::atomic<DWORD> nWorkers(0);      // 쐬[J[̐
+static std::atomic<DWORD> nAllowedWorkers(0xffffffff); // Qł郏[J[̐ (0xffffffff ͖ݒ)
+static std::atomic<DWORD> dwNextDeque(0);   // Qςݎn߂L[
+static std::atomic<DWORD> nCallers(0);      // 񏈗̌Ăяo ([J[ȊÕXbh) ̐
+static CIPH_LOCK ParallelLock = CIPH_LOCK_INIT;
+static CIPH_COND ParallelWake = CIPH_COND_INIT; // Qς܂ꂽA܂͎Qł郏[J[̐
+static CIPH_COND ParallelDone = CIPH_COND_INIT; // ̃[J[̐ 0 ɂȂ
+static thread_local DWORD dwWorkerIndex = PARALLEL_MAX_WORKERS; // [J[Xbh̔ԍ ([J[ȊO PARALLEL_MAX_WORKERS)
+
+// ParallelClaim ֐
+// dwRange Ԗڂ͈̔͂̐擪ő nChunk ̍ڂ擾B͈͂̏ꍇ FALSE Ԃ
+BOOL WINAPI ParallelClaim(PARALLEL_JOB* pJob, DWORD dwRange, DWORD* pdwFirst, DWORD* pnCount)
+{
+	std::atomic<ULONG64>* pRange = &pJob->Ranges[dwRange].Range;
+	ULONG64 Range = *pRange;
+	DWORD dwFirst, dwEnd, nCount;
+
+	do
+	{
+		dwFirst = PARALLEL_RANGE_FIRST(Range);
+		dwEnd = PARALLEL_RANGE_END(Range);
+		if (dwFirst >= dwEnd)
+		{
+			return FALSE;
+		}
+		nCount = dwEnd - dwFirst < pJob->nChunk ? dwEnd - dwFirst : pJob->nChunk;
+	} while (!pRange->compare_exchange_weak(Range, PARALLEL_RANGE_MAKE(dwFirst + nCount, dwEnd)));
+
+	*pdwFirst = dwFirst;
+	*pnCount = nCount;
+
+	return TRUE;
+}
+
+// ParallelSteal ֐
+// c肪ł͈̔͂̌딼 (c肪 nChunk ȉ̏ꍇ͑S) 𓐂݁AdwRange Ԗڂ͈̔͂Ƃ
+// SĂ͈̔͂̏ꍇ FALSE Ԃ
+BOOL WINAPI ParallelSteal(PARALLEL_JOB* pJob, DWORD dwRange)
+{
+	ULONG64 Range;
+	DWORD i, dwVictim, nRemain, nBest, dwFirst, dwEnd, dwSplit;
+
+	for (;;)
+	{
+		dwVictim = dwRange;
+		nBest = 0;
+		for (i = 0; i < pJob->nRanges; i++)
+		{
+			Range = pJob->Ranges[i].Range;
+			nRemain = PARALLEL_RANGE_FIRST(Range) < PARALLEL_RANGE_END(Range) ? PARALLEL_RANGE_END(Range) - PARALLEL_RANGE_FIRST(Range) : 0;
+			if (i != dwRange && nRemain > nBest)
+			{
+				dwVictim = i;
+				nBest = nRemain;
+			}
+		}
+		if (nBest == 0)
+		{
+			return FALSE;
+		}
+
+		// 傪擪擾Ĕ͈͂ςĂꍇ́AIђ
+		Range = pJob->Ranges[dwVictim].Range;
+		dwFirst = PARALLEL_RANGE_FIRST(Range);
+		dwEnd = PARALLEL_RANGE_END(Range);
+		if (dwFirst >= dwEnd)
+		{
+			continue;
+		}
+		dwSplit = dwEnd - dwFirst <= pJob->nChunk ? dwFirst : dwEnd - (dwEnd - dwFirst) / 2;
+		if (pJob->Ranges[dwVictim].Range.compare_exchange_strong(Range, PARALLEL_RANGE_MAKE(dwFirst, dwSplit)))
+		{
+			pJob->Ranges[dwRange].Range = PARALLEL_RANGE_MAKE(dwSplit, dwEnd);
+			return TRUE;
+		}
+	}
+}
+
+// ParallelRunChunks ֐
+// dwRange Ԗڂ͈̔͂̍ڂ nChunk A͈͂ɂȂƑ͈̔͂瓐ŁASĂ͈̔͂ɂȂ܂ŏ
+VOID WINAPI ParallelRunChunks(PARALLEL_JOB* pJob, DWORD dwRange)
+{
+	DWORD dwFirst, nCount;
+
+	do
+	{
+		while (ParallelClaim(pJob, dwRange, &dwFirst, &nCount))
+		{
+			pJob->Worker(pJob->pParam, dwFirst, nCount);
+		}
+	} while (ParallelSteal(pJob, dwRange));
+
+	return;
+}
+
+// ParallelPush ֐
+// dwIndex Ԗڂ̃[J[̃L[̖ɎQςށBL[t̏ꍇ FALSE Ԃ
+BOOL WINAPI ParallelPush(DWORD dwIndex, PARALLEL_JOB* pJob)
+{
+	PARALLEL_DEQUE* pDeque = &Deques[dwIndex];
+	BOOL bResult = FALSE;
+
+	CiphLock(&pDeque->Lock);
+	if (pDeque->dwTail - pDeque->dwHead < PARALLEL_DEQUE_SIZE)
+	{
+		pDeque->Jobs[pDeque->dwTail % PARALLEL_DEQUE_SIZE] = pJob;
+		pDeque->dwTail++;
+		nPending++;
+		bResult = TRUE;
+	}
+	CiphUnlock(&pDeque->Lock);
+
+	return bResult;
+}
+
+// ParallelTake ֐
+// dwIndex Ԗڂ̃[J[̃L[QoBbSteal  FALSE ̏ꍇ͖ATRUE ̏ꍇ͐擪o
+// o nActive ̓L[̃bNɑ₷߁AParallelRevoke ̌ɏQƂ邱Ƃ͂Ȃ
+PARALLEL_JOB* WINAPI ParallelTake(DWORD dwIndex, BOOL bSteal)
+{
+	PARALLEL_DEQUE* pDeque = &Deques[dwIndex];
+	PARALLEL_JOB* pJob = NULL;
+
+	CiphLock(&pDeque->Lock);
+	while (pJob == NULL && pDeque->dwHead != pDeque->dwTail)
+	{
+		if (bSteal)
+		{
+			pJob = pDeque->Jobs[pDeque->dwHead % PARALLEL_DEQUE_SIZE];
+			pDeque->dwHead++;
+		}
+		else
+		{
+			pDeque->dwTail--;
+			pJob = pDeque->Jobs[pDeque->dwTail % PARALLEL_DEQUE_SIZE];
+		}
+	}
+	if (pJob != NULL)
+	{
+		pJob->nActive++;
+		nPending--;
+	}
+	CiphUnlock(&pDeque->Lock);
+
+	return pJob;
+}
+
+// ParallelRevoke ֐
+// SẴL[珈̎Q
+VOID WINAPI ParallelRevoke(PARALLEL_JOB* pJob)
+{
+	DWORD i, j, n = nWorkers;
+	PARALLEL_DEQUE* pDeque;
+
+	for (i = 0; i < n; i++)
+	{
+		pDeque = &Deques[i];
+		CiphLock(&pDeque->Lock);
+		for (j = pDeque->dwHead; j != pDeque->dwTail; j++)
+		{
+			if (pDeque->Jobs[j % PARALLEL_DEQUE_SIZE] == pJob)
+			{
+				pDeque->Jobs[j % PARALLEL_DEQUE_SIZE] = NULL;
+				nPending--;
+			}
+		}
+		CiphUnlock(&pDeque->Lock);
+	}
+
+	return;
+}
+
+// ParallelWorkerAllowed ֐
+// dwIndex Ԗڂ̃[J[Qł邩Ԃ
+//  - 1 ̃[J[̂A2 ڈȍ~̌Ăяo̐ԍ̑傫[J[
+BOOL WINAPI ParallelWorkerAllowed(DWORD dwIndex)
+{
+	DWORD n = nCallers;
+
+	return dwIndex + (n > 1 ? n - 1 : 0) < nAllowedWorkers;
+}
+
+// ParallelLeave ֐
+// [J[甲BŌ̃[J[̏ꍇ͊҂ĂяoN
+// Ăяo ParallelLock 擾 nActive mF邽߁AbNɌ炵͏QƂȂ
+VOID WINAPI ParallelLeave(PARALLEL_JOB* pJob)
+{
+	CiphLock(&ParallelLock);
+	if (--pJob->nActive == 0)
+	{
+		CiphCondWakeAll(&ParallelDone);
+	}
+	CiphUnlock(&ParallelLock);
+
+	return;
+}
+
+// ParallelThreadProc ֐
+// [J[Xbh̊Jn֐
+// g̃L[Ã[J[̃L[̏ɎQTAȂꍇ͎Qς܂܂őҋ@
+#ifdef _WIN32
+DWORD WINAPI ParallelThreadProc(LPVOID lpParameter)
+#else
+PVOID ParallelThreadProc(PVOID lpParameter)
+#endif
+{
+	DWORD i, n;
+	PARALLEL_JOB* pJob;
+
+	dwWorkerIndex = (DWORD)(ULONG_PTR)lpParameter;
+
+	for (;;)
+	{
+		pJob = NULL;
+		if (ParallelWorkerAllowed(dwWorkerIndex))
+		{
+			pJob = ParallelTake(dwWorkerIndex, FALSE);
+			for (i = 1, n = nWorkers; pJob == NULL && i < n; i++)
+			{
+				pJob = ParallelTake((dwWorkerIndex + i) % n, TRUE);
+			}
+		}
+
+		if (pJob != NULL)
+		{
+			ParallelRunChunks(pJob, pJob->nJoined.fetch_add(1));
+			ParallelLeave(pJob);
+			continue;
+		}
+
+		CiphLock(&ParallelLock);
+		while (nPending <= 0 || !ParallelWorkerAllowed(dwWorkerIndex))
+		{
+			CiphCondWait(&ParallelWake, &ParallelLock);
+		}
+		CiphUnlock(&ParallelLock);
+	}
+
+	return 0;
+}
+
+// GetProcessorCount ֐
+// _vZbTԂ
+DWORD WINAPI GetProcessorCount()
+{
+#ifdef _WIN32
+	SYSTEM_INFO SystemInfo;
+
+	GetSystemInfo(&SystemInfo);
+
+	return SystemInfo.dwNumberOfProcessors != 0 ? SystemInfo.dwNumberOfProcessors : 1;
+#else
+	LONG nProcessors = (LONG)sysconf(_SC_NPROCESSORS_ONLN);
+
+	return nProcessors > 0 ? (DWORD)nProcessors : 1;
+#endif
+}
+
+// DetectCacheSize ֐
+// 1 RA L2 LbṼoCgԂB擾łȂꍇ 256 KB Ƃ
+DWORD WINAPI DetectCacheSize()
+{
+	DWORD cbCache = 0;
+#ifdef _WIN32
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION Info[256];
+	DWORD i, cbInfo = sizeof(Info);
+
+	if (GetLogicalProcessorInformation(Info, &cbInfo))
+	{
+		for (i = 0; i < cbInfo / sizeof(Info[0]); i++)
+		{
+			if (Info[i].Relationship == RelationCache && Info[i].Cache.Level == 2 && Info[i].Cache.Size > cbCache)
+			{
+				cbCache = Info[i].Cache.Size;
+			}
+		}
+	}
+#elif defined(_SC_LEVEL2_CACHE_SIZE)
+	LONG cbLevel2 = (LONG)sysconf(_SC_LEVEL2_CACHE_SIZE);
+
+	if (cbLevel2 > 0)
+	{
+		cbCache = (DWORD)cbLevel2;
+	}
+#endif
+
+	return cbCache != 0 ? cbCache : 0x40000;
+}
+
+// GetCacheSize ֐
+// 1 RA L2 LbṼoCgԂBŏ̌Ăяo 1 xׂ
+DWORD WINAPI GetCacheSize()
+{
+	static const DWORD cbCache = DetectCacheSize();
+
+	return cbCache;
+}
+
+// SetParallelConcurrency ֐
+// 񏈗ɎQXbh (ĂяõXbh܂) ̃vZXŜ̏ݒ肷
+// 0 ̏ꍇ͘_vZbTƂB[J[Xbh͏ - 1 ܂łƂȂA͎ɏグ܂őҋ@
+// ̃Xbhɕ񏈗Ăяoꍇ́A2 ڈȍ~̌Ăяo̐Q郏[J[炷
+VOID WINAPI SetParallelConcurrency(DWORD dwThreads)
+{
+	if (dwThreads == 0)
+	{
+		dwThreads = GetProcessorCount();
+	}
+	if (dwThreads > PARALLEL_MAX_WORKERS + 1)
+	{
+		dwThreads = PARALLEL_MAX_WORKERS + 1;
+	}
+
+	CiphLock(&ParallelLock);
+	nAllowedWorkers = dwThreads - 1;
+	CiphCondWakeAll(&ParallelWake);
+	CiphUnlock(&ParallelLock);
+
+	// Xbhɍ킹Ďs@臒l𑪒肵
+	CalibrateDispatch();
+
+	return;
+}
+
+// GetParallelConcurrency ֐
+// 񏈗ɎQXbh (ĂяõXbh܂) ̏Ԃ
+DWORD WINAPI GetParallelConcurrency()
+{
+	DWORD dwAllowed = nAllowedWorkers;
+
+	if (dwAllowed == 0xffffffff)
+	{
+		dwAllowed = GetProcessorCount() - 1;
+		if (dwAllowed > PARALLEL_MAX_WORKERS)
+		{
+			dwAllowed = PARALLEL_MAX_WORKERS;
+		}
+	}
+
+	return dwAllowed + 1;
+}
+
+// ParallelStartWorkers ֐
+// ܂ł̃[J[Xbh쐬A쐬ς݂̃[J[̐Ԃ
+DWORD WINAPI ParallelStartWorkers()
+{
+	DWORD dwAllowed = GetParallelConcurrency() - 1;
+#ifdef _WIN32
+	HANDLE hThread;
+#else
+	pthread_t hThread;
+#endif
+
+	if (nWorkers >= dwAllowed)
+	{
+		return nWorkers;
+	}
+
+	CiphLock(&ParallelLock);
+	if (nAllowedWorkers == 0xffffffff)
+	{
+		nAllowedWorkers = dwAllowed;
+	}
+	while (nWorkers < dwAllowed)
+	{
+		CiphLockInit(&Deques[nWorkers].Lock);
+#ifdef _WIN32
+		hThread = CreateThread(NULL, 0, ParallelThreadProc, (LPVOID)(ULONG_PTR)nWorkers.load(), 0, NULL);
+		if (hThread == NULL)
+		{
+			break;
+		}
+		CloseHandle(hThread);
+#else
+		if (pthread_create(&hThread, NULL, ParallelThreadProc, (PVOID)(ULONG_PTR)nWorkers.load()) != 0)
+		{
+			break;
+		}
+		pthread_detach(hThread);
+#endif
+		nWorkers++;
+	}
+	CiphUnlock(&ParallelLock);
+
+	return nWorkers;
+}
+
+// RunParallelEx ֐
+// nItems ̍ڂXbhv[ŕɏBSڂ̏I܂Ŗ߂Ȃ
+// cbItem  1 ڂ̃oCg̖ڈŁA1 xɎ擾鍀ڐ L2 LbV̔Ɏ܂ʂƂ (0 ̏ꍇ͍ڐ݂̂Ō߂)
+// dwThreads ͎QXbh (ĂяõXbh܂) ̏ŁA0 ̏ꍇ̓vZXŜ̏Ƃ
+// ؂肪 1 Ȃꍇ 1 ̏ꍇ́AĂяõXbhőSڂ
+// ڂ͌ĂяoƎQ͈̐̔͂ɋϓɕAĂяo 0 ԖځAQ擾[J[͎Q͈̔͂
+// Ăяo͎g͈̔͂A͈̔͂瓐߂ȂȂɎc̎QāÃ[J[̊ϐő҂
+// [J[ȊOĂяoꍇ͕񏈗̌ĂяoƂĐAɌĂяoꂽXbh܂߂ď𒴂Ȃ悤ɂ
+VOID WINAPI RunParallelEx(PARALLEL_WORKER Worker, PVOID pParam, DWORD nItems, SIZE_T cbItem, DWORD dwThreads)
+{
+	PARALLEL_JOB Job;
+	DWORD i, nChunk, nChunks, nTickets, nStarted, dwFirst;
+	DWORD dwLimit = GetParallelConcurrency();
+	BOOL bCaller;
+
+	if (nItems == 0)
+	{
+		return;
+	}
+	if (dwThreads == 0 || dwThreads > dwLimit)
+	{
+		dwThreads = dwLimit;
+	}
+
+	// ؂̑傫 : L2 LbV̔ (͂Əo͂܂) 𒴂AQXbh PARALLEL_CHUNKS ȏ̋؂pӂ
+	nChunk = nItems / (dwThreads * PARALLEL_CHUNKS);
+	if (cbItem != 0 && (SIZE_T)nChunk * cbItem > GetCacheSize() / 2)
+	{
+		nChunk = (DWORD)(GetCacheSize() / 2 / cbItem);
+	}
+	if (nChunk == 0)
+	{
+		nChunk = 1;
+	}
+	nChunks = nItems / nChunk + (nItems % nChunk != 0 ? 1 : 0);
+
+	if (dwThreads <= 1 || nChunks <= 1)
+	{
+		Worker(pParam, 0, nItems);
+		return;
+	}
+
+	nStarted = ParallelStartWorkers();
+	nTickets = dwThreads - 1 < nChunks - 1 ? dwThreads - 1 : nChunks - 1;
+	if (nTickets > nStarted)
+	{
+		nTickets = nStarted;
+	}
+	if (nTickets == 0)
+	{
+		Worker(pParam, 0, nItems);
+		return;
+	}
+
+	Job.Worker = Worker;
+	Job.pParam = pParam;
+	Job.nItems = nItems;
+	Job.nChunk = nChunk;
+	Job.nRanges = nTickets + 1;
+	Job.nJoined = 1;
+	Job.nActive = 0;
+	for (i = 0; i < Job.nRanges; i++)
+	{
+		Job.Ranges[i].Range = PARALLEL_RANGE_MAKE((ULONG64)nItems * i / Job.nRanges, (ULONG64)nItems * (i + 1) / Job.nRanges);
+	}
+
+	// [J[Ăяoꂽꍇ (q̕񏈗) ̓[J[ƂĐĂ邽߁AĂяoɂ͐Ȃ
+	bCaller = dwWorkerIndex >= PARALLEL_MAX_WORKERS;
+	if (bCaller)
+	{
+		nCallers++;
+	}
+
+	// [J[Ăяoꂽꍇ (q̕񏈗) ͎g̃L[ς
+	dwFirst = dwWorkerIndex < nStarted ? dwWorkerIndex : dwNextDeque.fetch_add(1) % nStarted;
+	for (i = 0; i < nTickets; i++)
+	{
+		ParallelPush((dwFirst + i) % nStarted, &Job);
+	}
+
+	CiphLock(&ParallelLock);
+	CiphCondWakeAll(&ParallelWake);
+	CiphUnlock(&ParallelLock);
+
+	ParallelRunChunks(&Job, 0);
+	ParallelRevoke(&Job);
+
+	// x܂Ă[J[͌ĂяoƎQł悤ɂȂ邽߁Aҋ@̃[J[N
+	CiphLock(&ParallelLock);
+	while (Job.nActive != 0)
+	{
+		CiphCondWait(&ParallelDone, &ParallelLock);
+	}
+	if (bCaller && nCallers-- > 1)
+	{
+		CiphCondWakeAll(&ParallelWake);
+	}
+	CiphUnlock(&ParallelLock);
+
+	return;
+}
+
+// RunParallel ֐
+// nItems ̍ڂXbhv[ŕɏ (1 ڂ̃oCgw肵Ȃ RunParallelEx)
+// dwThreads  0 ̏ꍇ̓vZXŜ̏ƂBSڂĂ߂
+VOID WINAPI RunParallel(PARALLEL_WORKER Worker, PVOID pParam, DWORD nItems, DWORD dwThreads)
+{
+	RunParallelEx(Worker, pParam, nItems, 0, dwThreads);
+
+	return;
+}
+
+// GetTimeNs ֐
+// PoߎԂimbŕԂ (Windows  QueryPerformanceCounterAȊO CLOCK_MONOTONIC)
+ULONG64 WINAPI GetTimeNs()
+{
+#ifdef _WIN32
+	LARGE_INTEGER Counter, Frequency;
+
+	QueryPerformanceFrequency(&Frequency);
+	QueryPerformanceCounter(&Counter);
+
+	return (ULONG64)(Counter.QuadPart / Frequency.QuadPart) * 1000000000 + (ULONG64)(Counter.QuadPart % Frequency.QuadPart) * 1000000000 / (ULONG64)Frequency.QuadPart;
+#else
+	struct timespec Time;
+
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+
+	return (ULONG64)Time.tv_sec * 1000000000 + (ULONG64)Time.tv_nsec;
+#endif
+}
+
+// s@̑I
+// 񏈗̏vԂ́u󂯓n̎ H + 1 Xbh̏ / nvŋߎł邽߁A
+// 1 Xbh̏ԂƂ̍ (cb * (1 - 1 / n) * 1 oCg̎)  H  DISPATCH_OVERHEAD_RATIO {ƂȂoCg臒lƂ
+// H ̓[J[ҋ@ԂNċ؂AĂяomF܂ł܂߂đ肷
+//  DispatchLock  1 ̃XbhɌAʂ̓GWE[hɏ㏑ (̃Xbh͌ÂlVl̂ꂩǂ)
+#define DISPATCH_SAMPLE_BYTES   0x00010000 // x̑ɎgoCg (64 KB)
+#define DISPATCH_MIN_THREADED   0x00004000 // 񏈗ɐ؂ւŏ̃oCg
+#define DISPATCH_DEFAULT        0x00100000 // łȂꍇ臒l (1 MB)
+#define DISPATCH_OVERHEAD_RATIO 4
+#define DISPATCH_HANDOFF_RUNS   8          // 󂯓n̎Ԃ𑪒肷
+#define DISPATCH_SPIN_NS        5000       // 󂯓n̎Ԃ̑ 1 ̋؂ɔ₷
+
+static std::atomic<DWORD> dwDispatchMode(DISPATCH_AUTO);
+static std::atomic<SIZE_T> DispatchOverride[DISPATCH_KINDS];   // w肳ꂽ臒l (0 ͖w)
+static std::atomic<SIZE_T> DispatchCalibrated[DISPATCH_KINDS]; // 肵臒l (0 ͖)
+static DISPATCH_SAMPLE DispatchSamples[DISPATCH_KINDS];        // Ɏg (eGW̐ÓIȏœo^)
+static PVOID DispatchSampleParams[DISPATCH_KINDS];
+static DWORD dwDispatchThreads = 0;                            // 臒l𑪒肵̕񏈗̃Xbh (DispatchLock ŕی)
+static ULONG64 DispatchHandoffNs = 0;                          // 肵󂯓n̎ (DispatchLock ŕی)
+static CIPH_LOCK DispatchLock = CIPH_LOCK_INIT;
+
+// ReadDispatchEnvironment ֐
+// ϐ CIPH_DISPATCH s@ǂݍ
+// serial, interleaved, threaded, auto ̂ꂩA܂͑SẴGWE[h臒l̃oCgwł
+BOOL WINAPI ReadDispatchEnvironment()
+{
+	CHAR Value[32];
+	ULONG64 cbThreaded;
+	DWORD i;
+#ifdef _WIN32
+	DWORD cchValue = GetEnvironmentVariableA("CIPH_DISPATCH", Value, sizeof(Value));
+
+	if (cchValue == 0 || cchValue >= sizeof(Value))
+	{
+		return FALSE;
+	}
+#else
+	const CHAR* pValue = getenv("CIPH_DISPATCH");
+
+	if (pValue == NULL || strlen(pValue) >= sizeof(Value))
+	{
+		return FALSE;
+	}
+	memcpy(Value, pValue, strlen(pValue) + 1);
+#endif
+
+	if (strcmp(Value, "serial") == 0)
+	{
+		dwDispatchMode = DISPATCH_SERIAL;
+	}
+	else if (strcmp(Value, "interleaved") == 0)
+	{
+		dwDispatchMode = DISPATCH_INTERLEAVED;
+	}
+	else if (strcmp(Value, "threaded") == 0)
+	{
+		dwDispatchMode = DISPATCH_THREADED;
+	}
+	else if (Value[0] >= '0' && Value[0] <= '9')
+	{
+		cbThreaded = strtoull(Value, NULL, 10);
+		for (i = 0; i < DISPATCH_KINDS; i++)
+		{
+			DispatchOverride[i] = (SIZE_T)cbThreaded;
+		}
+	}
+
+	return TRUE;
+}
+
+// DispatchInit ֐
+// ŏ̌Ăяo 1 xϐǂݍ (SetDispatchMode ȂǂŌォύXł)
+VOID WINAPI DispatchInit()
+{
+	static const BOOL bEnvironment = ReadDispatchEnvironment();
+
+	(VOID)bEnvironment;
+
+	return;
+}
+
+// DispatchSpinWorker ֐
+// 󂯓n̎Ԃ̑ɎgƊ֐B1 ڂ DISPATCH_SPIN_NS imb҂
+VOID WINAPI DispatchSpinWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	ULONG64 Start = GetTimeNs();
+
+	(VOID)pParam;
+	(VOID)dwFirst;
+
+	while (GetTimeNs() - Start < (ULONG64)DISPATCH_SPIN_NS * dwCount)
+	{
+	}
+
+	return;
+}
+
+// MeasureHandoff ֐
+// dwThreads ̃Xbhŋ؂ԂAzIȕ񏈗̎Ԃ󂯓n̎ (imb) 𑪒肷
+// ŏ 1 ̓[J[Xbh̍쐬܂ނߏADISPATCH_HANDOFF_RUNS ̕ςƂ
+ULONG64 WINAPI MeasureHandoff(DWORD dwThreads)
+{
+	DWORD i, nItems = dwThreads * PARALLEL_CHUNKS;
+	ULONG64 Start, Elapsed, Ideal = (ULONG64)DISPATCH_SPIN_NS * PARALLEL_CHUNKS * DISPATCH_HANDOFF_RUNS;
+
+	RunParallelEx(DispatchSpinWorker, NULL, nItems, 0, dwThreads);
+
+	Start = GetTimeNs();
+	for (i = 0; i < DISPATCH_HANDOFF_RUNS; i++)
+	{
+		RunParallelEx(DispatchSpinWorker, NULL, nItems, 0, dwThreads);
+	}
+	Elapsed = GetTimeNs() - Start;
+
+	return Elapsed > Ideal + DISPATCH_HANDOFF_RUNS * 1000 ? (Elapsed - Ideal) / DISPATCH_HANDOFF_RUNS : 1000;
+}
+
+// RegisterDispatchSample ֐
+// dwKind ̃GWE[h臒l̑Ɏgo^
+// eGW̐ÓIȏŌĂяo߁Az͐ÓI 0 ݂̂Ƃ
+VOID WINAPI RegisterDispatchSample(DWORD dwKind, DISPATCH_SAMPLE Sample, PVOID pParam)
+{
+	if (dwKind < DISPATCH_KINDS)
+	{
+		DispatchSamples[dwKind] = Sample;
+		DispatchSampleParams[dwKind] = pParam;
+	}
+
+	return;
+}
+
+// MeasureDispatchKind ֐
+// dwKind ̃GWE[h臒lAo^ꂽ̏xƎ󂯓n̎ Handoff 狁߂
+SIZE_T WINAPI MeasureDispatchKind(DWORD dwKind, DWORD dwThreads, ULONG64 Handoff, BYTE* buf)
+{
+	ULONG64 Start, Elapsed, cbThreaded;
+	DISPATCH_SAMPLE Sample = DispatchSamples[dwKind];
+	PVOID pParam = DispatchSampleParams[dwKind];
+
+	// ŏ̌Ăяo̓LbVւ̓ǂݍ݂܂ނ߁Aȓ͂ 1 xĂ瑪肷
+	Sample(pParam, buf, DISPATCH_SAMPLE_BYTES / 16);
+	Start = GetTimeNs();
+	Sample(pParam, buf, DISPATCH_SAMPLE_BYTES);
+	Elapsed = GetTimeNs() - Start;
+
+	cbThreaded = DISPATCH_OVERHEAD_RATIO * Handoff * DISPATCH_SAMPLE_BYTES * dwThreads / ((Elapsed != 0 ? Elapsed : 1) * (dwThreads - 1));
+	if (cbThreaded < DISPATCH_MIN_THREADED)
+	{
+		cbThreaded = DISPATCH_MIN_THREADED;
+	}
+	if (cbThreaded > (SIZE_T)-1)
+	{
+		cbThreaded = (SIZE_T)-1;
+	}
+
+	return (SIZE_T)cbThreaded;
+}
+
+// CalibrateDispatch ֐
+// o^ꂽSẴGWE[h臒l𑪒肷 (臒lw肳ꂽGWE[h͏)
+// 񏈗̃Xbh (_vZbT𒴂Ȃ) ȎƓꍇ́ÃGWE[ĥݑ肷
+// 1 XbhgȂꍇ͕񏈗I΂Ȃ
+// SetParallelConcurrency, SetDispatchMode Ȃǂ̐ݒ C C^[tF[X CiphCalibrateDispatch ĂяoA̍쐬f[^̏ɂ͌ĂяoȂ
+VOID WINAPI CalibrateDispatch()
+{
+	DWORD i, n = GetParallelConcurrency();
+	BOOL bRemeasure, bHandoff = FALSE;
+	BYTE* buf = NULL;
+
+	DispatchInit();
+	if (dwDispatchMode != DISPATCH_AUTO)
+	{
+		return;
+	}
+	if (n > GetProcessorCount())
+	{
+		n = GetProcessorCount();
+	}
+
+	CiphLock(&DispatchLock);
+	bRemeasure = dwDispatchThreads != n;
+	for (i = 0; i < DISPATCH_KINDS; i++)
+	{
+		if (DispatchSamples[i] == NULL || DispatchOverride[i] != 0 || (!bRemeasure && DispatchCalibrated[i] != 0))
+		{
+			continue;
+		}
+
+		if (n <= 1)
+		{
+			DispatchCalibrated[i] = (SIZE_T)-1;
+			continue;
+		}
+		if (buf == NULL)
+		{
+			buf = (BYTE*)CiphAlloc(DISPATCH_SAMPLE_BYTES);
+			if (buf == NULL)
+			{
+				break;
+			}
+		}
+		if (!bHandoff && (bRemeasure || DispatchHandoffNs == 0))
+		{
+			DispatchHandoffNs = MeasureHandoff(n);
+		}
+		bHandoff = TRUE;
+		DispatchCalibrated[i] = MeasureDispatchKind(i, n, DispatchHandoffNs, buf);
+	}
+	if (buf != NULL)
+	{
+		SecureZeroMemory(buf, DISPATCH_SAMPLE_BYTES);
+		CiphFree(buf);
+	}
+	dwDispatchThreads = n;
+	CiphUnlock(&DispatchLock);
+
+	return;
+}
+
+// SelectDispatch ֐
+// dwKind ̃GWE[h cb oCgs@ (DISPATCH_SERIAL, DISPATCH_INTERLEAVED, DISPATCH_THREADED) I
+// cbInterleave  1 ubNA臒l͌ݏA臒lȏ͕񏈗Ƃ
+// 臒l͎w肳ꂽlA肵l (CalibrateDispatch)ADISPATCH_DEFAULT ̏ɗpAł͑肵Ȃ
+DWORD WINAPI SelectDispatch(DWORD dwKind, SIZE_T cb, SIZE_T cbInterleave)
+{
+	DWORD dwMode;
+	SIZE_T cbThreaded;
+
+	DispatchInit();
+	dwMode = dwDispatchMode;
+	if (dwMode != DISPATCH_AUTO)
+	{
+		return dwMode;
+	}
+	if (cb < cbInterleave)
+	{
+		return DISPATCH_SERIAL;
+	}
+
+	cbThreaded = DispatchOverride[dwKind];
+	if (cbThreaded == 0)
+	{
+		cbThreaded = DispatchCalibrated[dwKind];
+	}
+	if (cbThreaded == 0)
+	{
+		cbThreaded = DISPATCH_DEFAULT;
+	}
+
+	return cb >= cbThreaded && GetParallelConcurrency() > 1 ? DISPATCH_THREADED : DISPATCH_INTERLEAVED;
+}
+
+// SetDispatchMode ֐
+// s@Œ肷 (DISPATCH_AUTO ̏ꍇ臒lőIA臒lő肷)
+VOID WINAPI SetDispatchMode(DWORD dwMode)
+{
+	DispatchInit();
+	if (dwMode <= DISPATCH_THREADED)
+	{
+		dwDispatchMode = dwMode;
+	}
+	CalibrateDispatch();
+
+	return;
+}
+
+// SetDispatchThreshold ֐
+// dwKind ̃GWE[h (DISPATCH_ALL_KINDS ̏ꍇ͑S) ŕ񏈗ɐ؂ւoCgw肷
+// 0 ̏ꍇ͑肵臒lɖ߂ (̏ꍇ͂ő肷)A(SIZE_T)-1 ̏ꍇ͕񏈗I΂Ȃ
+VOID WINAPI SetDispatchThreshold(DWORD dwKind, SIZE_T cbThreaded)
+{
+	DWORD i;
+
+	DispatchInit();
+	for (i = 0; i < DISPATCH_KINDS; i++)
+	{
+		if (dwKind == i || dwKind == DISPATCH_ALL_KINDS)
+		{
+			DispatchOverride[i] = cbThreaded;
+		}
+	}
+	if (cbThreaded == 0)
+	{
+		CalibrateDispatch();
+	}
+
+	return;
+}
+
+// GetDispatchThreshold ֐
+// dwKind ̃GWE[hŕ񏈗ɐ؂ւoCgԂ (wĂȂꍇ 0)
+SIZE_T WINAPI GetDispatchThreshold(DWORD dwKind)
+{
+	SIZE_T cbThreaded;
+
+	if (dwKind >= DISPATCH_KINDS)
+	{
+		return 0;
+	}
+
+	DispatchInit();
+	cbThreaded = DispatchOverride[dwKind];
+
+	return cbThreaded != 0 ? cbThreaded : (SIZE_T)DispatchCalibrated[dwKind];
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CiphPlatform.h"
+
+// AES  DES ̃GWŋʂ̏
+
+// Ɨ̈̊mۂƉ
+// ̈ 64 oCgEɑATCYNXɃXbh̃A[iƃvZXŜ̃v[ōėp
+// CiphAlloc  0 ŏACiphAllocEx  CIPH_ALLOC_* ŏ̏ȗ⃉[Wy[Ww肷
+// CiphFree ͍ėp̈ (OS ɕԂy[WȊO) ̓e 0 ŏĂ߂
+#define CIPH_ALLOC_NO_ZERO     0x00000001 // 0 ł̏Ȃ (Ŝ㏑̈)
+#define CIPH_ALLOC_LARGE_PAGES 0x00000002 // 8 MB 𒴂̈[Wy[WŊmۂ
+
+PVOID WINAPI CiphAlloc(SIZE_T cb);
+PVOID WINAPI CiphAllocEx(SIZE_T cb, DWORD dwFlags);
+VOID WINAPI CiphFree(PVOID p);
+VOID WINAPI CiphAllocTrim();
+
+// ʂ̃AP[^[
+// Alloc  cbAlign oCgEɑ cb oCg̗̈ԂAFree  Alloc Ŋmۂ̈
+typedef PVOID(WINAPI* CIPH_BACKING_ALLOC)(PVOID pUser, SIZE_T cb, SIZE_T cbAlign);
+typedef VOID(WINAPI* CIPH_BACKING_FREE)(PVOID pUser, PVOID p, SIZE_T cb);
+
+VOID WINAPI CiphSetBackingAllocator(CIPH_BACKING_ALLOC Alloc, CIPH_BACKING_FREE Free, PVOID pUser);
+
+// CiphRandom ֐
+// OS ̗킩 cbOut oCg̗擾
+BOOL WINAPI CiphRandom(BYTE* out, SIZE_T cbOut);
+
+// CPU ̊g
+#define CPU_FEATURE_SSSE3  0x00000001
+#define CPU_FEATURE_SSE41  0x00000002
+#define CPU_FEATURE_AESNI  0x00000004
+#define CPU_FEATURE_PCLMUL 0x00000008
+#define CPU_FEATURE_AVX2   0x00000010
+#define CPU_FEATURE_BMI2   0x00000020
+
+DWORD WINAPI DetectCpuFeatures();
+DWORD WINAPI GetCpuFeatures();
+
+VOID WINAPI Xor(BYTE* in1, BYTE* in2, DWORD cbIn, BYTE* out);
+
+// PKCS#7 pfBO
+VOID WINAPI Pkcs7PadBlock(BYTE* tail, DWORD cbTail, DWORD cbBlock, BYTE* block);
+BOOL WINAPI Pkcs7UnpadBlock(BYTE* block, DWORD cbBlock, DWORD* pcbData);
+
+// 񏈗̍Ɗ֐
+// pParam œnꂽ dwFirst Ԗڂ dwCount ̍ڂ
+typedef VOID(WINAPI* PARALLEL_WORKER)(PVOID pParam, DWORD dwFirst, DWORD dwCount);
+
+DWORD WINAPI GetProcessorCount();
+DWORD WINAPI GetCacheSize();
+
+// 񏈗 ([NXeB[ÕXbhv[)
+// dwThreads ͎QXbh (Ăяo܂) ̏ŁA0 ̏ꍇ̓vZXŜ̏ (SetParallelConcurrency) Ƃ
+// vZXŜ̏ɂ͓ɕ񏈗ĂяoĂXbh܂
+// RunParallelEx  cbItem  1 ڂ̃oCg̖ڈŁA1 xɏ鍀ڐ L2 LbVɍ킹
+VOID WINAPI RunParallel(PARALLEL_WORKER Worker, PVOID pParam, DWORD nItems, DWORD dwThreads);
+VOID WINAPI RunParallelEx(PARALLEL_WORKER Worker, PVOID pParam, DWORD nItems, SIZE_T cbItem, DWORD dwThreads);
+VOID WINAPI SetParallelConcurrency(DWORD dwThreads);
+DWORD WINAPI GetParallelConcurrency();
+
+// oߎ (imbAP)
+ULONG64 WINAPI GetTimeNs();
+
+// s@̑I (fBXpb`)
+// ͂̃oCgƃGWE[h (DISPATCH_AES_ECB Ȃ) A1 ubN̏AubŇݏAXbhv[ł̕񏈗̂ꂩI
+// 񏈗ɐ؂ւoCg (臒l) ́AXbhv[̎󂯓n̎Ԃ 1 Xbh̏x CalibrateDispatch ő肵Č߂
+//  SetParallelConcurrency, SetDispatchMode (DISPATCH_AUTO)  C C^[tF[X CiphCalibrateDispatch ōsA̍쐬f[^̏ɂ͍sȂ
+#define DISPATCH_AUTO        0 // 臒lőI (SetDispatchMode ̊)
+#define DISPATCH_SERIAL      1 // 1 ubN
+#define DISPATCH_INTERLEAVED 2 // ubN̖߂݂ɔsAĂяõXbhŏ
+#define DISPATCH_THREADED    3 // ؂薈ɃXbhv[ŕɏ
+
+#define DISPATCH_AES_ECB          0
+#define DISPATCH_AES_CBC_DECRYPT  1
+#define DISPATCH_AES_CTR          2
+#define DISPATCH_DES_ECB          3
+#define DISPATCH_DES_CBC_DECRYPT  4
+#define DISPATCH_DES_CTR          5
+#define DISPATCH_TDEA_ECB         6
+#define DISPATCH_TDEA_CBC_DECRYPT 7
+#define DISPATCH_TDEA_CTR         8
+#define DISPATCH_KINDS            9
+#define DISPATCH_ALL_KINDS        0xffffffff // SetDispatchThreshold őSẴGWE[hw肷
+
+// 臒l̑Ɏg
+// eGWŒ̌ buf  cb oCg̏ŏ (ĂяõXbhŁAubŇݏp)
+// pParam  RegisterDispatchSample ɓnl
+typedef VOID(WINAPI* DISPATCH_SAMPLE)(PVOID pParam, BYTE* buf, DWORD cb);
+
+// RegisterDispatchSample ͊eGWÓIȏŌĂяoAGWE[h̑Ɏgo^
+// CalibrateDispatch ͓o^ꂽSẴGWE[h臒l𑪒肷 (񏈗̃XbhȎ肩ςĂȂꍇ͉Ȃ)
+VOID WINAPI RegisterDispatchSample(DWORD dwKind, DISPATCH_SAMPLE Sample, PVOID pParam);
+VOID WINAPI CalibrateDispatch();
+
+// cbInterleave ͌ݏŕׂubN̍voCgŁAꖢ̓͂ 1 ubN
+// 臒lwĂȂꍇ 1 MB 臒lƂ
+DWORD WINAPI SelectDispatch(DWORD dwKind, SIZE_T cb, SIZE_T cbInterleave);
+VOID WINAPI SetDispatchMode(DWORD dwMode);
+VOID WINAPI SetDispatchThreshold(DWORD dwKind, SIZE_T cbThreaded);
+SIZE_T WINAPI GetDispatchThreshold(DWORD dwKind);
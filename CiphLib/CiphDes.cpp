@@ -0,0 +1,2629 @@
+#include "CiphDes.h"
+#include "CiphDesBitslice.h"
+#include <stdlib.h>
+#include <string.h>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+// DES (Data Encryption Standard) ɂÍ
+
+// Ql
+// https://csrc.nist.gov/csrc/media/publications/fips/46/3/archive/1999-10-25/documents/fips46-3.pdf
+// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-67r2.pdf
+// https://csrc.nist.gov/CSRC/media/Publications/fips/81/archive/1980-12-02/documents/fips81.pdf
+// https://tsapps.nist.gov/publication/get_pdf.cfm?pub_id=910079
+// https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/TDES_Core.pdf
+// https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/TDES_ModesA_All.pdf
+
+// Œe[u (PC1, PC2, IP, E, S, P Ȃ) ƃrbgXCX DES ̃ev[g CiphDesBitslice.h Q
+// AVX2 p֐ CiphDesAvx2.cpp ɂ܂Ƃ߂
+
+// Load64 ֐
+// 8 oCgrbOGfBA 64 rbglƂēǂݍ (in[0] ̍ŏʃrbg 1 rbg)
+ULONG64 WINAPI Load64(BYTE* in)
+{
+	ULONG64 x = 0;
+	DWORD i;
+
+	for (i = 0; i < 8; i++)
+	{
+		x = (x << 8) | in[i];
+	}
+
+	return x;
+}
+
+// Store64 ֐
+// 64 rbglrbOGfBA 8 oCgƂď
+VOID WINAPI Store64(ULONG64 x, BYTE* out)
+{
+	DWORD i;
+
+	for (i = 0; i < 8; i++)
+	{
+		out[i] = (BYTE)(x >> (56 - 8 * i));
+	}
+
+	return;
+}
+
+// SwapMove ֐
+// a  n rbgEVtgl b ̊ԂŁA}XN m ̗Ărbg (delta swap)
+// 1 ̌ 32 rbg̍ő 16 rbg𓯎Ɉړł
+#define SwapMove(a, b, n, m, t) ((t) = (((a) >> (n)) ^ (b)) & (m), (b) ^= (t), (a) ^= (t) << (n))
+
+// DesInitialPermutation ֐
+// IP  5  SwapMove ōsB64 rbg̓͂ 32 rbg L0, R0 ɕďo͂
+// IP  8 x 8 ̃rbgs̓]uƍsE̕בւɑA4, 16, 2, 8, 1 rbǧɕł
+VOID WINAPI DesInitialPermutation(ULONG64 x, DWORD* pL, DWORD* pR)
+{
+	DWORD L = (DWORD)(x >> 32), R = (DWORD)x, t;
+
+	SwapMove(L, R, 4, 0x0F0F0F0F, t);
+	SwapMove(L, R, 16, 0x0000FFFF, t);
+	SwapMove(R, L, 2, 0x33333333, t);
+	SwapMove(R, L, 8, 0x00FF00FF, t);
+	SwapMove(L, R, 1, 0x55555555, t);
+
+	*pL = L;
+	*pR = R;
+
+	return;
+}
+
+// DesFinalPermutation ֐
+// IP^-1  IP Ƌt̏ SwapMove ōsAL || R  64 rbgԂ
+ULONG64 WINAPI DesFinalPermutation(DWORD L, DWORD R)
+{
+	DWORD t;
+
+	SwapMove(L, R, 1, 0x55555555, t);
+	SwapMove(R, L, 8, 0x00FF00FF, t);
+	SwapMove(R, L, 2, 0x33333333, t);
+	SwapMove(L, R, 16, 0x0000FFFF, t);
+	SwapMove(L, R, 4, 0x0F0F0F0F, t);
+
+	return (ULONG64)L << 32 | R;
+}
+
+// Œ̓]ũR[h
+// e[uRpCɌ܂]uɂāAȉ̂ǂ炩̏RpCɐ
+// EVtg (o͂̃rbgʒu - ͂̃rbgʒu) rbg܂Ƃ߁AVtg, AND, OR ̖̒߂ɂ
+// E͂ 1 oCgɏo͂e[uRpCɍ쐬AoCg̎QƂ OR ɂ
+// Vtgʂ̎ނȂ]u (E Ȃ) ͑OҁA]u (PC1, PC2, P Ȃ) ͌҂̕ߐȂ
+// ͂ nIn rbg (8 ̔{)Ao͂ nOut rbgłEl߂ƂAe[u FIPS 46-3 Ɠ` (͂̍ŏʂ 1 rbgڂƂrbgʒuׂ)
+
+// Vtgʖ̃}XN
+struct PERMUTATION_PLAN
+{
+	INT Shift[64];    // Vtg (̏ꍇ͉EVtg)
+	ULONG64 Mask[64]; // VtgɎco͂̃rbg
+	DWORD nShifts;
+};
+
+// MakePermutationPlan ֐
+// o͂̊erbgVtgʖɐU蕪
+constexpr PERMUTATION_PLAN MakePermutationPlan(CONST BYTE* table, DWORD nOut, DWORD nIn)
+{
+	PERMUTATION_PLAN Plan = {};
+	DWORD i = 0, k = 0;
+	INT Shift = 0;
+
+	for (i = 0; i < nOut; i++)
+	{
+		Shift = (INT)(nOut - 1 - i) - (INT)(nIn - table[i]);
+		for (k = 0; k < Plan.nShifts && Plan.Shift[k] != Shift; k++)
+		{
+		}
+		if (k == Plan.nShifts)
+		{
+			Plan.Shift[k] = Shift;
+			Plan.nShifts++;
+		}
+		Plan.Mask[k] |= 1ULL << (nOut - 1 - i);
+	}
+
+	return Plan;
+}
+
+// ͂̊eoCg̒lɑ΂o
+struct PERMUTATION_LOOKUP
+{
+	ULONG64 Table[8][256]; // Table[b][v] : ͂̏ʂ b oCgڂ v ̏ꍇ̏o
+};
+
+// MakePermutationLookup ֐
+// 1 rbĝ݂lɑ΂o͂߁ATable[b][v] = Table[b][v & (v - 1)] | (v ̍ŉʃrbgɑ΂o) Ŗ߂
+constexpr PERMUTATION_LOOKUP MakePermutationLookup(CONST BYTE* table, DWORD nOut, DWORD nIn)
+{
+	PERMUTATION_LOOKUP Lookup = {};
+	ULONG64 Single[8][8] = {};
+	DWORD i = 0, b = 0, v = 0, Low = 0;
+
+	for (i = 0; i < nOut; i++)
+	{
+		Single[(table[i] - 1) / 8][7 - (table[i] - 1) % 8] |= 1ULL << (nOut - 1 - i);
+	}
+
+	for (b = 0; b < nIn / 8; b++)
+	{
+		for (v = 1; v < 256; v++)
+		{
+			for (Low = 0; ((v >> Low) & 1) == 0; Low++)
+			{
+			}
+			Lookup.Table[b][v] = Lookup.Table[b][v & (v - 1)] | Single[b][Low];
+		}
+	}
+
+	return Lookup;
+}
+
+// FixedPermutationLookup NX
+// oCg̃e[uQƂɂ]u
+template <CONST BYTE* Table, DWORD nOut, DWORD nIn>
+struct FixedPermutationLookup
+{
+	static constexpr PERMUTATION_LOOKUP Lookup = MakePermutationLookup(Table, nOut, nIn);
+
+	template <DWORD... b>
+	static constexpr ULONG64 Apply(ULONG64 x, std::integer_sequence<DWORD, b...>)
+	{
+		ULONG64 y = 0;
+
+		(VOID)std::initializer_list<INT>{ (y |= Lookup.Table[b][(x >> (nIn - 8 - 8 * b)) & 0xFF], 0)... };
+
+		return y;
+	}
+};
+
+template <CONST BYTE* Table, DWORD nOut, DWORD nIn>
+constexpr PERMUTATION_LOOKUP FixedPermutationLookup<Table, nOut, nIn>::Lookup;
+
+// FixedPermutation NX
+// Apply(x) œ]usBRpCɌvZVtgʂ̎ނ̐I
+// Vtg 1  3 ߁AoCg̎Q 1 ̓ANZX܂ 4 ߒx̂߁A҂ 2 {̏d݂tĔr
+template <CONST BYTE* Table, DWORD nOut, DWORD nIn>
+struct FixedPermutation
+{
+	static constexpr PERMUTATION_PLAN Plan = MakePermutationPlan(Table, nOut, nIn);
+	static constexpr bool bUseLookup = 3 * Plan.nShifts > 8 * (nIn / 8);
+
+	template <DWORD k>
+	static constexpr ULONG64 Step(ULONG64 x)
+	{
+		return (Plan.Shift[k] >= 0 ? x << Plan.Shift[k] : x >> -Plan.Shift[k]) & Plan.Mask[k];
+	}
+
+	template <DWORD... k>
+	static constexpr ULONG64 ApplyShifts(ULONG64 x, std::integer_sequence<DWORD, k...>)
+	{
+		ULONG64 y = 0;
+
+		(VOID)std::initializer_list<INT>{ (y |= Step<k>(x), 0)... };
+
+		return y;
+	}
+
+	static constexpr ULONG64 Apply(ULONG64 x, std::false_type)
+	{
+		return ApplyShifts(x, std::make_integer_sequence<DWORD, Plan.nShifts>());
+	}
+
+	static constexpr ULONG64 Apply(ULONG64 x, std::true_type)
+	{
+		return FixedPermutationLookup<Table, nOut, nIn>::Apply(x, std::make_integer_sequence<DWORD, nIn / 8>());
+	}
+
+	static constexpr ULONG64 Apply(ULONG64 x)
+	{
+		return Apply(x, std::integral_constant<bool, bUseLookup>());
+	}
+};
+
+template <CONST BYTE* Table, DWORD nOut, DWORD nIn>
+constexpr PERMUTATION_PLAN FixedPermutation<Table, nOut, nIn>::Plan;
+
+// SP e[u
+// S ֐̏o͂ P ֐̓]uKpe[uRpCɍ쐬
+// SP[j][x]  6 rbg̓ x (b1 ŏ) ɑ΂ Sj+1  4 rbg̏o͂ 32 rbg j Ԗڂ 4 rbgɒuAP œ]ul
+// f(R, K) = SP[0][B1] ^ DesSp.SP[1][B2] ^ ... ^ DesSp.SP[7][B8] (Bj  E(R) ^ K  j Ԗڂ 6 rbg) ƂȂ
+struct DES_SP_TABLE
+{
+	DWORD SP[8][64];
+};
+
+// MakeDesSpTable ֐
+// 6 rbg̓͂ b1, b6  RowAb2 ` b5  Column Ƃ S AP œ]u
+constexpr DES_SP_TABLE MakeDesSpTable()
+{
+	DES_SP_TABLE Table = {};
+	DWORD j = 0, x = 0, Row = 0, Column = 0;
+
+	for (j = 0; j < 8; j++)
+	{
+		for (x = 0; x < 64; x++)
+		{
+			Row = ((x >> 4) & 2) | (x & 1);
+			Column = (x >> 1) & 0xF;
+			Table.SP[j][x] = (DWORD)FixedPermutation<P, 32, 32>::Apply((ULONG64)S[j][Row * 16 + Column] << (28 - 4 * j));
+		}
+	}
+
+	return Table;
+}
+
+constexpr DES_SP_TABLE DesSp = MakeDesSpTable();
+
+// DesKeySetup ֐
+// 64 rbg̈Í (OriginalKey) 献ReLXg쐬 (DesEncrypt  2. ` 6. ̎菇)
+// Cn, Dn  28 rbg̒lƂăWX^Ń[e[gAߋ Cn, Dn ͕ێȂ
+VOID WINAPI DesKeySetup(BYTE* OriginalKey, DES_KEY_CONTEXT* pContext)
+{
+	BYTE i, j;
+
+	// Key Schedule 1 (KS1)
+	// ^ꂽIWǐ 56 rbǧ K0  1 ƁA 48 rbǧ 16 쐬
+	// +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
+	// |01|02|03|04|05|06|07|08|09|10|11|12|13|14|15|16|17|18|19|20|21|22|23|24|25|26|27|28|29|30|31|32|33|34|35|36|37|38|39|40|41|42|43|44|45|46|47|48|49|50|51|52|53|54|55|56|
+	// +--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+--+
+	// | Permuted Key (56 bits)                                                                                                                                                |
+	// +-----------------------------------------------------------------------------------+-----------------------------------------------------------------------------------+
+	// | C0 (28 bits)                                                                      | D0 (28 bits)                                                                      |
+	// +-----------------------------------------------------------------------------------+-----------------------------------------------------------------------------------+
+	// C0, D0 ɂĂꂼ 1 rbg[e[g C1, D1 쐬
+	//  +---------------------------------------------------------------------------------+  +--------------------------------------------------------------------------------+ 
+	//  |                                                                                 |  |                                                                                |
+	//  |                                                                                 v  |                                                                                v
+	// +-----------------------------------------------------------------------------------+-----------------------------------------------------------------------------------+
+	// | C1 (28 bits)                                                                      | D1 (28 bits)                                                                      |
+	// +-----------------------------------------------------------------------------------+-----------------------------------------------------------------------------------+
+	// 悤 C2, D2 ɂĂ C1, D1 ꂼrbg[e[gč쐬
+	// [e[grbǵAꂼ 1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1
+	DWORD C, D;
+	BYTE G[8];
+	ULONG64 Bits;
+
+	// Permuted Choice 1
+	// C0 : 56 rbgɏk]u K ̏ 28 rbg
+	// D0 : 56 rbgɏk]u K ̉ 28 rbg
+	Bits = FixedPermutation<PC1, 56, 64>::Apply(Load64(OriginalKey));
+	C = (DWORD)(Bits >> 28) & 0x0FFFFFFF;
+	D = (DWORD)Bits & 0x0FFFFFFF;
+
+	for (i = 0; i < 16; i++)
+	{
+		// Cn, Dn  Cn-1, Dn-1  NumLeftShifts[n - 1] rbg[e[g
+		C = ((C << NumLeftShifts[i]) | (C >> (28 - NumLeftShifts[i]))) & 0x0FFFFFFF;
+		D = ((D << NumLeftShifts[i]) | (D >> (28 - NumLeftShifts[i]))) & 0x0FFFFFFF;
+
+		// Permuted Choice 2 (Cn || Dn)
+		Bits = FixedPermutation<PC2, 48, 56>::Apply(((ULONG64)C << 28) | D);
+
+		// Kn  6 rbg 8 ɕAԖڂƊԖڂ̑gɕċl߂
+		for (j = 0; j < 8; j++)
+		{
+			G[j] = (BYTE)((Bits >> (42 - 6 * j)) & 0x3F);
+		}
+		pContext->K[i][0] = ((DWORD)G[0] << 24) | ((DWORD)G[2] << 16) | ((DWORD)G[4] << 8) | G[6];
+		pContext->K[i][1] = ((DWORD)G[1] << 24) | ((DWORD)G[3] << 16) | ((DWORD)G[5] << 8) | G[7];
+	}
+
+	SecureZeroMemory(G, sizeof(G));
+	C = 0;
+	D = 0;
+	Bits = 0;
+
+	return;
+}
+
+// DesF ֐
+// f ֐ : 32 rbg R ƃEh K  32 rbg̒l߂
+// E ɂ 48 rbgւ̊g j Ԗڂ 6 rbg R  4j ` 4j+5 rbg (0  32, 33  1 rbg) łA
+// R  4j+5 rbg[e[g 6 rbgɓ
+// R  3 rbgE[e[g j = 6, 4, 2, 0 ̑gA1 rbg[e[g j = 7, 5, 3, 1 ̑g
+// ʃoCg珇ɊeoCg̉ 6 rbgɕԂ߁A[e[g 2 ƃEhƂ xor 2  8 g̓Y
+// S ֐ P ֐ SP e[u̎QƂ xor ɂ܂Ƃ߂
+inline DWORD DesF(DWORD R, CONST DWORD* K)
+{
+	DWORD W, F;
+
+	W = _rotr(R, 3) ^ K[0];
+	F = DesSp.SP[6][W & 0x3F]
+		^ DesSp.SP[4][(W >> 8) & 0x3F]
+		^ DesSp.SP[2][(W >> 16) & 0x3F]
+		^ DesSp.SP[0][(W >> 24) & 0x3F];
+
+	W = _rotl(R, 1) ^ K[1];
+	F ^= DesSp.SP[7][W & 0x3F]
+		^ DesSp.SP[5][(W >> 8) & 0x3F]
+		^ DesSp.SP[3][(W >> 16) & 0x3F]
+		^ DesSp.SP[1][(W >> 24) & 0x3F];
+
+	return F;
+}
+
+// DesRounds ֐
+// L, R ɑ΂ 16 Ehs
+// eEh Ln+1 = Rn, Rn+1 = Ln ^ f(Rn, Kn+1)  2 EhWJAL  R ̓ւȂ
+// ̂ߏI *pL  L16A*pR  R16 AFP ̓ (R16 || L16)  *pR || *pL ƂȂ
+// DES  Feistel \̂߁A͓EhEh K16 ` K1 ̋tɗpčs΂悢
+inline VOID DesRounds(DES_KEY_CONTEXT* pContext, DWORD* pL, DWORD* pR, BOOL bDecrypt)
+{
+	BYTE i;
+	DWORD L = *pL, R = *pR;
+	CONST DWORD* K;
+	INT Step; // 1 Eh̃Eh DWORD  (ł͕)
+
+	K = pContext->K[bDecrypt ? 15 : 0];
+	Step = bDecrypt ? -2 : 2;
+
+	for (i = 0; i < 16; i += 2)
+	{
+		L ^= DesF(R, K);
+		R ^= DesF(L, K + Step);
+		K += 2 * Step;
+	}
+
+	*pL = L;
+	*pR = R;
+
+	return;
+}
+
+// DesCryptBlock ֐
+// ReLXgp 64 rbg̃ubNÍ /  (DesEncrypt  7. ` 13. ̎菇)
+// L, R  32 rbg̒lƂăWX^ɕێAubN̓ǂݍ݂Ə݂ 64 rbgPʂ 1 񂸂s
+VOID WINAPI DesCryptBlock(DES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, BOOL bDecrypt)
+{
+	DWORD L, R;
+
+	// Initial Permutation
+	DesInitialPermutation(Load64(in), &L, &R);
+
+	DesRounds(pContext, &L, &R, bDecrypt);
+
+	// Final Permutation (R16 || L16)
+	Store64(DesFinalPermutation(R, L), out);
+
+	return;
+}
+
+// DesCryptBlockKeys ֐
+// nKeys  (1 ܂ 3) ̌ReLXgp DES  nKeys is
+// 3 ȉꍇ TDEA ̈Í (E_K3(D_K2(E_K1(I)))) /  (D_K1(E_K2(D_K3(I)))) ƂȂ
+// i̊Ԃ FP Ǝ̒i IP ͑ł߁AIP  FP ̓ubN̓Əo 1 񂸂sA
+// eȉo R16 || L16 ̂܂܎̒i L0 || R0 Ƃčő 48 EhWX^őčs
+VOID WINAPI DesCryptBlockKeys(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, BYTE* out, BOOL bDecrypt)
+{
+	DWORD L, R, i;
+
+	// Initial Permutation
+	DesInitialPermutation(Load64(in), &L, &R);
+
+	for (i = 0; i < nKeys; i++)
+	{
+		if (i & 1)
+		{
+			DesRounds(&Contexts[i], &R, &L, !bDecrypt);
+		}
+		else
+		{
+			DesRounds(&Contexts[bDecrypt ? nKeys - 1 - i : i], &L, &R, bDecrypt);
+		}
+	}
+
+	// Final Permutation
+	// i̂߁AŌ̒i R16 || L16  R || L ɓĂ
+	Store64(DesFinalPermutation(R, L), out);
+
+	return;
+}
+
+// [ DES
+// DesRounds ̊eEh͑ÕEȟʂ҂߁ADES_LANES ̓ƗubÑEh݂ɐi߁A
+// SP e[u̎QƂ̑҂Ԃd˂ (rbgXCXgقǃubN܂Ƃ܂ĂȂꍇɗp)
+#define DES_LANES 4
+
+// DesRoundsLanes ֐
+// DES_LANES  L, R ɑ΂ DesRounds Ɠ 16 Ehs
+inline VOID DesRoundsLanes(DES_KEY_CONTEXT* pContext, DWORD* L, DWORD* R, BOOL bDecrypt)
+{
+	BYTE i, j;
+	CONST DWORD* K;
+	INT Step;
+
+	K = pContext->K[bDecrypt ? 15 : 0];
+	Step = bDecrypt ? -2 : 2;
+
+	for (i = 0; i < 16; i += 2)
+	{
+		for (j = 0; j < DES_LANES; j++)
+		{
+			L[j] ^= DesF(R[j], K);
+		}
+		for (j = 0; j < DES_LANES; j++)
+		{
+			R[j] ^= DesF(L[j], K + Step);
+		}
+		K += 2 * Step;
+	}
+
+	return;
+}
+
+// DesCryptLanes ֐
+// DES_LANES ̃ubN DesCryptBlockKeys Ɠ菇œɈÍ / 
+// SubNǂݍł珑ނ߁Ain  out ͓obt@ł悢
+VOID WINAPI DesCryptLanes(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, BYTE* out, BOOL bDecrypt)
+{
+	DWORD L[DES_LANES], R[DES_LANES], i;
+
+	for (i = 0; i < DES_LANES; i++)
+	{
+		DesInitialPermutation(Load64(&in[8 * i]), &L[i], &R[i]);
+	}
+
+	for (i = 0; i < nKeys; i++)
+	{
+		if (i & 1)
+		{
+			DesRoundsLanes(&Contexts[i], R, L, !bDecrypt);
+		}
+		else
+		{
+			DesRoundsLanes(&Contexts[bDecrypt ? nKeys - 1 - i : i], L, R, bDecrypt);
+		}
+	}
+
+	for (i = 0; i < DES_LANES; i++)
+	{
+		Store64(DesFinalPermutation(R[i], L[i]), &out[8 * i]);
+	}
+
+	return;
+}
+
+// DesKeyEqual ֐
+// 2  DES ̌peBrbg (eoCg̍ŉʃrbg) ē𔻒肷
+BOOL WINAPI DesKeyEqual(BYTE* Key1, BYTE* Key2)
+{
+	BYTE i, Diff = 0;
+
+	for (i = 0; i < 8; i++)
+	{
+		Diff |= (Key1[i] ^ Key2[i]) & 0xFE;
+	}
+
+	return Diff == 0;
+}
+
+// TdeaKeySetup ֐
+// TDEA  3 ̌献ReLXg쐬
+// ̑gݍ킹ɂ DES ɏkނꍇ́Ac 1 ̌XPW[쐬
+VOID WINAPI TdeaKeySetup(BYTE* Key1, BYTE* Key2, BYTE* Key3, TDEA_KEY_CONTEXT* pContext)
+{
+	if (DesKeyEqual(Key1, Key2))
+	{
+		DesKeySetup(Key3, &pContext->Keys[0]);
+		pContext->nKeys = 1;
+	}
+	else if (DesKeyEqual(Key2, Key3))
+	{
+		DesKeySetup(Key1, &pContext->Keys[0]);
+		pContext->nKeys = 1;
+	}
+	else
+	{
+		DesKeySetup(Key1, &pContext->Keys[0]);
+		DesKeySetup(Key2, &pContext->Keys[1]);
+		DesKeySetup(Key3, &pContext->Keys[2]);
+		pContext->nKeys = 3;
+	}
+
+	return;
+}
+
+// TdeaCryptBlock ֐
+// ReLXgp TDEA ɂÍ (E_K3(D_K2(E_K1(I)))) /  (D_K1(E_K2(D_K3(I)))) s
+VOID WINAPI TdeaCryptBlock(TDEA_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, BOOL bDecrypt)
+{
+	DesCryptBlockKeys(pContext->Keys, pContext->nKeys, in, out, bDecrypt);
+
+	return;
+}
+
+// DesBitslicedCryptBlocks ֐
+// nBlocks ̃ubN̂A64  (AVX2 gpłꍇ 256 ) Pʂŏł镪rbgXCXňÍ / 
+// ubNԂ
+DWORD WINAPI DesBitslicedCryptBlocks(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, BYTE* out, DWORD nBlocks, BOOL bDecrypt)
+{
+	DWORD nDone = 0;
+
+#if defined(CIPH_X86)
+	if (GetCpuFeatures() & CPU_FEATURE_AVX2)
+	{
+		nDone = DesBitslicedCryptBlocksAvx2(Contexts, nKeys, in, out, nBlocks, bDecrypt);
+	}
+#endif
+
+	for (; nBlocks - nDone >= DES_BITSLICE_BLOCKS; nDone += DES_BITSLICE_BLOCKS)
+	{
+		DesBitslicedCryptGroup<ULONG64>(Contexts, nKeys, &in[8 * nDone], &out[8 * nDone], bDecrypt);
+	}
+
+	return nDone;
+}
+
+// DesCryptBlocks ֐
+// nBlocks ̃ubN DES (nKeys = 1) ܂ TDEA (nKeys = 3) ňÍ / 
+// 64 ȏ܂Ƃ܂Ă镔̓rbgXCXŁAc DES_LANES  DesCryptLanes ŁA[ DesCryptBlockKeys ŏ
+// SubNǂݍł珑ނ߁Ain  out ͓obt@ł悢
+VOID WINAPI DesCryptBlocks(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, BYTE* out, DWORD nBlocks, BOOL bDecrypt)
+{
+	DWORD i;
+
+	i = DesBitslicedCryptBlocks(Contexts, nKeys, in, out, nBlocks, bDecrypt);
+	for (; nBlocks - i >= DES_LANES; i += DES_LANES)
+	{
+		DesCryptLanes(Contexts, nKeys, &in[8 * i], &out[8 * i], bDecrypt);
+	}
+	for (; i < nBlocks; i++)
+	{
+		DesCryptBlockKeys(Contexts, nKeys, &in[8 * i], &out[8 * i], bDecrypt);
+	}
+
+	return;
+}
+
+// DesCbcDecryptBlocks ֐
+// CBC ɂ镡 DES (nKeys = 1) ܂ TDEA (nKeys = 3) ōs
+// ͊eubNœƗĂ邽߁Aő 256 ubN DesCryptBlocks ł܂Ƃ߂ĕĂÖÍubN xor 
+// in  out obt@ł悢悤AÖÍubN͏ݑOɑޔ
+VOID WINAPI DesCbcDecryptBlocks(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	BYTE Temp[8 * DES_BITSLICE_BLOCKS256], Prev[8];
+	DWORD cbCurrent, cbChunk, i;
+
+	memcpy(Prev, IV, 8);
+	for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += cbChunk)
+	{
+		cbChunk = cbIn - cbCurrent < sizeof(Temp) ? cbIn - cbCurrent : sizeof(Temp);
+		DesCryptBlocks(Contexts, nKeys, &in[cbCurrent], Temp, cbChunk / 8, TRUE);
+		Xor(Temp, Prev, 8, Temp);
+		for (i = 8; i < cbChunk; i += 8)
+		{
+			Xor(&Temp[i], &in[cbCurrent + i - 8], 8, &Temp[i]);
+		}
+		memcpy(Prev, &in[cbCurrent + cbChunk - 8], 8);
+		memcpy(&out[cbCurrent], Temp, cbChunk);
+	}
+	SecureZeroMemory(Temp, sizeof(Temp));
+
+	return;
+}
+
+// DesEncrypt ֐
+// DES ɂÍsBDES ɂÍ͈ȉ̎菇očs
+// 1.̓f[^Ƃ 64 rbg̕ƁA64 rbg̈Í󂯎
+// 2.64 rbg̈Í Permuted Choice 1 s 56 rbǧ K0 𐶐
+// 3.K0 ̃f[^ 28 rbg̃f[^ C0, D0  2 ɕ
+// 4.C0, D0 ̂ꂼ[e[g (dlł͍VtgƋLڂĂ邪Aۂ͍[e[g)  C1, D1 쐬
+// 5.C1, D1 ̃f[^ Permuted Choice 2 sA48 rbǧ K1 𐶐
+// 6.C1, D1 ` C16, D16 ɂ 4. y 5. ̏JԂ K1`K16쐬
+// 7.ɂ Initial Permutation (IP) ƌĂ΂鏉]us
+// 8.]usʂ 32 rbg̃f[^ L0, R0  2 ɕ
+// 9.R0  32 rbg 48 rbgɊg
+// 10.R0 ̂܂ L1 Ƃ
+// 11 R0  48 rbgɊĝ K1 ̓f[^Ƃ f ֐ĂяoǍʂ L0 ̘_ς R1 Ƃ
+// 12.L0, R0 ` L15, R15 ɂ 9. ` 11. ̏JԂ L1, R1 ` L16, R16 쐬
+// 13.R16, L16 (R16  L16 E)  Inverse Initial Permutation (ŏI]u) sāA64 rbg̈Í擾
+// 
+// }ɂƈȉ̂悤ɂȂ
+// +---------------------------------+           +---------------------------------+
+// | Plain Text (64 bits)            |           | Original Key (64 bits)          |
+// +----------------+----------------+           +----------------+----------------+
+//                  | Initial Permutation (IP)                    | Permuted Choice 1
+//                  |                            +----------------+----------------+  +----------------+----------------+
+// +----------------+----------------+           | Permuted Key K0 (56 bits)       +->+ C0 (28bits)| D0 (28bits)|
+// | L0 (32bits)| R0 (32bits)|           +---------------------------------+  +--------+-------+-------+--------+
+// +--------+-------+-------+--------+                                                         | [e[g  | [e[g
+//          |               |                    +---------------------------------+  +--------+-------+-------+--------+
+//          | +-------------+                    | Permuted Key K1 (48 bits)       +<-+ C1 (28 bits)   | D1 (28 bits)   |
+//          |/      +-------+--------+           +----------------+----------------+  +--------+-------+-------+--------+
+//         /|       | Expansion      |                            |         Permuted Choice 2  | [e[g  | [e[g            
+//        / |       +-------+--------+     +----------------------+                            |               |
+//       /  |               |              |     +---------------------------------+  +--------+-------+-------+--------+
+//      /   |       +-------+--------+     |     | Permuted Key K2 (48 bits)       +<-+ C2 (28 bits)   | D2 (28 bits)   |
+//      |   |       | f              +-----+     +----------------+----------------+  +--------+-------+-------+--------+
+//      |   |       +-------+--------+                            |         Permuted Choice 2  | [e[g  | [e[g 
+//      |  xor--------------+                                     :                            :               :
+//      |   |                                                     :                            :               :
+//      |   +---------------+
+//      |                   |
+// +----+-----------+-------+--------+
+// | L1 (32bits)    | R1 (32bits)    |
+// +--------+-------+-------+--------+
+//          |               |
+//          :               :
+// +--------+-------+-------+--------+
+// | L16 (32bits)   | R16 (32bits)   |
+// +--------+-------+-------+--------+
+//          |               |
+//          +-------+-------+
+//                  | Inverse Initial Permutation
+// +---------------------------------+
+// | Cipher Text (64 bits)           |
+// +---------------------------------+
+// 
+// 
+// 1 ubNɌXPW[쐬邽߁Aŕ̃ubNꍇ
+// DesKeySetup ō쐬ReLXg DesCryptBlock gp
+VOID WINAPI DesEncrypt(BYTE* in, BYTE* OriginalKey, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesCryptBlock(&Context, in, out, FALSE);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+// DesDecrypt ֐
+// Des ɂĈÍꂽ𕡍
+// ÍƓXPW[쐬AEh K16 ` K1 ̋tɗpĈÍƓEhs
+VOID WINAPI DesDecrypt(BYTE* in, BYTE* OriginalKey, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesCryptBlock(&Context, in, out, TRUE);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+// DesEcbEncryptContext ֐
+// ReLXgp ECB ɂÍs
+VOID WINAPI DesEcbEncryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out)
+{
+	DesEcbCryptDispatch(pContext, 1, in, cbIn, out, FALSE);
+
+	return;
+}
+
+// DesEcbDecryptContext ֐
+// ReLXgp ECB ɂ镡s
+VOID WINAPI DesEcbDecryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out)
+{
+	DesEcbCryptDispatch(pContext, 1, in, cbIn, out, TRUE);
+
+	return;
+}
+
+// DesCbcEncryptContext ֐
+// ReLXgp CBC ɂÍs
+VOID WINAPI DesCbcEncryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	BYTE inTemp[8];
+	DWORD cbCurrent;
+
+	Xor(in, IV, 8, inTemp);
+	DesCryptBlock(pContext, inTemp, out, FALSE);
+	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		Xor(&in[cbCurrent], &out[cbCurrent - 8], 8, inTemp);
+		DesCryptBlock(pContext, inTemp, &out[cbCurrent], FALSE);
+	}
+
+	return;
+}
+
+// DesCbcDecryptContext ֐
+// ReLXgp CBC ɂ镡s
+VOID WINAPI DesCbcDecryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	DesCbcDecryptDispatch(pContext, 1, in, cbIn, IV, out);
+
+	return;
+}
+
+// DesCfbEncryptContext ֐
+// ReLXgp CFB ɂÍs
+VOID WINAPI DesCfbEncryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	BYTE outTemp[8];
+	DWORD cbCurrent;
+
+	DesCryptBlock(pContext, IV, outTemp, FALSE);
+	Xor(in, outTemp, 8, out);
+	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		DesCryptBlock(pContext, &out[cbCurrent - 8], outTemp, FALSE);
+		Xor(&in[cbCurrent], outTemp, 8, &out[cbCurrent]);
+	}
+
+	return;
+}
+
+// DesCfbDecryptContext ֐
+// ReLXgp CFB ɂ镡s
+VOID WINAPI DesCfbDecryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	BYTE outTemp[8];
+	DWORD cbCurrent;
+
+	DesCryptBlock(pContext, IV, outTemp, FALSE);
+	Xor(in, outTemp, 8, out);
+	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		DesCryptBlock(pContext, &in[cbCurrent - 8], outTemp, FALSE);
+		Xor(&in[cbCurrent], outTemp, 8, &out[cbCurrent]);
+	}
+
+	return;
+}
+
+// DesOfbEncryptDecryptContext ֐
+// ReLXgp OFB ɂÍ / s
+// o̓ubN On = CIPH(On-1) ̃ubN̓͂Ƃ
+VOID WINAPI DesOfbEncryptDecryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	BYTE Temp[8];
+	DWORD cbCurrent;
+
+	DesCryptBlock(pContext, IV, Temp, FALSE);
+	Xor(in, Temp, 8, out);
+	for (cbCurrent = 8; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		DesCryptBlock(pContext, Temp, Temp, FALSE);
+		Xor(&in[cbCurrent], Temp, 8, &out[cbCurrent]);
+	}
+
+	return;
+}
+
+// DesCtrCryptKeys ֐
+// DES (nKeys = 1) ܂ TDEA (nKeys = 3)  CTR ɂÍ / s (Íƕ͓)
+// JE^ubN ICV  64 rbg big endian ̐Ƃ݂ȂAubN 1  (2^64 Ő܂Ԃ)
+// Offset ̓f[^Ŝ̐擪̃oCgʒuŁAin, out ͂̈ʒu cbIn oCgw
+// Offset / 8 Ԗڂ̃JE^献Xg[A̐擪 Offset % 8 oCgǂݔ΂߁ACӂ̈ʒu珈n߂
+// Xg[͍ő 256 ubÑJE^ubNׁADesCryptBlocks ł܂Ƃ߂č쐬
+VOID WINAPI DesCtrCryptKeys(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out)
+{
+	BYTE Stream[8 * DES_BITSLICE_BLOCKS256];
+	ULONG64 Counter = Load64(ICV) + Offset / 8;
+	DWORD cbSkip = (DWORD)(Offset % 8);
+	DWORD cbCurrent = 0, cbChunk, nBlocks, i;
+
+	while (cbCurrent < cbIn)
+	{
+		nBlocks = (DWORD)(((ULONG64)cbSkip + (cbIn - cbCurrent) + 7) / 8);
+		if (nBlocks > DES_BITSLICE_BLOCKS256)
+		{
+			nBlocks = DES_BITSLICE_BLOCKS256;
+		}
+
+		for (i = 0; i < nBlocks; i++)
+		{
+			Store64(Counter++, &Stream[8 * i]);
+		}
+		DesCryptBlocks(Contexts, nKeys, Stream, Stream, nBlocks, FALSE);
+
+		cbChunk = 8 * nBlocks - cbSkip;
+		if (cbChunk > cbIn - cbCurrent)
+		{
+			cbChunk = cbIn - cbCurrent;
+		}
+		Xor(&in[cbCurrent], &Stream[cbSkip], cbChunk, &out[cbCurrent]);
+
+		cbCurrent += cbChunk;
+		cbSkip = 0;
+	}
+	SecureZeroMemory(Stream, sizeof(Stream));
+
+	return;
+}
+
+// DES-CTR ̕񏈗̃p[^
+typedef struct
+{
+	DES_KEY_CONTEXT* Contexts;
+	DWORD nKeys;
+	BYTE* in;
+	DWORD cbIn;
+	BYTE* ICV;
+	ULONG64 Offset;
+	BYTE* out;
+} DES_CTR_BATCH;
+
+// XbhɊ蓖Ăf[^̒P (oCg)
+#define DES_CTR_CHUNK 65536
+
+// DesCtrWorker ֐
+// dwFirst Ԗڂ dwCount  DES_CTR_CHUNK oCg̋؂
+VOID WINAPI DesCtrWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	DES_CTR_BATCH* pBatch = (DES_CTR_BATCH*)pParam;
+	ULONG64 cbFirst = (ULONG64)dwFirst * DES_CTR_CHUNK;
+	ULONG64 cbLast = (ULONG64)(dwFirst + dwCount) * DES_CTR_CHUNK;
+
+	if (cbLast > pBatch->cbIn)
+	{
+		cbLast = pBatch->cbIn;
+	}
+	DesCtrCryptKeys(pBatch->Contexts, pBatch->nKeys, &pBatch->in[cbFirst], (DWORD)(cbLast - cbFirst), pBatch->ICV, pBatch->Offset + cbFirst, &pBatch->out[cbFirst]);
+
+	return;
+}
+
+// DesCtrCryptParallel ֐
+// f[^ DES_CTR_CHUNK oCgɋ؂AXbhv[ŕ CTR ɂÍ / s
+// e؂̃JE^ Offset vZł邽߁AXbhԂœ͕sv
+// dwThreads ͎QXbh̏ (0 ̏ꍇ̓vZXŜ̏)
+VOID WINAPI DesCtrCryptParallel(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out, DWORD dwThreads)
+{
+	DES_CTR_BATCH Batch;
+
+	Batch.Contexts = Contexts;
+	Batch.nKeys = nKeys;
+	Batch.in = in;
+	Batch.cbIn = cbIn;
+	Batch.ICV = ICV;
+	Batch.Offset = Offset;
+	Batch.out = out;
+	RunParallelEx(DesCtrWorker, &Batch, cbIn / DES_CTR_CHUNK + (cbIn % DES_CTR_CHUNK != 0 ? 1 : 0), DES_CTR_CHUNK, dwThreads);
+
+	return;
+}
+
+// ECB, CBC ̕, CTR ̈ꊇ
+// DesCryptBlocks  DES_LANES ̃ubN 1 邽߁Aꖢ̓͂ 1 ubN
+// 񏈗 CBC ̕ 1 ڂƂoCg (e؂̒ÖÍubN IV Ƃ)
+#define DES_DISPATCH_GROUP 4096
+
+// s@̑I (SelectDispatch) ƕ񏈗̃p[^
+typedef struct
+{
+	DES_KEY_CONTEXT* Contexts;
+	DWORD nKeys;
+	BYTE* in;
+	DWORD cbIn;
+	BYTE* out;
+	BYTE* Prevs;   // CBC : e؂̒ÖÍubN
+	BOOL bDecrypt; // ECB
+} DES_DISPATCH_BATCH;
+
+// DesDispatchKind ֐
+// DES (nKeys = 1)  TDEA (nKeys = 3) ͏xقȂ邽߁ADISPATCH_DES_*  DISPATCH_TDEA_* ŕʂ臒lp
+DWORD WINAPI DesDispatchKind(DWORD dwDesKind, DWORD nKeys)
+{
+	return nKeys == 1 ? dwDesKind : dwDesKind + (DISPATCH_TDEA_ECB - DISPATCH_DES_ECB);
+}
+
+// DesEcbSample ֐, DesCbcDecryptSample ֐, DesCtrSample ֐
+// 臒l̑Ɏg (pParam  TDEA ̌ReLXg buf ̏ŏ)
+VOID WINAPI DesEcbSample(PVOID pParam, BYTE* buf, DWORD cb)
+{
+	TDEA_KEY_CONTEXT* pContext = (TDEA_KEY_CONTEXT*)pParam;
+
+	DesCryptBlocks(pContext->Keys, pContext->nKeys, buf, buf, cb / 8, FALSE);
+
+	return;
+}
+
+VOID WINAPI DesCbcDecryptSample(PVOID pParam, BYTE* buf, DWORD cb)
+{
+	TDEA_KEY_CONTEXT* pContext = (TDEA_KEY_CONTEXT*)pParam;
+	BYTE IV[8] = { 0 };
+
+	DesCbcDecryptBlocks(pContext->Keys, pContext->nKeys, buf, cb, IV, buf);
+
+	return;
+}
+
+VOID WINAPI DesCtrSample(PVOID pParam, BYTE* buf, DWORD cb)
+{
+	TDEA_KEY_CONTEXT* pContext = (TDEA_KEY_CONTEXT*)pParam;
+	BYTE ICV[8] = { 0 };
+
+	DesCtrCryptKeys(pContext->Keys, pContext->nKeys, buf, cb, ICV, 0, buf);
+
+	return;
+}
+
+// RegisterDesDispatchSamples ֐
+// 臒l̑Ɏgo^ (ÓIȏ 1 xĂяo)
+// ͌Ăяǒg킸ɍs߁ADES (1 iɏk)  TDEA (3 i) ̌Œ̌ō쐬ReLXgp
+static TDEA_KEY_CONTEXT DesSampleContexts[2];
+
+BOOL WINAPI RegisterDesDispatchSamples()
+{
+	BYTE Keys[3][8] = { { 0x01 }, { 0x02 }, { 0x04 } };
+	DWORD i;
+
+	TdeaKeySetup(Keys[0], Keys[0], Keys[0], &DesSampleContexts[0]);
+	TdeaKeySetup(Keys[0], Keys[1], Keys[2], &DesSampleContexts[1]);
+	for (i = 0; i < 2; i++)
+	{
+		RegisterDispatchSample(DesDispatchKind(DISPATCH_DES_ECB, DesSampleContexts[i].nKeys), DesEcbSample, &DesSampleContexts[i]);
+		RegisterDispatchSample(DesDispatchKind(DISPATCH_DES_CBC_DECRYPT, DesSampleContexts[i].nKeys), DesCbcDecryptSample, &DesSampleContexts[i]);
+		RegisterDispatchSample(DesDispatchKind(DISPATCH_DES_CTR, DesSampleContexts[i].nKeys), DesCtrSample, &DesSampleContexts[i]);
+	}
+
+	return TRUE;
+}
+
+static const BOOL bDesDispatchSamples = RegisterDesDispatchSamples();
+
+// DesEcbWorker ֐
+// dwFirst Ԗڂ dwCount ̃ubNÍ / 
+VOID WINAPI DesEcbWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	DES_DISPATCH_BATCH* pBatch = (DES_DISPATCH_BATCH*)pParam;
+	SIZE_T cbFirst = (SIZE_T)dwFirst * 8;
+
+	DesCryptBlocks(pBatch->Contexts, pBatch->nKeys, &pBatch->in[cbFirst], &pBatch->out[cbFirst], dwCount, pBatch->bDecrypt);
+
+	return;
+}
+
+// DesCbcDecryptWorker ֐
+// dwFirst Ԗڂ dwCount  DES_DISPATCH_GROUP oCg̋؂AޔÖÍubN IV Ƃĕ
+VOID WINAPI DesCbcDecryptWorker(PVOID pParam, DWORD dwFirst, DWORD dwCount)
+{
+	DES_DISPATCH_BATCH* pBatch = (DES_DISPATCH_BATCH*)pParam;
+	SIZE_T cbFirst = (SIZE_T)dwFirst * DES_DISPATCH_GROUP;
+	SIZE_T cbLast = (SIZE_T)(dwFirst + dwCount) * DES_DISPATCH_GROUP;
+
+	if (cbLast > pBatch->cbIn)
+	{
+		cbLast = pBatch->cbIn;
+	}
+	DesCbcDecryptBlocks(pBatch->Contexts, pBatch->nKeys, &pBatch->in[cbFirst], (DWORD)(cbLast - cbFirst), &pBatch->Prevs[8 * (SIZE_T)dwFirst], &pBatch->out[cbFirst]);
+
+	return;
+}
+
+// DesEcbCryptDispatch ֐
+// DES (nKeys = 1) ܂ TDEA (nKeys = 3)  ECB ɂÍ / s
+// ͂̃oCgɉāADesCryptBlocks (1 ubNA܂͌ݏ) Xbhv[ł̕񏈗I
+VOID WINAPI DesEcbCryptDispatch(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* out, BOOL bDecrypt)
+{
+	DES_DISPATCH_BATCH Batch;
+
+	Batch.Contexts = Contexts;
+	Batch.nKeys = nKeys;
+	Batch.in = in;
+	Batch.cbIn = cbIn;
+	Batch.out = out;
+	Batch.bDecrypt = bDecrypt;
+	if (SelectDispatch(DesDispatchKind(DISPATCH_DES_ECB, nKeys), cbIn, 8 * DES_LANES) == DISPATCH_THREADED)
+	{
+		RunParallelEx(DesEcbWorker, &Batch, cbIn / 8, 8, 0);
+	}
+	else
+	{
+		DesCryptBlocks(Contexts, nKeys, in, out, cbIn / 8, bDecrypt);
+	}
+
+	return;
+}
+
+// DesCbcDecryptDispatch ֐
+// DES (nKeys = 1) ܂ TDEA (nKeys = 3)  CBC ɂ镡s (cbIn  8 ̔{)
+// ͂̃oCgɉāA1 ubN̏ADesCbcDecryptBlocks (ݏ)AXbhv[ł̕񏈗I
+// 񏈗ł͊e؂̒ÖÍubNɑޔ邽߁Ain  out obt@ł悢
+VOID WINAPI DesCbcDecryptDispatch(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	DES_DISPATCH_BATCH Batch;
+	BYTE Prev[8], Next[8], Temp[8];
+	DWORD dwMode, cbCurrent, i, nGroups = cbIn / DES_DISPATCH_GROUP + (cbIn % DES_DISPATCH_GROUP != 0 ? 1 : 0);
+
+	Batch.Contexts = Contexts;
+	Batch.nKeys = nKeys;
+	Batch.in = in;
+	Batch.cbIn = cbIn;
+	Batch.out = out;
+	dwMode = SelectDispatch(DesDispatchKind(DISPATCH_DES_CBC_DECRYPT, nKeys), cbIn, 8 * DES_LANES);
+
+	if (dwMode == DISPATCH_SERIAL)
+	{
+		memcpy(Prev, IV, 8);
+		for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += 8)
+		{
+			memcpy(Next, &in[cbCurrent], 8);
+			DesCryptBlockKeys(Contexts, nKeys, Next, Temp, TRUE);
+			Xor(Temp, Prev, 8, &out[cbCurrent]);
+			memcpy(Prev, Next, 8);
+		}
+		SecureZeroMemory(Temp, sizeof(Temp));
+		return;
+	}
+
+	if (dwMode == DISPATCH_THREADED)
+	{
+		Batch.Prevs = (BYTE*)CiphAllocEx(8 * (SIZE_T)nGroups, CIPH_ALLOC_NO_ZERO);
+		if (Batch.Prevs != NULL)
+		{
+			memcpy(Batch.Prevs, IV, 8);
+			for (i = 1; i < nGroups; i++)
+			{
+				memcpy(&Batch.Prevs[8 * (SIZE_T)i], &in[(SIZE_T)i * DES_DISPATCH_GROUP - 8], 8);
+			}
+			RunParallelEx(DesCbcDecryptWorker, &Batch, nGroups, DES_DISPATCH_GROUP, 0);
+			CiphFree(Batch.Prevs);
+			return;
+		}
+	}
+
+	DesCbcDecryptBlocks(Contexts, nKeys, in, cbIn, IV, out);
+
+	return;
+}
+
+// DesCtrCryptDispatch ֐
+// DES (nKeys = 1) ܂ TDEA (nKeys = 3)  CTR ɂÍ / s (ICV, Offset  DesCtrCryptKeys Ɠ)
+// ͂̃oCgɉāA1 ubN̏ADesCtrCryptKeys (ݏ)ADesCtrCryptParallel (񏈗) I
+VOID WINAPI DesCtrCryptDispatch(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out)
+{
+	BYTE Stream[8];
+	ULONG64 Counter = Load64(ICV) + Offset / 8;
+	DWORD dwMode, cbSkip = (DWORD)(Offset % 8), cbCurrent, cbChunk;
+
+	dwMode = SelectDispatch(DesDispatchKind(DISPATCH_DES_CTR, nKeys), cbIn, 8 * DES_LANES);
+
+	if (dwMode == DISPATCH_SERIAL)
+	{
+		for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += cbChunk)
+		{
+			Store64(Counter++, Stream);
+			DesCryptBlockKeys(Contexts, nKeys, Stream, Stream, FALSE);
+			cbChunk = 8 - cbSkip < cbIn - cbCurrent ? 8 - cbSkip : cbIn - cbCurrent;
+			Xor(&in[cbCurrent], &Stream[cbSkip], cbChunk, &out[cbCurrent]);
+			cbSkip = 0;
+		}
+		SecureZeroMemory(Stream, sizeof(Stream));
+	}
+	else if (dwMode == DISPATCH_THREADED)
+	{
+		DesCtrCryptParallel(Contexts, nKeys, in, cbIn, ICV, Offset, out, 0);
+	}
+	else
+	{
+		DesCtrCryptKeys(Contexts, nKeys, in, cbIn, ICV, Offset, out);
+	}
+
+	return;
+}
+
+// DesCtrEncryptDecryptContext ֐
+// ReLXgp CTR ɂÍ / s
+// Offset ̓f[^Ŝ̐擪̃oCgʒu (擪珈ꍇ 0)AdwThreads ͎QXbh̏ (0 ̏ꍇ̓vZXŜ̏)
+VOID WINAPI DesCtrEncryptDecryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out, DWORD dwThreads)
+{
+	DesCtrCryptParallel(pContext, 1, in, cbIn, ICV, Offset, out, dwThreads);
+
+	return;
+}
+
+VOID WINAPI DesEcbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesEcbEncryptContext(&Context, in, cbIn, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI DesEcbDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesEcbDecryptContext(&Context, in, cbIn, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI DesCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesCbcEncryptContext(&Context, in, cbIn, IV, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI DesCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesCbcDecryptContext(&Context, in, cbIn, IV, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI DesCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesCfbEncryptContext(&Context, in, cbIn, IV, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI DesCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesCfbDecryptContext(&Context, in, cbIn, IV, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI DesOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesOfbEncryptDecryptContext(&Context, in, cbIn, IV, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI DesCtrEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* ICV, BYTE* out)
+{
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context);
+	DesCtrCryptDispatch(&Context, 1, in, cbIn, ICV, 0, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaEncrypt(BYTE* in, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	TdeaCryptBlock(&Context, in, out, FALSE);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaDecrypt(BYTE* in, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	TdeaCryptBlock(&Context, in, out, TRUE);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaEcbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	DesEcbCryptDispatch(Context.Keys, Context.nKeys, in, cbIn, out, FALSE);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaEcbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	DesEcbCryptDispatch(Context.Keys, Context.nKeys, in, cbIn, out, TRUE);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+{
+	BYTE Temp1[8], Temp2[8];
+	DWORD cbCurrent;
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	memcpy(Temp2, IV, 8);
+	for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		Xor(Temp2, &in[cbCurrent], 8, Temp1);
+		TdeaCryptBlock(&Context, Temp1, Temp2, FALSE);
+		memcpy(&out[cbCurrent], Temp2, 8);
+	}
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	DesCbcDecryptDispatch(Context.Keys, Context.nKeys, in, cbIn, IV, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+{
+	BYTE Temp1[8], Temp2[8];
+	DWORD cbCurrent;
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	memcpy(Temp2, IV, 8);
+	for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		TdeaCryptBlock(&Context, Temp2, Temp1, FALSE);
+		Xor(&in[cbCurrent], Temp1, 8, Temp2);
+		memcpy(&out[cbCurrent], Temp2, 8);
+	}
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+{
+	BYTE Temp[8];
+	DWORD cbCurrent;
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		TdeaCryptBlock(&Context, cbCurrent == 0 ? IV : &in[cbCurrent - 8], Temp, FALSE);
+		Xor(&in[cbCurrent], Temp, 8, &out[cbCurrent]);
+	}
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+VOID WINAPI TdeaOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+{
+	BYTE Temp[8];
+	DWORD cbCurrent;
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	memcpy(Temp, IV, 8);
+	for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		TdeaCryptBlock(&Context, Temp, Temp, FALSE);
+		Xor(&in[cbCurrent], Temp, 8, &out[cbCurrent]);
+	}
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+// TdeaCtrEncryptDecrypt ֐
+// CTR ɂÍ /  DesCtrCryptDispatch ōs (JE^ ICV n܂ 64 rbg big endian ̐)
+VOID WINAPI TdeaCtrEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* ICV, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	DesCtrCryptDispatch(Context.Keys, Context.nKeys, in, cbIn, ICV, 0, out);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return;
+}
+
+// ubNÍ / ֐̌^
+// DES  pContext->Keys[0] ̂݁ATDEA  TdeaKeySetup ō쐬ReLXggp
+typedef VOID(WINAPI* DES_BLOCK_FUNCTION)(BYTE* in, BYTE* out, TDEA_KEY_CONTEXT* pContext);
+
+VOID WINAPI DesBlockEncrypt(BYTE* in, BYTE* out, TDEA_KEY_CONTEXT* pContext)
+{
+	DesCryptBlock(&pContext->Keys[0], in, out, FALSE);
+}
+
+VOID WINAPI DesBlockDecrypt(BYTE* in, BYTE* out, TDEA_KEY_CONTEXT* pContext)
+{
+	DesCryptBlock(&pContext->Keys[0], in, out, TRUE);
+}
+
+VOID WINAPI TdeaBlockEncrypt(BYTE* in, BYTE* out, TDEA_KEY_CONTEXT* pContext)
+{
+	TdeaCryptBlock(pContext, in, out, FALSE);
+}
+
+VOID WINAPI TdeaBlockDecrypt(BYTE* in, BYTE* out, TDEA_KEY_CONTEXT* pContext)
+{
+	TdeaCryptBlock(pContext, in, out, TRUE);
+}
+
+// DesGetOutputLength ֐
+// pfBOɉÍ̃oCgԂ
+// PKCS#7 ͕K 1 ` 8 oCg̃pfBOt邽߁A 8 ̔{ɐ؂グ
+// Íގ (CS1, CS2, CS3) ͕ƓoCg̈Ío͂
+DWORD WINAPI DesGetOutputLength(DWORD cbIn, DWORD dwPadding)
+{
+	if (dwPadding == DES_PADDING_PKCS7)
+	{
+		return (cbIn / 8 + 1) * 8;
+	}
+
+	return cbIn;
+}
+
+// EcbEncryptPkcs7 ֐
+// PKCS#7 pfBOt ECB ɂÍs
+// SȃubN͓̓f[^璼ڈÍAŌ̃ubN̂݃X^bNőgݗĂ
+VOID WINAPI EcbEncryptPkcs7(BYTE* in, DWORD cbIn, DES_BLOCK_FUNCTION Encrypt, TDEA_KEY_CONTEXT* pContext, BYTE* out)
+{
+	DWORD cbCurrent, cbFull = cbIn & ~7UL;
+	BYTE Temp[8];
+
+	for (cbCurrent = 0; cbCurrent < cbFull; cbCurrent += 8)
+	{
+		Encrypt(&in[cbCurrent], &out[cbCurrent], pContext);
+	}
+
+	Pkcs7PadBlock(&in[cbFull], cbIn - cbFull, 8, Temp);
+	Encrypt(Temp, &out[cbFull], pContext);
+
+	return;
+}
+
+// EcbDecryptPkcs7 ֐
+// ECB ɂ镡sAPKCS#7 pfBO菜
+BOOL WINAPI EcbDecryptPkcs7(BYTE* in, DWORD cbIn, DES_BLOCK_FUNCTION Decrypt, TDEA_KEY_CONTEXT* pContext, BYTE* out, DWORD* pcbOut)
+{
+	DWORD cbCurrent, cbLast;
+	BYTE Temp[8];
+
+	if (cbIn == 0 || cbIn % 8 != 0)
+	{
+		return FALSE;
+	}
+
+	for (cbCurrent = 0; cbCurrent < cbIn - 8; cbCurrent += 8)
+	{
+		Decrypt(&in[cbCurrent], &out[cbCurrent], pContext);
+	}
+
+	Decrypt(&in[cbIn - 8], Temp, pContext);
+	if (!Pkcs7UnpadBlock(Temp, 8, &cbLast))
+	{
+		return FALSE;
+	}
+	memcpy(&out[cbIn - 8], Temp, cbLast);
+	*pcbOut = cbIn - 8 + cbLast;
+
+	return TRUE;
+}
+
+// CbcEncryptPkcs7 ֐
+// PKCS#7 pfBOt CBC ɂÍs
+VOID WINAPI CbcEncryptPkcs7(BYTE* in, DWORD cbIn, DES_BLOCK_FUNCTION Encrypt, TDEA_KEY_CONTEXT* pContext, BYTE* IV, BYTE* out)
+{
+	DWORD cbCurrent, cbFull = cbIn & ~7UL;
+	BYTE Temp1[8], Temp2[8];
+
+	memcpy(Temp2, IV, 8);
+	for (cbCurrent = 0; cbCurrent < cbFull; cbCurrent += 8)
+	{
+		Xor(&in[cbCurrent], Temp2, 8, Temp1);
+		Encrypt(Temp1, Temp2, pContext);
+		memcpy(&out[cbCurrent], Temp2, 8);
+	}
+
+	Pkcs7PadBlock(&in[cbFull], cbIn - cbFull, 8, Temp1);
+	Xor(Temp1, Temp2, 8, Temp1);
+	Encrypt(Temp1, &out[cbFull], pContext);
+
+	return;
+}
+
+// CbcDecryptPkcs7 ֐
+// CBC ɂ镡sAPKCS#7 pfBO菜
+BOOL WINAPI CbcDecryptPkcs7(BYTE* in, DWORD cbIn, DES_BLOCK_FUNCTION Decrypt, TDEA_KEY_CONTEXT* pContext, BYTE* IV, BYTE* out, DWORD* pcbOut)
+{
+	DWORD cbCurrent, cbLast;
+	BYTE Temp1[8], Temp2[8];
+
+	if (cbIn == 0 || cbIn % 8 != 0)
+	{
+		return FALSE;
+	}
+
+	for (cbCurrent = 0; cbCurrent < cbIn; cbCurrent += 8)
+	{
+		Decrypt(&in[cbCurrent], Temp1, pContext);
+		Xor(Temp1, cbCurrent == 0 ? IV : &in[cbCurrent - 8], 8, Temp2);
+		if (cbCurrent + 8 < cbIn)
+		{
+			memcpy(&out[cbCurrent], Temp2, 8);
+		}
+	}
+
+	if (!Pkcs7UnpadBlock(Temp2, 8, &cbLast))
+	{
+		return FALSE;
+	}
+	memcpy(&out[cbIn - 8], Temp2, cbLast);
+	*pcbOut = cbIn - 8 + cbLast;
+
+	return TRUE;
+}
+
+// CbcEncryptCts ֐
+// Íގ (Ciphertext Stealing) p CBC ɂÍs
+// NIST SP 800-38A Addendum  CBC-CS1, CBC-CS2, CBC-CS3 ɑΉAÍ͕ƓoCgɂȂ
+//  P1, P2, ..., Pn-1, Pn* (Pn*  d oCg, 1 <= d <= 8) Ƃ
+// 1. Pn* ̌ 0 t Pn ܂߂Ēʏ CBC  C1 ` Cn ߂
+// 2. Cn-1 ̐擪 d oCg Cn-1' ƂAc 8 - d oCg͏o͂Ȃ (Cn ̕ŕł)
+// 3. o͈͂̏ȉ̒ʂ
+//    CS1 : C1 || ... || Cn-2 || Cn-1' || Cn
+//    CS2 : d = 8 ̏ꍇ CS1 ƓAȊO CS3 Ɠ
+//    CS3 : C1 || ... || Cn-2 || Cn || Cn-1'
+// ̓f[^ 8 oCgȏłKv
+BOOL WINAPI CbcEncryptCts(BYTE* in, DWORD cbIn, DES_BLOCK_FUNCTION Encrypt, TDEA_KEY_CONTEXT* pContext, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	DWORD cbCurrent, cbTail, cbHead;
+	BYTE Temp1[8], Temp2[8], Last[8];
+
+	if (cbIn < 8 || dwPadding < DES_PADDING_CS1 || dwPadding > DES_PADDING_CS3)
+	{
+		return FALSE;
+	}
+
+	cbTail = cbIn % 8 != 0 ? cbIn % 8 : 8;
+	cbHead = cbIn - cbTail;
+
+	if (cbHead == 0)
+	{
+		Xor(in, IV, 8, Temp1);
+		Encrypt(Temp1, out, pContext);
+		return TRUE;
+	}
+
+	// C1 ` Cn-2 ͒ʏ CBC Œڏo͂ACn-1  Temp2 Ɏc
+	memcpy(Temp2, IV, 8);
+	for (cbCurrent = 0; cbCurrent < cbHead; cbCurrent += 8)
+	{
+		Xor(&in[cbCurrent], Temp2, 8, Temp1);
+		Encrypt(Temp1, Temp2, pContext);
+		if (cbCurrent + 8 < cbHead)
+		{
+			memcpy(&out[cbCurrent], Temp2, 8);
+		}
+	}
+
+	// Pn* ̌ 0 t Cn ߂
+	ZeroMemory(Temp1, 8);
+	memcpy(Temp1, &in[cbHead], cbTail);
+	Xor(Temp1, Temp2, 8, Temp1);
+	Encrypt(Temp1, Last, pContext);
+
+	if (dwPadding == DES_PADDING_CS1 || (dwPadding == DES_PADDING_CS2 && cbTail == 8))
+	{
+		memcpy(&out[cbHead - 8], Temp2, cbTail);
+		memcpy(&out[cbHead - 8 + cbTail], Last, 8);
+	}
+	else
+	{
+		memcpy(&out[cbHead - 8], Last, 8);
+		memcpy(&out[cbHead], Temp2, cbTail);
+	}
+
+	return TRUE;
+}
+
+// CbcDecryptCts ֐
+// Íގ (Ciphertext Stealing) p CBC ɂ镡s
+// Cn 𕡍ʂ̌ 8 - d oCgAo͂Ȃ Cn-1 ̎c̕ƂȂ
+BOOL WINAPI CbcDecryptCts(BYTE* in, DWORD cbIn, DES_BLOCK_FUNCTION Decrypt, TDEA_KEY_CONTEXT* pContext, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	DWORD cbCurrent, cbTail, cbHead;
+	BYTE Temp[8], Prev[8], * pPrev, * pLast;
+
+	if (cbIn < 8 || dwPadding < DES_PADDING_CS1 || dwPadding > DES_PADDING_CS3)
+	{
+		return FALSE;
+	}
+
+	cbTail = cbIn % 8 != 0 ? cbIn % 8 : 8;
+	cbHead = cbIn - cbTail;
+
+	if (cbHead == 0)
+	{
+		Decrypt(in, Temp, pContext);
+		Xor(Temp, IV, 8, out);
+		return TRUE;
+	}
+
+	for (cbCurrent = 0; cbCurrent + 8 < cbHead; cbCurrent += 8)
+	{
+		Decrypt(&in[cbCurrent], Temp, pContext);
+		Xor(Temp, cbCurrent == 0 ? IV : &in[cbCurrent - 8], 8, &out[cbCurrent]);
+	}
+
+	if (dwPadding == DES_PADDING_CS1 || (dwPadding == DES_PADDING_CS2 && cbTail == 8))
+	{
+		pPrev = &in[cbHead - 8];
+		pLast = &in[cbHead - 8 + cbTail];
+	}
+	else
+	{
+		pLast = &in[cbHead - 8];
+		pPrev = &in[cbHead];
+	}
+
+	// Cn 𕡍ACn-1' ƌʂ̌ 8 - d oCg Cn-1 𕜌
+	Decrypt(pLast, Temp, pContext);
+	memcpy(Prev, pPrev, cbTail);
+	memcpy(&Prev[cbTail], &Temp[cbTail], 8 - cbTail);
+	Xor(Temp, Prev, cbTail, &out[cbHead]);
+
+	Decrypt(Prev, Temp, pContext);
+	Xor(Temp, cbHead == 8 ? IV : &in[cbHead - 16], 8, &out[cbHead - 8]);
+
+	return TRUE;
+}
+
+VOID WINAPI DesEcbEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context.Keys[0]);
+	Context.nKeys = 1;
+	EcbEncryptPkcs7(in, cbIn, DesBlockEncrypt, &Context, out);
+
+	return;
+}
+
+BOOL WINAPI DesEcbDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out, DWORD* pcbOut)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context.Keys[0]);
+	Context.nKeys = 1;
+	return EcbDecryptPkcs7(in, cbIn, DesBlockDecrypt, &Context, out, pcbOut);
+}
+
+VOID WINAPI DesCbcEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context.Keys[0]);
+	Context.nKeys = 1;
+	CbcEncryptPkcs7(in, cbIn, DesBlockEncrypt, &Context, IV, out);
+
+	return;
+}
+
+BOOL WINAPI DesCbcDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out, DWORD* pcbOut)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context.Keys[0]);
+	Context.nKeys = 1;
+	return CbcDecryptPkcs7(in, cbIn, DesBlockDecrypt, &Context, IV, out, pcbOut);
+}
+
+BOOL WINAPI DesCbcEncryptCts(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context.Keys[0]);
+	Context.nKeys = 1;
+	return CbcEncryptCts(in, cbIn, DesBlockEncrypt, &Context, IV, dwPadding, out);
+}
+
+BOOL WINAPI DesCbcDecryptCts(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	DesKeySetup(OriginalKey, &Context.Keys[0]);
+	Context.nKeys = 1;
+	return CbcDecryptCts(in, cbIn, DesBlockDecrypt, &Context, IV, dwPadding, out);
+}
+
+VOID WINAPI TdeaEcbEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	EcbEncryptPkcs7(in, cbIn, TdeaBlockEncrypt, &Context, out);
+
+	return;
+}
+
+BOOL WINAPI TdeaEcbDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out, DWORD* pcbOut)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	return EcbDecryptPkcs7(in, cbIn, TdeaBlockDecrypt, &Context, out, pcbOut);
+}
+
+VOID WINAPI TdeaCbcEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	CbcEncryptPkcs7(in, cbIn, TdeaBlockEncrypt, &Context, IV, out);
+
+	return;
+}
+
+BOOL WINAPI TdeaCbcDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out, DWORD* pcbOut)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	return CbcDecryptPkcs7(in, cbIn, TdeaBlockDecrypt, &Context, IV, out, pcbOut);
+}
+
+BOOL WINAPI TdeaCbcEncryptCts(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	return CbcEncryptCts(in, cbIn, TdeaBlockEncrypt, &Context, IV, dwPadding, out);
+}
+
+BOOL WINAPI TdeaCbcDecryptCts(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	TDEA_KEY_CONTEXT Context;
+
+	TdeaKeySetup(Key1, Key2, Key3, &Context);
+	return CbcDecryptCts(in, cbIn, TdeaBlockDecrypt, &Context, IV, dwPadding, out);
+}
+
+VOID WINAPI TdeaEcbEncryptPkcs7Context(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out)
+{
+	EcbEncryptPkcs7(in, cbIn, TdeaBlockEncrypt, pContext, out);
+
+	return;
+}
+
+BOOL WINAPI TdeaEcbDecryptPkcs7Context(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out, DWORD* pcbOut)
+{
+	return EcbDecryptPkcs7(in, cbIn, TdeaBlockDecrypt, pContext, out, pcbOut);
+}
+
+VOID WINAPI TdeaCbcEncryptPkcs7Context(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out)
+{
+	CbcEncryptPkcs7(in, cbIn, TdeaBlockEncrypt, pContext, IV, out);
+
+	return;
+}
+
+BOOL WINAPI TdeaCbcDecryptPkcs7Context(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out, DWORD* pcbOut)
+{
+	return CbcDecryptPkcs7(in, cbIn, TdeaBlockDecrypt, pContext, IV, out, pcbOut);
+}
+
+BOOL WINAPI TdeaCbcEncryptCtsContext(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	return CbcEncryptCts(in, cbIn, TdeaBlockEncrypt, pContext, IV, dwPadding, out);
+}
+
+BOOL WINAPI TdeaCbcDecryptCtsContext(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, DWORD dwPadding, BYTE* out)
+{
+	return CbcDecryptCts(in, cbIn, TdeaBlockDecrypt, pContext, IV, dwPadding, out);
+}
+
+// ꊇœɐi߂郁bZ[W (AVX2 ̃rbgXCX 1 xɏubNɍ킹)
+#define DES_MAC_LANES DES_BITSLICE_BLOCKS256
+
+// DesMacDouble ֐
+// CMAC ̃TǔvZŁA64 rbg̃ubN GF(2^64)  x { (Rb = 0x1b)
+VOID WINAPI DesMacDouble(BYTE* in, BYTE* out)
+{
+	ULONG64 v = Load64(in);
+
+	Store64((v << 1) ^ ((0 - (v >> 63)) & 0x1b), out);
+
+	return;
+}
+
+// DesMacInit ֐
+// Algorithm 1, CMAC ł Key1 ` Key3  TdeaKeySetup ƓlɈ (DES  Key1 == Key2 == Key3 Ƃ邩AKey2, Key3  NULL Ƃ)
+// Algorithm 3 ł Key1  KAKey2  K' ƂĎgpAKey3 ͎gpȂ
+VOID WINAPI DesMacInit(BYTE* Key1, BYTE* Key2, BYTE* Key3, DWORD dwAlgorithm, DWORD dwPadding, DES_MAC_CONTEXT* pContext)
+{
+	BYTE L[8] = { 0 };
+
+	ZeroMemory(pContext, sizeof(DES_MAC_CONTEXT));
+	pContext->dwAlgorithm = dwAlgorithm;
+	pContext->dwPadding = dwPadding;
+
+	if (dwAlgorithm == DES_MAC_ALGORITHM3)
+	{
+		DesKeySetup(Key1, &pContext->Key.Keys[0]);
+		pContext->Key.nKeys = 1;
+		DesKeySetup(Key2, &pContext->Key2);
+		return;
+	}
+
+	if (Key2 == NULL || Key3 == NULL)
+	{
+		DesKeySetup(Key1, &pContext->Key.Keys[0]);
+		pContext->Key.nKeys = 1;
+	}
+	else
+	{
+		TdeaKeySetup(Key1, Key2, Key3, &pContext->Key);
+	}
+
+	if (dwAlgorithm == DES_MAC_CMAC)
+	{
+		TdeaCryptBlock(&pContext->Key, L, L, FALSE);
+		DesMacDouble(L, pContext->K1);
+		DesMacDouble(pContext->K1, pContext->K2);
+		SecureZeroMemory(L, 8);
+	}
+
+	return;
+}
+
+// DesMacBlockCount ֐
+// pfBÕbZ[W̃ubNԂ
+DWORD WINAPI DesMacBlockCount(DES_MAC_CONTEXT* pContext, DWORD cbIn)
+{
+	if (pContext->dwAlgorithm != DES_MAC_CMAC && pContext->dwPadding == DES_MAC_PADDING2)
+	{
+		return cbIn / 8 + 1;
+	}
+
+	return cbIn == 0 ? 1 : (cbIn + 7) / 8;
+}
+
+// DesMacLoadBlock ֐
+// pfBÕbZ[W dwBlock Ԗڂ̃ubN Block Ɏo
+// CMAC ̍Ō̃ubŃASȃubNȂ K1 AłȂ 10* ŃpfBO K2  XOR 
+VOID WINAPI DesMacLoadBlock(DES_MAC_CONTEXT* pContext, BYTE* in, DWORD cbIn, DWORD dwBlock, BYTE* Block)
+{
+	DWORD cbLast;
+
+	if (dwBlock + 1 < DesMacBlockCount(pContext, cbIn))
+	{
+		memcpy(Block, &in[8 * dwBlock], 8);
+		return;
+	}
+
+	cbLast = cbIn - 8 * dwBlock;
+	if (cbLast == 8)
+	{
+		memcpy(Block, &in[8 * dwBlock], 8);
+		if (pContext->dwAlgorithm == DES_MAC_CMAC)
+		{
+			Xor(Block, pContext->K1, 8, Block);
+		}
+		return;
+	}
+
+	// ̃bZ[W in  NULL ̏ꍇ
+	ZeroMemory(Block, 8);
+	if (cbLast != 0)
+	{
+		memcpy(Block, &in[8 * dwBlock], cbLast);
+	}
+	if (pContext->dwAlgorithm == DES_MAC_CMAC)
+	{
+		Block[cbLast] = 0x80;
+		Xor(Block, pContext->K2, 8, Block);
+	}
+	else if (pContext->dwPadding == DES_MAC_PADDING2)
+	{
+		Block[cbLast] = 0x80;
+	}
+
+	return;
+}
+
+// DesMac ֐
+// bZ[WF؃R[h (8 oCg) vZBXPW[̓ReLXĝ̂gAubNɍ蒼Ȃ
+// 
+//        D1                  D2                  Dq (pfBO̍Ō̃ubN)
+//        |                   |                   |
+//        |         +------->xor        +------->xor
+//        |         |         |         |         |
+//        v         |         v         |         v
+//      CIPH_K      |       CIPH_K      |       CIPH_K
+//        |         |         |         |         |
+//        +---------+         +---------+         +---> H ---> (Algorithm 3 : E_K(D_K'(H))) ---> MAC
+// 
+VOID WINAPI DesMac(DES_MAC_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* Mac)
+{
+	DWORD i, nBlocks = DesMacBlockCount(pContext, cbIn);
+	BYTE Block[8], X[8] = { 0 };
+
+	for (i = 0; i < nBlocks; i++)
+	{
+		DesMacLoadBlock(pContext, in, cbIn, i, Block);
+		Xor(X, Block, 8, X);
+		TdeaCryptBlock(&pContext->Key, X, X, FALSE);
+	}
+	if (pContext->dwAlgorithm == DES_MAC_ALGORITHM3)
+	{
+		DesCryptBlock(&pContext->Key2, X, X, TRUE);
+		DesCryptBlock(&pContext->Key.Keys[0], X, X, FALSE);
+	}
+	memcpy(Mac, X, 8);
+
+	return;
+}
+
+// DesMacBatch ֐
+//  nMessages ̓ƗbZ[W MAC vZAMacs  8 oCgi[
+// 1 ̃bZ[W CBC-MAC ͑ÕubŇʂ҂Kv邪AقȂ郁bZ[W̘A͓ƗĂ
+// ōő DES_MAC_LANES ̃bZ[W̘A 1 ubNĐi߁AeXebv 1 x DesCryptBlocks ŏ
+// (64 [ȏ㑵Ă΃rbgXCXŏ)
+// ZbZ[WI[ɂ͎̃bZ[W[Aɑ̃ubN܂Ƃ߂ď悤ɂ
+// Algorithm 3 ̏o͕ϊAXebvŏI[܂Ƃ߂ď
+VOID WINAPI DesMacBatch(DES_MAC_CONTEXT* pContext, BYTE** Messages, DWORD* cbMessages, DWORD nMessages, BYTE* Macs)
+{
+	DWORD j, nDone, dwNext = 0, nActive = 0;
+	DWORD Lane[DES_MAC_LANES], Block[DES_MAC_LANES], Done[DES_MAC_LANES];
+	BYTE State[8 * DES_MAC_LANES], Input[8 * DES_MAC_LANES], Output[8 * DES_MAC_LANES];
+
+	for (;;)
+	{
+		// 󂢂[Ɏ̃bZ[W蓖Ă
+		while (nActive < DES_MAC_LANES && dwNext < nMessages)
+		{
+			Lane[nActive] = dwNext++;
+			Block[nActive] = 0;
+			ZeroMemory(&State[8 * nActive], 8);
+			nActive++;
+		}
+		if (nActive == 0)
+		{
+			break;
+		}
+
+		// e[̎̃ubNׂāA܂Ƃ߂ĈÍ
+		for (j = 0; j < nActive; j++)
+		{
+			DesMacLoadBlock(pContext, Messages[Lane[j]], cbMessages[Lane[j]], Block[j], &Input[8 * j]);
+		}
+		Xor(Input, State, 8 * nActive, Input);
+		DesCryptBlocks(pContext->Key.Keys, pContext->Key.nKeys, Input, State, nActive, FALSE);
+
+		// Ō̃ubN܂ŏ[̌ʂW߂
+		for (j = 0, nDone = 0; j < nActive; j++)
+		{
+			if (++Block[j] == DesMacBlockCount(pContext, cbMessages[Lane[j]]))
+			{
+				memcpy(&Output[8 * nDone], &State[8 * j], 8);
+				Done[nDone++] = Lane[j];
+			}
+		}
+		if (nDone != 0 && pContext->dwAlgorithm == DES_MAC_ALGORITHM3)
+		{
+			DesCryptBlocks(&pContext->Key2, 1, Output, Output, nDone, TRUE);
+			DesCryptBlocks(pContext->Key.Keys, 1, Output, Output, nDone, FALSE);
+		}
+		for (j = 0; j < nDone; j++)
+		{
+			memcpy(&Macs[8 * (SIZE_T)Done[j]], &Output[8 * j], 8);
+		}
+
+		// I[Ō̃[ŋl߂
+		for (j = 0; j < nActive;)
+		{
+			if (Block[j] < DesMacBlockCount(pContext, cbMessages[Lane[j]]))
+			{
+				j++;
+				continue;
+			}
+
+			nActive--;
+			if (j != nActive)
+			{
+				Lane[j] = Lane[nActive];
+				Block[j] = Block[nActive];
+				memcpy(&State[8 * j], &State[8 * nActive], 8);
+			}
+		}
+	}
+
+	return;
+}
+
+// DesMacVerifyBatch ֐
+// nMessages ̃bZ[W MAC ܂Ƃ߂ČvZAMacs  cbMac oCg (1 ` 8A擪؂l߂) ׂlƔr
+// Results[i] ɊebZ[W̌،ʂi[AvbZ[W̐ԂBr͈vȂoCg̈ʒuɂ炸Ԃōs
+DWORD WINAPI DesMacVerifyBatch(DES_MAC_CONTEXT* pContext, BYTE** Messages, DWORD* cbMessages, DWORD nMessages, BYTE* Macs, DWORD cbMac, BOOL* Results)
+{
+	DWORD i, j, nValid = 0;
+	BYTE* Computed, bDiff;
+
+	Computed = (BYTE*)CiphAlloc(8 * (SIZE_T)nMessages + 8);
+	DesMacBatch(pContext, Messages, cbMessages, nMessages, Computed);
+
+	for (i = 0; i < nMessages; i++)
+	{
+		bDiff = 0;
+		for (j = 0; j < cbMac; j++)
+		{
+			bDiff |= Computed[8 * (SIZE_T)i + j] ^ Macs[cbMac * (SIZE_T)i + j];
+		}
+		Results[i] = bDiff == 0;
+		nValid += bDiff == 0;
+	}
+
+	SecureZeroMemory(Computed, 8 * (SIZE_T)nMessages);
+	CiphFree(Computed);
+
+	return nValid;
+}
+
+// DUKPT (Derived Unique Key Per Transaction, TDES)
+// Ql
+// ANSI X9.24-1:2009 (Annex A)
+// 
+// KSN (10 oCg) ́A̎ʎq (59 rbg)  21 rbg̃gUNVJE^Ȃ
+// [̏ IPEK  BDK  KSN (JE^ 0 Ƃ) 瓱o
+// gUNV IPEK AJE^ 1 ̃rbgʂ珇 KSN ɉȂ
+// t (NRKGP) JԂċ߂ (ő 21 Aۂɂ̓JE^ 1 ̃rbg 10 ȉ)
+// 
+//   IPEK ---NRKGP(R8 | b20)---> Key ---NRKGP(R8 | b20 | b17)---> ... ---> gUNV
+// 
+// [̃JE^ 1 邽߁AAgUNV͏ʂ̃rbg̓rL
+// DUKPT_CONTEXT ͂̓rrbgʒuɕێAOƈقȂrbg悾vZ
+
+const ULONG64 DukptVariantMask[6] =
+{
+	0x0000000000000000, 0x00000000000000FF, 0x000000000000FF00, 0x00000000FF000000, 0x0000000000FF0000, 0x000000FF00000000
+};
+
+// DukptBdkSetup ֐
+// BDK (2  TDEAA16 oCg) ̌XPW[쐬
+VOID WINAPI DukptBdkSetup(BYTE* Bdk, DUKPT_BDK_CONTEXT* pContext)
+{
+	BYTE Variant[16];
+
+	TdeaKeySetup(Bdk, &Bdk[8], Bdk, &pContext->Bdk);
+	Store64(Load64(Bdk) ^ 0xC0C0C0C000000000, Variant);
+	Store64(Load64(&Bdk[8]) ^ 0xC0C0C0C000000000, &Variant[8]);
+	TdeaKeySetup(Variant, &Variant[8], Variant, &pContext->BdkVariant);
+	SecureZeroMemory(Variant, 16);
+
+	return;
+}
+
+// DukptIpekBlock ֐
+// IPEK ̓oɎgAKSN ̃JE^ 0 Ƃ 8 oCgԂ
+ULONG64 WINAPI DukptIpekBlock(BYTE* Ksn)
+{
+	return Load64(Ksn) & 0xFFFFFFFFFFFFFFE0;
+}
+
+// DukptCounter ֐
+// KSN ̉E[ 21 rbg̃gUNVJE^Ԃ
+DWORD WINAPI DukptCounter(BYTE* Ksn)
+{
+	return (Ksn[7] & 0x1F) << 16 | Ksn[8] << 8 | Ksn[9];
+}
+
+// DukptDeriveIpek ֐
+// BDK  KSN  IPEK (16 oCg) 𓱏o
+VOID WINAPI DukptDeriveIpek(DUKPT_BDK_CONTEXT* pBdk, BYTE* Ksn, BYTE* Ipek)
+{
+	Store64(DukptIpekBlock(Ksn), Ipek);
+	Store64(DukptIpekBlock(Ksn), &Ipek[8]);
+	TdeaCryptBlock(&pBdk->Bdk, Ipek, Ipek, FALSE);
+	TdeaCryptBlock(&pBdk->BdkVariant, &Ipek[8], &Ipek[8], FALSE);
+
+	return;
+}
+
+// DukptInit ֐
+// IPEK  KSN [̓oԂ쐬 (JE^͖)
+VOID WINAPI DukptInit(BYTE* Ipek, BYTE* Ksn, DUKPT_CONTEXT* pContext)
+{
+	memcpy(pContext->Ksn, Ksn, 10);
+	pContext->Ksn[7] &= 0xE0;
+	pContext->Ksn[8] = 0;
+	pContext->Ksn[9] = 0;
+	memcpy(pContext->Ipek, Ipek, 16);
+	pContext->dwCounter = 0;
+	pContext->bCached = FALSE;
+
+	return;
+}
+
+// DukptNonReversibleKey ֐
+// t (NRKGP) :  Key (KL || KR)  KSN ̉E 8 oCg R8 玟̌
+// 
+//   E = DES_KL(R8 ^ KR) ^ KR
+//    = DES_KL'(R8 ^ KR') ^ KR'   (KL' || KR' = Key ^ C0C0C0C000000000C0C0C0C000000000)
+// 
+VOID WINAPI DukptNonReversibleKey(BYTE* Key, ULONG64 R8, BYTE* out)
+{
+	BYTE Left[8], Right[8], Half[8];
+	ULONG64 KR = Load64(&Key[8]);
+	DES_KEY_CONTEXT Context;
+
+	DesKeySetup(Key, &Context);
+	Store64(R8 ^ KR, Right);
+	DesCryptBlock(&Context, Right, Right, FALSE);
+	Store64(Load64(Right) ^ KR, Right);
+
+	Store64(Load64(Key) ^ 0xC0C0C0C000000000, Half);
+	KR ^= 0xC0C0C0C000000000;
+	DesKeySetup(Half, &Context);
+	Store64(R8 ^ KR, Left);
+	DesCryptBlock(&Context, Left, Left, FALSE);
+	Store64(Load64(Left) ^ KR, Left);
+
+	memcpy(out, Left, 8);
+	memcpy(&out[8], Right, 8);
+
+	SecureZeroMemory(&Context, sizeof(Context));
+	SecureZeroMemory(Half, 8);
+
+	return;
+}
+
+// DukptApplyVariant ֐
+// gUNVɕό`Kp
+// f[^Íp̕ό`́A}XN XOR Ŏg̍E̔ꂼ TDEA ňÍ̂Ƃ
+VOID WINAPI DukptApplyVariant(BYTE* Key, DWORD dwVariant, BYTE* out)
+{
+	BYTE Variant[16];
+	TDEA_KEY_CONTEXT Context;
+
+	Store64(Load64(Key) ^ DukptVariantMask[dwVariant], Variant);
+	Store64(Load64(&Key[8]) ^ DukptVariantMask[dwVariant], &Variant[8]);
+
+	if (dwVariant == DUKPT_VARIANT_DATA_REQUEST || dwVariant == DUKPT_VARIANT_DATA_RESPONSE)
+	{
+		TdeaKeySetup(Variant, &Variant[8], Variant, &Context);
+		TdeaCryptBlock(&Context, Variant, Variant, FALSE);
+		TdeaCryptBlock(&Context, &Variant[8], &Variant[8], FALSE);
+		SecureZeroMemory(&Context, sizeof(Context));
+	}
+	memcpy(out, Variant, 16);
+	SecureZeroMemory(Variant, 16);
+
+	return;
+}
+
+// DukptDeriveKey ֐
+// JE^ dwCounter ̃gUNV𓱏oAό`Kp Key (16 oCg) Ɋi[
+// ÕJE^Əʂ̃rbǵAێĂrĊJ
+VOID WINAPI DukptDeriveKey(DUKPT_CONTEXT* pContext, DWORD dwCounter, DWORD dwVariant, BYTE* Key)
+{
+	INT b;
+	DWORD dwDiff, dwShift;
+	ULONG64 R8 = Load64(&pContext->Ksn[2]);
+	BYTE* pCurrent = pContext->Ipek;
+
+	dwCounter &= DUKPT_COUNTER_MASK;
+
+	// OƈقȂŏʂ̃rbǵAO̓r̂܂܎g
+	dwDiff = pContext->bCached ? dwCounter ^ pContext->dwCounter : DUKPT_COUNTER_MASK;
+
+	for (b = DUKPT_COUNTER_BITS - 1; b >= 0; b--)
+	{
+		dwShift = 1UL << b;
+		if ((dwCounter & dwShift) == 0)
+		{
+			continue;
+		}
+
+		R8 |= dwShift;
+		if ((dwDiff >> b) != 0)
+		{
+			DukptNonReversibleKey(pCurrent, R8, pContext->Keys[b]);
+		}
+		pCurrent = pContext->Keys[b];
+	}
+	pContext->dwCounter = dwCounter;
+	pContext->bCached = TRUE;
+
+	DukptApplyVariant(pCurrent, dwVariant, Key);
+
+	return;
+}
+
+// ꊇoŕבւ KSN ƁǍ̈ʒu
+typedef struct
+{
+	BYTE* Ksn;
+	DWORD dwIndex;
+} DUKPT_BATCH_ITEM;
+
+// DukptCompareKsn ֐
+// KSN ̎ʎqAJE^̏ɕׂ邽߂̔r֐ ( KSN ͌̏ɕׂ)
+INT __cdecl DukptCompareKsn(CONST VOID* p1, CONST VOID* p2)
+{
+	CONST DUKPT_BATCH_ITEM* pItem1 = (CONST DUKPT_BATCH_ITEM*)p1;
+	CONST DUKPT_BATCH_ITEM* pItem2 = (CONST DUKPT_BATCH_ITEM*)p2;
+	INT nResult = memcmp(pItem1->Ksn, pItem2->Ksn, 10);
+
+	if (nResult == 0)
+	{
+		nResult = pItem1->dwIndex < pItem2->dwIndex ? -1 : pItem1->dwIndex > pItem2->dwIndex;
+	}
+
+	return nResult;
+}
+
+// DukptDeriveBatch ֐
+// nKsns  KSN (10 oCgׂ) ̃gUNV𓱏oAKeys  16 oCgi[
+// KSN בւē[̂̂אڂAIPEK ͈قȂ[̕܂Ƃ߂ DesCryptBlocks œo
+// ([ 64 ȏ゠΃rbgXCXŏ)
+// [ KSN ̓JE^̏ DukptDeriveKey ŏAʂ̃rbg̓rL
+VOID WINAPI DukptDeriveBatch(DUKPT_BDK_CONTEXT* pBdk, BYTE* Ksns, DWORD nKsns, DWORD dwVariant, BYTE* Keys)
+{
+	DWORD i, j, nDevices = 0;
+	DUKPT_BATCH_ITEM* Items;
+	BYTE* Left, * Right;
+	DUKPT_CONTEXT* pContext;
+	BYTE Ipek[16];
+
+	if (nKsns == 0)
+	{
+		return;
+	}
+
+	Items = (DUKPT_BATCH_ITEM*)CiphAlloc(sizeof(DUKPT_BATCH_ITEM) * nKsns);
+	Left = (BYTE*)CiphAlloc(8 * (SIZE_T)nKsns);
+	Right = (BYTE*)CiphAlloc(8 * (SIZE_T)nKsns);
+	pContext = (DUKPT_CONTEXT*)CiphAlloc(sizeof(DUKPT_CONTEXT));
+
+	for (i = 0; i < nKsns; i++)
+	{
+		Items[i].Ksn = &Ksns[10 * (SIZE_T)i];
+		Items[i].dwIndex = i;
+	}
+	qsort(Items, nKsns, sizeof(DUKPT_BATCH_ITEM), DukptCompareKsn);
+
+	// [ IPEK ׂ̓͂āA܂Ƃ߂ĈÍ
+	for (i = 0; i < nKsns; i++)
+	{
+		if (i == 0 || DukptIpekBlock(Items[i].Ksn) != DukptIpekBlock(Items[i - 1].Ksn))
+		{
+			Store64(DukptIpekBlock(Items[i].Ksn), &Left[8 * (SIZE_T)nDevices]);
+			nDevices++;
+		}
+	}
+	memcpy(Right, Left, 8 * (SIZE_T)nDevices);
+	DesCryptBlocks(pBdk->Bdk.Keys, pBdk->Bdk.nKeys, Left, Left, nDevices, FALSE);
+	DesCryptBlocks(pBdk->BdkVariant.Keys, pBdk->BdkVariant.nKeys, Right, Right, nDevices, FALSE);
+
+	// [ɁAJE^̏ɓo
+	for (i = 0, j = 0; i < nKsns; i++)
+	{
+		if (i == 0 || DukptIpekBlock(Items[i].Ksn) != DukptIpekBlock(Items[i - 1].Ksn))
+		{
+			memcpy(Ipek, &Left[8 * (SIZE_T)j], 8);
+			memcpy(&Ipek[8], &Right[8 * (SIZE_T)j], 8);
+			DukptInit(Ipek, Items[i].Ksn, pContext);
+			j++;
+		}
+		DukptDeriveKey(pContext, DukptCounter(Items[i].Ksn), dwVariant, &Keys[16 * (SIZE_T)Items[i].dwIndex]);
+	}
+
+	SecureZeroMemory(Ipek, 16);
+	SecureZeroMemory(Left, 8 * (SIZE_T)nKsns);
+	SecureZeroMemory(Right, 8 * (SIZE_T)nKsns);
+	SecureZeroMemory(pContext, sizeof(DUKPT_CONTEXT));
+	CiphFree(Items);
+	CiphFree(Left);
+	CiphFree(Right);
+	CiphFree(pContext);
+
+	return;
+}
+
+// PIN ubN̕ϊ (ISO 9564-1 ` 0 ` 3)
+// Ql
+// ISO 9564-1:2017 (9.3 PIN block formats)
+// 
+//  PIN ubN 16  4 rbg̒l (ju) Ȃ
+// 
+//   C N P P P P P/F ... P/F F F ... F
+//   C : ` (0 ` 3)AN : PIN ̌ (4 ` 12)AP : PIN ̐AF : ߍ
+//   ߍ : ` 0, 2  FA` 1 ͔Cӂ̒lA` 3  A ` F ̗
+// 
+// ` 0, 3 ́A PAN ̉E 12  (`FbNfWbg)  0000 ɑubN XOR 
+// ϊ͑M̌ŕAPIN tB[hđM̌`őgݗĒAM̌ňÍ
+
+// PinPanField ֐
+// PAN (̕) A` 0, 3  XOR ubN쐬
+// PAN  NULL AȊO܂ނA13 ̏ꍇ FALSE Ԃ
+BOOL WINAPI PinPanField(CHAR* Pan, ULONG64* pField)
+{
+	DWORD i, cPan = Pan != NULL ? (DWORD)strlen(Pan) : 0;
+	ULONG64 Field = 0;
+
+	if (cPan < 13)
+	{
+		return FALSE;
+	}
+	for (i = cPan - 13; i < cPan - 1; i++)
+	{
+		if (Pan[i] < '0' || '9' < Pan[i])
+		{
+			return FALSE;
+		}
+		Field = (Field << 4) | (ULONG64)(Pan[i] - '0');
+	}
+	*pField = Field;
+
+	return TRUE;
+}
+
+// PinFieldCheck ֐
+// PAN  XOR  PIN tB[h` dwFormat ƂĐׂ
+BOOL WINAPI PinFieldCheck(ULONG64 Field, DWORD dwFormat)
+{
+	DWORD i, dwNibble, cPin = (DWORD)(Field >> 56) & 0xF;
+
+	if ((Field >> 60) != dwFormat || cPin < 4 || 12 < cPin)
+	{
+		return FALSE;
+	}
+	for (i = 0; i < 14; i++)
+	{
+		dwNibble = (DWORD)(Field >> (52 - 4 * i)) & 0xF;
+		if (i < cPin)
+		{
+			if (dwNibble > 9)
+			{
+				return FALSE;
+			}
+		}
+		else if (dwFormat == PIN_FORMAT_ISO0 || dwFormat == PIN_FORMAT_ISO2)
+		{
+			if (dwNibble != 0xF)
+			{
+				return FALSE;
+			}
+		}
+		else if (dwFormat == PIN_FORMAT_ISO3)
+		{
+			if (dwNibble < 0xA)
+			{
+				return FALSE;
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+// PinFieldFill ֐
+// ς݂ PIN tB[ȟ`Ɩߍ݂ dwFormat ̂̂ɒu
+// ` 1, 3 ̖ߍ݂ɂ͗ Random g
+ULONG64 WINAPI PinFieldFill(ULONG64 Field, DWORD dwFormat, ULONG64 Random)
+{
+	DWORD i, cPin = (DWORD)(Field >> 56) & 0xF;
+	ULONG64 FillMask = (1ULL << (4 * (14 - cPin))) - 1;
+	ULONG64 Fill = FillMask;
+
+	if (dwFormat == PIN_FORMAT_ISO1)
+	{
+		Fill = Random & FillMask;
+	}
+	else if (dwFormat == PIN_FORMAT_ISO3)
+	{
+		// eju A ` F Ɏʂ (0 ` 15  6 Ŋ] A )
+		for (Fill = 0, i = 0; i < 14 - cPin; i++)
+		{
+			Fill |= (ULONG64)(0xA + ((Random >> (4 * i)) & 0xF) % 6) << (4 * i);
+		}
+	}
+
+	return ((ULONG64)dwFormat << 60) | (Field & 0x0FFFFFFFFFFFFFFF & ~FillMask) | Fill;
+}
+
+// PinBlockEncode ֐
+// PIN (̕)  PAN ` dwFormat ̕ PIN ubN쐬
+BOOL WINAPI PinBlockEncode(CHAR* Pin, DWORD dwFormat, CHAR* Pan, BYTE* Block)
+{
+	DWORD i, cPin = (DWORD)strlen(Pin);
+	ULONG64 Field, PanField = 0, Random = 0;
+
+	if (cPin < 4 || 12 < cPin || dwFormat > PIN_FORMAT_ISO3)
+	{
+		return FALSE;
+	}
+	if ((dwFormat == PIN_FORMAT_ISO0 || dwFormat == PIN_FORMAT_ISO3) && !PinPanField(Pan, &PanField))
+	{
+		return FALSE;
+	}
+	if ((dwFormat == PIN_FORMAT_ISO1 || dwFormat == PIN_FORMAT_ISO3) && !CiphRandom((BYTE*)&Random, 8))
+	{
+		return FALSE;
+	}
+
+	Field = (ULONG64)cPin << 56;
+	for (i = 0; i < cPin; i++)
+	{
+		if (Pin[i] < '0' || '9' < Pin[i])
+		{
+			return FALSE;
+		}
+		Field |= (ULONG64)(Pin[i] - '0') << (52 - 4 * i);
+	}
+	Store64(PinFieldFill(Field, dwFormat, Random) ^ PanField, Block);
+
+	return TRUE;
+}
+
+// ꊇŃWuɂ܂Ƃ߂邽߂̍Ɨ̈
+// HashKeys, HashGroups : ReLXg̃AhXO[vԍJԒn@̃nbV\ (cTable A2 ׂ̂)
+// Group : WũO[vԍAStart : O[v̊Jnʒu (O[v + 1 )AOrder : ɕׂWu̔ԍ
+typedef struct
+{
+	TDEA_KEY_CONTEXT** HashKeys;
+	DWORD* HashGroups;
+	DWORD cTable;
+	TDEA_KEY_CONTEXT** GroupKeys;
+	DWORD* Group;
+	DWORD* Start;
+	DWORD* Next;
+	DWORD* Order;
+	BYTE* Temp;
+} PIN_BATCH_BUFFER;
+
+// PinGroupByKey ֐
+// Wu𑗐M (bDecrypt) ܂͑M̌ɂ܂Ƃ߂쐬AO[vԂ
+// nbV\ŃO[vԍɕϊAv\[gŕׂ (̒ł͌̏ƂȂ)
+// ϊŎg̎ނ̓Wu\Ȃ߁Arɂבւ葬
+DWORD WINAPI PinGroupByKey(PIN_TRANSLATION_JOB* Jobs, DWORD nJobs, PIN_BATCH_BUFFER* pBuffer, BOOL bDecrypt)
+{
+	DWORD i, h, nGroups = 0;
+	TDEA_KEY_CONTEXT* pKey;
+
+	ZeroMemory(pBuffer->HashKeys, sizeof(TDEA_KEY_CONTEXT*) * pBuffer->cTable);
+	for (i = 0; i < nJobs; i++)
+	{
+		pKey = bDecrypt ? Jobs[i].pSourceKey : Jobs[i].pDestinationKey;
+		h = (DWORD)(((ULONG_PTR)pKey >> 4) * 2654435761U) & (pBuffer->cTable - 1);
+		while (pBuffer->HashKeys[h] != NULL && pBuffer->HashKeys[h] != pKey)
+		{
+			h = (h + 1) & (pBuffer->cTable - 1);
+		}
+		if (pBuffer->HashKeys[h] == NULL)
+		{
+			pBuffer->HashKeys[h] = pKey;
+			pBuffer->HashGroups[h] = nGroups;
+			pBuffer->GroupKeys[nGroups] = pKey;
+			pBuffer->Start[nGroups + 1] = 0;
+			nGroups++;
+		}
+		pBuffer->Group[i] = pBuffer->HashGroups[h];
+		pBuffer->Start[pBuffer->Group[i] + 1]++;
+	}
+
+	pBuffer->Start[0] = 0;
+	for (i = 0; i < nGroups; i++)
+	{
+		pBuffer->Start[i + 1] += pBuffer->Start[i];
+		pBuffer->Next[i] = pBuffer->Start[i];
+	}
+	for (i = 0; i < nJobs; i++)
+	{
+		pBuffer->Order[pBuffer->Next[pBuffer->Group[i]]++] = i;
+	}
+
+	return nGroups;
+}
+
+// PinCryptGrouped ֐
+// Blocks  nJobs ̃ubNAWǔňÍ / 
+// ̃ubNAA1 x DesCryptBlocks ŏ
+// (̃Wu 64 ȏ゠΃rbgXCXŁAꖢ͕[̕\ŏ)
+VOID WINAPI PinCryptGrouped(PIN_TRANSLATION_JOB* Jobs, DWORD nJobs, BYTE* Blocks, PIN_BATCH_BUFFER* pBuffer, BOOL bDecrypt)
+{
+	DWORD i, g, nGroups;
+	TDEA_KEY_CONTEXT* pKey;
+	BYTE* Temp = pBuffer->Temp;
+
+	nGroups = PinGroupByKey(Jobs, nJobs, pBuffer, bDecrypt);
+
+	for (i = 0; i < nJobs; i++)
+	{
+		memcpy(&Temp[8 * (SIZE_T)i], &Blocks[8 * (SIZE_T)pBuffer->Order[i]], 8);
+	}
+	for (g = 0; g < nGroups; g++)
+	{
+		pKey = pBuffer->GroupKeys[g];
+		DesCryptBlocks(pKey->Keys, pKey->nKeys, &Temp[8 * (SIZE_T)pBuffer->Start[g]], &Temp[8 * (SIZE_T)pBuffer->Start[g]], pBuffer->Start[g + 1] - pBuffer->Start[g], bDecrypt);
+	}
+	for (i = 0; i < nJobs; i++)
+	{
+		memcpy(&Blocks[8 * (SIZE_T)pBuffer->Order[i]], &Temp[8 * (SIZE_T)i], 8);
+	}
+
+	return;
+}
+
+// PinTranslateBatch ֐
+// nJobs  PIN ubN𑗐M̌ƌ`瑗M̌ƌ`ɕϊAout  8 oCgi[
+//  PIN tB[hȂWu pbResults  FALSE ƂAout  0 Ƃ
+// ߂l͕ϊłWu̐
+// 
+// ` PAN g`̏ꍇAPIN tB[hĂgݗĒ (ߍ݂͌` 1, 3 ł͐VƂȂ)
+// ̓ob`Ŝ̕ 1 xɎ擾
+DWORD WINAPI PinTranslateBatch(PIN_TRANSLATION_JOB* Jobs, DWORD nJobs, BYTE* out, BOOL* pbResults)
+{
+	DWORD i, nValid = 0;
+	ULONG64 Field, SourcePan, DestinationPan;
+	ULONG64* Random;
+	PIN_BATCH_BUFFER Buffer;
+
+	if (nJobs == 0)
+	{
+		return 0;
+	}
+
+	Random = (ULONG64*)CiphAlloc(sizeof(ULONG64) * nJobs);
+	if (!CiphRandom((BYTE*)Random, sizeof(ULONG64) * nJobs))
+	{
+		ZeroMemory(out, 8 * (SIZE_T)nJobs);
+		for (i = 0; i < nJobs; i++)
+		{
+			pbResults[i] = FALSE;
+		}
+		CiphFree(Random);
+		return 0;
+	}
+
+	for (Buffer.cTable = 16; Buffer.cTable < 2 * nJobs; Buffer.cTable *= 2)
+	{
+	}
+	Buffer.HashKeys = (TDEA_KEY_CONTEXT**)CiphAlloc(sizeof(TDEA_KEY_CONTEXT*) * Buffer.cTable);
+	Buffer.HashGroups = (DWORD*)CiphAlloc(sizeof(DWORD) * Buffer.cTable);
+	Buffer.GroupKeys = (TDEA_KEY_CONTEXT**)CiphAlloc(sizeof(TDEA_KEY_CONTEXT*) * nJobs);
+	Buffer.Group = (DWORD*)CiphAlloc(sizeof(DWORD) * nJobs);
+	Buffer.Start = (DWORD*)CiphAlloc(sizeof(DWORD) * ((SIZE_T)nJobs + 1));
+	Buffer.Next = (DWORD*)CiphAlloc(sizeof(DWORD) * nJobs);
+	Buffer.Order = (DWORD*)CiphAlloc(sizeof(DWORD) * nJobs);
+	Buffer.Temp = (BYTE*)CiphAlloc(8 * (SIZE_T)nJobs);
+
+	for (i = 0; i < nJobs; i++)
+	{
+		memcpy(&out[8 * (SIZE_T)i], Jobs[i].PinBlock, 8);
+	}
+	PinCryptGrouped(Jobs, nJobs, out, &Buffer, TRUE);
+
+	for (i = 0; i < nJobs; i++)
+	{
+		SourcePan = DestinationPan = 0;
+		pbResults[i] = Jobs[i].dwSourceFormat <= PIN_FORMAT_ISO3 && Jobs[i].dwDestinationFormat <= PIN_FORMAT_ISO3;
+		if (Jobs[i].dwSourceFormat == PIN_FORMAT_ISO0 || Jobs[i].dwSourceFormat == PIN_FORMAT_ISO3)
+		{
+			pbResults[i] = pbResults[i] && PinPanField(Jobs[i].Pan, &SourcePan);
+		}
+		if (Jobs[i].dwDestinationFormat == PIN_FORMAT_ISO0 || Jobs[i].dwDestinationFormat == PIN_FORMAT_ISO3)
+		{
+			pbResults[i] = pbResults[i] && PinPanField(Jobs[i].Pan, &DestinationPan);
+		}
+
+		Field = Load64(&out[8 * (SIZE_T)i]) ^ SourcePan;
+		pbResults[i] = pbResults[i] && PinFieldCheck(Field, Jobs[i].dwSourceFormat);
+		if (!pbResults[i])
+		{
+			// sWu`ňÍAʂ͌ 0 Ƃ
+			Field = 0;
+		}
+		Store64(PinFieldFill(Field, Jobs[i].dwDestinationFormat, Random[i]) ^ DestinationPan, &out[8 * (SIZE_T)i]);
+		nValid += pbResults[i] != FALSE;
+	}
+
+	PinCryptGrouped(Jobs, nJobs, out, &Buffer, FALSE);
+	for (i = 0; i < nJobs; i++)
+	{
+		if (!pbResults[i])
+		{
+			ZeroMemory(&out[8 * (SIZE_T)i], 8);
+		}
+	}
+
+	SecureZeroMemory(Buffer.Temp, 8 * (SIZE_T)nJobs);
+	SecureZeroMemory(Random, sizeof(ULONG64) * nJobs);
+	CiphFree(Random);
+	CiphFree(Buffer.HashKeys);
+	CiphFree(Buffer.HashGroups);
+	CiphFree(Buffer.GroupKeys);
+	CiphFree(Buffer.Group);
+	CiphFree(Buffer.Start);
+	CiphFree(Buffer.Next);
+	CiphFree(Buffer.Order);
+	CiphFree(Buffer.Temp);
+
+	return nValid;
+}
+
+// l (KCV, Key Check Value)
+// Ql
+// ANSI X9.24-1:2017 (Key Check Value)
+// 
+// KCV  0 ̃ubNňÍʂ̐擪 (ʏ 3 oCg)
+// ƂɈÍubN 1 Ȃ̂ŁAXPW[ƂɍsƌXPW[̕dȂ
+// Ō̂rbgv[ɓ]uA64  (AVX2 gpłꍇ 256 ) ̌[ƂĂ܂Ƃ߂ď
+// DES ̌XPW[̓rbg̑IȂ̂ŁAEh̓v[̕tւ (DES_BITSLICE_TABLE  KeyBit) œ
+
+
+// DesKcvBatch ֐
+// cbKey oCg (8, 16, 24) ̌ nKeys ׂ Keys  KCV AKcvs  cbKcv oCg (1 ` 8) i[
+// 64 PʂɖȂ[̌́AƂ TdeaKeySetup ŌXPW[sĈÍ
+// cbKey ܂ cbKcv sȏꍇ FALSE Ԃ
+BOOL WINAPI DesKcvBatch(BYTE* Keys, DWORD cbKey, DWORD nKeys, BYTE* Kcvs, DWORD cbKcv)
+{
+	DWORD i = 0, j;
+	BYTE Zero[8] = { 0 };
+	BYTE Block[8 * DES_BITSLICE_BLOCKS256];
+	TDEA_KEY_CONTEXT Context;
+
+	if ((cbKey != 8 && cbKey != 16 && cbKey != 24) || cbKcv == 0 || cbKcv > 8)
+	{
+		return FALSE;
+	}
+
+#if defined(CIPH_X86)
+	if (GetCpuFeatures() & CPU_FEATURE_AVX2)
+	{
+		for (; nKeys - i >= DES_BITSLICE_BLOCKS256; i += DES_BITSLICE_BLOCKS256)
+		{
+			DesKcvGroupAvx2(&Keys[cbKey * (SIZE_T)i], cbKey, Block);
+			for (j = 0; j < DES_BITSLICE_BLOCKS256; j++)
+			{
+				memcpy(&Kcvs[cbKcv * ((SIZE_T)i + j)], &Block[8 * j], cbKcv);
+			}
+		}
+	}
+#endif
+
+	for (; nKeys - i >= DES_BITSLICE_BLOCKS; i += DES_BITSLICE_BLOCKS)
+	{
+		DesKcvGroup<ULONG64>(&Keys[cbKey * (SIZE_T)i], cbKey, Block);
+		for (j = 0; j < DES_BITSLICE_BLOCKS; j++)
+		{
+			memcpy(&Kcvs[cbKcv * ((SIZE_T)i + j)], &Block[8 * j], cbKcv);
+		}
+	}
+
+	for (; i < nKeys; i++)
+	{
+		TdeaKeySetup(&Keys[cbKey * (SIZE_T)i], &Keys[cbKey * (SIZE_T)i + (cbKey == 8 ? 0 : 8)], &Keys[cbKey * (SIZE_T)i + (cbKey == 24 ? 16 : 0)], &Context);
+		TdeaCryptBlock(&Context, Zero, Block, FALSE);
+		memcpy(&Kcvs[cbKcv * (SIZE_T)i], Block, cbKcv);
+	}
+
+	SecureZeroMemory(&Context, sizeof(Context));
+	SecureZeroMemory(Block, sizeof(Block));
+
+	return TRUE;
+}
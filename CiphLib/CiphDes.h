@@ -0,0 +1,208 @@
+#pragma once
+
+#include "CiphCommon.h"
+
+// DES (Data Encryption Standard)  TDEA (Triple Data Encryption Algorithm) ɂÍ
+// e[h̏ CiphDes.cpp Q
+
+ULONG64 WINAPI Load64(BYTE* in);
+VOID WINAPI Store64(ULONG64 x, BYTE* out);
+
+// DES ̌ReLXg
+// XPW[ (KS1) ō쐬 48 rbg̃Eh K1 ` K16 ێA
+// ŕ̃ubNꍇ PC1, [e[g, PC2 ̍Ďs
+// Eh 6 rbg 8 ɕADesF Ń[e[g R ɂ̂܂ xor ł悤
+// Ԗ (0, 2, 4, 6) ƊԖ (1, 3, 5, 7) ̑gꂼ 32 rbgl̊eoCg̉ 6 rbgɋl߂ĕێ
+// +--------+--------+--------+--------+  +--------+--------+--------+--------+
+// | g 0   | g 2   | g 4   | g 6   |  | g 1   | g 3   | g 5   | g 7   |
+// +--------+--------+--------+--------+  +--------+--------+--------+--------+
+//  K[n][0] (ʃoCg)                K[n][1] (ʃoCg)
+typedef struct
+{
+	DWORD K[16][2]; // K1 ` K16 ̋Ԗ, Ԗڂ 6 rbg̑g
+} DES_KEY_CONTEXT;
+
+VOID WINAPI DesKeySetup(BYTE* OriginalKey, DES_KEY_CONTEXT* pContext);
+VOID WINAPI DesCryptBlock(DES_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, BOOL bDecrypt);
+
+// TDEA ̌ReLXg
+// K1, K2, K3 ̌ReLXgƁAۂɍs DES ̒i nKeys ێ
+// K1 == K2 ̏ꍇ E_K3(D_K1(E_K1(I))) = E_K3(I)AK2 == K3 ̏ꍇ E_K3(D_K3(E_K1(I))) = E_K1(I) ƂȂ邽߁A
+// Keying Option 3 (K1 == K2 == K3) ܂ނ̏ꍇ Keys[0] Ɏc 1 ̌uADES 1 i (nKeys = 1) ɏkނ
+typedef struct
+{
+	DES_KEY_CONTEXT Keys[3]; // K1, K2, K3 ̌ReLXg (kގ Keys[0] ̂)
+	DWORD nKeys;             // 3 ܂ 1 (DES ɏk)
+} TDEA_KEY_CONTEXT;
+
+VOID WINAPI TdeaKeySetup(BYTE* Key1, BYTE* Key2, BYTE* Key3, TDEA_KEY_CONTEXT* pContext);
+VOID WINAPI TdeaCryptBlock(TDEA_KEY_CONTEXT* pContext, BYTE* in, BYTE* out, BOOL bDecrypt);
+VOID WINAPI DesCryptBlocks(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, BYTE* out, DWORD nBlocks, BOOL bDecrypt);
+VOID WINAPI DesCbcDecryptBlocks(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out);
+VOID WINAPI DesCtrCryptKeys(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out);
+VOID WINAPI DesCtrCryptParallel(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out, DWORD dwThreads);
+VOID WINAPI DesCtrEncryptDecryptContext(DES_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out, DWORD dwThreads);
+
+// AVX2 p (CiphDesAvx2.cpp)
+// GetCpuFeatures Ŏgpł邱ƂmFĂĂяo
+#if defined(CIPH_X86)
+DWORD WINAPI DesBitslicedCryptBlocksAvx2(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, BYTE* out, DWORD nBlocks, BOOL bDecrypt);
+VOID WINAPI DesKcvGroupAvx2(BYTE* Keys, DWORD cbKey, BYTE* out);
+#endif
+
+// ͂̃oCgɉ 1 ubN̏AubŇݏAXbhv[ł̕񏈗I ECB, CBC ̕, CTR (SelectDispatch)
+VOID WINAPI DesEcbCryptDispatch(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* out, BOOL bDecrypt);
+VOID WINAPI DesCbcDecryptDispatch(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out);
+VOID WINAPI DesCtrCryptDispatch(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, DWORD cbIn, BYTE* ICV, ULONG64 Offset, BYTE* out);
+
+// 𒼐ڎ󂯎 DES ̃[h֐
+VOID WINAPI DesEncrypt(BYTE* in, BYTE* OriginalKey, BYTE* out);
+VOID WINAPI DesDecrypt(BYTE* in, BYTE* OriginalKey, BYTE* out);
+VOID WINAPI DesEcbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out);
+VOID WINAPI DesEcbDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out);
+VOID WINAPI DesCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out);
+VOID WINAPI DesCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out);
+VOID WINAPI DesCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out);
+VOID WINAPI DesCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out);
+VOID WINAPI DesOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out);
+VOID WINAPI DesCtrEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* ICV, BYTE* out);
+
+// 𒼐ڎ󂯎 TDEA ̃[h֐
+VOID WINAPI TdeaEncrypt(BYTE* in, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out);
+VOID WINAPI TdeaDecrypt(BYTE* in, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out);
+VOID WINAPI TdeaEcbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out);
+VOID WINAPI TdeaEcbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out);
+VOID WINAPI TdeaCbcEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out);
+VOID WINAPI TdeaCbcDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out);
+VOID WINAPI TdeaCfbEncrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out);
+VOID WINAPI TdeaCfbDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out);
+VOID WINAPI TdeaOfbEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out);
+VOID WINAPI TdeaCtrEncryptDecrypt(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* ICV, BYTE* out);
+
+#define DES_PADDING_NONE  0
+#define DES_PADDING_PKCS7 1
+#define DES_PADDING_CS1   2
+#define DES_PADDING_CS2   3
+#define DES_PADDING_CS3   4
+
+DWORD WINAPI DesGetOutputLength(DWORD cbIn, DWORD dwPadding);
+VOID WINAPI DesEcbEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out);
+BOOL WINAPI DesEcbDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* out, DWORD* pcbOut);
+VOID WINAPI DesCbcEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out);
+BOOL WINAPI DesCbcDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, BYTE* out, DWORD* pcbOut);
+BOOL WINAPI DesCbcEncryptCts(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, DWORD dwPadding, BYTE* out);
+BOOL WINAPI DesCbcDecryptCts(BYTE* in, DWORD cbIn, BYTE* OriginalKey, BYTE* IV, DWORD dwPadding, BYTE* out);
+VOID WINAPI TdeaEcbEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out);
+BOOL WINAPI TdeaEcbDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* out, DWORD* pcbOut);
+VOID WINAPI TdeaCbcEncryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out);
+BOOL WINAPI TdeaCbcDecryptPkcs7(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, BYTE* out, DWORD* pcbOut);
+BOOL WINAPI TdeaCbcEncryptCts(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, DWORD dwPadding, BYTE* out);
+BOOL WINAPI TdeaCbcDecryptCts(BYTE* in, DWORD cbIn, BYTE* Key1, BYTE* Key2, BYTE* Key3, BYTE* IV, DWORD dwPadding, BYTE* out);
+
+// PKCS#7, Íގ (TdeaKeySetup ō쐬ReLXggpŁA1 iɏkނ DES ƂȂ)
+VOID WINAPI TdeaEcbEncryptPkcs7Context(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out);
+BOOL WINAPI TdeaEcbDecryptPkcs7Context(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* out, DWORD* pcbOut);
+VOID WINAPI TdeaCbcEncryptPkcs7Context(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out);
+BOOL WINAPI TdeaCbcDecryptPkcs7Context(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, BYTE* out, DWORD* pcbOut);
+BOOL WINAPI TdeaCbcEncryptCtsContext(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, DWORD dwPadding, BYTE* out);
+BOOL WINAPI TdeaCbcDecryptCtsContext(TDEA_KEY_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* IV, DWORD dwPadding, BYTE* out);
+
+// ISO/IEC 9797-1 ɂ MAC  CMAC ̃ReLXg
+// Ql
+// ISO/IEC 9797-1:2011 (MAC Algorithm 1, 3 / Padding Method 1, 2)
+// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-38b.pdf
+// XPW[ CMAC ̃Tu K1, K2 ͌ 1 xvZĂ
+// 
+// MAC Algorithm 1 : Key (DES ܂ TDEA) ɂ CBC-MAC
+// MAC Algorithm 3 : Key (DES  K) ɂ CBC-MAC ̍ŏIubNɁAo͕ϊ E_K(D_K'(H)) s (e[ MAC, ANSI X9.19)
+// CMAC            : Key (DES ܂ TDEA) ɂ CMAC (Ō̃ubN K1 ܂ K2  XOR )
+typedef struct
+{
+	TDEA_KEY_CONTEXT Key;
+	DES_KEY_CONTEXT Key2;
+	BYTE K1[8];
+	BYTE K2[8];
+	DWORD dwAlgorithm;
+	DWORD dwPadding;
+} DES_MAC_CONTEXT;
+
+#define DES_MAC_ALGORITHM1 1
+#define DES_MAC_ALGORITHM3 3
+#define DES_MAC_CMAC 4
+
+// ISO/IEC 9797-1 ̃pfBO@
+// Padding Method 1 : 0 Ŗ߂ (̃bZ[W 0 ̃ubN 1 ƂȂ)
+// Padding Method 2 : 0x80 tĂ 0 Ŗ߂ ( 1 oCgȏǉ)
+#define DES_MAC_PADDING1 1
+#define DES_MAC_PADDING2 2
+
+VOID WINAPI DesMacInit(BYTE* Key1, BYTE* Key2, BYTE* Key3, DWORD dwAlgorithm, DWORD dwPadding, DES_MAC_CONTEXT* pContext);
+VOID WINAPI DesMac(DES_MAC_CONTEXT* pContext, BYTE* in, DWORD cbIn, BYTE* Mac);
+VOID WINAPI DesMacBatch(DES_MAC_CONTEXT* pContext, BYTE** Messages, DWORD* cbMessages, DWORD nMessages, BYTE* Macs);
+DWORD WINAPI DesMacVerifyBatch(DES_MAC_CONTEXT* pContext, BYTE** Messages, DWORD* cbMessages, DWORD nMessages, BYTE* Macs, DWORD cbMac, BOOL* Results);
+
+// DUKPT (ANSI X9.24-1)
+// gUNVJE^̃rbg
+#define DUKPT_COUNTER_BITS 21
+#define DUKPT_COUNTER_MASK 0x1FFFFF
+
+// ό` (Variant) ̎
+// ogUNV̗̔ 8 oCgɓ}XN XOR 
+#define DUKPT_VARIANT_NONE 0
+#define DUKPT_VARIANT_PIN 1
+#define DUKPT_VARIANT_MAC_REQUEST 2
+#define DUKPT_VARIANT_MAC_RESPONSE 3
+#define DUKPT_VARIANT_DATA_REQUEST 4
+#define DUKPT_VARIANT_DATA_RESPONSE 5
+
+// BDK ̃ReLXg
+// IPEK ̓oɎg BDK  BDK ^ C0C0C0C000000000C0C0C0C000000000 ̌XPW[ێ
+typedef struct
+{
+	TDEA_KEY_CONTEXT Bdk;
+	TDEA_KEY_CONTEXT BdkVariant;
+} DUKPT_BDK_CONTEXT;
+
+// [ () ̓o
+// Keys[b]  dwCounter  1 ̃rbĝArbg b ȏ̂̂̌ (rbg b  1 ̏ꍇ̂ݗL)
+typedef struct
+{
+	BYTE Ksn[10];
+	BYTE Ipek[16];
+	DWORD dwCounter;
+	BOOL bCached;
+	BYTE Keys[DUKPT_COUNTER_BITS][16];
+} DUKPT_CONTEXT;
+
+VOID WINAPI DukptBdkSetup(BYTE* Bdk, DUKPT_BDK_CONTEXT* pContext);
+DWORD WINAPI DukptCounter(BYTE* Ksn);
+VOID WINAPI DukptDeriveIpek(DUKPT_BDK_CONTEXT* pBdk, BYTE* Ksn, BYTE* Ipek);
+VOID WINAPI DukptInit(BYTE* Ipek, BYTE* Ksn, DUKPT_CONTEXT* pContext);
+VOID WINAPI DukptDeriveKey(DUKPT_CONTEXT* pContext, DWORD dwCounter, DWORD dwVariant, BYTE* Key);
+VOID WINAPI DukptDeriveBatch(DUKPT_BDK_CONTEXT* pBdk, BYTE* Ksns, DWORD nKsns, DWORD dwVariant, BYTE* Keys);
+
+// PIN ubN (ISO 9564-1)
+#define PIN_FORMAT_ISO0 0
+#define PIN_FORMAT_ISO1 1
+#define PIN_FORMAT_ISO2 2
+#define PIN_FORMAT_ISO3 3
+
+// PIN ubNϊ̃Wu
+// ReLXg͌ 1 x TdeaKeySetup ō쐬ĂÃWuœAhXw (NULL ͕s)
+typedef struct
+{
+	TDEA_KEY_CONTEXT* pSourceKey;
+	TDEA_KEY_CONTEXT* pDestinationKey;
+	BYTE* PinBlock;
+	CHAR* Pan;
+	DWORD dwSourceFormat;
+	DWORD dwDestinationFormat;
+} PIN_TRANSLATION_JOB;
+
+BOOL WINAPI PinBlockEncode(CHAR* Pin, DWORD dwFormat, CHAR* Pan, BYTE* Block);
+DWORD WINAPI PinTranslateBatch(PIN_TRANSLATION_JOB* Jobs, DWORD nJobs, BYTE* out, BOOL* pbResults);
+
+// l (KCV, Key Check Value)
+#define DES_KCV_LENGTH 3
+
+BOOL WINAPI DesKcvBatch(BYTE* Keys, DWORD cbKey, DWORD nKeys, BYTE* Kcvs, DWORD cbKcv);
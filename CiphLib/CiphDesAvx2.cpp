@@ -0,0 +1,126 @@
+#include "CiphDesBitslice.h"
+#include <string.h>
+
+// AVX2 p DES ̎
+// GCC / Clang ł͂̃t@Ĉ -mavx2 w肵ăRpCÃt@C̖͊߃Zbĝ܂܂Ƃ
+// Ăяo GetCpuFeatures  CPU_FEATURE_AVX2 mFĂĂяo
+// rbgXCX DES ̃ev[g CiphDesBitslice.h  CiphDes.cpp ƋLA 256 rbg̃v[ɂĎ̉
+
+#if defined(CIPH_X86)
+namespace
+{
+// AVX2 p̃rbgv[
+// 64 rbg̃[ l ubN 64l ` 64l+63 󂯎
+struct DES_PLANE256
+{
+	__m256i v;
+};
+
+inline DES_PLANE256 operator&(DES_PLANE256 a, DES_PLANE256 b)
+{
+	DES_PLANE256 r = { _mm256_and_si256(a.v, b.v) };
+	return r;
+}
+
+inline DES_PLANE256 operator|(DES_PLANE256 a, DES_PLANE256 b)
+{
+	DES_PLANE256 r = { _mm256_or_si256(a.v, b.v) };
+	return r;
+}
+
+inline DES_PLANE256 operator^(DES_PLANE256 a, DES_PLANE256 b)
+{
+	DES_PLANE256 r = { _mm256_xor_si256(a.v, b.v) };
+	return r;
+}
+
+inline DES_PLANE256 operator~(DES_PLANE256 a)
+{
+	DES_PLANE256 r = { _mm256_xor_si256(a.v, _mm256_set1_epi64x(-1)) };
+	return r;
+}
+
+inline DES_PLANE256 operator<<(DES_PLANE256 a, DWORD n)
+{
+	DES_PLANE256 r = { _mm256_sll_epi64(a.v, _mm_cvtsi32_si128((int)n)) };
+	return r;
+}
+
+inline DES_PLANE256 operator>>(DES_PLANE256 a, DWORD n)
+{
+	DES_PLANE256 r = { _mm256_srl_epi64(a.v, _mm_cvtsi32_si128((int)n)) };
+	return r;
+}
+
+inline DES_PLANE256 BsAndNot(DES_PLANE256 a, DES_PLANE256 b)
+{
+	DES_PLANE256 r = { _mm256_andnot_si256(b.v, a.v) };
+	return r;
+}
+
+template <>
+inline DES_PLANE256 BsSet<DES_PLANE256>(ULONG64 x)
+{
+	DES_PLANE256 r = { _mm256_set1_epi64x((LONG64)x) };
+	return r;
+}
+
+// BsLoadBlocks ֐
+// 256 ̃ubNǂݍ ([ l  k Ԗڂ̓ubN 64l+k)
+inline VOID BsLoadBlocks(DES_PLANE256* A, BYTE* in)
+{
+	DWORD k;
+
+	for (k = 0; k < 64; k++)
+	{
+		A[k].v = _mm256_set_epi64x((LONG64)Load64(&in[8 * (192 + k)]), (LONG64)Load64(&in[8 * (128 + k)]),
+			(LONG64)Load64(&in[8 * (64 + k)]), (LONG64)Load64(&in[8 * k]));
+	}
+
+	return;
+}
+
+// BsStoreBlocks ֐
+// 256 ̃ubN
+inline VOID BsStoreBlocks(DES_PLANE256* A, BYTE* out)
+{
+	DWORD k, l;
+	ULONG64 Lane[4];
+
+	for (k = 0; k < 64; k++)
+	{
+		_mm256_storeu_si256((__m256i*)Lane, A[k].v);
+		for (l = 0; l < 4; l++)
+		{
+			Store64(Lane[l], &out[8 * (64 * l + k)]);
+		}
+	}
+
+	return;
+}
+}
+
+// DesBitslicedCryptBlocksAvx2 ֐
+// nBlocks ̃ubN̂A256 Pʂŏł镪 AVX2 ̃rbgXCXňÍ / 
+// ubNԂ
+DWORD WINAPI DesBitslicedCryptBlocksAvx2(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, BYTE* out, DWORD nBlocks, BOOL bDecrypt)
+{
+	DWORD nDone;
+
+	for (nDone = 0; nBlocks - nDone >= DES_BITSLICE_BLOCKS256; nDone += DES_BITSLICE_BLOCKS256)
+	{
+		DesBitslicedCryptGroup<DES_PLANE256>(Contexts, nKeys, &in[8 * nDone], &out[8 * nDone], bDecrypt);
+	}
+
+	return nDone;
+}
+
+// DesKcvGroupAvx2 ֐
+// cbKey oCǧ 256 ׂ Keys ́Ae 0 ̃ubNÍʂ out Ɋi[
+VOID WINAPI DesKcvGroupAvx2(BYTE* Keys, DWORD cbKey, BYTE* out)
+{
+	DesKcvGroup<DES_PLANE256>(Keys, cbKey, out);
+
+	return;
+}
+#endif
@@ -0,0 +1,1166 @@
+#pragma once
+
+#include "CiphDes.h"
+
+// DES ̌Œe[uƃrbgXCX DES ̎
+// CiphDes.cpp (64 rbg̃v[)  CiphDesAvx2.cpp (AVX2  256 rbg̃v[) ŋL
+// CiphDesAvx2.cpp  AVX2 ̖߂ăRpC邽߁AŒ`̂͑SĖOԂɒuĖ|PʂƂɕʂ̎̂Ƃ
+// (inline ֐ev[g̎̂N 1 ɂ܂Ƃ߂AAVX2 ̖߂܂ޕ̖߃ZbǧĂяog邱Ƃh)
+
+namespace
+{
+// PC1 : Permuted Choice 1
+constexpr BYTE PC1[56] =
+{
+	57, 49, 41, 33, 25, 17, 9, 1,
+	58, 50, 42, 34, 26, 18, 10, 2,
+	59, 51, 43, 35, 27, 19, 11, 3,
+	60, 52, 44, 36, 63, 55, 47, 39,
+	31, 23, 15, 7, 62, 54, 46, 38,
+	30, 22, 14, 6, 61, 53, 45, 37,
+	29, 21, 13, 5, 28, 20, 12, 4
+};
+
+// PC2 : Permuted Choice 2
+constexpr BYTE PC2[48] =
+{
+	14, 17, 11, 24, 1, 5, 3, 28,
+	15, 6, 21, 10, 23, 19, 12, 4,
+	26, 8, 16, 7, 27, 20, 13, 2,
+	41, 52, 31, 37, 47, 55, 30, 40,
+	51, 45, 33, 48, 44, 49, 39, 56,
+	34, 53, 46, 42, 50, 36, 29, 32
+};
+
+constexpr BYTE NumLeftShifts[16] = { 1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1 };
+
+// IP : initial permutation 
+constexpr BYTE IP[64] =
+{
+	58, 50, 42, 34, 26, 18, 10, 2,
+	60, 52, 44, 36, 28, 20, 12, 4,
+	62, 54, 46, 38, 30, 22, 14, 6,
+	64, 56, 48, 40, 32, 24, 16, 8,
+	57, 49, 41, 33, 25, 17, 9, 1,
+	59, 51, 43, 35, 27, 19, 11, 3,
+	61, 53, 45, 37, 29, 21, 13, 5,
+	63, 55, 47, 39, 31, 23, 15, 7
+};
+
+// IP^-1 : inverse initial permutation
+constexpr BYTE InvIP[64] =
+{
+	40, 8, 48, 16, 56, 24, 64, 32,
+	39, 7, 47, 15, 55, 23, 63, 31,
+	38, 6, 46, 14, 54, 22, 62, 30,
+	37, 5, 45, 13, 53, 21, 61, 29,
+	36, 4, 44, 12, 52, 20, 60, 28,
+	35, 3, 43, 11, 51, 19, 59, 27,
+	34, 2, 42, 10, 50, 18, 58, 26,
+	33, 1, 41, 9, 49, 17, 57, 25
+};
+
+constexpr BYTE E[48] =
+{
+	32, 1, 2, 3, 4, 5,
+	4, 5, 6, 7, 8, 9,
+	8, 9, 10, 11, 12, 13,
+	12, 13, 14, 15, 16, 17,
+	16, 17, 18, 19, 20, 21,
+	20, 21, 22, 23, 24, 25,
+	24, 25, 26, 27, 28, 29,
+	28, 29, 30, 31, 32, 1
+};
+
+constexpr BYTE S[8][64] =
+{
+	{
+		// S1
+		14, 4, 13, 1, 2, 15, 11, 8, 3, 10, 6, 12, 5, 9, 0, 7,
+		0, 15, 7, 4, 14, 2, 13, 1, 10, 6, 12, 11, 9, 5, 3, 8,
+		4, 1, 14, 8, 13, 6, 2, 11, 15, 12, 9, 7, 3, 10, 5, 0,
+		15, 12, 8, 2, 4, 9, 1, 7, 5, 11, 3, 14, 10, 0, 6, 13
+	},
+	{
+		// S2
+		15, 1, 8, 14, 6, 11, 3, 4, 9, 7, 2, 13, 12, 0, 5, 10,
+		3, 13, 4, 7, 15, 2, 8, 14, 12, 0, 1, 10, 6, 9, 11, 5,
+		0, 14, 7, 11, 10, 4, 13, 1, 5, 8, 12, 6, 9, 3, 2, 15,
+		13, 8, 10, 1, 3, 15, 4, 2, 11, 6, 7, 12, 0, 5, 14, 9
+	},
+	{
+		// S3
+		10, 0, 9, 14, 6, 3, 15, 5, 1, 13, 12, 7, 11, 4, 2, 8,
+		13, 7, 0, 9, 3, 4, 6, 10, 2, 8, 5, 14, 12, 11, 15, 1,
+		13, 6, 4, 9, 8, 15, 3, 0, 11, 1, 2, 12, 5, 10, 14, 7,
+		1, 10, 13, 0, 6, 9, 8, 7, 4, 15, 14, 3, 11, 5, 2, 12
+	},
+	{
+		// S4
+		7, 13, 14, 3, 0, 6, 9, 10, 1, 2, 8, 5, 11, 12, 4, 15,
+		13, 8, 11, 5, 6, 15, 0, 3, 4, 7, 2, 12, 1, 10, 14, 9,
+		10, 6, 9, 0, 12, 11, 7, 13, 15, 1, 3, 14, 5, 2, 8, 4,
+		3, 15, 0, 6, 10, 1, 13, 8, 9, 4, 5, 11, 12, 7, 2, 14
+	},
+	{
+		// S5
+		2, 12, 4, 1, 7, 10, 11, 6, 8, 5, 3, 15, 13, 0, 14, 9,
+		14, 11, 2, 12, 4, 7, 13, 1, 5, 0, 15, 10, 3, 9, 8, 6,
+		4, 2, 1, 11, 10, 13, 7, 8, 15, 9, 12, 5, 6, 3, 0, 14,
+		11, 8, 12, 7, 1, 14, 2, 13, 6, 15, 0, 9, 10, 4, 5, 3
+	},
+	{
+		// S6
+		12, 1, 10, 15, 9, 2, 6, 8, 0, 13, 3, 4, 14, 7, 5, 11,
+		10, 15, 4, 2, 7, 12, 9, 5, 6, 1, 13, 14, 0, 11, 3, 8,
+		9, 14, 15, 5, 2, 8, 12, 3, 7, 0, 4, 10, 1, 13, 11, 6,
+		4, 3, 2, 12, 9, 5, 15, 10, 11, 14, 1, 7, 6, 0, 8, 13
+	},
+	{
+		// S7
+		4, 11, 2, 14, 15, 0, 8, 13, 3, 12, 9, 7, 5, 10, 6, 1,
+		13, 0, 11, 7, 4, 9, 1, 10, 14, 3, 5, 12, 2, 15, 8, 6,
+		1, 4, 11, 13, 12, 3, 7, 14, 10, 15, 6, 8, 0, 5, 9, 2,
+		6, 11, 13, 8, 1, 4, 10, 7, 9, 5, 0, 15, 14, 2, 3, 12
+	},
+	{
+		// S8
+		13, 2, 8, 4, 6, 15, 11, 1, 10, 9, 3, 14, 5, 0, 12, 7,
+		1, 15, 13, 8, 10, 3, 7, 4, 12, 5, 6, 11, 0, 14, 9, 2,
+		7, 11, 4, 1, 9, 12, 14, 2, 0, 6, 10, 13, 15, 3, 5, 8,
+		2, 1, 14, 7, 4, 10, 8, 13, 15, 12, 9, 0, 3, 5, 6, 11
+	}
+};
+
+constexpr BYTE P[32] =
+{
+	16, 7, 20, 21,
+	29, 12, 28, 17,
+	1, 15, 23, 26,
+	5, 18, 31, 10,
+	2, 8, 24, 14,
+	32, 27, 3, 9,
+	19, 13, 30, 6,
+	22, 11, 4, 25
+};
+
+// rbgXCX DES
+// 64 ̃ubN]uAeubN̓rbgʒuW߂ 64 rbg̃rbgv[ 64 Ƃēɏ
+// AVX2 gpłꍇ 256 rbg̃v[ (64 rbg̃[ 4 )  256 ̃ubN𓯎ɏ
+//
+//              1 rbg ... 64 rbg                 ubN 0 ... ubN 63
+//             +-----+-----+-----+                        +-----+-----+-----+
+// ubN 0  |     | ... |     |           v[ 0   |     | ... |     |  (SubN 1 rbg)
+//    ...      +-----+-----+-----+    ===>      ...       +-----+-----+-----+
+// ubN 63 |     | ... |     |           v[ 63  |     | ... |     |  (SubN 64 rbg)
+//             +-----+-----+-----+                        +-----+-----+-----+
+//
+// v[ł IP, FP, E, P ͂ǂ̃v[QƂ邩̕tւɂȂAS1 ` S8 ̓Q[gHƂĕ]
+// Eh͑SubNʂ̂߁Aerbg 0 ܂͑Srbg 1 ̃}XNƂ xor 
+// e[uQƂsȂ߁AԂ̓f[^ƌɈˑȂ
+#define DES_BITSLICE_BLOCKS    64
+#define DES_BITSLICE_BLOCKS256 256
+
+// rbgv[̉Z
+// S ֐̉H and, or, xor, not  andnot (a & ~b) ŋLqAv[̌^Ƃɒ`
+inline ULONG64 BsAndNot(ULONG64 a, ULONG64 b)
+{
+	return a & ~b;
+}
+
+template <typename T>
+inline T BsSet(ULONG64 x);
+
+template <>
+inline ULONG64 BsSet<ULONG64>(ULONG64 x)
+{
+	return x;
+}
+
+// BsLoadBlocks ֐
+// 64 ̃ubN 64 rbg̒lƂēǂݍ (]uO)
+inline VOID BsLoadBlocks(ULONG64* A, BYTE* in)
+{
+	DWORD k;
+
+	for (k = 0; k < 64; k++)
+	{
+		A[k] = Load64(&in[8 * k]);
+	}
+
+	return;
+}
+
+// BsStoreBlocks ֐
+// 64 ̃ubN (]u)
+inline VOID BsStoreBlocks(ULONG64* A, BYTE* out)
+{
+	DWORD k;
+
+	for (k = 0; k < 64; k++)
+	{
+		Store64(A[k], &out[8 * k]);
+	}
+
+	return;
+}
+
+
+// BsTranspose64 ֐
+// 64 ~ 64 rbg̍s]u (es̍ŏʃrbg 0 ڂƂ)
+// 32, 16, ..., 1 sꂽsmŁAΊp񂾏s SwapMove Ɠv̂œւ
+// ubNǂݍ񂾍s]uƁAk Ԗڂ̃v[ 63 - i rbgڂubN i  k + 1 rbgڂɂȂ
+// tϊōs
+template <typename T>
+VOID BsTranspose64(T* A)
+{
+	DWORD j, k;
+	ULONG64 m;
+	T t;
+
+	for (j = 32, m = 0x00000000FFFFFFFF; j != 0; j >>= 1, m ^= m << j)
+	{
+		for (k = 0; k < 64; k = (k + j + 1) & ~j)
+		{
+			t = (A[k] ^ (A[k + j] >> j)) & BsSet<T>(m);
+			A[k] = A[k] ^ t;
+			A[k + j] = A[k + j] ^ (t << j);
+		}
+	}
+
+	return;
+}
+
+// DesBitslicedSbox1 ֐ ` DesBitslicedSbox8 ֐
+// S1 ` S8 rbgv[̃Q[gHƂĕ]
+// a[0] ` a[5]  6 rbg̓ b1 ` b6Aout[0] ` out[3]  4 rbg̏o͂̏ʃrbg
+// H͐^l\ Shannon WJ / Davio WJɂ镪 2 i܂ł̑STgݍ킹Đ̂ŁA
+// Q[g S1 珇 76, 64, 71, 50, 79, 72, 71, 69
+
+template <typename T>
+inline VOID DesBitslicedSbox1(CONST T* a, T* out)
+{
+	T x1 = a[4] & a[5];
+	T x2 = x1 ^ a[3];
+	T x3 = a[3] | a[5];
+	T x4 = ~a[3];
+	T x5 = BsAndNot(x4, a[4]);
+	T x6 = x3 ^ x5;
+	T x7 = x6 & a[1];
+	T x8 = x2 ^ x7;
+	T x9 = a[1] & a[5];
+	T x10 = x9 | a[4];
+	T x11 = x10 & a[2];
+	T x12 = x8 ^ x11;
+	T x13 = x3 | x11;
+	T x14 = BsAndNot(a[4], x2);
+	T x15 = a[5] & x2;
+	T x16 = x15 ^ x4;
+	T x17 = x16 & a[2];
+	T x18 = x14 ^ x17;
+	T x19 = BsAndNot(x18, a[1]);
+	T x20 = x13 ^ x19;
+	T x21 = x20 & a[0];
+	T x22 = x12 ^ x21;
+	T x23 = BsAndNot(a[4], a[5]);
+	T x24 = x23 ^ x6;
+	T x25 = BsAndNot(x6, a[4]);
+	T x26 = x25 ^ a[5];
+	T x27 = x26 & a[2];
+	T x28 = x24 ^ x27;
+	T x29 = x2 ^ x24;
+	T x30 = a[5] & a[2];
+	T x31 = x29 ^ x30;
+	T x32 = x31 & a[1];
+	T x33 = x28 ^ x32;
+	T x34 = a[2] ^ a[4];
+	T x35 = x34 | x1;
+	T x36 = BsAndNot(x35, a[3]);
+	T x37 = a[5] ^ x36;
+	T x38 = a[2] ^ x28;
+	T x39 = BsAndNot(x38, x37);
+	T x40 = x39 & a[1];
+	T x41 = x37 ^ x40;
+	T x42 = x41 & a[0];
+	T x43 = x33 ^ x42;
+	T x44 = x15 ^ x25;
+	T x45 = a[5] ^ x29;
+	T x46 = x45 & a[2];
+	T x47 = x44 ^ x46;
+	T x48 = a[2] | a[3];
+	T x49 = x48 ^ x4;
+	T x50 = x49 & a[1];
+	T x51 = x47 ^ x50;
+	T x52 = x3 ^ x29;
+	T x53 = BsAndNot(x52, a[1]);
+	T x54 = ~x14;
+	T x55 = BsAndNot(x16, a[1]);
+	T x56 = x54 ^ x55;
+	T x57 = BsAndNot(x56, a[2]);
+	T x58 = x53 ^ x57;
+	T x59 = x58 & a[0];
+	T x60 = x51 ^ x59;
+	T x61 = x14 ^ x26;
+	T x62 = a[4] ^ x3;
+	T x63 = BsAndNot(x62, a[2]);
+	T x64 = x61 ^ x63;
+	T x65 = a[2] ^ x14;
+	T x66 = x65 | x62;
+	T x67 = x66 & a[1];
+	T x68 = x64 ^ x67;
+	T x69 = a[3] & x35;
+	T x70 = x69 ^ x54;
+	T x71 = x15 ^ x35;
+	T x72 = x71 ^ x64;
+	T x73 = x72 & a[1];
+	T x74 = x70 ^ x73;
+	T x75 = x74 & a[0];
+	T x76 = x68 ^ x75;
+
+	out[0] = x60;
+	out[1] = x43;
+	out[2] = x76;
+	out[3] = x22;
+
+	return;
+}
+
+template <typename T>
+inline VOID DesBitslicedSbox2(CONST T* a, T* out)
+{
+	T x1 = a[4] ^ a[5];
+	T x2 = ~x1;
+	T x3 = x2 ^ a[0];
+	T x4 = x3 ^ a[1];
+	T x5 = ~a[4];
+	T x6 = a[1] ^ a[4];
+	T x7 = a[1] & a[4];
+	T x8 = x7 & a[0];
+	T x9 = x6 ^ x8;
+	T x10 = BsAndNot(x9, a[5]);
+	T x11 = x5 ^ x10;
+	T x12 = x11 & a[3];
+	T x13 = x4 ^ x12;
+	T x14 = a[1] ^ a[5];
+	T x15 = BsAndNot(x14, x8);
+	T x16 = a[4] & a[5];
+	T x17 = x16 & a[3];
+	T x18 = x15 ^ x17;
+	T x19 = x18 & a[2];
+	T x20 = x13 ^ x19;
+	T x21 = a[0] ^ x5;
+	T x22 = x21 | x16;
+	T x23 = a[0] | a[4];
+	T x24 = x23 ^ x1;
+	T x25 = BsAndNot(x24, a[1]);
+	T x26 = x22 ^ x25;
+	T x27 = ~x7;
+	T x28 = BsAndNot(x6, x21);
+	T x29 = x28 & a[5];
+	T x30 = x27 ^ x29;
+	T x31 = BsAndNot(x30, a[3]);
+	T x32 = x26 ^ x31;
+	T x33 = x2 & x22;
+	T x34 = x1 & x23;
+	T x35 = x34 & a[1];
+	T x36 = x33 ^ x35;
+	T x37 = BsAndNot(x36, a[2]);
+	T x38 = x32 ^ x37;
+	T x39 = a[1] ^ x33;
+	T x40 = x23 | x26;
+	T x41 = x40 ^ x22;
+	T x42 = BsAndNot(x41, a[3]);
+	T x43 = x39 ^ x42;
+	T x44 = x8 | x29;
+	T x45 = x44 ^ x40;
+	T x46 = a[0] & x4;
+	T x47 = x46 ^ x3;
+	T x48 = BsAndNot(x47, a[3]);
+	T x49 = x45 ^ x48;
+	T x50 = BsAndNot(x49, a[2]);
+	T x51 = x43 ^ x50;
+	T x52 = a[1] ^ x1;
+	T x53 = BsAndNot(x2, x7);
+	T x54 = BsAndNot(x52, a[0]);
+	T x55 = x53 & a[0];
+	T x56 = x54 | x55;
+	T x57 = a[0] ^ a[5];
+	T x58 = x57 | x11;
+	T x59 = BsAndNot(x58, a[2]);
+	T x60 = x56 ^ x59;
+	T x61 = a[1] | x16;
+	T x62 = x61 | x28;
+	T x63 = x62 & a[3];
+	T x64 = x60 ^ x63;
+
+	out[0] = x64;
+	out[1] = x20;
+	out[2] = x51;
+	out[3] = x38;
+
+	return;
+}
+
+template <typename T>
+inline VOID DesBitslicedSbox3(CONST T* a, T* out)
+{
+	T x1 = a[0] ^ a[3];
+	T x2 = a[0] | a[3];
+	T x3 = ~x2;
+	T x4 = x3 | a[2];
+	T x5 = x4 & a[1];
+	T x6 = x1 ^ x5;
+	T x7 = a[2] | x2;
+	T x8 = a[0] ^ a[2];
+	T x9 = x8 ^ x2;
+	T x10 = BsAndNot(x9, a[1]);
+	T x11 = x7 ^ x10;
+	T x12 = BsAndNot(x11, a[5]);
+	T x13 = x6 ^ x12;
+	T x14 = x3 ^ x7;
+	T x15 = x2 ^ x11;
+	T x16 = BsAndNot(x15, a[5]);
+	T x17 = x14 ^ x16;
+	T x18 = BsAndNot(x17, a[4]);
+	T x19 = x13 ^ x18;
+	T x20 = a[5] ^ x8;
+	T x21 = a[0] | a[2];
+	T x22 = x21 | a[5];
+	T x23 = x22 & a[1];
+	T x24 = x20 ^ x23;
+	T x25 = a[0] ^ a[1];
+	T x26 = x25 ^ a[5];
+	T x27 = BsAndNot(x24, a[4]);
+	T x28 = x26 & a[4];
+	T x29 = x27 | x28;
+	T x30 = BsAndNot(a[4], a[5]);
+	T x31 = ~a[0];
+	T x32 = a[0] & a[4];
+	T x33 = x32 & a[5];
+	T x34 = x31 ^ x33;
+	T x35 = BsAndNot(x34, a[2]);
+	T x36 = x30 ^ x35;
+	T x37 = a[5] ^ x21;
+	T x38 = ~x37;
+	T x39 = BsAndNot(x38, a[1]);
+	T x40 = x36 ^ x39;
+	T x41 = x40 & a[3];
+	T x42 = x29 ^ x41;
+	T x43 = a[1] ^ x20;
+	T x44 = x21 ^ x31;
+	T x45 = a[0] & x20;
+	T x46 = x45 & a[1];
+	T x47 = x44 ^ x46;
+	T x48 = BsAndNot(x47, a[4]);
+	T x49 = x43 ^ x48;
+	T x50 = a[0] | a[4];
+	T x51 = x50 ^ x31;
+	T x52 = BsAndNot(a[0], x5);
+	T x53 = x52 & a[5];
+	T x54 = x51 ^ x53;
+	T x55 = BsAndNot(x54, a[3]);
+	T x56 = x49 ^ x55;
+	T x57 = a[1] ^ a[2];
+	T x58 = x25 | x31;
+	T x59 = BsAndNot(x58, a[3]);
+	T x60 = x57 ^ x59;
+	T x61 = a[1] ^ x31;
+	T x62 = x61 | x15;
+	T x63 = BsAndNot(x62, a[5]);
+	T x64 = x60 ^ x63;
+	T x65 = x1 | x60;
+	T x66 = x1 ^ x4;
+	T x67 = x66 ^ x60;
+	T x68 = x67 & a[5];
+	T x69 = x65 ^ x68;
+	T x70 = BsAndNot(x69, a[4]);
+	T x71 = x64 ^ x70;
+
+	out[0] = x19;
+	out[1] = x42;
+	out[2] = x71;
+	out[3] = x56;
+
+	return;
+}
+
+template <typename T>
+inline VOID DesBitslicedSbox4(CONST T* a, T* out)
+{
+	T x1 = ~a[3];
+	T x2 = a[2] | a[3];
+	T x3 = BsAndNot(x1, a[1]);
+	T x4 = x2 & a[1];
+	T x5 = x3 | x4;
+	T x6 = a[2] ^ a[3];
+	T x7 = BsAndNot(x6, a[4]);
+	T x8 = x5 ^ x7;
+	T x9 = BsAndNot(a[4], a[2]);
+	T x10 = ~x9;
+	T x11 = a[2] ^ a[4];
+	T x12 = BsAndNot(a[1], x11);
+	T x13 = x12 & a[3];
+	T x14 = x10 ^ x13;
+	T x15 = x14 & a[0];
+	T x16 = x8 ^ x15;
+	T x17 = x7 ^ x9;
+	T x18 = a[3] & x11;
+	T x19 = x18 ^ x10;
+	T x20 = x19 & a[1];
+	T x21 = x17 ^ x20;
+	T x22 = a[3] & x19;
+	T x23 = BsAndNot(x9, a[1]);
+	T x24 = x22 ^ x23;
+	T x25 = x24 & a[0];
+	T x26 = x21 ^ x25;
+	T x27 = x26 & a[5];
+	T x28 = x16 ^ x27;
+	T x29 = x1 ^ x17;
+	T x30 = x7 ^ x11;
+	T x31 = BsAndNot(x30, a[1]);
+	T x32 = x29 ^ x31;
+	T x33 = a[1] ^ a[3];
+	T x34 = x33 | x24;
+	T x35 = BsAndNot(x34, a[0]);
+	T x36 = x32 ^ x35;
+	T x37 = a[4] ^ x1;
+	T x38 = x37 ^ x21;
+	T x39 = x20 | x32;
+	T x40 = x39 & x14;
+	T x41 = BsAndNot(x40, a[0]);
+	T x42 = x38 ^ x41;
+	T x43 = BsAndNot(x42, a[5]);
+	T x44 = x36 ^ x43;
+	T x45 = ~x42;
+	T x46 = x45 & a[5];
+	T x47 = x36 ^ x46;
+	T x48 = ~x26;
+	T x49 = BsAndNot(x48, a[5]);
+	T x50 = x16 ^ x49;
+
+	out[0] = x50;
+	out[1] = x28;
+	out[2] = x47;
+	out[3] = x44;
+
+	return;
+}
+
+template <typename T>
+inline VOID DesBitslicedSbox5(CONST T* a, T* out)
+{
+	T x1 = a[0] ^ a[5];
+	T x2 = BsAndNot(a[0], a[5]);
+	T x3 = x2 ^ a[1];
+	T x4 = BsAndNot(x3, a[2]);
+	T x5 = x1 ^ x4;
+	T x6 = a[2] | a[5];
+	T x7 = a[2] & a[5];
+	T x8 = ~x6;
+	T x9 = BsAndNot(x8, a[0]);
+	T x10 = x7 ^ x9;
+	T x11 = x10 & a[1];
+	T x12 = x6 ^ x11;
+	T x13 = BsAndNot(x12, a[4]);
+	T x14 = x5 ^ x13;
+	T x15 = ~a[1];
+	T x16 = a[0] | a[1];
+	T x17 = BsAndNot(x15, a[2]);
+	T x18 = x16 & a[2];
+	T x19 = x17 | x18;
+	T x20 = BsAndNot(x1, x3);
+	T x21 = x20 ^ x9;
+	T x22 = BsAndNot(x21, a[4]);
+	T x23 = x19 ^ x22;
+	T x24 = x23 & a[3];
+	T x25 = x14 ^ x24;
+	T x26 = a[1] ^ a[5];
+	T x27 = a[0] | x20;
+	T x28 = x27 & a[2];
+	T x29 = x26 ^ x28;
+	T x30 = ~a[0];
+	T x31 = x15 ^ x16;
+	T x32 = a[0] ^ a[1];
+	T x33 = x32 & a[2];
+	T x34 = x31 ^ x33;
+	T x35 = x34 & a[5];
+	T x36 = x30 ^ x35;
+	T x37 = x36 & a[4];
+	T x38 = x29 ^ x37;
+	T x39 = x16 ^ x27;
+	T x40 = x2 | x15;
+	T x41 = x40 & a[4];
+	T x42 = x39 ^ x41;
+	T x43 = a[4] | x1;
+	T x44 = x43 ^ x31;
+	T x45 = x44 & a[2];
+	T x46 = x42 ^ x45;
+	T x47 = x46 & a[3];
+	T x48 = x38 ^ x47;
+	T x49 = a[1] & x1;
+	T x50 = x49 ^ x40;
+	T x51 = x50 & a[2];
+	T x52 = x39 ^ x51;
+	T x53 = BsAndNot(x19, x9);
+	T x54 = x53 & a[4];
+	T x55 = x52 ^ x54;
+	T x56 = a[5] | x11;
+	T x57 = x3 & x26;
+	T x58 = x57 ^ x21;
+	T x59 = BsAndNot(x58, a[4]);
+	T x60 = x56 ^ x59;
+	T x61 = BsAndNot(x60, a[3]);
+	T x62 = x55 ^ x61;
+	T x63 = x30 ^ x49;
+	T x64 = a[0] ^ x26;
+	T x65 = BsAndNot(x63, a[3]);
+	T x66 = x64 & a[3];
+	T x67 = x65 | x66;
+	T x68 = a[0] | x50;
+	T x69 = x68 ^ x26;
+	T x70 = x69 | a[3];
+	T x71 = BsAndNot(x70, a[2]);
+	T x72 = x67 ^ x71;
+	T x73 = a[2] | x30;
+	T x74 = a[0] ^ a[2];
+	T x75 = x74 & x1;
+	T x76 = BsAndNot(x75, a[3]);
+	T x77 = x73 ^ x76;
+	T x78 = x77 & a[4];
+	T x79 = x72 ^ x78;
+
+	out[0] = x48;
+	out[1] = x79;
+	out[2] = x62;
+	out[3] = x25;
+
+	return;
+}
+
+template <typename T>
+inline VOID DesBitslicedSbox6(CONST T* a, T* out)
+{
+	T x1 = a[1] ^ a[3];
+	T x2 = ~x1;
+	T x3 = a[3] | a[4];
+	T x4 = BsAndNot(x3, a[5]);
+	T x5 = x2 ^ x4;
+	T x6 = a[1] | x2;
+	T x7 = x6 & a[5];
+	T x8 = x7 | a[4];
+	T x9 = x8 & a[0];
+	T x10 = x5 ^ x9;
+	T x11 = a[3] & x7;
+	T x12 = BsAndNot(x11, a[0]);
+	T x13 = a[1] ^ x12;
+	T x14 = a[3] | a[5];
+	T x15 = BsAndNot(a[5], a[1]);
+	T x16 = ~x15;
+	T x17 = x16 & a[0];
+	T x18 = x14 ^ x17;
+	T x19 = BsAndNot(x18, a[4]);
+	T x20 = x13 ^ x19;
+	T x21 = x20 & a[2];
+	T x22 = x10 ^ x21;
+	T x23 = a[5] ^ x2;
+	T x24 = a[3] ^ x11;
+	T x25 = BsAndNot(x23, a[4]);
+	T x26 = x24 & a[4];
+	T x27 = x25 | x26;
+	T x28 = a[3] & a[4];
+	T x29 = ~x28;
+	T x30 = a[4] & x14;
+	T x31 = BsAndNot(x30, a[1]);
+	T x32 = x29 ^ x31;
+	T x33 = BsAndNot(x32, a[0]);
+	T x34 = x27 ^ x33;
+	T x35 = a[1] | a[4];
+	T x36 = BsAndNot(a[1], a[5]);
+	T x37 = BsAndNot(x16, a[4]);
+	T x38 = x36 ^ x37;
+	T x39 = x38 & a[0];
+	T x40 = x35 ^ x39;
+	T x41 = BsAndNot(x40, a[2]);
+	T x42 = x34 ^ x41;
+	T x43 = a[3] ^ x23;
+	T x44 = a[1] & a[5];
+	T x45 = x44 | a[2];
+	T x46 = BsAndNot(x45, a[0]);
+	T x47 = x43 ^ x46;
+	T x48 = a[0] | a[5];
+	T x49 = BsAndNot(x36, a[2]);
+	T x50 = x48 ^ x49;
+	T x51 = BsAndNot(x50, a[3]);
+	T x52 = x47 ^ x51;
+	T x53 = a[0] & a[2];
+	T x54 = ~x53;
+	T x55 = x16 & x46;
+	T x56 = x55 ^ x48;
+	T x57 = x56 & a[3];
+	T x58 = x54 ^ x57;
+	T x59 = BsAndNot(x58, a[4]);
+	T x60 = x52 ^ x59;
+	T x61 = x6 ^ x26;
+	T x62 = x61 ^ x43;
+	T x63 = a[4] ^ x29;
+	T x64 = BsAndNot(x63, a[2]);
+	T x65 = x62 ^ x64;
+	T x66 = x23 | x29;
+	T x67 = x3 | x44;
+	T x68 = x67 ^ x27;
+	T x69 = x68 & a[2];
+	T x70 = x66 ^ x69;
+	T x71 = x70 & a[0];
+	T x72 = x65 ^ x71;
+
+	out[0] = x22;
+	out[1] = x72;
+	out[2] = x42;
+	out[3] = x60;
+
+	return;
+}
+
+template <typename T>
+inline VOID DesBitslicedSbox7(CONST T* a, T* out)
+{
+	T x1 = a[0] | a[2];
+	T x2 = x1 & a[1];
+	T x3 = a[2] ^ x2;
+	T x4 = a[0] ^ a[1];
+	T x5 = x4 ^ x2;
+	T x6 = x5 & a[3];
+	T x7 = x3 ^ x6;
+	T x8 = BsAndNot(a[0], a[2]);
+	T x9 = ~x8;
+	T x10 = BsAndNot(a[1], x5);
+	T x11 = BsAndNot(x10, a[3]);
+	T x12 = x9 ^ x11;
+	T x13 = x12 & a[5];
+	T x14 = x7 ^ x13;
+	T x15 = a[1] | x9;
+	T x16 = BsAndNot(a[0], a[1]);
+	T x17 = BsAndNot(x16, a[3]);
+	T x18 = x15 ^ x17;
+	T x19 = a[0] ^ a[3];
+	T x20 = x19 & x1;
+	T x21 = BsAndNot(x20, a[5]);
+	T x22 = x18 ^ x21;
+	T x23 = x22 & a[4];
+	T x24 = x14 ^ x23;
+	T x25 = a[5] ^ x4;
+	T x26 = a[0] & a[1];
+	T x27 = ~x26;
+	T x28 = BsAndNot(x26, a[5]);
+	T x29 = x27 ^ x28;
+	T x30 = x29 & a[4];
+	T x31 = x25 ^ x30;
+	T x32 = a[1] ^ x29;
+	T x33 = x32 & a[2];
+	T x34 = x31 ^ x33;
+	T x35 = ~a[2];
+	T x36 = a[1] ^ x8;
+	T x37 = x36 & a[5];
+	T x38 = x35 ^ x37;
+	T x39 = BsAndNot(x38, a[4]);
+	T x40 = x29 ^ x39;
+	T x41 = x40 & a[3];
+	T x42 = x34 ^ x41;
+	T x43 = a[0] | x35;
+	T x44 = x15 ^ x26;
+	T x45 = BsAndNot(x44, a[4]);
+	T x46 = x43 ^ x45;
+	T x47 = BsAndNot(x46, a[5]);
+	T x48 = x36 ^ x47;
+	T x49 = BsAndNot(x27, a[4]);
+	T x50 = a[1] & a[4];
+	T x51 = x49 | x50;
+	T x52 = BsAndNot(x3, a[0]);
+	T x53 = a[1] ^ x43;
+	T x54 = x53 & a[4];
+	T x55 = x52 ^ x54;
+	T x56 = x55 & a[5];
+	T x57 = x51 ^ x56;
+	T x58 = x57 & a[3];
+	T x59 = x48 ^ x58;
+	T x60 = x3 ^ x43;
+	T x61 = x4 | x36;
+	T x62 = BsAndNot(x61, a[5]);
+	T x63 = x60 ^ x62;
+	T x64 = x63 ^ a[4];
+	T x65 = x29 ^ x61;
+	T x66 = a[0] ^ a[5];
+	T x67 = BsAndNot(x66, x38);
+	T x68 = x67 & a[4];
+	T x69 = x65 ^ x68;
+	T x70 = x69 & a[3];
+	T x71 = x64 ^ x70;
+
+	out[0] = x24;
+	out[1] = x71;
+	out[2] = x59;
+	out[3] = x42;
+
+	return;
+}
+
+template <typename T>
+inline VOID DesBitslicedSbox8(CONST T* a, T* out)
+{
+	T x1 = a[0] ^ a[2];
+	T x2 = a[1] | a[2];
+	T x3 = x2 & a[5];
+	T x4 = x1 ^ x3;
+	T x5 = BsAndNot(a[0], a[2]);
+	T x6 = x5 | a[1];
+	T x7 = x6 | a[5];
+	T x8 = BsAndNot(x7, a[4]);
+	T x9 = x4 ^ x8;
+	T x10 = ~a[4];
+	T x11 = a[0] | a[4];
+	T x12 = x11 & a[1];
+	T x13 = x10 ^ x12;
+	T x14 = BsAndNot(a[2], a[4]);
+	T x15 = x5 ^ x11;
+	T x16 = BsAndNot(x15, a[1]);
+	T x17 = x14 ^ x16;
+	T x18 = BsAndNot(x13, a[5]);
+	T x19 = x17 & a[5];
+	T x20 = x18 | x19;
+	T x21 = BsAndNot(x20, a[3]);
+	T x22 = x9 ^ x21;
+	T x23 = x2 ^ x17;
+	T x24 = a[1] ^ a[4];
+	T x25 = x24 ^ x13;
+	T x26 = x25 & a[3];
+	T x27 = x23 ^ x26;
+	T x28 = x10 | x15;
+	T x29 = a[0] & x6;
+	T x30 = x29 & a[3];
+	T x31 = x28 ^ x30;
+	T x32 = BsAndNot(x31, a[5]);
+	T x33 = x27 ^ x32;
+	T x34 = BsAndNot(x1, a[4]);
+	T x35 = x34 ^ x28;
+	T x36 = a[0] & x28;
+	T x37 = BsAndNot(x36, a[5]);
+	T x38 = x35 ^ x37;
+	T x39 = a[5] | x28;
+	T x40 = BsAndNot(x39, a[1]);
+	T x41 = x38 ^ x40;
+	T x42 = x1 ^ x2;
+	T x43 = a[0] | a[1];
+	T x44 = x43 & a[4];
+	T x45 = x42 ^ x44;
+	T x46 = x45 & a[5];
+	T x47 = x11 ^ x46;
+	T x48 = BsAndNot(x47, a[3]);
+	T x49 = x41 ^ x48;
+	T x50 = a[1] ^ x1;
+	T x51 = ~x50;
+	T x52 = ~x29;
+	T x53 = BsAndNot(x52, a[4]);
+	T x54 = x51 ^ x53;
+	T x55 = x13 & a[3];
+	T x56 = x54 ^ x55;
+	T x57 = a[4] ^ x36;
+	T x58 = x15 ^ x28;
+	T x59 = BsAndNot(x58, a[1]);
+	T x60 = x57 ^ x59;
+	T x61 = x2 ^ x10;
+	T x62 = x10 | x24;
+	T x63 = BsAndNot(x61, a[0]);
+	T x64 = x62 & a[0];
+	T x65 = x63 | x64;
+	T x66 = x65 & a[3];
+	T x67 = x60 ^ x66;
+	T x68 = BsAndNot(x67, a[5]);
+	T x69 = x56 ^ x68;
+
+	out[0] = x69;
+	out[1] = x33;
+	out[2] = x49;
+	out[3] = x22;
+
+	return;
+}
+
+// rbgXCX DES ̓Ye[u
+// S ֐̏o͂ m rbgڂ P ɂ f  PInv[m] rbgڂɈڂ
+// Eh Kn+1  b + 1 rbgڂ 64 rbg KeyBit[n][b] + 1 rbg (ƂɃv[ꍇɎg)
+struct DES_BITSLICE_TABLE
+{
+	BYTE PInv[32];
+	BYTE KeyBit[16][48];
+};
+
+// MakeDesBitsliceTable ֐
+constexpr DES_BITSLICE_TABLE MakeDesBitsliceTable()
+{
+	DES_BITSLICE_TABLE Table = {};
+	DWORD i = 0;
+
+	DWORD n = 0, b = 0, p = 0, Shift = 0;
+
+	for (i = 0; i < 32; i++)
+	{
+		Table.PInv[P[i] - 1] = (BYTE)i;
+	}
+
+	// Kn+1 = PC2(Cn+1 || Dn+1) ŁACn+1, Dn+1  C0, D0  Shift rbg[e[g
+	//  CD  p rbgڂ C0 (܂ D0)  (p + Shift) mod 28 rbgځAȂ킿 PC1 ̂̈ʒǔrbgɂȂ
+	for (n = 0; n < 16; n++)
+	{
+		Shift += NumLeftShifts[n];
+		for (b = 0; b < 48; b++)
+		{
+			p = PC2[b] - 1;
+			p = p < 28 ? (p + Shift) % 28 : 28 + (p - 28 + Shift) % 28;
+			Table.KeyBit[n][b] = (BYTE)(PC1[p] - 1);
+		}
+	}
+
+	return Table;
+}
+
+constexpr DES_BITSLICE_TABLE DesBitslice = MakeDesBitsliceTable();
+
+// DesRoundKey ֐
+// ReLXg烉Eh Kn+1  48 rbg̒l (ŏʂ 1 rbg) ƂĎo
+inline ULONG64 DesRoundKey(DES_KEY_CONTEXT* pContext, DWORD n)
+{
+	DWORD j;
+	ULONG64 K = 0;
+
+	for (j = 0; j < 8; j++)
+	{
+		K = (K << 6) | ((pContext->K[n][j & 1] >> (24 - 8 * (j >> 1))) & 0x3F);
+	}
+
+	return K;
+}
+
+// DesBitslicedRoundKey ֐
+// Eh Kn+1 ̊erbgS[ʂ̃}XNƂ 48 ̃v[ K ɓWJ
+template <typename T>
+inline VOID DesBitslicedRoundKey(DES_KEY_CONTEXT* pContext, DWORD n, T* K)
+{
+	ULONG64 Kn = DesRoundKey(pContext, n);
+	DWORD b;
+
+	for (b = 0; b < 48; b++)
+	{
+		K[b] = BsSet<T>(0 - ((Kn >> (47 - b)) & 1));
+	}
+
+	return;
+}
+
+// DesBitslicedRoundKey ֐
+// ̃v[ ([ƂɈقȂ錮) AEh Kn+1  48 ̃v[ K Iяo
+// XPW[̓rbg̑IȂ̂ŁAv[̕tւōς
+template <typename T>
+inline VOID DesBitslicedRoundKey(CONST T* KeyPlanes, DWORD n, T* K)
+{
+	DWORD b;
+
+	for (b = 0; b < 48; b++)
+	{
+		K[b] = KeyPlanes[DesBitslice.KeyBit[n][b]];
+	}
+
+	return;
+}
+
+// DesBitslicedSboxInput ֐
+// E ɏ] R ̃v[IсAEh̃v[ K  xor  Sj+1 ̓͂
+template <typename T>
+inline VOID DesBitslicedSboxInput(CONST T* R, CONST T* K, DWORD j, T* In)
+{
+	DWORD b;
+
+	for (b = 0; b < 6; b++)
+	{
+		In[b] = R[E[6 * j + b] - 1] ^ K[6 * j + b];
+	}
+
+	return;
+}
+
+// DesBitslicedSboxOutput ֐
+// Sj+1 ̏o͂ P ̈ړ L ̃v[ xor 
+template <typename T>
+inline VOID DesBitslicedSboxOutput(CONST T* Out, DWORD j, T* L)
+{
+	DWORD k;
+
+	for (k = 0; k < 4; k++)
+	{
+		L[DesBitslice.PInv[4 * j + k]] = L[DesBitslice.PInv[4 * j + k]] ^ Out[k];
+	}
+
+	return;
+}
+
+// DesBitslicedF ֐
+// f ֐rbgv[ŌvZAL  xor  (Rn+1 = Ln ^ f(Rn, Kn+1))
+template <typename T>
+VOID DesBitslicedF(CONST T* R, CONST T* K, T* L)
+{
+	T In[6], Out[4];
+
+	DesBitslicedSboxInput(R, K, 0, In);
+	DesBitslicedSbox1(In, Out);
+	DesBitslicedSboxOutput(Out, 0, L);
+
+	DesBitslicedSboxInput(R, K, 1, In);
+	DesBitslicedSbox2(In, Out);
+	DesBitslicedSboxOutput(Out, 1, L);
+
+	DesBitslicedSboxInput(R, K, 2, In);
+	DesBitslicedSbox3(In, Out);
+	DesBitslicedSboxOutput(Out, 2, L);
+
+	DesBitslicedSboxInput(R, K, 3, In);
+	DesBitslicedSbox4(In, Out);
+	DesBitslicedSboxOutput(Out, 3, L);
+
+	DesBitslicedSboxInput(R, K, 4, In);
+	DesBitslicedSbox5(In, Out);
+	DesBitslicedSboxOutput(Out, 4, L);
+
+	DesBitslicedSboxInput(R, K, 5, In);
+	DesBitslicedSbox6(In, Out);
+	DesBitslicedSboxOutput(Out, 5, L);
+
+	DesBitslicedSboxInput(R, K, 6, In);
+	DesBitslicedSbox7(In, Out);
+	DesBitslicedSboxOutput(Out, 6, L);
+
+	DesBitslicedSboxInput(R, K, 7, In);
+	DesBitslicedSbox8(In, Out);
+	DesBitslicedSboxOutput(Out, 7, L);
+
+	return;
+}
+
+// DesBitslicedRounds ֐
+// 16 Ehrbgv[ōs
+// DesCryptBlock Ɠ 2 EhWJ邽߁AI L  L16AR  R16 
+// Key  DES_KEY_CONTEXT* (S[ʂ̌) ܂͌̃v[ CONST T* ([Ƃ̌)
+template <typename T, typename KEY>
+VOID DesBitslicedRounds(KEY Key, T* L, T* R, BOOL bDecrypt)
+{
+	T K[48];
+	DWORD i;
+
+	for (i = 0; i < 16; i += 2)
+	{
+		DesBitslicedRoundKey(Key, bDecrypt ? 15 - i : i, K);
+		DesBitslicedF(R, K, L);
+		DesBitslicedRoundKey(Key, bDecrypt ? 14 - i : i + 1, K);
+		DesBitslicedF(L, K, R);
+	}
+
+	return;
+}
+
+// DesBitslicedCryptGroup ֐
+// 64  (ULONG64) ܂ 256  (DES_PLANE256) ̃ubN܂Ƃ߂ĈÍ / 
+// nKeys  1 ̏ꍇ DESA3 ̏ꍇ TDEA (TdeaCryptBlock Ɠ E-D-E / D-E-D) Ƃ
+// TDEA ̒i̊Ԃ FP  IP ͑ł߁Av[̕tւ͍ŏ IP ƍŌ FP ł悢
+template <typename T>
+VOID DesBitslicedCryptGroup(DES_KEY_CONTEXT* Contexts, DWORD nKeys, BYTE* in, BYTE* out, BOOL bDecrypt)
+{
+	T X[64], Y[64];
+	T* L = Y;
+	T* R = &Y[32];
+	T* Swap;
+	DWORD i;
+
+	BsLoadBlocks(X, in);
+	BsTranspose64(X);
+
+	// Initial Permutation
+	for (i = 0; i < 64; i++)
+	{
+		Y[i] = X[IP[i] - 1];
+	}
+
+	for (i = 0; i < nKeys; i++)
+	{
+		DesBitslicedRounds(&Contexts[bDecrypt ? nKeys - 1 - i : i], L, R, (i & 1) ? !bDecrypt : bDecrypt);
+
+		// ̒i̓ (܂ FP ̓)  R16 || L16
+		Swap = L;
+		L = R;
+		R = Swap;
+	}
+
+	// Final Permutation
+	for (i = 0; i < 64; i++)
+	{
+		X[i] = InvIP[i] <= 32 ? L[InvIP[i] - 1] : R[InvIP[i] - 33];
+	}
+
+	BsTranspose64(X);
+	BsStoreBlocks(X, out);
+
+	return;
+}
+
+// DesKcvGroup ֐
+// cbKey oCǧ 64  (ULONG64) ܂ 256  (DES_PLANE256) ׂ Keys ́Ae 0 ̃ubNÍʂ out Ɋi[
+// cbKey  8 (DES)A16 (TDEA Keying Option 2, K3 = K1)A24 (TDEA Keying Option 1)
+template <typename T>
+VOID DesKcvGroup(BYTE* Keys, DWORD cbKey, BYTE* out)
+{
+	T KeyPlanes[3][64], X[64], Y[64];
+	T* L = Y;
+	T* R = &Y[32];
+	T* Swap;
+	BYTE Temp[8 * 8 * sizeof(T)];
+	DWORD i, j, nStages = cbKey == 8 ? 1 : 3;
+
+	// eǐגăv[ɓ]u (̃peBrbg̃v[͎gȂ)
+	for (j = 0; j < cbKey / 8; j++)
+	{
+		for (i = 0; i < 8 * sizeof(T); i++)
+		{
+			memcpy(&Temp[8 * i], &Keys[cbKey * i + 8 * j], 8);
+		}
+		BsLoadBlocks(KeyPlanes[j], Temp);
+		BsTranspose64(KeyPlanes[j]);
+	}
+
+	// 0 ̃ubN IP ̌ 0
+	for (i = 0; i < 64; i++)
+	{
+		Y[i] = BsSet<T>(0);
+	}
+
+	// TDEA  E-D-E
+	for (j = 0; j < nStages; j++)
+	{
+		DesBitslicedRounds(KeyPlanes[j == 2 && cbKey == 16 ? 0 : j], L, R, j == 1);
+
+		Swap = L;
+		L = R;
+		R = Swap;
+	}
+
+	// Final Permutation
+	for (i = 0; i < 64; i++)
+	{
+		X[i] = InvIP[i] <= 32 ? L[InvIP[i] - 1] : R[InvIP[i] - 33];
+	}
+
+	BsTranspose64(X);
+	BsStoreBlocks(X, out);
+
+	SecureZeroMemory(KeyPlanes, sizeof(KeyPlanes));
+	SecureZeroMemory(Temp, sizeof(Temp));
+
+	return;
+}
+}
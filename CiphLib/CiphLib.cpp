@@ -0,0 +1,1786 @@
+#include "CiphLib.h"
+#include "CiphAes.h"
+#include "CiphDes.h"
+#include <string.h>
+
+// CiphLib  C C^[tF[X
+// nh̎̂̓GW̌ReLXgŁA쐬 CiphAlloc ŊmۂAjɏĂ CiphFree ŉ
+// GW̊֐̓oCg DWORD Ŏ󂯎邽߁Asize_t ̃f[^ CIPH_CHUNK oCgɋ؂ēn
+// ECB, CBC ̕, CTR ̓GW *Dispatch ֐ɓnA͂̃oCgɉs@ (SelectDispatch) ŏ
+
+struct CIPH_AES_KEY_
+{
+	AES_KEY_CONTEXT Context;
+};
+
+struct CIPH_AES_GCM_
+{
+	AES_GCM_CONTEXT Context;
+};
+
+struct CIPH_AES_CMAC_
+{
+	AES_CMAC_CONTEXT Context;
+};
+
+struct CIPH_AES_XTS_
+{
+	AES_XTS_CONTEXT Context;
+};
+
+struct CIPH_AES_OCB_
+{
+	AES_OCB_CONTEXT Context;
+};
+
+struct CIPH_AES_CCM_
+{
+	AES_CCM_CONTEXT Context;
+};
+
+// GW̃Ggs[ɂ CiphDrbgEntropy nAĂяo̊֐ƈ̓nhɕێ
+struct CIPH_AES_DRBG_
+{
+	AES_CTR_DRBG_CONTEXT Context;
+	CIPH_ENTROPY_FUNCTION Entropy;
+	void* pUser;
+};
+
+struct CIPH_AES_FF1_
+{
+	AES_FF1_CONTEXT Context;
+};
+
+struct CIPH_AES_FF3_
+{
+	AES_FF3_CONTEXT Context;
+};
+
+struct CIPH_AES_DUKPT_BDK_
+{
+	AES_DUKPT_BDK_CONTEXT Context;
+};
+
+struct CIPH_TDEA_KEY_
+{
+	TDEA_KEY_CONTEXT Context;
+};
+
+struct CIPH_TDEA_MAC_
+{
+	DES_MAC_CONTEXT Context;
+};
+
+struct CIPH_TDEA_DUKPT_BDK_
+{
+	DUKPT_BDK_CONTEXT Context;
+};
+
+// 1 ̃GWĂяoŏő̃oCg (AES  DES ̃ubN̔{)
+#define CIPH_CHUNK 0x40000000
+
+// CiphAesBitLength ֐
+// ̃oCg AESBitLength ߂B16, 24, 32 oCgȊȌꍇ FALSE Ԃ
+static BOOL CiphAesBitLength(size_t cbKey, AESBitLength* pBitLength)
+{
+	switch (cbKey)
+	{
+	case 16:
+		*pBitLength = AES128;
+		return TRUE;
+	case 24:
+		*pBitLength = AES192;
+		return TRUE;
+	case 32:
+		*pBitLength = AES256;
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+// CiphCheckBuffers ֐
+// ubNPʂ̃[ḧ (cb == 0 ̏ꍇ in, out  NULL ł悢)
+static CIPH_STATUS CiphCheckBuffers(const void* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t cbBlock)
+{
+	if (hKey == NULL || (cb != 0 && (in == NULL || out == NULL)))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (cb % cbBlock != 0)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesCreateKey(const uint8_t* Key, size_t cbKey, CIPH_AES_KEY** phKey)
+{
+	AESBitLength BitLength;
+	CIPH_AES_KEY* hKey;
+
+	if (Key == NULL || phKey == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hKey = (CIPH_AES_KEY*)CiphAlloc(sizeof(CIPH_AES_KEY));
+	if (hKey == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesKeySetup((BYTE*)Key, BitLength, &hKey->Context);
+	*phKey = hKey;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesDestroyKey(CIPH_AES_KEY* hKey)
+{
+	if (hKey != NULL)
+	{
+		SecureZeroMemory(hKey, sizeof(CIPH_AES_KEY));
+		CiphFree(hKey);
+	}
+
+	return;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesEcbEncrypt(const CIPH_AES_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 16);
+	size_t cbCurrent, cbChunk;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += cbChunk)
+	{
+		cbChunk = cb - cbCurrent < CIPH_CHUNK ? cb - cbCurrent : CIPH_CHUNK;
+		AesEcbCryptDispatch((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)&in[cbCurrent], (DWORD)cbChunk, &out[cbCurrent], FALSE);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesEcbDecrypt(const CIPH_AES_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 16);
+	size_t cbCurrent, cbChunk;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += cbChunk)
+	{
+		cbChunk = cb - cbCurrent < CIPH_CHUNK ? cb - cbCurrent : CIPH_CHUNK;
+		AesEcbCryptDispatch((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)&in[cbCurrent], (DWORD)cbChunk, &out[cbCurrent], TRUE);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphAesCbcEncrypt ֐
+// CBC ̈Í͑ÕubŇʂɈˑ邽߁A1 ubN
+CIPH_STATUS CIPH_CALL CiphAesCbcEncrypt(const CIPH_AES_KEY* hKey, const uint8_t IV[16], const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 16);
+	BYTE Block[16];
+	size_t cbCurrent;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (IV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	memcpy(Block, IV, 16);
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += 16)
+	{
+		Xor((BYTE*)&in[cbCurrent], Block, 16, Block);
+		AesEncryptBlocks((AES_KEY_CONTEXT*)&hKey->Context, Block, Block, 1);
+		memcpy(&out[cbCurrent], Block, 16);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphAesCbcDecrypt ֐
+// CIPH_CHUNK oCg AesCbcDecryptDispatch ĂяoA؂̍Ō̈ÍubN IV Ƃ
+CIPH_STATUS CIPH_CALL CiphAesCbcDecrypt(const CIPH_AES_KEY* hKey, const uint8_t IV[16], const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 16);
+	BYTE Prev[16], Next[16];
+	size_t cbCurrent, cbChunk;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (IV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	memcpy(Prev, IV, 16);
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += cbChunk)
+	{
+		cbChunk = cb - cbCurrent < CIPH_CHUNK ? cb - cbCurrent : CIPH_CHUNK;
+		memcpy(Next, &in[cbCurrent + cbChunk - 16], 16);
+		AesCbcDecryptDispatch((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)&in[cbCurrent], (DWORD)cbChunk, Prev, &out[cbCurrent]);
+		memcpy(Prev, Next, 16);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphAesCtrCrypt ֐
+// AesCtrCryptDispatch  Offset e؂̃JE^vZ邽߁ACIPH_CHUNK oCg Offset i߂ČĂяo
+CIPH_STATUS CIPH_CALL CiphAesCtrCrypt(const CIPH_AES_KEY* hKey, const uint8_t ICV[16], uint64_t Offset, const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 1);
+	size_t cbCurrent, cbChunk;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (ICV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += cbChunk)
+	{
+		cbChunk = cb - cbCurrent < CIPH_CHUNK ? cb - cbCurrent : CIPH_CHUNK;
+		AesCtrCryptDispatch((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)&in[cbCurrent], (DWORD)cbChunk, (BYTE*)ICV, Offset + cbCurrent, &out[cbCurrent]);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphCheckPadded ֐
+// pfBOt / 郂[ḧ (CIPH_PADDING_*  AES_PADDING_*, DES_PADDING_* ƓlƂ)
+// GW PKCS#7 ̈Í̃oCg DWORD ň߁A2^32 - 16 oCgȏ CIPH_INVALID_LENGTH Ƃ
+static CIPH_STATUS CiphCheckPadded(const void* hKey, uint32_t Padding, const uint8_t* in, size_t cb, const uint8_t* out, const size_t* pcbOut, size_t cbBlock, BOOL bDecrypt)
+{
+	if (hKey == NULL || out == NULL || pcbOut == NULL || (cb != 0 && in == NULL))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (Padding < CIPH_PADDING_PKCS7 || CIPH_PADDING_CS3 < Padding)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if ((ULONG64)cb >= 0xFFFFFFF0)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+	if (Padding == CIPH_PADDING_PKCS7 ? bDecrypt && (cb == 0 || cb % cbBlock != 0) : cb < cbBlock)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesEcbEncryptPkcs7(const CIPH_AES_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckPadded(hKey, CIPH_PADDING_PKCS7, in, cb, out, pcbOut, 16, FALSE);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	AesEcbEncryptPkcs7Context((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, out);
+	*pcbOut = AesGetOutputLength((DWORD)cb, AES_PADDING_PKCS7);
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesEcbDecryptPkcs7(const CIPH_AES_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckPadded(hKey, CIPH_PADDING_PKCS7, in, cb, out, pcbOut, 16, TRUE);
+	DWORD cbOut;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	if (!AesEcbDecryptPkcs7Context((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, out, &cbOut))
+	{
+		return CIPH_INVALID_DATA;
+	}
+	*pcbOut = cbOut;
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesCbcEncryptPadded(const CIPH_AES_KEY* hKey, uint32_t Padding, const uint8_t IV[16], const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckPadded(hKey, Padding, in, cb, out, pcbOut, 16, FALSE);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (IV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	if (Padding == CIPH_PADDING_PKCS7)
+	{
+		AesCbcEncryptPkcs7Context((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, (BYTE*)IV, out);
+	}
+	else
+	{
+		AesCbcEncryptCtsContext((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, (BYTE*)IV, Padding, out);
+	}
+	*pcbOut = AesGetOutputLength((DWORD)cb, Padding);
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesCbcDecryptPadded(const CIPH_AES_KEY* hKey, uint32_t Padding, const uint8_t IV[16], const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckPadded(hKey, Padding, in, cb, out, pcbOut, 16, TRUE);
+	DWORD cbOut = (DWORD)cb;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (IV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	if (Padding == CIPH_PADDING_PKCS7)
+	{
+		if (!AesCbcDecryptPkcs7Context((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, (BYTE*)IV, out, &cbOut))
+		{
+			return CIPH_INVALID_DATA;
+		}
+	}
+	else
+	{
+		AesCbcDecryptCtsContext((AES_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, (BYTE*)IV, Padding, out);
+	}
+	*pcbOut = cbOut;
+
+	return CIPH_SUCCESS;
+}
+
+// CiphCheckKeyWrap ֐
+// bv / Abv̈
+static CIPH_STATUS CiphCheckKeyWrap(const CIPH_AES_KEY* hKek, uint32_t Mode, const uint8_t* in, size_t cb, const uint8_t* out, const size_t* pcbOut, BOOL bUnwrap)
+{
+	size_t cbMin;
+
+	if (hKek == NULL || in == NULL || out == NULL || pcbOut == NULL || (Mode != CIPH_KEY_WRAP_KW && Mode != CIPH_KEY_WRAP_KWP))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (bUnwrap)
+	{
+		cbMin = Mode == CIPH_KEY_WRAP_KWP ? 16 : 24;
+	}
+	else
+	{
+		cbMin = Mode == CIPH_KEY_WRAP_KWP ? 1 : 16;
+	}
+	if (cb < cbMin || (ULONG64)cb >= 0xFFFFFFF0 || ((bUnwrap || Mode == CIPH_KEY_WRAP_KW) && cb % 8 != 0))
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesKeyWrap(const CIPH_AES_KEY* hKek, uint32_t Mode, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckKeyWrap(hKek, Mode, in, cb, out, pcbOut, FALSE);
+	DWORD cbOut;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	if (!AesKeyWrap((AES_KEY_CONTEXT*)&hKek->Context, (BYTE*)in, (DWORD)cb, Mode == CIPH_KEY_WRAP_KWP, out, &cbOut))
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+	*pcbOut = cbOut;
+
+	return CIPH_SUCCESS;
+}
+
+// CiphAesKeyUnwrap ֐
+// ͎OɌ邽߁AGW FALSE Ԃ̂͊S̊mFɎsꍇ݂̂ƂȂ
+CIPH_STATUS CIPH_CALL CiphAesKeyUnwrap(const CIPH_AES_KEY* hKek, uint32_t Mode, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckKeyWrap(hKek, Mode, in, cb, out, pcbOut, TRUE);
+	DWORD cbOut;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	if (!AesKeyUnwrap((AES_KEY_CONTEXT*)&hKek->Context, (BYTE*)in, (DWORD)cb, Mode == CIPH_KEY_WRAP_KWP, out, &cbOut))
+	{
+		return CIPH_AUTHENTICATION_FAILED;
+	}
+	*pcbOut = cbOut;
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesGcmCreate(const uint8_t* Key, size_t cbKey, CIPH_AES_GCM** phGcm)
+{
+	AESBitLength BitLength;
+	CIPH_AES_GCM* hGcm;
+
+	if (Key == NULL || phGcm == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hGcm = (CIPH_AES_GCM*)CiphAlloc(sizeof(CIPH_AES_GCM));
+	if (hGcm == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesGcmInit((BYTE*)Key, BitLength, &hGcm->Context);
+	*phGcm = hGcm;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesGcmDestroy(CIPH_AES_GCM* hGcm)
+{
+	if (hGcm != NULL)
+	{
+		SecureZeroMemory(hGcm, sizeof(CIPH_AES_GCM));
+		CiphFree(hGcm);
+	}
+
+	return;
+}
+
+// CiphAeadCheck ֐
+// GCM, OCB, CCM ̈BGW͊e DWORD Ŏ󂯎邽߁A2^32 oCgȏ CIPH_INVALID_LENGTH Ƃ
+static CIPH_STATUS CiphAeadCheck(const void* hContext, const uint8_t* IV, size_t cbIV, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, const uint8_t* out, const uint8_t* Tag)
+{
+	if (hContext == NULL || IV == NULL || cbIV == 0 || Tag == NULL || (cbAAD != 0 && AAD == NULL) || (cb != 0 && (in == NULL || out == NULL)))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if ((ULONG64)cbIV > 0xFFFFFFFF || (ULONG64)cbAAD > 0xFFFFFFFF || (ULONG64)cb > 0xFFFFFFFF)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesGcmEncrypt(const CIPH_AES_GCM* hGcm, const uint8_t* IV, size_t cbIV, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, uint8_t* out, uint8_t Tag[16])
+{
+	CIPH_STATUS Status = CiphAeadCheck(hGcm, IV, cbIV, AAD, cbAAD, in, cb, out, Tag);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	AesGcmEncrypt((AES_GCM_CONTEXT*)&hGcm->Context, (BYTE*)IV, (DWORD)cbIV, (BYTE*)AAD, (DWORD)cbAAD, (BYTE*)in, (DWORD)cb, out, Tag);
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesGcmDecrypt(const CIPH_AES_GCM* hGcm, const uint8_t* IV, size_t cbIV, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, const uint8_t Tag[16], uint8_t* out)
+{
+	CIPH_STATUS Status = CiphAeadCheck(hGcm, IV, cbIV, AAD, cbAAD, in, cb, out, Tag);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	if (!AesGcmDecrypt((AES_GCM_CONTEXT*)&hGcm->Context, (BYTE*)IV, (DWORD)cbIV, (BYTE*)AAD, (DWORD)cbAAD, (BYTE*)in, (DWORD)cb, (BYTE*)Tag, out))
+	{
+		return CIPH_AUTHENTICATION_FAILED;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesCmacCreate(const uint8_t* Key, size_t cbKey, CIPH_AES_CMAC** phCmac)
+{
+	AESBitLength BitLength;
+	CIPH_AES_CMAC* hCmac;
+
+	if (Key == NULL || phCmac == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hCmac = (CIPH_AES_CMAC*)CiphAlloc(sizeof(CIPH_AES_CMAC));
+	if (hCmac == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesCmacInit((BYTE*)Key, BitLength, &hCmac->Context);
+	*phCmac = hCmac;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesCmacDestroy(CIPH_AES_CMAC* hCmac)
+{
+	if (hCmac != NULL)
+	{
+		SecureZeroMemory(hCmac, sizeof(CIPH_AES_CMAC));
+		CiphFree(hCmac);
+	}
+
+	return;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesCmac(const CIPH_AES_CMAC* hCmac, const uint8_t* in, size_t cb, uint8_t Mac[16])
+{
+	if (hCmac == NULL || Mac == NULL || (cb != 0 && in == NULL))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if ((ULONG64)cb > 0xFFFFFFFF)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	AesCmac((AES_CMAC_CONTEXT*)&hCmac->Context, (BYTE*)in, (DWORD)cb, Mac);
+
+	return CIPH_SUCCESS;
+}
+
+// CiphAesXtsCreate ֐
+//  Key1 || Key2 ̘AŁAꂼ̒ AESBitLength ߂
+CIPH_STATUS CIPH_CALL CiphAesXtsCreate(const uint8_t* Key, size_t cbKey, CIPH_AES_XTS** phXts)
+{
+	AESBitLength BitLength;
+	CIPH_AES_XTS* hXts;
+
+	if (Key == NULL || phXts == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (cbKey % 2 != 0 || !CiphAesBitLength(cbKey / 2, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hXts = (CIPH_AES_XTS*)CiphAlloc(sizeof(CIPH_AES_XTS));
+	if (hXts == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesXtsInit((BYTE*)Key, BitLength, &hXts->Context);
+	*phXts = hXts;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesXtsDestroy(CIPH_AES_XTS* hXts)
+{
+	if (hXts != NULL)
+	{
+		SecureZeroMemory(hXts, sizeof(CIPH_AES_XTS));
+		CiphFree(hXts);
+	}
+
+	return;
+}
+
+// CiphXtsCrypt ֐
+// 1 ̃GWĂяo CIPH_CHUNK oCg (ZN^傫ꍇ 1 ZN^) 𒴂Ȃ悤ɃZN^؂
+static CIPH_STATUS CiphXtsCrypt(const CIPH_AES_XTS* hXts, uint64_t FirstSector, const uint8_t* in, size_t cbSector, size_t nSectors, uint8_t* out, BOOL bEncrypt)
+{
+	size_t nCurrent, nChunk, nMax;
+
+	if (hXts == NULL || (nSectors != 0 && (in == NULL || out == NULL)))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (cbSector < 16 || (ULONG64)cbSector > 0xFFFFFFFF)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	nMax = cbSector < CIPH_CHUNK ? CIPH_CHUNK / cbSector : 1;
+	for (nCurrent = 0; nCurrent < nSectors; nCurrent += nChunk)
+	{
+		nChunk = nSectors - nCurrent < nMax ? nSectors - nCurrent : nMax;
+		if (bEncrypt)
+		{
+			AesXtsEncryptSectors((AES_XTS_CONTEXT*)&hXts->Context, FirstSector + nCurrent, (BYTE*)&in[cbSector * nCurrent], (DWORD)cbSector, (DWORD)nChunk, &out[cbSector * nCurrent], 0);
+		}
+		else
+		{
+			AesXtsDecryptSectors((AES_XTS_CONTEXT*)&hXts->Context, FirstSector + nCurrent, (BYTE*)&in[cbSector * nCurrent], (DWORD)cbSector, (DWORD)nChunk, &out[cbSector * nCurrent], 0);
+		}
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesXtsEncrypt(const CIPH_AES_XTS* hXts, uint64_t FirstSector, const uint8_t* in, size_t cbSector, size_t nSectors, uint8_t* out)
+{
+	return CiphXtsCrypt(hXts, FirstSector, in, cbSector, nSectors, out, TRUE);
+}
+
+CIPH_STATUS CIPH_CALL CiphAesXtsDecrypt(const CIPH_AES_XTS* hXts, uint64_t FirstSector, const uint8_t* in, size_t cbSector, size_t nSectors, uint8_t* out)
+{
+	return CiphXtsCrypt(hXts, FirstSector, in, cbSector, nSectors, out, FALSE);
+}
+
+CIPH_STATUS CIPH_CALL CiphAesOcbCreate(const uint8_t* Key, size_t cbKey, size_t cbTag, CIPH_AES_OCB** phOcb)
+{
+	AESBitLength BitLength;
+	CIPH_AES_OCB* hOcb;
+
+	if (Key == NULL || phOcb == NULL || cbTag == 0 || 16 < cbTag)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hOcb = (CIPH_AES_OCB*)CiphAlloc(sizeof(CIPH_AES_OCB));
+	if (hOcb == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesOcbInit((BYTE*)Key, BitLength, (DWORD)cbTag, &hOcb->Context);
+	*phOcb = hOcb;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesOcbDestroy(CIPH_AES_OCB* hOcb)
+{
+	if (hOcb != NULL)
+	{
+		SecureZeroMemory(hOcb, sizeof(CIPH_AES_OCB));
+		CiphFree(hOcb);
+	}
+
+	return;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesOcbEncrypt(const CIPH_AES_OCB* hOcb, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, uint8_t* out, uint8_t* Tag)
+{
+	CIPH_STATUS Status = CiphAeadCheck(hOcb, Nonce, cbNonce, AAD, cbAAD, in, cb, out, Tag);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (15 < cbNonce)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	AesOcbEncrypt((AES_OCB_CONTEXT*)&hOcb->Context, (BYTE*)Nonce, (DWORD)cbNonce, (BYTE*)AAD, (DWORD)cbAAD, (BYTE*)in, (DWORD)cb, out, Tag, 0);
+
+	return CIPH_SUCCESS;
+}
+
+// CiphAesOcbDecrypt ֐
+// Nonce ͎̒OɌ邽߁AGW FALSE Ԃ͔̂F؃^OvȂꍇ݂̂ƂȂ
+CIPH_STATUS CIPH_CALL CiphAesOcbDecrypt(const CIPH_AES_OCB* hOcb, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, const uint8_t* Tag, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphAeadCheck(hOcb, Nonce, cbNonce, AAD, cbAAD, in, cb, out, Tag);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (15 < cbNonce)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	if (!AesOcbDecrypt((AES_OCB_CONTEXT*)&hOcb->Context, (BYTE*)Nonce, (DWORD)cbNonce, (BYTE*)AAD, (DWORD)cbAAD, (BYTE*)in, (DWORD)cb, (BYTE*)Tag, out, 0))
+	{
+		return CIPH_AUTHENTICATION_FAILED;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesCcmCreate(const uint8_t* Key, size_t cbKey, size_t cbTag, CIPH_AES_CCM** phCcm)
+{
+	AESBitLength BitLength;
+	CIPH_AES_CCM* hCcm;
+
+	if (Key == NULL || phCcm == NULL || cbTag < 4 || 16 < cbTag || cbTag % 2 != 0)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hCcm = (CIPH_AES_CCM*)CiphAlloc(sizeof(CIPH_AES_CCM));
+	if (hCcm == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesCcmInit((BYTE*)Key, BitLength, (DWORD)cbTag, &hCcm->Context);
+	*phCcm = hCcm;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesCcmDestroy(CIPH_AES_CCM* hCcm)
+{
+	if (hCcm != NULL)
+	{
+		SecureZeroMemory(hCcm, sizeof(CIPH_AES_CCM));
+		CiphFree(hCcm);
+	}
+
+	return;
+}
+
+// CiphCcmCheck ֐
+// CCM  Nonce ̒ƁÃtB[h (15 - cbNonce oCg) ŕ\f[^̒
+static CIPH_STATUS CiphCcmCheck(const CIPH_AES_CCM* hCcm, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, const uint8_t* out, const uint8_t* Tag)
+{
+	CIPH_STATUS Status = CiphAeadCheck(hCcm, Nonce, cbNonce, AAD, cbAAD, in, cb, out, Tag);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (cbNonce < 7 || 13 < cbNonce || (cbNonce > 11 && ((ULONG64)cb >> (8 * (15 - cbNonce))) != 0))
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesCcmEncrypt(const CIPH_AES_CCM* hCcm, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, uint8_t* out, uint8_t* Tag)
+{
+	CIPH_STATUS Status = CiphCcmCheck(hCcm, Nonce, cbNonce, AAD, cbAAD, in, cb, out, Tag);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	AesCcmEncrypt((AES_CCM_CONTEXT*)&hCcm->Context, (BYTE*)Nonce, (DWORD)cbNonce, (BYTE*)AAD, (DWORD)cbAAD, (BYTE*)in, (DWORD)cb, out, Tag);
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesCcmDecrypt(const CIPH_AES_CCM* hCcm, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, const uint8_t* Tag, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCcmCheck(hCcm, Nonce, cbNonce, AAD, cbAAD, in, cb, out, Tag);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	if (!AesCcmDecrypt((AES_CCM_CONTEXT*)&hCcm->Context, (BYTE*)Nonce, (DWORD)cbNonce, (BYTE*)AAD, (DWORD)cbAAD, (BYTE*)in, (DWORD)cb, (BYTE*)Tag, out))
+	{
+		return CIPH_AUTHENTICATION_FAILED;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphDrbgEntropy ֐
+// GW̃Ggs[ (DRBG_ENTROPY_SOURCE) AnhɕێĂяo̊֐Ăяo
+static BOOL WINAPI CiphDrbgEntropy(PVOID pParam, BYTE* out, DWORD cbOut)
+{
+	CIPH_AES_DRBG* hDrbg = (CIPH_AES_DRBG*)pParam;
+
+	return hDrbg->Entropy(hDrbg->pUser, out, cbOut) != 0;
+}
+
+// CiphAesDrbgCreate ֐
+// Personalization ͎̒OɌ邽߁ACX^X̍쐬Ɏŝ̓Ggs[擾łȂꍇ݂̂ƂȂ
+CIPH_STATUS CIPH_CALL CiphAesDrbgCreate(size_t cbKey, uint32_t Flags, CIPH_ENTROPY_FUNCTION Entropy, void* pUser, const uint8_t* Personalization, size_t cbPersonalization, CIPH_AES_DRBG** phDrbg)
+{
+	AESBitLength BitLength;
+	CIPH_AES_DRBG* hDrbg;
+	BOOL bResult;
+
+	if (phDrbg == NULL || (cbPersonalization != 0 && Personalization == NULL))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+	if (cbPersonalization > cbKey + 16)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	hDrbg = (CIPH_AES_DRBG*)CiphAlloc(sizeof(CIPH_AES_DRBG));
+	if (hDrbg == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	hDrbg->Entropy = Entropy;
+	hDrbg->pUser = pUser;
+	if (Entropy != NULL)
+	{
+		bResult = AesCtrDrbgInstantiate(&hDrbg->Context, BitLength, CiphDrbgEntropy, hDrbg, (BYTE*)Personalization, (DWORD)cbPersonalization, (Flags & CIPH_DRBG_PREDICTION_RESISTANCE) != 0);
+	}
+	else
+	{
+		bResult = AesCtrDrbgInstantiate(&hDrbg->Context, BitLength, NULL, NULL, (BYTE*)Personalization, (DWORD)cbPersonalization, (Flags & CIPH_DRBG_PREDICTION_RESISTANCE) != 0);
+	}
+	if (!bResult)
+	{
+		CiphAesDrbgDestroy(hDrbg);
+		return CIPH_ENTROPY_FAILED;
+	}
+	*phDrbg = hDrbg;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesDrbgDestroy(CIPH_AES_DRBG* hDrbg)
+{
+	if (hDrbg != NULL)
+	{
+		AesCtrDrbgUninstantiate(&hDrbg->Context);
+		SecureZeroMemory(hDrbg, sizeof(CIPH_AES_DRBG));
+		CiphFree(hDrbg);
+	}
+
+	return;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesDrbgReseed(CIPH_AES_DRBG* hDrbg, const uint8_t* AddInput, size_t cbAddInput)
+{
+	if (hDrbg == NULL || (cbAddInput != 0 && AddInput == NULL))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (cbAddInput > hDrbg->Context.cbSeed)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	if (!AesCtrDrbgReseed(&hDrbg->Context, (BYTE*)AddInput, (DWORD)cbAddInput))
+	{
+		return CIPH_ENTROPY_FAILED;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesDrbgGenerate(CIPH_AES_DRBG* hDrbg, uint8_t* out, size_t cb, const uint8_t* AddInput, size_t cbAddInput)
+{
+	if (hDrbg == NULL || (cb != 0 && out == NULL) || (cbAddInput != 0 && AddInput == NULL))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (cbAddInput > hDrbg->Context.cbSeed)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	if (!AesCtrDrbgGenerate(&hDrbg->Context, out, cb, (BYTE*)AddInput, (DWORD)cbAddInput))
+	{
+		return CIPH_ENTROPY_FAILED;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphRandomBytes(uint8_t* out, size_t cb)
+{
+	if (cb != 0 && out == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	if (!AesRandomBytes(out, cb))
+	{
+		return CIPH_ENTROPY_FAILED;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesFf1Create(const uint8_t* Key, size_t cbKey, uint32_t Radix, const uint8_t* Tweak, size_t cbTweak, CIPH_AES_FF1** phFf1)
+{
+	AESBitLength BitLength;
+	CIPH_AES_FF1* hFf1;
+	BYTE Empty[1] = { 0 };
+
+	if (Key == NULL || phFf1 == NULL || (cbTweak != 0 && Tweak == NULL) || Radix < 2 || 65536 < Radix)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+	if (cbTweak > FF1_MAX_TWEAK)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	hFf1 = (CIPH_AES_FF1*)CiphAlloc(sizeof(CIPH_AES_FF1));
+	if (hFf1 == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesFf1Init((BYTE*)Key, BitLength, Radix, Tweak != NULL ? (BYTE*)Tweak : Empty, (DWORD)cbTweak, &hFf1->Context);
+	*phFf1 = hFf1;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesFf1Destroy(CIPH_AES_FF1* hFf1)
+{
+	if (hFf1 != NULL)
+	{
+		SecureZeroMemory(hFf1, sizeof(CIPH_AES_FF1));
+		CiphFree(hFf1);
+	}
+
+	return;
+}
+
+// CiphFf1Crypt ֐
+// ͎̐OɌ邽߁AGW FALSE Ԃ̂ Radix ȏ̐܂ޏꍇ݂̂ƂȂ
+static CIPH_STATUS CiphFf1Crypt(const CIPH_AES_FF1* hFf1, const uint16_t* in, size_t n, uint16_t* out, BOOL bEncrypt)
+{
+	BOOL bResult;
+
+	if (hFf1 == NULL || in == NULL || out == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (n < hFf1->Context.dwMinLen || FPE_MAX_LEN < n)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	if (bEncrypt)
+	{
+		bResult = AesFf1Encrypt((AES_FF1_CONTEXT*)&hFf1->Context, (WORD*)in, (DWORD)n, out);
+	}
+	else
+	{
+		bResult = AesFf1Decrypt((AES_FF1_CONTEXT*)&hFf1->Context, (WORD*)in, (DWORD)n, out);
+	}
+
+	return bResult ? CIPH_SUCCESS : CIPH_INVALID_DATA;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesFf1Encrypt(const CIPH_AES_FF1* hFf1, const uint16_t* in, size_t n, uint16_t* out)
+{
+	return CiphFf1Crypt(hFf1, in, n, out, TRUE);
+}
+
+CIPH_STATUS CIPH_CALL CiphAesFf1Decrypt(const CIPH_AES_FF1* hFf1, const uint16_t* in, size_t n, uint16_t* out)
+{
+	return CiphFf1Crypt(hFf1, in, n, out, FALSE);
+}
+
+CIPH_STATUS CIPH_CALL CiphAesFf3Create(const uint8_t* Key, size_t cbKey, uint32_t Radix, const uint8_t Tweak[7], CIPH_AES_FF3** phFf3)
+{
+	AESBitLength BitLength;
+	CIPH_AES_FF3* hFf3;
+
+	if (Key == NULL || Tweak == NULL || phFf3 == NULL || Radix < 2 || 65536 < Radix)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hFf3 = (CIPH_AES_FF3*)CiphAlloc(sizeof(CIPH_AES_FF3));
+	if (hFf3 == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesFf3Init((BYTE*)Key, BitLength, Radix, (BYTE*)Tweak, &hFf3->Context);
+	*phFf3 = hFf3;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesFf3Destroy(CIPH_AES_FF3* hFf3)
+{
+	if (hFf3 != NULL)
+	{
+		SecureZeroMemory(hFf3, sizeof(CIPH_AES_FF3));
+		CiphFree(hFf3);
+	}
+
+	return;
+}
+
+static CIPH_STATUS CiphFf3Crypt(const CIPH_AES_FF3* hFf3, const uint16_t* in, size_t n, uint16_t* out, BOOL bEncrypt)
+{
+	BOOL bResult;
+
+	if (hFf3 == NULL || in == NULL || out == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (n < hFf3->Context.dwMinLen || hFf3->Context.dwMaxLen < n)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	if (bEncrypt)
+	{
+		bResult = AesFf3Encrypt((AES_FF3_CONTEXT*)&hFf3->Context, (WORD*)in, (DWORD)n, out);
+	}
+	else
+	{
+		bResult = AesFf3Decrypt((AES_FF3_CONTEXT*)&hFf3->Context, (WORD*)in, (DWORD)n, out);
+	}
+
+	return bResult ? CIPH_SUCCESS : CIPH_INVALID_DATA;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesFf3Encrypt(const CIPH_AES_FF3* hFf3, const uint16_t* in, size_t n, uint16_t* out)
+{
+	return CiphFf3Crypt(hFf3, in, n, out, TRUE);
+}
+
+CIPH_STATUS CIPH_CALL CiphAesFf3Decrypt(const CIPH_AES_FF3* hFf3, const uint16_t* in, size_t n, uint16_t* out)
+{
+	return CiphFf3Crypt(hFf3, in, n, out, FALSE);
+}
+
+CIPH_STATUS CIPH_CALL CiphAesDukptCreateBdk(const uint8_t* Bdk, size_t cbBdk, CIPH_AES_DUKPT_BDK** phBdk)
+{
+	AESBitLength BitLength;
+	CIPH_AES_DUKPT_BDK* hBdk;
+
+	if (Bdk == NULL || phBdk == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbBdk, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hBdk = (CIPH_AES_DUKPT_BDK*)CiphAlloc(sizeof(CIPH_AES_DUKPT_BDK));
+	if (hBdk == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	AesDukptBdkSetup((BYTE*)Bdk, BitLength, &hBdk->Context);
+	*phBdk = hBdk;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphAesDukptDestroyBdk(CIPH_AES_DUKPT_BDK* hBdk)
+{
+	if (hBdk != NULL)
+	{
+		SecureZeroMemory(hBdk, sizeof(CIPH_AES_DUKPT_BDK));
+		CiphFree(hBdk);
+	}
+
+	return;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesDukptDeriveInitialKey(const CIPH_AES_DUKPT_BDK* hBdk, const uint8_t InitialKeyId[8], uint8_t* InitialKey)
+{
+	if (hBdk == NULL || InitialKeyId == NULL || InitialKey == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	AesDukptDeriveInitialKey((AES_DUKPT_BDK_CONTEXT*)&hBdk->Context, (BYTE*)InitialKeyId, InitialKey);
+
+	return CIPH_SUCCESS;
+}
+
+// CiphAesDukptDeriveKeys ֐
+// AesDukptDeriveBatch  KSN ̐ DWORD Ŏ󂯎邽߁ACIPH_CHUNK ɋ؂ēn
+CIPH_STATUS CIPH_CALL CiphAesDukptDeriveKeys(const CIPH_AES_DUKPT_BDK* hBdk, const uint8_t* Ksns, size_t nKsns, uint32_t Usage, uint32_t KeyType, uint8_t* Keys)
+{
+	size_t nCurrent, nChunk, cbKey;
+
+	if (hBdk == NULL || (nKsns != 0 && (Ksns == NULL || Keys == NULL)) || Usage > 0xFFFF || KeyType > CIPH_AES_DUKPT_KEY_AES256)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	cbKey = AesDukptKeyBits[KeyType] / 8;
+	for (nCurrent = 0; nCurrent < nKsns; nCurrent += nChunk)
+	{
+		nChunk = nKsns - nCurrent < CIPH_CHUNK ? nKsns - nCurrent : CIPH_CHUNK;
+		AesDukptDeriveBatch((AES_DUKPT_BDK_CONTEXT*)&hBdk->Context, (BYTE*)&Ksns[12 * nCurrent], (DWORD)nChunk, Usage, KeyType, &Keys[cbKey * nCurrent]);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphAesDukptDeriveKey ֐
+// [̓oԂꎞIɍ쐬 1 ̍ƌ𓱏oA
+CIPH_STATUS CIPH_CALL CiphAesDukptDeriveKey(const uint8_t* InitialKey, size_t cbInitialKey, const uint8_t Ksn[12], uint32_t Usage, uint32_t KeyType, uint8_t* Key)
+{
+	AESBitLength BitLength;
+	AES_DUKPT_CONTEXT Context;
+
+	if (InitialKey == NULL || Ksn == NULL || Key == NULL || Usage > 0xFFFF || KeyType > CIPH_AES_DUKPT_KEY_AES256)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbInitialKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	AesDukptInit((BYTE*)InitialKey, BitLength, (BYTE*)Ksn, &Context);
+	AesDukptDeriveKey(&Context, AesDukptCounter((BYTE*)Ksn), Usage, KeyType, Key);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphAesKcvBatch(const uint8_t* Keys, size_t cbKey, size_t nKeys, uint8_t* Kcvs, size_t cbKcv)
+{
+	AESBitLength BitLength;
+	size_t nCurrent, nChunk;
+
+	if ((nKeys != 0 && (Keys == NULL || Kcvs == NULL)) || cbKcv == 0 || cbKcv > 16)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (!CiphAesBitLength(cbKey, &BitLength))
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	for (nCurrent = 0; nCurrent < nKeys; nCurrent += nChunk)
+	{
+		nChunk = nKeys - nCurrent < CIPH_CHUNK ? nKeys - nCurrent : CIPH_CHUNK;
+		if (!AesKcvBatch((BYTE*)&Keys[cbKey * nCurrent], BitLength, (DWORD)nChunk, &Kcvs[cbKcv * nCurrent], (DWORD)cbKcv))
+		{
+			return CIPH_INVALID_PARAMETER;
+		}
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphTdeaCreateKey ֐
+// 8 oCǧ K1 = K2 = K3 (Keying Option 3)A16 oCǧ K3 = K1 (Keying Option 2) Ƃ TdeaKeySetup ɓn
+CIPH_STATUS CIPH_CALL CiphTdeaCreateKey(const uint8_t* Key, size_t cbKey, CIPH_TDEA_KEY** phKey)
+{
+	CIPH_TDEA_KEY* hKey;
+	BYTE* K = (BYTE*)Key;
+
+	if (Key == NULL || phKey == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (cbKey != 8 && cbKey != 16 && cbKey != 24)
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hKey = (CIPH_TDEA_KEY*)CiphAlloc(sizeof(CIPH_TDEA_KEY));
+	if (hKey == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	TdeaKeySetup(K, cbKey == 8 ? K : &K[8], cbKey == 24 ? &K[16] : K, &hKey->Context);
+	*phKey = hKey;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphTdeaDestroyKey(CIPH_TDEA_KEY* hKey)
+{
+	if (hKey != NULL)
+	{
+		SecureZeroMemory(hKey, sizeof(CIPH_TDEA_KEY));
+		CiphFree(hKey);
+	}
+
+	return;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaEcbEncrypt(const CIPH_TDEA_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 8);
+	size_t cbCurrent, cbChunk;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += cbChunk)
+	{
+		cbChunk = cb - cbCurrent < CIPH_CHUNK ? cb - cbCurrent : CIPH_CHUNK;
+		DesEcbCryptDispatch((DES_KEY_CONTEXT*)hKey->Context.Keys, hKey->Context.nKeys, (BYTE*)&in[cbCurrent], (DWORD)cbChunk, &out[cbCurrent], FALSE);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaEcbDecrypt(const CIPH_TDEA_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 8);
+	size_t cbCurrent, cbChunk;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += cbChunk)
+	{
+		cbChunk = cb - cbCurrent < CIPH_CHUNK ? cb - cbCurrent : CIPH_CHUNK;
+		DesEcbCryptDispatch((DES_KEY_CONTEXT*)hKey->Context.Keys, hKey->Context.nKeys, (BYTE*)&in[cbCurrent], (DWORD)cbChunk, &out[cbCurrent], TRUE);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphTdeaCbcEncrypt ֐
+// CBC ̈Í͑ÕubŇʂɈˑ邽߁A1 ubN
+CIPH_STATUS CIPH_CALL CiphTdeaCbcEncrypt(const CIPH_TDEA_KEY* hKey, const uint8_t IV[8], const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 8);
+	BYTE Block[8];
+	size_t cbCurrent;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (IV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	memcpy(Block, IV, 8);
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += 8)
+	{
+		Xor((BYTE*)&in[cbCurrent], Block, 8, Block);
+		TdeaCryptBlock((TDEA_KEY_CONTEXT*)&hKey->Context, Block, Block, FALSE);
+		memcpy(&out[cbCurrent], Block, 8);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphTdeaCbcDecrypt ֐
+// CIPH_CHUNK oCg DesCbcDecryptDispatch ĂяoA؂̍Ō̈ÍubN IV Ƃ
+CIPH_STATUS CIPH_CALL CiphTdeaCbcDecrypt(const CIPH_TDEA_KEY* hKey, const uint8_t IV[8], const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 8);
+	BYTE Prev[8], Next[8];
+	size_t cbCurrent, cbChunk;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (IV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	memcpy(Prev, IV, 8);
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += cbChunk)
+	{
+		cbChunk = cb - cbCurrent < CIPH_CHUNK ? cb - cbCurrent : CIPH_CHUNK;
+		memcpy(Next, &in[cbCurrent + cbChunk - 8], 8);
+		DesCbcDecryptDispatch((DES_KEY_CONTEXT*)hKey->Context.Keys, hKey->Context.nKeys, (BYTE*)&in[cbCurrent], (DWORD)cbChunk, Prev, &out[cbCurrent]);
+		memcpy(Prev, Next, 8);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphTdeaCtrCrypt ֐
+// DesCtrCryptDispatch  Offset e؂̃JE^vZ邽߁ACIPH_CHUNK oCg Offset i߂ČĂяo
+CIPH_STATUS CIPH_CALL CiphTdeaCtrCrypt(const CIPH_TDEA_KEY* hKey, const uint8_t ICV[8], uint64_t Offset, const uint8_t* in, size_t cb, uint8_t* out)
+{
+	CIPH_STATUS Status = CiphCheckBuffers(hKey, in, cb, out, 1);
+	size_t cbCurrent, cbChunk;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (ICV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	for (cbCurrent = 0; cbCurrent < cb; cbCurrent += cbChunk)
+	{
+		cbChunk = cb - cbCurrent < CIPH_CHUNK ? cb - cbCurrent : CIPH_CHUNK;
+		DesCtrCryptDispatch((DES_KEY_CONTEXT*)hKey->Context.Keys, hKey->Context.nKeys, (BYTE*)&in[cbCurrent], (DWORD)cbChunk, (BYTE*)ICV, Offset + cbCurrent, &out[cbCurrent]);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaEcbEncryptPkcs7(const CIPH_TDEA_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckPadded(hKey, CIPH_PADDING_PKCS7, in, cb, out, pcbOut, 8, FALSE);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	TdeaEcbEncryptPkcs7Context((TDEA_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, out);
+	*pcbOut = DesGetOutputLength((DWORD)cb, DES_PADDING_PKCS7);
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaEcbDecryptPkcs7(const CIPH_TDEA_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckPadded(hKey, CIPH_PADDING_PKCS7, in, cb, out, pcbOut, 8, TRUE);
+	DWORD cbOut;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+
+	if (!TdeaEcbDecryptPkcs7Context((TDEA_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, out, &cbOut))
+	{
+		return CIPH_INVALID_DATA;
+	}
+	*pcbOut = cbOut;
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaCbcEncryptPadded(const CIPH_TDEA_KEY* hKey, uint32_t Padding, const uint8_t IV[8], const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckPadded(hKey, Padding, in, cb, out, pcbOut, 8, FALSE);
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (IV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	if (Padding == CIPH_PADDING_PKCS7)
+	{
+		TdeaCbcEncryptPkcs7Context((TDEA_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, (BYTE*)IV, out);
+	}
+	else
+	{
+		TdeaCbcEncryptCtsContext((TDEA_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, (BYTE*)IV, Padding, out);
+	}
+	*pcbOut = DesGetOutputLength((DWORD)cb, Padding);
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaCbcDecryptPadded(const CIPH_TDEA_KEY* hKey, uint32_t Padding, const uint8_t IV[8], const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut)
+{
+	CIPH_STATUS Status = CiphCheckPadded(hKey, Padding, in, cb, out, pcbOut, 8, TRUE);
+	DWORD cbOut = (DWORD)cb;
+
+	if (Status != CIPH_SUCCESS)
+	{
+		return Status;
+	}
+	if (IV == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	if (Padding == CIPH_PADDING_PKCS7)
+	{
+		if (!TdeaCbcDecryptPkcs7Context((TDEA_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, (BYTE*)IV, out, &cbOut))
+		{
+			return CIPH_INVALID_DATA;
+		}
+	}
+	else
+	{
+		TdeaCbcDecryptCtsContext((TDEA_KEY_CONTEXT*)&hKey->Context, (BYTE*)in, (DWORD)cb, (BYTE*)IV, Padding, out);
+	}
+	*pcbOut = cbOut;
+
+	return CIPH_SUCCESS;
+}
+
+// CiphTdeaMacCreate ֐
+// Algorithm 3  Key  K || K' Ƃ DesMacInit ɓnAȊO 8 oCǧ DES (Key2, Key3  NULL)A16 oCǧ K3 = K1  TDEA Ƃ
+// CIPH_MAC_*  DES_MAC_* ƓlƂ
+CIPH_STATUS CIPH_CALL CiphTdeaMacCreate(const uint8_t* Key, size_t cbKey, uint32_t Algorithm, uint32_t Padding, CIPH_TDEA_MAC** phMac)
+{
+	CIPH_TDEA_MAC* hMac;
+	BYTE* K = (BYTE*)Key;
+
+	if (Key == NULL || phMac == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (Algorithm != CIPH_MAC_ALGORITHM1 && Algorithm != CIPH_MAC_ALGORITHM3 && Algorithm != CIPH_MAC_CMAC)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (Algorithm != CIPH_MAC_CMAC && Padding != CIPH_MAC_PADDING1 && Padding != CIPH_MAC_PADDING2)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (Algorithm == CIPH_MAC_ALGORITHM3 ? cbKey != 16 : cbKey != 8 && cbKey != 16 && cbKey != 24)
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hMac = (CIPH_TDEA_MAC*)CiphAlloc(sizeof(CIPH_TDEA_MAC));
+	if (hMac == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	if (Algorithm == CIPH_MAC_ALGORITHM3 || cbKey == 16)
+	{
+		DesMacInit(K, &K[8], K, Algorithm, Padding, &hMac->Context);
+	}
+	else if (cbKey == 24)
+	{
+		DesMacInit(K, &K[8], &K[16], Algorithm, Padding, &hMac->Context);
+	}
+	else
+	{
+		DesMacInit(K, NULL, NULL, Algorithm, Padding, &hMac->Context);
+	}
+	*phMac = hMac;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphTdeaMacDestroy(CIPH_TDEA_MAC* hMac)
+{
+	if (hMac != NULL)
+	{
+		SecureZeroMemory(hMac, sizeof(CIPH_TDEA_MAC));
+		CiphFree(hMac);
+	}
+
+	return;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaMac(const CIPH_TDEA_MAC* hMac, const uint8_t* in, size_t cb, uint8_t Mac[8])
+{
+	if (hMac == NULL || Mac == NULL || (cb != 0 && in == NULL))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if ((ULONG64)cb > 0xFFFFFFFF)
+	{
+		return CIPH_INVALID_LENGTH;
+	}
+
+	DesMac((DES_MAC_CONTEXT*)&hMac->Context, (BYTE*)in, (DWORD)cb, Mac);
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaDukptCreateBdk(const uint8_t* Bdk, size_t cbBdk, CIPH_TDEA_DUKPT_BDK** phBdk)
+{
+	CIPH_TDEA_DUKPT_BDK* hBdk;
+
+	if (Bdk == NULL || phBdk == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (cbBdk != 16)
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	hBdk = (CIPH_TDEA_DUKPT_BDK*)CiphAlloc(sizeof(CIPH_TDEA_DUKPT_BDK));
+	if (hBdk == NULL)
+	{
+		return CIPH_NO_MEMORY;
+	}
+	DukptBdkSetup((BYTE*)Bdk, &hBdk->Context);
+	*phBdk = hBdk;
+
+	return CIPH_SUCCESS;
+}
+
+void CIPH_CALL CiphTdeaDukptDestroyBdk(CIPH_TDEA_DUKPT_BDK* hBdk)
+{
+	if (hBdk != NULL)
+	{
+		SecureZeroMemory(hBdk, sizeof(CIPH_TDEA_DUKPT_BDK));
+		CiphFree(hBdk);
+	}
+
+	return;
+}
+
+CIPH_STATUS CIPH_CALL CiphTdeaDukptDeriveIpek(const CIPH_TDEA_DUKPT_BDK* hBdk, const uint8_t Ksn[10], uint8_t Ipek[16])
+{
+	if (hBdk == NULL || Ksn == NULL || Ipek == NULL)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	DukptDeriveIpek((DUKPT_BDK_CONTEXT*)&hBdk->Context, (BYTE*)Ksn, Ipek);
+
+	return CIPH_SUCCESS;
+}
+
+// CiphTdeaDukptDeriveKeys ֐
+// DukptDeriveBatch  KSN ̐ DWORD Ŏ󂯎邽߁ACIPH_CHUNK ɋ؂ēn
+CIPH_STATUS CIPH_CALL CiphTdeaDukptDeriveKeys(const CIPH_TDEA_DUKPT_BDK* hBdk, const uint8_t* Ksns, size_t nKsns, uint32_t Variant, uint8_t* Keys)
+{
+	size_t nCurrent, nChunk;
+
+	if (hBdk == NULL || (nKsns != 0 && (Ksns == NULL || Keys == NULL)) || Variant > CIPH_TDEA_DUKPT_VARIANT_DATA_RESPONSE)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	for (nCurrent = 0; nCurrent < nKsns; nCurrent += nChunk)
+	{
+		nChunk = nKsns - nCurrent < CIPH_CHUNK ? nKsns - nCurrent : CIPH_CHUNK;
+		DukptDeriveBatch((DUKPT_BDK_CONTEXT*)&hBdk->Context, (BYTE*)&Ksns[10 * nCurrent], (DWORD)nChunk, Variant, &Keys[16 * nCurrent]);
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// CiphTdeaDukptDeriveKey ֐
+// [̓oԂꎞIɍ쐬 1 ̍ƌ𓱏oA
+CIPH_STATUS CIPH_CALL CiphTdeaDukptDeriveKey(const uint8_t Ipek[16], const uint8_t Ksn[10], uint32_t Variant, uint8_t Key[16])
+{
+	DUKPT_CONTEXT Context;
+
+	if (Ipek == NULL || Ksn == NULL || Key == NULL || Variant > CIPH_TDEA_DUKPT_VARIANT_DATA_RESPONSE)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	DukptInit((BYTE*)Ipek, (BYTE*)Ksn, &Context);
+	DukptDeriveKey(&Context, DukptCounter((BYTE*)Ksn), Variant, Key);
+	SecureZeroMemory(&Context, sizeof(Context));
+
+	return CIPH_SUCCESS;
+}
+
+CIPH_STATUS CIPH_CALL CiphPinBlockEncode(const char* Pin, uint32_t Format, const char* Pan, uint8_t Block[8])
+{
+	if (Pin == NULL || Block == NULL || Format > CIPH_PIN_FORMAT_ISO3)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+
+	if (!PinBlockEncode((CHAR*)Pin, Format, (CHAR*)Pan, Block))
+	{
+		return CIPH_INVALID_DATA;
+	}
+
+	return CIPH_SUCCESS;
+}
+
+// 1  PinTranslateBatch ɓnő̃Wu
+#define CIPH_PIN_JOBS 4096
+
+// CiphPinTranslate ֐
+// PIN ubÑWu CIPH_PIN_JOBS 쐬 PinTranslateBatch ɓn (SẴWu͓ReLXgw)
+CIPH_STATUS CIPH_CALL CiphPinTranslate(const CIPH_TDEA_KEY* hSourceKey, uint32_t SourceFormat, const CIPH_TDEA_KEY* hDestinationKey, uint32_t DestinationFormat, const uint8_t* PinBlocks, const char* const* Pans, size_t nBlocks, uint8_t* out, uint8_t* Results)
+{
+	PIN_TRANSLATION_JOB* Jobs;
+	BOOL* pbResults;
+	size_t i, nCurrent, nChunk, nValid = 0;
+
+	if (hSourceKey == NULL || hDestinationKey == NULL || (nBlocks != 0 && (PinBlocks == NULL || out == NULL)))
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (SourceFormat > CIPH_PIN_FORMAT_ISO3 || DestinationFormat > CIPH_PIN_FORMAT_ISO3)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (nBlocks == 0)
+	{
+		return CIPH_SUCCESS;
+	}
+
+	Jobs = (PIN_TRANSLATION_JOB*)CiphAlloc(sizeof(PIN_TRANSLATION_JOB) * CIPH_PIN_JOBS);
+	pbResults = (BOOL*)CiphAlloc(sizeof(BOOL) * CIPH_PIN_JOBS);
+	if (Jobs == NULL || pbResults == NULL)
+	{
+		CiphFree(Jobs);
+		CiphFree(pbResults);
+		return CIPH_NO_MEMORY;
+	}
+
+	for (nCurrent = 0; nCurrent < nBlocks; nCurrent += nChunk)
+	{
+		nChunk = nBlocks - nCurrent < CIPH_PIN_JOBS ? nBlocks - nCurrent : CIPH_PIN_JOBS;
+		for (i = 0; i < nChunk; i++)
+		{
+			Jobs[i].pSourceKey = (TDEA_KEY_CONTEXT*)&hSourceKey->Context;
+			Jobs[i].pDestinationKey = (TDEA_KEY_CONTEXT*)&hDestinationKey->Context;
+			Jobs[i].PinBlock = (BYTE*)&PinBlocks[8 * (nCurrent + i)];
+			Jobs[i].Pan = Pans != NULL ? (CHAR*)Pans[nCurrent + i] : NULL;
+			Jobs[i].dwSourceFormat = SourceFormat;
+			Jobs[i].dwDestinationFormat = DestinationFormat;
+		}
+		nValid += PinTranslateBatch(Jobs, (DWORD)nChunk, &out[8 * nCurrent], pbResults);
+		if (Results != NULL)
+		{
+			for (i = 0; i < nChunk; i++)
+			{
+				Results[nCurrent + i] = pbResults[i] ? 1 : 0;
+			}
+		}
+	}
+
+	CiphFree(Jobs);
+	CiphFree(pbResults);
+
+	return nValid == nBlocks ? CIPH_SUCCESS : CIPH_INVALID_DATA;
+}
+
+CIPH_STATUS CIPH_CALL CiphDesKcvBatch(const uint8_t* Keys, size_t cbKey, size_t nKeys, uint8_t* Kcvs, size_t cbKcv)
+{
+	size_t nCurrent, nChunk;
+
+	if ((nKeys != 0 && (Keys == NULL || Kcvs == NULL)) || cbKcv == 0 || cbKcv > 8)
+	{
+		return CIPH_INVALID_PARAMETER;
+	}
+	if (cbKey != 8 && cbKey != 16 && cbKey != 24)
+	{
+		return CIPH_INVALID_KEY_LENGTH;
+	}
+
+	for (nCurrent = 0; nCurrent < nKeys; nCurrent += nChunk)
+	{
+		nChunk = nKeys - nCurrent < CIPH_CHUNK ? nKeys - nCurrent : CIPH_CHUNK;
+		if (!DesKcvBatch((BYTE*)&Keys[cbKey * nCurrent], (DWORD)cbKey, (DWORD)nChunk, &Kcvs[cbKcv * nCurrent], (DWORD)cbKcv))
+		{
+			return CIPH_INVALID_PARAMETER;
+		}
+	}
+
+	return CIPH_SUCCESS;
+}
+
+void* CIPH_CALL CiphBufferAlloc(size_t cb, uint32_t Flags)
+{
+	return CiphAllocEx(cb, (Flags & CIPH_BUFFER_NO_ZERO ? CIPH_ALLOC_NO_ZERO : 0) | (Flags & CIPH_BUFFER_LARGE_PAGES ? CIPH_ALLOC_LARGE_PAGES : 0));
+}
+
+void CIPH_CALL CiphBufferFree(void* p)
+{
+	CiphFree(p);
+
+	return;
+}
+
+void CIPH_CALL CiphBufferTrim(void)
+{
+	CiphAllocTrim();
+
+	return;
+}
+
+void CIPH_CALL CiphSetConcurrency(uint32_t nThreads)
+{
+	SetParallelConcurrency(nThreads);
+
+	return;
+}
+
+// CIPH_DISPATCH_*  CIPH_DISPATCH_KIND_*  DISPATCH_* ƓlƂ
+void CIPH_CALL CiphSetDispatch(uint32_t Strategy)
+{
+	SetDispatchMode(Strategy);
+
+	return;
+}
+
+void CIPH_CALL CiphSetDispatchThreshold(uint32_t Kind, size_t cbThreaded)
+{
+	SetDispatchThreshold(Kind, cbThreaded);
+
+	return;
+}
+
+size_t CIPH_CALL CiphGetDispatchThreshold(uint32_t Kind)
+{
+	return GetDispatchThreshold(Kind);
+}
+
+void CIPH_CALL CiphCalibrateDispatch(void)
+{
+	CalibrateDispatch();
+
+	return;
+}
+
+// CIPH_CALL  WINAPI ͓ĂяoKŁAsize_t  SIZE_T ͓傫̂ߊ֐|C^̂܂ܓn
+void CIPH_CALL CiphSetAllocator(CIPH_ALLOC_FUNCTION Alloc, CIPH_FREE_FUNCTION Free, void* pUser)
+{
+	CiphSetBackingAllocator((CIPH_BACKING_ALLOC)Alloc, (CIPH_BACKING_FREE)Free, pUser);
+
+	return;
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+// CiphLib : AES / DES / TDEA ̈ÍGW C C^[tF[X
+// ^͌Œ蕝̐^݂̂gAWindows.h ɂ͈ˑȂ
+// XPW[Ȃǂ̏Ԃ Create ֐ō쐬nh (sȌ^) ɕێADestroy ֐ŏĉ
+// nh͍쐬ɕύXȂ߁Anh𕡐̃Xbh瓯Ɏgpł (ɏԂXV CIPH_AES_DRBG )
+//
+// ÓICu (ciph_static) ͂̂܂܃NALCu (ciph_shared, CiphLib.dll) gꍇ CIPH_SHARED `
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(CIPH_SHARED)
+#if defined(_WIN32)
+#if defined(CIPH_EXPORTS)
+#define CIPH_API __declspec(dllexport)
+#else
+#define CIPH_API __declspec(dllimport)
+#endif
+#else
+#define CIPH_API __attribute__((visibility("default")))
+#endif
+#else
+#define CIPH_API
+#endif
+
+#if defined(_WIN32)
+#define CIPH_CALL __stdcall
+#else
+#define CIPH_CALL
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ߂l
+typedef int32_t CIPH_STATUS;
+
+#define CIPH_SUCCESS               0
+#define CIPH_INVALID_PARAMETER     1 // NULL ̃|C^Ȃ
+#define CIPH_INVALID_KEY_LENGTH    2 // ̃oCgs
+#define CIPH_INVALID_LENGTH        3 // f[^̃oCgubN̔{łȂȂ
+#define CIPH_AUTHENTICATION_FAILED 4 // F؃^OvȂ (o͂ 0 ŏ)
+#define CIPH_NO_MEMORY             5
+#define CIPH_INVALID_DATA          6 // pfBOAPIN ubNA̗Ȃǂ̓es
+#define CIPH_ENTROPY_FAILED        7 // Ggs[擾łȂ
+
+// nh
+typedef struct CIPH_AES_KEY_ CIPH_AES_KEY;   // AES ̌ReLXg
+typedef struct CIPH_AES_GCM_ CIPH_AES_GCM;   // AES-GCM ̃ReLXg
+typedef struct CIPH_AES_CMAC_ CIPH_AES_CMAC; // AES-CMAC ̃ReLXg
+typedef struct CIPH_AES_XTS_ CIPH_AES_XTS;   // AES-XTS ̃ReLXg
+typedef struct CIPH_AES_OCB_ CIPH_AES_OCB;   // AES-OCB3 ̃ReLXg
+typedef struct CIPH_AES_CCM_ CIPH_AES_CCM;   // AES-CCM ̃ReLXg
+typedef struct CIPH_AES_DRBG_ CIPH_AES_DRBG; // AES CTR_DRBG ̃CX^X
+typedef struct CIPH_AES_FF1_ CIPH_AES_FF1;   // FF1 ̃ReLXg
+typedef struct CIPH_AES_FF3_ CIPH_AES_FF3;   // FF3-1 ̃ReLXg
+typedef struct CIPH_AES_DUKPT_BDK_ CIPH_AES_DUKPT_BDK;   // AES DUKPT  BDK
+typedef struct CIPH_TDEA_KEY_ CIPH_TDEA_KEY; // DES / TDEA ̌ReLXg
+typedef struct CIPH_TDEA_MAC_ CIPH_TDEA_MAC; // DES / TDEA  MAC ̃ReLXg
+typedef struct CIPH_TDEA_DUKPT_BDK_ CIPH_TDEA_DUKPT_BDK; // TDEA DUKPT  BDK
+
+// AES
+//  16, 24, 32 oCg (AES-128, AES-192, AES-256)
+// ECB, CBC ̃f[^̓ubN (16 oCg) ̔{ƂApfBO͌Ăяoōs
+// CTR ̃JE^ ICV  128 rbg big endian ̐Ƃ݂ȂăubN 1 
+// Offset ̓f[^Ŝ̐擪̃oCgʒuŁAin, out ͂̈ʒu cb oCgw (擪珈ꍇ 0)
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCreateKey(const uint8_t* Key, size_t cbKey, CIPH_AES_KEY** phKey);
+CIPH_API void CIPH_CALL CiphAesDestroyKey(CIPH_AES_KEY* hKey);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesEcbEncrypt(const CIPH_AES_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesEcbDecrypt(const CIPH_AES_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCbcEncrypt(const CIPH_AES_KEY* hKey, const uint8_t IV[16], const uint8_t* in, size_t cb, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCbcDecrypt(const CIPH_AES_KEY* hKey, const uint8_t IV[16], const uint8_t* in, size_t cb, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCtrCrypt(const CIPH_AES_KEY* hKey, const uint8_t ICV[16], uint64_t Offset, const uint8_t* in, size_t cb, uint8_t* out);
+
+// pfBO (AES, DES / TDEA )
+// CIPH_PADDING_PKCS7  1 ` ubÑoCgtAÍ͕̎̃ubN̔{̃oCgƂȂ (ECB, CBC)
+// CIPH_PADDING_CS1 ` CS3  CBC ̈Íގ (NIST SP 800-38A Addendum) ŁAÍ͕ƓoCg (ubNȏ)
+// Í out ɂ͈Í̃oCgA out ɂ cb oCg̗̈悪KvŁA*pcbOut ɏo͂oCgԂ
+// ŃpfBOȂꍇ CIPH_INVALID_DATA ԂBf[^̒ 2^32 - 16 oCg
+#define CIPH_PADDING_PKCS7 1
+#define CIPH_PADDING_CS1   2
+#define CIPH_PADDING_CS2   3
+#define CIPH_PADDING_CS3   4
+
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesEcbEncryptPkcs7(const CIPH_AES_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesEcbDecryptPkcs7(const CIPH_AES_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCbcEncryptPadded(const CIPH_AES_KEY* hKey, uint32_t Padding, const uint8_t IV[16], const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCbcDecryptPadded(const CIPH_AES_KEY* hKey, uint32_t Padding, const uint8_t IV[16], const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+
+// AES bv (NIST SP 800-38F)BÍ CIPH_AES_KEY ̃nhg
+// CIPH_KEY_WRAP_KW  16 oCgȏ 8 ̔{ACIPH_KEY_WRAP_KWP  1 oCgȏ̃f[^bv
+// bv out ɂ cb + 8 oCg (KWP  cb  8 ̔{ɐ؂グ + 8 oCg)AAbv out ɂ cb - 8 oCg̗̈悪Kv
+// AbvŊS̊mFɎsꍇ CIPH_AUTHENTICATION_FAILED Ԃ (o͂ 0 ŏ)
+#define CIPH_KEY_WRAP_KW  0
+#define CIPH_KEY_WRAP_KWP 1
+
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesKeyWrap(const CIPH_AES_KEY* hKek, uint32_t Mode, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesKeyUnwrap(const CIPH_AES_KEY* hKek, uint32_t Mode, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+
+// AES-GCM
+// IV ͔Cӂ̒ ( 12 oCg)AF؃^O 16 oCg
+// IV, AAD, f[^̒͂ꂼ 2^32 oCg (ȏ CIPH_INVALID_LENGTH)
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesGcmCreate(const uint8_t* Key, size_t cbKey, CIPH_AES_GCM** phGcm);
+CIPH_API void CIPH_CALL CiphAesGcmDestroy(CIPH_AES_GCM* hGcm);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesGcmEncrypt(const CIPH_AES_GCM* hGcm, const uint8_t* IV, size_t cbIV, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, uint8_t* out, uint8_t Tag[16]);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesGcmDecrypt(const CIPH_AES_GCM* hGcm, const uint8_t* IV, size_t cbIV, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, const uint8_t Tag[16], uint8_t* out);
+
+// AES-CMAC (MAC  16 oCgAf[^̒ 2^32 oCg)
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCmacCreate(const uint8_t* Key, size_t cbKey, CIPH_AES_CMAC** phCmac);
+CIPH_API void CIPH_CALL CiphAesCmacDestroy(CIPH_AES_CMAC* hCmac);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCmac(const CIPH_AES_CMAC* hCmac, const uint8_t* in, size_t cb, uint8_t Mac[16]);
+
+// AES-XTS (IEEE 1619)
+//  Key1 || Key2  32, 48, 64 oCgAf[^ cbSector oCg (16 oCgȏ) ̃ZN^ nSectors ׂ
+// ZN^ԍ FirstSector  1 ₵AZN^͕ɏ
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesXtsCreate(const uint8_t* Key, size_t cbKey, CIPH_AES_XTS** phXts);
+CIPH_API void CIPH_CALL CiphAesXtsDestroy(CIPH_AES_XTS* hXts);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesXtsEncrypt(const CIPH_AES_XTS* hXts, uint64_t FirstSector, const uint8_t* in, size_t cbSector, size_t nSectors, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesXtsDecrypt(const CIPH_AES_XTS* hXts, uint64_t FirstSector, const uint8_t* in, size_t cbSector, size_t nSectors, uint8_t* out);
+
+// AES-OCB3 (RFC 7253)
+// F؃^O cbTag (1 ` 16) oCgANonce  1 ` 15 oCg
+// AAD, f[^̒͂ꂼ 2^32 oCg (ȏ CIPH_INVALID_LENGTH)
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesOcbCreate(const uint8_t* Key, size_t cbKey, size_t cbTag, CIPH_AES_OCB** phOcb);
+CIPH_API void CIPH_CALL CiphAesOcbDestroy(CIPH_AES_OCB* hOcb);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesOcbEncrypt(const CIPH_AES_OCB* hOcb, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, uint8_t* out, uint8_t* Tag);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesOcbDecrypt(const CIPH_AES_OCB* hOcb, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, const uint8_t* Tag, uint8_t* out);
+
+// AES-CCM (NIST SP 800-38C)
+// F؃^O cbTag (4 ` 16 ̋) oCgANonce  7 ` 13 oCg
+// f[^̒ 2^(8 * (15 - cbNonce)) oCg 2^32 oCgAAAD ̒ 2^32 oCg
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCcmCreate(const uint8_t* Key, size_t cbKey, size_t cbTag, CIPH_AES_CCM** phCcm);
+CIPH_API void CIPH_CALL CiphAesCcmDestroy(CIPH_AES_CCM* hCcm);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCcmEncrypt(const CIPH_AES_CCM* hCcm, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, uint8_t* out, uint8_t* Tag);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesCcmDecrypt(const CIPH_AES_CCM* hCcm, const uint8_t* Nonce, size_t cbNonce, const uint8_t* AAD, size_t cbAAD, const uint8_t* in, size_t cb, const uint8_t* Tag, uint8_t* out);
+
+// AES CTR_DRBG (NIST SP 800-90AAo֐Ȃ)
+// cbKey (16, 24, 32) ͓ AES ̌ŁAseedlen  cbKey + 16 oCg
+// Entropy  NULL ̏ꍇ OS ̗gBȊO Entropy(pUser, out, cb)  out  cb oCg݁Aꍇ 0 ȊOԂ
+// Personalization, AddInput  seedlen oCgȉ (NULL ł悢)BCIPH_DRBG_PREDICTION_RESISTANCE w肷ƐɍăV[h
+// ɓԂXV邽߁A CIPH_AES_DRBG 𕡐̃Xbh瓯ɎgpȂ (Xbhɍ쐬)
+// CiphRandomBytes ̓Xbh AES-256 CTR_DRBG (OS ̗ŃV[h) gÃXbh瓯ɌĂяo
+typedef int32_t (CIPH_CALL* CIPH_ENTROPY_FUNCTION)(void* pUser, uint8_t* out, size_t cb);
+
+#define CIPH_DRBG_PREDICTION_RESISTANCE 0x00000001
+
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesDrbgCreate(size_t cbKey, uint32_t Flags, CIPH_ENTROPY_FUNCTION Entropy, void* pUser, const uint8_t* Personalization, size_t cbPersonalization, CIPH_AES_DRBG** phDrbg);
+CIPH_API void CIPH_CALL CiphAesDrbgDestroy(CIPH_AES_DRBG* hDrbg);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesDrbgReseed(CIPH_AES_DRBG* hDrbg, const uint8_t* AddInput, size_t cbAddInput);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesDrbgGenerate(CIPH_AES_DRBG* hDrbg, uint8_t* out, size_t cb, const uint8_t* AddInput, size_t cbAddInput);
+CIPH_API CIPH_STATUS CIPH_CALL CiphRandomBytes(uint8_t* out, size_t cb);
+
+// ێÍ (NIST SP 800-38G  FF1, FF3-1)
+//  Radix (2 ` 65536) ̗̐ uint16_t ̔zŕ\A擪ŏʂ̐Ƃ (e Radix AȊO CIPH_INVALID_DATA)
+// ̐ n  Radix^n >= 1000000 𖞂AFF1  256 ȉAFF3-1  2 * floor(log_Radix(2^96))  256 ̏ȉ (ȊO CIPH_INVALID_LENGTH)
+// FF1 ̒l 0 ` 64 oCgAFF3-1 ̒l 7 oCg
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesFf1Create(const uint8_t* Key, size_t cbKey, uint32_t Radix, const uint8_t* Tweak, size_t cbTweak, CIPH_AES_FF1** phFf1);
+CIPH_API void CIPH_CALL CiphAesFf1Destroy(CIPH_AES_FF1* hFf1);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesFf1Encrypt(const CIPH_AES_FF1* hFf1, const uint16_t* in, size_t n, uint16_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesFf1Decrypt(const CIPH_AES_FF1* hFf1, const uint16_t* in, size_t n, uint16_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesFf3Create(const uint8_t* Key, size_t cbKey, uint32_t Radix, const uint8_t Tweak[7], CIPH_AES_FF3** phFf3);
+CIPH_API void CIPH_CALL CiphAesFf3Destroy(CIPH_AES_FF3* hFf3);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesFf3Encrypt(const CIPH_AES_FF3* hFf3, const uint16_t* in, size_t n, uint16_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesFf3Decrypt(const CIPH_AES_FF3* hFf3, const uint16_t* in, size_t n, uint16_t* out);
+
+// AES DUKPT (ANSI X9.24-3)
+// BDK Ə 16, 24, 32 oCg ()A̎ʎq 8 oCgAKSN  12 oCg (̎ʎq || 32 rbg̃JE^)
+// KeyType ͍ƌ̎ނŁAƌ 2TDEA, AES128  16 oCgA3TDEA, AES192  24 oCgAAES256  32 oCg
+// CiphAesDukptDeriveKeys ̓zXg nKsns  KSN (12 oCg) ̍ƌ𓱏oACiphAesDukptDeriveKey ͏ 1 ̍ƌ𓱏o
+#define CIPH_AES_DUKPT_KEY_2TDEA  0
+#define CIPH_AES_DUKPT_KEY_3TDEA  1
+#define CIPH_AES_DUKPT_KEY_AES128 2
+#define CIPH_AES_DUKPT_KEY_AES192 3
+#define CIPH_AES_DUKPT_KEY_AES256 4
+
+#define CIPH_AES_DUKPT_USAGE_KEY_ENCRYPTION   0x0002
+#define CIPH_AES_DUKPT_USAGE_PIN              0x1000
+#define CIPH_AES_DUKPT_USAGE_MAC_GENERATION   0x2000
+#define CIPH_AES_DUKPT_USAGE_MAC_VERIFICATION 0x2001
+#define CIPH_AES_DUKPT_USAGE_MAC_BOTH         0x2002
+#define CIPH_AES_DUKPT_USAGE_DATA_ENCRYPT     0x3000
+#define CIPH_AES_DUKPT_USAGE_DATA_DECRYPT     0x3001
+#define CIPH_AES_DUKPT_USAGE_DATA_BOTH        0x3002
+
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesDukptCreateBdk(const uint8_t* Bdk, size_t cbBdk, CIPH_AES_DUKPT_BDK** phBdk);
+CIPH_API void CIPH_CALL CiphAesDukptDestroyBdk(CIPH_AES_DUKPT_BDK* hBdk);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesDukptDeriveInitialKey(const CIPH_AES_DUKPT_BDK* hBdk, const uint8_t InitialKeyId[8], uint8_t* InitialKey);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesDukptDeriveKeys(const CIPH_AES_DUKPT_BDK* hBdk, const uint8_t* Ksns, size_t nKsns, uint32_t Usage, uint32_t KeyType, uint8_t* Keys);
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesDukptDeriveKey(const uint8_t* InitialKey, size_t cbInitialKey, const uint8_t Ksn[12], uint32_t Usage, uint32_t KeyType, uint8_t* Key);
+
+// AES ̌l
+// Keys ɂ cbKey oCǧ nKeys ׁAKcvs ɂ E_K(0) ̐擪 cbKcv (1 ` 16) oCg nKeys o
+CIPH_API CIPH_STATUS CIPH_CALL CiphAesKcvBatch(const uint8_t* Keys, size_t cbKey, size_t nKeys, uint8_t* Kcvs, size_t cbKcv);
+
+// DES / TDEA
+//  8 oCg (DES)A16 oCg (K1 || K2AK3 = K1  2-key TDEA)A24 oCg (K1 || K2 || K3) ̂ꂩ
+// ECB, CBC ̃f[^̓ubN (8 oCg) ̔{ƂACTR ̃JE^ ICV  64 rbg big endian ̐Ƃ݂Ȃ
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaCreateKey(const uint8_t* Key, size_t cbKey, CIPH_TDEA_KEY** phKey);
+CIPH_API void CIPH_CALL CiphTdeaDestroyKey(CIPH_TDEA_KEY* hKey);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaEcbEncrypt(const CIPH_TDEA_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaEcbDecrypt(const CIPH_TDEA_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaCbcEncrypt(const CIPH_TDEA_KEY* hKey, const uint8_t IV[8], const uint8_t* in, size_t cb, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaCbcDecrypt(const CIPH_TDEA_KEY* hKey, const uint8_t IV[8], const uint8_t* in, size_t cb, uint8_t* out);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaCtrCrypt(const CIPH_TDEA_KEY* hKey, const uint8_t ICV[8], uint64_t Offset, const uint8_t* in, size_t cb, uint8_t* out);
+
+// DES / TDEA ̃pfBO (CIPH_PADDING_*AubN 8 oCg)
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaEcbEncryptPkcs7(const CIPH_TDEA_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaEcbDecryptPkcs7(const CIPH_TDEA_KEY* hKey, const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaCbcEncryptPadded(const CIPH_TDEA_KEY* hKey, uint32_t Padding, const uint8_t IV[8], const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaCbcDecryptPadded(const CIPH_TDEA_KEY* hKey, uint32_t Padding, const uint8_t IV[8], const uint8_t* in, size_t cb, uint8_t* out, size_t* pcbOut);
+
+// DES / TDEA  MAC (ISO/IEC 9797-1, NIST SP 800-38B)
+// CIPH_MAC_ALGORITHM1 : CBC-MACB 8, 16, 24 oCg (CiphTdeaCreateKey Ɠ)
+// CIPH_MAC_ALGORITHM3 : e[ MAC (ANSI X9.19)B K || K'  16 oCg
+// CIPH_MAC_CMAC       : CMACB 8, 16, 24 oCgŁAPadding ͎gpȂ
+// Padding  CIPH_MAC_PADDING1 (0 Ŗ߂) ܂ CIPH_MAC_PADDING2 (0x80 tĂ 0 Ŗ߂)AMAC  8 oCg
+#define CIPH_MAC_ALGORITHM1 1
+#define CIPH_MAC_ALGORITHM3 3
+#define CIPH_MAC_CMAC       4
+
+#define CIPH_MAC_PADDING1 1
+#define CIPH_MAC_PADDING2 2
+
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaMacCreate(const uint8_t* Key, size_t cbKey, uint32_t Algorithm, uint32_t Padding, CIPH_TDEA_MAC** phMac);
+CIPH_API void CIPH_CALL CiphTdeaMacDestroy(CIPH_TDEA_MAC* hMac);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaMac(const CIPH_TDEA_MAC* hMac, const uint8_t* in, size_t cb, uint8_t Mac[8]);
+
+// TDEA DUKPT (ANSI X9.24-1:2009)
+// BDK, IPEK, ƌ 16 oCgAKSN  10 oCg ( 21 rbgJE^)
+// Variant ͍ƌ XOR }XN̎ (CIPH_TDEA_DUKPT_VARIANT_*)
+// CiphTdeaDukptDeriveKeys ̓zXg nKsns  KSN (10 oCg) ̍ƌ𓱏oACiphTdeaDukptDeriveKey  IPEK  1 ̍ƌ𓱏o
+#define CIPH_TDEA_DUKPT_VARIANT_NONE          0
+#define CIPH_TDEA_DUKPT_VARIANT_PIN           1
+#define CIPH_TDEA_DUKPT_VARIANT_MAC_REQUEST   2
+#define CIPH_TDEA_DUKPT_VARIANT_MAC_RESPONSE  3
+#define CIPH_TDEA_DUKPT_VARIANT_DATA_REQUEST  4
+#define CIPH_TDEA_DUKPT_VARIANT_DATA_RESPONSE 5
+
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaDukptCreateBdk(const uint8_t* Bdk, size_t cbBdk, CIPH_TDEA_DUKPT_BDK** phBdk);
+CIPH_API void CIPH_CALL CiphTdeaDukptDestroyBdk(CIPH_TDEA_DUKPT_BDK* hBdk);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaDukptDeriveIpek(const CIPH_TDEA_DUKPT_BDK* hBdk, const uint8_t Ksn[10], uint8_t Ipek[16]);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaDukptDeriveKeys(const CIPH_TDEA_DUKPT_BDK* hBdk, const uint8_t* Ksns, size_t nKsns, uint32_t Variant, uint8_t* Keys);
+CIPH_API CIPH_STATUS CIPH_CALL CiphTdeaDukptDeriveKey(const uint8_t Ipek[16], const uint8_t Ksn[10], uint32_t Variant, uint8_t Key[16]);
+
+// PIN ubN (ISO 9564-1 ̌` 0 ` 3)
+// Pin  4 ` 12 ̐̕APan  PAN ̕ (` 0, 3 ŎgpA` 1, 2 ł NULL ł悢)
+// CiphPinBlockEncode ͕ PIN ubN쐬 (PIN, PAN Ȃꍇ CIPH_INVALID_DATA)
+// CiphPinTranslate  hSourceKey ňÍꂽ nBlocks  PIN ubN (8 oCg) 𕡍A`ς hDestinationKey ňÍ
+// Pans  PIN ubN PAN (` 0, 3 gȂꍇ NULL ł悢)AResults  NULL łȂΕϊłubN 1AȊO 0 Ƃ
+// PIN tB[hȂubN out  0 ŏ CIPH_INVALID_DATA Ԃ (̑̃ubN͕ϊ)
+#define CIPH_PIN_FORMAT_ISO0 0
+#define CIPH_PIN_FORMAT_ISO1 1
+#define CIPH_PIN_FORMAT_ISO2 2
+#define CIPH_PIN_FORMAT_ISO3 3
+
+CIPH_API CIPH_STATUS CIPH_CALL CiphPinBlockEncode(const char* Pin, uint32_t Format, const char* Pan, uint8_t Block[8]);
+CIPH_API CIPH_STATUS CIPH_CALL CiphPinTranslate(const CIPH_TDEA_KEY* hSourceKey, uint32_t SourceFormat, const CIPH_TDEA_KEY* hDestinationKey, uint32_t DestinationFormat, const uint8_t* PinBlocks, const char* const* Pans, size_t nBlocks, uint8_t* out, uint8_t* Results);
+
+// DES / TDEA ̌l
+// Keys ɂ cbKey (8, 16, 24) oCǧ nKeys ׁAKcvs ɂ E_K(0) ̐擪 cbKcv (1 ` 8) oCg nKeys o
+CIPH_API CIPH_STATUS CIPH_CALL CiphDesKcvBatch(const uint8_t* Keys, size_t cbKey, size_t nKeys, uint8_t* Kcvs, size_t cbKcv);
+
+// Ɨ̈
+// CiphBufferAlloc  64 oCgEɑ cb oCg̗̈mۂ (mۂłȂꍇ NULL)
+// CIPH_BUFFER_NO_ZERO  0 ł̏Ȃ (Ŝ㏑o̓obt@Ȃ)ACIPH_BUFFER_LARGE_PAGES ͑傫ȗ̈[Wy[WŊmۂ
+// ̈̓Xbh̃A[iƃvZXŜ̃v[ɕێčėpACiphBufferTrim ŉʂ̃AP[^[ OS ɕԂ
+// CiphBufferFree ͓e 0 ŏĂ߂߁ACIPH_BUFFER_NO_ZERO Ŋmۂ̈ɂȑOɉ̈̓e͎cȂ
+#define CIPH_BUFFER_NO_ZERO     0x00000001
+#define CIPH_BUFFER_LARGE_PAGES 0x00000002
+
+CIPH_API void* CIPH_CALL CiphBufferAlloc(size_t cb, uint32_t Flags);
+CIPH_API void CIPH_CALL CiphBufferFree(void* p);
+CIPH_API void CIPH_CALL CiphBufferTrim(void);
+
+// 񏈗
+// CTR  XTS Ȃǂ̕񏈗ɎQXbh (ĂяõXbh܂) ̃vZXŜ̏ݒ肷
+// 0 ̏ꍇ͘_vZbTƂB[J[Xbh͑SĂ̌ĂяoŋL邽߁Aɑ̌ĂяoĂXbh͏𒴂Ȃ
+CIPH_API void CIPH_CALL CiphSetConcurrency(uint32_t nThreads);
+
+// s@̑I
+// ECB, CBC ̕, CTR ͓͂̃oCgɉāA1 ubN̏AubŇݏAXbhv[ł̕񏈗IɑI
+// 񏈗ɐ؂ւoCg (臒l) ̓GWƃ[hɁA󂯓n̎Ԃ 1 Xbh̏x𑪒肵Č߂
+//  CiphCalibrateDispatch, CiphSetConcurrency, CiphSetDispatch (CIPH_DISPATCH_AUTO) ōsAnh̍쐬f[^̏ɂ͍sȂ
+// O 1 MB 臒lƂ邽߁A CiphCalibrateDispatch ĂяoĂƂ悢 (񏈗ɎQSẴXbhgđ肷)
+// CiphSetDispatch ͎s@Œ肵ACiphSetDispatchThreshold 臒lw肷 (0 ͑肵lɖ߂ASIZE_MAX ͕񏈗I΂Ȃ)
+// CiphGetDispatchThreshold ݂͌臒lԂ (wĂȂꍇ 0)
+// ϐ CIPH_DISPATCH (serial, interleaved, threaded, auto ܂臒l̃oCg) łwł
+#define CIPH_DISPATCH_AUTO        0
+#define CIPH_DISPATCH_SERIAL      1
+#define CIPH_DISPATCH_INTERLEAVED 2
+#define CIPH_DISPATCH_THREADED    3
+
+#define CIPH_DISPATCH_KIND_AES_ECB          0
+#define CIPH_DISPATCH_KIND_AES_CBC_DECRYPT  1
+#define CIPH_DISPATCH_KIND_AES_CTR          2
+#define CIPH_DISPATCH_KIND_DES_ECB          3 // 1 iɏkނ (8 oCǧȂ)
+#define CIPH_DISPATCH_KIND_DES_CBC_DECRYPT  4
+#define CIPH_DISPATCH_KIND_DES_CTR          5
+#define CIPH_DISPATCH_KIND_TDEA_ECB         6
+#define CIPH_DISPATCH_KIND_TDEA_CBC_DECRYPT 7
+#define CIPH_DISPATCH_KIND_TDEA_CTR         8
+#define CIPH_DISPATCH_KIND_ALL              0xffffffff
+
+CIPH_API void CIPH_CALL CiphSetDispatch(uint32_t Strategy);
+CIPH_API void CIPH_CALL CiphSetDispatchThreshold(uint32_t Kind, size_t cbThreaded);
+CIPH_API size_t CIPH_CALL CiphGetDispatchThreshold(uint32_t Kind);
+CIPH_API void CIPH_CALL CiphCalibrateDispatch(void);
+
+// ʂ̃AP[^[
+// Alloc  cbAlign (2 ׂ̂) oCgEɑ cb oCg̗̈ԂAFree  Alloc Ŋmۂ̈
+// nhƗ̈mۂOɌĂяoBAlloc, Free  NULL w肷Ɗ (aligned malloc  OS ̃y[W) ɖ߂
+typedef void* (CIPH_CALL* CIPH_ALLOC_FUNCTION)(void* pUser, size_t cb, size_t cbAlign);
+typedef void (CIPH_CALL* CIPH_FREE_FUNCTION)(void* pUser, void* p, size_t cb);
+
+CIPH_API void CIPH_CALL CiphSetAllocator(CIPH_ALLOC_FUNCTION Alloc, CIPH_FREE_FUNCTION Free, void* pUser);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,124 @@
+#pragma once
+
+// vbgtH[ˑ
+// Windows ł Windows.h ̌^ API ̂܂܎gAȊOł͓Ǒ^ƍŏ̑ւ`
+// ÍGW (CiphAes.cpp, CiphDes.cpp) ͂̃wb_[݂̂ɈˑAWindows.h 𒼐 include Ȃ
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <bcrypt.h>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// ^̑傫 Windows (LLP64) ɍ킹ALONG, ULONG  32 rbgƂ
+// 64 rbǧ^ printf  %llx ƈv悤 long long Ƃ
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef int32_t BOOL;
+typedef int INT;
+typedef unsigned int UINT;
+typedef char CHAR;
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef long long LONG64;
+typedef unsigned long long ULONG64;
+typedef long long LONGLONG;
+typedef unsigned long long ULONGLONG;
+typedef size_t SIZE_T;
+typedef uintptr_t ULONG_PTR;
+typedef void* PVOID;
+typedef void* LPVOID;
+
+#define VOID void
+#define CONST const
+#define TRUE 1
+#define FALSE 0
+#define WINAPI
+#define __cdecl
+
+#define ZeroMemory(Destination, Length) memset((Destination), 0, (Length))
+
+// SecureZeroMemory ֐
+// œKŏȂȂ悤Avolatile ʂ 1 oCg 0 
+// ̃wb_[̊֐͊g߂ăRpCt@C (CiphAesNi.cpp, CiphDesAvx2.cpp) ɂ܂܂邽߁A
+// static ƂĖ|PʂƂɕʂ̎̂Ƃ (NɊg߂܂ގ̂ 1 ɂ܂Ƃ߂Ȃ悤ɂ)
+static inline PVOID SecureZeroMemory(PVOID ptr, SIZE_T cnt)
+{
+	volatile BYTE* p = (volatile BYTE*)ptr;
+
+	while (cnt != 0)
+	{
+		*p++ = 0;
+		cnt--;
+	}
+
+	return ptr;
+}
+#endif
+
+// x86 ̊g (SSSE3, SSE4.1, AES-NI, PCLMULQDQ, AVX2) gLɂ邩
+// gݍ݊֐g֐ CiphAesNi.cpp  CiphDesAvx2.cpp ɂ܂Ƃ߁As GetCpuFeatures Ŕ肵ĂĂяo
+// ̃t@C̖͊߃ZbgŃRpC邽߁A̖߂ɑΉĂȂ CPU łCugpł
+// MSVC ͖߃Zbgw肵ȂĂgݍ݊֐gpł邽ߏɗLƂ
+// GCC / Clang  CIPH_SIMD `ꍇ (CMake  CIPH_SIMD IvV) ɗLƂA2 ̃t@Ĉ݂ -maes -mavx2 Ȃǂw肷
+#if defined(_M_IX86) || defined(_M_X64)
+#define CIPH_X86
+#if defined(_M_X64)
+#define CIPH_X64
+#endif
+#elif (defined(__i386__) || defined(__x86_64__)) && defined(CIPH_SIMD)
+#define CIPH_X86
+#if defined(__x86_64__)
+#define CIPH_X64
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(CIPH_X86)
+#include <cpuid.h>
+#include <immintrin.h>
+
+// MSVC  __cpuid, __cpuidex, _xgetbv Ɠ`̊֐
+// _xgetbv  XSAVE ȂƃRpCłȂ߁AXGETBV ߂𒼐ڋLq
+static inline VOID CiphCpuidex(INT CpuInfo[4], INT Function, INT SubFunction)
+{
+	__cpuid_count(Function, SubFunction, CpuInfo[0], CpuInfo[1], CpuInfo[2], CpuInfo[3]);
+}
+
+static inline ULONG64 CiphXgetbv(UINT Xcr)
+{
+	DWORD Low, High;
+
+	__asm__ __volatile__("xgetbv" : "=a"(Low), "=d"(High) : "c"(Xcr));
+
+	return ((ULONG64)High << 32) | Low;
+}
+
+#undef __cpuid
+#define __cpuid(CpuInfo, Function) CiphCpuidex((CpuInfo), (Function), 0)
+#define __cpuidex CiphCpuidex
+#define _xgetbv CiphXgetbv
+#endif
+
+#if !defined(_MSC_VER)
+// _rotl, _rotr ֐
+// 32 rbgl̃[e[g (MSVC ̑gݍ݊֐Ɠ)
+static inline UINT CiphRotl(UINT Value, INT Shift)
+{
+	return (Value << (Shift & 31)) | (Value >> (-Shift & 31));
+}
+
+static inline UINT CiphRotr(UINT Value, INT Shift)
+{
+	return (Value >> (Shift & 31)) | (Value << (-Shift & 31));
+}
+
+#undef _rotl
+#undef _rotr
+#define _rotl CiphRotl
+#define _rotr CiphRotr
+#endif
@@ -0,0 +1,733 @@
+#include "CiphLib.h"
+#include <stdio.h>
+#include <string.h>
+
+// CiphLib  C C^[tF[X (CiphLib.h) ̃eXg
+// LCu (ciph_shared) ݂̂NACiphLib.h ŌJ֐pĊm̒lƈv邩mF
+// m̒l̃Tv CiphAesCrypt, CiphDesCrypt ̊e Example Ɠ
+// vȂڂꍇ 1 Ԃ (ctest s)
+
+// vȂڂ̐
+static int nFailures = 0;
+
+// ParseHex ֐
+// 16 i̕oCgɕϊAoCgԂ (󔒂͓ǂݔ΂)
+static size_t ParseHex(const char* Hex, uint8_t* out)
+{
+	size_t cb = 0;
+	int nDigits = 0;
+	uint8_t Value = 0;
+
+	for (; *Hex != '\0'; Hex++)
+	{
+		if (*Hex == ' ')
+		{
+			continue;
+		}
+		Value = (uint8_t)(Value << 4);
+		if ('0' <= *Hex && *Hex <= '9')
+		{
+			Value |= (uint8_t)(*Hex - '0');
+		}
+		else if ('a' <= *Hex && *Hex <= 'f')
+		{
+			Value |= (uint8_t)(*Hex - 'a' + 10);
+		}
+		else if ('A' <= *Hex && *Hex <= 'F')
+		{
+			Value |= (uint8_t)(*Hex - 'A' + 10);
+		}
+		if (++nDigits == 2)
+		{
+			out[cb++] = Value;
+			nDigits = 0;
+			Value = 0;
+		}
+	}
+
+	return cb;
+}
+
+// ParseNumerals ֐
+// 0-9, a-z ̕ 36 ܂ł̗̐ɕϊA̐Ԃ (FF1, FF3-1 Ŏgp)
+static size_t ParseNumerals(const char* Text, uint16_t* out)
+{
+	size_t n;
+
+	for (n = 0; Text[n] != '\0'; n++)
+	{
+		out[n] = (uint16_t)('0' <= Text[n] && Text[n] <= '9' ? Text[n] - '0' : Text[n] - 'a' + 10);
+	}
+
+	return n;
+}
+
+// CheckBytes ֐
+// o͂҂l (16 i̕) ƈv邩mFČʂ\
+static void CheckBytes(const char* Name, const uint8_t* Actual, size_t cb, const char* Expected)
+{
+	uint8_t Bytes[256];
+	size_t cbExpected = ParseHex(Expected, Bytes);
+	int bMatch = cbExpected == cb && memcmp(Actual, Bytes, cb) == 0;
+
+	printf("%-25s = %s\r\n", Name, bMatch ? "match" : "mismatch");
+	if (!bMatch)
+	{
+		nFailures++;
+	}
+
+	return;
+}
+
+// CheckStatus ֐
+// ֐̖߂l҂lƈv邩mFČʂ\
+static void CheckStatus(const char* Name, CIPH_STATUS Status, CIPH_STATUS Expected)
+{
+	printf("%-25s = %d (%s)\r\n", Name, Status, Status == Expected ? "match" : "mismatch");
+	if (Status != Expected)
+	{
+		nFailures++;
+	}
+
+	return;
+}
+
+// CheckTrue ֐
+// 藧mFČʂ\ (̈vȂ)
+static void CheckTrue(const char* Name, int bCondition)
+{
+	printf("%-25s = %s\r\n", Name, bCondition ? "match" : "mismatch");
+	if (!bCondition)
+	{
+		nFailures++;
+	}
+
+	return;
+}
+
+// FixedEntropy ֐
+// pUser ̃oCg擪ԂGgs[ (CTR_DRBG ̊m̒lmF邽߂Ɏgp)
+static int32_t CIPH_CALL FixedEntropy(void* pUser, uint8_t* out, size_t cb)
+{
+	memcpy(out, pUser, cb);
+
+	return 1;
+}
+
+// FailingEntropy ֐
+// ɎsGgs[
+static int32_t CIPH_CALL FailingEntropy(void* pUser, uint8_t* out, size_t cb)
+{
+	(void)pUser;
+	(void)out;
+	(void)cb;
+
+	return 0;
+}
+
+// TestAesModes ֐
+// ECB, CBC, CTR (SP 800-38A F.1.1, F.2.1, F.5.1)  CMAC (SP 800-38B D.1)
+static void TestAesModes(void)
+{
+	uint8_t Key[16], IV[16], ICV[16], in[64], cipher[64], out[64], Mac[16];
+	CIPH_AES_KEY* hKey;
+	CIPH_AES_CMAC* hCmac;
+
+	ParseHex("2b7e151628aed2a6abf7158809cf4f3c", Key);
+	ParseHex("000102030405060708090a0b0c0d0e0f", IV);
+	ParseHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff", ICV);
+	ParseHex("6bc1bee22e409f96e93d7e117393172a ae2d8a571e03ac9c9eb76fac45af8e51 30c81c46a35ce411e5fbc1191a0a52ef f69f2445df4f9b17ad2b417be66c3710", in);
+
+	CheckStatus("Create (AES)", CiphAesCreateKey(Key, 16, &hKey), CIPH_SUCCESS);
+	CheckStatus("Create (CMAC)", CiphAesCmacCreate(Key, 16, &hCmac), CIPH_SUCCESS);
+
+	CiphAesEcbEncrypt(hKey, in, 64, cipher);
+	CheckBytes("AES-ECB", cipher, 64, "3ad77bb40d7a3660a89ecaf32466ef97 f5d3d58503b9699de785895a96fdbaaf 43b1cd7f598ece23881b00e3ed030688 7b0c785e27e8ad3f8223207104725dd4");
+	CiphAesEcbDecrypt(hKey, cipher, 64, out);
+	CheckTrue("AES-ECB (Decrypt)", memcmp(out, in, 64) == 0);
+
+	CiphAesCbcEncrypt(hKey, IV, in, 64, cipher);
+	CheckBytes("AES-CBC", cipher, 64, "7649abac8119b246cee98e9b12e9197d 5086cb9b507219ee95db113a917678b2 73bed6b8e3c1743b7116e69e22229516 3ff1caa1681fac09120eca307586e1a7");
+	CiphAesCbcDecrypt(hKey, IV, cipher, 64, out);
+	CheckTrue("AES-CBC (Decrypt)", memcmp(out, in, 64) == 0);
+
+	// CTR ͓r̃oCgʒu (Offset) 珈ʂmF
+	CiphAesCtrCrypt(hKey, ICV, 0, in, 64, cipher);
+	CheckBytes("AES-CTR", cipher, 64, "874d6191b620e3261bef6864990db6ce 9806f66b7970fdff8617187bb9fffdff 5ae4df3edbd5d35e5b4f09020db03eab 1e031dda2fbe03d1792170a0f3009cee");
+	CiphAesCtrCrypt(hKey, ICV, 37, &in[37], 27, out);
+	CheckTrue("AES-CTR (Offset 37)", memcmp(out, &cipher[37], 27) == 0);
+
+	CiphAesCmac(hCmac, in, 0, Mac);
+	CheckBytes("AES-CMAC (0 bytes)", Mac, 16, "bb1d6929e95937287fa37d129b756746");
+	CiphAesCmac(hCmac, in, 64, Mac);
+	CheckBytes("AES-CMAC (64 bytes)", Mac, 16, "51f0bebf7e3b9d92fc49741779363cfe");
+
+	CheckStatus("AES-ECB (15 bytes)", CiphAesEcbEncrypt(hKey, in, 15, cipher), CIPH_INVALID_LENGTH);
+	CheckStatus("Create (AES, 20 bytes)", CiphAesCreateKey(Key, 20, &hKey), CIPH_INVALID_KEY_LENGTH);
+
+	CiphAesCmacDestroy(hCmac);
+	CiphAesDestroyKey(hKey);
+
+	return;
+}
+
+// TestAesPadding ֐
+// PKCS#7 pfBOƈÍގ (CBC-CS1/CS2/CS3)
+//  "chicken teriyaki"AIV  0 (RFC 3962 ̗)
+static void TestAesPadding(void)
+{
+	uint8_t Key[16], IV[16] = { 0 }, in[32], cipher[48], out[48];
+	size_t cbIn, cbCipher, cbOut;
+	CIPH_AES_KEY* hKey;
+
+	memcpy(Key, "chicken teriyaki", 16);
+	CiphAesCreateKey(Key, 16, &hKey);
+
+	cbIn = ParseHex("4920776f756c64206c696b652074686520", in);
+	CheckStatus("ECB-P7", CiphAesEcbEncryptPkcs7(hKey, in, cbIn, cipher, &cbCipher), CIPH_SUCCESS);
+	CheckBytes("ECB-P7 (Cipher Text)", cipher, cbCipher, "97687268d6ecccc0c07b25e25ecfe584 b617cc075da7f5682cbce9921e84f830");
+	CiphAesEcbDecryptPkcs7(hKey, cipher, cbCipher, out, &cbOut);
+	CheckTrue("ECB-P7 (Decrypt)", cbOut == cbIn && memcmp(out, in, cbIn) == 0);
+
+	CiphAesCbcEncryptPadded(hKey, CIPH_PADDING_CS1, IV, in, cbIn, cipher, &cbCipher);
+	CheckBytes("CBC-CS1", cipher, cbCipher, "97c6353568f2bf8cb4d8a580362da7ff7f");
+	CiphAesCbcDecryptPadded(hKey, CIPH_PADDING_CS1, IV, cipher, cbCipher, out, &cbOut);
+	CheckTrue("CBC-CS1 (Decrypt)", cbOut == cbIn && memcmp(out, in, cbIn) == 0);
+
+	CiphAesCbcEncryptPadded(hKey, CIPH_PADDING_CS3, IV, in, cbIn, cipher, &cbCipher);
+	CheckBytes("CBC-CS3", cipher, cbCipher, "c6353568f2bf8cb4d8a580362da7ff7f97");
+
+	cbIn = ParseHex("4920776f756c64206c696b6520746865 2047656e6572616c20476175277320", in);
+	CiphAesCbcEncryptPadded(hKey, CIPH_PADDING_PKCS7, IV, in, cbIn, cipher, &cbCipher);
+	CheckBytes("CBC-P7", cipher, cbCipher, "97687268d6ecccc0c07b25e25ecfe584 e480280dc4eb56da3366eb05d313878c");
+	CiphAesCbcDecryptPadded(hKey, CIPH_PADDING_PKCS7, IV, cipher, cbCipher, out, &cbOut);
+	CheckTrue("CBC-P7 (Decrypt)", cbOut == cbIn && memcmp(out, in, cbIn) == 0);
+
+	CiphAesCbcEncryptPadded(hKey, CIPH_PADDING_CS2, IV, in, cbIn, cipher, &cbCipher);
+	CheckBytes("CBC-CS2", cipher, cbCipher, "fc00783e0efdb2c1d445d4c8eff7ed22 97687268d6ecccc0c07b25e25ecfe5");
+	CiphAesCbcDecryptPadded(hKey, CIPH_PADDING_CS2, IV, cipher, cbCipher, out, &cbOut);
+	CheckTrue("CBC-CS2 (Decrypt)", cbOut == cbIn && memcmp(out, in, cbIn) == 0);
+
+	// pfBOtɈÍÍ́ApfBOsȂ CIPH_INVALID_DATA Ԃ
+	CiphAesEcbEncrypt(hKey, in, 16, cipher);
+	CheckStatus("ECB-P7 (Bad Padding)", CiphAesEcbDecryptPkcs7(hKey, cipher, 16, out, &cbOut), CIPH_INVALID_DATA);
+	CheckStatus("CBC-CS1 (15 bytes)", CiphAesCbcEncryptPadded(hKey, CIPH_PADDING_CS1, IV, in, 15, cipher, &cbCipher), CIPH_INVALID_LENGTH);
+
+	CiphAesDestroyKey(hKey);
+
+	return;
+}
+
+// TestAesKeyWrap ֐
+// bv KW (RFC 3394 4.1)  KWP (RFC 5649 6)
+static void TestAesKeyWrap(void)
+{
+	uint8_t Kek[24], in[24], Wrapped[40], out[40];
+	size_t cbIn, cbWrapped, cbOut;
+	CIPH_AES_KEY* hKek;
+
+	ParseHex("000102030405060708090a0b0c0d0e0f", Kek);
+	CiphAesCreateKey(Kek, 16, &hKek);
+	cbIn = ParseHex("00112233445566778899aabbccddeeff", in);
+	CiphAesKeyWrap(hKek, CIPH_KEY_WRAP_KW, in, cbIn, Wrapped, &cbWrapped);
+	CheckBytes("KW", Wrapped, cbWrapped, "1fa68b0a8112b447aef34bd8fb5a7b829d3e862371d2cfe5");
+	CiphAesKeyUnwrap(hKek, CIPH_KEY_WRAP_KW, Wrapped, cbWrapped, out, &cbOut);
+	CheckTrue("KW (Unwrap)", cbOut == cbIn && memcmp(out, in, cbIn) == 0);
+	Wrapped[0] ^= 1;
+	CheckStatus("KW (Tampered)", CiphAesKeyUnwrap(hKek, CIPH_KEY_WRAP_KW, Wrapped, cbWrapped, out, &cbOut), CIPH_AUTHENTICATION_FAILED);
+	CiphAesDestroyKey(hKek);
+
+	ParseHex("5840df6e29b02af1ab493b705bf16ea1ae8338f4dcc176a8", Kek);
+	CiphAesCreateKey(Kek, 24, &hKek);
+	cbIn = ParseHex("c37b7e6492584340bed12207808941155068f738", in);
+	CiphAesKeyWrap(hKek, CIPH_KEY_WRAP_KWP, in, cbIn, Wrapped, &cbWrapped);
+	CheckBytes("KWP (20 bytes)", Wrapped, cbWrapped, "138bdeaa9b8fa7fc61f97742e72248ee5ae6ae5360d1ae6a5f54f373fa543b6a");
+	CiphAesKeyUnwrap(hKek, CIPH_KEY_WRAP_KWP, Wrapped, cbWrapped, out, &cbOut);
+	CheckTrue("KWP (Unwrap)", cbOut == cbIn && memcmp(out, in, cbIn) == 0);
+	cbIn = ParseHex("466f7250617369", in);
+	CiphAesKeyWrap(hKek, CIPH_KEY_WRAP_KWP, in, cbIn, Wrapped, &cbWrapped);
+	CheckBytes("KWP (7 bytes)", Wrapped, cbWrapped, "afbeb0f07dfbf5419200f2ccb50bb24f");
+	CiphAesDestroyKey(hKek);
+
+	return;
+}
+
+// TestAesGcm ֐
+// GCM (McGrew, Viega  Test Case 2)
+static void TestAesGcm(void)
+{
+	uint8_t Key[16] = { 0 }, IV[12] = { 0 }, in[16] = { 0 }, cipher[16], out[16], Tag[16];
+	CIPH_AES_GCM* hGcm;
+
+	CiphAesGcmCreate(Key, 16, &hGcm);
+	CiphAesGcmEncrypt(hGcm, IV, 12, NULL, 0, in, 16, cipher, Tag);
+	CheckBytes("GCM", cipher, 16, "0388dace60b6a392f328c2b971b2fe78");
+	CheckBytes("GCM (Tag)", Tag, 16, "ab6e47d42cec13bdf53a67b21257bddf");
+	CheckStatus("GCM (Decrypt)", CiphAesGcmDecrypt(hGcm, IV, 12, NULL, 0, cipher, 16, Tag, out), CIPH_SUCCESS);
+	Tag[15] ^= 1;
+	CheckStatus("GCM (Tampered)", CiphAesGcmDecrypt(hGcm, IV, 12, NULL, 0, cipher, 16, Tag, out), CIPH_AUTHENTICATION_FAILED);
+	CiphAesGcmDestroy(hGcm);
+
+	return;
+}
+
+// TestAesXts ֐
+// XTS (IEEE 1619  Vector 1, 2)
+// 2 ZN^܂Ƃ߂ďʂAZN^ɏʂƈv邩mF
+static void TestAesXts(void)
+{
+	uint8_t Key[32] = { 0 }, in[64] = { 0 }, cipher[64], out[64];
+	CIPH_AES_XTS* hXts;
+
+	CheckStatus("Create (XTS)", CiphAesXtsCreate(Key, 32, &hXts), CIPH_SUCCESS);
+	CiphAesXtsEncrypt(hXts, 0, in, 32, 1, cipher);
+	CheckBytes("XTS (Vector 1)", cipher, 32, "917cf69ebd68b2ec9b9fe9a3eadda692cd43d2f59598ed858c02c2652fbf922e");
+	CiphAesXtsDestroy(hXts);
+
+	memset(Key, 0x11, 16);
+	memset(&Key[16], 0x22, 16);
+	memset(in, 0x44, 64);
+	CiphAesXtsCreate(Key, 32, &hXts);
+	CiphAesXtsEncrypt(hXts, 0x3333333333, in, 32, 2, cipher);
+	CheckBytes("XTS (Vector 2)", cipher, 32, "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0");
+	CiphAesXtsEncrypt(hXts, 0x3333333334, in, 32, 1, out);
+	CheckTrue("XTS (Next Sector)", memcmp(out, &cipher[32], 32) == 0);
+	CiphAesXtsDecrypt(hXts, 0x3333333333, cipher, 32, 2, out);
+	CheckTrue("XTS (Decrypt)", memcmp(out, in, 64) == 0);
+	CheckStatus("XTS (15 bytes)", CiphAesXtsEncrypt(hXts, 0, in, 15, 1, cipher), CIPH_INVALID_LENGTH);
+	CiphAesXtsDestroy(hXts);
+
+	CheckStatus("Create (XTS, 40 bytes)", CiphAesXtsCreate(Key, 40, &hXts), CIPH_INVALID_KEY_LENGTH);
+
+	return;
+}
+
+// TestAesOcb ֐
+// OCB3 (RFC 7253 Appendix A)
+static void TestAesOcb(void)
+{
+	uint8_t Key[16], Nonce[12], AAD[8], in[40], cipher[40], out[40], Tag[16];
+	CIPH_AES_OCB* hOcb;
+
+	ParseHex("000102030405060708090a0b0c0d0e0f", Key);
+	CheckStatus("Create (OCB)", CiphAesOcbCreate(Key, 16, 16, &hOcb), CIPH_SUCCESS);
+
+	ParseHex("bbaa99887766554433221100", Nonce);
+	CiphAesOcbEncrypt(hOcb, Nonce, 12, NULL, 0, NULL, 0, cipher, Tag);
+	CheckBytes("OCB (Empty)", Tag, 16, "785407bfffc8ad9edcc5520ac9111ee6");
+
+	ParseHex("bbaa99887766554433221101", Nonce);
+	ParseHex("0001020304050607", AAD);
+	ParseHex("0001020304050607", in);
+	CiphAesOcbEncrypt(hOcb, Nonce, 12, AAD, 8, in, 8, cipher, Tag);
+	CheckBytes("OCB (8 bytes)", cipher, 8, "6820b3657b6f615a");
+	CheckBytes("OCB (8 bytes, Tag)", Tag, 16, "5725bda0d3b4eb3a257c9af1f8f03009");
+
+	ParseHex("bbaa9988776655443322110f", Nonce);
+	for (int i = 0; i < 40; i++)
+	{
+		in[i] = (uint8_t)i;
+	}
+	CiphAesOcbEncrypt(hOcb, Nonce, 12, NULL, 0, in, 40, cipher, Tag);
+	CheckBytes("OCB (40 bytes)", cipher, 40, "4412923493c57d5de0d700f753cce0d1d2d95060122e9f15a5ddbfc5787e50b5cc55ee507bcb084e");
+	CheckBytes("OCB (40 bytes, Tag)", Tag, 16, "479ad363ac366b95a98ca5f3000b1479");
+	CheckStatus("OCB (Decrypt)", CiphAesOcbDecrypt(hOcb, Nonce, 12, NULL, 0, cipher, 40, Tag, out), CIPH_SUCCESS);
+	CheckTrue("OCB (Output)", memcmp(out, in, 40) == 0);
+	cipher[0] ^= 1;
+	CheckStatus("OCB (Tampered)", CiphAesOcbDecrypt(hOcb, Nonce, 12, NULL, 0, cipher, 40, Tag, out), CIPH_AUTHENTICATION_FAILED);
+
+	CiphAesOcbDestroy(hOcb);
+
+	return;
+}
+
+// TestAesCcm ֐
+// CCM (SP 800-38C Appendix C  Example 1, 2)
+static void TestAesCcm(void)
+{
+	uint8_t Key[16], Nonce[8], AAD[16], in[16], cipher[16], out[16], Tag[16];
+	CIPH_AES_CCM* hCcm;
+
+	ParseHex("404142434445464748494a4b4c4d4e4f", Key);
+	ParseHex("1011121314151617", Nonce);
+	ParseHex("000102030405060708090a0b0c0d0e0f", AAD);
+	ParseHex("202122232425262728292a2b2c2d2e2f", in);
+
+	CheckStatus("Create (CCM)", CiphAesCcmCreate(Key, 16, 4, &hCcm), CIPH_SUCCESS);
+	CiphAesCcmEncrypt(hCcm, Nonce, 7, AAD, 8, in, 4, cipher, Tag);
+	CheckBytes("CCM (Example 1)", cipher, 4, "7162015b");
+	CheckBytes("CCM (Example 1, Tag)", Tag, 4, "4dac255d");
+	CiphAesCcmDestroy(hCcm);
+
+	CiphAesCcmCreate(Key, 16, 6, &hCcm);
+	CiphAesCcmEncrypt(hCcm, Nonce, 8, AAD, 16, in, 16, cipher, Tag);
+	CheckBytes("CCM (Example 2)", cipher, 16, "d2a1f0e051ea5f62081a7792073d593d");
+	CheckBytes("CCM (Example 2, Tag)", Tag, 6, "1fc64fbfaccd");
+	CheckStatus("CCM (Decrypt)", CiphAesCcmDecrypt(hCcm, Nonce, 8, AAD, 16, cipher, 16, Tag, out), CIPH_SUCCESS);
+	CheckTrue("CCM (Output)", memcmp(out, in, 16) == 0);
+	Tag[0] ^= 1;
+	CheckStatus("CCM (Tampered)", CiphAesCcmDecrypt(hCcm, Nonce, 8, AAD, 16, cipher, 16, Tag, out), CIPH_AUTHENTICATION_FAILED);
+	CheckStatus("CCM (Nonce 6 bytes)", CiphAesCcmEncrypt(hCcm, Nonce, 6, AAD, 16, in, 16, cipher, Tag), CIPH_INVALID_LENGTH);
+	CiphAesCcmDestroy(hCcm);
+
+	return;
+}
+
+// TestAesDrbg ֐
+// CTR_DRBG (o֐Ȃ)
+// Entropy Input = 00 01 02 ... (seedlen oCg) ō쐬A2 ڂ̐ʂmF (CiphAesCrypt  Example 13 Ɠ)
+static void TestAesDrbg(void)
+{
+	uint8_t Entropy[48], out[64], out2[64];
+	CIPH_AES_DRBG* hDrbg;
+
+	for (int i = 0; i < 48; i++)
+	{
+		Entropy[i] = (uint8_t)i;
+	}
+
+	CheckStatus("Create (DRBG)", CiphAesDrbgCreate(16, 0, FixedEntropy, Entropy, NULL, 0, &hDrbg), CIPH_SUCCESS);
+	CiphAesDrbgGenerate(hDrbg, out, 64, NULL, 0);
+	CiphAesDrbgGenerate(hDrbg, out, 64, NULL, 0);
+	CheckBytes("DRBG (AES-128)", out, 32, "796037fe48c39bf610f8a85a98565d96094b2d53595ffe0fc61be739c21d9394");
+	CheckStatus("DRBG (Reseed)", CiphAesDrbgReseed(hDrbg, NULL, 0), CIPH_SUCCESS);
+	CiphAesDrbgDestroy(hDrbg);
+
+	CiphAesDrbgCreate(32, 0, FixedEntropy, Entropy, NULL, 0, &hDrbg);
+	CiphAesDrbgGenerate(hDrbg, out, 64, NULL, 0);
+	CiphAesDrbgGenerate(hDrbg, out, 64, NULL, 0);
+	CheckBytes("DRBG (AES-256)", out, 32, "04562ad35e8ecafaafda16981cdaa147606beea62801342af13c8b5535f72f94");
+	CiphAesDrbgDestroy(hDrbg);
+
+	CheckStatus("DRBG (Entropy Failed)", CiphAesDrbgCreate(16, 0, FailingEntropy, NULL, NULL, 0, &hDrbg), CIPH_ENTROPY_FAILED);
+	CheckStatus("DRBG (Personalization)", CiphAesDrbgCreate(16, 0, FixedEntropy, Entropy, Entropy, 33, &hDrbg), CIPH_INVALID_LENGTH);
+
+	// OS ̃Ggs[gꍇ͒lmFłȂ߁AAo͂قȂ邱Ƃ݂̂mF
+	CheckStatus("Random Bytes", CiphRandomBytes(out, 64), CIPH_SUCCESS);
+	CiphRandomBytes(out2, 64);
+	CheckTrue("Random Bytes (Distinct)", memcmp(out, out2, 64) != 0);
+
+	return;
+}
+
+// TestAesFpe ֐
+// ێÍ FF1 (SP 800-38G  Sample 1, 2, 3)  FF3-1
+static void TestAesFpe(void)
+{
+	uint8_t Key[16], Tweak[16];
+	uint16_t in[32], cipher[32], out[32], Expected[32];
+	size_t n, cbTweak;
+	CIPH_AES_FF1* hFf1;
+	CIPH_AES_FF3* hFf3;
+
+	ParseHex("2b7e151628aed2a6abf7158809cf4f3c", Key);
+	n = ParseNumerals("0123456789", in);
+
+	CheckStatus("Create (FF1)", CiphAesFf1Create(Key, 16, 10, NULL, 0, &hFf1), CIPH_SUCCESS);
+	CiphAesFf1Encrypt(hFf1, in, n, cipher);
+	ParseNumerals("2433477484", Expected);
+	CheckTrue("FF1 (Sample 1)", memcmp(cipher, Expected, n * sizeof(uint16_t)) == 0);
+	CiphAesFf1Decrypt(hFf1, cipher, n, out);
+	CheckTrue("FF1 (Decrypt)", memcmp(out, in, n * sizeof(uint16_t)) == 0);
+	CheckStatus("FF1 (1 numeral)", CiphAesFf1Encrypt(hFf1, in, 1, cipher), CIPH_INVALID_LENGTH);
+	in[0] = 10;
+	CheckStatus("FF1 (Numeral 10)", CiphAesFf1Encrypt(hFf1, in, n, cipher), CIPH_INVALID_DATA);
+	in[0] = 0;
+	CiphAesFf1Destroy(hFf1);
+
+	cbTweak = ParseHex("39383736353433323130", Tweak);
+	CiphAesFf1Create(Key, 16, 10, Tweak, cbTweak, &hFf1);
+	CiphAesFf1Encrypt(hFf1, in, n, cipher);
+	ParseNumerals("6124200773", Expected);
+	CheckTrue("FF1 (Sample 2)", memcmp(cipher, Expected, n * sizeof(uint16_t)) == 0);
+	CiphAesFf1Destroy(hFf1);
+
+	cbTweak = ParseHex("3737373770717273373737", Tweak);
+	n = ParseNumerals("0123456789abcdefghi", in);
+	CiphAesFf1Create(Key, 16, 36, Tweak, cbTweak, &hFf1);
+	CiphAesFf1Encrypt(hFf1, in, n, cipher);
+	ParseNumerals("a9tv40mll9kdu509eum", Expected);
+	CheckTrue("FF1 (Sample 3)", memcmp(cipher, Expected, n * sizeof(uint16_t)) == 0);
+	CiphAesFf1Destroy(hFf1);
+
+	ParseHex("2de79d232df5585d68ce47882ae256d6", Key);
+	ParseHex("cbd09280979564", Tweak);
+	n = ParseNumerals("3992520240", in);
+	CheckStatus("Create (FF3-1)", CiphAesFf3Create(Key, 16, 10, Tweak, &hFf3), CIPH_SUCCESS);
+	CiphAesFf3Encrypt(hFf3, in, n, cipher);
+	ParseNumerals("8901801106", Expected);
+	CheckTrue("FF3-1", memcmp(cipher, Expected, n * sizeof(uint16_t)) == 0);
+	CiphAesFf3Decrypt(hFf3, cipher, n, out);
+	CheckTrue("FF3-1 (Decrypt)", memcmp(out, in, n * sizeof(uint16_t)) == 0);
+	CiphAesFf3Destroy(hFf3);
+
+	return;
+}
+
+// TestAesDukpt ֐
+// DUKPT (AES) (ANSI X9.24-3-2017 ̗)
+// BDK 瓱oƁA 1 䕪𓱏ov邩mF
+static void TestAesDukpt(void)
+{
+	uint8_t Bdk[16], InitialKeyId[8], InitialKey[16], Ksns[24], Keys[32], Key[16];
+	CIPH_AES_DUKPT_BDK* hBdk;
+
+	ParseHex("fedcba9876543210f1f1f1f1f1f1f1f1", Bdk);
+	ParseHex("1234567890123456", InitialKeyId);
+	ParseHex("123456789012345600000001 123456789012345600000002", Ksns);
+
+	CheckStatus("Create (AES DUKPT)", CiphAesDukptCreateBdk(Bdk, 16, &hBdk), CIPH_SUCCESS);
+	CiphAesDukptDeriveInitialKey(hBdk, InitialKeyId, InitialKey);
+	CheckBytes("AES DUKPT (Initial Key)", InitialKey, 16, "1273671ea26ac29afa4d1084127652a1");
+
+	CiphAesDukptDeriveKeys(hBdk, Ksns, 2, CIPH_AES_DUKPT_USAGE_PIN, CIPH_AES_DUKPT_KEY_AES128, Keys);
+	CheckBytes("AES DUKPT (PIN Key)", Keys, 16, "af8cb133a78f8dc2d1359f18527593fb");
+	CheckBytes("AES DUKPT (PIN Key 2)", &Keys[16], 16, "d30bdc73ec9714b000bec66bdb7b6d09");
+	CiphAesDukptDeriveKey(InitialKey, 16, &Ksns[12], CIPH_AES_DUKPT_USAGE_PIN, CIPH_AES_DUKPT_KEY_AES128, Key);
+	CheckTrue("AES DUKPT (From IK)", memcmp(Key, &Keys[16], 16) == 0);
+
+	CiphAesDukptDeriveKeys(hBdk, Ksns, 1, CIPH_AES_DUKPT_USAGE_MAC_GENERATION, CIPH_AES_DUKPT_KEY_AES128, Keys);
+	CheckBytes("AES DUKPT (MAC Key)", Keys, 16, "a2dc23de6fde0824a2bc321e08e4b8b7");
+	CiphAesDukptDeriveKeys(hBdk, Ksns, 1, CIPH_AES_DUKPT_USAGE_DATA_BOTH, CIPH_AES_DUKPT_KEY_2TDEA, Keys);
+	CheckBytes("AES DUKPT (Data Key)", Keys, 16, "4473f9d031694d7e58d9d4f87f83072d");
+
+	CiphAesDukptDestroyBdk(hBdk);
+
+	return;
+}
+
+// TestTdeaModes ֐
+// TDEA  ECB, CBC, CTR (SP 800-67 / SP 800-38A ̗)  PKCS#7AÍގ
+static void TestTdeaModes(void)
+{
+	uint8_t Key[24], IV[8], in[32], cipher[40], out[40];
+	size_t cbCipher, cbOut;
+	CIPH_TDEA_KEY* hKey;
+
+	ParseHex("0123456789abcdef23456789abcdef01456789abcdef0123", Key);
+	ParseHex("f69f2445df4f9b17", IV);
+	ParseHex("6bc1bee22e409f96e93d7e117393172a ae2d8a571e03ac9c9eb76fac45af8e51", in);
+
+	CheckStatus("Create (TDEA)", CiphTdeaCreateKey(Key, 24, &hKey), CIPH_SUCCESS);
+	CiphTdeaEcbEncrypt(hKey, in, 32, cipher);
+	CheckBytes("TDEA-ECB", cipher, 32, "714772f339841d34267fcc4bd2949cc3 ee11c22a576a303876183f99c0b6de87");
+	CiphTdeaCbcEncrypt(hKey, IV, in, 32, cipher);
+	CheckBytes("TDEA-CBC", cipher, 32, "2079c3d53aa763e193b79e2569ab5262 516570481f25b50f73c0bda85c8e0da7");
+	CiphTdeaCbcDecrypt(hKey, IV, cipher, 32, out);
+	CheckTrue("TDEA-CBC (Decrypt)", memcmp(out, in, 32) == 0);
+	CiphTdeaCtrCrypt(hKey, IV, 0, in, 32, cipher);
+	CheckBytes("TDEA-CTR", cipher, 32, "078bb74e59ce7ed619aa11d25004fb65 a03cedf1ba0b09baa3bc81b8f69c1da9");
+
+	// CBC ̐擪 16 oCg PKCS#7 tĂςȂ
+	CiphTdeaCbcEncryptPadded(hKey, CIPH_PADDING_PKCS7, IV, in, 21, cipher, &cbCipher);
+	CheckTrue("TDEA-CBC-P7 (Length)", cbCipher == 24);
+	CheckBytes("TDEA-CBC-P7", cipher, 16, "2079c3d53aa763e193b79e2569ab5262");
+	CiphTdeaCbcDecryptPadded(hKey, CIPH_PADDING_PKCS7, IV, cipher, cbCipher, out, &cbOut);
+	CheckTrue("TDEA-CBC-P7 (Decrypt)", cbOut == 21 && memcmp(out, in, 21) == 0);
+	CiphTdeaEcbEncryptPkcs7(hKey, in, 16, cipher, &cbCipher);
+	CiphTdeaEcbDecryptPkcs7(hKey, cipher, cbCipher, out, &cbOut);
+	CheckTrue("TDEA-ECB-P7 (Decrypt)", cbCipher == 24 && cbOut == 16 && memcmp(out, in, 16) == 0);
+	CiphTdeaCbcEncryptPadded(hKey, CIPH_PADDING_CS3, IV, in, 21, cipher, &cbCipher);
+	CiphTdeaCbcDecryptPadded(hKey, CIPH_PADDING_CS3, IV, cipher, cbCipher, out, &cbOut);
+	CheckTrue("TDEA-CBC-CS3 (Decrypt)", cbCipher == 21 && cbOut == 21 && memcmp(out, in, 21) == 0);
+	CiphTdeaDestroyKey(hKey);
+
+	// Keying Option 3 (DES)  CBC-CS1 ̐擪 8 oCg CBC ̐擪 8 oCgƈv
+	ParseHex("0123456789abcdef", Key);
+	ParseHex("1234567890abcdef", IV);
+	CiphTdeaCreateKey(Key, 8, &hKey);
+	CiphTdeaCbcEncryptPadded(hKey, CIPH_PADDING_CS1, IV, (const uint8_t*)"Now is the time for a", 21, cipher, &cbCipher);
+	CheckBytes("DES-CBC-CS1", cipher, 8, "e5c7cdde872bf27c");
+	CiphTdeaDestroyKey(hKey);
+
+	return;
+}
+
+// TestTdeaMac ֐
+// ISO/IEC 9797-1 MAC Algorithm 1, Algorithm 3  TDEA-CMAC (SP 800-38B ̗)
+static void TestTdeaMac(void)
+{
+	uint8_t Key[24], in[32], Mac[8];
+	const uint8_t* Text = (const uint8_t*)"Now is the time for all ";
+	CIPH_TDEA_MAC* hMac;
+
+	ParseHex("0123456789abcdeffedcba9876543210", Key);
+	CheckStatus("Create (MAC 1)", CiphTdeaMacCreate(Key, 8, CIPH_MAC_ALGORITHM1, CIPH_MAC_PADDING1, &hMac), CIPH_SUCCESS);
+	CiphTdeaMac(hMac, Text, 24, Mac);
+	CheckBytes("MAC Algorithm 1", Mac, 8, "70a30640cc76dd8b");
+	CiphTdeaMacDestroy(hMac);
+
+	CiphTdeaMacCreate(Key, 16, CIPH_MAC_ALGORITHM3, CIPH_MAC_PADDING1, &hMac);
+	CiphTdeaMac(hMac, Text, 24, Mac);
+	CheckBytes("MAC Algorithm 3", Mac, 8, "a1c72e74ea3fa9b6");
+	CiphTdeaMacDestroy(hMac);
+
+	CiphTdeaMacCreate(Key, 16, CIPH_MAC_ALGORITHM3, CIPH_MAC_PADDING2, &hMac);
+	CiphTdeaMac(hMac, Text, 21, Mac);
+	CheckBytes("MAC Algorithm 3 (Pad 2)", Mac, 8, "cb59b6b656bfb429");
+	CiphTdeaMacDestroy(hMac);
+
+	CheckStatus("Create (MAC 3, 8 bytes)", CiphTdeaMacCreate(Key, 8, CIPH_MAC_ALGORITHM3, CIPH_MAC_PADDING1, &hMac), CIPH_INVALID_KEY_LENGTH);
+
+	ParseHex("8aa83bf8cbda10620bc1bf19fbb6cd58bc313d4a371ca8b5", Key);
+	ParseHex("6bc1bee22e409f96e93d7e117393172a ae2d8a571e03ac9c9eb76fac45af8e51", in);
+	CiphTdeaMacCreate(Key, 24, CIPH_MAC_CMAC, 0, &hMac);
+	CiphTdeaMac(hMac, NULL, 0, Mac);
+	CheckBytes("TDEA-CMAC (0 bytes)", Mac, 8, "b7a688e122ffaf95");
+	CiphTdeaMac(hMac, in, 20, Mac);
+	CheckBytes("TDEA-CMAC (20 bytes)", Mac, 8, "743ddbe0ce2dc2ed");
+	CiphTdeaMac(hMac, in, 32, Mac);
+	CheckBytes("TDEA-CMAC (32 bytes)", Mac, 8, "33e6b1092400eae5");
+	CiphTdeaMacDestroy(hMac);
+
+	return;
+}
+
+// TestTdeaDukpt ֐
+// DUKPT (TDES) (ANSI X9.24-1:2009 Annex A)
+static void TestTdeaDukpt(void)
+{
+	uint8_t Bdk[16], Ksns[30], Ipek[16], Keys[48], Key[16];
+	CIPH_TDEA_DUKPT_BDK* hBdk;
+
+	ParseHex("0123456789abcdeffedcba9876543210", Bdk);
+	ParseHex("ffff9876543210e00001 ffff9876543210e00002 ffff9876543210e00003", Ksns);
+
+	CheckStatus("Create (TDES DUKPT)", CiphTdeaDukptCreateBdk(Bdk, 16, &hBdk), CIPH_SUCCESS);
+	CiphTdeaDukptDeriveIpek(hBdk, Ksns, Ipek);
+	CheckBytes("TDES DUKPT (IPEK)", Ipek, 16, "6ac292faa1315b4d858ab3a3d7d5933a");
+
+	CiphTdeaDukptDeriveKeys(hBdk, Ksns, 3, CIPH_TDEA_DUKPT_VARIANT_PIN, Keys);
+	CheckBytes("TDES DUKPT (PIN Key 1)", Keys, 16, "042666b49184cf5c68de9628d0397b36");
+	CheckBytes("TDES DUKPT (PIN Key 2)", &Keys[16], 16, "c46551cef9fd244faa9ad834130d3b38");
+	CheckBytes("TDES DUKPT (PIN Key 3)", &Keys[32], 16, "0df3d9422aca561a47676d07ad6bad05");
+
+	CiphTdeaDukptDeriveKey(Ipek, Ksns, CIPH_TDEA_DUKPT_VARIANT_MAC_REQUEST, Key);
+	CheckBytes("TDES DUKPT (MAC Key)", Key, 16, "042666b4918430a368de9628d03984c9");
+	CiphTdeaDukptDeriveKey(Ipek, Ksns, CIPH_TDEA_DUKPT_VARIANT_DATA_REQUEST, Key);
+	CheckBytes("TDES DUKPT (Data Key)", Key, 16, "448d3f076d8304036a55a3d7e0055a78");
+
+	CiphTdeaDukptDestroyBdk(hBdk);
+
+	return;
+}
+
+// TestPin ֐
+// PIN ubN̍쐬ƕϊ (ISO 9564-1)
+// M̌ (3-key TDEA) ňÍ ISO 0  PIN ubN𑗐M̌ (DES) ɕϊAČ PIN ubNƈv邩mF
+static void TestPin(void)
+{
+	uint8_t SourceKey[24], DestinationKey[8], Block[8], Blocks[16], Translated[16], Clear[16], Results[2];
+	const char* Pans[2] = { "4111111111111111", "4111111111111111" };
+	CIPH_TDEA_KEY* hSourceKey, * hDestinationKey;
+
+	CheckStatus("PIN Block (ISO 0)", CiphPinBlockEncode("1234", CIPH_PIN_FORMAT_ISO0, "4111111111111111", Block), CIPH_SUCCESS);
+	CheckBytes("PIN Block (Value)", Block, 8, "041225eeeeeeeeee");
+	CheckStatus("PIN Block (3 digits)", CiphPinBlockEncode("123", CIPH_PIN_FORMAT_ISO0, "4111111111111111", Block), CIPH_INVALID_DATA);
+	CiphPinBlockEncode("1234", CIPH_PIN_FORMAT_ISO0, "4111111111111111", Block);
+
+	ParseHex("0123456789abcdef23456789abcdef01456789abcdef0123", SourceKey);
+	ParseHex("0123456789abcdef", DestinationKey);
+	CiphTdeaCreateKey(SourceKey, 24, &hSourceKey);
+	CiphTdeaCreateKey(DestinationKey, 8, &hDestinationKey);
+
+	CiphTdeaEcbEncrypt(hSourceKey, Block, 8, Blocks);
+	CiphTdeaEcbEncrypt(hSourceKey, Block, 8, &Blocks[8]);
+	CheckStatus("PIN Translate", CiphPinTranslate(hSourceKey, CIPH_PIN_FORMAT_ISO0, hDestinationKey, CIPH_PIN_FORMAT_ISO0, Blocks, Pans, 2, Translated, Results), CIPH_SUCCESS);
+	CiphTdeaEcbDecrypt(hDestinationKey, Translated, 16, Clear);
+	CheckTrue("PIN Translate (Output)", Results[0] != 0 && Results[1] != 0 && memcmp(Clear, Block, 8) == 0 && memcmp(&Clear[8], Block, 8) == 0);
+
+	// M̌قȂ PIN ubN CIPH_INVALID_DATA ԂAResults ŎsubN
+	CiphTdeaEcbEncrypt(hDestinationKey, Block, 8, &Blocks[8]);
+	CheckStatus("PIN Translate (Bad Key)", CiphPinTranslate(hSourceKey, CIPH_PIN_FORMAT_ISO0, hDestinationKey, CIPH_PIN_FORMAT_ISO0, Blocks, Pans, 2, Translated, Results), CIPH_INVALID_DATA);
+	CheckTrue("PIN Translate (Results)", Results[0] != 0 && Results[1] == 0);
+
+	CiphTdeaDestroyKey(hSourceKey);
+	CiphTdeaDestroyKey(hDestinationKey);
+
+	return;
+}
+
+// TestDispatch ֐
+// s@臒l͌nh̍쐬ł͑肹ACiphCalibrateDispatch ő肷 (ϐ CIPH_DISPATCH w肵Ȃꍇ)
+static void TestDispatch(void)
+{
+	uint8_t Key[16] = { 0 };
+	CIPH_AES_KEY* hKey;
+	int bMeasured = 1;
+
+	CiphAesCreateKey(Key, 16, &hKey);
+	CheckTrue("Dispatch (Create Key)", CiphGetDispatchThreshold(CIPH_DISPATCH_KIND_AES_ECB) == 0);
+	CiphAesDestroyKey(hKey);
+
+	CiphCalibrateDispatch();
+	for (uint32_t i = CIPH_DISPATCH_KIND_AES_ECB; i <= CIPH_DISPATCH_KIND_TDEA_CTR; i++)
+	{
+		if (CiphGetDispatchThreshold(i) == 0)
+		{
+			bMeasured = 0;
+		}
+	}
+	CheckTrue("Dispatch (Calibrate)", bMeasured);
+
+	return;
+}
+
+// TestBuffer ֐
+// Ɨ͓̈eĂėp (TCY CIPH_BUFFER_NO_ZERO ŊmۂĊmF)
+// [Wy[Ẅ̗͊mۂƉł邱Ƃ̂݊mF
+static void TestBuffer(void)
+{
+	uint8_t* p;
+	size_t i, cb = 4096;
+	int bWiped = 1;
+
+	p = (uint8_t*)CiphBufferAlloc(cb, CIPH_BUFFER_NO_ZERO);
+	memset(p, 0xa5, cb);
+	CiphBufferFree(p);
+	p = (uint8_t*)CiphBufferAlloc(cb, CIPH_BUFFER_NO_ZERO);
+	for (i = 0; i < cb; i++)
+	{
+		if (p[i] == 0xa5)
+		{
+			bWiped = 0;
+		}
+	}
+	CheckTrue("Buffer (Wiped)", bWiped);
+	CiphBufferFree(p);
+
+	cb = 0x01000001;
+	p = (uint8_t*)CiphBufferAlloc(cb, CIPH_BUFFER_LARGE_PAGES);
+	CheckTrue("Buffer (Large Pages)", p != NULL && ((uintptr_t)p & 63) == 0 && p[0] == 0 && p[cb - 1] == 0);
+	if (p != NULL)
+	{
+		p[0] = p[cb - 1] = 1;
+	}
+	CiphBufferFree(p);
+
+	return;
+}
+
+int main(void)
+{
+	TestDispatch();
+	TestBuffer();
+	TestAesModes();
+	TestAesPadding();
+	TestAesKeyWrap();
+	TestAesGcm();
+	TestAesXts();
+	TestAesOcb();
+	TestAesCcm();
+	TestAesDrbg();
+	TestAesFpe();
+	TestAesDukpt();
+	TestTdeaModes();
+	TestTdeaMac();
+	TestTdeaDukpt();
+	TestPin();
+
+	printf("\r\n%-25s = %d\r\n", "Failures", nFailures);
+
+	return nFailures == 0 ? 0 : 1;
+}